@@ -34,15 +34,23 @@
 #include "utility.h"
 #include "contour_generator.h"
 #include "segment_merger.h"
+#include "strip_stitcher.h"
 
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "cpl_conv.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_srs_api.h"
 #include "ogr_geometry.h"
 
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
 static CPLErr OGRPolygonContourWriter(double dfLevelMin, double dfLevelMax,
                                       const OGRMultiPolygon &multipoly,
                                       void *pInfo)
@@ -208,6 +216,289 @@ struct GDALRingAppender
     void *data_;
 };
 
+/************************************************************************/
+/*                       ContourLayerTransaction                        */
+/*                                                                      */
+/*      Used by the multi-threaded code path to write the features by   */
+/*      batches, each batch in its own transaction when the output      */
+/*      layer supports them.                                            */
+/************************************************************************/
+
+class ContourLayerTransaction
+{
+    CPL_DISALLOW_COPY_ASSIGN(ContourLayerTransaction)
+
+  public:
+    explicit ContourLayerTransaction(OGRLayerH hLayer)
+        : hLayer_(hLayer && OGR_L_TestCapability(hLayer, OLCTransactions)
+                      ? hLayer
+                      : nullptr)
+    {
+        start_();
+    }
+
+    ~ContourLayerTransaction()
+    {
+        commit_();
+    }
+
+    // Commit the features written since the previous batch.
+    bool flush()
+    {
+        const bool ok = commit_();
+        start_();
+        return ok;
+    }
+
+  private:
+    OGRLayerH hLayer_;
+    bool active_ = false;
+
+    void start_()
+    {
+        if (hLayer_ == nullptr)
+            return;
+        // A transaction might already be active on the dataset, in which
+        // case the features are just written in it.
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        active_ = OGR_L_StartTransaction(hLayer_) == OGRERR_NONE;
+    }
+
+    bool commit_()
+    {
+        if (!active_)
+            return true;
+        active_ = false;
+        return OGR_L_CommitTransaction(hLayer_) == OGRERR_NONE;
+    }
+};
+
+/************************************************************************/
+/*                        ContourLinesPerStrip()                        */
+/*                                                                      */
+/*      Number of lines of the horizontal strips processed by each      */
+/*      thread, so that all threads get work on small rasters, and      */
+/*      that the strip of each thread fits in a memory budget of about  */
+/*      16 MB of Float64 values. Can be overridden with the             */
+/*      GDAL_CONTOUR_LINES_PER_STRIP configuration option (mostly for   */
+/*      testing purposes).                                              */
+/************************************************************************/
+
+static int ContourLinesPerStrip(int nXSize, int nYSize, int nThreads)
+{
+    const char *pszLinesPerStrip =
+        CPLGetConfigOption("GDAL_CONTOUR_LINES_PER_STRIP", nullptr);
+    if (pszLinesPerStrip)
+        return std::max(1, std::min(nYSize, atoi(pszLinesPerStrip)));
+    const GIntBig nBytesPerLine =
+        static_cast<GIntBig>(nXSize) * sizeof(double);
+    return static_cast<int>(std::max<GIntBig>(
+        1, std::min<GIntBig>((nYSize + nThreads - 1) / nThreads,
+                             16 * 1024 * 1024 / nBytesPerLine)));
+}
+
+/************************************************************************/
+/*                             ContourStrip                             */
+/************************************************************************/
+
+namespace
+{
+template <typename LevelGenerator> struct ContourStrip
+{
+    ContourStrip(size_t width_, size_t height_, size_t startLine_,
+                 size_t endLine_, const double *lines_)
+        : width(width_), height(height_), startLine(startLine_),
+          endLine(endLine_), lines(lines_),
+          collector(startLine_, endLine_, height_)
+    {
+    }
+    ContourStrip(ContourStrip &&) = default;
+    ContourStrip(const ContourStrip &) = delete;
+    ContourStrip &operator=(const ContourStrip &) = delete;
+
+    size_t width;
+    size_t height;
+    // Lines [startLine, endLine[ of the raster. Line startLine - 1 is
+    // available just before them, when startLine > 0.
+    size_t startLine;
+    size_t endLine;
+    const double *lines;
+
+    bool hasNoData = false;
+    double noDataValue = 0;
+    LevelGenerator *levels = nullptr;
+    bool polygonize = false;
+
+    marching_squares::StripCollector collector;
+    std::string errorMsg{};
+};
+}  // namespace
+
+/************************************************************************/
+/*                           ContourStripFunc()                         */
+/************************************************************************/
+
+template <typename LevelGenerator> static void ContourStripFunc(void *pData)
+{
+    using namespace marching_squares;
+
+    auto psStrip = static_cast<ContourStrip<LevelGenerator> *>(pData);
+    try
+    {
+        SegmentMerger<StripCollector, LevelGenerator> merger(
+            psStrip->collector, *psStrip->levels, psStrip->polygonize);
+        ContourGenerator<decltype(merger), LevelGenerator> cg(
+            psStrip->width, psStrip->height, psStrip->hasNoData,
+            psStrip->noDataValue, merger, *psStrip->levels);
+        cg.startAtLine(psStrip->startLine,
+                       psStrip->startLine > 0 ? psStrip->lines - psStrip->width
+                                              : nullptr);
+        const double *line = psStrip->lines;
+        for (size_t lineIdx = psStrip->startLine; lineIdx < psStrip->endLine;
+             lineIdx++, line += psStrip->width)
+        {
+            cg.feedLine(line);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        psStrip->errorMsg = e.what();
+    }
+}
+
+/************************************************************************/
+/*                         ContourGenerateMT()                          */
+/*                                                                      */
+/*      Process the raster by chunks of nThreads horizontal strips,     */
+/*      each strip being contoured by a worker thread with its own      */
+/*      SegmentMerger. The complete lines of a chunk are written once   */
+/*      it is processed, and the lines that end on the boundary         */
+/*      between two strips are joined after the last chunk.             */
+/************************************************************************/
+
+template <typename LineWriter, typename LevelGenerator>
+static bool ContourGenerateMT(GDALRasterBandH hBand, bool hasNoData,
+                              double noDataValue, LineWriter &lineWriter,
+                              LevelGenerator &levels, bool polygonize,
+                              int nThreads, CPLJobQueue *poJobQueue,
+                              ContourLayerTransaction &transaction,
+                              GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    using namespace marching_squares;
+
+    const int nXSize = GDALGetRasterBandXSize(hBand);
+    const int nYSize = GDALGetRasterBandYSize(hBand);
+    const size_t width = nXSize;
+    const size_t height = nYSize;
+    const size_t linesPerStrip = ContourLinesPerStrip(nXSize, nYSize, nThreads);
+    const size_t chunkLines = linesPerStrip * nThreads;
+
+    std::vector<double> buffer;
+    std::vector<ContourStrip<LevelGenerator>> strips;
+    StripStitcher<LineWriter> stitcher(lineWriter);
+
+    for (size_t chunkStart = 0; chunkStart < height; chunkStart += chunkLines)
+    {
+        if (pfnProgress(double(chunkStart) / height, "Processing line",
+                        pProgressArg) == FALSE)
+            return false;
+
+        // The squares of the first line of the chunk also need the line
+        // before it.
+        const size_t chunkEnd = std::min(height, chunkStart + chunkLines);
+        const size_t readStart = chunkStart > 0 ? chunkStart - 1 : 0;
+        const size_t readLines = chunkEnd - readStart;
+        buffer.resize(width * readLines);
+        CPLErr error = GDALRasterIO(hBand, GF_Read, 0, int(readStart),
+                                    nXSize, int(readLines), buffer.data(),
+                                    nXSize, int(readLines), GDT_Float64, 0, 0);
+        if (error != CE_None)
+        {
+            CPLDebug("CONTOUR", "failed fetch %d %d", int(readStart),
+                     int(readLines));
+            return false;
+        }
+
+        strips.clear();
+        strips.reserve(nThreads);
+        for (size_t stripStart = chunkStart; stripStart < chunkEnd;
+             stripStart += linesPerStrip)
+        {
+            strips.emplace_back(
+                width, height, stripStart,
+                std::min(chunkEnd, stripStart + linesPerStrip),
+                buffer.data() + (stripStart - readStart) * width);
+            auto &strip = strips.back();
+            strip.hasNoData = hasNoData;
+            strip.noDataValue = noDataValue;
+            strip.levels = &levels;
+            strip.polygonize = polygonize;
+        }
+
+        for (auto &strip : strips)
+            poJobQueue->SubmitJob(ContourStripFunc<LevelGenerator>, &strip);
+        poJobQueue->WaitCompletion();
+
+        for (auto &strip : strips)
+        {
+            if (!strip.errorMsg.empty())
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                         strip.errorMsg.c_str());
+                return false;
+            }
+        }
+
+        for (auto &strip : strips)
+        {
+            for (auto &line : strip.collector.lines)
+                lineWriter.addLine(line.level, line.ls, line.closed);
+            stitcher.addOpenLines(strip.collector.openLines);
+        }
+        if (!transaction.flush())
+            return false;
+    }
+
+    stitcher.process();
+
+    pfnProgress(1.0, "", pProgressArg);
+    return true;
+}
+
+/************************************************************************/
+/*                           ContourGenerate()                          */
+/************************************************************************/
+
+template <typename LineWriter, typename LevelGenerator>
+static bool ContourGenerate(GDALRasterBandH hBand, bool hasNoData,
+                            double noDataValue, LineWriter &lineWriter,
+                            LevelGenerator &levels, bool polygonize,
+                            int nThreads,
+                            ContourLayerTransaction *poTransaction,
+                            GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    using namespace marching_squares;
+
+    if (nThreads > 1 && poTransaction)
+    {
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        auto poJobQueue =
+            poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+        if (poJobQueue)
+            return ContourGenerateMT(hBand, hasNoData, noDataValue,
+                                     lineWriter, levels, polygonize, nThreads,
+                                     poJobQueue.get(), *poTransaction,
+                                     pfnProgress, pProgressArg);
+    }
+
+    SegmentMerger<LineWriter, LevelGenerator> writer(lineWriter, levels,
+                                                     polygonize);
+    ContourGeneratorFromRaster<decltype(writer), LevelGenerator> cg(
+        hBand, hasNoData, noDataValue, writer, levels);
+    return cg.process(pfnProgress, pProgressArg);
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                   Additional C Callable Functions                    */
@@ -543,6 +834,17 @@ mode.
  *
  * If YES, contour polygons will be created, rather than polygon lines.
  *
+ *   NUM_THREADS=number|ALL_CPUS
+ *
+ * (GDAL >= 3.8) Number of worker threads. Defaults to 1. When greater than
+ * 1, the raster is split into horizontal strips that are contoured in
+ * parallel, and the contours crossing strip boundaries are joined
+ * afterwards. The resulting contours are the same as in the single-threaded
+ * mode, but the order of the features, and the start point of closed lines,
+ * may differ. For that reason, the GDAL_NUM_THREADS configuration option is
+ * not taken into account. The features are written by batches, in
+ * transactions when the output layer supports them.
+ *
  *
  * @return CE_None on success or CE_Failure if an error occurs.
  */
@@ -654,6 +956,13 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
         GDALGetGeoTransform(hSrcDS, oCWI.adfGeoTransform);
     oCWI.nNextID = 0;
 
+    // The transaction must outlive the ring appenders, that write their
+    // features when they are destroyed.
+    const int nThreads = GDALGetNumThreads(options, false);
+    std::unique_ptr<ContourLayerTransaction> poTransaction;
+    if (nThreads > 1)
+        poTransaction.reset(new ContourLayerTransaction(oCWI.hLayer));
+
     bool ok = false;
     try
     {
@@ -669,32 +978,26 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                 FixedLevelRangeIterator levels(
                     &fixedLevels[0], fixedLevels.size(),
                     GDALGetRasterMaximum(hBand, &bSuccess));
-                SegmentMerger<RingAppender, FixedLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           FixedLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = ContourGenerate(hBand, useNoData, noDataValue, appender,
+                                     levels, /* polygonize */ true, nThreads,
+                                     poTransaction.get(), pfnProgress,
+                                     pProgressArg);
             }
             else if (expBase > 0.0)
             {
                 ExponentialLevelRangeIterator levels(expBase);
-                SegmentMerger<RingAppender, ExponentialLevelRangeIterator>
-                    writer(appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           ExponentialLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = ContourGenerate(hBand, useNoData, noDataValue, appender,
+                                     levels, /* polygonize */ true, nThreads,
+                                     poTransaction.get(), pfnProgress,
+                                     pProgressArg);
             }
             else
             {
                 IntervalLevelRangeIterator levels(contourBase, contourInterval);
-                SegmentMerger<RingAppender, IntervalLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           IntervalLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = ContourGenerate(hBand, useNoData, noDataValue, appender,
+                                     levels, /* polygonize */ true, nThreads,
+                                     poTransaction.get(), pfnProgress,
+                                     pProgressArg);
             }
         }
         else
@@ -704,32 +1007,26 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
             {
                 FixedLevelRangeIterator levels(&fixedLevels[0],
                                                fixedLevels.size());
-                SegmentMerger<GDALRingAppender, FixedLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           FixedLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = ContourGenerate(hBand, useNoData, noDataValue, appender,
+                                     levels, /* polygonize */ false, nThreads,
+                                     poTransaction.get(), pfnProgress,
+                                     pProgressArg);
             }
             else if (expBase > 0.0)
             {
                 ExponentialLevelRangeIterator levels(expBase);
-                SegmentMerger<GDALRingAppender, ExponentialLevelRangeIterator>
-                    writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           ExponentialLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = ContourGenerate(hBand, useNoData, noDataValue, appender,
+                                     levels, /* polygonize */ false, nThreads,
+                                     poTransaction.get(), pfnProgress,
+                                     pProgressArg);
             }
             else
             {
                 IntervalLevelRangeIterator levels(contourBase, contourInterval);
-                SegmentMerger<GDALRingAppender, IntervalLevelRangeIterator>
-                    writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           IntervalLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = ContourGenerate(hBand, useNoData, noDataValue, appender,
+                                     levels, /* polygonize */ false, nThreads,
+                                     poTransaction.get(), pfnProgress,
+                                     pProgressArg);
             }
         }
     }
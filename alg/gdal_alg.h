@@ -354,6 +354,14 @@ GDALDatasetH CPL_DLL GDALViewshedGenerate(
     void *pProgressArg, GDALViewshedOutputType heightMode,
     CSLConstList papszExtraOptions);
 
+GDALDatasetH CPL_DLL GDALViewshedGenerateCumulative(
+    GDALRasterBandH hBand, const char *pszDriverName,
+    const char *pszTargetRasterName, CSLConstList papszCreationOptions,
+    int nObservers, const double *padfObserverX, const double *padfObserverY,
+    double dfObserverHeight, double dfTargetHeight, double dfCurvCoeff,
+    GDALViewshedMode eMode, double dfMaxDistance, GDALProgressFunc pfnProgress,
+    void *pProgressArg, CSLConstList papszExtraOptions);
+
 /************************************************************************/
 /*      Rasterizer API - geometries burned into GDAL raster.            */
 /************************************************************************/
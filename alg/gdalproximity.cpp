@@ -34,13 +34,18 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
@@ -51,6 +56,13 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    double *pdfSrcNoDataValue, int nTargetValues,
                                    int *panTargetValues);
 
+static CPLErr GDALComputeProximityExact(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hProximityBand, int nXSize,
+    int nYSize, double dfMaxDist, double dfDistMult,
+    const double *pdfSrcNoDataValue, float fNoDataValue, bool bFixedBufVal,
+    double dfFixedBufVal, int nTargetValues, const int *panTargetValues,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg);
+
 /************************************************************************/
 /*                        GDALComputeProximity()                        */
 /************************************************************************/
@@ -107,6 +119,19 @@ the proximity output.
 
 If this option is set, all pixels within the MAXDIST threadhold are
 set to this fixed value instead of to a proximity distance.
+
+  ALGORITHM=[DEFAULT]/EXACT
+
+(GDAL >= 3.8) The DEFAULT algorithm propagates the nearest target found
+during a forward and a backward sweep of the raster, which may slightly
+overestimate some distances. The EXACT algorithm computes an exact Euclidean
+distance transform (Meijster et al. separable algorithm). It processes the
+raster by strips of bounded memory size, and can use several threads.
+
+  NUM_THREADS=n/ALL_CPUS
+
+(GDAL >= 3.8) Number of threads to use with ALGORITHM=EXACT. If not set,
+the GDAL_NUM_THREADS configuration option is used, and defaults to 1.
 */
 
 CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
@@ -243,6 +268,26 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         CSLDestroy(papszValuesTokens);
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Which algorithm should be used?                                 */
+    /* -------------------------------------------------------------------- */
+    bool bExact = false;
+    pszOpt = CSLFetchNameValue(papszOptions, "ALGORITHM");
+    if (pszOpt)
+    {
+        if (EQUAL(pszOpt, "EXACT"))
+            bExact = true;
+        else if (!EQUAL(pszOpt, "DEFAULT"))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unrecognized ALGORITHM value '%s', should be DEFAULT or "
+                     "EXACT.",
+                     pszOpt);
+            CPLFree(panTargetValues);
+            return CE_Failure;
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Initialize progress counter.                                    */
     /* -------------------------------------------------------------------- */
@@ -253,6 +298,19 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
+    if (bExact)
+    {
+        const int nThreads = GDALGetNumThreads(papszOptions, true);
+
+        const CPLErr eExactErr = GDALComputeProximityExact(
+            hSrcBand, hProximityBand, nXSize, nYSize, dfMaxDist, dfDistMult,
+            pdfSrcNoData, fNoDataValue, bFixedBufVal, dfFixedBufVal,
+            nTargetValues, panTargetValues, nThreads, pfnProgress,
+            pProgressArg);
+        CPLFree(panTargetValues);
+        return eExactErr;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      We need a signed type for the working proximity values kept     */
     /*      on disk.  If our proximity band is not signed, then create a    */
@@ -590,3 +648,406 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
 
     return CE_None;
 }
+
+/************************************************************************/
+/*                      GDALProximityRunParallel()                      */
+/************************************************************************/
+
+// Split [0, nSize[ in (at most) nThreads ranges, and run fn() on each of
+// them, using the global thread pool if more than one thread is requested.
+static void GDALProximityRunParallel(int nThreads, int nSize,
+                                     const std::function<void(int, int)> &fn)
+{
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 && nSize > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    if (!poQueue)
+    {
+        fn(0, nSize);
+        return;
+    }
+
+    struct Job
+    {
+        const std::function<void(int, int)> *pfn;
+        int nStart;
+        int nEnd;
+    };
+
+    const int nJobs = std::min(nThreads, nSize);
+    std::vector<Job> asJobs(nJobs);
+    for (int i = 0; i < nJobs; i++)
+    {
+        asJobs[i].pfn = &fn;
+        asJobs[i].nStart = static_cast<int>(static_cast<GIntBig>(nSize) * i /
+                                            nJobs);
+        asJobs[i].nEnd = static_cast<int>(static_cast<GIntBig>(nSize) *
+                                          (i + 1) / nJobs);
+        const auto JobFunc = [](void *pData)
+        {
+            const Job *psJob = static_cast<const Job *>(pData);
+            (*psJob->pfn)(psJob->nStart, psJob->nEnd);
+        };
+        if (!poQueue->SubmitJob(JobFunc, &asJobs[i]))
+            JobFunc(&asJobs[i]);
+    }
+    poQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                       ProximityFloorDiv()                            */
+/************************************************************************/
+
+// Floor division, assuming nDenom > 0.
+static inline GIntBig ProximityFloorDiv(GIntBig nNum, GIntBig nDenom)
+{
+    GIntBig nQuot = nNum / nDenom;
+    if (nNum % nDenom != 0 && nNum < 0)
+        nQuot--;
+    return nQuot;
+}
+
+/************************************************************************/
+/*                       ProcessProximityRowExact()                     */
+/************************************************************************/
+
+// Second (horizontal) pass of the Meijster et al. distance transform:
+// given in panG[] the vertical distance of each pixel of the row to the
+// nearest target pixel of its column (>= nInf meaning none within reach),
+// compute in panDistSq[] the squared Euclidean distance to the nearest target.
+// panS[] and panT[] are working arrays of nXSize elements.
+// Returns false if there is no target within reach of the row.
+static bool ProcessProximityRowExact(const int *panG, int nXSize, int nInf,
+                                     int *panS, int *panT, GIntBig *panDistSq)
+{
+    const auto F = [panG](GIntBig x, GIntBig i)
+    { return (x - i) * (x - i) + static_cast<GIntBig>(panG[i]) * panG[i]; };
+    const auto Sep = [panG](GIntBig i, GIntBig u)
+    {
+        return ProximityFloorDiv(u * u - i * i +
+                                     static_cast<GIntBig>(panG[u]) * panG[u] -
+                                     static_cast<GIntBig>(panG[i]) * panG[i],
+                                 2 * (u - i));
+    };
+
+    // Build the lower envelope of the parabolas of the columns that have
+    // a target within reach.
+    int q = -1;
+    for (int u = 0; u < nXSize; u++)
+    {
+        if (panG[u] >= nInf)
+            continue;
+        while (q >= 0 && F(panT[q], panS[q]) > F(panT[q], u))
+            q--;
+        if (q < 0)
+        {
+            q = 0;
+            panS[0] = u;
+            panT[0] = 0;
+        }
+        else
+        {
+            const GIntBig w = 1 + Sep(panS[q], u);
+            if (w < nXSize)
+            {
+                q++;
+                panS[q] = u;
+                panT[q] = static_cast<int>(w);
+            }
+        }
+    }
+    if (q < 0)
+        return false;
+
+    for (int u = nXSize - 1; u >= 0; u--)
+    {
+        panDistSq[u] = F(u, panS[q]);
+        if (u == panT[q])
+            q--;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                      GDALComputeProximityExact()                     */
+/************************************************************************/
+
+// Exact Euclidean distance transform, following "A general algorithm for
+// computing distance transforms in linear time", Meijster, Roerdink and
+// Hesselink, 2000.
+//
+// The first (vertical) pass is done with a top to bottom sweep that stores
+// in a working band the distance to the nearest target above each pixel,
+// and a bottom to top sweep that completes it with the nearest target below.
+// As soon as a line is final, the second (horizontal) pass is applied to it.
+// The raster is processed by strips of lines: within a strip, the vertical
+// pass is parallelized over columns and the horizontal pass over lines.
+
+static CPLErr GDALComputeProximityExact(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hProximityBand, int nXSize,
+    int nYSize, double dfMaxDist, double dfDistMult,
+    const double *pdfSrcNoDataValue, float fNoDataValue, bool bFixedBufVal,
+    double dfFixedBufVal, int nTargetValues, const int *panTargetValues,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    // Vertical distances beyond the maximum distance are useless, so they
+    // are all clamped to nInf, which stands for "no target within reach".
+    const int nInf =
+        dfMaxDist >= nYSize ? nYSize
+                            : std::max(1, static_cast<int>(dfMaxDist) + 1);
+
+    /* -------------------------------------------------------------------- */
+    /*      The working band stores the vertical distances, with            */
+    /*      -1 - distance for source nodata pixels. Use the proximity band  */
+    /*      if it can hold them exactly, or a temporary file otherwise.     */
+    /* -------------------------------------------------------------------- */
+    GDALRasterBandH hWorkProximityBand = hProximityBand;
+    GDALDatasetH hWorkProximityDS = nullptr;
+    bool bTempFileAlreadyDeleted = false;
+    const GDALDataType eProxType = GDALGetRasterDataType(hProximityBand);
+    if (!(eProxType == GDT_Int32 || eProxType == GDT_Int64 ||
+          eProxType == GDT_Float64 ||
+          (eProxType == GDT_Float32 && nInf < (1 << 24))))
+    {
+        GDALDriverH hDriver = GDALGetDriverByName("GTiff");
+        if (hDriver == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "GDALComputeProximity needs GTiff driver");
+            return CE_Failure;
+        }
+        CPLString osTmpFile = CPLGenerateTempFilename("proximity");
+        hWorkProximityDS = GDALCreate(hDriver, osTmpFile, nXSize, nYSize, 1,
+                                      GDT_Int32, nullptr);
+        if (hWorkProximityDS == nullptr)
+            return CE_Failure;
+        bTempFileAlreadyDeleted = VSIUnlink(osTmpFile) == 0;
+        hWorkProximityBand = GDALGetRasterBand(hWorkProximityDS, 1);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Allocate strip buffers.                                         */
+    /* -------------------------------------------------------------------- */
+    constexpr int MAX_BYTES_PER_STRIP = 64 * 1024 * 1024;
+    int nLinesPerStrip = std::max(
+        1, static_cast<int>(std::min<GIntBig>(
+               nYSize, MAX_BYTES_PER_STRIP /
+                           (static_cast<GIntBig>(nXSize) *
+                            (sizeof(GInt32) + sizeof(float))))));
+    const char *pszLinesPerStrip =
+        CPLGetConfigOption("GDAL_PROXIMITY_LINES_PER_STRIP", nullptr);
+    if (pszLinesPerStrip)
+        nLinesPerStrip = std::max(1, std::min(nYSize, atoi(pszLinesPerStrip)));
+
+    std::vector<GInt32> anStrip;
+    std::vector<float> afProximity;
+    std::vector<int> anLastG;
+    try
+    {
+        anStrip.resize(static_cast<size_t>(nLinesPerStrip) * nXSize);
+        afProximity.resize(static_cast<size_t>(nLinesPerStrip) * nXSize);
+        anLastG.resize(nXSize, nInf);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate proximity working buffers");
+        if (hWorkProximityDS)
+            GDALClose(hWorkProximityDS);
+        return CE_Failure;
+    }
+
+    const int nStrips = (nYSize + nLinesPerStrip - 1) / nLinesPerStrip;
+    CPLErr eErr = CE_None;
+
+    /* -------------------------------------------------------------------- */
+    /*      Top to bottom: distance to the nearest target above.            */
+    /* -------------------------------------------------------------------- */
+    for (int iStrip = 0; eErr == CE_None && iStrip < nStrips; iStrip++)
+    {
+        const int nYOff = iStrip * nLinesPerStrip;
+        const int nLines = std::min(nLinesPerStrip, nYSize - nYOff);
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, nYOff, nXSize, nLines,
+                            anStrip.data(), nXSize, nLines, GDT_Int32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        GDALProximityRunParallel(
+            nThreads, nXSize,
+            [&anStrip, &anLastG, nLines, nXSize, nInf, pdfSrcNoDataValue,
+             nTargetValues, panTargetValues](int nXStart, int nXEnd)
+            {
+                for (int iLine = 0; iLine < nLines; iLine++)
+                {
+                    GInt32 *panLine =
+                        anStrip.data() + static_cast<size_t>(iLine) * nXSize;
+                    for (int i = nXStart; i < nXEnd; i++)
+                    {
+                        const GInt32 nVal = panLine[i];
+                        bool bIsTarget = false;
+                        if (nTargetValues == 0)
+                        {
+                            bIsTarget = nVal != 0;
+                        }
+                        else
+                        {
+                            for (int j = 0; j < nTargetValues; j++)
+                            {
+                                if (nVal == panTargetValues[j])
+                                    bIsTarget = true;
+                            }
+                        }
+
+                        const int nG =
+                            bIsTarget ? 0 : std::min(anLastG[i] + 1, nInf);
+                        anLastG[i] = nG;
+                        panLine[i] = (!bIsTarget && pdfSrcNoDataValue &&
+                                      nVal == *pdfSrcNoDataValue)
+                                         ? -1 - nG
+                                         : nG;
+                    }
+                }
+            });
+
+        eErr = GDALRasterIO(hWorkProximityBand, GF_Write, 0, nYOff, nXSize,
+                            nLines, anStrip.data(), nXSize, nLines, GDT_Int32,
+                            0, 0);
+        if (eErr != CE_None)
+            break;
+
+        if (!pfnProgress(0.5 * (nYOff + nLines) / static_cast<double>(nYSize),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Bottom to top: complete with the nearest target below, and      */
+    /*      compute the final distances of each line.                       */
+    /* -------------------------------------------------------------------- */
+    std::fill(anLastG.begin(), anLastG.end(), nInf);
+    for (int iStrip = nStrips - 1; eErr == CE_None && iStrip >= 0; iStrip--)
+    {
+        const int nYOff = iStrip * nLinesPerStrip;
+        const int nLines = std::min(nLinesPerStrip, nYSize - nYOff);
+        eErr = GDALRasterIO(hWorkProximityBand, GF_Read, 0, nYOff, nXSize,
+                            nLines, anStrip.data(), nXSize, nLines, GDT_Int32,
+                            0, 0);
+        if (eErr != CE_None)
+            break;
+
+        GDALProximityRunParallel(
+            nThreads, nXSize,
+            [&anStrip, &anLastG, nLines, nXSize, nInf](int nXStart, int nXEnd)
+            {
+                for (int iLine = nLines - 1; iLine >= 0; iLine--)
+                {
+                    GInt32 *panLine =
+                        anStrip.data() + static_cast<size_t>(iLine) * nXSize;
+                    for (int i = nXStart; i < nXEnd; i++)
+                    {
+                        const bool bNoData = panLine[i] < 0;
+                        const int nG =
+                            std::min(bNoData ? -1 - panLine[i] : panLine[i],
+                                     std::min(anLastG[i] + 1, nInf));
+                        anLastG[i] = nG;
+                        panLine[i] = bNoData ? -1 - nG : nG;
+                    }
+                }
+            });
+
+        std::atomic<bool> bOutOfMemory{false};
+        GDALProximityRunParallel(
+            nThreads, nLines,
+            [&anStrip, &afProximity, &bOutOfMemory, nXSize, nInf, dfMaxDist,
+             dfDistMult, fNoDataValue, bFixedBufVal,
+             dfFixedBufVal](int iLineStart, int iLineEnd)
+            {
+                std::vector<int> anG, anS, anT;
+                std::vector<GIntBig> anDistSq;
+                try
+                {
+                    anG.resize(nXSize);
+                    anS.resize(nXSize);
+                    anT.resize(nXSize);
+                    anDistSq.resize(nXSize);
+                }
+                catch (const std::exception &)
+                {
+                    bOutOfMemory = true;
+                    return;
+                }
+
+                const double dfMaxDistSq = dfMaxDist * dfMaxDist;
+                for (int iLine = iLineStart; iLine < iLineEnd; iLine++)
+                {
+                    const GInt32 *panLine =
+                        anStrip.data() + static_cast<size_t>(iLine) * nXSize;
+                    float *pafLine = afProximity.data() +
+                                     static_cast<size_t>(iLine) * nXSize;
+                    for (int i = 0; i < nXSize; i++)
+                        anG[i] = panLine[i] < 0 ? -1 - panLine[i] : panLine[i];
+
+                    if (!ProcessProximityRowExact(anG.data(), nXSize, nInf,
+                                                  anS.data(), anT.data(),
+                                                  anDistSq.data()))
+                    {
+                        std::fill(pafLine, pafLine + nXSize, fNoDataValue);
+                        continue;
+                    }
+
+                    for (int i = 0; i < nXSize; i++)
+                    {
+                        const GIntBig nDistSq = anDistSq[i];
+                        if (nDistSq == 0)
+                            pafLine[i] = 0.0f;
+                        else if (panLine[i] < 0 ||
+                                 static_cast<double>(nDistSq) > dfMaxDistSq)
+                            pafLine[i] = fNoDataValue;
+                        else if (bFixedBufVal)
+                            pafLine[i] = static_cast<float>(dfFixedBufVal);
+                        else
+                            pafLine[i] = static_cast<float>(
+                                static_cast<float>(
+                                    sqrt(static_cast<double>(nDistSq))) *
+                                dfDistMult);
+                    }
+                }
+            });
+        if (bOutOfMemory)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate proximity working buffers");
+            eErr = CE_Failure;
+            break;
+        }
+
+        eErr = GDALRasterIO(hProximityBand, GF_Write, 0, nYOff, nXSize, nLines,
+                            afProximity.data(), nXSize, nLines, GDT_Float32, 0,
+                            0);
+        if (eErr != CE_None)
+            break;
+
+        if (!pfnProgress(0.5 + 0.5 * (nYSize - nYOff) /
+                                   static_cast<double>(nYSize),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    if (hWorkProximityDS != nullptr)
+    {
+        CPLString osProxFile = GDALGetDescription(hWorkProximityDS);
+        GDALClose(hWorkProximityDS);
+        if (!bTempFileAlreadyDeleted)
+        {
+            GDALDeleteDataset(GDALGetDriverByName("GTiff"), osProxFile);
+        }
+    }
+
+    return eErr;
+}
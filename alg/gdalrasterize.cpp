@@ -32,6 +32,7 @@
 #include "gdal_alg_priv.h"
 
 #include <climits>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
@@ -48,6 +49,7 @@
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -485,16 +487,35 @@ static void GDALCollectRingsFromGeometry(const OGRGeometry *poShape,
 }
 
 /************************************************************************/
-/*                       gv_rasterize_one_shape()                       */
+/*                          GDALRasterizeShape                          */
+/*                                                                      */
+/*      Rings of a geometry (or of one of its parts), transformed to    */
+/*      pixel/line coordinates, and that can be burnt in any window     */
+/*      of the raster.                                                  */
+/************************************************************************/
+
+namespace
+{
+struct GDALRasterizeShape
+{
+    OGRwkbGeometryType eGeomType = wkbUnknown;
+    std::vector<double> aPointX{};
+    std::vector<double> aPointY{};
+    std::vector<double> aPointVariant{};
+    std::vector<int> aPartSize{};
+};
+}  // namespace
+
+/************************************************************************/
+/*                      GDALRasterizePrepareShape()                     */
 /************************************************************************/
-static void gv_rasterize_one_shape(
-    unsigned char *pabyChunkBuf, int nXOff, int nYOff, int nXSize, int nYSize,
-    int nBands, GDALDataType eType, int nPixelSpace, GSpacing nLineSpace,
-    GSpacing nBandSpace, int bAllTouched, const OGRGeometry *poShape,
-    GDALDataType eBurnValueType, const double *padfBurnValues,
-    const int64_t *panBurnValues, GDALBurnValueSrc eBurnValueSrc,
-    GDALRasterMergeAlg eMergeAlg, GDALTransformerFunc pfnTransformer,
-    void *pTransformArg)
+
+static void GDALRasterizePrepareShape(const OGRGeometry *poShape,
+                                      GDALBurnValueSrc eBurnValueSrc,
+                                      GDALRasterMergeAlg eMergeAlg,
+                                      GDALTransformerFunc pfnTransformer,
+                                      void *pTransformArg,
+                                      std::vector<GDALRasterizeShape> &aoShapes)
 
 {
     if (poShape == nullptr || poShape->IsEmpty())
@@ -510,15 +531,53 @@ static void gv_rasterize_one_shape(
         const auto poGC = poShape->toGeometryCollection();
         for (const auto poPart : *poGC)
         {
-            gv_rasterize_one_shape(
-                pabyChunkBuf, nXOff, nYOff, nXSize, nYSize, nBands, eType,
-                nPixelSpace, nLineSpace, nBandSpace, bAllTouched, poPart,
-                eBurnValueType, padfBurnValues, panBurnValues, eBurnValueSrc,
-                eMergeAlg, pfnTransformer, pTransformArg);
+            GDALRasterizePrepareShape(poPart, eBurnValueSrc, eMergeAlg,
+                                      pfnTransformer, pTransformArg, aoShapes);
         }
         return;
     }
 
+    aoShapes.emplace_back();
+    GDALRasterizeShape &oShape = aoShapes.back();
+    oShape.eGeomType = eGeomType;
+
+    /* -------------------------------------------------------------------- */
+    /*      Transform polygon geometries into a set of rings and a part     */
+    /*      size list.                                                      */
+    /* -------------------------------------------------------------------- */
+    GDALCollectRingsFromGeometry(poShape, oShape.aPointX, oShape.aPointY,
+                                 oShape.aPointVariant, oShape.aPartSize,
+                                 eBurnValueSrc);
+
+    /* -------------------------------------------------------------------- */
+    /*      Transform points if needed.                                     */
+    /* -------------------------------------------------------------------- */
+    if (pfnTransformer != nullptr)
+    {
+        int *panSuccess =
+            static_cast<int *>(CPLCalloc(sizeof(int), oShape.aPointX.size()));
+
+        // TODO: We need to add all appropriate error checking at some point.
+        pfnTransformer(pTransformArg, FALSE,
+                       static_cast<int>(oShape.aPointX.size()),
+                       oShape.aPointX.data(), oShape.aPointY.data(), nullptr,
+                       panSuccess);
+        CPLFree(panSuccess);
+    }
+}
+
+/************************************************************************/
+/*                     gv_rasterize_prepared_shape()                    */
+/************************************************************************/
+static void gv_rasterize_prepared_shape(
+    unsigned char *pabyChunkBuf, int nXOff, int nYOff, int nXSize, int nYSize,
+    int nBands, GDALDataType eType, int nPixelSpace, GSpacing nLineSpace,
+    GSpacing nBandSpace, int bAllTouched, const GDALRasterizeShape &oShape,
+    GDALDataType eBurnValueType, const double *padfBurnValues,
+    const int64_t *panBurnValues, GDALBurnValueSrc eBurnValueSrc,
+    GDALRasterMergeAlg eMergeAlg)
+
+{
     if (nPixelSpace == 0)
     {
         nPixelSpace = GDALGetDataTypeSizeBytes(eType);
@@ -553,47 +612,26 @@ static void gv_rasterize_one_shape(
     sInfo.eBurnValueSource = eBurnValueSrc;
     sInfo.eMergeAlg = eMergeAlg;
 
-    /* -------------------------------------------------------------------- */
-    /*      Transform polygon geometries into a set of rings and a part     */
-    /*      size list.                                                      */
-    /* -------------------------------------------------------------------- */
-    std::vector<double> aPointX;
-    std::vector<double> aPointY;
-    std::vector<double> aPointVariant;
-    std::vector<int> aPartSize;
-
-    GDALCollectRingsFromGeometry(poShape, aPointX, aPointY, aPointVariant,
-                                 aPartSize, eBurnValueSrc);
-
-    /* -------------------------------------------------------------------- */
-    /*      Transform points if needed.                                     */
-    /* -------------------------------------------------------------------- */
-    if (pfnTransformer != nullptr)
-    {
-        int *panSuccess =
-            static_cast<int *>(CPLCalloc(sizeof(int), aPointX.size()));
-
-        // TODO: We need to add all appropriate error checking at some point.
-        pfnTransformer(pTransformArg, FALSE, static_cast<int>(aPointX.size()),
-                       aPointX.data(), aPointY.data(), nullptr, panSuccess);
-        CPLFree(panSuccess);
-    }
-
     /* -------------------------------------------------------------------- */
     /*      Shift to account for the buffer offset of this buffer.          */
     /* -------------------------------------------------------------------- */
+    std::vector<double> aPointX(oShape.aPointX);
+    std::vector<double> aPointY(oShape.aPointY);
     for (unsigned int i = 0; i < aPointX.size(); i++)
         aPointX[i] -= nXOff;
     for (unsigned int i = 0; i < aPointY.size(); i++)
         aPointY[i] -= nYOff;
 
+    const std::vector<int> &aPartSize = oShape.aPartSize;
+    const std::vector<double> &aPointVariant = oShape.aPointVariant;
+
     /* -------------------------------------------------------------------- */
     /*      Perform the rasterization.                                      */
     /*      According to the C++ Standard/23.2.4, elements of a vector are  */
     /*      stored in continuous memory block.                              */
     /* -------------------------------------------------------------------- */
 
-    switch (eGeomType)
+    switch (oShape.eGeomType)
     {
         case wkbPoint:
         case wkbMultiPoint:
@@ -648,18 +686,15 @@ static void gv_rasterize_one_shape(
                 }
                 else
                 {
-                    for (unsigned int i = 0, n = 0;
-                         i < static_cast<unsigned int>(aPartSize.size()); i++)
-                    {
-                        for (int j = 0; j < aPartSize[i]; j++)
-                            aPointVariant[n++] = aPointVariant[0];
-                    }
+                    std::vector<double> aPointVariantFirst(
+                        aPointVariant.size(), aPointVariant[0]);
 
                     GDALdllImageLineAllTouched(
                         sInfo.nXSize, nYSize,
                         static_cast<int>(aPartSize.size()), aPartSize.data(),
-                        aPointX.data(), aPointY.data(), aPointVariant.data(),
-                        gvBurnPoint, &sInfo, eMergeAlg == GRMA_Add, true);
+                        aPointX.data(), aPointY.data(),
+                        aPointVariantFirst.data(), gvBurnPoint, &sInfo,
+                        eMergeAlg == GRMA_Add, true);
                 }
             }
         }
@@ -667,6 +702,32 @@ static void gv_rasterize_one_shape(
     }
 }
 
+/************************************************************************/
+/*                       gv_rasterize_one_shape()                       */
+/************************************************************************/
+static void gv_rasterize_one_shape(
+    unsigned char *pabyChunkBuf, int nXOff, int nYOff, int nXSize, int nYSize,
+    int nBands, GDALDataType eType, int nPixelSpace, GSpacing nLineSpace,
+    GSpacing nBandSpace, int bAllTouched, const OGRGeometry *poShape,
+    GDALDataType eBurnValueType, const double *padfBurnValues,
+    const int64_t *panBurnValues, GDALBurnValueSrc eBurnValueSrc,
+    GDALRasterMergeAlg eMergeAlg, GDALTransformerFunc pfnTransformer,
+    void *pTransformArg)
+
+{
+    std::vector<GDALRasterizeShape> aoShapes;
+    GDALRasterizePrepareShape(poShape, eBurnValueSrc, eMergeAlg,
+                              pfnTransformer, pTransformArg, aoShapes);
+    for (const auto &oShape : aoShapes)
+    {
+        gv_rasterize_prepared_shape(
+            pabyChunkBuf, nXOff, nYOff, nXSize, nYSize, nBands, eType,
+            nPixelSpace, nLineSpace, nBandSpace, bAllTouched, oShape,
+            eBurnValueType, padfBurnValues, panBurnValues, eBurnValueSrc,
+            eMergeAlg);
+    }
+}
+
 /************************************************************************/
 /*                        GDALRasterizeOptions()                        */
 /*                                                                      */
@@ -752,6 +813,392 @@ static CPLErr GDALRasterizeOptions(CSLConstList papszOptions, int *pbAllTouched,
     return CE_None;
 }
 
+/************************************************************************/
+/*                       GDALRasterizeTileSize()                        */
+/*                                                                      */
+/*      Size along one axis of the tiles processed by each thread in    */
+/*      multi-threaded mode: about 512 pixels, rounded to a multiple    */
+/*      of the block size. Can be overridden with the                   */
+/*      GDAL_RASTERIZE_TILE_SIZE configuration option (mostly for       */
+/*      testing purposes).                                              */
+/************************************************************************/
+
+static int GDALRasterizeTileSize(int nBlockSize, int nRasterSize)
+{
+    const char *pszTileSize =
+        CPLGetConfigOption("GDAL_RASTERIZE_TILE_SIZE", nullptr);
+    int nTileSize = pszTileSize ? std::max(1, atoi(pszTileSize)) : 512;
+    if (!pszTileSize && nBlockSize > 0)
+    {
+        nTileSize = std::max(1, nTileSize / nBlockSize) * nBlockSize;
+    }
+    return std::min(nTileSize, nRasterSize);
+}
+
+namespace
+{
+// Shapes of one geometry, and the pixel extent they cover.
+struct GDALRasterizeGeomShapes
+{
+    std::vector<GDALRasterizeShape> aoShapes{};
+    int nMinX = 0;
+    int nMinY = 0;
+    int nMaxX = -1;
+    int nMaxY = -1;
+};
+
+struct GDALRasterizePrepareJob
+{
+    const OGRGeometryH *pahGeometries = nullptr;
+    std::vector<GDALRasterizeGeomShapes> *paoGeomShapes = nullptr;
+    int nStart = 0;
+    int nEnd = 0;
+    GDALBurnValueSrc eBurnValueSrc = GBV_UserBurnValue;
+    GDALRasterMergeAlg eMergeAlg = GRMA_Replace;
+    GDALTransformerFunc pfnTransformer = nullptr;
+    void *pTransformArg = nullptr;
+    int nRasterXSize = 0;
+    int nRasterYSize = 0;
+};
+
+struct GDALRasterizeTileJob
+{
+    const std::vector<GDALRasterizeGeomShapes> *paoGeomShapes = nullptr;
+    const std::vector<int> *panGeoms = nullptr;
+    std::vector<GByte> abyBuffer{};
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+    int nBandCount = 0;
+    GDALDataType eType = GDT_Unknown;
+    int bAllTouched = FALSE;
+    GDALDataType eBurnValueType = GDT_Float64;
+    const double *padfGeomBurnValues = nullptr;
+    const int64_t *panGeomBurnValues = nullptr;
+    GDALBurnValueSrc eBurnValueSrc = GBV_UserBurnValue;
+    GDALRasterMergeAlg eMergeAlg = GRMA_Replace;
+};
+}  // namespace
+
+/************************************************************************/
+/*                     GDALRasterizeComputeExtent()                     */
+/*                                                                      */
+/*      Compute the extent, in pixels of the raster, that may be        */
+/*      touched by the shapes of a geometry.                            */
+/************************************************************************/
+
+static void GDALRasterizeComputeExtent(GDALRasterizeGeomShapes &oGeomShapes,
+                                       int nRasterXSize, int nRasterYSize)
+{
+    double dfMinX = std::numeric_limits<double>::infinity();
+    double dfMinY = std::numeric_limits<double>::infinity();
+    double dfMaxX = -std::numeric_limits<double>::infinity();
+    double dfMaxY = -std::numeric_limits<double>::infinity();
+    bool bHasPoints = false;
+    bool bInvalid = false;
+    for (const auto &oShape : oGeomShapes.aoShapes)
+    {
+        for (size_t i = 0; i < oShape.aPointX.size(); i++)
+        {
+            const double dfX = oShape.aPointX[i];
+            const double dfY = oShape.aPointY[i];
+            if (!std::isfinite(dfX) || !std::isfinite(dfY))
+                bInvalid = true;
+            dfMinX = std::min(dfMinX, dfX);
+            dfMinY = std::min(dfMinY, dfY);
+            dfMaxX = std::max(dfMaxX, dfX);
+            dfMaxY = std::max(dfMaxY, dfY);
+            bHasPoints = true;
+        }
+    }
+    if (!bHasPoints)
+        return;
+
+    if (bInvalid)
+    {
+        // Let the rasterization routines deal with such coordinates on the
+        // whole raster, as in the single-threaded code path.
+        oGeomShapes.nMinX = 0;
+        oGeomShapes.nMinY = 0;
+        oGeomShapes.nMaxX = nRasterXSize - 1;
+        oGeomShapes.nMaxY = nRasterYSize - 1;
+        return;
+    }
+
+    // Margin of one pixel to account for the rounding of the line and
+    // point rasterization routines.
+    oGeomShapes.nMinX = static_cast<int>(std::min(
+        1.0 * nRasterXSize, std::max(0.0, std::floor(dfMinX) - 1)));
+    oGeomShapes.nMinY = static_cast<int>(std::min(
+        1.0 * nRasterYSize, std::max(0.0, std::floor(dfMinY) - 1)));
+    oGeomShapes.nMaxX = static_cast<int>(
+        std::max(-1.0, std::min(nRasterXSize - 1.0, std::floor(dfMaxX) + 1)));
+    oGeomShapes.nMaxY = static_cast<int>(
+        std::max(-1.0, std::min(nRasterYSize - 1.0, std::floor(dfMaxY) + 1)));
+}
+
+/************************************************************************/
+/*                      GDALRasterizePrepareFunc()                      */
+/*                                                                      */
+/*      Prepare the shapes of geometries [nStart, nEnd[ and compute     */
+/*      their extent.                                                   */
+/************************************************************************/
+
+static void GDALRasterizePrepareFunc(void *pData)
+{
+    auto psJob = static_cast<GDALRasterizePrepareJob *>(pData);
+    for (int iGeom = psJob->nStart; iGeom < psJob->nEnd; iGeom++)
+    {
+        GDALRasterizeGeomShapes &oGeomShapes = (*psJob->paoGeomShapes)[iGeom];
+        GDALRasterizePrepareShape(
+            OGRGeometry::FromHandle(psJob->pahGeometries[iGeom]),
+            psJob->eBurnValueSrc, psJob->eMergeAlg, psJob->pfnTransformer,
+            psJob->pTransformArg, oGeomShapes.aoShapes);
+        GDALRasterizeComputeExtent(oGeomShapes, psJob->nRasterXSize,
+                                   psJob->nRasterYSize);
+    }
+}
+
+/************************************************************************/
+/*                        GDALRasterizeTileFunc()                       */
+/************************************************************************/
+
+static void GDALRasterizeTileFunc(void *pData)
+{
+    auto psJob = static_cast<GDALRasterizeTileJob *>(pData);
+    const int nBandCount = psJob->nBandCount;
+    for (const int iGeom : *(psJob->panGeoms))
+    {
+        for (const auto &oShape : (*psJob->paoGeomShapes)[iGeom].aoShapes)
+        {
+            gv_rasterize_prepared_shape(
+                psJob->abyBuffer.data(), psJob->nXOff, psJob->nYOff,
+                psJob->nXSize, psJob->nYSize, nBandCount, psJob->eType, 0, 0,
+                0, psJob->bAllTouched, oShape, psJob->eBurnValueType,
+                psJob->padfGeomBurnValues
+                    ? psJob->padfGeomBurnValues +
+                          static_cast<size_t>(iGeom) * nBandCount
+                    : nullptr,
+                psJob->panGeomBurnValues
+                    ? psJob->panGeomBurnValues +
+                          static_cast<size_t>(iGeom) * nBandCount
+                    : nullptr,
+                psJob->eBurnValueSrc, psJob->eMergeAlg);
+        }
+    }
+}
+
+/************************************************************************/
+/*                     GDALRasterizeGeometriesMT()                      */
+/*                                                                      */
+/*      Multi-threaded rasterization. The geometries are transformed    */
+/*      to pixel coordinates once, and indexed on a grid of tiles.      */
+/*      Tiles are then read, burnt by the worker threads and written    */
+/*      back by batches. Within a tile, geometries are burnt in their   */
+/*      input order, so the result does not depend on the number of     */
+/*      threads.                                                        */
+/************************************************************************/
+
+static CPLErr GDALRasterizeGeometriesMT(
+    GDALDataset *poDS, GDALRasterBand *poBand, int nBandCount,
+    const int *panBandList, int nGeomCount, const OGRGeometryH *pahGeometries,
+    GDALTransformerFunc pfnTransformer, void *pTransformArg,
+    bool bCanCloneTransformer, GDALDataType eBurnValueType,
+    const double *padfGeomBurnValues, const int64_t *panGeomBurnValues,
+    int bAllTouched, GDALBurnValueSrc eBurnValueSource,
+    GDALRasterMergeAlg eMergeAlg, int nThreads, CPLJobQueue *poJobQueue,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nRasterXSize = poDS->GetRasterXSize();
+    const int nRasterYSize = poDS->GetRasterYSize();
+
+    pfnProgress(0.0, nullptr, pProgressArg);
+
+    /* -------------------------------------------------------------------- */
+    /*      Transform the geometries to pixel coordinates. Transformers     */
+    /*      are not thread-safe: this is done in parallel only if we can    */
+    /*      clone the one we created.                                       */
+    /* -------------------------------------------------------------------- */
+    std::vector<GDALRasterizeGeomShapes> aoGeomShapes(nGeomCount);
+    {
+        const int nPrepareJobs =
+            bCanCloneTransformer ? std::min(nThreads, nGeomCount) : 1;
+        std::vector<GDALRasterizePrepareJob> asJobs(nPrepareJobs);
+        bool bOK = true;
+        for (int i = 0; i < nPrepareJobs; i++)
+        {
+            auto &sJob = asJobs[i];
+            sJob.pahGeometries = pahGeometries;
+            sJob.paoGeomShapes = &aoGeomShapes;
+            sJob.nStart = static_cast<int>(
+                static_cast<GIntBig>(nGeomCount) * i / nPrepareJobs);
+            sJob.nEnd = static_cast<int>(static_cast<GIntBig>(nGeomCount) *
+                                         (i + 1) / nPrepareJobs);
+            sJob.eBurnValueSrc = eBurnValueSource;
+            sJob.eMergeAlg = eMergeAlg;
+            sJob.pfnTransformer = pfnTransformer;
+            sJob.pTransformArg = pTransformArg;
+            if (i > 0)
+            {
+                sJob.pTransformArg = GDALCloneTransformer(pTransformArg);
+                if (sJob.pTransformArg == nullptr)
+                {
+                    bOK = false;
+                    break;
+                }
+            }
+            sJob.nRasterXSize = nRasterXSize;
+            sJob.nRasterYSize = nRasterYSize;
+        }
+        if (bOK)
+        {
+            for (int i = 1; i < nPrepareJobs; i++)
+                poJobQueue->SubmitJob(GDALRasterizePrepareFunc, &asJobs[i]);
+            GDALRasterizePrepareFunc(&asJobs[0]);
+            poJobQueue->WaitCompletion();
+        }
+        for (int i = 1; i < nPrepareJobs; i++)
+        {
+            if (asJobs[i].pTransformArg)
+                GDALDestroyTransformer(asJobs[i].pTransformArg);
+        }
+        if (!bOK)
+            return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Index the geometries on a grid of tiles aligned on blocks.      */
+    /* -------------------------------------------------------------------- */
+    int nXBlockSize = 0;
+    int nYBlockSize = 0;
+    poBand->GetBlockSize(&nXBlockSize, &nYBlockSize);
+    const int nTileXSize = GDALRasterizeTileSize(nXBlockSize, nRasterXSize);
+    const int nTileYSize = GDALRasterizeTileSize(nYBlockSize, nRasterYSize);
+    const int nTilesX = (nRasterXSize + nTileXSize - 1) / nTileXSize;
+    const int nTilesY = (nRasterYSize + nTileYSize - 1) / nTileYSize;
+
+    std::vector<std::vector<int>> aanTileGeoms(static_cast<size_t>(nTilesX) *
+                                               nTilesY);
+    for (int iGeom = 0; iGeom < nGeomCount; iGeom++)
+    {
+        const auto &oGeomShapes = aoGeomShapes[iGeom];
+        if (oGeomShapes.nMaxX < oGeomShapes.nMinX ||
+            oGeomShapes.nMaxY < oGeomShapes.nMinY)
+            continue;
+        for (int iTileY = oGeomShapes.nMinY / nTileYSize;
+             iTileY <= oGeomShapes.nMaxY / nTileYSize; iTileY++)
+        {
+            for (int iTileX = oGeomShapes.nMinX / nTileXSize;
+                 iTileX <= oGeomShapes.nMaxX / nTileXSize; iTileX++)
+            {
+                aanTileGeoms[static_cast<size_t>(iTileY) * nTilesX + iTileX]
+                    .push_back(iGeom);
+            }
+        }
+    }
+
+    std::vector<int> anTiles;
+    for (size_t i = 0; i < aanTileGeoms.size(); i++)
+    {
+        if (!aanTileGeoms[i].empty())
+            anTiles.push_back(static_cast<int>(i));
+    }
+
+    CPLDebug("GDAL",
+             "Rasterizer operating on %d non-empty tiles of %dx%d pixels "
+             "with %d threads.",
+             static_cast<int>(anTiles.size()), nTileXSize, nTileYSize,
+             nThreads);
+
+    /* -------------------------------------------------------------------- */
+    /*      Process the tiles by batches: the tiles are read and written    */
+    /*      by the current thread, and burnt by the worker threads.         */
+    /* -------------------------------------------------------------------- */
+    const GDALDataType eType =
+        GDALGetNonComplexDataType(poBand->GetRasterDataType());
+    const int nDTSize = GDALGetDataTypeSizeBytes(eType);
+    const int nTilesPerBatch = nThreads * 4;
+    std::vector<GDALRasterizeTileJob> asJobs;
+    CPLErr eErr = CE_None;
+    for (size_t iBatchStart = 0;
+         iBatchStart < anTiles.size() && eErr == CE_None;
+         iBatchStart += nTilesPerBatch)
+    {
+        const size_t iBatchEnd =
+            std::min(anTiles.size(), iBatchStart + nTilesPerBatch);
+        asJobs.resize(iBatchEnd - iBatchStart);
+        for (size_t i = iBatchStart; i < iBatchEnd && eErr == CE_None; i++)
+        {
+            const int iTile = anTiles[i];
+            auto &sJob = asJobs[i - iBatchStart];
+            sJob.paoGeomShapes = &aoGeomShapes;
+            sJob.panGeoms = &aanTileGeoms[iTile];
+            sJob.nXOff = (iTile % nTilesX) * nTileXSize;
+            sJob.nYOff = (iTile / nTilesX) * nTileYSize;
+            sJob.nXSize = std::min(nTileXSize, nRasterXSize - sJob.nXOff);
+            sJob.nYSize = std::min(nTileYSize, nRasterYSize - sJob.nYOff);
+            sJob.nBandCount = nBandCount;
+            sJob.eType = eType;
+            sJob.bAllTouched = bAllTouched;
+            sJob.eBurnValueType = eBurnValueType;
+            sJob.padfGeomBurnValues = padfGeomBurnValues;
+            sJob.panGeomBurnValues = panGeomBurnValues;
+            sJob.eBurnValueSrc = eBurnValueSource;
+            sJob.eMergeAlg = eMergeAlg;
+            try
+            {
+                sJob.abyBuffer.resize(static_cast<size_t>(sJob.nXSize) *
+                                      sJob.nYSize * nBandCount * nDTSize);
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate tile buffer");
+                eErr = CE_Failure;
+                break;
+            }
+
+            eErr = poDS->RasterIO(
+                GF_Read, sJob.nXOff, sJob.nYOff, sJob.nXSize, sJob.nYSize,
+                sJob.abyBuffer.data(), sJob.nXSize, sJob.nYSize, eType,
+                nBandCount, const_cast<int *>(panBandList), 0, 0, 0, nullptr);
+        }
+        if (eErr != CE_None)
+            break;
+
+        for (auto &sJob : asJobs)
+            poJobQueue->SubmitJob(GDALRasterizeTileFunc, &sJob);
+        poJobQueue->WaitCompletion();
+
+        for (auto &sJob : asJobs)
+        {
+            eErr = poDS->RasterIO(
+                GF_Write, sJob.nXOff, sJob.nYOff, sJob.nXSize, sJob.nYSize,
+                sJob.abyBuffer.data(), sJob.nXSize, sJob.nYSize, eType,
+                nBandCount, const_cast<int *>(panBandList), 0, 0, 0, nullptr);
+            if (eErr != CE_None)
+                break;
+        }
+
+        if (eErr == CE_None &&
+            !pfnProgress(static_cast<double>(iBatchEnd) / anTiles.size(), "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    if (eErr == CE_None && !pfnProgress(1.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        eErr = CE_Failure;
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                      GDALRasterizeGeometries()                       */
 /************************************************************************/
@@ -812,6 +1259,12 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * used. Default size will be estimated based on the GDAL cache buffer size
  * using formula: cache_size_bytes/scanline_size_bytes, so the chunk will
  * not exceed the cache. Not used in OPTIM=RASTER mode.</li>
+ * <li>"NUM_THREADS": (GDAL >= 3.8) Number of worker threads, or "ALL_CPUS".
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ * When greater than 1, the raster is split into tiles of about 512x512
+ * pixels, aligned on blocks, that are burnt concurrently with the geometries
+ * that intersect them, in their input order. The OPTIM and CHUNKYSIZE
+ * options are then ignored.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -992,6 +1445,26 @@ static CPLErr GDALRasterizeGeometriesInternal(
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Multi-threaded mode, that does not use the OPTIM setting.       */
+    /* -------------------------------------------------------------------- */
+    const int nThreads = GDALGetNumThreads(papszOptions, true);
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    if (poJobQueue)
+    {
+        const CPLErr eErr = GDALRasterizeGeometriesMT(
+            poDS, poBand, nBandCount, panBandList, nGeomCount, pahGeometries,
+            pfnTransformer, pTransformArg, bNeedToFreeTransformer,
+            eBurnValueType, padfGeomBurnValues, panGeomBurnValues, bAllTouched,
+            eBurnValueSource, eMergeAlg, nThreads, poJobQueue.get(),
+            pfnProgress, pProgressArg);
+        if (bNeedToFreeTransformer)
+            GDALDestroyTransformer(pTransformArg);
+        return eErr;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Choice of optimisation in auto mode. Use vector optim :         */
     /*      1) if output is tiled                                           */
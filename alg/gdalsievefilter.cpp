@@ -30,9 +30,13 @@
 #include "cpl_port.h"
 #include "gdal_alg.h"
 
+#include <climits>
 #include <cstring>
 
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include <new>
 #include <set>
 #include <vector>
 #include <utility>
@@ -40,9 +44,12 @@
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_alg_priv.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
@@ -143,6 +150,826 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
         anBigNeighbour[nPolyId2] = nPolyId1;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*      Strip based sieve filter.                                       */
+/*                                                                      */
+/*      The raster is split in strips of lines, that are labeled       */
+/*      independently (and possibly in parallel), each one together     */
+/*      with the last line of the previous strip.                       */
+/*                                                                      */
+/*      1) A first pass computes the size of each polygon, by           */
+/*         stitching strips in order with a union-find structure that   */
+/*         only holds the polygons touching the last processed line.    */
+/*         Only the sizes of the polygons touching the first or last    */
+/*         line of a strip need to be kept.                             */
+/*                                                                      */
+/*      2) A second pass labels strips again, and for each polygon      */
+/*         smaller than the threshold, records its pixels and its       */
+/*         largest neighbour (the first one met in raster order in      */
+/*         case of ties, as in the default algorithm).  Small polygons  */
+/*         crossing strips are stitched together.                       */
+/*                                                                      */
+/*      3) The chains of largest neighbours are followed for small      */
+/*         polygons, and only the strips that have changed pixels are   */
+/*         rewritten (all strips if the output is not the input band).  */
+/* ==================================================================== */
+/************************************************************************/
+
+namespace
+{
+
+// A run of pixels of a polygon smaller than the threshold.
+struct GSRun
+{
+    int nY;
+    int nX;
+    int nLength;
+    int nSmallPoly;  // index of the polygon in the strip, then globally
+};
+
+// A polygon smaller than the threshold, and its largest neighbour.
+struct GSSmallPoly
+{
+    int nId = 0;  // polygon id in its strip, then union-find parent
+    int nBestSize = -1;     // size of the largest neighbour, -1 if none
+    int nBestSmallId = -1;  // index of the largest neighbour if it is small
+    GIntBig nBestPos = 0;   // position of the first contact with it
+    std::int64_t nBestValue = 0;
+
+    void UpdateBest(int nOtherSize, GIntBig nPos, std::int64_t nOtherValue,
+                    int nOtherSmallId)
+    {
+        if (nBestSize < nOtherSize ||
+            (nBestSize == nOtherSize && nPos < nBestPos))
+        {
+            nBestSize = nOtherSize;
+            nBestPos = nPos;
+            nBestValue = nOtherValue;
+            nBestSmallId = nOtherSmallId;
+        }
+    }
+};
+
+struct GSStrip
+{
+    int nXSize = 0;
+    int nYOff = 0;
+    int nLines = 0;
+    bool bHasHalo = false;  // whether anValues starts with line nYOff - 1
+    bool bLastStrip = false;
+    int nConnectedness = 4;
+    int nSizeThreshold = 0;
+    bool bSecondPass = false;
+
+    std::vector<std::int64_t> anValues{};
+
+    // Polygons touching the first or last line of the strip, sorted by id.
+    // In the first pass, this is filled with the number of pixels of the
+    // polygon within the strip, and then updated with the total size
+    // of the polygon once it is known. It is an input of the second pass.
+    std::vector<std::pair<GInt32, int>> *paoBoundarySizes = nullptr;
+
+    // Outputs.
+    bool bOutOfMemory = false;
+    std::vector<GInt32> anHaloIds{};  // polygon id of the halo line pixels
+    std::vector<GInt32> anLastIds{};  // polygon id of the last line pixels
+    std::vector<GSSmallPoly> aoSmallPolys{};  // second pass, sorted by id
+    std::vector<GSRun> aoRuns{};              // second pass
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                          GSFindBoundary()                            */
+/************************************************************************/
+
+static int GSFindBoundary(const std::vector<std::pair<GInt32, int>> &aoSizes,
+                          GInt32 nId)
+{
+    const auto oIter = std::lower_bound(
+        aoSizes.begin(), aoSizes.end(), std::pair<GInt32, int>(nId, INT_MIN));
+    if (oIter == aoSizes.end() || oIter->first != nId)
+        return -1;
+    return static_cast<int>(oIter - aoSizes.begin());
+}
+
+/************************************************************************/
+/*                           GSFindSmall()                              */
+/************************************************************************/
+
+static int GSFindSmall(const std::vector<GSSmallPoly> &aoSmallPolys,
+                       GInt32 nId)
+{
+    const auto oIter = std::lower_bound(
+        aoSmallPolys.begin(), aoSmallPolys.end(), nId,
+        [](const GSSmallPoly &oPoly, GInt32 nVal) { return oPoly.nId < nVal; });
+    if (oIter == aoSmallPolys.end() || oIter->nId != nId)
+        return -1;
+    return static_cast<int>(oIter - aoSmallPolys.begin());
+}
+
+/************************************************************************/
+/*                          GSProcessStrip()                            */
+/************************************************************************/
+
+static void GSProcessStrip(GSStrip *psStrip)
+{
+    const int nXSize = psStrip->nXSize;
+    const int iFirstLine = psStrip->bHasHalo ? 1 : 0;
+    const int nTotalLines = psStrip->nLines + iFirstLine;
+
+    try
+    {
+        /* ---------------------------------------------------------------- */
+        /*      Label the pixels of the strip.                              */
+        /* ---------------------------------------------------------------- */
+        GDALRasterPolygonEnumerator oEnum(psStrip->nConnectedness);
+        std::vector<GInt32> anIds(static_cast<size_t>(nTotalLines) * nXSize);
+        const auto Ids = [&anIds, nXSize](int iLine)
+        { return anIds.data() + static_cast<size_t>(iLine) * nXSize; };
+        const auto Values = [psStrip, nXSize](int iLine)
+        {
+            return psStrip->anValues.data() +
+                   static_cast<size_t>(iLine) * nXSize;
+        };
+
+        for (int iLine = 0; iLine < nTotalLines; iLine++)
+        {
+            if (iLine == 0)
+                oEnum.ProcessLine(nullptr, Values(iLine), nullptr, Ids(iLine),
+                                  nXSize);
+            else
+                oEnum.ProcessLine(Values(iLine - 1), Values(iLine),
+                                  Ids(iLine - 1), Ids(iLine), nXSize);
+        }
+        oEnum.CompleteMerges();
+        psStrip->anValues.clear();
+        psStrip->anValues.shrink_to_fit();
+
+        for (auto &nId : anIds)
+        {
+            if (nId >= 0)
+                nId = oEnum.panPolyIdMap[nId];
+        }
+
+        if (psStrip->bHasHalo)
+            psStrip->anHaloIds.assign(Ids(0), Ids(0) + nXSize);
+        psStrip->anLastIds.assign(Ids(nTotalLines - 1),
+                                  Ids(nTotalLines - 1) + nXSize);
+
+        /* ---------------------------------------------------------------- */
+        /*      Count pixels of each polygon, excluding the halo line.      */
+        /* ---------------------------------------------------------------- */
+        std::vector<int> anSizes(oEnum.nNextPolygonId);
+        for (int iLine = iFirstLine; iLine < nTotalLines; iLine++)
+        {
+            const GInt32 *panIds = Ids(iLine);
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                if (panIds[iX] >= 0 && anSizes[panIds[iX]] < MY_MAX_INT)
+                    anSizes[panIds[iX]]++;
+            }
+        }
+
+        auto &aoBoundarySizes = *(psStrip->paoBoundarySizes);
+        if (!psStrip->bSecondPass)
+        {
+            std::vector<bool> abBoundary(oEnum.nNextPolygonId);
+            for (const GInt32 nId : psStrip->anHaloIds)
+            {
+                if (nId >= 0)
+                    abBoundary[nId] = true;
+            }
+            if (!psStrip->bLastStrip)
+            {
+                for (const GInt32 nId : psStrip->anLastIds)
+                {
+                    if (nId >= 0)
+                        abBoundary[nId] = true;
+                }
+            }
+            for (int iPoly = 0; iPoly < oEnum.nNextPolygonId; iPoly++)
+            {
+                if (abBoundary[iPoly])
+                    aoBoundarySizes.emplace_back(iPoly, anSizes[iPoly]);
+            }
+            return;
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Second pass: find the small polygons.                       */
+        /* ---------------------------------------------------------------- */
+        for (const auto &oBoundary : aoBoundarySizes)
+            anSizes[oBoundary.first] = oBoundary.second;
+
+        std::vector<int> anSmallIdx(oEnum.nNextPolygonId, -1);
+        auto &aoSmallPolys = psStrip->aoSmallPolys;
+        for (int iPoly = 0; iPoly < oEnum.nNextPolygonId; iPoly++)
+        {
+            if (oEnum.panPolyIdMap[iPoly] == iPoly &&
+                oEnum.panPolyValue[iPoly] != GP_NODATA_MARKER &&
+                anSizes[iPoly] < psStrip->nSizeThreshold)
+            {
+                anSmallIdx[iPoly] = static_cast<int>(aoSmallPolys.size());
+                aoSmallPolys.emplace_back();
+                aoSmallPolys.back().nId = iPoly;
+            }
+        }
+        if (aoSmallPolys.empty())
+            return;
+
+        /* ---------------------------------------------------------------- */
+        /*      Find their largest neighbour, comparing pixels in the       */
+        /*      same order as the default algorithm.                        */
+        /* ---------------------------------------------------------------- */
+        const auto CompareNeighbour =
+            [&oEnum, &anSizes, &anSmallIdx, &aoSmallPolys](
+                int nPolyId1, int nPolyId2, GIntBig nPos)
+        {
+            if (nPolyId1 < 0 || nPolyId2 < 0 || nPolyId1 == nPolyId2)
+                return;
+            const int iSmall1 = anSmallIdx[nPolyId1];
+            const int iSmall2 = anSmallIdx[nPolyId2];
+            if (iSmall1 >= 0)
+                aoSmallPolys[iSmall1].UpdateBest(
+                    anSizes[nPolyId2], nPos, oEnum.panPolyValue[nPolyId2],
+                    iSmall2 >= 0 ? nPolyId2 : -1);
+            if (iSmall2 >= 0)
+                aoSmallPolys[iSmall2].UpdateBest(
+                    anSizes[nPolyId1], nPos, oEnum.panPolyValue[nPolyId1],
+                    iSmall1 >= 0 ? nPolyId1 : -1);
+        };
+
+        const bool b8Connected = psStrip->nConnectedness == 8;
+        for (int iLine = iFirstLine; iLine < nTotalLines; iLine++)
+        {
+            const GInt32 *panThisLineId = Ids(iLine);
+            const GInt32 *panLastLineId = iLine > 0 ? Ids(iLine - 1) : nullptr;
+            const int iY = psStrip->nYOff + iLine - iFirstLine;
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const GIntBig nPos =
+                    (static_cast<GIntBig>(iY) * nXSize + iX) * 4;
+                const int nThisId = panThisLineId[iX];
+                if (panLastLineId)
+                {
+                    CompareNeighbour(nThisId, panLastLineId[iX], nPos);
+
+                    if (iX > 0 && b8Connected)
+                        CompareNeighbour(nThisId, panLastLineId[iX - 1],
+                                         nPos + 1);
+
+                    if (iX < nXSize - 1 && b8Connected)
+                        CompareNeighbour(nThisId, panLastLineId[iX + 1],
+                                         nPos + 2);
+                }
+
+                if (iX > 0)
+                    CompareNeighbour(nThisId, panThisLineId[iX - 1], nPos + 3);
+            }
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Record the pixels of small polygons as runs.                */
+        /* ---------------------------------------------------------------- */
+        for (int iLine = iFirstLine; iLine < nTotalLines; iLine++)
+        {
+            const GInt32 *panIds = Ids(iLine);
+            const int iY = psStrip->nYOff + iLine - iFirstLine;
+            for (int iX = 0; iX < nXSize;)
+            {
+                const int nId = panIds[iX];
+                int iXEnd = iX + 1;
+                while (iXEnd < nXSize && panIds[iXEnd] == nId)
+                    iXEnd++;
+                if (nId >= 0 && anSmallIdx[nId] >= 0)
+                {
+                    GSRun oRun;
+                    oRun.nY = iY;
+                    oRun.nX = iX;
+                    oRun.nLength = iXEnd - iX;
+                    oRun.nSmallPoly = anSmallIdx[nId];
+                    psStrip->aoRuns.push_back(oRun);
+                }
+                iX = iXEnd;
+            }
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        psStrip->bOutOfMemory = true;
+    }
+}
+
+/************************************************************************/
+/*                       GDALSieveFilterStreaming()                     */
+/************************************************************************/
+
+static CPLErr GDALSieveFilterStreaming(GDALRasterBandH hSrcBand,
+                                       GDALRasterBandH hMaskBand,
+                                       GDALRasterBandH hDstBand,
+                                       int nSizeThreshold, int nConnectedness,
+                                       int nThreads,
+                                       GDALProgressFunc pfnProgress,
+                                       void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    /* -------------------------------------------------------------------- */
+    /*      Determine the strip height, so that a strip uses about          */
+    /*      32 MB for its pixel values and polygon ids.                     */
+    /* -------------------------------------------------------------------- */
+    constexpr int MAX_BYTES_PER_STRIP = 32 * 1024 * 1024;
+    constexpr int MAX_LINES_PER_STRIP = 1024;
+    int nLinesPerStrip = static_cast<int>(std::max<GIntBig>(
+        1, std::min<GIntBig>(MAX_LINES_PER_STRIP,
+                             MAX_BYTES_PER_STRIP /
+                                 (static_cast<GIntBig>(nXSize) *
+                                  (sizeof(std::int64_t) + sizeof(GInt32))))));
+    if (nThreads > 1)
+        nLinesPerStrip = std::max(
+            1, std::min(nLinesPerStrip, (nYSize + nThreads - 1) / nThreads));
+    const char *pszLinesPerStrip =
+        CPLGetConfigOption("GDAL_SIEVE_LINES_PER_STRIP", nullptr);
+    if (pszLinesPerStrip)
+        nLinesPerStrip = std::max(1, atoi(pszLinesPerStrip));
+    const int nStrips =
+        nYSize == 0 ? 0 : (nYSize + nLinesPerStrip - 1) / nLinesPerStrip;
+
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+
+    std::vector<std::vector<std::pair<GInt32, int>>> aaoBoundarySizes;
+    std::vector<GByte> abyMaskLine;
+    CPLErr eErr = CE_None;
+    try
+    {
+        aaoBoundarySizes.resize(nStrips);
+        if (hMaskBand)
+            abyMaskLine.resize(nXSize);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate sieve filter working buffers");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Run one pass over strips: read and label them by batches, and   */
+    /*      call pfnStitch() on each of them, in order.                     */
+    /* -------------------------------------------------------------------- */
+    const auto RunPass = [&](bool bSecondPass, double dfProgressStart,
+                             const std::function<void(GSStrip &)> &pfnStitch)
+    {
+        const int nStripsPerBatch = poQueue ? nThreads : 1;
+        for (int iBatchStart = 0; eErr == CE_None && iBatchStart < nStrips;
+             iBatchStart += nStripsPerBatch)
+        {
+            const int nBatchStrips =
+                std::min(nStripsPerBatch, nStrips - iBatchStart);
+            std::vector<std::unique_ptr<GSStrip>> apoStrips;
+            for (int i = 0; eErr == CE_None && i < nBatchStrips; i++)
+            {
+                const int iStrip = iBatchStart + i;
+                apoStrips.emplace_back(new GSStrip());
+                GSStrip *psStrip = apoStrips.back().get();
+                psStrip->nXSize = nXSize;
+                psStrip->nYOff = iStrip * nLinesPerStrip;
+                psStrip->nLines =
+                    std::min(nLinesPerStrip, nYSize - psStrip->nYOff);
+                psStrip->bHasHalo = iStrip > 0;
+                psStrip->bLastStrip = iStrip == nStrips - 1;
+                psStrip->nConnectedness = nConnectedness;
+                psStrip->nSizeThreshold = nSizeThreshold;
+                psStrip->bSecondPass = bSecondPass;
+                psStrip->paoBoundarySizes = &aaoBoundarySizes[iStrip];
+
+                const int nFirstLine = psStrip->nYOff - (iStrip > 0 ? 1 : 0);
+                const int nTotalLines =
+                    psStrip->nYOff + psStrip->nLines - nFirstLine;
+                try
+                {
+                    psStrip->anValues.resize(
+                        static_cast<size_t>(nTotalLines) * nXSize);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "Cannot allocate sieve filter working buffers");
+                    eErr = CE_Failure;
+                    break;
+                }
+
+                eErr = GDALRasterIO(hSrcBand, GF_Read, 0, nFirstLine, nXSize,
+                                    nTotalLines, psStrip->anValues.data(),
+                                    nXSize, nTotalLines, GDT_Int64, 0, 0);
+                for (int iLine = 0; eErr == CE_None && hMaskBand != nullptr &&
+                                    iLine < nTotalLines;
+                     iLine++)
+                {
+                    eErr = GPMaskImageData(
+                        hMaskBand, abyMaskLine.data(), nFirstLine + iLine,
+                        nXSize,
+                        psStrip->anValues.data() +
+                            static_cast<size_t>(iLine) * nXSize);
+                }
+                if (eErr != CE_None)
+                    break;
+
+                const auto JobFunc = [](void *pData)
+                { GSProcessStrip(static_cast<GSStrip *>(pData)); };
+                if (!poQueue || !poQueue->SubmitJob(JobFunc, psStrip))
+                    JobFunc(psStrip);
+            }
+            if (poQueue)
+                poQueue->WaitCompletion();
+
+            for (int i = 0; eErr == CE_None && i < nBatchStrips; i++)
+            {
+                if (apoStrips[i]->bOutOfMemory)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "Cannot allocate sieve filter working buffers");
+                    eErr = CE_Failure;
+                    break;
+                }
+                try
+                {
+                    pfnStitch(*apoStrips[i]);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "Cannot allocate sieve filter working buffers");
+                    eErr = CE_Failure;
+                    break;
+                }
+                apoStrips[i].reset();
+
+                if (!pfnProgress(dfProgressStart +
+                                     0.4 * (iBatchStart + i + 1) / nStrips,
+                                 "", pProgressArg))
+                {
+                    CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                    eErr = CE_Failure;
+                }
+            }
+        }
+    };
+
+    /* ==================================================================== */
+    /*      First pass: compute the size of polygons crossing strips.       */
+    /* ==================================================================== */
+    struct GSOpenPoly
+    {
+        int nParent;
+        GIntBig nSize;
+        // Entries of aaoBoundarySizes (strip, index) of this polygon.
+        std::vector<std::pair<int, int>> aoEntries;
+    };
+
+    std::vector<GSOpenPoly> aoOpenPolys;
+    std::vector<int> anLastLineOpenPoly;
+    int iCurStrip = 0;
+
+    const auto FindOpen = [&aoOpenPolys](int i)
+    {
+        while (aoOpenPolys[i].nParent != i)
+        {
+            const int iParent = aoOpenPolys[i].nParent;
+            aoOpenPolys[i].nParent = aoOpenPolys[iParent].nParent;
+            i = iParent;
+        }
+        return i;
+    };
+
+    RunPass(
+        false, 0.0,
+        [&](GSStrip &oStrip)
+        {
+            const int iStrip = iCurStrip++;
+            auto &aoBoundarySizes = aaoBoundarySizes[iStrip];
+
+            // Register the polygons touching the first or last line.
+            std::vector<int> anOpenPoly(aoBoundarySizes.size());
+            for (size_t i = 0; i < aoBoundarySizes.size(); i++)
+            {
+                anOpenPoly[i] = static_cast<int>(aoOpenPolys.size());
+                aoOpenPolys.push_back(GSOpenPoly{
+                    anOpenPoly[i], aoBoundarySizes[i].second,
+                    std::vector<std::pair<int, int>>{
+                        std::pair<int, int>(iStrip, static_cast<int>(i))}});
+            }
+
+            // Merge with the polygons of the previous strip.
+            for (int iX = 0; oStrip.bHasHalo && iX < nXSize; iX++)
+            {
+                const GInt32 nId = oStrip.anHaloIds[iX];
+                if (nId < 0 || anLastLineOpenPoly[iX] < 0)
+                    continue;
+                int i = FindOpen(
+                    anOpenPoly[GSFindBoundary(aoBoundarySizes, nId)]);
+                int j = FindOpen(anLastLineOpenPoly[iX]);
+                if (i == j)
+                    continue;
+                if (aoOpenPolys[i].aoEntries.size() <
+                    aoOpenPolys[j].aoEntries.size())
+                    std::swap(i, j);
+                aoOpenPolys[i].nSize += aoOpenPolys[j].nSize;
+                aoOpenPolys[i].aoEntries.insert(
+                    aoOpenPolys[i].aoEntries.end(),
+                    aoOpenPolys[j].aoEntries.begin(),
+                    aoOpenPolys[j].aoEntries.end());
+                std::vector<std::pair<int, int>>().swap(
+                    aoOpenPolys[j].aoEntries);
+                aoOpenPolys[j].nParent = i;
+            }
+
+            // Polygons touching the last line are still open.
+            std::vector<bool> abStillOpen(aoOpenPolys.size());
+            for (int iX = 0; !oStrip.bLastStrip && iX < nXSize; iX++)
+            {
+                const GInt32 nId = oStrip.anLastIds[iX];
+                if (nId >= 0)
+                    abStillOpen[FindOpen(anOpenPoly[GSFindBoundary(
+                        aoBoundarySizes, nId)])] = true;
+            }
+
+            // Store the size of closed polygons, and renumber open ones.
+            std::vector<int> anNewIndex(aoOpenPolys.size(), -1);
+            std::vector<GSOpenPoly> aoNewOpenPolys;
+            for (int i = 0; i < static_cast<int>(aoOpenPolys.size()); i++)
+            {
+                if (FindOpen(i) != i)
+                    continue;
+                if (abStillOpen[i])
+                {
+                    anNewIndex[i] = static_cast<int>(aoNewOpenPolys.size());
+                    aoNewOpenPolys.emplace_back(std::move(aoOpenPolys[i]));
+                    aoNewOpenPolys.back().nParent = anNewIndex[i];
+                }
+                else
+                {
+                    const int nSize = static_cast<int>(
+                        std::min<GIntBig>(aoOpenPolys[i].nSize, MY_MAX_INT));
+                    for (const auto &oEntry : aoOpenPolys[i].aoEntries)
+                        aaoBoundarySizes[oEntry.first][oEntry.second].second =
+                            nSize;
+                }
+            }
+
+            anLastLineOpenPoly.assign(nXSize, -1);
+            for (int iX = 0; !oStrip.bLastStrip && iX < nXSize; iX++)
+            {
+                const GInt32 nId = oStrip.anLastIds[iX];
+                if (nId >= 0)
+                    anLastLineOpenPoly[iX] = anNewIndex[FindOpen(anOpenPoly[
+                        GSFindBoundary(aoBoundarySizes, nId)])];
+            }
+            aoOpenPolys = std::move(aoNewOpenPolys);
+        });
+    aoOpenPolys.clear();
+    anLastLineOpenPoly.clear();
+
+    /* ==================================================================== */
+    /*      Second pass: collect small polygons and their largest           */
+    /*      neighbour.                                                      */
+    /* ==================================================================== */
+    std::vector<GSSmallPoly> aoSmallPolys;
+    std::vector<GSRun> aoRuns;
+    std::vector<int> anLastLineSmallPoly;
+
+    const auto FindSmall = [&aoSmallPolys](int i)
+    {
+        while (aoSmallPolys[i].nId != i)
+        {
+            aoSmallPolys[i].nId = aoSmallPolys[aoSmallPolys[i].nId].nId;
+            i = aoSmallPolys[i].nId;
+        }
+        return i;
+    };
+
+    iCurStrip = 0;
+    RunPass(
+        true, 0.4,
+        [&](GSStrip &oStrip)
+        {
+            std::vector<std::pair<GInt32, int>>().swap(
+                aaoBoundarySizes[iCurStrip++]);
+
+            const int nBase = static_cast<int>(aoSmallPolys.size());
+            const auto ToGlobal = [&oStrip, nBase](GInt32 nId)
+            {
+                const int i = nId >= 0 ? GSFindSmall(oStrip.aoSmallPolys, nId)
+                                       : -1;
+                return i >= 0 ? nBase + i : -1;
+            };
+
+            for (auto &oPoly : oStrip.aoSmallPolys)
+            {
+                if (oPoly.nBestSmallId >= 0)
+                    oPoly.nBestSmallId = ToGlobal(oPoly.nBestSmallId);
+            }
+            std::vector<int> anHaloSmallPoly, anLastSmallPoly;
+            for (int iX = 0; oStrip.bHasHalo && iX < nXSize; iX++)
+                anHaloSmallPoly.push_back(ToGlobal(oStrip.anHaloIds[iX]));
+            for (int iX = 0; iX < nXSize; iX++)
+                anLastSmallPoly.push_back(ToGlobal(oStrip.anLastIds[iX]));
+
+            for (auto &oPoly : oStrip.aoSmallPolys)
+            {
+                oPoly.nId = static_cast<int>(aoSmallPolys.size());
+                aoSmallPolys.push_back(oPoly);
+            }
+            for (auto &oRun : oStrip.aoRuns)
+            {
+                oRun.nSmallPoly += nBase;
+                aoRuns.push_back(oRun);
+            }
+
+            // Merge with the small polygons of the previous strip.
+            for (int iX = 0; oStrip.bHasHalo && iX < nXSize; iX++)
+            {
+                if (anHaloSmallPoly[iX] < 0 || anLastLineSmallPoly[iX] < 0)
+                    continue;
+                int i = FindSmall(anHaloSmallPoly[iX]);
+                int j = FindSmall(anLastLineSmallPoly[iX]);
+                if (i == j)
+                    continue;
+                auto &oPolyI = aoSmallPolys[i];
+                auto &oPolyJ = aoSmallPolys[j];
+                oPolyI.UpdateBest(oPolyJ.nBestSize, oPolyJ.nBestPos,
+                                  oPolyJ.nBestValue, oPolyJ.nBestSmallId);
+                oPolyJ.nId = i;
+            }
+
+            anLastLineSmallPoly = std::move(anLastSmallPoly);
+        });
+    aaoBoundarySizes.clear();
+    anLastLineSmallPoly.clear();
+    if (eErr != CE_None)
+        return eErr;
+
+    /* -------------------------------------------------------------------- */
+    /*      If our biggest neighbour is still smaller than the              */
+    /*      threshold, then try tracking to that polygons biggest           */
+    /*      neighbour, and so forth.                                        */
+    /* -------------------------------------------------------------------- */
+    int nFailedMerges = 0;
+    int nIsolatedSmall = 0;
+    int nSieveTargets = 0;
+
+    constexpr int STATE_UNKNOWN = 0;
+    constexpr int STATE_VISITING = 1;
+    constexpr int STATE_MERGED = 2;
+    constexpr int STATE_FAILED = 3;
+    std::vector<GByte> abyState(aoSmallPolys.size(), STATE_UNKNOWN);
+    std::vector<std::int64_t> anNewValue(aoSmallPolys.size());
+    std::vector<int> anChain;
+
+    for (int iPoly = 0; iPoly < static_cast<int>(aoSmallPolys.size()); iPoly++)
+    {
+        if (FindSmall(iPoly) != iPoly)
+            continue;
+
+        nSieveTargets++;
+
+        // if we have no neighbours but we are small, what shall we do?
+        if (aoSmallPolys[iPoly].nBestSize < 0)
+        {
+            nIsolatedSmall++;
+            abyState[iPoly] = STATE_FAILED;
+            continue;
+        }
+
+        // Walk through our neighbours until we find a polygon large enough.
+        anChain.clear();
+        int iCur = iPoly;
+        GByte byResult = STATE_FAILED;
+        std::int64_t nResultValue = 0;
+        while (true)
+        {
+            if (abyState[iCur] == STATE_MERGED)
+            {
+                byResult = STATE_MERGED;
+                nResultValue = anNewValue[iCur];
+                break;
+            }
+            // Check that we don't cycle on an already visited polygon.
+            if (abyState[iCur] != STATE_UNKNOWN)
+                break;
+            abyState[iCur] = STATE_VISITING;
+            anChain.push_back(iCur);
+
+            const auto &oPoly = aoSmallPolys[iCur];
+            if (oPoly.nBestSize < 0)
+                break;
+            // If the biggest neighbour is larger than the threshold
+            // then we are golden.
+            if (oPoly.nBestSmallId < 0)
+            {
+                byResult = STATE_MERGED;
+                nResultValue = oPoly.nBestValue;
+                break;
+            }
+            iCur = FindSmall(oPoly.nBestSmallId);
+        }
+
+        if (byResult != STATE_MERGED)
+            nFailedMerges++;
+        for (const int i : anChain)
+        {
+            abyState[i] = byResult;
+            anNewValue[i] = nResultValue;
+        }
+    }
+
+    CPLDebug("GDALSieveFilter",
+             "Small Polygons: %d, Isolated: %d, Unmergable: %d", nSieveTargets,
+             nIsolatedSmall, nFailedMerges);
+
+    /* ==================================================================== */
+    /*      Write the output. If updating the source band in place, only    */
+    /*      the lines with changed pixels are rewritten. Runs are sorted    */
+    /*      by strip, and by line within a strip.                           */
+    /* ==================================================================== */
+    const bool bInPlace = hSrcBand == hDstBand;
+    std::vector<std::int64_t> anValues;
+    size_t iRun = 0;
+    for (int iStrip = 0; eErr == CE_None && iStrip < nStrips; iStrip++)
+    {
+        int nYOff = iStrip * nLinesPerStrip;
+        int nLines = std::min(nLinesPerStrip, nYSize - nYOff);
+        const size_t iFirstRun = iRun;
+        int nMinY = INT_MAX;
+        int nMaxY = -1;
+        for (; iRun < aoRuns.size() && aoRuns[iRun].nY < nYOff + nLines;
+             iRun++)
+        {
+            const int iPoly = FindSmall(aoRuns[iRun].nSmallPoly);
+            aoRuns[iRun].nSmallPoly = iPoly;
+            if (abyState[iPoly] == STATE_MERGED)
+            {
+                nMinY = std::min(nMinY, aoRuns[iRun].nY);
+                nMaxY = std::max(nMaxY, aoRuns[iRun].nY);
+            }
+        }
+        if (bInPlace)
+        {
+            nYOff = nMinY;
+            nLines = nMaxY >= 0 ? nMaxY - nMinY + 1 : 0;
+        }
+
+        if (nLines > 0)
+        {
+            try
+            {
+                anValues.resize(static_cast<size_t>(nLines) * nXSize);
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate sieve filter working buffers");
+                eErr = CE_Failure;
+                break;
+            }
+            eErr = GDALRasterIO(hSrcBand, GF_Read, 0, nYOff, nXSize, nLines,
+                                anValues.data(), nXSize, nLines, GDT_Int64, 0,
+                                0);
+            if (eErr != CE_None)
+                break;
+            for (size_t i = iFirstRun; i < iRun; i++)
+            {
+                const GSRun &oRun = aoRuns[i];
+                if (abyState[oRun.nSmallPoly] != STATE_MERGED)
+                    continue;
+                std::int64_t *panRun =
+                    anValues.data() +
+                    static_cast<size_t>(oRun.nY - nYOff) * nXSize + oRun.nX;
+                std::fill(panRun, panRun + oRun.nLength,
+                          anNewValue[oRun.nSmallPoly]);
+            }
+            eErr = GDALRasterIO(hDstBand, GF_Write, 0, nYOff, nXSize, nLines,
+                                anValues.data(), nXSize, nLines, GDT_Int64, 0,
+                                0);
+        }
+
+        if (eErr == CE_None &&
+            !pfnProgress(0.8 + 0.2 * (iStrip + 1) / nStrips, "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                          GDALSieveFilter()                           */
 /************************************************************************/
@@ -184,8 +1011,20 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * @param nConnectedness either 4 indicating that diagonal pixels are not
  * considered directly adjacent for polygon membership purposes or 8
  * indicating they are.
- * @param papszOptions algorithm options in name=value list form.  None
- * currently supported.
+ * @param papszOptions algorithm options in name=value list form.
+ * Available options are:
+ * <ul>
+ * <li>STREAMING=YES/NO: (GDAL >= 3.8) If set to YES, the raster is
+ * processed by strips of lines that are labeled independently and stitched
+ * together. Memory use then depends on the strip size, the polygons crossing
+ * strip boundaries and the number of polygons smaller than the threshold,
+ * rather than on the total number of polygons. When updating hSrcBand in
+ * place, only the lines with changed pixels are rewritten. The result is
+ * identical to the default mode. Defaults to NO.</li>
+ * <li>NUM_THREADS=n/ALL_CPUS: (GDAL >= 3.8) Number of threads used to
+ * label strips when STREAMING=YES. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1.</li>
+ * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
  * @param pProgressArg callback argument passed to pfnProgress.
@@ -197,7 +1036,7 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
                                    GDALRasterBandH hMaskBand,
                                    GDALRasterBandH hDstBand, int nSizeThreshold,
                                    int nConnectedness,
-                                   CPL_UNUSED char **papszOptions,
+                                   char **papszOptions,
                                    GDALProgressFunc pfnProgress,
                                    void *pProgressArg)
 {
@@ -207,6 +1046,17 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
 
+    if (CPLFetchBool(papszOptions, "STREAMING", false))
+    {
+        const int nThreads = GDALGetNumThreads(papszOptions, true);
+        const CPLErr eErr = GDALSieveFilterStreaming(
+            hSrcBand, hMaskBand, hDstBand, nSizeThreshold, nConnectedness,
+            nThreads, pfnProgress, pProgressArg);
+        if (eErr == CE_None)
+            pfnProgress(1.0, "", pProgressArg);
+        return eErr;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate working buffers.                                       */
     /* -------------------------------------------------------------------- */
@@ -2630,6 +2630,35 @@ void GDALDestroyGenImgProjTransformer(void *hTransformArg)
     CPLFree(psInfo);
 }
 
+/************************************************************************/
+/*                     GDALApplyGeoTransformBatch()                     */
+/************************************************************************/
+
+// Apply a geotransform to the points flagged in panSuccess. The loop body is
+// kept free of branches (failed points get their input value selected back)
+// so that the compiler can vectorize it.
+static void GDALApplyGeoTransformBatch(const double *padfGeoTransform,
+                                       int nPointCount, double *padfX,
+                                       double *padfY, const int *panSuccess)
+{
+    const double dfGT0 = padfGeoTransform[0];
+    const double dfGT1 = padfGeoTransform[1];
+    const double dfGT2 = padfGeoTransform[2];
+    const double dfGT3 = padfGeoTransform[3];
+    const double dfGT4 = padfGeoTransform[4];
+    const double dfGT5 = padfGeoTransform[5];
+    for (int i = 0; i < nPointCount; i++)
+    {
+        const double dfX = padfX[i];
+        const double dfY = padfY[i];
+        const double dfNewX = dfGT0 + dfX * dfGT1 + dfY * dfGT2;
+        const double dfNewY = dfGT3 + dfX * dfGT4 + dfY * dfGT5;
+        const bool bOK = panSuccess[i] != 0;
+        padfX[i] = bOK ? dfNewX : dfX;
+        padfY[i] = bOK ? dfNewY : dfY;
+    }
+}
+
 /************************************************************************/
 /*                      GDALGenImgProjTransform()                       */
 /************************************************************************/
@@ -2692,21 +2721,8 @@ int GDALGenImgProjTransform(void *pTransformArgIn, int bDstToSrc,
     }
     else
     {
-        for (int i = 0; i < nPointCount; i++)
-        {
-            if (!panSuccess[i])
-                continue;
-
-            const double dfNewX = padfGeoTransform[0] +
-                                  padfX[i] * padfGeoTransform[1] +
-                                  padfY[i] * padfGeoTransform[2];
-            const double dfNewY = padfGeoTransform[3] +
-                                  padfX[i] * padfGeoTransform[4] +
-                                  padfY[i] * padfGeoTransform[5];
-
-            padfX[i] = dfNewX;
-            padfY[i] = dfNewY;
-        }
+        GDALApplyGeoTransformBatch(padfGeoTransform, nPointCount, padfX,
+                                   padfY, panSuccess);
     }
 
     /* -------------------------------------------------------------------- */
@@ -2743,21 +2759,8 @@ int GDALGenImgProjTransform(void *pTransformArgIn, int bDstToSrc,
     }
     else
     {
-        for (int i = 0; i < nPointCount; i++)
-        {
-            if (!panSuccess[i])
-                continue;
-
-            const double dfNewX = padfGeoTransform[0] +
-                                  padfX[i] * padfGeoTransform[1] +
-                                  padfY[i] * padfGeoTransform[2];
-            const double dfNewY = padfGeoTransform[3] +
-                                  padfX[i] * padfGeoTransform[4] +
-                                  padfY[i] * padfGeoTransform[5];
-
-            padfX[i] = dfNewX;
-            padfY[i] = dfNewY;
-        }
+        GDALApplyGeoTransformBatch(padfGeoTransform, nPointCount, padfX,
+                                   padfY, panSuccess);
     }
 
     return TRUE;
@@ -3923,7 +3926,10 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
     /*      NOTE: the above comment is not true: gdalwarp uses approximator */
     /*      also to compute the source pixel of each target pixel.          */
     /* -------------------------------------------------------------------- */
-    for (int i = nPoints - 1; i >= 0; i--)
+    // x[0] is read by every iteration, so save it before the loop overwrites
+    // it: this allows the interpolation to run forward and be vectorized.
+    const double dfX0 = x[0];
+    for (int i = 0; i < nPoints; i++)
     {
 #ifdef check_error
         double xtemp = x[i];
@@ -3935,7 +3941,7 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
         psATInfo->pfnBaseTransformer(psATInfo->pBaseCBData, bDstToSrc, 1,
                                      &xtemp, &ytemp, &ztemp, &btemp);
 #endif
-        const double dfDist = (x[i] - x[0]);
+        const double dfDist = (x[i] - dfX0);
         x[i] = xSMETransformed[0] + dfDeltaX * dfDist;
         y[i] = ySMETransformed[0] + dfDeltaY * dfDist;
         z[i] = zSMETransformed[0] + dfDeltaZ * dfDist;
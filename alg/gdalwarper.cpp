@@ -1177,6 +1177,11 @@ CPLErr GDALWarpDstAlphaMasker(void *pMaskFuncArg, int nBandCount,
  * set the number of threads to use to parallelize the computation part of the
  * warping. If not set, computation will be done in a single thread.</li>
  *
+ * <li>PIPELINE_DEPTH: (GDAL >= 3.8) Maximum number of chunks in flight in
+ * the read/mask/warp/write pipeline of GDALWarpOperation::ChunkAndWarpMulti().
+ * Defaults to 4. The working buffers of the chunks in flight are also bounded
+ * by twice the warp memory limit.</li>
+ *
  * <li>STREAMABLE_OUTPUT: (GDAL >= 2.0) This defaults to FALSE, but may
  * be set to TRUE typically when writing to a streamed file. The
  * gdalwarp utility automatically sets this option when writing to
@@ -507,9 +507,6 @@ class CPL_DLL GDALWarpOperation
     static CPLErr CreateKernelMask(GDALWarpKernel *, int iBand,
                                    const char *pszType);
 
-    CPLMutex *hIOMutex;
-    CPLMutex *hWarpMutex;
-
     int nChunkListCount;
     int nChunkListMax;
     GDALWarpChunk *pasChunkList;
@@ -206,6 +206,8 @@ static CPLErr GWKSumPreserving(GDALWarpKernel *);
 static CPLErr GWKCubicNoMasksOrDstDensityOnlyUShort(GDALWarpKernel *);
 static CPLErr GWKCubicSplineNoMasksOrDstDensityOnlyUShort(GDALWarpKernel *);
 static CPLErr GWKBilinearNoMasksOrDstDensityOnlyUShort(GDALWarpKernel *);
+template <class T>
+static CPLErr GWKNearestNoMasksOrDstDensityOnlyT(GDALWarpKernel *poWK);
 
 /************************************************************************/
 /*                           GWKJobStruct                               */
@@ -1284,6 +1286,27 @@ CPLErr GDALWarpKernel::PerformWarp()
     if (eWorkingDataType == GDT_Float32 && eResample == GRA_NearestNeighbour)
         return GWKNearestFloat(this);
 
+    if (eResample == GRA_NearestNeighbour && bNoMasksOrDstDensityOnly)
+    {
+        switch (eWorkingDataType)
+        {
+            case GDT_Int8:
+                return GWKNearestNoMasksOrDstDensityOnlyT<GInt8>(this);
+            case GDT_Int32:
+                return GWKNearestNoMasksOrDstDensityOnlyT<GInt32>(this);
+            case GDT_UInt32:
+                return GWKNearestNoMasksOrDstDensityOnlyT<GUInt32>(this);
+            case GDT_Int64:
+                return GWKNearestNoMasksOrDstDensityOnlyT<std::int64_t>(this);
+            case GDT_UInt64:
+                return GWKNearestNoMasksOrDstDensityOnlyT<std::uint64_t>(this);
+            case GDT_Float64:
+                return GWKNearestNoMasksOrDstDensityOnlyT<double>(this);
+            default:
+                break;
+        }
+    }
+
     if (eWorkingDataType == GDT_Float32 && eResample == GRA_Bilinear &&
         bNoMasksOrDstDensityOnly)
         return GWKBilinearNoMasksOrDstDensityOnlyFloat(this);
@@ -1422,12 +1445,10 @@ template <> float GWKRoundValueT<float>(double dfValue)
     return static_cast<float>(dfValue);
 }
 
-#ifdef notused
 template <> double GWKRoundValueT<double>(double dfValue)
 {
     return dfValue;
 }
-#endif
 
 /************************************************************************/
 /*                            GWKClampValueT()                          */
@@ -1435,9 +1456,9 @@ template <> double GWKRoundValueT<double>(double dfValue)
 
 template <class T> static CPL_INLINE T GWKClampValueT(double dfValue)
 {
-    if (dfValue < std::numeric_limits<T>::min())
+    if (dfValue < static_cast<double>(std::numeric_limits<T>::min()))
         return std::numeric_limits<T>::min();
-    else if (dfValue > std::numeric_limits<T>::max())
+    else if (dfValue > static_cast<double>(std::numeric_limits<T>::max()))
         return std::numeric_limits<T>::max();
     else
         return GWKRoundValueT<T>(dfValue);
@@ -1448,12 +1469,10 @@ template <> float GWKClampValueT<float>(double dfValue)
     return static_cast<float>(dfValue);
 }
 
-#ifdef notused
 template <> double GWKClampValueT<double>(double dfValue)
 {
     return dfValue;
 }
-#endif
 
 /************************************************************************/
 /*                         GWKSetPixelValueRealT()                      */
@@ -1814,12 +1833,13 @@ static bool GWKSetPixelValue(const GDALWarpKernel *poWK, int iBand,
 /*                       GWKSetPixelValueReal()                         */
 /************************************************************************/
 
+template <class T>
 static bool GWKSetPixelValueReal(const GDALWarpKernel *poWK, int iBand,
                                  GPtrDiff_t iDstOffset, double dfDensity,
                                  double dfReal)
 
 {
-    GByte *pabyDst = poWK->papabyDstImage[iBand];
+    T *pDst = reinterpret_cast<T *>(poWK->papabyDstImage[iBand]);
 
     /* -------------------------------------------------------------------- */
     /*      If the source density is less than 100% we need to fetch the    */
@@ -1835,7 +1855,6 @@ static bool GWKSetPixelValueReal(const GDALWarpKernel *poWK, int iBand,
         if (dfDensity < 0.0001)
             return true;
 
-        double dfDstReal = 0.0;
         double dfDstDensity = 1.0;
 
         if (poWK->pafDstDensity != nullptr)
@@ -1846,59 +1865,7 @@ static bool GWKSetPixelValueReal(const GDALWarpKernel *poWK, int iBand,
 
         // It seems like we also ought to be testing panDstValid[] here!
 
-        switch (poWK->eWorkingDataType)
-        {
-            case GDT_Byte:
-                dfDstReal = pabyDst[iDstOffset];
-                break;
-
-            case GDT_Int8:
-                dfDstReal = reinterpret_cast<GInt8 *>(pabyDst)[iDstOffset];
-                break;
-
-            case GDT_Int16:
-                dfDstReal = reinterpret_cast<GInt16 *>(pabyDst)[iDstOffset];
-                break;
-
-            case GDT_UInt16:
-                dfDstReal = reinterpret_cast<GUInt16 *>(pabyDst)[iDstOffset];
-                break;
-
-            case GDT_Int32:
-                dfDstReal = reinterpret_cast<GInt32 *>(pabyDst)[iDstOffset];
-                break;
-
-            case GDT_UInt32:
-                dfDstReal = reinterpret_cast<GUInt32 *>(pabyDst)[iDstOffset];
-                break;
-
-            case GDT_Int64:
-                dfDstReal = static_cast<double>(
-                    reinterpret_cast<std::int64_t *>(pabyDst)[iDstOffset]);
-                break;
-
-            case GDT_UInt64:
-                dfDstReal = static_cast<double>(
-                    reinterpret_cast<std::uint64_t *>(pabyDst)[iDstOffset]);
-                break;
-
-            case GDT_Float32:
-                dfDstReal = reinterpret_cast<float *>(pabyDst)[iDstOffset];
-                break;
-
-            case GDT_Float64:
-                dfDstReal = reinterpret_cast<double *>(pabyDst)[iDstOffset];
-                break;
-
-            case GDT_CInt16:
-            case GDT_CInt32:
-            case GDT_CFloat32:
-            case GDT_CFloat64:
-            case GDT_Unknown:
-            case GDT_TypeCount:
-                CPLAssert(false);
-                return false;
-        }
+        const double dfDstReal = static_cast<double>(pDst[iDstOffset]);
 
         // The destination density is really only relative to the portion
         // not occluded by the overlay.
@@ -1914,60 +1881,28 @@ static bool GWKSetPixelValueReal(const GDALWarpKernel *poWK, int iBand,
     /*      Avoid using the destination nodata value for integer datatypes  */
     /*      if by chance it is equal to the computed pixel value.           */
     /* -------------------------------------------------------------------- */
-
-    switch (poWK->eWorkingDataType)
+    if (std::numeric_limits<T>::is_integer)
     {
-        case GDT_Byte:
-            CLAMP(GByte);
-            break;
-
-        case GDT_Int8:
-            CLAMP(GInt8);
-            break;
-
-        case GDT_Int16:
-            CLAMP(GInt16);
-            break;
-
-        case GDT_UInt16:
-            CLAMP(GUInt16);
-            break;
-
-        case GDT_UInt32:
-            CLAMP(GUInt32);
-            break;
-
-        case GDT_Int32:
-            CLAMP(GInt32);
-            break;
-
-        case GDT_UInt64:
-            CLAMP(std::uint64_t);
-            break;
-
-        case GDT_Int64:
-            CLAMP(std::int64_t);
-            break;
-
-        case GDT_Float32:
-            reinterpret_cast<float *>(pabyDst)[iDstOffset] =
-                static_cast<float>(dfReal);
-            break;
-
-        case GDT_Float64:
-            reinterpret_cast<double *>(pabyDst)[iDstOffset] = dfReal;
-            break;
-
-        case GDT_CInt16:
-        case GDT_CInt32:
-        case GDT_CFloat32:
-        case GDT_CFloat64:
-            return false;
-
-        case GDT_Unknown:
-        case GDT_TypeCount:
-            CPLAssert(false);
-            return false;
+        if (dfReal < static_cast<double>(std::numeric_limits<T>::min()))
+            pDst[iDstOffset] = std::numeric_limits<T>::min();
+        else if (dfReal > static_cast<double>(std::numeric_limits<T>::max()))
+            pDst[iDstOffset] = std::numeric_limits<T>::max();
+        else
+            pDst[iDstOffset] = GWKRoundValueT<T>(dfReal);
+        if (poWK->padfDstNoDataReal != nullptr &&
+            poWK->padfDstNoDataReal[iBand] ==
+                static_cast<double>(pDst[iDstOffset]))
+        {
+            if (pDst[iDstOffset] == std::numeric_limits<T>::min())
+                pDst[iDstOffset] =
+                    static_cast<T>(std::numeric_limits<T>::min() + 1);
+            else
+                pDst[iDstOffset]--;
+        }
+    }
+    else
+    {
+        pDst[iDstOffset] = static_cast<T>(dfReal);
     }
 
     return true;
@@ -2091,13 +2026,12 @@ static bool GWKGetPixelValue(const GDALWarpKernel *poWK, int iBand,
 /*                       GWKGetPixelValueReal()                         */
 /************************************************************************/
 
+template <class T>
 static bool GWKGetPixelValueReal(const GDALWarpKernel *poWK, int iBand,
                                  GPtrDiff_t iSrcOffset, double *pdfDensity,
                                  double *pdfReal)
 
 {
-    GByte *pabySrc = poWK->papabySrcImage[iBand];
-
     if (poWK->papanBandSrcValid != nullptr &&
         poWK->papanBandSrcValid[iBand] != nullptr &&
         !CPLMaskGet(poWK->papanBandSrcValid[iBand], iSrcOffset))
@@ -2106,59 +2040,8 @@ static bool GWKGetPixelValueReal(const GDALWarpKernel *poWK, int iBand,
         return false;
     }
 
-    switch (poWK->eWorkingDataType)
-    {
-        case GDT_Byte:
-            *pdfReal = pabySrc[iSrcOffset];
-            break;
-
-        case GDT_Int8:
-            *pdfReal = reinterpret_cast<GInt8 *>(pabySrc)[iSrcOffset];
-            break;
-
-        case GDT_Int16:
-            *pdfReal = reinterpret_cast<GInt16 *>(pabySrc)[iSrcOffset];
-            break;
-
-        case GDT_UInt16:
-            *pdfReal = reinterpret_cast<GUInt16 *>(pabySrc)[iSrcOffset];
-            break;
-
-        case GDT_Int32:
-            *pdfReal = reinterpret_cast<GInt32 *>(pabySrc)[iSrcOffset];
-            break;
-
-        case GDT_UInt32:
-            *pdfReal = reinterpret_cast<GUInt32 *>(pabySrc)[iSrcOffset];
-            break;
-
-        case GDT_Int64:
-            *pdfReal = static_cast<double>(
-                reinterpret_cast<std::int64_t *>(pabySrc)[iSrcOffset]);
-            break;
-
-        case GDT_UInt64:
-            *pdfReal = static_cast<double>(
-                reinterpret_cast<std::uint64_t *>(pabySrc)[iSrcOffset]);
-            break;
-
-        case GDT_Float32:
-            *pdfReal = reinterpret_cast<float *>(pabySrc)[iSrcOffset];
-            break;
-
-        case GDT_Float64:
-            *pdfReal = reinterpret_cast<double *>(pabySrc)[iSrcOffset];
-            break;
-
-        case GDT_CInt16:
-        case GDT_CInt32:
-        case GDT_CFloat32:
-        case GDT_CFloat64:
-        case GDT_Unknown:
-        case GDT_TypeCount:
-            CPLAssert(false);
-            return false;
-    }
+    *pdfReal = static_cast<double>(
+        reinterpret_cast<const T *>(poWK->papabySrcImage[iBand])[iSrcOffset]);
 
     if (poWK->pafUnifiedSrcDensity != nullptr)
         *pdfDensity = poWK->pafUnifiedSrcDensity[iSrcOffset];
@@ -2169,90 +2052,155 @@ static bool GWKGetPixelValueReal(const GDALWarpKernel *poWK, int iBand,
 }
 
 /************************************************************************/
-/*                          GWKGetPixelRow()                            */
+/*                     GWKGetPixelRowInitDensity()                      */
 /************************************************************************/
 
-/* It is assumed that adfImag[] is set to 0 by caller code for non-complex */
-/* data-types. */
+/* Initializes padfDensity[] from the source validity masks. Returns false */
+/* if none of the pixels of the row is valid. */
 
-static bool GWKGetPixelRow(const GDALWarpKernel *poWK, int iBand,
-                           GPtrDiff_t iSrcOffset, int nHalfSrcLen,
-                           double *padfDensity, double adfReal[],
-                           double *padfImag)
+static bool GWKGetPixelRowInitDensity(const GDALWarpKernel *poWK, int iBand,
+                                      GPtrDiff_t iSrcOffset, int nSrcLen,
+                                      double *padfDensity)
 {
-    // We know that nSrcLen is even, so we can *always* unroll loops 2x.
-    const int nSrcLen = nHalfSrcLen * 2;
     bool bHasValid = false;
 
-    if (padfDensity != nullptr)
+    // Init the density.
+    for (int i = 0; i < nSrcLen; i += 2)
     {
-        // Init the density.
-        for (int i = 0; i < nSrcLen; i += 2)
-        {
-            padfDensity[i] = 1.0;
-            padfDensity[i + 1] = 1.0;
-        }
+        padfDensity[i] = 1.0;
+        padfDensity[i + 1] = 1.0;
+    }
 
-        if (poWK->panUnifiedSrcValid != nullptr)
+    if (poWK->panUnifiedSrcValid != nullptr)
+    {
+        for (int i = 0; i < nSrcLen; i += 2)
         {
-            for (int i = 0; i < nSrcLen; i += 2)
-            {
-                if (CPLMaskGet(poWK->panUnifiedSrcValid, iSrcOffset + i))
-                    bHasValid = true;
-                else
-                    padfDensity[i] = 0.0;
-
-                if (CPLMaskGet(poWK->panUnifiedSrcValid, iSrcOffset + i + 1))
-                    bHasValid = true;
-                else
-                    padfDensity[i + 1] = 0.0;
-            }
+            if (CPLMaskGet(poWK->panUnifiedSrcValid, iSrcOffset + i))
+                bHasValid = true;
+            else
+                padfDensity[i] = 0.0;
 
-            // Reset or fail as needed.
-            if (bHasValid)
-                bHasValid = false;
+            if (CPLMaskGet(poWK->panUnifiedSrcValid, iSrcOffset + i + 1))
+                bHasValid = true;
             else
-                return false;
+                padfDensity[i + 1] = 0.0;
         }
 
-        if (poWK->papanBandSrcValid != nullptr &&
-            poWK->papanBandSrcValid[iBand] != nullptr)
-        {
-            for (int i = 0; i < nSrcLen; i += 2)
-            {
-                if (CPLMaskGet(poWK->papanBandSrcValid[iBand], iSrcOffset + i))
-                    bHasValid = true;
-                else
-                    padfDensity[i] = 0.0;
+        // Reset or fail as needed.
+        if (bHasValid)
+            bHasValid = false;
+        else
+            return false;
+    }
 
-                if (CPLMaskGet(poWK->papanBandSrcValid[iBand],
-                               iSrcOffset + i + 1))
-                    bHasValid = true;
-                else
-                    padfDensity[i + 1] = 0.0;
-            }
+    if (poWK->papanBandSrcValid != nullptr &&
+        poWK->papanBandSrcValid[iBand] != nullptr)
+    {
+        for (int i = 0; i < nSrcLen; i += 2)
+        {
+            if (CPLMaskGet(poWK->papanBandSrcValid[iBand], iSrcOffset + i))
+                bHasValid = true;
+            else
+                padfDensity[i] = 0.0;
 
-            // Reset or fail as needed.
-            if (bHasValid)
-                bHasValid = false;
+            if (CPLMaskGet(poWK->papanBandSrcValid[iBand],
+                           iSrcOffset + i + 1))
+                bHasValid = true;
             else
-                return false;
+                padfDensity[i + 1] = 0.0;
         }
+
+        if (!bHasValid)
+            return false;
     }
 
-    // TODO(schwehr): Fix casting.
-    // Fetch data.
-    switch (poWK->eWorkingDataType)
+    return true;
+}
+
+/************************************************************************/
+/*                    GWKGetPixelRowFinishDensity()                     */
+/************************************************************************/
+
+/* Combines padfDensity[] with the unified source density. Returns false */
+/* if none of the pixels of the row has a significant density. */
+
+static bool GWKGetPixelRowFinishDensity(const GDALWarpKernel *poWK,
+                                        GPtrDiff_t iSrcOffset, int nSrcLen,
+                                        double *padfDensity)
+{
+    bool bHasValid = false;
+
+    if (poWK->pafUnifiedSrcDensity == nullptr)
     {
-        case GDT_Byte:
+        for (int i = 0; i < nSrcLen; i += 2)
         {
-            GByte *pSrc =
-                reinterpret_cast<GByte *>(poWK->papabySrcImage[iBand]);
-            pSrc += iSrcOffset;
-            for (int i = 0; i < nSrcLen; i += 2)
+            // Take into account earlier calcs.
+            if (padfDensity[i] > SRC_DENSITY_THRESHOLD)
             {
-                adfReal[i] = pSrc[i];
-                adfReal[i + 1] = pSrc[i + 1];
+                padfDensity[i] = 1.0;
+                bHasValid = true;
+            }
+
+            if (padfDensity[i + 1] > SRC_DENSITY_THRESHOLD)
+            {
+                padfDensity[i + 1] = 1.0;
+                bHasValid = true;
+            }
+        }
+    }
+    else
+    {
+        for (int i = 0; i < nSrcLen; i += 2)
+        {
+            if (padfDensity[i] > SRC_DENSITY_THRESHOLD)
+                padfDensity[i] = poWK->pafUnifiedSrcDensity[iSrcOffset + i];
+            if (padfDensity[i] > SRC_DENSITY_THRESHOLD)
+                bHasValid = true;
+
+            if (padfDensity[i + 1] > SRC_DENSITY_THRESHOLD)
+                padfDensity[i + 1] =
+                    poWK->pafUnifiedSrcDensity[iSrcOffset + i + 1];
+            if (padfDensity[i + 1] > SRC_DENSITY_THRESHOLD)
+                bHasValid = true;
+        }
+    }
+
+    return bHasValid;
+}
+
+/************************************************************************/
+/*                          GWKGetPixelRow()                            */
+/************************************************************************/
+
+/* It is assumed that adfImag[] is set to 0 by caller code for non-complex */
+/* data-types. */
+
+static bool GWKGetPixelRow(const GDALWarpKernel *poWK, int iBand,
+                           GPtrDiff_t iSrcOffset, int nHalfSrcLen,
+                           double *padfDensity, double adfReal[],
+                           double *padfImag)
+{
+    // We know that nSrcLen is even, so we can *always* unroll loops 2x.
+    const int nSrcLen = nHalfSrcLen * 2;
+
+    if (padfDensity != nullptr &&
+        !GWKGetPixelRowInitDensity(poWK, iBand, iSrcOffset, nSrcLen,
+                                   padfDensity))
+        return false;
+
+    // TODO(schwehr): Fix casting.
+    // Fetch data.
+    switch (poWK->eWorkingDataType)
+    {
+        case GDT_Byte:
+        {
+            GByte *pSrc =
+                reinterpret_cast<GByte *>(poWK->papabySrcImage[iBand]);
+            pSrc += iSrcOffset;
+            for (int i = 0; i < nSrcLen; i += 2)
+            {
+                adfReal[i] = pSrc[i];
+                adfReal[i + 1] = pSrc[i + 1];
             }
             break;
         }
@@ -2449,42 +2397,41 @@ static bool GWKGetPixelRow(const GDALWarpKernel *poWK, int iBand,
     if (padfDensity == nullptr)
         return true;
 
-    if (poWK->pafUnifiedSrcDensity == nullptr)
-    {
-        for (int i = 0; i < nSrcLen; i += 2)
-        {
-            // Take into account earlier calcs.
-            if (padfDensity[i] > SRC_DENSITY_THRESHOLD)
-            {
-                padfDensity[i] = 1.0;
-                bHasValid = true;
-            }
+    return GWKGetPixelRowFinishDensity(poWK, iSrcOffset, nSrcLen, padfDensity);
+}
 
-            if (padfDensity[i + 1] > SRC_DENSITY_THRESHOLD)
-            {
-                padfDensity[i + 1] = 1.0;
-                bHasValid = true;
-            }
-        }
-    }
-    else
-    {
-        for (int i = 0; i < nSrcLen; i += 2)
-        {
-            if (padfDensity[i] > SRC_DENSITY_THRESHOLD)
-                padfDensity[i] = poWK->pafUnifiedSrcDensity[iSrcOffset + i];
-            if (padfDensity[i] > SRC_DENSITY_THRESHOLD)
-                bHasValid = true;
+/************************************************************************/
+/*                          GWKGetPixelRowT()                           */
+/************************************************************************/
 
-            if (padfDensity[i + 1] > SRC_DENSITY_THRESHOLD)
-                padfDensity[i + 1] =
-                    poWK->pafUnifiedSrcDensity[iSrcOffset + i + 1];
-            if (padfDensity[i + 1] > SRC_DENSITY_THRESHOLD)
-                bHasValid = true;
-        }
+/* Same as GWKGetPixelRow(), for a non-complex working data type known at */
+/* compile time. */
+
+template <class T>
+static bool GWKGetPixelRowT(const GDALWarpKernel *poWK, int iBand,
+                            GPtrDiff_t iSrcOffset, int nHalfSrcLen,
+                            double *padfDensity, double adfReal[])
+{
+    // We know that nSrcLen is even, so we can *always* unroll loops 2x.
+    const int nSrcLen = nHalfSrcLen * 2;
+
+    if (padfDensity != nullptr &&
+        !GWKGetPixelRowInitDensity(poWK, iBand, iSrcOffset, nSrcLen,
+                                   padfDensity))
+        return false;
+
+    const T *pSrc =
+        reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]) + iSrcOffset;
+    for (int i = 0; i < nSrcLen; i += 2)
+    {
+        adfReal[i] = static_cast<double>(pSrc[i]);
+        adfReal[i + 1] = static_cast<double>(pSrc[i + 1]);
     }
 
-    return bHasValid;
+    if (padfDensity == nullptr)
+        return true;
+
+    return GWKGetPixelRowFinishDensity(poWK, iSrcOffset, nSrcLen, padfDensity);
 }
 
 /************************************************************************/
@@ -3939,31 +3886,226 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
         }
     }
 
-    GPtrDiff_t iRowOffset =
-        iSrcOffset + static_cast<GPtrDiff_t>(jMin - 1) * nSrcXSize + iMin;
+    GPtrDiff_t iRowOffset =
+        iSrcOffset + static_cast<GPtrDiff_t>(jMin - 1) * nSrcXSize + iMin;
+
+    // If we have no density information, we can simply compute the
+    // accumulated weight.
+    if (padfRowDensity == nullptr)
+    {
+        double dfRowAccWeight = 0.0;
+        for (int i = iMin; i <= iMax; ++i)
+        {
+            dfRowAccWeight += padfWeightsX[i - poWK->nFiltInitX];
+        }
+        double dfColAccWeight = 0.0;
+        for (int j = jMin; j <= jMax; ++j)
+        {
+            dfColAccWeight += padfWeightsY[j - poWK->nFiltInitY];
+        }
+        dfAccumulatorWeight = dfRowAccWeight * dfColAccWeight;
+    }
+
+    const bool bIsNonComplex = !GDALDataTypeIsComplex(poWK->eWorkingDataType);
+
+    // Loop over pixel rows in the kernel.
+    int nCountValid = 0;
+    for (int j = jMin; j <= jMax; ++j)
+    {
+        iRowOffset += nSrcXSize;
+
+        // Get pixel values.
+        // We can potentially read extra elements after the "normal" end of the
+        // source arrays, but the contract of papabySrcImage[iBand],
+        // papanBandSrcValid[iBand], panUnifiedSrcValid and pafUnifiedSrcDensity
+        // is to have WARP_EXTRA_ELTS reserved at their end.
+        if (!GWKGetPixelRow(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
+                            padfRowDensity, padfRowReal, padfRowImag))
+            continue;
+
+        const double dfWeight1 = padfWeightsY[j - poWK->nFiltInitY];
+
+        // Iterate over pixels in row.
+        if (padfRowDensity != nullptr)
+        {
+            for (int i = iMin; i <= iMax; ++i)
+            {
+                // Skip sampling if pixel has zero density.
+                if (padfRowDensity[i - iMin] < SRC_DENSITY_THRESHOLD)
+                    continue;
+
+                nCountValid++;
+
+                //  Use a cached set of weights for this row.
+                const double dfWeight2 =
+                    dfWeight1 * padfWeightsX[i - poWK->nFiltInitX];
+
+                // Accumulate!
+                dfAccumulatorReal += padfRowReal[i - iMin] * dfWeight2;
+                dfAccumulatorImag += padfRowImag[i - iMin] * dfWeight2;
+                dfAccumulatorDensity += padfRowDensity[i - iMin] * dfWeight2;
+                dfAccumulatorWeight += dfWeight2;
+            }
+        }
+        else if (bIsNonComplex)
+        {
+            double dfRowAccReal = 0.0;
+            for (int i = iMin; i <= iMax; ++i)
+            {
+                const double dfWeight2 = padfWeightsX[i - poWK->nFiltInitX];
+
+                // Accumulate!
+                dfRowAccReal += padfRowReal[i - iMin] * dfWeight2;
+            }
+
+            dfAccumulatorReal += dfRowAccReal * dfWeight1;
+        }
+        else
+        {
+            double dfRowAccReal = 0.0;
+            double dfRowAccImag = 0.0;
+            for (int i = iMin; i <= iMax; ++i)
+            {
+                const double dfWeight2 = padfWeightsX[i - poWK->nFiltInitX];
+
+                // Accumulate!
+                dfRowAccReal += padfRowReal[i - iMin] * dfWeight2;
+                dfRowAccImag += padfRowImag[i - iMin] * dfWeight2;
+            }
+
+            dfAccumulatorReal += dfRowAccReal * dfWeight1;
+            dfAccumulatorImag += dfRowAccImag * dfWeight1;
+        }
+    }
+
+    if (dfAccumulatorWeight < 0.000001 ||
+        (padfRowDensity != nullptr &&
+         (dfAccumulatorDensity < 0.000001 ||
+          nCountValid < (jMax - jMin + 1) * (iMax - iMin + 1) / 2)))
+    {
+        *pdfDensity = 0.0;
+        return false;
+    }
+
+    // Calculate the output taking into account weighting.
+    if (dfAccumulatorWeight < 0.99999 || dfAccumulatorWeight > 1.00001)
+    {
+        const double dfInvAcc = 1.0 / dfAccumulatorWeight;
+        *pdfReal = dfAccumulatorReal * dfInvAcc;
+        *pdfImag = dfAccumulatorImag * dfInvAcc;
+        if (padfRowDensity != nullptr)
+            *pdfDensity = dfAccumulatorDensity * dfInvAcc;
+        else
+            *pdfDensity = 1.0;
+    }
+    else
+    {
+        *pdfReal = dfAccumulatorReal;
+        *pdfImag = dfAccumulatorImag;
+        if (padfRowDensity != nullptr)
+            *pdfDensity = dfAccumulatorDensity;
+        else
+            *pdfDensity = 1.0;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                             GWKFilterT()                             */
+/************************************************************************/
+
+template <GDALResampleAlg eResample> static double GWKFilterT(double dfX);
+
+template <> double GWKFilterT<GRA_Bilinear>(double dfX)
+{
+    return GWKBilinear(dfX);
+}
+
+template <> double GWKFilterT<GRA_Cubic>(double dfX)
+{
+    return GWKCubic(dfX);
+}
+
+template <> double GWKFilterT<GRA_CubicSpline>(double dfX)
+{
+    return GWKBSpline(dfX);
+}
+
+template <> double GWKFilterT<GRA_Lanczos>(double dfX)
+{
+    return GWKLanczosSinc(dfX);
+}
+
+/************************************************************************/
+/*                          GWKResampleRealT()                          */
+/************************************************************************/
+
+/* Same as GWKResample(), for a non-complex working data type and a */
+/* resampling kernel known at compile time. The X weights are computed */
+/* once per output pixel, and the accumulations are done in the same order */
+/* as GWKResample() so that results are identical. */
+
+template <class T, GDALResampleAlg eResample>
+static bool GWKResampleRealT(const GDALWarpKernel *poWK, int iBand,
+                             double dfSrcX, double dfSrcY, double *pdfDensity,
+                             double *pdfReal, GWKResampleWrkStruct *psWrkStruct)
+
+{
+    // Save as local variables to avoid following pointers in loops.
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int nSrcYSize = poWK->nSrcYSize;
+
+    double dfAccumulatorReal = 0.0;
+    double dfAccumulatorDensity = 0.0;
+    double dfAccumulatorWeight = 0.0;
+    const int iSrcX = static_cast<int>(floor(dfSrcX - 0.5));
+    const int iSrcY = static_cast<int>(floor(dfSrcY - 0.5));
+    const GPtrDiff_t iSrcOffset =
+        iSrcX + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+    const double dfDeltaX = dfSrcX - 0.5 - iSrcX;
+    const double dfDeltaY = dfSrcY - 0.5 - iSrcY;
+
+    const double dfXScale = poWK->dfXScale;
+    const double dfYScale = poWK->dfYScale;
+
+    double *padfWeightsX = psWrkStruct->padfWeightsX;
+
+    // Space for saving a row of pixels.
+    double *padfRowDensity = psWrkStruct->padfRowDensity;
+    double *padfRowReal = psWrkStruct->padfRowReal;
+
+    // Skip sampling over edge of image.
+    int j = poWK->nFiltInitY;
+    int jMax = poWK->nYRadius;
+    if (iSrcY + j < 0)
+        j = -iSrcY;
+    if (iSrcY + jMax >= nSrcYSize)
+        jMax = nSrcYSize - iSrcY - 1;
+
+    int iMin = poWK->nFiltInitX;
+    int iMax = poWK->nXRadius;
+    if (iSrcX + iMin < 0)
+        iMin = -iSrcX;
+    if (iSrcX + iMax >= nSrcXSize)
+        iMax = nSrcXSize - iSrcX - 1;
+
+    const bool bXScaleBelow1 = (dfXScale < 1.0);
+    const bool bYScaleBelow1 = (dfYScale < 1.0);
 
-    // If we have no density information, we can simply compute the
-    // accumulated weight.
-    if (padfRowDensity == nullptr)
+    // The X weights are the same for all rows of the kernel.
+    for (int i = iMin; i <= iMax; ++i)
     {
-        double dfRowAccWeight = 0.0;
-        for (int i = iMin; i <= iMax; ++i)
-        {
-            dfRowAccWeight += padfWeightsX[i - poWK->nFiltInitX];
-        }
-        double dfColAccWeight = 0.0;
-        for (int j = jMin; j <= jMax; ++j)
-        {
-            dfColAccWeight += padfWeightsY[j - poWK->nFiltInitY];
-        }
-        dfAccumulatorWeight = dfRowAccWeight * dfColAccWeight;
+        padfWeightsX[i - iMin] =
+            bXScaleBelow1 ? GWKFilterT<eResample>((i - dfDeltaX) * dfXScale)
+                          : GWKFilterT<eResample>(i - dfDeltaX);
     }
 
-    const bool bIsNonComplex = !GDALDataTypeIsComplex(poWK->eWorkingDataType);
+    GPtrDiff_t iRowOffset =
+        iSrcOffset + static_cast<GPtrDiff_t>(j - 1) * nSrcXSize + iMin;
 
     // Loop over pixel rows in the kernel.
-    int nCountValid = 0;
-    for (int j = jMin; j <= jMax; ++j)
+    for (; j <= jMax; ++j)
     {
         iRowOffset += nSrcXSize;
 
@@ -3972,69 +4114,52 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
         // source arrays, but the contract of papabySrcImage[iBand],
         // papanBandSrcValid[iBand], panUnifiedSrcValid and pafUnifiedSrcDensity
         // is to have WARP_EXTRA_ELTS reserved at their end.
-        if (!GWKGetPixelRow(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
-                            padfRowDensity, padfRowReal, padfRowImag))
+        if (!GWKGetPixelRowT<T>(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
+                                padfRowDensity, padfRowReal))
             continue;
 
-        const double dfWeight1 = padfWeightsY[j - poWK->nFiltInitY];
+        // Calculate the Y weight.
+        const double dfWeight1 =
+            bYScaleBelow1 ? GWKFilterT<eResample>((j - dfDeltaY) * dfYScale)
+                          : GWKFilterT<eResample>(j - dfDeltaY);
 
         // Iterate over pixels in row.
-        if (padfRowDensity != nullptr)
-        {
-            for (int i = iMin; i <= iMax; ++i)
-            {
-                // Skip sampling if pixel has zero density.
-                if (padfRowDensity[i - iMin] < SRC_DENSITY_THRESHOLD)
-                    continue;
-
-                nCountValid++;
-
-                //  Use a cached set of weights for this row.
-                const double dfWeight2 =
-                    dfWeight1 * padfWeightsX[i - poWK->nFiltInitX];
+        double dfAccumulatorRealLocal = 0.0;
+        double dfAccumulatorDensityLocal = 0.0;
+        double dfAccumulatorWeightLocal = 0.0;
 
-                // Accumulate!
-                dfAccumulatorReal += padfRowReal[i - iMin] * dfWeight2;
-                dfAccumulatorImag += padfRowImag[i - iMin] * dfWeight2;
-                dfAccumulatorDensity += padfRowDensity[i - iMin] * dfWeight2;
-                dfAccumulatorWeight += dfWeight2;
-            }
-        }
-        else if (bIsNonComplex)
+        if (padfRowDensity == nullptr)
         {
-            double dfRowAccReal = 0.0;
             for (int i = iMin; i <= iMax; ++i)
             {
-                const double dfWeight2 = padfWeightsX[i - poWK->nFiltInitX];
-
-                // Accumulate!
-                dfRowAccReal += padfRowReal[i - iMin] * dfWeight2;
+                const double dfWeight2 = padfWeightsX[i - iMin];
+                dfAccumulatorRealLocal += padfRowReal[i - iMin] * dfWeight2;
+                dfAccumulatorWeightLocal += dfWeight2;
             }
-
-            dfAccumulatorReal += dfRowAccReal * dfWeight1;
         }
         else
         {
-            double dfRowAccReal = 0.0;
-            double dfRowAccImag = 0.0;
             for (int i = iMin; i <= iMax; ++i)
             {
-                const double dfWeight2 = padfWeightsX[i - poWK->nFiltInitX];
+                // Skip sampling if pixel has zero density.
+                if (padfRowDensity[i - iMin] < SRC_DENSITY_THRESHOLD)
+                    continue;
 
-                // Accumulate!
-                dfRowAccReal += padfRowReal[i - iMin] * dfWeight2;
-                dfRowAccImag += padfRowImag[i - iMin] * dfWeight2;
+                const double dfWeight2 = padfWeightsX[i - iMin];
+                dfAccumulatorRealLocal += padfRowReal[i - iMin] * dfWeight2;
+                dfAccumulatorDensityLocal +=
+                    padfRowDensity[i - iMin] * dfWeight2;
+                dfAccumulatorWeightLocal += dfWeight2;
             }
-
-            dfAccumulatorReal += dfRowAccReal * dfWeight1;
-            dfAccumulatorImag += dfRowAccImag * dfWeight1;
         }
+
+        dfAccumulatorReal += dfAccumulatorRealLocal * dfWeight1;
+        dfAccumulatorDensity += dfAccumulatorDensityLocal * dfWeight1;
+        dfAccumulatorWeight += dfAccumulatorWeightLocal * dfWeight1;
     }
 
     if (dfAccumulatorWeight < 0.000001 ||
-        (padfRowDensity != nullptr &&
-         (dfAccumulatorDensity < 0.000001 ||
-          nCountValid < (jMax - jMin + 1) * (iMax - iMin + 1) / 2)))
+        (padfRowDensity != nullptr && dfAccumulatorDensity < 0.000001))
     {
         *pdfDensity = 0.0;
         return false;
@@ -4043,18 +4168,15 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
     // Calculate the output taking into account weighting.
     if (dfAccumulatorWeight < 0.99999 || dfAccumulatorWeight > 1.00001)
     {
-        const double dfInvAcc = 1.0 / dfAccumulatorWeight;
-        *pdfReal = dfAccumulatorReal * dfInvAcc;
-        *pdfImag = dfAccumulatorImag * dfInvAcc;
+        *pdfReal = dfAccumulatorReal / dfAccumulatorWeight;
         if (padfRowDensity != nullptr)
-            *pdfDensity = dfAccumulatorDensity * dfInvAcc;
+            *pdfDensity = dfAccumulatorDensity / dfAccumulatorWeight;
         else
             *pdfDensity = 1.0;
     }
     else
     {
         *pdfReal = dfAccumulatorReal;
-        *pdfImag = dfAccumulatorImag;
         if (padfRowDensity != nullptr)
             *pdfDensity = dfAccumulatorDensity;
         else
@@ -5281,6 +5403,7 @@ static CPLErr GWKGeneralCase(GDALWarpKernel *poWK)
 /*      General case for non-complex data types.                        */
 /************************************************************************/
 
+template <class T, GDALResampleAlg eResample>
 static void GWKRealCaseThread(void *pData)
 
 {
@@ -5310,8 +5433,13 @@ static void GWKRealCaseThread(void *pData)
     const bool bUse4SamplesFormula =
         poWK->dfXScale >= 0.95 && poWK->dfYScale >= 0.95;
 
+    // Nearest neighbour never reaches GWKResampleRealT(): avoid
+    // instantiating it, and GWKFilterT(), for that case.
+    constexpr GDALResampleAlg eResampleKernel =
+        eResample == GRA_NearestNeighbour ? GRA_Bilinear : eResample;
+
     GWKResampleWrkStruct *psWrkStruct = nullptr;
-    if (poWK->eResample != GRA_NearestNeighbour)
+    if (eResample != GRA_NearestNeighbour)
     {
         psWrkStruct = GWKResampleCreateWrkStruct(poWK);
     }
@@ -5414,15 +5542,15 @@ static void GWKRealCaseThread(void *pData)
                 /*      Collect the source value. */
                 /* --------------------------------------------------------------------
                  */
-                if (poWK->eResample == GRA_NearestNeighbour || nSrcXSize == 1 ||
+                if (eResample == GRA_NearestNeighbour || nSrcXSize == 1 ||
                     nSrcYSize == 1)
                 {
                     // FALSE is returned if dfBandDensity == 0, which is
                     // checked below.
-                    CPL_IGNORE_RET_VAL(GWKGetPixelValueReal(
+                    CPL_IGNORE_RET_VAL(GWKGetPixelValueReal<T>(
                         poWK, iBand, iSrcOffset, &dfBandDensity, &dfValueReal));
                 }
-                else if (poWK->eResample == GRA_Bilinear && bUse4SamplesFormula)
+                else if (eResample == GRA_Bilinear && bUse4SamplesFormula)
                 {
                     double dfValueImagIgnored = 0.0;
                     GWKBilinearResample4Sample(
@@ -5430,7 +5558,7 @@ static void GWKRealCaseThread(void *pData)
                         padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
                         &dfValueReal, &dfValueImagIgnored);
                 }
-                else if (poWK->eResample == GRA_Cubic && bUse4SamplesFormula)
+                else if (eResample == GRA_Cubic && bUse4SamplesFormula)
                 {
                     if (bSrcMaskIsDensity)
                     {
@@ -5472,11 +5600,21 @@ static void GWKRealCaseThread(void *pData)
                     if (psWrkStruct != nullptr)
 #endif
                     {
-                        double dfValueImagIgnored = 0.0;
-                        psWrkStruct->pfnGWKResample(
-                            poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
-                            padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
-                            &dfValueReal, &dfValueImagIgnored, psWrkStruct);
+                        if (eResample == GRA_Lanczos)
+                        {
+                            double dfValueImagIgnored = 0.0;
+                            GWKResampleOptimizedLanczos(
+                                poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
+                                padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
+                                &dfValueReal, &dfValueImagIgnored, psWrkStruct);
+                        }
+                        else
+                        {
+                            GWKResampleRealT<T, eResampleKernel>(
+                                poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
+                                padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
+                                &dfValueReal, psWrkStruct);
+                        }
                     }
 
                 // If we didn't find any valid inputs skip to next band.
@@ -5503,8 +5641,8 @@ static void GWKRealCaseThread(void *pData)
                 /*      the destination pixel. */
                 /* --------------------------------------------------------------------
                  */
-                GWKSetPixelValueReal(poWK, iBand, iDstOffset, dfBandDensity,
-                                     dfValueReal);
+                GWKSetPixelValueReal<T>(poWK, iBand, iDstOffset, dfBandDensity,
+                                        dfValueReal);
             }
 
             if (!bHasFoundDensity)
@@ -5543,9 +5681,58 @@ static void GWKRealCaseThread(void *pData)
         GWKResampleDeleteWrkStruct(psWrkStruct);
 }
 
+template <class T> static CPLErr GWKRealCaseT(GDALWarpKernel *poWK)
+{
+    switch (poWK->eResample)
+    {
+        case GRA_NearestNeighbour:
+            return GWKRun(poWK, "GWKRealCase",
+                          GWKRealCaseThread<T, GRA_NearestNeighbour>);
+        case GRA_Bilinear:
+            return GWKRun(poWK, "GWKRealCase",
+                          GWKRealCaseThread<T, GRA_Bilinear>);
+        case GRA_Cubic:
+            return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<T, GRA_Cubic>);
+        case GRA_CubicSpline:
+            return GWKRun(poWK, "GWKRealCase",
+                          GWKRealCaseThread<T, GRA_CubicSpline>);
+        case GRA_Lanczos:
+            return GWKRun(poWK, "GWKRealCase",
+                          GWKRealCaseThread<T, GRA_Lanczos>);
+        default:
+            break;
+    }
+    return GWKGeneralCase(poWK);
+}
+
 static CPLErr GWKRealCase(GDALWarpKernel *poWK)
 {
-    return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread);
+    switch (poWK->eWorkingDataType)
+    {
+        case GDT_Byte:
+            return GWKRealCaseT<GByte>(poWK);
+        case GDT_Int8:
+            return GWKRealCaseT<GInt8>(poWK);
+        case GDT_Int16:
+            return GWKRealCaseT<GInt16>(poWK);
+        case GDT_UInt16:
+            return GWKRealCaseT<GUInt16>(poWK);
+        case GDT_Int32:
+            return GWKRealCaseT<GInt32>(poWK);
+        case GDT_UInt32:
+            return GWKRealCaseT<GUInt32>(poWK);
+        case GDT_Int64:
+            return GWKRealCaseT<std::int64_t>(poWK);
+        case GDT_UInt64:
+            return GWKRealCaseT<std::uint64_t>(poWK);
+        case GDT_Float32:
+            return GWKRealCaseT<float>(poWK);
+        case GDT_Float64:
+            return GWKRealCaseT<double>(poWK);
+        default:
+            break;
+    }
+    return GWKGeneralCase(poWK);
 }
 
 /************************************************************************/
@@ -6067,6 +6254,220 @@ static CPLErr GWKNearestFloat(GDALWarpKernel *poWK)
     return GWKRun(poWK, "GWKNearestFloat", GWKNearestThread<float>);
 }
 
+template <class T>
+static CPLErr GWKNearestNoMasksOrDstDensityOnlyT(GDALWarpKernel *poWK)
+{
+    return GWKRun(
+        poWK, "GWKNearestNoMasksOrDstDensityOnlyT",
+        GWKResampleNoMasksOrDstDensityOnlyThread<T, GRA_NearestNeighbour>);
+}
+
+/************************************************************************/
+/*                          GWKModeHashTable                            */
+/************************************************************************/
+
+namespace
+{
+// Open addressing hash table counting the occurrences of floating-point
+// values, used by the mode algorithm on data types that are not histogram
+// friendly. Slots are cleared lazily, so that resetting the table between
+// target pixels only costs the number of distinct values seen.
+class GWKModeHashTable
+{
+    std::vector<float> m_afValues{};
+    std::vector<int> m_anCounts{};  // 0 for an empty slot
+    std::vector<int> m_anUsedSlots{};
+    unsigned m_nMask = 0;
+
+    static unsigned Hash(float fVal)
+    {
+        // 0.0 and -0.0 compare equal, so they must hash the same.
+        if (fVal == 0.0f)
+            fVal = 0.0f;
+        GUInt32 nBits = 0;
+        memcpy(&nBits, &fVal, sizeof(nBits));
+        return (nBits * 0x9E3779B1U) ^ (nBits >> 16);
+    }
+
+  public:
+    // Prepare the table to receive at most nMaxValues values.
+    void Reset(size_t nMaxValues)
+    {
+        for (int iSlot : m_anUsedSlots)
+            m_anCounts[iSlot] = 0;
+        m_anUsedSlots.clear();
+
+        size_t nSize = 16;
+        while (nSize < 2 * nMaxValues)
+            nSize *= 2;
+        if (nSize > m_anCounts.size())
+        {
+            m_afValues.resize(nSize);
+            m_anCounts.assign(nSize, 0);
+            m_nMask = static_cast<unsigned>(nSize - 1);
+        }
+    }
+
+    // Count one more occurrence of fVal (not NaN), and return its count.
+    int Add(float fVal)
+    {
+        unsigned iSlot = Hash(fVal) & m_nMask;
+        while (m_anCounts[iSlot] != 0)
+        {
+            if (m_afValues[iSlot] == fVal)
+                return ++m_anCounts[iSlot];
+            iSlot = (iSlot + 1) & m_nMask;
+        }
+        m_afValues[iSlot] = fVal;
+        m_anCounts[iSlot] = 1;
+        m_anUsedSlots.push_back(static_cast<int>(iSlot));
+        return 1;
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                    GWKAverageOrModeWholePixels()                     */
+/************************************************************************/
+
+// Fast path of GWKAverageOrModeThread() for the average, RMS, minimum and
+// maximum algorithms, used when the source window of a target pixel is made
+// of whole source pixels (all weights are 1) and there is no source mask.
+// The result is identical to the one of the general code path: small integer
+// values are summed exactly with integer arithmetic (which vectorizes), and
+// other values are summed in the same order.
+
+template <class T>
+static double GWKAverageOrModeWholePixelsT(const GDALWarpKernel *poWK,
+                                           int iBand, int nAlgo, int iSrcXMin,
+                                           int iSrcXMax, int iSrcYMin,
+                                           int iSrcYMax)
+{
+    const T *pSrc = reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]);
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int nXCount = iSrcXMax - iSrcXMin;
+    const double dfCount =
+        static_cast<double>(nXCount) * (iSrcYMax - iSrcYMin);
+
+    if (nAlgo == GWKAOM_Min || nAlgo == GWKAOM_Max)
+    {
+        double dfRes = nAlgo == GWKAOM_Max
+                           ? std::numeric_limits<double>::lowest()
+                           : std::numeric_limits<double>::max();
+        for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
+        {
+            const T *pRow =
+                pSrc + iSrcXMin + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+            if (nAlgo == GWKAOM_Max)
+            {
+                for (int iX = 0; iX < nXCount; iX++)
+                {
+                    const double dfVal = static_cast<double>(pRow[iX]);
+                    if (dfRes < dfVal)
+                        dfRes = dfVal;
+                }
+            }
+            else
+            {
+                for (int iX = 0; iX < nXCount; iX++)
+                {
+                    const double dfVal = static_cast<double>(pRow[iX]);
+                    if (dfRes > dfVal)
+                        dfRes = dfVal;
+                }
+            }
+        }
+        return dfRes;
+    }
+
+    const bool bRMS = nAlgo == GWKAOM_RMS;
+    double dfTotal = 0.0;
+    // Integer sums are exact as long as they fit in the 53-bit mantissa of
+    // the double accumulator of the general code path.
+    if (std::numeric_limits<T>::is_integer &&
+        sizeof(T) <= (bRMS ? 2U : 4U) && dfCount <= (1 << 20))
+    {
+        std::int64_t nTotal = 0;
+        for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
+        {
+            const T *pRow =
+                pSrc + iSrcXMin + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+            std::int64_t nRowTotal = 0;
+            if (bRMS)
+            {
+                for (int iX = 0; iX < nXCount; iX++)
+                    nRowTotal += static_cast<std::int64_t>(pRow[iX]) * pRow[iX];
+            }
+            else
+            {
+                for (int iX = 0; iX < nXCount; iX++)
+                    nRowTotal += pRow[iX];
+            }
+            nTotal += nRowTotal;
+        }
+        dfTotal = static_cast<double>(nTotal);
+    }
+    else
+    {
+        for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
+        {
+            const T *pRow =
+                pSrc + iSrcXMin + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+            for (int iX = 0; iX < nXCount; iX++)
+            {
+                const double dfVal = static_cast<double>(pRow[iX]);
+                dfTotal += bRMS ? dfVal * dfVal : dfVal;
+            }
+        }
+    }
+
+    return bRMS ? sqrt(dfTotal / dfCount) : dfTotal / dfCount;
+}
+
+static double GWKAverageOrModeWholePixels(const GDALWarpKernel *poWK,
+                                          int iBand, int nAlgo, int iSrcXMin,
+                                          int iSrcXMax, int iSrcYMin,
+                                          int iSrcYMax)
+{
+    switch (poWK->eWorkingDataType)
+    {
+        case GDT_Byte:
+            return GWKAverageOrModeWholePixelsT<GByte>(
+                poWK, iBand, nAlgo, iSrcXMin, iSrcXMax, iSrcYMin, iSrcYMax);
+        case GDT_Int8:
+            return GWKAverageOrModeWholePixelsT<GInt8>(
+                poWK, iBand, nAlgo, iSrcXMin, iSrcXMax, iSrcYMin, iSrcYMax);
+        case GDT_Int16:
+            return GWKAverageOrModeWholePixelsT<GInt16>(
+                poWK, iBand, nAlgo, iSrcXMin, iSrcXMax, iSrcYMin, iSrcYMax);
+        case GDT_UInt16:
+            return GWKAverageOrModeWholePixelsT<GUInt16>(
+                poWK, iBand, nAlgo, iSrcXMin, iSrcXMax, iSrcYMin, iSrcYMax);
+        case GDT_Int32:
+            return GWKAverageOrModeWholePixelsT<GInt32>(
+                poWK, iBand, nAlgo, iSrcXMin, iSrcXMax, iSrcYMin, iSrcYMax);
+        case GDT_UInt32:
+            return GWKAverageOrModeWholePixelsT<GUInt32>(
+                poWK, iBand, nAlgo, iSrcXMin, iSrcXMax, iSrcYMin, iSrcYMax);
+        case GDT_Int64:
+            return GWKAverageOrModeWholePixelsT<std::int64_t>(
+                poWK, iBand, nAlgo, iSrcXMin, iSrcXMax, iSrcYMin, iSrcYMax);
+        case GDT_UInt64:
+            return GWKAverageOrModeWholePixelsT<std::uint64_t>(
+                poWK, iBand, nAlgo, iSrcXMin, iSrcXMax, iSrcYMin, iSrcYMax);
+        case GDT_Float32:
+            return GWKAverageOrModeWholePixelsT<float>(
+                poWK, iBand, nAlgo, iSrcXMin, iSrcXMax, iSrcYMin, iSrcYMax);
+        case GDT_Float64:
+            return GWKAverageOrModeWholePixelsT<double>(
+                poWK, iBand, nAlgo, iSrcXMin, iSrcXMax, iSrcYMin, iSrcYMax);
+        default:
+            break;
+    }
+    CPLAssert(false);
+    return 0.0;
+}
+
 /************************************************************************/
 /*                           GWKAverageOrMode()                         */
 /*                                                                      */
@@ -6100,15 +6501,17 @@ static void GWKAverageOrModeThread(void *pData)
     int *panVals = nullptr;
     int nBins = 0;
     int nBinsOffset = 0;
+    // Bins touched for the current pixel, to reset only them when the
+    // histogram is large.
+    bool bTrackTouchedBins = false;
+    std::vector<int> anTouchedBins;
 
     // Only used with nAlgo = 2.
-    float *pafRealVals = nullptr;
-    float *pafImagVals = nullptr;
-    int *panRealSums = nullptr;
-    int *panImagSums = nullptr;
+    GWKModeHashTable oModeHashTable;
 
     // Only used with nAlgo = 6.
     float quant = 0.5;
+    std::vector<double> adfQuantValues;
 
     // To control array allocation only when data type is complex
     const bool bIsComplex = GDALDataTypeIsComplex(poWK->eWorkingDataType) != 0;
@@ -6154,27 +6557,14 @@ static void GWKAverageOrModeThread(void *pData)
                 nBins = 65536;
             }
             panVals =
-                static_cast<int *>(VSI_MALLOC_VERBOSE(nBins * sizeof(int)));
+                static_cast<int *>(VSI_CALLOC_VERBOSE(nBins, sizeof(int)));
             if (panVals == nullptr)
                 return;
+            bTrackTouchedBins = nBins > 256;
         }
         else
         {
             nAlgo = GWKAOM_Fmode;
-
-            if (nSrcXSize > 0 && nSrcYSize > 0)
-            {
-                pafRealVals = static_cast<float *>(
-                    VSI_MALLOC3_VERBOSE(nSrcXSize, nSrcYSize, sizeof(float)));
-                panRealSums = static_cast<int *>(
-                    VSI_MALLOC3_VERBOSE(nSrcXSize, nSrcYSize, sizeof(int)));
-                if (pafRealVals == nullptr || panRealSums == nullptr)
-                {
-                    VSIFree(pafRealVals);
-                    VSIFree(panRealSums);
-                    return;
-                }
-            }
         }
     }
     else if (poWK->eResample == GRA_Max)
@@ -6247,6 +6637,28 @@ static void GWKAverageOrModeThread(void *pData)
     const int nYMargin =
         2 * std::max(1, static_cast<int>(std::ceil(1. / poWK->dfYScale)));
 
+    // With an axis-aligned transform, pixel corners that fall within
+    // numerical noise of source pixel boundaries are snapped on them, which
+    // is typically the case of integer downsampling ratios. Source windows
+    // made of whole pixels can then use GWKAverageOrModeWholePixels().
+    const bool bIsAffineNoRotation =
+        GDALTransformIsAffineNoRotation(poWK->pfnTransformer,
+                                        psJob->pTransformerArg) &&
+        // for debug/testing purposes
+        CPLTestBool(
+            CPLGetConfigOption("GDAL_WARP_USE_AFFINE_OPTIMIZATION", "YES"));
+    const auto SnapToPixelBoundary = [](double &dfVal)
+    {
+        const double dfRounded = std::round(dfVal);
+        if (std::fabs(dfVal - dfRounded) <= 1e-10)
+            dfVal = dfRounded;
+    };
+    const bool bCanUseWholePixels =
+        !bIsComplex && poWK->panUnifiedSrcValid == nullptr &&
+        poWK->pafUnifiedSrcDensity == nullptr &&
+        (nAlgo == GWKAOM_Average || nAlgo == GWKAOM_RMS ||
+         nAlgo == GWKAOM_Min || nAlgo == GWKAOM_Max);
+
     /* ==================================================================== */
     /*      Loop over output lines.                                         */
     /* ==================================================================== */
@@ -6292,6 +6704,17 @@ static void GWKAverageOrModeThread(void *pData)
                 iDstY + 1.0 + poWK->nDstYOff);
         }
 
+        if (bIsAffineNoRotation)
+        {
+            for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+            {
+                SnapToPixelBoundary(padfX[iDstX]);
+                SnapToPixelBoundary(padfY[iDstX]);
+                SnapToPixelBoundary(padfX2[iDstX]);
+                SnapToPixelBoundary(padfY2[iDstX]);
+            }
+        }
+
         /* ====================================================================
          */
         /*      Loop over pixels in output scanline. */
@@ -6379,6 +6802,12 @@ static void GWKAverageOrModeThread(void *pData)
             if (iSrcYMin == iSrcYMax && iSrcYMax < nSrcYSize)
                 iSrcYMax++;
 
+            const bool bWholePixels =
+                bCanUseWholePixels && !bWrapOverX && dfXMin == iSrcXMin &&
+                dfXMax == iSrcXMax && dfYMin == iSrcYMin &&
+                dfYMax == iSrcYMax && iSrcXMin < iSrcXMax &&
+                iSrcYMin < iSrcYMax;
+
             /* ====================================================================
              */
             /*      Loop processing each band. */
@@ -6414,8 +6843,30 @@ static void GWKAverageOrModeThread(void *pData)
      : (iSrcX + 1 == iSrcXMax) ? dfWeightY * (1 - (iSrcXMax - dfXMax))         \
                                : dfWeightY)
 
+                if (bWholePixels &&
+                    (poWK->papanBandSrcValid == nullptr ||
+                     poWK->papanBandSrcValid[iBand] == nullptr))
+                {
+                    dfValueReal = GWKAverageOrModeWholePixels(
+                        poWK, iBand, nAlgo, iSrcXMin, iSrcXMax, iSrcYMin,
+                        iSrcYMax);
+
+                    if (poWK->bApplyVerticalShift)
+                    {
+                        if (!std::isfinite(padfZ[iDstX]))
+                            continue;
+                        // Subtract padfZ[] since the coordinate
+                        // transformation is from target to source
+                        dfValueReal =
+                            dfValueReal * poWK->dfMultFactorVerticalShift -
+                            padfZ[iDstX];
+                    }
+
+                    dfBandDensity = 1;
+                    bHasFoundDensity = true;
+                }
                 // poWK->eResample == GRA_Average.
-                if (nAlgo == GWKAOM_Average)
+                else if (nAlgo == GWKAOM_Average)
                 {
                     double dfTotalReal = 0.0;
                     double dfTotalImag = 0.0;
@@ -6484,7 +6935,7 @@ static void GWKAverageOrModeThread(void *pData)
                     }
                 }  // GRA_Average.
                 // poWK->eResample == GRA_RMS.
-                if (nAlgo == GWKAOM_RMS)
+                else if (nAlgo == GWKAOM_RMS)
                 {
                     double dfTotalReal = 0.0;
                     double dfTotalImag = 0.0;
@@ -6630,9 +7081,14 @@ static void GWKAverageOrModeThread(void *pData)
                         // majority filter on floating point data? But, here it
                         // is for the sake of compatibility. It won't look
                         // right on RGB images by the nature of the filter.
-                        int iMaxInd = 0;
-                        int iMaxVal = -1;
-                        int i = 0;
+                        // As with the histogram, the mode is the first value
+                        // whose count exceeds the one of all other values.
+                        float fMaxVal = 0.0f;
+                        int nMaxCount = 0;
+
+                        oModeHashTable.Reset(
+                            static_cast<size_t>(iSrcXMax - iSrcXMin) *
+                            (iSrcYMax - iSrcYMin));
 
                         for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
                         {
@@ -6661,34 +7117,24 @@ static void GWKAverageOrModeThread(void *pData)
                                     const float fVal =
                                         static_cast<float>(dfValueRealTmp);
 
-                                    // Check array for existing entry.
-                                    for (i = 0; i < iMaxInd; ++i)
-                                        if (pafRealVals[i] == fVal &&
-                                            ++panRealSums[i] >
-                                                panRealSums[iMaxVal])
-                                        {
-                                            iMaxVal = i;
-                                            break;
-                                        }
-
-                                    // Add to arr if entry not already there.
-                                    if (i == iMaxInd)
+                                    // NaN never compares equal to any
+                                    // value, so it is counted only once.
+                                    const int nCount =
+                                        CPLIsNan(fVal)
+                                            ? 1
+                                            : oModeHashTable.Add(fVal);
+                                    if (nCount > nMaxCount)
                                     {
-                                        pafRealVals[iMaxInd] = fVal;
-                                        panRealSums[iMaxInd] = 1;
-
-                                        if (iMaxVal < 0)
-                                            iMaxVal = iMaxInd;
-
-                                        ++iMaxInd;
+                                        nMaxCount = nCount;
+                                        fMaxVal = fVal;
                                     }
                                 }
                             }
                         }
 
-                        if (iMaxVal != -1)
+                        if (nMaxCount > 0)
                         {
-                            dfValueReal = pafRealVals[iMaxVal];
+                            dfValueReal = fMaxVal;
 
                             if (poWK->bApplyVerticalShift)
                             {
@@ -6711,7 +7157,8 @@ static void GWKAverageOrModeThread(void *pData)
                         int nMaxVal = 0;
                         int iMaxInd = -1;
 
-                        memset(panVals, 0, nBins * sizeof(int));
+                        if (!bTrackTouchedBins)
+                            memset(panVals, 0, nBins * sizeof(int));
 
                         for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
                         {
@@ -6739,6 +7186,10 @@ static void GWKAverageOrModeThread(void *pData)
                                 {
                                     const int nVal =
                                         static_cast<int>(dfValueRealTmp);
+                                    if (bTrackTouchedBins &&
+                                        panVals[nVal + nBinsOffset] == 0)
+                                        anTouchedBins.push_back(nVal +
+                                                                nBinsOffset);
                                     if (++panVals[nVal + nBinsOffset] > nMaxVal)
                                     {
                                         // Sum the density.
@@ -6750,6 +7201,12 @@ static void GWKAverageOrModeThread(void *pData)
                             }
                         }
 
+                        // Reset only the bins used by this pixel, instead of
+                        // the whole 65536 bins histogram.
+                        for (int iBin : anTouchedBins)
+                            panVals[iBin] = 0;
+                        anTouchedBins.clear();
+
                         if (iMaxInd != -1)
                         {
                             dfValueReal = iMaxInd;
@@ -6893,7 +7350,8 @@ static void GWKAverageOrModeThread(void *pData)
                 // poWK->eResample == GRA_Med | GRA_Q1 | GRA_Q3.
                 {
                     bool bFoundValid = false;
-                    std::vector<double> dfRealValuesTmp;
+                    std::vector<double> &dfRealValuesTmp = adfQuantValues;
+                    dfRealValuesTmp.clear();
 
                     // This code adapted from nAlgo 1 method, GRA_Average.
                     for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
@@ -6929,10 +7387,13 @@ static void GWKAverageOrModeThread(void *pData)
 
                     if (bFoundValid)
                     {
-                        std::sort(dfRealValuesTmp.begin(),
-                                  dfRealValuesTmp.end());
+                        // Only the value at the quantile position is needed,
+                        // so a selection is enough instead of a full sort.
                         int quantIdx = static_cast<int>(
                             std::ceil(quant * dfRealValuesTmp.size() - 1));
+                        std::nth_element(dfRealValuesTmp.begin(),
+                                         dfRealValuesTmp.begin() + quantIdx,
+                                         dfRealValuesTmp.end());
                         dfValueReal = dfRealValuesTmp[quantIdx];
 
                         if (poWK->bApplyVerticalShift)
@@ -6948,7 +7409,6 @@ static void GWKAverageOrModeThread(void *pData)
 
                         dfBandDensity = 1;
                         bHasFoundDensity = true;
-                        dfRealValuesTmp.clear();
                     }
                 }  // Quantile.
 
@@ -7010,13 +7470,6 @@ static void GWKAverageOrModeThread(void *pData)
     CPLFree(pabSuccess);
     CPLFree(pabSuccess2);
     VSIFree(panVals);
-    VSIFree(pafRealVals);
-    VSIFree(panRealSums);
-    if (bIsComplex)
-    {
-        VSIFree(pafImagVals);
-        VSIFree(panImagSums);
-    }
 }
 
 /************************************************************************/
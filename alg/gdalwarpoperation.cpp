@@ -38,9 +38,12 @@
 
 #include <algorithm>
 #include <limits>
+#include <chrono>
+#include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -171,9 +174,9 @@ GDALWarpKernel.
 /************************************************************************/
 
 GDALWarpOperation::GDALWarpOperation()
-    : psOptions(nullptr), hIOMutex(nullptr), hWarpMutex(nullptr),
-      nChunkListCount(0), nChunkListMax(0), pasChunkList(nullptr),
-      bReportTimings(FALSE), nLastTimeReported(0), psThreadData(nullptr)
+    : psOptions(nullptr), nChunkListCount(0), nChunkListMax(0),
+      pasChunkList(nullptr), bReportTimings(FALSE), nLastTimeReported(0),
+      psThreadData(nullptr)
 {
 }
 
@@ -195,12 +198,6 @@ GDALWarpOperation::~GDALWarpOperation()
 
     WipeOptions();
 
-    if (hIOMutex != nullptr)
-    {
-        CPLDestroyMutex(hIOMutex);
-        CPLDestroyMutex(hWarpMutex);
-    }
-
     WipeChunkList();
     if (psThreadData)
         GWKThreadsEnd(psThreadData);
@@ -1005,64 +1002,319 @@ CPLErr GDALChunkAndWarpImage(GDALWarpOperationH hOperation, int nDstXOff,
 }
 
 /************************************************************************/
-/*                          ChunkThreadMain()                           */
+/*                       ComputePixelCostInBits()                       */
 /************************************************************************/
 
-typedef struct
+// Number of bits of working buffers per source and destination pixel, based
+// on the types of masks in use.
+static void ComputePixelCostInBits(const GDALWarpOptions *psOptions,
+                                   int *pnSrcPixelCostInBits,
+                                   int *pnDstPixelCostInBits)
 {
-    GDALWarpOperation *poOperation;
-    GDALWarpChunk *pasChunkInfo;
-    CPLJoinableThread *hThreadHandle;
-    CPLErr eErr;
-    double dfProgressBase;
-    double dfProgressScale;
-    CPLMutex *hIOMutex;
-
-    CPLMutex *hCondMutex;
-    volatile int bIOMutexTaken;
-    CPLCond *hCond;
-} ChunkThreadData;
+    /* -------------------------------------------------------------------- */
+    /*      Based on the types of masks in use, how many bits will each     */
+    /*      source pixel cost us?                                           */
+    /* -------------------------------------------------------------------- */
+    int nSrcPixelCostInBits = GDALGetDataTypeSize(psOptions->eWorkingDataType) *
+                              psOptions->nBandCount;
 
-static void ChunkThreadMain(void *pThreadData)
+    if (psOptions->pfnSrcDensityMaskFunc != nullptr)
+        nSrcPixelCostInBits += 32;  // Float mask?
 
-{
-    volatile ChunkThreadData *psData =
-        static_cast<volatile ChunkThreadData *>(pThreadData);
+    GDALRasterBandH hSrcBand = nullptr;
+    if (psOptions->nBandCount > 0)
+        hSrcBand =
+            GDALGetRasterBand(psOptions->hSrcDS, psOptions->panSrcBands[0]);
+
+    if (psOptions->nSrcAlphaBand > 0 || psOptions->hCutline != nullptr)
+        nSrcPixelCostInBits += 32;  // UnifiedSrcDensity float mask.
+    else if (hSrcBand != nullptr &&
+             (GDALGetMaskFlags(hSrcBand) & GMF_PER_DATASET))
+        nSrcPixelCostInBits += 1;  // UnifiedSrcValid bit mask.
 
-    GDALWarpChunk *pasChunkInfo = psData->pasChunkInfo;
+    if (psOptions->papfnSrcPerBandValidityMaskFunc != nullptr ||
+        psOptions->padfSrcNoDataReal != nullptr)
+        nSrcPixelCostInBits += psOptions->nBandCount;  // Bit/band mask.
+
+    if (psOptions->pfnSrcValidityMaskFunc != nullptr)
+        nSrcPixelCostInBits += 1;  // Bit mask.
 
     /* -------------------------------------------------------------------- */
-    /*      Acquire IO mutex.                                               */
+    /*      What about the cost for the destination.                        */
     /* -------------------------------------------------------------------- */
-    if (!CPLAcquireMutex(psData->hIOMutex, 600.0))
+    int nDstPixelCostInBits = GDALGetDataTypeSize(psOptions->eWorkingDataType) *
+                              psOptions->nBandCount;
+
+    if (psOptions->pfnDstDensityMaskFunc != nullptr)
+        nDstPixelCostInBits += 32;
+
+    if (psOptions->padfDstNoDataReal != nullptr ||
+        psOptions->pfnDstValidityMaskFunc != nullptr)
+        nDstPixelCostInBits += psOptions->nBandCount;
+
+    if (psOptions->nDstAlphaBand > 0)
+        nDstPixelCostInBits += 32;  // DstDensity float mask.
+
+    *pnSrcPixelCostInBits = nSrcPixelCostInBits;
+    *pnDstPixelCostInBits = nDstPixelCostInBits;
+}
+
+/************************************************************************/
+/*                          GDALWarpPipeline                            */
+/************************************************************************/
+
+// Stages of the ChunkAndWarpMulti() pipeline. Each chunk goes through them
+// in that order, and chunks enter a given stage in increasing index order.
+typedef enum
+{
+    GWPS_READ,  /* destination pre-read and source read */
+    GWPS_MASK,  /* validity and density masks */
+    GWPS_WARP,  /* pre-processor, warp kernel and post-processor */
+    GWPS_WRITE, /* destination alpha and destination imagery write */
+    GWPS_COUNT
+} GDALWarpPipelineStage;
+
+static const char *const apszPipelineStageNames[GWPS_COUNT] = {
+    "read", "mask", "warp", "write"};
+
+namespace
+{
+struct GDALWarpPipeline
+{
+    std::mutex oMutex{};
+    std::condition_variable oCond{};
+
+    // Index of the next chunk allowed to enter each stage.
+    int anNextChunk[GWPS_COUNT] = {};
+
+    // Exclusive resources. Dataset I/O is serialized, as is the warp kernel
+    // which shares the transformer with ComputeSourceWindow() and the
+    // kernel thread data with other chunks.
+    bool bIOBusy = false;
+    bool bWarpBusy = false;
+
+    // Whether the mask stage reads alpha or mask bands.
+    bool bMaskStageNeedsIO = false;
+
+    GDALWarpOperation *poOperation = nullptr;
+    const GDALWarpChunk *pasChunks = nullptr;
+    int nChunkCount = 0;
+    std::vector<double> adfProgressBase{};
+    std::vector<double> adfProgressScale{};
+    std::vector<double> adfChunkMemory{};
+
+    // Chunk dispatching, bounded by memory use.
+    int nNextChunkToStart = 0;
+    int nChunksInFlight = 0;
+    double dfMemoryInFlight = 0.0;
+    double dfMemoryLimit = 0.0;
+    bool bStop = false;
+    CPLErr eErr = CE_None;
+
+    // Cumulated per-stage timings, in seconds, reported as debug messages.
+    double adfBusyTime[GWPS_COUNT] = {};
+    double adfWaitTime[GWPS_COUNT] = {};
+};
+
+struct GDALWarpPipelineJob
+{
+    GDALWarpPipeline *poPipeline = nullptr;
+    int iChunk = 0;
+    int nStage = -1;  // -1 before entering the read stage
+    std::chrono::steady_clock::time_point oStageStart{};
+};
+}  // namespace
+
+// Job of the chunk being processed by the current thread, if any.
+static thread_local GDALWarpPipelineJob *tlsPipelineJob = nullptr;
+
+/************************************************************************/
+/*                          GWPGetCurrentJob()                          */
+/************************************************************************/
+
+static GDALWarpPipelineJob *GWPGetCurrentJob(const GDALWarpOperation *poOp)
+{
+    // A source VRTWarpedDataset read during the read stage runs its own
+    // warp operation in this thread: it must not see our job.
+    GDALWarpPipelineJob *psJob = tlsPipelineJob;
+    if (psJob != nullptr && psJob->poPipeline->poOperation == poOp)
+        return psJob;
+    return nullptr;
+}
+
+/************************************************************************/
+/*                        GWPGetStageResource()                         */
+/************************************************************************/
+
+static bool *GWPGetStageResource(GDALWarpPipeline *poPipeline, int nStage)
+{
+    switch (nStage)
+    {
+        case GWPS_READ:
+        case GWPS_WRITE:
+            return &poPipeline->bIOBusy;
+        case GWPS_MASK:
+            return poPipeline->bMaskStageNeedsIO ? &poPipeline->bIOBusy
+                                                 : nullptr;
+        case GWPS_WARP:
+            return &poPipeline->bWarpBusy;
+        default:
+            break;
+    }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                           GWPEnterStage()                            */
+/************************************************************************/
+
+// Moves the current chunk to nStage (GWPS_COUNT to leave the pipeline).
+// The resource of the previous stage is released before waiting, so a chunk
+// never waits while holding a resource. Skipped stages are passed in order.
+static void GWPEnterStage(GDALWarpPipelineJob *psJob, int nStage)
+{
+    GDALWarpPipeline *poPipeline = psJob->poPipeline;
+    if (nStage <= psJob->nStage)
+        return;
+
+    std::unique_lock<std::mutex> oLock(poPipeline->oMutex);
+    const auto oNow = std::chrono::steady_clock::now();
+    if (psJob->nStage >= 0)
     {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Failed to acquire IOMutex in WarpRegion().");
-        psData->eErr = CE_Failure;
+        bool *pbResource = GWPGetStageResource(poPipeline, psJob->nStage);
+        if (pbResource)
+        {
+            *pbResource = false;
+            poPipeline->oCond.notify_all();
+        }
+        poPipeline->adfBusyTime[psJob->nStage] +=
+            std::chrono::duration<double>(oNow - psJob->oStageStart).count();
+    }
+
+    const int iChunk = psJob->iChunk;
+    const int nLastStage = std::min(nStage, static_cast<int>(GWPS_COUNT) - 1);
+    for (int iStage = psJob->nStage + 1; iStage <= nLastStage; ++iStage)
+    {
+        poPipeline->oCond.wait(
+            oLock, [poPipeline, iStage, iChunk]
+            { return poPipeline->anNextChunk[iStage] == iChunk; });
+        if (iStage == nStage)
+        {
+            bool *pbResource = GWPGetStageResource(poPipeline, iStage);
+            if (pbResource)
+            {
+                poPipeline->oCond.wait(oLock,
+                                       [pbResource] { return !*pbResource; });
+                *pbResource = true;
+            }
+        }
+        poPipeline->anNextChunk[iStage]++;
+        poPipeline->oCond.notify_all();
+    }
+
+    psJob->nStage = nStage;
+    psJob->oStageStart = std::chrono::steady_clock::now();
+    if (nStage < GWPS_COUNT)
+    {
+        poPipeline->adfWaitTime[nStage] +=
+            std::chrono::duration<double>(psJob->oStageStart - oNow).count();
+    }
+}
+
+/************************************************************************/
+/*                         GWPLockTransformer()                         */
+/************************************************************************/
+
+// Gives exclusive access to the transformer shared with the warp kernel.
+static void GWPLockTransformer(GDALWarpPipelineJob *psJob, bool bLock)
+{
+    GDALWarpPipeline *poPipeline = psJob->poPipeline;
+    std::unique_lock<std::mutex> oLock(poPipeline->oMutex);
+    if (bLock)
+    {
+        poPipeline->oCond.wait(oLock,
+                               [poPipeline] { return !poPipeline->bWarpBusy; });
+        poPipeline->bWarpBusy = true;
     }
     else
     {
-        if (psData->hCond != nullptr)
+        poPipeline->bWarpBusy = false;
+        poPipeline->oCond.notify_all();
+    }
+}
+
+/************************************************************************/
+/*                          ChunkThreadMain()                           */
+/************************************************************************/
+
+static void ChunkThreadMain(void *pThreadData)
+
+{
+    GDALWarpPipeline *poPipeline =
+        static_cast<GDALWarpPipeline *>(pThreadData);
+
+    while (true)
+    {
+        /* ---------------------------------------------------------------- */
+        /*      Pick the next chunk, once it fits in the memory budget.     */
+        /* ---------------------------------------------------------------- */
+        int iChunk = 0;
         {
-            CPLAcquireMutex(psData->hCondMutex, 1.0);
-            psData->bIOMutexTaken = TRUE;
-            CPLCondSignal(psData->hCond);
-            CPLReleaseMutex(psData->hCondMutex);
+            std::unique_lock<std::mutex> oLock(poPipeline->oMutex);
+            poPipeline->oCond.wait(
+                oLock,
+                [poPipeline]
+                {
+                    const int i = poPipeline->nNextChunkToStart;
+                    return poPipeline->bStop ||
+                           i >= poPipeline->nChunkCount ||
+                           poPipeline->nChunksInFlight == 0 ||
+                           poPipeline->dfMemoryInFlight +
+                                   poPipeline->adfChunkMemory[i] <=
+                               poPipeline->dfMemoryLimit;
+                });
+            if (poPipeline->bStop ||
+                poPipeline->nNextChunkToStart >= poPipeline->nChunkCount)
+                break;
+            iChunk = poPipeline->nNextChunkToStart++;
+            poPipeline->nChunksInFlight++;
+            poPipeline->dfMemoryInFlight += poPipeline->adfChunkMemory[iChunk];
         }
 
-        psData->eErr = psData->poOperation->WarpRegion(
-            pasChunkInfo->dx, pasChunkInfo->dy, pasChunkInfo->dsx,
-            pasChunkInfo->dsy, pasChunkInfo->sx, pasChunkInfo->sy,
-            pasChunkInfo->ssx, pasChunkInfo->ssy, pasChunkInfo->sExtraSx,
-            pasChunkInfo->sExtraSy, psData->dfProgressBase,
-            psData->dfProgressScale);
+        CPLDebug("GDAL", "Start chunk %d / %d.", iChunk,
+                 poPipeline->nChunkCount);
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Release the IO mutex. */
-        /* --------------------------------------------------------------------
-         */
-        CPLReleaseMutex(psData->hIOMutex);
+        GDALWarpPipelineJob sJob;
+        sJob.poPipeline = poPipeline;
+        sJob.iChunk = iChunk;
+        tlsPipelineJob = &sJob;
+
+        const GDALWarpChunk *pasThisChunk = poPipeline->pasChunks + iChunk;
+        const CPLErr eErr = poPipeline->poOperation->WarpRegion(
+            pasThisChunk->dx, pasThisChunk->dy, pasThisChunk->dsx,
+            pasThisChunk->dsy, pasThisChunk->sx, pasThisChunk->sy,
+            pasThisChunk->ssx, pasThisChunk->ssy, pasThisChunk->sExtraSx,
+            pasThisChunk->sExtraSy, poPipeline->adfProgressBase[iChunk],
+            poPipeline->adfProgressScale[iChunk]);
+
+        // Release the resource still held, and let following chunks pass
+        // the stages this one did not reach.
+        GWPEnterStage(&sJob, GWPS_COUNT);
+        tlsPipelineJob = nullptr;
+
+        CPLDebug("GDAL", "Finished chunk %d / %d.", iChunk,
+                 poPipeline->nChunkCount);
+
+        std::lock_guard<std::mutex> oLock(poPipeline->oMutex);
+        poPipeline->nChunksInFlight--;
+        poPipeline->dfMemoryInFlight -= poPipeline->adfChunkMemory[iChunk];
+        if (eErr != CE_None)
+        {
+            poPipeline->bStop = true;
+            if (poPipeline->eErr == CE_None)
+                poPipeline->eErr = eErr;
+        }
+        poPipeline->oCond.notify_all();
     }
 }
 
@@ -1080,7 +1332,16 @@ static void ChunkThreadMain(void *pThreadData)
  *
  * Externally this method operates the same as ChunkAndWarpImage(), but
  * internally this method uses multiple threads to interleave input/output
- * for one region while the processing is being done for another.
+ * for some regions while the processing is being done for another.
+ *
+ * Starting with GDAL 3.8, chunks go through a pipeline made of a read stage
+ * (source and destination reads), a mask stage, a warp stage and a write
+ * stage. Up to PIPELINE_DEPTH chunks (4 by default) are in flight, as long as
+ * their cumulated working buffers fit within twice the warp memory limit.
+ * Dataset I/O remains serialized, as does the warp kernel, and chunks are
+ * processed by each stage in order, so the result is identical to the one of
+ * ChunkAndWarpImage(). When debugging is enabled, the time spent by chunks
+ * in each stage and waiting for it is reported.
  *
  * @param nDstXOff X offset to window of destination data to be produced.
  * @param nDstYOff Y offset to window of destination data to be produced.
@@ -1094,137 +1355,108 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
                                             int nDstXSize, int nDstYSize)
 
 {
-    hIOMutex = CPLCreateMutex();
-    hWarpMutex = CPLCreateMutex();
-
-    CPLReleaseMutex(hIOMutex);
-    CPLReleaseMutex(hWarpMutex);
-
-    CPLCond *hCond = CPLCreateCond();
-    CPLMutex *hCondMutex = CPLCreateMutex();
-    CPLReleaseMutex(hCondMutex);
-
     /* -------------------------------------------------------------------- */
     /*      Collect the list of chunks to operate on.                       */
     /* -------------------------------------------------------------------- */
     CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
 
-    /* -------------------------------------------------------------------- */
-    /*      Process them one at a time, updating the progress               */
-    /*      information for each region.                                    */
-    /* -------------------------------------------------------------------- */
-    ChunkThreadData volatile asThreadData[2] = {};
-    memset(reinterpret_cast<void *>(
-               const_cast<ChunkThreadData(*)[2]>(&asThreadData)),
-           0, sizeof(asThreadData));
-    asThreadData[0].poOperation = this;
-    asThreadData[0].hIOMutex = hIOMutex;
-    asThreadData[1].poOperation = this;
-    asThreadData[1].hIOMutex = hIOMutex;
-
-    double dfPixelsProcessed = 0.0;
-    double dfTotalPixels = static_cast<double>(nDstXSize) * nDstYSize;
-
-    CPLErr eErr = CE_None;
-    for (int iChunk = 0; iChunk < nChunkListCount + 1; iChunk++)
+    if (pasChunkList == nullptr || nChunkListCount == 0)
     {
-        int iThread = iChunk % 2;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Launch thread for this chunk. */
-        /* --------------------------------------------------------------------
-         */
-        if (pasChunkList != nullptr && iChunk < nChunkListCount)
-        {
-            GDALWarpChunk *pasThisChunk = pasChunkList + iChunk;
-            const double dfChunkPixels =
-                pasThisChunk->dsx * static_cast<double>(pasThisChunk->dsy);
-
-            asThreadData[iThread].dfProgressBase =
-                dfPixelsProcessed / dfTotalPixels;
-            asThreadData[iThread].dfProgressScale =
-                dfChunkPixels / dfTotalPixels;
-
-            dfPixelsProcessed += dfChunkPixels;
-
-            asThreadData[iThread].pasChunkInfo = pasThisChunk;
-
-            if (iChunk == 0)
-            {
-                asThreadData[iThread].hCond = hCond;
-                asThreadData[iThread].hCondMutex = hCondMutex;
-            }
-            else
-            {
-                asThreadData[iThread].hCond = nullptr;
-                asThreadData[iThread].hCondMutex = nullptr;
-            }
-            asThreadData[iThread].bIOMutexTaken = FALSE;
-
-            CPLDebug("GDAL", "Start chunk %d / %d.", iChunk, nChunkListCount);
-            asThreadData[iThread].hThreadHandle = CPLCreateJoinableThread(
-                ChunkThreadMain,
-                const_cast<ChunkThreadData *>(&asThreadData[iThread]));
-            if (asThreadData[iThread].hThreadHandle == nullptr)
-            {
-                CPLError(
-                    CE_Failure, CPLE_AppDefined,
-                    "CPLCreateJoinableThread() failed in ChunkAndWarpMulti()");
-                eErr = CE_Failure;
-                break;
-            }
-
-            // Wait that the first thread has acquired the IO mutex before
-            // proceeding.  This will ensure that the first thread will run
-            // before the second one.
-            if (iChunk == 0)
-            {
-                CPLAcquireMutex(hCondMutex, 1.0);
-                while (asThreadData[iThread].bIOMutexTaken == FALSE)
-                    CPLCondWait(hCond, hCondMutex);
-                CPLReleaseMutex(hCondMutex);
-            }
-        }
+        WipeChunkList();
+        return CE_None;
+    }
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Wait for previous chunks thread to complete. */
-        /* --------------------------------------------------------------------
-         */
-        if (iChunk > 0)
-        {
-            iThread = (iChunk - 1) % 2;
+    /* -------------------------------------------------------------------- */
+    /*      Setup the pipeline.                                             */
+    /* -------------------------------------------------------------------- */
+    const int nDepth = std::max(
+        1, std::min(nChunkListCount,
+                    atoi(CSLFetchNameValueDef(psOptions->papszWarpOptions,
+                                              "PIPELINE_DEPTH", "4"))));
 
-            // Wait for thread to finish.
-            CPLJoinThread(asThreadData[iThread].hThreadHandle);
-            asThreadData[iThread].hThreadHandle = nullptr;
+    GDALWarpPipeline oPipeline;
+    oPipeline.poOperation = this;
+    oPipeline.pasChunks = pasChunkList;
+    oPipeline.nChunkCount = nChunkListCount;
+    oPipeline.dfMemoryLimit = 2 * psOptions->dfWarpMemoryLimit;
 
-            CPLDebug("GDAL", "Finished chunk %d / %d.", iChunk - 1,
-                     nChunkListCount);
+    GDALRasterBandH hSrcBand = nullptr;
+    if (psOptions->nBandCount > 0)
+        hSrcBand =
+            GDALGetRasterBand(psOptions->hSrcDS, psOptions->panSrcBands[0]);
+    const int nSrcMaskFlags =
+        hSrcBand != nullptr ? GDALGetMaskFlags(hSrcBand) : GMF_ALL_VALID;
+    // Mask functions installed by the caller may read from the datasets.
+    const bool bHasCustomMaskFunc =
+        psOptions->papfnSrcPerBandValidityMaskFunc != nullptr ||
+        psOptions->pfnSrcValidityMaskFunc != nullptr ||
+        psOptions->pfnSrcDensityMaskFunc != nullptr ||
+        psOptions->pfnDstValidityMaskFunc != nullptr ||
+        psOptions->pfnDstDensityMaskFunc != nullptr;
+    oPipeline.bMaskStageNeedsIO =
+        bHasCustomMaskFunc || psOptions->nSrcAlphaBand > 0 ||
+        psOptions->nDstAlphaBand > 0 ||
+        ((nSrcMaskFlags & GMF_PER_DATASET) && !(nSrcMaskFlags & GMF_ALPHA));
+
+    int nSrcPixelCostInBits = 0;
+    int nDstPixelCostInBits = 0;
+    ComputePixelCostInBits(psOptions, &nSrcPixelCostInBits,
+                           &nDstPixelCostInBits);
 
-            eErr = asThreadData[iThread].eErr;
+    double dfPixelsProcessed = 0.0;
+    const double dfTotalPixels = static_cast<double>(nDstXSize) * nDstYSize;
+    for (int iChunk = 0; iChunk < nChunkListCount; iChunk++)
+    {
+        const GDALWarpChunk *pasThisChunk = pasChunkList + iChunk;
+        const double dfChunkPixels =
+            pasThisChunk->dsx * static_cast<double>(pasThisChunk->dsy);
+        oPipeline.adfProgressBase.push_back(dfPixelsProcessed / dfTotalPixels);
+        oPipeline.adfProgressScale.push_back(dfChunkPixels / dfTotalPixels);
+        dfPixelsProcessed += dfChunkPixels;
 
-            if (eErr != CE_None)
-                break;
-        }
+        oPipeline.adfChunkMemory.push_back(
+            (static_cast<double>(nSrcPixelCostInBits) * pasThisChunk->ssx *
+                 pasThisChunk->ssy +
+             static_cast<double>(nDstPixelCostInBits) * dfChunkPixels) /
+            8.0);
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Wait for all threads to complete.                               */
+    /*      Launch the workers, and wait for them to complete.              */
     /* -------------------------------------------------------------------- */
-    for (int iThread = 0; iThread < 2; iThread++)
+    std::vector<CPLJoinableThread *> ahThreads;
+    for (int i = 0; i < nDepth; i++)
     {
-        if (asThreadData[iThread].hThreadHandle)
-            CPLJoinThread(asThreadData[iThread].hThreadHandle);
+        CPLJoinableThread *hThread =
+            CPLCreateJoinableThread(ChunkThreadMain, &oPipeline);
+        if (hThread == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "CPLCreateJoinableThread() failed in ChunkAndWarpMulti()");
+            std::lock_guard<std::mutex> oLock(oPipeline.oMutex);
+            oPipeline.bStop = true;
+            oPipeline.eErr = CE_Failure;
+            oPipeline.oCond.notify_all();
+            break;
+        }
+        ahThreads.push_back(hThread);
     }
 
-    CPLDestroyCond(hCond);
-    CPLDestroyMutex(hCondMutex);
+    for (CPLJoinableThread *hThread : ahThreads)
+        CPLJoinThread(hThread);
+
+    for (int iStage = 0; iStage < GWPS_COUNT; iStage++)
+    {
+        CPLDebug("WARP",
+                 "Pipeline stage %s: %.3f s busy, %.3f s waiting "
+                 "(depth %d, %d chunks).",
+                 apszPipelineStageNames[iStage], oPipeline.adfBusyTime[iStage],
+                 oPipeline.adfWaitTime[iStage], nDepth, nChunkListCount);
+    }
 
     WipeChunkList();
 
-    return eErr;
+    return oPipeline.eErr;
 }
 
 /************************************************************************/
@@ -1298,49 +1530,10 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
         CPLFetchBool(psOptions->papszWarpOptions, "SKIP_NOSOURCE", false))
         return CE_None;
 
-    /* -------------------------------------------------------------------- */
-    /*      Based on the types of masks in use, how many bits will each     */
-    /*      source pixel cost us?                                           */
-    /* -------------------------------------------------------------------- */
-    int nSrcPixelCostInBits = GDALGetDataTypeSize(psOptions->eWorkingDataType) *
-                              psOptions->nBandCount;
-
-    if (psOptions->pfnSrcDensityMaskFunc != nullptr)
-        nSrcPixelCostInBits += 32;  // Float mask?
-
-    GDALRasterBandH hSrcBand = nullptr;
-    if (psOptions->nBandCount > 0)
-        hSrcBand =
-            GDALGetRasterBand(psOptions->hSrcDS, psOptions->panSrcBands[0]);
-
-    if (psOptions->nSrcAlphaBand > 0 || psOptions->hCutline != nullptr)
-        nSrcPixelCostInBits += 32;  // UnifiedSrcDensity float mask.
-    else if (hSrcBand != nullptr &&
-             (GDALGetMaskFlags(hSrcBand) & GMF_PER_DATASET))
-        nSrcPixelCostInBits += 1;  // UnifiedSrcValid bit mask.
-
-    if (psOptions->papfnSrcPerBandValidityMaskFunc != nullptr ||
-        psOptions->padfSrcNoDataReal != nullptr)
-        nSrcPixelCostInBits += psOptions->nBandCount;  // Bit/band mask.
-
-    if (psOptions->pfnSrcValidityMaskFunc != nullptr)
-        nSrcPixelCostInBits += 1;  // Bit mask.
-
-    /* -------------------------------------------------------------------- */
-    /*      What about the cost for the destination.                        */
-    /* -------------------------------------------------------------------- */
-    int nDstPixelCostInBits = GDALGetDataTypeSize(psOptions->eWorkingDataType) *
-                              psOptions->nBandCount;
-
-    if (psOptions->pfnDstDensityMaskFunc != nullptr)
-        nDstPixelCostInBits += 32;
-
-    if (psOptions->padfDstNoDataReal != nullptr ||
-        psOptions->pfnDstValidityMaskFunc != nullptr)
-        nDstPixelCostInBits += psOptions->nBandCount;
-
-    if (psOptions->nDstAlphaBand > 0)
-        nDstPixelCostInBits += 32;  // DstDensity float mask.
+    int nSrcPixelCostInBits = 0;
+    int nDstPixelCostInBits = 0;
+    ComputePixelCostInBits(psOptions, &nSrcPixelCostInBits,
+                           &nDstPixelCostInBits);
 
     /* -------------------------------------------------------------------- */
     /*      Does the cost of the current rectangle exceed our memory        */
@@ -1553,6 +1746,10 @@ CPLErr GDALWarpOperation::WarpRegion(
     double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale)
 
 {
+    GDALWarpPipelineJob *psPipelineJob = GWPGetCurrentJob(this);
+    if (psPipelineJob != nullptr)
+        GWPEnterStage(psPipelineJob, GWPS_READ);
+
     ReportTiming(nullptr);
 
     /* -------------------------------------------------------------------- */
@@ -1614,6 +1811,9 @@ CPLErr GDALWarpOperation::WarpRegion(
     /* -------------------------------------------------------------------- */
     if (eErr == CE_None)
     {
+        if (psPipelineJob != nullptr)
+            GWPEnterStage(psPipelineJob, GWPS_WRITE);
+
         if (psOptions->nBandCount == 1)
         {
             // Particular case to simplify the stack a bit.
@@ -1760,26 +1960,25 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
     CPLAssert(eBufDataType == psOptions->eWorkingDataType);
 
+    GDALWarpPipelineJob *psPipelineJob = GWPGetCurrentJob(this);
+
     /* -------------------------------------------------------------------- */
     /*      If not given a corresponding source window compute one now.     */
     /* -------------------------------------------------------------------- */
     if (nSrcXSize == 0 && nSrcYSize == 0)
     {
-        // TODO: This taking of the warp mutex is suboptimal. We could get rid
-        // of it, but that would require making sure ComputeSourceWindow()
-        // uses a different pTransformerArg than the warp kernel.
-        if (hWarpMutex != nullptr && !CPLAcquireMutex(hWarpMutex, 600.0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Failed to acquire WarpMutex in WarpRegion().");
-            return CE_Failure;
-        }
+        // TODO: This locking of the transformer against the warp stage is
+        // suboptimal. We could get rid of it, but that would require making
+        // sure ComputeSourceWindow() uses a different pTransformerArg than
+        // the warp kernel.
+        if (psPipelineJob != nullptr)
+            GWPLockTransformer(psPipelineJob, true);
         const CPLErr eErr =
             ComputeSourceWindow(nDstXOff, nDstYOff, nDstXSize, nDstYSize,
                                 &nSrcXOff, &nSrcYOff, &nSrcXSize, &nSrcYSize,
                                 &dfSrcXExtraSize, &dfSrcYExtraSize, nullptr);
-        if (hWarpMutex != nullptr)
-            CPLReleaseMutex(hWarpMutex);
+        if (psPipelineJob != nullptr)
+            GWPLockTransformer(psPipelineJob, false);
         if (eErr != CE_None)
         {
             const bool bErrorOutIfEmptySourceWindow =
@@ -1887,6 +2086,9 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
     ReportTiming("Input buffer read");
 
+    if (psPipelineJob != nullptr)
+        GWPEnterStage(psPipelineJob, GWPS_MASK);
+
     /* -------------------------------------------------------------------- */
     /*      Initialize destination buffer.                                  */
     /* -------------------------------------------------------------------- */
@@ -2191,18 +2393,10 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Release IO Mutex, and acquire warper mutex.                     */
+    /*      Enter the warp stage of the ChunkAndWarpMulti() pipeline.       */
     /* -------------------------------------------------------------------- */
-    if (hIOMutex != nullptr)
-    {
-        CPLReleaseMutex(hIOMutex);
-        if (!CPLAcquireMutex(hWarpMutex, 600.0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Failed to acquire WarpMutex in WarpRegion().");
-            return CE_Failure;
-        }
-    }
+    if (psPipelineJob != nullptr)
+        GWPEnterStage(psPipelineJob, GWPS_WARP);
 
     /* -------------------------------------------------------------------- */
     /*      Optional application provided prewarp chunk processor.          */
@@ -2228,18 +2422,10 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
             &oWK, psOptions->pPostWarpProcessorArg);
 
     /* -------------------------------------------------------------------- */
-    /*      Release Warp Mutex, and acquire io mutex.                       */
+    /*      Enter the write stage of the ChunkAndWarpMulti() pipeline.      */
     /* -------------------------------------------------------------------- */
-    if (hIOMutex != nullptr)
-    {
-        CPLReleaseMutex(hWarpMutex);
-        if (!CPLAcquireMutex(hIOMutex, 600.0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Failed to acquire IOMutex in WarpRegion().");
-            return CE_Failure;
-        }
-    }
+    if (psPipelineJob != nullptr)
+        GWPEnterStage(psPipelineJob, GWPS_WRITE);
 
     /* -------------------------------------------------------------------- */
     /*      Write destination alpha if available.                           */
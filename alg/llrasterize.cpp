@@ -35,6 +35,7 @@
 #include <cstring>
 
 #include <algorithm>
+#include <limits>
 #include <set>
 #include <utility>
 #include <vector>
@@ -114,36 +115,88 @@ void GDALdllImageFilledPolygon(int nRasterXSize, int nRasterYSize,
     int minx = 0;
     const int maxx = nRasterXSize - 1;
 
+    /* -------------------------------------------------------------------- */
+    /*      Build the edge table: edge i goes from vertex ind1 to vertex    */
+    /*      ind2 (which is i), and is only considered for the scanlines     */
+    /*      whose center is within its Y extent. Edges are activated in     */
+    /*      increasing order of their minimum Y, and the active ones are    */
+    /*      kept sorted by index so that the scanline function is called    */
+    /*      in the same order as when iterating over all edges.             */
+    /* -------------------------------------------------------------------- */
+    struct Edge
+    {
+        int ind1;
+        int ind2;
+        double dfMinY;
+        double dfMaxY;
+    };
+    std::vector<Edge> edges(n);
+    for (int i = 0, part = 0, partoffset = 0; i < n; i++)
+    {
+        if (i == partoffset + panPartSize[part])
+        {
+            partoffset += panPartSize[part];
+            part++;
+        }
+
+        Edge &edge = edges[i];
+        edge.ind1 = (i == partoffset) ? partoffset + panPartSize[part] - 1
+                                      : i - 1;
+        edge.ind2 = i;
+        const double dy1 = padfY[edge.ind1];
+        const double dy2 = padfY[edge.ind2];
+        if (std::isnan(dy1) || std::isnan(dy2))
+        {
+            // Never skipped by the scanline tests below.
+            edge.dfMinY = -std::numeric_limits<double>::infinity();
+            edge.dfMaxY = std::numeric_limits<double>::infinity();
+        }
+        else
+        {
+            edge.dfMinY = std::min(dy1, dy2);
+            edge.dfMaxY = std::max(dy1, dy2);
+        }
+    }
+
+    std::vector<int> sortedEdges(n);
+    for (int i = 0; i < n; i++)
+        sortedEdges[i] = i;
+    std::sort(sortedEdges.begin(), sortedEdges.end(), [&edges](int a, int b)
+              { return edges[a].dfMinY < edges[b].dfMinY; });
+    size_t nextEdge = 0;
+    std::vector<int> activeEdges;
+
     // Fix in 1.3: count a vertex only once.
     for (int y = miny; y <= maxy; y++)
     {
-        int partoffset = 0;
-
         const double dy = y + 0.5;  // Center height of line.
 
-        int part = 0;
+        const size_t nOldActive = activeEdges.size();
+        while (nextEdge < sortedEdges.size() &&
+               edges[sortedEdges[nextEdge]].dfMinY <= dy)
+        {
+            activeEdges.push_back(sortedEdges[nextEdge]);
+            nextEdge++;
+        }
+        if (activeEdges.size() != nOldActive)
+        {
+            std::sort(activeEdges.begin() + nOldActive, activeEdges.end());
+            std::inplace_merge(activeEdges.begin(),
+                               activeEdges.begin() + nOldActive,
+                               activeEdges.end());
+        }
+        activeEdges.erase(std::remove_if(activeEdges.begin(),
+                                         activeEdges.end(),
+                                         [&edges, dy](int i)
+                                         { return edges[i].dfMaxY < dy; }),
+                          activeEdges.end());
+
         int ints = 0;
 
-        for (int i = 0; i < n; i++)
+        for (const int i : activeEdges)
         {
-            if (i == partoffset + panPartSize[part])
-            {
-                partoffset += panPartSize[part];
-                part++;
-            }
-
-            int ind1 = 0;
-            int ind2 = 0;
-            if (i == partoffset)
-            {
-                ind1 = partoffset + panPartSize[part] - 1;
-                ind2 = partoffset;
-            }
-            else
-            {
-                ind1 = i - 1;
-                ind2 = i;
-            }
+            const int ind1 = edges[i].ind1;
+            const int ind2 = edges[i].ind2;
 
             double dy1 = padfY[ind1];
             double dy2 = padfY[ind2];
@@ -585,6 +638,11 @@ void GDALdllImageLineAllTouched(int nRasterXSize, int nRasterYSize,
                 dfX = 0.0;
             }
 
+            // The segment clipped in X may be off the target region.
+            if ((dfY < 0.0 && dfYEnd < 0.0) ||
+                (dfY > nRasterYSize && dfYEnd > nRasterYSize))
+                continue;
+
             // Clip segment in Y.
             if (dfYEnd > dfY)
             {
@@ -617,6 +675,8 @@ void GDALdllImageLineAllTouched(int nRasterXSize, int nRasterYSize,
                 if (dfYEnd < 0.0)
                 {
                     dfXEnd -= (dfYEnd - 0) / dfSlope;
+                    if (dfXEnd > nRasterXSize)
+                        dfXEnd = nRasterXSize;
                     // dfYEnd is no longer used afterwards, but for
                     // consistency it should be:
                     // dfYEnd = 0.0;
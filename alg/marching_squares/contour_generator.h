@@ -69,6 +69,18 @@ class ContourGenerator
         return CE_None;
     }
 
+    // Start the processing at line lineIdx instead of the first line, so
+    // that horizontal strips of the raster can be processed independently.
+    // previousLine is the content of line lineIdx - 1 (unused if lineIdx
+    // is 0).
+    void startAtLine(size_t lineIdx, const double *previousLine)
+    {
+        lineIdx_ = lineIdx;
+        if (lineIdx > 0)
+            std::copy(previousLine, previousLine + width_,
+                      previousLine_.begin());
+    }
+
   private:
     size_t width_;
     size_t height_;
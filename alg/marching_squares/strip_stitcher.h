@@ -0,0 +1,197 @@
+/******************************************************************************
+ *
+ * Project:  Marching squares
+ * Purpose:  Join contour pieces computed on horizontal strips of a raster.
+ *
+ ******************************************************************************
+ * Copyright (c) 2023, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+#ifndef MARCHING_SQUARES_STRIP_STITCHER_H
+#define MARCHING_SQUARES_STRIP_STITCHER_H
+
+#include "point.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace marching_squares
+{
+
+// A linestring of a given level, as emitted by a SegmentMerger
+struct LevelLine
+{
+    double level = 0;
+    LineString ls = LineString();
+    bool closed = false;
+};
+
+// StripCollector: line writer of the SegmentMerger of a horizontal strip
+// of the raster, that processes the squares of lines [startLine, endLine[.
+//
+// Contour points on the boundary between two strips lie on the line of
+// pixel centers y = startLine - .5 (resp. endLine - .5), and are computed
+// identically by the squares on both sides. Lines that end on such a
+// boundary are kept apart, to be joined by a StripStitcher with the lines of
+// the neighbouring strips. The other ones are complete.
+struct StripCollector
+{
+    StripCollector(size_t startLine, size_t endLine, size_t height)
+        : hasUpperBoundary_(startLine > 0), hasLowerBoundary_(endLine < height),
+          upperBoundary_(startLine - .5), lowerBoundary_(endLine - .5)
+    {
+    }
+
+    void addLine(double level, LineString &ls, bool closed)
+    {
+        LevelLine line;
+        line.level = level;
+        line.ls.swap(ls);
+        line.closed = closed;
+        if (!(line.ls.front() == line.ls.back()) &&
+            (onBoundary_(line.ls.front()) || onBoundary_(line.ls.back())))
+            openLines.push_back(std::move(line));
+        else
+            lines.push_back(std::move(line));
+    }
+
+    // complete lines
+    std::vector<LevelLine> lines = {};
+    // lines ending on a strip boundary
+    std::vector<LevelLine> openLines = {};
+
+  private:
+    const bool hasUpperBoundary_;
+    const bool hasLowerBoundary_;
+    const double upperBoundary_;
+    const double lowerBoundary_;
+
+    bool onBoundary_(const Point &p) const
+    {
+        return (hasUpperBoundary_ && p.y == upperBoundary_) ||
+               (hasLowerBoundary_ && p.y == lowerBoundary_);
+    }
+};
+
+// StripStitcher: join the open lines of all strips on their common end
+// points and send the results to a line writer.
+template <typename LineWriter> class StripStitcher
+{
+  public:
+    explicit StripStitcher(LineWriter &lineWriter) : lineWriter_(lineWriter)
+    {
+    }
+
+    void addOpenLines(std::vector<LevelLine> &lines)
+    {
+        for (auto &line : lines)
+            lines_[line.level].push_back(std::move(line.ls));
+        lines.clear();
+    }
+
+    void process()
+    {
+        for (auto &levelLines : lines_)
+            processLevel_(levelLines.first, levelLines.second);
+        lines_.clear();
+    }
+
+    // non copyable
+    StripStitcher(const StripStitcher<LineWriter> &) = delete;
+    StripStitcher<LineWriter> &
+    operator=(const StripStitcher<LineWriter> &) = delete;
+
+  private:
+    typedef std::pair<double, double> Key;
+
+    LineWriter &lineWriter_;
+    // open lines of each level
+    std::map<double, std::vector<LineString>> lines_ = {};
+
+    static Key key_(const Point &p)
+    {
+        return Key(p.x, p.y);
+    }
+
+    void processLevel_(double level, std::vector<LineString> &lines)
+    {
+        // end point -> indices of the lines that end there
+        std::map<Key, std::vector<size_t>> ends;
+        for (size_t i = 0; i < lines.size(); i++)
+        {
+            ends[key_(lines[i].front())].push_back(i);
+            ends[key_(lines[i].back())].push_back(i);
+        }
+
+        std::vector<bool> used(lines.size(), false);
+        auto takeNeighbour = [&](const Point &p) -> LineString *
+        {
+            for (size_t idx : ends[key_(p)])
+            {
+                if (!used[idx])
+                {
+                    used[idx] = true;
+                    return &lines[idx];
+                }
+            }
+            return nullptr;
+        };
+
+        for (size_t i = 0; i < lines.size(); i++)
+        {
+            if (used[i])
+                continue;
+            used[i] = true;
+            LineString ls;
+            ls.swap(lines[i]);
+
+            // extend the end of the line, and then its start
+            bool closed = false;
+            while (!closed)
+            {
+                LineString *other = takeNeighbour(ls.back());
+                if (other == nullptr)
+                    break;
+                if (!(other->front() == ls.back()))
+                    other->reverse();
+                other->pop_front();
+                ls.splice(ls.end(), *other);
+                closed = ls.front() == ls.back();
+            }
+            while (!closed)
+            {
+                LineString *other = takeNeighbour(ls.front());
+                if (other == nullptr)
+                    break;
+                if (!(other->back() == ls.front()))
+                    other->reverse();
+                other->pop_back();
+                ls.splice(ls.begin(), *other);
+                closed = ls.front() == ls.back();
+            }
+
+            lineWriter_.addLine(level, ls, closed);
+        }
+    }
+};
+
+}  // namespace marching_squares
+#endif
@@ -37,6 +37,7 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <new>
 #include <utility>
 #include <vector>
 
@@ -49,6 +50,8 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
@@ -383,12 +386,15 @@ void RPolygon::AddSegment(int x1, int y1, int x2, int y2, int direction)
 /*      (previous) and right.  If they are different polygon ids        */
 /*      then add the pixel edge to this polygon and the one on the      */
 /*      other side of the edge.                                         */
+/*                                                                      */
+/*      oAddSegment(nPolyId, x1, y1, x2, y2, direction) is called for   */
+/*      each edge, with the same arguments as RPolygon::AddSegment().   */
 /************************************************************************/
 
-template <class DataType>
+template <class AddSegmentFunc>
 static void AddEdges(GInt32 *panThisLineId, GInt32 *panLastLineId,
-                     GInt32 *panPolyIdMap, DataType *panPolyValue,
-                     RPolygon **papoPoly, int iX, int iY)
+                     GInt32 *panPolyIdMap, int iX, int iY,
+                     AddSegmentFunc &oAddSegment)
 
 {
     // TODO(schwehr): Simplify these three vars.
@@ -408,21 +414,11 @@ static void AddEdges(GInt32 *panThisLineId, GInt32 *panLastLineId,
     {
         if (nThisId != -1)
         {
-            if (papoPoly[nThisId] == nullptr)
-                // FIXME loss of precision for [U]Int64
-                papoPoly[nThisId] =
-                    new RPolygon(static_cast<double>(panPolyValue[nThisId]));
-
-            papoPoly[nThisId]->AddSegment(iXReal, iY, iXReal + 1, iY, 1);
+            oAddSegment(nThisId, iXReal, iY, iXReal + 1, iY, 1);
         }
         if (nPreviousId != -1)
         {
-            if (papoPoly[nPreviousId] == nullptr)
-                // FIXME loss of precision for [U]Int64
-                papoPoly[nPreviousId] = new RPolygon(
-                    static_cast<double>(panPolyValue[nPreviousId]));
-
-            papoPoly[nPreviousId]->AddSegment(iXReal, iY, iXReal + 1, iY, 0);
+            oAddSegment(nPreviousId, iXReal, iY, iXReal + 1, iY, 0);
         }
     }
 
@@ -430,34 +426,22 @@ static void AddEdges(GInt32 *panThisLineId, GInt32 *panLastLineId,
     {
         if (nThisId != -1)
         {
-            if (papoPoly[nThisId] == nullptr)
-                // FIXME loss of precision for [U]Int64
-                papoPoly[nThisId] =
-                    new RPolygon(static_cast<double>(panPolyValue[nThisId]));
-
-            papoPoly[nThisId]->AddSegment(iXReal + 1, iY, iXReal + 1, iY + 1,
-                                          1);
+            oAddSegment(nThisId, iXReal + 1, iY, iXReal + 1, iY + 1, 1);
         }
 
         if (nRightId != -1)
         {
-            if (papoPoly[nRightId] == nullptr)
-                // FIXME loss of precision for [U]Int64
-                papoPoly[nRightId] =
-                    new RPolygon(static_cast<double>(panPolyValue[nRightId]));
-
-            papoPoly[nRightId]->AddSegment(iXReal + 1, iY, iXReal + 1, iY + 1,
-                                           0);
+            oAddSegment(nRightId, iXReal + 1, iY, iXReal + 1, iY + 1, 0);
         }
     }
 }
 
 /************************************************************************/
-/*                         EmitPolygonToLayer()                         */
+/*                         RPolygonToGeometry()                         */
 /************************************************************************/
 
-static CPLErr EmitPolygonToLayer(OGRLayerH hOutLayer, int iPixValField,
-                                 RPolygon *poRPoly, double *padfGeoTransform)
+static OGRGeometryH RPolygonToGeometry(RPolygon *poRPoly,
+                                       const double *padfGeoTransform)
 
 {
     /* -------------------------------------------------------------------- */
@@ -496,6 +480,17 @@ static CPLErr EmitPolygonToLayer(OGRLayerH hOutLayer, int iPixValField,
         OGR_G_AddGeometryDirectly(hPolygon, hRing);
     }
 
+    return hPolygon;
+}
+
+/************************************************************************/
+/*                         EmitPolygonToLayer()                         */
+/************************************************************************/
+
+static CPLErr EmitPolygonToLayer(OGRLayerH hOutLayer, int iPixValField,
+                                 OGRGeometryH hPolygon, double dfPolyValue)
+
+{
     /* -------------------------------------------------------------------- */
     /*      Create the feature object.                                      */
     /* -------------------------------------------------------------------- */
@@ -504,7 +499,7 @@ static CPLErr EmitPolygonToLayer(OGRLayerH hOutLayer, int iPixValField,
     OGR_F_SetGeometryDirectly(hFeat, hPolygon);
 
     if (iPixValField >= 0)
-        OGR_F_SetFieldDouble(hFeat, iPixValField, poRPoly->dfPolyValue);
+        OGR_F_SetFieldDouble(hFeat, iPixValField, dfPolyValue);
 
     /* -------------------------------------------------------------------- */
     /*      Write the to the layer.                                         */
@@ -519,6 +514,19 @@ static CPLErr EmitPolygonToLayer(OGRLayerH hOutLayer, int iPixValField,
     return eErr;
 }
 
+/************************************************************************/
+/*                         EmitPolygonToLayer()                         */
+/************************************************************************/
+
+static CPLErr EmitPolygonToLayer(OGRLayerH hOutLayer, int iPixValField,
+                                 RPolygon *poRPoly, double *padfGeoTransform)
+
+{
+    return EmitPolygonToLayer(hOutLayer, iPixValField,
+                              RPolygonToGeometry(poRPoly, padfGeoTransform),
+                              poRPoly->dfPolyValue);
+}
+
 /************************************************************************/
 /*                          GPMaskImageData()                           */
 /*                                                                      */
@@ -545,6 +553,523 @@ static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
     return CE_None;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*      Streaming polygonization.                                       */
+/*                                                                      */
+/*      The raster is split in strips of lines, that are labeled        */
+/*      independently (and possibly in parallel), each one together     */
+/*      with the last line of the previous strip. The calls that        */
+/*      AddEdges() makes for each polygon piece of a strip are          */
+/*      recorded. Strips are then stitched in order with a union-find   */
+/*      structure that only holds the polygons touching the last        */
+/*      processed line, and polygons are emitted as soon as they are    */
+/*      closed, by replaying their recorded segments in raster order.   */
+/*      This gives the same geometries as the default algorithm, with   */
+/*      a memory use that depends on the open polygons only.            */
+/* ==================================================================== */
+/************************************************************************/
+
+namespace
+{
+
+// One call to RPolygon::AddSegment() made by AddEdges(). Sorting records
+// gives back the order in which the calls were made for a given polygon.
+struct GPSegment
+{
+    int nY;
+    int nX;     // iX argument of AddEdges()
+    int nKind;  // 0/1: top edge of this pixel/of the pixel above,
+                // 2/3: right edge of this pixel/left edge of the pixel at right
+
+    bool operator<(const GPSegment &other) const
+    {
+        if (nY != other.nY)
+            return nY < other.nY;
+        if (nX != other.nX)
+            return nX < other.nX;
+        return nKind < other.nKind;
+    }
+};
+
+template <class DataType> struct GPStrip
+{
+    int nXSize = 0;
+    int nYOff = 0;
+    int nLines = 0;
+    bool bHasHalo = false;  // whether aValues starts with line nYOff - 1
+    bool bLastStrip = false;
+    int nConnectedness = 4;
+    const double *padfGeoTransform = nullptr;
+
+    std::vector<DataType> aValues{};
+
+    // Outputs.
+    bool bOutOfMemory = false;
+    std::vector<GInt32> anHaloIds{};  // polygon id of the halo line pixels
+    std::vector<GInt32> anLastIds{};  // polygon id of the last line pixels
+    std::vector<std::vector<GPSegment>> aaoSegments{};  // indexed by id
+    std::vector<double> adfPolyValue{};                 // indexed by id
+    // Polygons that do not touch the first or last line of the strip.
+    std::vector<std::pair<OGRGeometryH, double>> aoClosedPolygons{};
+};
+
+struct GPOpenPolygon
+{
+    int nParent = 0;
+    double dfPolyValue = 0;
+    std::vector<GPSegment> aoSegments{};
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                        GPSegmentsToGeometry()                        */
+/************************************************************************/
+
+static OGRGeometryH
+GPSegmentsToGeometry(const std::vector<GPSegment> &aoSegments,
+                     double dfPolyValue, const double *padfGeoTransform)
+{
+    RPolygon oPoly(dfPolyValue);
+    for (const auto &oSeg : aoSegments)
+    {
+        if (oSeg.nKind < 2)
+            oPoly.AddSegment(oSeg.nX - 1, oSeg.nY, oSeg.nX, oSeg.nY,
+                             oSeg.nKind == 0 ? 1 : 0);
+        else
+            oPoly.AddSegment(oSeg.nX, oSeg.nY, oSeg.nX, oSeg.nY + 1,
+                             oSeg.nKind == 2 ? 1 : 0);
+    }
+    return RPolygonToGeometry(&oPoly, padfGeoTransform);
+}
+
+/************************************************************************/
+/*                          GPProcessStrip()                            */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static void GPProcessStrip(GPStrip<DataType> *psStrip)
+{
+    const int nXSize = psStrip->nXSize;
+    const int nTotalLines = psStrip->nLines + (psStrip->bHasHalo ? 1 : 0);
+
+    try
+    {
+        /* ---------------------------------------------------------------- */
+        /*      Label the pixels of the strip, with a padding id of -1      */
+        /*      before and after each line.                                 */
+        /* ---------------------------------------------------------------- */
+        GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oEnum(
+            psStrip->nConnectedness);
+        std::vector<GInt32> anIds(static_cast<size_t>(nTotalLines) *
+                                  (nXSize + 2));
+        const auto Ids = [&anIds, nXSize](int iLine)
+        { return anIds.data() + static_cast<size_t>(iLine) * (nXSize + 2); };
+        const auto Values = [psStrip, nXSize](int iLine)
+        {
+            return psStrip->aValues.data() +
+                   static_cast<size_t>(iLine) * nXSize;
+        };
+
+        for (int iLine = 0; iLine < nTotalLines; iLine++)
+        {
+            GInt32 *panThisLineId = Ids(iLine);
+            panThisLineId[0] = -1;
+            panThisLineId[nXSize + 1] = -1;
+            if (iLine == 0)
+                oEnum.ProcessLine(nullptr, Values(iLine), nullptr,
+                                  panThisLineId + 1, nXSize);
+            else
+                oEnum.ProcessLine(Values(iLine - 1), Values(iLine),
+                                  Ids(iLine - 1) + 1, panThisLineId + 1,
+                                  nXSize);
+        }
+        oEnum.CompleteMerges();
+        psStrip->aValues.clear();
+        psStrip->aValues.shrink_to_fit();
+
+        /* ---------------------------------------------------------------- */
+        /*      Record polygon edges.                                       */
+        /* ---------------------------------------------------------------- */
+        auto &aaoSegments = psStrip->aaoSegments;
+        aaoSegments.resize(oEnum.nNextPolygonId);
+        const auto RecordSegment = [&aaoSegments](int nId, int x1, int y1,
+                                                  int x2, int y2, int direction)
+        {
+            GPSegment oSeg;
+            oSeg.nY = y1;
+            if (y1 == y2)
+            {
+                oSeg.nX = x2;
+                oSeg.nKind = direction == 1 ? 0 : 1;
+            }
+            else
+            {
+                oSeg.nX = x1;
+                oSeg.nKind = direction == 1 ? 2 : 3;
+            }
+            aaoSegments[nId].push_back(oSeg);
+        };
+
+        std::vector<GInt32> anEmptyLine(nXSize + 2, -1);
+        const int iFirstLine = psStrip->bHasHalo ? 1 : 0;
+        for (int iLine = iFirstLine; iLine <= nTotalLines; iLine++)
+        {
+            if (iLine == nTotalLines && !psStrip->bLastStrip)
+                break;
+            GInt32 *panThisLineId =
+                iLine < nTotalLines ? Ids(iLine) : anEmptyLine.data();
+            GInt32 *panLastLineId =
+                iLine > 0 ? Ids(iLine - 1) : anEmptyLine.data();
+            const int iY = psStrip->nYOff + iLine - iFirstLine;
+            for (int iX = 0; iX < nXSize + 1; iX++)
+            {
+                AddEdges(panThisLineId, panLastLineId, oEnum.panPolyIdMap, iX,
+                         iY, RecordSegment);
+            }
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Collect the polygon ids of the first and last lines.        */
+        /* ---------------------------------------------------------------- */
+        std::vector<bool> abTouchesBoundary(oEnum.nNextPolygonId);
+        const auto GetFinalIds =
+            [&oEnum, &abTouchesBoundary, nXSize](const GInt32 *panLineId,
+                                                 std::vector<GInt32> &anOut,
+                                                 bool bMarkBoundary)
+        {
+            anOut.resize(nXSize);
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const int nId = panLineId[iX + 1];
+                anOut[iX] = nId >= 0 ? oEnum.panPolyIdMap[nId] : -1;
+                if (bMarkBoundary && nId >= 0)
+                    abTouchesBoundary[anOut[iX]] = true;
+            }
+        };
+        if (psStrip->bHasHalo)
+            GetFinalIds(Ids(0), psStrip->anHaloIds, true);
+        GetFinalIds(Ids(nTotalLines - 1), psStrip->anLastIds,
+                    !psStrip->bLastStrip);
+        anIds.clear();
+        anIds.shrink_to_fit();
+
+        psStrip->adfPolyValue.resize(oEnum.nNextPolygonId);
+        for (int iPoly = 0; iPoly < oEnum.nNextPolygonId; iPoly++)
+        {
+            // FIXME loss of precision for [U]Int64
+            psStrip->adfPolyValue[iPoly] =
+                static_cast<double>(oEnum.panPolyValue[iPoly]);
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Build the geometries of the polygons that are closed        */
+        /*      within this strip.                                          */
+        /* ---------------------------------------------------------------- */
+        for (int iPoly = 0; iPoly < oEnum.nNextPolygonId; iPoly++)
+        {
+            if (!abTouchesBoundary[iPoly] && !aaoSegments[iPoly].empty())
+            {
+                psStrip->aoClosedPolygons.emplace_back(
+                    GPSegmentsToGeometry(aaoSegments[iPoly],
+                                         psStrip->adfPolyValue[iPoly],
+                                         psStrip->padfGeoTransform),
+                    psStrip->adfPolyValue[iPoly]);
+                std::vector<GPSegment>().swap(aaoSegments[iPoly]);
+            }
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        psStrip->bOutOfMemory = true;
+    }
+}
+
+/************************************************************************/
+/*                     GDALPolygonizeStreamingT()                       */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static CPLErr GDALPolygonizeStreamingT(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand, OGRLayerH hOutLayer,
+    int iPixValField, int nConnectedness, const double *padfGeoTransform,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg,
+    GDALDataType eDT)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    /* -------------------------------------------------------------------- */
+    /*      Determine the strip height, so that a strip uses about          */
+    /*      32 MB for its pixel values and polygon ids.                     */
+    /* -------------------------------------------------------------------- */
+    constexpr int MAX_BYTES_PER_STRIP = 32 * 1024 * 1024;
+    constexpr int MAX_LINES_PER_STRIP = 1024;
+    int nLinesPerStrip = static_cast<int>(std::max<GIntBig>(
+        1, std::min<GIntBig>(MAX_LINES_PER_STRIP,
+                             MAX_BYTES_PER_STRIP /
+                                 ((static_cast<GIntBig>(nXSize) + 2) *
+                                  (sizeof(DataType) + sizeof(GInt32))))));
+    if (nThreads > 1)
+        nLinesPerStrip = std::max(
+            1, std::min(nLinesPerStrip, (nYSize + nThreads - 1) / nThreads));
+    const char *pszLinesPerStrip =
+        CPLGetConfigOption("GDAL_POLYGONIZE_LINES_PER_STRIP", nullptr);
+    if (pszLinesPerStrip)
+        nLinesPerStrip = std::max(1, atoi(pszLinesPerStrip));
+    const int nStrips =
+        nYSize == 0 ? 0 : (nYSize + nLinesPerStrip - 1) / nLinesPerStrip;
+
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+
+    std::vector<GByte> abyMaskLine;
+    std::vector<GPOpenPolygon> aoOpenPolygons;
+    std::vector<int> anLastLineOpenPolygon;
+
+    const auto Find = [&aoOpenPolygons](int i)
+    {
+        while (aoOpenPolygons[i].nParent != i)
+        {
+            aoOpenPolygons[i].nParent =
+                aoOpenPolygons[aoOpenPolygons[i].nParent].nParent;
+            i = aoOpenPolygons[i].nParent;
+        }
+        return i;
+    };
+
+    const auto Union = [&aoOpenPolygons, &Find](int i, int j)
+    {
+        i = Find(i);
+        j = Find(j);
+        if (i == j)
+            return;
+        // Keep the oldest polygon as the root, but append the smallest
+        // segment list to the largest one.
+        if (j < i)
+            std::swap(i, j);
+        auto &aoSegmentsI = aoOpenPolygons[i].aoSegments;
+        auto &aoSegmentsJ = aoOpenPolygons[j].aoSegments;
+        if (aoSegmentsI.size() < aoSegmentsJ.size())
+            std::swap(aoSegmentsI, aoSegmentsJ);
+        aoSegmentsI.insert(aoSegmentsI.end(), aoSegmentsJ.begin(),
+                           aoSegmentsJ.end());
+        std::vector<GPSegment>().swap(aoSegmentsJ);
+        aoOpenPolygons[j].nParent = i;
+    };
+
+    CPLErr eErr = CE_None;
+    const auto Emit = [&eErr, hOutLayer, iPixValField](OGRGeometryH hPolygon,
+                                                      double dfPolyValue)
+    {
+        if (eErr == CE_None)
+            eErr = EmitPolygonToLayer(hOutLayer, iPixValField, hPolygon,
+                                      dfPolyValue);
+        else
+            OGR_G_DestroyGeometry(hPolygon);
+    };
+
+    const int nStripsPerBatch = poQueue ? nThreads : 1;
+    for (int iBatchStart = 0; eErr == CE_None && iBatchStart < nStrips;
+         iBatchStart += nStripsPerBatch)
+    {
+        /* ---------------------------------------------------------------- */
+        /*      Read and label a batch of strips.                           */
+        /* ---------------------------------------------------------------- */
+        const int nBatchStrips =
+            std::min(nStripsPerBatch, nStrips - iBatchStart);
+        std::vector<std::unique_ptr<GPStrip<DataType>>> apoStrips;
+        for (int i = 0; eErr == CE_None && i < nBatchStrips; i++)
+        {
+            const int iStrip = iBatchStart + i;
+            apoStrips.emplace_back(new GPStrip<DataType>());
+            auto psStrip = apoStrips.back().get();
+            psStrip->nXSize = nXSize;
+            psStrip->nYOff = iStrip * nLinesPerStrip;
+            psStrip->nLines =
+                std::min(nLinesPerStrip, nYSize - psStrip->nYOff);
+            psStrip->bHasHalo = iStrip > 0;
+            psStrip->bLastStrip = iStrip == nStrips - 1;
+            psStrip->nConnectedness = nConnectedness;
+            psStrip->padfGeoTransform = padfGeoTransform;
+
+            const int nFirstLine = psStrip->nYOff - (iStrip > 0 ? 1 : 0);
+            const int nTotalLines =
+                psStrip->nYOff + psStrip->nLines - nFirstLine;
+            try
+            {
+                psStrip->aValues.resize(static_cast<size_t>(nTotalLines) *
+                                        nXSize);
+                if (hMaskBand)
+                    abyMaskLine.resize(nXSize);
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate polygonize working buffers");
+                eErr = CE_Failure;
+                break;
+            }
+
+            eErr = GDALRasterIO(hSrcBand, GF_Read, 0, nFirstLine, nXSize,
+                                nTotalLines, psStrip->aValues.data(), nXSize,
+                                nTotalLines, eDT, 0, 0);
+            for (int iLine = 0;
+                 eErr == CE_None && hMaskBand != nullptr && iLine < nTotalLines;
+                 iLine++)
+            {
+                eErr = GPMaskImageData(
+                    hMaskBand, abyMaskLine.data(), nFirstLine + iLine, nXSize,
+                    psStrip->aValues.data() +
+                        static_cast<size_t>(iLine) * nXSize);
+            }
+            if (eErr != CE_None)
+                break;
+
+            const auto JobFunc = [](void *pData)
+            {
+                GPProcessStrip<DataType, EqualityTest>(
+                    static_cast<GPStrip<DataType> *>(pData));
+            };
+            if (!poQueue || !poQueue->SubmitJob(JobFunc, psStrip))
+                JobFunc(psStrip);
+        }
+        if (poQueue)
+            poQueue->WaitCompletion();
+
+        /* ---------------------------------------------------------------- */
+        /*      Stitch strips in order, and emit closed polygons.           */
+        /* ---------------------------------------------------------------- */
+        for (int i = 0; eErr == CE_None && i < nBatchStrips; i++)
+        {
+            auto psStrip = apoStrips[i].get();
+            if (psStrip->bOutOfMemory)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate polygonize working buffers");
+                eErr = CE_Failure;
+                break;
+            }
+
+            for (const auto &oClosedPolygon : psStrip->aoClosedPolygons)
+                Emit(oClosedPolygon.first, oClosedPolygon.second);
+            psStrip->aoClosedPolygons.clear();
+
+            // Register the polygons touching the first or last line.
+            std::vector<int> anStripToOpenPolygon(
+                psStrip->aaoSegments.size(), -1);
+            const auto GetOpenPolygon =
+                [&aoOpenPolygons, &anStripToOpenPolygon, psStrip](int nId)
+            {
+                if (anStripToOpenPolygon[nId] < 0)
+                {
+                    anStripToOpenPolygon[nId] =
+                        static_cast<int>(aoOpenPolygons.size());
+                    aoOpenPolygons.emplace_back();
+                    auto &oPoly = aoOpenPolygons.back();
+                    oPoly.nParent = anStripToOpenPolygon[nId];
+                    oPoly.dfPolyValue = psStrip->adfPolyValue[nId];
+                    oPoly.aoSegments = std::move(psStrip->aaoSegments[nId]);
+                }
+                return anStripToOpenPolygon[nId];
+            };
+
+            if (psStrip->bHasHalo)
+            {
+                for (int iX = 0; iX < nXSize; iX++)
+                {
+                    const int nId = psStrip->anHaloIds[iX];
+                    if (nId >= 0 && anLastLineOpenPolygon[iX] >= 0)
+                        Union(GetOpenPolygon(nId), anLastLineOpenPolygon[iX]);
+                }
+            }
+
+            // Polygons that touch the last line of the strip are still open.
+            std::vector<bool> abStillOpen(aoOpenPolygons.size());
+            if (!psStrip->bLastStrip)
+            {
+                for (int iX = 0; iX < nXSize; iX++)
+                {
+                    const int nId = psStrip->anLastIds[iX];
+                    if (nId >= 0)
+                    {
+                        const int iOpen = GetOpenPolygon(nId);
+                        if (static_cast<size_t>(iOpen) >= abStillOpen.size())
+                            abStillOpen.resize(iOpen + 1);
+                        abStillOpen[Find(iOpen)] = true;
+                    }
+                }
+            }
+
+            // Emit the others, and renumber the open polygons.
+            std::vector<int> anNewIndex(aoOpenPolygons.size(), -1);
+            std::vector<GPOpenPolygon> aoNewOpenPolygons;
+            for (int iOpen = 0;
+                 iOpen < static_cast<int>(aoOpenPolygons.size()); iOpen++)
+            {
+                if (Find(iOpen) != iOpen)
+                    continue;
+                auto &oPoly = aoOpenPolygons[iOpen];
+                if (static_cast<size_t>(iOpen) < abStillOpen.size() &&
+                    abStillOpen[iOpen])
+                {
+                    anNewIndex[iOpen] =
+                        static_cast<int>(aoNewOpenPolygons.size());
+                    aoNewOpenPolygons.emplace_back(std::move(oPoly));
+                    aoNewOpenPolygons.back().nParent = anNewIndex[iOpen];
+                }
+                else
+                {
+                    std::sort(oPoly.aoSegments.begin(),
+                              oPoly.aoSegments.end());
+                    Emit(GPSegmentsToGeometry(oPoly.aoSegments,
+                                              oPoly.dfPolyValue,
+                                              padfGeoTransform),
+                         oPoly.dfPolyValue);
+                }
+            }
+
+            anLastLineOpenPolygon.assign(nXSize, -1);
+            if (!psStrip->bLastStrip)
+            {
+                for (int iX = 0; iX < nXSize; iX++)
+                {
+                    const int nId = psStrip->anLastIds[iX];
+                    if (nId >= 0)
+                        anLastLineOpenPolygon[iX] =
+                            anNewIndex[Find(anStripToOpenPolygon[nId])];
+                }
+            }
+            aoOpenPolygons = std::move(aoNewOpenPolygons);
+            apoStrips[i].reset();
+
+            if (eErr == CE_None &&
+                !pfnProgress(static_cast<double>(iBatchStart + i + 1) /
+                                 nStrips,
+                             "", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                eErr = CE_Failure;
+            }
+        }
+
+        // Free geometries of strips that were not emitted because of an
+        // error.
+        for (auto &poStrip : apoStrips)
+        {
+            if (poStrip)
+            {
+                for (const auto &oClosedPolygon : poStrip->aoClosedPolygons)
+                    OGR_G_DestroyGeometry(oClosedPolygon.first);
+            }
+        }
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALPolygonizeT()                          */
 /************************************************************************/
@@ -577,37 +1102,9 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Allocate working buffers.                                       */
-    /* -------------------------------------------------------------------- */
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
 
-    DataType *panLastLineVal = static_cast<DataType *>(
-        VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize + 2));
-    DataType *panThisLineVal = static_cast<DataType *>(
-        VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize + 2));
-    GInt32 *panLastLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize + 2));
-    GInt32 *panThisLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize + 2));
-
-    GByte *pabyMaskLine = hMaskBand != nullptr
-                              ? static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize))
-                              : nullptr;
-
-    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
-        panLastLineId == nullptr || panThisLineId == nullptr ||
-        (hMaskBand != nullptr && pabyMaskLine == nullptr))
-    {
-        CPLFree(panThisLineId);
-        CPLFree(panLastLineId);
-        CPLFree(panThisLineVal);
-        CPLFree(panLastLineVal);
-        CPLFree(pabyMaskLine);
-        return CE_Failure;
-    }
-
     /* -------------------------------------------------------------------- */
     /*      Get the geotransform, if there is one, so we can convert the    */
     /*      vectors into georeferenced coordinates.                         */
@@ -643,6 +1140,45 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         adfGeoTransform[5] = 1;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Use the streaming algorithm if requested.                       */
+    /* -------------------------------------------------------------------- */
+    if (CPLFetchBool(papszOptions, "STREAMING", false))
+    {
+        const int nThreads = GDALGetNumThreads(papszOptions, true);
+        return GDALPolygonizeStreamingT<DataType, EqualityTest>(
+            hSrcBand, hMaskBand, hOutLayer, iPixValField, nConnectedness,
+            adfGeoTransform, nThreads, pfnProgress, pProgressArg, eDT);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Allocate working buffers.                                       */
+    /* -------------------------------------------------------------------- */
+    DataType *panLastLineVal = static_cast<DataType *>(
+        VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize + 2));
+    DataType *panThisLineVal = static_cast<DataType *>(
+        VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize + 2));
+    GInt32 *panLastLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize + 2));
+    GInt32 *panThisLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize + 2));
+
+    GByte *pabyMaskLine = hMaskBand != nullptr
+                              ? static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize))
+                              : nullptr;
+
+    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
+        panLastLineId == nullptr || panThisLineId == nullptr ||
+        (hMaskBand != nullptr && pabyMaskLine == nullptr))
+    {
+        CPLFree(panThisLineId);
+        CPLFree(panLastLineId);
+        CPLFree(panThisLineVal);
+        CPLFree(panLastLineVal);
+        CPLFree(pabyMaskLine);
+        return CE_Failure;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      The first pass over the raster is only used to build up the     */
     /*      polygon id map so we will know in advance what polygons are     */
@@ -713,6 +1249,17 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         nConnectedness);
     RPolygon **papoPoly = static_cast<RPolygon **>(
         CPLCalloc(sizeof(RPolygon *), oFirstEnum.nNextPolygonId));
+    const auto AddSegmentToPolygon =
+        [papoPoly, &oFirstEnum](int nId, int x1, int y1, int x2, int y2,
+                                int direction)
+    {
+        if (papoPoly[nId] == nullptr)
+            // FIXME loss of precision for [U]Int64
+            papoPoly[nId] = new RPolygon(
+                static_cast<double>(oFirstEnum.panPolyValue[nId]));
+
+        papoPoly[nId]->AddSegment(x1, y1, x2, y2, direction);
+    };
 
     /* ==================================================================== */
     /*      Second pass during which we will actually collect polygon       */
@@ -769,8 +1316,8 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
          */
         for (int iX = 0; iX < nXSize + 1; iX++)
         {
-            AddEdges(panThisLineId, panLastLineId, oFirstEnum.panPolyIdMap,
-                     oFirstEnum.panPolyValue, papoPoly, iX, iY);
+            AddEdges(panThisLineId, panLastLineId, oFirstEnum.panPolyIdMap, iX,
+                     iY, AddSegmentToPolygon);
         }
 
         /* --------------------------------------------------------------------
@@ -946,6 +1493,16 @@ GBool GDALFloatEquals(float A, float B)
  * <ul>
  * <li>8CONNECTED=8: May be set to "8" to use 8 connectedness.
  * Otherwise 4 connectedness will be applied to the algorithm</li>
+ * <li>STREAMING=YES/NO: (GDAL >= 3.8) If set to YES, the raster is
+ * processed by strips of lines that are labeled independently and stitched
+ * together, and polygons are written as soon as they are complete. Memory
+ * use then depends on the polygons crossing the current strip, rather than
+ * on the total number of polygons. The output polygons are the same as with
+ * the default algorithm, but may be written in a different order.
+ * Defaults to NO.</li>
+ * <li>NUM_THREADS=n/ALL_CPUS: (GDAL >= 3.8) Number of threads used to
+ * label strips when STREAMING=YES. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -1017,6 +1574,16 @@ CPLErr CPL_STDCALL GDALPolygonize(GDALRasterBandH hSrcBand,
  * <ul>
  * <li>8CONNECTED=8: May be set to "8" to use 8 connectedness.
  * Otherwise 4 connectedness will be applied to the algorithm</li>
+ * <li>STREAMING=YES/NO: (GDAL >= 3.8) If set to YES, the raster is
+ * processed by strips of lines that are labeled independently and stitched
+ * together, and polygons are written as soon as they are complete. Memory
+ * use then depends on the polygons crossing the current strip, rather than
+ * on the total number of polygons. The output polygons are the same as with
+ * the default algorithm, but may be written in a different order.
+ * Defaults to NO.</li>
+ * <li>NUM_THREADS=n/ALL_CPUS: (GDAL >= 3.8) Number of threads used to
+ * label strips when STREAMING=YES. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -35,16 +35,22 @@
 #include <cstring>
 
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include <new>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
@@ -334,32 +340,1154 @@ static CPLErr GDALMultiFilter(GDALRasterBandH hTargetBand,
     return eErr;
 }
 
+/************************************************************************/
+/*                     GDALFillNodataLinesPerStrip()                    */
+/*                                                                      */
+/*      Number of lines processed at once by the multi-threaded         */
+/*      code paths, so that a strip of each thread fits in a memory     */
+/*      budget of about 16 MB. Can be overridden with the               */
+/*      GDAL_FILLNODATA_LINES_PER_STRIP configuration option (mostly    */
+/*      for testing purposes).                                          */
+/************************************************************************/
+
+static int GDALFillNodataLinesPerStrip(int nXSize, int nYSize,
+                                       int nBytesPerPixel)
+{
+    const char *pszLinesPerStrip =
+        CPLGetConfigOption("GDAL_FILLNODATA_LINES_PER_STRIP", nullptr);
+    if (pszLinesPerStrip)
+        return std::max(1, std::min(nYSize, atoi(pszLinesPerStrip)));
+    const GIntBig nBytesPerLine =
+        static_cast<GIntBig>(nXSize) * nBytesPerPixel;
+    return static_cast<int>(std::max<GIntBig>(
+        1, std::min<GIntBig>(nYSize, 16 * 1024 * 1024 / nBytesPerLine)));
+}
+
+/************************************************************************/
+/*                         GDALMultiFilterStrip                         */
+/************************************************************************/
+
+namespace
+{
+struct GDALMultiFilterStrip
+{
+    // Window of the chunk buffers (with halo) used by this strip
+    const float *pafIn = nullptr;
+    const GByte *pabyTMask = nullptr;
+    const GByte *pabyFMask = nullptr;
+    int nWinYOff = 0;   // image line of the first line of the window
+    int nWinLines = 0;  // number of lines of the window
+
+    // Lines of the window to output
+    float *pafOut = nullptr;
+    int nOutYOff = 0;
+    int nOutLines = 0;
+
+    int nXSize = 0;
+    int nYSize = 0;
+    int nIterations = 0;
+    bool bError = false;
+};
+}  // namespace
+
+/************************************************************************/
+/*                       GDALMultiFilterStripFunc()                     */
+/*                                                                      */
+/*      Run all iterations of the 3x3 filter on a strip and its halo    */
+/*      of nIterations lines above and below. The halo lines are        */
+/*      progressively corrupted by the missing neighbours outside of    */
+/*      the window, but by exactly one line per iteration, so the       */
+/*      output lines get the same values as with GDALMultiFilter().     */
+/************************************************************************/
+
+static void GDALMultiFilterStripFunc(void *pData)
+{
+    GDALMultiFilterStrip *psStrip = static_cast<GDALMultiFilterStrip *>(pData);
+    const int nXSize = psStrip->nXSize;
+    const size_t nWinSize = static_cast<size_t>(nXSize) * psStrip->nWinLines;
+
+    std::vector<float> afA, afB;
+    try
+    {
+        afA.assign(psStrip->pafIn, psStrip->pafIn + nWinSize);
+        afB.resize(nWinSize);
+    }
+    catch (const std::bad_alloc &)
+    {
+        psStrip->bError = true;
+        return;
+    }
+
+    for (int iIter = 0; iIter < psStrip->nIterations; iIter++)
+    {
+        for (int iLine = 0; iLine < psStrip->nWinLines; iLine++)
+        {
+            const int iY = psStrip->nWinYOff + iLine;
+            const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+
+            // Skip the first and last line of the image and of the window.
+            if (iY < 1 || iY >= psStrip->nYSize - 1 || iLine == 0 ||
+                iLine == psStrip->nWinLines - 1)
+            {
+                memcpy(afB.data() + nOffset, afA.data() + nOffset,
+                       sizeof(float) * nXSize);
+                continue;
+            }
+
+            GDALFilterLine(afA.data() + nOffset - nXSize,
+                           afA.data() + nOffset, afA.data() + nOffset + nXSize,
+                           afB.data() + nOffset,
+                           psStrip->pabyTMask + nOffset - nXSize,
+                           psStrip->pabyTMask + nOffset,
+                           psStrip->pabyTMask + nOffset + nXSize,
+                           psStrip->pabyFMask + nOffset, nXSize);
+        }
+        std::swap(afA, afB);
+    }
+
+    memcpy(psStrip->pafOut,
+           afA.data() + static_cast<size_t>(psStrip->nOutYOff -
+                                            psStrip->nWinYOff) *
+                            nXSize,
+           sizeof(float) * nXSize * psStrip->nOutLines);
+}
+
+/************************************************************************/
+/*                         GDALMultiFilterMT()                          */
+/*                                                                      */
+/*      Multi-threaded version of GDALMultiFilter(). The image is       */
+/*      processed by chunks of nThreads strips, each strip being        */
+/*      filtered independently by a worker thread from its own lines    */
+/*      plus a halo of nIterations lines above and below.               */
+/************************************************************************/
+
+static CPLErr GDALMultiFilterMT(GDALRasterBandH hTargetBand,
+                                GDALRasterBandH hTargetMaskBand,
+                                GDALRasterBandH hFiltMaskBand, int nIterations,
+                                int nThreads, GDALProgressFunc pfnProgress,
+                                void *pProgressArg)
+
+{
+    const int nXSize = GDALGetRasterBandXSize(hTargetBand);
+    const int nYSize = GDALGetRasterBandYSize(hTargetBand);
+
+    if (!pfnProgress(0.0, "Smoothing Filter...", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if (!poJobQueue)
+        return GDALMultiFilter(hTargetBand, hTargetMaskBand, hFiltMaskBand,
+                               nIterations, pfnProgress, pProgressArg);
+
+    // Make the strips at least 4 times taller than the halo, so that the
+    // redundant computations on halo lines remain reasonable.
+    const int nLinesPerStrip = std::max(
+        std::min(nYSize, 4 * nIterations),
+        GDALFillNodataLinesPerStrip(nXSize, nYSize, 3 * sizeof(float) + 2));
+    const int nChunkLines = static_cast<int>(std::min<GIntBig>(
+        nYSize, static_cast<GIntBig>(nLinesPerStrip) * nThreads));
+
+    std::vector<float> afIn, afOut;
+    std::vector<GByte> abyTMask, abyFMask;
+    std::vector<GDALMultiFilterStrip> asStrips;
+
+    CPLErr eErr = CE_None;
+    int nPrevReadYOff = 0;
+    for (int nChunkYOff = 0; eErr == CE_None && nChunkYOff < nYSize;
+         nChunkYOff += nChunkLines)
+    {
+        const int nChunkYEnd = std::min(nYSize, nChunkYOff + nChunkLines);
+        const int nReadYOff = std::max(0, nChunkYOff - nIterations);
+        const int nReadLines =
+            std::min(nYSize, nChunkYEnd + nIterations) - nReadYOff;
+        const size_t nReadSize = static_cast<size_t>(nXSize) * nReadLines;
+
+        // The upper halo lines have already been overwritten by the
+        // previous chunk, so take their original values from the end of its
+        // buffers.
+        const int nKeptLines = nChunkYOff - nReadYOff;
+        if (nKeptLines > 0)
+        {
+            const size_t nSrcOffset =
+                static_cast<size_t>(nReadYOff - nPrevReadYOff) * nXSize;
+            const size_t nKeptSize = static_cast<size_t>(nKeptLines) * nXSize;
+            memmove(afIn.data(), afIn.data() + nSrcOffset,
+                    nKeptSize * sizeof(float));
+            memmove(abyTMask.data(), abyTMask.data() + nSrcOffset, nKeptSize);
+            memmove(abyFMask.data(), abyFMask.data() + nSrcOffset, nKeptSize);
+        }
+        nPrevReadYOff = nReadYOff;
+
+        try
+        {
+            afIn.resize(nReadSize);
+            abyTMask.resize(nReadSize);
+            abyFMask.resize(nReadSize);
+            afOut.resize(static_cast<size_t>(nXSize) *
+                         (nChunkYEnd - nChunkYOff));
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate smoothing buffers");
+            eErr = CE_Failure;
+            break;
+        }
+
+        const int nNewLines = nReadLines - nKeptLines;
+        const size_t nKeptSize = static_cast<size_t>(nKeptLines) * nXSize;
+        eErr = GDALRasterIO(hTargetMaskBand, GF_Read, 0, nChunkYOff, nXSize,
+                            nNewLines, abyTMask.data() + nKeptSize, nXSize,
+                            nNewLines, GDT_Byte, 0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hFiltMaskBand, GF_Read, 0, nChunkYOff, nXSize,
+                                nNewLines, abyFMask.data() + nKeptSize,
+                                nXSize, nNewLines, GDT_Byte, 0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hTargetBand, GF_Read, 0, nChunkYOff, nXSize,
+                                nNewLines, afIn.data() + nKeptSize, nXSize,
+                                nNewLines, GDT_Float32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        asStrips.clear();
+        for (int nStripYOff = nChunkYOff; nStripYOff < nChunkYEnd;
+             nStripYOff += nLinesPerStrip)
+        {
+            GDALMultiFilterStrip sStrip;
+            const int nStripYEnd =
+                std::min(nChunkYEnd, nStripYOff + nLinesPerStrip);
+            sStrip.nWinYOff = std::max(0, nStripYOff - nIterations);
+            sStrip.nWinLines =
+                std::min(nYSize, nStripYEnd + nIterations) - sStrip.nWinYOff;
+            const size_t nWinOffset =
+                static_cast<size_t>(sStrip.nWinYOff - nReadYOff) * nXSize;
+            sStrip.pafIn = afIn.data() + nWinOffset;
+            sStrip.pabyTMask = abyTMask.data() + nWinOffset;
+            sStrip.pabyFMask = abyFMask.data() + nWinOffset;
+            sStrip.pafOut = afOut.data() +
+                            static_cast<size_t>(nStripYOff - nChunkYOff) *
+                                nXSize;
+            sStrip.nOutYOff = nStripYOff;
+            sStrip.nOutLines = nStripYEnd - nStripYOff;
+            sStrip.nXSize = nXSize;
+            sStrip.nYSize = nYSize;
+            sStrip.nIterations = nIterations;
+            asStrips.push_back(sStrip);
+        }
+
+        for (auto &sStrip : asStrips)
+            poJobQueue->SubmitJob(GDALMultiFilterStripFunc, &sStrip);
+        poJobQueue->WaitCompletion();
+
+        for (const auto &sStrip : asStrips)
+        {
+            if (sStrip.bError)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate smoothing buffers");
+                eErr = CE_Failure;
+            }
+        }
+        if (eErr != CE_None)
+            break;
+
+        eErr = GDALRasterIO(hTargetBand, GF_Write, 0, nChunkYOff, nXSize,
+                            nChunkYEnd - nChunkYOff, afOut.data(), nXSize,
+                            nChunkYEnd - nChunkYOff, GDT_Float32, 0, 0);
+
+        if (eErr == CE_None &&
+            !pfnProgress(nChunkYEnd / static_cast<double>(nYSize),
+                         "Smoothing Filter...", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                             QUAD_CHECK()                             */
 /*                                                                      */
-/*      macro for checking whether a point is nearer than the           */
-/*      existing closest point.                                         */
+/*      macro for checking whether a point is nearer than the           */
+/*      existing closest point.                                         */
+/************************************************************************/
+
+inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
+                       GUInt32 target_y, int origin_x, int origin_y,
+                       float fTargetValue, GUInt32 nNoDataVal)
+{
+    if (target_y != nNoDataVal)
+    {
+        const double dfDx =
+            static_cast<double>(target_x) - static_cast<double>(origin_x);
+        const double dfDy =
+            static_cast<double>(target_y) - static_cast<double>(origin_y);
+        double dfDistSq = dfDx * dfDx + dfDy * dfDy;
+
+        if (dfDistSq < dfQuadDist * dfQuadDist)
+        {
+            CPLAssert(dfDistSq > 0.0);
+            dfQuadDist = sqrt(dfDistSq);
+            fQuadValue = fTargetValue;
+        }
+    }
+}
+
+/************************************************************************/
+/*                      GDALFillNodataInterpolator                      */
+/************************************************************************/
+
+namespace
+{
+struct GDALFillNodataInterpolator
+{
+    int nXSize = 0;
+    double dfMaxSearchDist = 0;
+    int nMaxSearchDist = 0;
+    GUInt32 nNoDataVal = 0;
+    bool bHasNoData = false;
+    float fNoData = 0;
+
+    // Buffers of a batch of nBatchLines lines, the first one being image
+    // line nBatchYOff.
+    int nBatchYOff = 0;
+    int nBatchLines = 0;
+    const GUInt32 *panTopDownY = nullptr;
+    const float *pafTopDownValue = nullptr;
+    const GUInt32 *panBottomUpY = nullptr;
+    const float *pafBottomUpValue = nullptr;
+    float *pafScanline = nullptr;
+    GByte *pabyMask = nullptr;
+    GByte *pabyFiltMask = nullptr;
+
+    void InterpolateLine(int iLine) const;
+};
+
+struct GDALFillNodataInterpolateJob
+{
+    const GDALFillNodataInterpolator *poInterpolator = nullptr;
+    int iFirstLine = 0;
+    int nLineStep = 1;
+};
+}  // namespace
+
+/************************************************************************/
+/*                          InterpolateLine()                           */
+/*                                                                      */
+/*      Attempt to interpolate any pixels that are nodata on a line     */
+/*      of the batch, from the last valid values found in each column   */
+/*      when scanning from top to bottom (panTopDownY, which includes   */
+/*      the current line) and from bottom to top (panBottomUpY, which   */
+/*      doesn't).                                                       */
+/************************************************************************/
+
+void GDALFillNodataInterpolator::InterpolateLine(int iLine) const
+{
+    const int iY = nBatchYOff + iLine;
+    const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+    const GUInt32 *const panTopDownYLine = panTopDownY + nOffset;
+    const float *const pafTopDownValueLine = pafTopDownValue + nOffset;
+    const GUInt32 *const panLastY = panBottomUpY + nOffset;
+    const float *const pafLastValue = pafBottomUpValue + nOffset;
+    float *const pafScanlineLine = pafScanline + nOffset;
+    GByte *const pabyMaskLine = pabyMask + nOffset;
+    GByte *const pabyFiltMaskLine = pabyFiltMask + nOffset;
+
+    memset(pabyFiltMaskLine, 0, nXSize);
+    for (int iX = 0; iX < nXSize; iX++)
+    {
+        int nThisMaxSearchDist = nMaxSearchDist;
+
+        // If this was a valid target - no change.
+        if (pabyMaskLine[iX])
+            continue;
+
+        // Quadrants 0:topleft, 1:bottomleft, 2:topright, 3:bottomright
+        double adfQuadDist[4] = {};
+        float fQuadValue[4] = {};
+
+        for (int iQuad = 0; iQuad < 4; iQuad++)
+        {
+            adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
+            fQuadValue[iQuad] = 0.0;
+        }
+
+        // Step left and right by one pixel searching for the closest
+        // target value for each quadrant.
+        for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
+        {
+            const int iLeftX = std::max(0, iX - iStep);
+            const int iRightX = std::min(nXSize - 1, iX + iStep);
+
+            // Top left includes current line.
+            QUAD_CHECK(adfQuadDist[0], fQuadValue[0], iLeftX,
+                       panTopDownYLine[iLeftX], iX, iY,
+                       pafTopDownValueLine[iLeftX], nNoDataVal);
+
+            // Bottom left.
+            QUAD_CHECK(adfQuadDist[1], fQuadValue[1], iLeftX,
+                       panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
+                       nNoDataVal);
+
+            // Top right and bottom right do no include center pixel.
+            if (iStep == 0)
+                continue;
+
+            // Top right includes current line.
+            QUAD_CHECK(adfQuadDist[2], fQuadValue[2], iRightX,
+                       panTopDownYLine[iRightX], iX, iY,
+                       pafTopDownValueLine[iRightX], nNoDataVal);
+
+            // Bottom right.
+            QUAD_CHECK(adfQuadDist[3], fQuadValue[3], iRightX,
+                       panLastY[iRightX], iX, iY, pafLastValue[iRightX],
+                       nNoDataVal);
+
+            // Every four steps, recompute maximum distance.
+            if ((iStep & 0x3) == 0)
+                nThisMaxSearchDist = static_cast<int>(floor(
+                    std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
+                             std::max(adfQuadDist[2], adfQuadDist[3]))));
+        }
+
+        double dfWeightSum = 0.0;
+        double dfValueSum = 0.0;
+        bool bHasSrcValues = false;
+
+        for (int iQuad = 0; iQuad < 4; iQuad++)
+        {
+            if (adfQuadDist[iQuad] <= dfMaxSearchDist)
+            {
+                bHasSrcValues = true;
+                if (!bHasNoData || fQuadValue[iQuad] != fNoData)
+                {
+                    const double dfWeight = 1.0 / adfQuadDist[iQuad];
+                    dfWeightSum += dfWeight;
+                    dfValueSum += fQuadValue[iQuad] * dfWeight;
+                }
+            }
+        }
+
+        if (bHasSrcValues)
+        {
+            pabyFiltMaskLine[iX] = 255;
+            if (dfWeightSum > 0.0)
+            {
+                pabyMaskLine[iX] = 255;
+                pafScanlineLine[iX] =
+                    static_cast<float>(dfValueSum / dfWeightSum);
+            }
+            else
+                pafScanlineLine[iX] = fNoData;
+        }
+    }
+}
+
+/************************************************************************/
+/*                   GDALFillNodataInterpolateJobFunc()                 */
+/************************************************************************/
+
+static void GDALFillNodataInterpolateJobFunc(void *pData)
+{
+    const GDALFillNodataInterpolateJob *psJob =
+        static_cast<const GDALFillNodataInterpolateJob *>(pData);
+    const GDALFillNodataInterpolator *poInterpolator = psJob->poInterpolator;
+    for (int iLine = psJob->iFirstLine; iLine < poInterpolator->nBatchLines;
+         iLine += psJob->nLineStep)
+    {
+        poInterpolator->InterpolateLine(iLine);
+    }
+}
+
+/************************************************************************/
+/*                          GDALFillNodataGrid                          */
+/************************************************************************/
+
+namespace
+{
+// States of the cells of GDALFillNodataGrid
+constexpr GByte GFN_EXCLUDED = 0;  // neither a source nor a pixel to fill
+constexpr GByte GFN_FIXED = 1;     // source pixel
+constexpr GByte GFN_FREE = 2;      // pixel to fill
+constexpr GByte GFN_REACHED = 3;   // temporary state used by the search
+
+// One level of the multigrid pyramid. The unknowns are the values of the
+// GFN_FREE cells, that must be equal to the average of their non excluded
+// 4-neighbours, plus afRhs / (number of such neighbours) when afRhs is set
+// (coarse levels of the V-cycles, which solve for a correction).
+struct GDALFillNodataGrid
+{
+    int nXSize = 0;
+    int nYSize = 0;
+    std::vector<float> afValue{};
+    std::vector<float> afRhs{};
+    std::vector<GByte> abyState{};
+};
+
+struct GDALFillNodataLinesJob
+{
+    const std::function<void(int, int)> *pfnFunc = nullptr;
+    int nYStart = 0;
+    int nYEnd = 0;
+};
+}  // namespace
+
+/************************************************************************/
+/*                     GDALFillNodataLinesJobFunc()                     */
+/************************************************************************/
+
+static void GDALFillNodataLinesJobFunc(void *pData)
+{
+    const GDALFillNodataLinesJob *psJob =
+        static_cast<const GDALFillNodataLinesJob *>(pData);
+    (*psJob->pfnFunc)(psJob->nYStart, psJob->nYEnd);
+}
+
+/************************************************************************/
+/*                      GDALFillNodataForEachLines()                    */
+/*                                                                      */
+/*      Call pfnFunc(nYStart, nYEnd) on ranges of lines covering        */
+/*      [0, nLines[, distributed on worker threads for large grids.     */
+/************************************************************************/
+
+static void
+GDALFillNodataForEachLines(const GDALFillNodataGrid &oGrid, int nLines,
+                           CPLJobQueue *poJobQueue, int nThreads,
+                           const std::function<void(int, int)> &pfnFunc)
+{
+    // Not worth dispatching small grids to worker threads.
+    if (poJobQueue == nullptr ||
+        static_cast<GIntBig>(oGrid.nXSize) * oGrid.nYSize < 256 * 256)
+        nThreads = 1;
+    nThreads = std::min(nThreads, nLines);
+    if (nThreads <= 1)
+    {
+        pfnFunc(0, nLines);
+        return;
+    }
+
+    std::vector<GDALFillNodataLinesJob> asJobs(nThreads);
+    for (int i = 0; i < nThreads; i++)
+    {
+        asJobs[i].pfnFunc = &pfnFunc;
+        asJobs[i].nYStart =
+            static_cast<int>(static_cast<GIntBig>(nLines) * i / nThreads);
+        asJobs[i].nYEnd =
+            static_cast<int>(static_cast<GIntBig>(nLines) * (i + 1) / nThreads);
+        poJobQueue->SubmitJob(GDALFillNodataLinesJobFunc, &asJobs[i]);
+    }
+    poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                     GDALFillNodataSumNeighbours()                    */
+/************************************************************************/
+
+static inline double
+GDALFillNodataSumNeighbours(const GDALFillNodataGrid &oGrid, int iX, int iY,
+                            size_t i, int &nCount)
+{
+    const int nXSize = oGrid.nXSize;
+    const float *const pafValue = oGrid.afValue.data();
+    const GByte *const pabyState = oGrid.abyState.data();
+    double dfSum = 0;
+    nCount = 0;
+    if (iX > 0 && pabyState[i - 1] != GFN_EXCLUDED)
+    {
+        dfSum += pafValue[i - 1];
+        nCount++;
+    }
+    if (iX + 1 < nXSize && pabyState[i + 1] != GFN_EXCLUDED)
+    {
+        dfSum += pafValue[i + 1];
+        nCount++;
+    }
+    if (iY > 0 && pabyState[i - nXSize] != GFN_EXCLUDED)
+    {
+        dfSum += pafValue[i - nXSize];
+        nCount++;
+    }
+    if (iY + 1 < oGrid.nYSize && pabyState[i + nXSize] != GFN_EXCLUDED)
+    {
+        dfSum += pafValue[i + nXSize];
+        nCount++;
+    }
+    return dfSum;
+}
+
+/************************************************************************/
+/*                        GDALFillNodataRelax()                         */
+/*                                                                      */
+/*      Red-black successive over-relaxation sweeps on the cells to     */
+/*      fill. Cells of one color only depend on cells of the other      */
+/*      color, so the result does not depend on the number of threads. */
+/************************************************************************/
+
+static void GDALFillNodataRelax(GDALFillNodataGrid &oGrid, int nSweeps,
+                                double dfOmega, CPLJobQueue *poJobQueue,
+                                int nThreads)
+{
+    for (int iSweep = 0; iSweep < nSweeps; iSweep++)
+    {
+        for (int nColor = 0; nColor < 2; nColor++)
+        {
+            const std::function<void(int, int)> oRelax =
+                [&oGrid, dfOmega, nColor](int nYStart, int nYEnd)
+            {
+                const int nXSize = oGrid.nXSize;
+                float *const pafValue = oGrid.afValue.data();
+                const float *const pafRhs =
+                    oGrid.afRhs.empty() ? nullptr : oGrid.afRhs.data();
+                for (int iY = nYStart; iY < nYEnd; iY++)
+                {
+                    const size_t nLineOffset = static_cast<size_t>(iY) * nXSize;
+                    for (int iX = (iY + nColor) % 2; iX < nXSize; iX += 2)
+                    {
+                        const size_t i = nLineOffset + iX;
+                        if (oGrid.abyState[i] != GFN_FREE)
+                            continue;
+                        int nCount = 0;
+                        double dfSum = GDALFillNodataSumNeighbours(
+                            oGrid, iX, iY, i, nCount);
+                        if (nCount == 0)
+                            continue;
+                        if (pafRhs)
+                            dfSum += pafRhs[i];
+                        pafValue[i] = static_cast<float>(
+                            pafValue[i] +
+                            dfOmega * (dfSum / nCount - pafValue[i]));
+                    }
+                }
+            };
+            GDALFillNodataForEachLines(oGrid, oGrid.nYSize, poJobQueue,
+                                       nThreads, oRelax);
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GDALFillNodataCoarsen()                        */
+/*                                                                      */
+/*      Build the next coarser level of the multigrid pyramid: each     */
+/*      cell covers 2x2 cells of the finer level. It is a source cell   */
+/*      (with the average value of its source subcells) if any of its   */
+/*      subcells is a source, otherwise a cell to fill if any of its    */
+/*      subcells is to be filled. Giving precedence to sources ensures  */
+/*      that each connected area to fill still touches a source.        */
+/************************************************************************/
+
+static void GDALFillNodataCoarsen(const GDALFillNodataGrid &oFine,
+                                  GDALFillNodataGrid &oCoarse)
+{
+    oCoarse.nXSize = (oFine.nXSize + 1) / 2;
+    oCoarse.nYSize = (oFine.nYSize + 1) / 2;
+    const size_t nCoarseSize =
+        static_cast<size_t>(oCoarse.nXSize) * oCoarse.nYSize;
+    oCoarse.afValue.assign(nCoarseSize, 0.0f);
+    oCoarse.abyState.assign(nCoarseSize, GFN_EXCLUDED);
+
+    for (int iY = 0; iY < oCoarse.nYSize; iY++)
+    {
+        for (int iX = 0; iX < oCoarse.nXSize; iX++)
+        {
+            double dfSum = 0;
+            int nFixed = 0;
+            bool bFree = false;
+            for (int iSubY = 2 * iY; iSubY < std::min(2 * iY + 2, oFine.nYSize);
+                 iSubY++)
+            {
+                for (int iSubX = 2 * iX;
+                     iSubX < std::min(2 * iX + 2, oFine.nXSize); iSubX++)
+                {
+                    const size_t i =
+                        static_cast<size_t>(iSubY) * oFine.nXSize + iSubX;
+                    if (oFine.abyState[i] == GFN_FIXED)
+                    {
+                        dfSum += oFine.afValue[i];
+                        nFixed++;
+                    }
+                    else if (oFine.abyState[i] == GFN_FREE)
+                    {
+                        bFree = true;
+                    }
+                }
+            }
+            const size_t i = static_cast<size_t>(iY) * oCoarse.nXSize + iX;
+            if (nFixed > 0)
+            {
+                oCoarse.abyState[i] = GFN_FIXED;
+                oCoarse.afValue[i] = static_cast<float>(dfSum / nFixed);
+            }
+            else if (bFree)
+            {
+                oCoarse.abyState[i] = GFN_FREE;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                      GDALFillNodataProlongate()                      */
+/*                                                                      */
+/*      Set (or add to) the cells to fill of a level the value of the   */
+/*      coarser level cell that covers them.                            */
+/************************************************************************/
+
+static void GDALFillNodataProlongate(const GDALFillNodataGrid &oCoarse,
+                                     GDALFillNodataGrid &oFine, bool bAdd,
+                                     CPLJobQueue *poJobQueue, int nThreads)
+{
+    GDALFillNodataForEachLines(
+        oFine, oFine.nYSize, poJobQueue, nThreads,
+        [&oCoarse, &oFine, bAdd](int nYStart, int nYEnd)
+        {
+            for (int iY = nYStart; iY < nYEnd; iY++)
+            {
+                const float *pafCoarseLine =
+                    oCoarse.afValue.data() +
+                    static_cast<size_t>(iY / 2) * oCoarse.nXSize;
+                const size_t nLineOffset =
+                    static_cast<size_t>(iY) * oFine.nXSize;
+                for (int iX = 0; iX < oFine.nXSize; iX++)
+                {
+                    const size_t i = nLineOffset + iX;
+                    if (oFine.abyState[i] != GFN_FREE)
+                        continue;
+                    if (bAdd)
+                        oFine.afValue[i] += pafCoarseLine[iX / 2];
+                    else
+                        oFine.afValue[i] = pafCoarseLine[iX / 2];
+                }
+            }
+        });
+}
+
+/************************************************************************/
+/*                   GDALFillNodataRestrictResidual()                   */
+/*                                                                      */
+/*      Compute the residual of the equations of the cells to fill,     */
+/*      and sum it over 2x2 cells as the right hand side of the         */
+/*      coarser level.                                                  */
+/************************************************************************/
+
+static void GDALFillNodataRestrictResidual(const GDALFillNodataGrid &oFine,
+                                           GDALFillNodataGrid &oCoarse,
+                                           CPLJobQueue *poJobQueue,
+                                           int nThreads)
+{
+    GDALFillNodataForEachLines(
+        oFine, oCoarse.nYSize, poJobQueue, nThreads,
+        [&oCoarse, &oFine](int nYStart, int nYEnd)
+        {
+            const size_t nStart =
+                static_cast<size_t>(nYStart) * oCoarse.nXSize;
+            const size_t nEnd = static_cast<size_t>(nYEnd) * oCoarse.nXSize;
+            std::fill(oCoarse.afRhs.begin() + nStart,
+                      oCoarse.afRhs.begin() + nEnd, 0.0f);
+            std::fill(oCoarse.afValue.begin() + nStart,
+                      oCoarse.afValue.begin() + nEnd, 0.0f);
+            for (int iY = 2 * nYStart; iY < std::min(2 * nYEnd, oFine.nYSize);
+                 iY++)
+            {
+                const size_t nLineOffset =
+                    static_cast<size_t>(iY) * oFine.nXSize;
+                float *pafCoarseRhs =
+                    oCoarse.afRhs.data() +
+                    static_cast<size_t>(iY / 2) * oCoarse.nXSize;
+                for (int iX = 0; iX < oFine.nXSize; iX++)
+                {
+                    const size_t i = nLineOffset + iX;
+                    if (oFine.abyState[i] != GFN_FREE)
+                        continue;
+                    int nCount = 0;
+                    double dfResidual =
+                        GDALFillNodataSumNeighbours(oFine, iX, iY, i, nCount) -
+                        nCount * static_cast<double>(oFine.afValue[i]);
+                    if (!oFine.afRhs.empty())
+                        dfResidual += oFine.afRhs[i];
+                    pafCoarseRhs[iX / 2] += static_cast<float>(dfResidual);
+                }
+            }
+        });
+}
+
+/************************************************************************/
+/*                        GDALFillNodataVCycle()                        */
+/************************************************************************/
+
+static void GDALFillNodataVCycle(std::vector<GDALFillNodataGrid> &aoLevels,
+                                 int iLevel, CPLJobQueue *poJobQueue,
+                                 int nThreads)
+{
+    constexpr int SMOOTHING_SWEEPS = 2;
+    constexpr int COARSEST_LEVEL_SWEEPS = 64;
+
+    GDALFillNodataGrid &oGrid = aoLevels[iLevel];
+    if (iLevel + 1 == static_cast<int>(aoLevels.size()))
+    {
+        GDALFillNodataRelax(oGrid, COARSEST_LEVEL_SWEEPS, 1.5, poJobQueue,
+                            nThreads);
+        return;
+    }
+
+    GDALFillNodataRelax(oGrid, SMOOTHING_SWEEPS, 1.0, poJobQueue, nThreads);
+    GDALFillNodataRestrictResidual(oGrid, aoLevels[iLevel + 1], poJobQueue,
+                                   nThreads);
+    GDALFillNodataVCycle(aoLevels, iLevel + 1, poJobQueue, nThreads);
+    GDALFillNodataProlongate(aoLevels[iLevel + 1], oGrid, true, poJobQueue,
+                             nThreads);
+    GDALFillNodataRelax(oGrid, SMOOTHING_SWEEPS, 1.0, poJobQueue, nThreads);
+}
+
+/************************************************************************/
+/*                  GDALFillNodataSelectReachable()                     */
+/*                                                                      */
+/*      Keep as pixels to fill only the ones that can be reached from   */
+/*      a source pixel with a path of at most dfMaxSearchDist steps     */
+/*      through 4-connected pixels to fill, or with any path if         */
+/*      dfMaxSearchDist is 0. Returns whether there is any pixel to     */
+/*      fill.                                                           */
+/************************************************************************/
+
+static bool GDALFillNodataSelectReachable(GDALFillNodataGrid &oGrid,
+                                          double dfMaxSearchDist)
+{
+    const int nXSize = oGrid.nXSize;
+    const int nYSize = oGrid.nYSize;
+    GByte *const pabyState = oGrid.abyState.data();
+
+    std::vector<size_t> anFrontier;
+    std::vector<size_t> anNextFrontier;
+    // Mark the pixels to fill next to pixel i as reached.
+    const auto Visit =
+        [nXSize, nYSize, pabyState](size_t i, std::vector<size_t> &anOut)
+    {
+        const int iX = static_cast<int>(i % nXSize);
+        const int iY = static_cast<int>(i / nXSize);
+        const size_t anNeighbours[] = {i - 1, i + 1, i - nXSize, i + nXSize};
+        const bool abValid[] = {iX > 0, iX + 1 < nXSize, iY > 0,
+                                iY + 1 < nYSize};
+        for (int k = 0; k < 4; k++)
+        {
+            if (abValid[k] && pabyState[anNeighbours[k]] == GFN_FREE)
+            {
+                pabyState[anNeighbours[k]] = GFN_REACHED;
+                anOut.push_back(anNeighbours[k]);
+            }
+        }
+    };
+
+    const bool bUnlimited = dfMaxSearchDist == 0;
+    if (bUnlimited || dfMaxSearchDist >= 1)
+    {
+        const size_t nSize = static_cast<size_t>(nXSize) * nYSize;
+        for (size_t i = 0; i < nSize; i++)
+        {
+            if (pabyState[i] == GFN_FIXED)
+                Visit(i, anFrontier);
+        }
+    }
+
+    const bool bHasFree = !anFrontier.empty();
+    for (int nDist = 2;
+         (bUnlimited || nDist <= dfMaxSearchDist) && !anFrontier.empty();
+         nDist++)
+    {
+        anNextFrontier.clear();
+        for (const size_t i : anFrontier)
+            Visit(i, anNextFrontier);
+        std::swap(anFrontier, anNextFrontier);
+    }
+
+    for (auto &nState : oGrid.abyState)
+    {
+        if (nState == GFN_REACHED)
+            nState = GFN_FREE;
+        else if (nState == GFN_FREE)
+            nState = GFN_EXCLUDED;
+    }
+
+    return bHasFree;
+}
+
+/************************************************************************/
+/*                       GDALFillNodataHarmonic()                       */
+/*                                                                      */
+/*      Fill nodata pixels by harmonic interpolation, that is by        */
+/*      solving the Laplace equation with the valid pixels as           */
+/*      boundary conditions, with a multigrid solver. An initial        */
+/*      solution is first computed on a pyramid of 2x coarser grids,    */
+/*      starting from the coarsest one, the solution of each level      */
+/*      being the initial guess of the next finer one (cascadic         */
+/*      multigrid). It is then refined with a few V-cycles, which       */
+/*      solve for the correction on the coarse levels. The whole band   */
+/*      is processed in memory.                                         */
 /************************************************************************/
 
-inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
-                       GUInt32 target_y, int origin_x, int origin_y,
-                       float fTargetValue, GUInt32 nNoDataVal)
+static CPLErr GDALFillNodataHarmonic(
+    GDALRasterBandH hTargetBand, GDALRasterBandH hMaskBand, bool bUpdateMask,
+    GDALRasterBandH hFiltMaskBand, double dfMaxSearchDist, bool bHasNoData,
+    float fNoData, int nThreads, GDALProgressFunc pfnProgress,
+    void *pProgressArg)
 {
-    if (target_y != nNoDataVal)
+    const int nXSize = GDALGetRasterBandXSize(hTargetBand);
+    const int nYSize = GDALGetRasterBandYSize(hTargetBand);
+    const size_t nSize = static_cast<size_t>(nXSize) * nYSize;
+
+    // Number of relaxation sweeps of the cascade on the finest level. It is
+    // doubled at each coarser level, which keeps the total cost at about
+    // twice the one of the finest level.
+    static constexpr int CASCADE_FINEST_LEVEL_SWEEPS = 4;
+    static constexpr int CASCADE_MAX_SWEEPS = 256;
+    static constexpr double CASCADE_OMEGA = 1.8;
+    static constexpr int V_CYCLES = 4;
+
+    std::vector<GDALFillNodataGrid> aoLevels(1);
+    std::vector<GByte> abyLine;
+    try
     {
-        const double dfDx =
-            static_cast<double>(target_x) - static_cast<double>(origin_x);
-        const double dfDy =
-            static_cast<double>(target_y) - static_cast<double>(origin_y);
-        double dfDistSq = dfDx * dfDx + dfDy * dfDy;
+        aoLevels[0].nXSize = nXSize;
+        aoLevels[0].nYSize = nYSize;
+        aoLevels[0].afValue.resize(nSize);
+        aoLevels[0].abyState.resize(nSize);
+        abyLine.resize(nXSize);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate buffers for INTERPOLATION=HARMONIC");
+        return CE_Failure;
+    }
 
-        if (dfDistSq < dfQuadDist * dfQuadDist)
+    /* -------------------------------------------------------------------- */
+    /*      Read data and mask.                                             */
+    /* -------------------------------------------------------------------- */
+    CPLErr eErr = GDALRasterIO(hTargetBand, GF_Read, 0, 0, nXSize, nYSize,
+                               aoLevels[0].afValue.data(), nXSize, nYSize,
+                               GDT_Float32, 0, 0);
+    if (eErr == CE_None)
+        eErr = GDALRasterIO(hMaskBand, GF_Read, 0, 0, nXSize, nYSize,
+                            aoLevels[0].abyState.data(), nXSize, nYSize,
+                            GDT_Byte, 0, 0);
+    if (eErr != CE_None)
+        return eErr;
+
+    for (size_t i = 0; i < nSize; i++)
+    {
+        GByte &nState = aoLevels[0].abyState[i];
+        if (nState == 0)
+            nState = GFN_FREE;
+        else if (bHasNoData && aoLevels[0].afValue[i] == fNoData)
+            nState = GFN_EXCLUDED;
+        else
+            nState = GFN_FIXED;
+    }
+
+    const bool bHasFree =
+        GDALFillNodataSelectReachable(aoLevels[0], dfMaxSearchDist);
+
+    if (!pfnProgress(0.1, "Filling...", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    if (bHasFree)
+    {
+        /* ---------------------------------------------------------------- */
+        /*      Build the pyramid.                                          */
+        /* ---------------------------------------------------------------- */
+        try
         {
-            CPLAssert(dfDistSq > 0.0);
-            dfQuadDist = sqrt(dfDistSq);
-            fQuadValue = fTargetValue;
+            while (std::max(aoLevels.back().nXSize, aoLevels.back().nYSize) >
+                   4)
+            {
+                GDALFillNodataGrid oCoarse;
+                GDALFillNodataCoarsen(aoLevels.back(), oCoarse);
+                aoLevels.push_back(std::move(oCoarse));
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate buffers for INTERPOLATION=HARMONIC");
+            return CE_Failure;
+        }
+        const int nLevels = static_cast<int>(aoLevels.size());
+
+        CPLWorkerThreadPool *poThreadPool =
+            nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+        auto poJobQueue =
+            poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+
+        /* ---------------------------------------------------------------- */
+        /*      Cascade from the coarsest level, initialized with the       */
+        /*      average of its sources.                                     */
+        /* ---------------------------------------------------------------- */
+        GDALFillNodataGrid &oCoarsest = aoLevels.back();
+        double dfSum = 0;
+        size_t nFixed = 0;
+        for (size_t i = 0; i < oCoarsest.afValue.size(); i++)
+        {
+            if (oCoarsest.abyState[i] == GFN_FIXED)
+            {
+                dfSum += oCoarsest.afValue[i];
+                nFixed++;
+            }
+        }
+        for (size_t i = 0; i < oCoarsest.afValue.size(); i++)
+        {
+            if (oCoarsest.abyState[i] == GFN_FREE)
+                oCoarsest.afValue[i] = static_cast<float>(dfSum / nFixed);
+        }
+
+        for (int iLevel = nLevels - 1; iLevel >= 0; iLevel--)
+        {
+            GDALFillNodataGrid &oGrid = aoLevels[iLevel];
+            if (iLevel < nLevels - 1)
+            {
+                GDALFillNodataProlongate(aoLevels[iLevel + 1], oGrid, false,
+                                         poJobQueue.get(), nThreads);
+            }
+            GDALFillNodataRelax(oGrid,
+                                iLevel == nLevels - 1
+                                    ? CASCADE_MAX_SWEEPS
+                                    : std::min(CASCADE_MAX_SWEEPS,
+                                               CASCADE_FINEST_LEVEL_SWEEPS
+                                                   << std::min(iLevel, 8)),
+                                CASCADE_OMEGA, poJobQueue.get(), nThreads);
+        }
+
+        if (!pfnProgress(0.3, "Filling...", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
         }
+
+        /* ---------------------------------------------------------------- */
+        /*      Refine with V-cycles. On coarse levels, sources now hold    */
+        /*      a zero correction.                                          */
+        /* ---------------------------------------------------------------- */
+        try
+        {
+            for (int iLevel = 1; iLevel < nLevels; iLevel++)
+            {
+                aoLevels[iLevel].afRhs.resize(aoLevels[iLevel].afValue.size());
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate buffers for INTERPOLATION=HARMONIC");
+            return CE_Failure;
+        }
+
+        for (int iCycle = 0; iCycle < V_CYCLES; iCycle++)
+        {
+            GDALFillNodataVCycle(aoLevels, 0, poJobQueue.get(), nThreads);
+
+            if (!pfnProgress(0.3 + 0.6 * (iCycle + 1) / V_CYCLES, "Filling...",
+                             pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return CE_Failure;
+            }
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Write out the updated data and mask information.                */
+    /* -------------------------------------------------------------------- */
+    const GDALFillNodataGrid &oGrid = aoLevels[0];
+    for (int iY = 0; iY < nYSize && eErr == CE_None; iY++)
+    {
+        const size_t nOffset = static_cast<size_t>(iY) * nXSize;
+        const GByte *pabyState = oGrid.abyState.data() + nOffset;
+        if (bHasFree)
+        {
+            eErr = GDALRasterIO(hTargetBand, GF_Write, 0, iY, nXSize, 1,
+                                const_cast<float *>(oGrid.afValue.data()) +
+                                    nOffset,
+                                nXSize, 1, GDT_Float32, 0, 0);
+        }
+
+        if (eErr == CE_None && bUpdateMask && bHasFree)
+        {
+            eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, 1,
+                                abyLine.data(), nXSize, 1, GDT_Byte, 0, 0);
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                if (pabyState[iX] == GFN_FREE)
+                    abyLine[iX] = 255;
+            }
+            if (eErr == CE_None)
+                eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iY, nXSize, 1,
+                                    abyLine.data(), nXSize, 1, GDT_Byte, 0, 0);
+        }
+
+        if (eErr == CE_None && hFiltMaskBand)
+        {
+            for (int iX = 0; iX < nXSize; iX++)
+                abyLine[iX] = pabyState[iX] == GFN_FREE ? 255 : 0;
+            eErr = GDALRasterIO(hFiltMaskBand, GF_Write, 0, iY, nXSize, 1,
+                                abyLine.data(), nXSize, 1, GDT_Byte, 0, 0);
+        }
+
+        if (eErr == CE_None &&
+            !pfnProgress(0.9 + 0.1 * (iY + 1) / static_cast<double>(nYSize),
+                         "Filling...", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                        GDALFillNodataSmooth()                        */
+/************************************************************************/
+
+static CPLErr GDALFillNodataSmooth(GDALRasterBandH hTargetBand,
+                                   GDALRasterBandH hMaskBand,
+                                   bool bFlushMaskBand,
+                                   GDALRasterBandH hFiltMaskBand,
+                                   int nSmoothingIterations, int nThreads,
+                                   double dfProgressRatio,
+                                   GDALProgressFunc pfnProgress,
+                                   void *pProgressArg)
+{
+    if (bFlushMaskBand)
+    {
+        // Force masks to be to flushed and recomputed when the user
+        // didn't pass a user-provided hMaskBand, and we assigned it
+        // to be the mask band of hTargetBand.
+        GDALFlushRasterCache(hMaskBand);
     }
+
+    void *pScaledProgress = GDALCreateScaledProgress(dfProgressRatio, 1.0,
+                                                     pfnProgress, pProgressArg);
+
+    const CPLErr eErr =
+        nThreads > 1
+            ? GDALMultiFilterMT(hTargetBand, hMaskBand, hFiltMaskBand,
+                                nSmoothingIterations, nThreads,
+                                GDALScaledProgress, pScaledProgress)
+            : GDALMultiFilter(hTargetBand, hMaskBand, hFiltMaskBand,
+                              nSmoothingIterations, GDALScaledProgress,
+                              pScaledProgress);
+
+    GDALDestroyScaledProgress(pScaledProgress);
+
+    return eErr;
 }
 
 /************************************************************************/
@@ -399,6 +1527,19 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
  * <li>NODATA=value (starting with GDAL 2.4).
  * Source pixels at that value will be ignored by the interpolator. Warning:
  * currently this will not be honored by smoothing passes.</li>
+ * <li>INTERPOLATION=INV_DIST/HARMONIC (GDAL >= 3.8). Defaults to INV_DIST,
+ * the four direction inverse distance weighting search. HARMONIC fills
+ * nodata areas with the solution of the Laplace equation whose boundary
+ * conditions are the surrounding valid pixels, computed with a multigrid
+ * solver. This gives smooth results even for large voids, without the cost
+ * of a large dfMaxSearchDist. In that mode, the pixels filled are the ones
+ * that can be reached from a valid pixel with a path of at most
+ * dfMaxSearchDist pixels (or of any length if dfMaxSearchDist is 0) through
+ * 4-connected nodata pixels, and the whole band is processed in memory
+ * (about 7 bytes per pixel).</li>
+ * <li>NUM_THREADS=n/ALL_CPUS (GDAL >= 3.8). Number of worker threads.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ * Results do not depend on the number of threads.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -420,6 +1561,9 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     const int nXSize = GDALGetRasterBandXSize(hTargetBand);
     const int nYSize = GDALGetRasterBandYSize(hTargetBand);
 
+    // 0 means unlimited. The HARMONIC mode handles it itself, as the paths
+    // through nodata pixels can be longer than the raster dimensions.
+    const double dfMaxSearchDistIn = dfMaxSearchDist;
     if (dfMaxSearchDist == 0.0)
         dfMaxSearchDist = std::max(nXSize, nYSize) + 1;
 
@@ -513,6 +1657,18 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         fNoData = static_cast<float>(CPLAtof(pszNoData));
     }
 
+    const char *pszInterpolation =
+        CSLFetchNameValueDef(papszOptions, "INTERPOLATION", "INV_DIST");
+    const bool bHarmonic = EQUAL(pszInterpolation, "HARMONIC");
+    if (!bHarmonic && !EQUAL(pszInterpolation, "INV_DIST"))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Unsupported value for INTERPOLATION: %s", pszInterpolation);
+        return CE_Failure;
+    }
+
+    const int nThreads = GDALGetNumThreads(papszOptions, true);
+
     /* -------------------------------------------------------------------- */
     /*      Initialize progress counter.                                    */
     /* -------------------------------------------------------------------- */
@@ -525,6 +1681,51 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         return CE_Failure;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Create a mask file to make it clear what pixels can be filtered */
+    /*      on the filtering pass.                                          */
+    /* -------------------------------------------------------------------- */
+    const CPLString osFiltMaskTmpFile = osTmpFile + "fill_filtmask_work.tif";
+
+    auto poFiltMaskDS = std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
+        GDALCreate(hDriver, osFiltMaskTmpFile, nXSize, nYSize, 1, GDT_Byte,
+                   aosWorkFileOptions.List())));
+
+    if (poFiltMaskDS == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not create mask work file. Check driver capabilities.");
+        return CE_Failure;
+    }
+    poFiltMaskDS->MarkSuppressOnClose();
+
+    GDALRasterBandH hFiltMaskBand =
+        GDALRasterBand::FromHandle(poFiltMaskDS->GetRasterBand(1));
+
+    /* -------------------------------------------------------------------- */
+    /*      Harmonic interpolation doesn't need the work files of the       */
+    /*      directional search.                                             */
+    /* -------------------------------------------------------------------- */
+    if (bHarmonic)
+    {
+        void *pScaledProgress = GDALCreateScaledProgress(
+            0.0, dfProgressRatio, pfnProgress, pProgressArg);
+        CPLErr eErr = GDALFillNodataHarmonic(
+            hTargetBand, hMaskBand, poTmpMaskDS != nullptr, hFiltMaskBand,
+            dfMaxSearchDistIn, bHasNoData, fNoData, nThreads,
+            GDALScaledProgress, pScaledProgress);
+        GDALDestroyScaledProgress(pScaledProgress);
+
+        if (eErr == CE_None && nSmoothingIterations > 0)
+        {
+            eErr = GDALFillNodataSmooth(
+                hTargetBand, hMaskBand, poTmpMaskDS == nullptr, hFiltMaskBand,
+                nSmoothingIterations, nThreads, dfProgressRatio, pfnProgress,
+                pProgressArg);
+        }
+        return eErr;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Create a work file to hold the Y "last value" indices.          */
     /* -------------------------------------------------------------------- */
@@ -570,52 +1771,48 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         GDALRasterBand::FromHandle(poValDS->GetRasterBand(1));
 
     /* -------------------------------------------------------------------- */
-    /*      Create a mask file to make it clear what pixels can be filtered */
-    /*      on the filtering pass.                                          */
-    /* -------------------------------------------------------------------- */
-    const CPLString osFiltMaskTmpFile = osTmpFile + "fill_filtmask_work.tif";
-
-    auto poFiltMaskDS = std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
-        GDALCreate(hDriver, osFiltMaskTmpFile, nXSize, nYSize, 1, GDT_Byte,
-                   aosWorkFileOptions.List())));
-
-    if (poFiltMaskDS == nullptr)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Could not create mask work file. Check driver capabilities.");
-        return CE_Failure;
-    }
-    poFiltMaskDS->MarkSuppressOnClose();
-
-    GDALRasterBandH hFiltMaskBand =
-        GDALRasterBand::FromHandle(poFiltMaskDS->GetRasterBand(1));
-
-    /* -------------------------------------------------------------------- */
-    /*      Allocate buffers for last scanline and this scanline.           */
+    /*      Allocate buffers for last scanline and this scanline, and for   */
+    /*      the batches of lines interpolated by the bottom to top pass.    */
     /* -------------------------------------------------------------------- */
+    const int nBatchLines =
+        std::max(std::min(nYSize, nThreads),
+                 GDALFillNodataLinesPerStrip(nXSize, nYSize,
+                                             5 * sizeof(float) + 2));
 
     GUInt32 *panLastY =
         static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
     GUInt32 *panThisY =
         static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
-    GUInt32 *panTopDownY =
-        static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
+    GUInt32 *panTopDownY = static_cast<GUInt32 *>(
+        VSI_MALLOC3_VERBOSE(nXSize, nBatchLines, sizeof(GUInt32)));
+    GUInt32 *panBottomUpY = static_cast<GUInt32 *>(
+        VSI_MALLOC3_VERBOSE(nXSize, nBatchLines, sizeof(GUInt32)));
     float *pafLastValue =
         static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
     float *pafThisValue =
         static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    float *pafTopDownValue =
-        static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    float *pafScanline =
-        static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    GByte *pabyMask = static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, 1));
-    GByte *pabyFiltMask = static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, 1));
+    float *pafTopDownValue = static_cast<float *>(
+        VSI_MALLOC3_VERBOSE(nXSize, nBatchLines, sizeof(float)));
+    float *pafBottomUpValue = static_cast<float *>(
+        VSI_MALLOC3_VERBOSE(nXSize, nBatchLines, sizeof(float)));
+    float *pafScanline = static_cast<float *>(
+        VSI_MALLOC3_VERBOSE(nXSize, nBatchLines, sizeof(float)));
+    GByte *pabyMask =
+        static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXSize, nBatchLines));
+    GByte *pabyFiltMask =
+        static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXSize, nBatchLines));
 
     CPLErr eErr = CE_None;
+    GDALFillNodataInterpolator oInterpolator;
+    std::vector<GDALFillNodataInterpolateJob> asJobs(nThreads);
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
 
     if (panLastY == nullptr || panThisY == nullptr || panTopDownY == nullptr ||
-        pafLastValue == nullptr || pafThisValue == nullptr ||
-        pafTopDownValue == nullptr || pafScanline == nullptr ||
+        panBottomUpY == nullptr || pafLastValue == nullptr ||
+        pafThisValue == nullptr || pafTopDownValue == nullptr ||
+        pafBottomUpValue == nullptr || pafScanline == nullptr ||
         pabyMask == nullptr || pabyFiltMask == nullptr)
     {
         eErr = CE_Failure;
@@ -722,44 +1919,50 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     /*      Now we will do collect similar this/last information from       */
     /*      bottom to top and use it in combination with the top to         */
     /*      bottom search info to interpolate.                              */
+    /*                                                                      */
+    /*      This is done by batches of lines. The bottom to top state of    */
+    /*      each column is cheap to propagate and is saved for each line    */
+    /*      of the batch, so that the interpolation of the lines, which     */
+    /*      dominates the processing time, can then be distributed among    */
+    /*      worker threads.                                                 */
     /* ==================================================================== */
-    for (int iY = nYSize - 1; iY >= 0 && eErr == CE_None; iY--)
+    oInterpolator.nXSize = nXSize;
+    oInterpolator.dfMaxSearchDist = dfMaxSearchDist;
+    oInterpolator.nMaxSearchDist = nMaxSearchDist;
+    oInterpolator.nNoDataVal = nNoDataVal;
+    oInterpolator.bHasNoData = bHasNoData;
+    oInterpolator.fNoData = fNoData;
+    oInterpolator.panTopDownY = panTopDownY;
+    oInterpolator.pafTopDownValue = pafTopDownValue;
+    oInterpolator.panBottomUpY = panBottomUpY;
+    oInterpolator.pafBottomUpValue = pafBottomUpValue;
+    oInterpolator.pafScanline = pafScanline;
+    oInterpolator.pabyMask = pabyMask;
+    oInterpolator.pabyFiltMask = pabyFiltMask;
+    for (int i = 0; i < nThreads; i++)
     {
-        eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, 1, pabyMask,
-                            nXSize, 1, GDT_Byte, 0, 0);
+        asJobs[i].poInterpolator = &oInterpolator;
+        asJobs[i].iFirstLine = i;
+        asJobs[i].nLineStep = nThreads;
+    }
 
-        if (eErr != CE_None)
-            break;
+    for (int iYEnd = nYSize; iYEnd > 0 && eErr == CE_None;
+         iYEnd -= nBatchLines)
+    {
+        const int iYStart = std::max(0, iYEnd - nBatchLines);
+        const int nLines = iYEnd - iYStart;
 
-        eErr = GDALRasterIO(hTargetBand, GF_Read, 0, iY, nXSize, 1, pafScanline,
-                            nXSize, 1, GDT_Float32, 0, 0);
+        eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iYStart, nXSize, nLines,
+                            pabyMask, nXSize, nLines, GDT_Byte, 0, 0);
 
         if (eErr != CE_None)
             break;
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Figure out the most recent pixel for each column. */
-        /* --------------------------------------------------------------------
-         */
+        eErr = GDALRasterIO(hTargetBand, GF_Read, 0, iYStart, nXSize, nLines,
+                            pafScanline, nXSize, nLines, GDT_Float32, 0, 0);
 
-        for (int iX = 0; iX < nXSize; iX++)
-        {
-            if (pabyMask[iX])
-            {
-                pafThisValue[iX] = pafScanline[iX];
-                panThisY[iX] = iY;
-            }
-            else if (panLastY[iX] - iY <= dfMaxSearchDist)
-            {
-                pafThisValue[iX] = pafLastValue[iX];
-                panThisY[iX] = panLastY[iX];
-            }
-            else
-            {
-                panThisY[iX] = nNoDataVal;
-            }
-        }
+        if (eErr != CE_None)
+            break;
 
         /* --------------------------------------------------------------------
          */
@@ -767,119 +1970,79 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
          */
         /* --------------------------------------------------------------------
          */
-        eErr = GDALRasterIO(hYBand, GF_Read, 0, iY, nXSize, 1, panTopDownY,
-                            nXSize, 1, GDT_UInt32, 0, 0);
+        eErr = GDALRasterIO(hYBand, GF_Read, 0, iYStart, nXSize, nLines,
+                            panTopDownY, nXSize, nLines, GDT_UInt32, 0, 0);
 
         if (eErr != CE_None)
             break;
 
-        eErr = GDALRasterIO(hValBand, GF_Read, 0, iY, nXSize, 1,
-                            pafTopDownValue, nXSize, 1, GDT_Float32, 0, 0);
+        eErr = GDALRasterIO(hValBand, GF_Read, 0, iYStart, nXSize, nLines,
+                            pafTopDownValue, nXSize, nLines, GDT_Float32, 0,
+                            0);
 
         if (eErr != CE_None)
             break;
 
         /* --------------------------------------------------------------------
          */
-        /*      Attempt to interpolate any pixels that are nodata. */
+        /*      Figure out the most recent pixel for each column, and save */
+        /*      the one of the line below for the interpolation. */
         /* --------------------------------------------------------------------
          */
-        memset(pabyFiltMask, 0, nXSize);
-        for (int iX = 0; iX < nXSize; iX++)
+        for (int iY = iYEnd - 1; iY >= iYStart; iY--)
         {
-            int nThisMaxSearchDist = nMaxSearchDist;
-
-            // If this was a valid target - no change.
-            if (pabyMask[iX])
-                continue;
-
-            // Quadrants 0:topleft, 1:bottomleft, 2:topright, 3:bottomright
-            double adfQuadDist[4] = {};
-            float fQuadValue[4] = {};
-
-            for (int iQuad = 0; iQuad < 4; iQuad++)
-            {
-                adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
-                fQuadValue[iQuad] = 0.0;
-            }
-
-            // Step left and right by one pixel searching for the closest
-            // target value for each quadrant.
-            for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
-            {
-                const int iLeftX = std::max(0, iX - iStep);
-                const int iRightX = std::min(nXSize - 1, iX + iStep);
-
-                // Top left includes current line.
-                QUAD_CHECK(adfQuadDist[0], fQuadValue[0], iLeftX,
-                           panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
-                           nNoDataVal);
-
-                // Bottom left.
-                QUAD_CHECK(adfQuadDist[1], fQuadValue[1], iLeftX,
-                           panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
-                           nNoDataVal);
-
-                // Top right and bottom right do no include center pixel.
-                if (iStep == 0)
-                    continue;
-
-                // Top right includes current line.
-                QUAD_CHECK(adfQuadDist[2], fQuadValue[2], iRightX,
-                           panTopDownY[iRightX], iX, iY,
-                           pafTopDownValue[iRightX], nNoDataVal);
-
-                // Bottom right.
-                QUAD_CHECK(adfQuadDist[3], fQuadValue[3], iRightX,
-                           panLastY[iRightX], iX, iY, pafLastValue[iRightX],
-                           nNoDataVal);
-
-                // Every four steps, recompute maximum distance.
-                if ((iStep & 0x3) == 0)
-                    nThisMaxSearchDist = static_cast<int>(floor(
-                        std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
-                                 std::max(adfQuadDist[2], adfQuadDist[3]))));
-            }
+            const size_t nOffset = static_cast<size_t>(iY - iYStart) * nXSize;
+            memcpy(panBottomUpY + nOffset, panLastY, sizeof(GUInt32) * nXSize);
+            memcpy(pafBottomUpValue + nOffset, pafLastValue,
+                   sizeof(float) * nXSize);
 
-            double dfWeightSum = 0.0;
-            double dfValueSum = 0.0;
-            bool bHasSrcValues = false;
-
-            for (int iQuad = 0; iQuad < 4; iQuad++)
+            for (int iX = 0; iX < nXSize; iX++)
             {
-                if (adfQuadDist[iQuad] <= dfMaxSearchDist)
+                if (pabyMask[nOffset + iX])
                 {
-                    bHasSrcValues = true;
-                    if (!bHasNoData || fQuadValue[iQuad] != fNoData)
-                    {
-                        const double dfWeight = 1.0 / adfQuadDist[iQuad];
-                        dfWeightSum += dfWeight;
-                        dfValueSum += fQuadValue[iQuad] * dfWeight;
-                    }
+                    pafThisValue[iX] = pafScanline[nOffset + iX];
+                    panThisY[iX] = iY;
                 }
-            }
-
-            if (bHasSrcValues)
-            {
-                pabyFiltMask[iX] = 255;
-                if (dfWeightSum > 0.0)
+                else if (panLastY[iX] - iY <= dfMaxSearchDist)
                 {
-                    pabyMask[iX] = 255;
-                    pafScanline[iX] =
-                        static_cast<float>(dfValueSum / dfWeightSum);
+                    pafThisValue[iX] = pafLastValue[iX];
+                    panThisY[iX] = panLastY[iX];
                 }
                 else
-                    pafScanline[iX] = fNoData;
+                {
+                    panThisY[iX] = nNoDataVal;
+                }
             }
+
+            std::swap(pafThisValue, pafLastValue);
+            std::swap(panThisY, panLastY);
+        }
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Attempt to interpolate any pixels that are nodata. */
+        /* --------------------------------------------------------------------
+         */
+        oInterpolator.nBatchYOff = iYStart;
+        oInterpolator.nBatchLines = nLines;
+        for (auto &sJob : asJobs)
+        {
+            if (poJobQueue)
+                poJobQueue->SubmitJob(GDALFillNodataInterpolateJobFunc,
+                                      &sJob);
+            else
+                GDALFillNodataInterpolateJobFunc(&sJob);
         }
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
 
         /* --------------------------------------------------------------------
          */
         /*      Write out the updated data and mask information. */
         /* --------------------------------------------------------------------
          */
-        eErr = GDALRasterIO(hTargetBand, GF_Write, 0, iY, nXSize, 1,
-                            pafScanline, nXSize, 1, GDT_Float32, 0, 0);
+        eErr = GDALRasterIO(hTargetBand, GF_Write, 0, iYStart, nXSize, nLines,
+                            pafScanline, nXSize, nLines, GDT_Float32, 0, 0);
 
         if (eErr != CE_None)
             break;
@@ -888,36 +2051,30 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         {
             // Update (copy of) mask band when it has been provided by the
             // user
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iY, nXSize, 1, pabyMask,
-                                nXSize, 1, GDT_Byte, 0, 0);
+            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iYStart, nXSize,
+                                nLines, pabyMask, nXSize, nLines, GDT_Byte, 0,
+                                0);
 
             if (eErr != CE_None)
                 break;
         }
 
-        eErr = GDALRasterIO(hFiltMaskBand, GF_Write, 0, iY, nXSize, 1,
-                            pabyFiltMask, nXSize, 1, GDT_Byte, 0, 0);
+        eErr = GDALRasterIO(hFiltMaskBand, GF_Write, 0, iYStart, nXSize,
+                            nLines, pabyFiltMask, nXSize, nLines, GDT_Byte, 0,
+                            0);
 
         if (eErr != CE_None)
             break;
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Flip this/last buffers. */
-        /* --------------------------------------------------------------------
-         */
-        std::swap(pafThisValue, pafLastValue);
-        std::swap(panThisY, panLastY);
-
         /* --------------------------------------------------------------------
          */
         /*      report progress. */
         /* --------------------------------------------------------------------
          */
-        if (!pfnProgress(
-                dfProgressRatio *
-                    (0.5 + 0.5 * (nYSize - iY) / static_cast<double>(nYSize)),
-                "Filling...", pProgressArg))
+        if (!pfnProgress(dfProgressRatio *
+                             (0.5 + 0.5 * (nYSize - iYStart) /
+                                        static_cast<double>(nYSize)),
+                         "Filling...", pProgressArg))
         {
             CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
             eErr = CE_Failure;
@@ -931,22 +2088,10 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     /* ==================================================================== */
     if (eErr == CE_None && nSmoothingIterations > 0)
     {
-        if (poTmpMaskDS == nullptr)
-        {
-            // Force masks to be to flushed and recomputed when the user
-            // didn't pass a user-provided hMaskBand, and we assigned it
-            // to be the mask band of hTargetBand.
-            GDALFlushRasterCache(hMaskBand);
-        }
-
-        void *pScaledProgress = GDALCreateScaledProgress(
-            dfProgressRatio, 1.0, pfnProgress, pProgressArg);
-
-        eErr = GDALMultiFilter(hTargetBand, hMaskBand, hFiltMaskBand,
-                               nSmoothingIterations, GDALScaledProgress,
-                               pScaledProgress);
-
-        GDALDestroyScaledProgress(pScaledProgress);
+        eErr = GDALFillNodataSmooth(hTargetBand, hMaskBand,
+                                    poTmpMaskDS == nullptr, hFiltMaskBand,
+                                    nSmoothingIterations, nThreads,
+                                    dfProgressRatio, pfnProgress, pProgressArg);
     }
 
 /* -------------------------------------------------------------------- */
@@ -956,9 +2101,11 @@ end:
     CPLFree(panLastY);
     CPLFree(panThisY);
     CPLFree(panTopDownY);
+    CPLFree(panBottomUpY);
     CPLFree(pafLastValue);
     CPLFree(pafThisValue);
     CPLFree(pafTopDownValue);
+    CPLFree(pafBottomUpValue);
     CPLFree(pafScanline);
     CPLFree(pabyMask);
     CPLFree(pabyFiltMask);
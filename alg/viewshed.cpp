@@ -29,18 +29,25 @@
 #include "gdal_alg.h"
 
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <array>
+#include <atomic>
 #include <limits>
 #include <algorithm>
+#include <memory>
+#include <mutex>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_spatialref.h"
 #include "ogr_core.h"
@@ -49,13 +56,13 @@
 CPL_CVSID("$Id$")
 
 inline static void SetVisibility(int iPixel, double dfZ, double dfZTarget,
-                                 double *padfZVal, std::vector<GByte> &vResult,
+                                 double *padfZVal, GByte *pabyResult,
                                  GByte byVisibleVal, GByte byInvisibleVal)
 {
     if (padfZVal[iPixel] + dfZTarget < dfZ)
-        vResult[iPixel] = byInvisibleVal;
+        pabyResult[iPixel] = byInvisibleVal;
     else
-        vResult[iPixel] = byVisibleVal;
+        pabyResult[iPixel] = byVisibleVal;
 
     if (padfZVal[iPixel] < dfZ)
         padfZVal[iPixel] = dfZ;
@@ -119,6 +126,304 @@ inline static double CalcHeight(double dfZ, double dfZ2, GDALViewshedMode eMode)
         return dfZ;
 }
 
+namespace
+{
+/** Parameters of the viewshed computation for one observer. */
+struct GDALViewshedContext
+{
+    const double *padfGeoTransform = nullptr;
+    int nX = 0;      // column of the observer, relative to nXStart
+    int nXSize = 0;  // width of the processed window
+    double dfZObserver = 0.0;
+    double dfTargetHeight = 0.0;
+    double dfDistance2 = 0.0;
+    double dfCurvCoeff = 0.0;
+    double dfSphereDiameter = 0.0;
+    double dfOutOfRangeVal = 0.0;
+    GDALViewshedMode eMode = GVM_Edge;
+    GDALViewshedOutputType heightMode = GVOT_NORMAL;
+    GByte byVisibleVal = 255;
+    GByte byInvisibleVal = 0;
+    GByte byOutOfRangeVal = 0;
+};
+}  // namespace
+
+/************************************************************************/
+/*                        GDALViewshedGetWindow()                       */
+/************************************************************************/
+
+/* Compute the position of the observer, and the window of the raster */
+/* within dfMaxDistance of it. */
+static bool GDALViewshedGetWindow(double *adfInvGeoTransform,
+                                  double dfObserverX, double dfObserverY,
+                                  double dfMaxDistance, int nRasterXSize,
+                                  int nRasterYSize, int &nX, int &nY,
+                                  int &nXStart, int &nXStop, int &nYStart,
+                                  int &nYStop)
+{
+    double dfX, dfY;
+    GDALApplyGeoTransform(adfInvGeoTransform, dfObserverX, dfObserverY, &dfX,
+                          &dfY);
+    nX = static_cast<int>(dfX);
+    nY = static_cast<int>(dfY);
+
+    if (nX < 0 || nX > nRasterXSize || nY < 0 || nY > nRasterYSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "The observer location falls outside of the DEM area");
+        return false;
+    }
+
+    /* calculate the area of interest */
+    nXStart =
+        dfMaxDistance > 0
+            ? (std::max)(0, static_cast<int>(std::floor(
+                                nX - adfInvGeoTransform[1] * dfMaxDistance)))
+            : 0;
+    nXStop =
+        dfMaxDistance > 0
+            ? (std::min)(nRasterXSize,
+                         static_cast<int>(std::ceil(nX + adfInvGeoTransform[1] *
+                                                             dfMaxDistance) +
+                                          1))
+            : nRasterXSize;
+    nYStart =
+        dfMaxDistance > 0
+            ? (std::max)(0, static_cast<int>(std::floor(
+                                nY + adfInvGeoTransform[5] * dfMaxDistance)))
+            : 0;
+    nYStop =
+        dfMaxDistance > 0
+            ? (std::min)(nRasterYSize,
+                         static_cast<int>(std::ceil(nY - adfInvGeoTransform[5] *
+                                                             dfMaxDistance) +
+                                          1))
+            : nRasterYSize;
+
+    if (nXStop - nXStart == 0 || nYStop - nYStart == 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Invalid target raster size");
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                    GDALViewshedGetSphereDiameter()                   */
+/************************************************************************/
+
+static double GDALViewshedGetSphereDiameter(const OGRSpatialReference *poSRS)
+{
+    /* If we can't get a SemiMajor axis from the SRS, it will be
+     * SRS_WGS84_SEMIMAJOR
+     */
+    double dfSphereDiameter(std::numeric_limits<double>::infinity());
+    if (poSRS)
+    {
+        OGRErr eSRSerr;
+        double dfSemiMajor = poSRS->GetSemiMajor(&eSRSerr);
+
+        /* If we fetched the axis from the SRS, use it */
+        if (eSRSerr != OGRERR_FAILURE)
+            dfSphereDiameter = dfSemiMajor * 2.0;
+        else
+            CPLDebug("GDALViewshedGenerate",
+                     "Unable to fetch SemiMajor axis from spatial reference");
+    }
+    return dfSphereDiameter;
+}
+
+/************************************************************************/
+/*                     GDALViewshedProcessFirstLine()                   */
+/************************************************************************/
+
+/* Process the line of the observer. padfFirstLineVal is modified, and */
+/* is the starting point of the upwards and downwards scans. */
+static void GDALViewshedProcessFirstLine(const GDALViewshedContext &oCtx,
+                                         double *padfFirstLineVal,
+                                         GByte *pabyResult,
+                                         double *dfHeightResult)
+{
+    const int nX = oCtx.nX;
+    const int nXSize = oCtx.nXSize;
+    const GDALViewshedOutputType heightMode = oCtx.heightMode;
+
+    /* mark the observer point as visible */
+    double dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                               ? padfFirstLineVal[nX]
+                               : 0.0;
+    pabyResult[nX] = oCtx.byVisibleVal;
+    if (heightMode != GVOT_NORMAL)
+        dfHeightResult[nX] = dfGroundLevel;
+
+    if (nX > 0)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                            ? padfFirstLineVal[nX - 1]
+                            : 0.0;
+        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
+            oCtx.padfGeoTransform, 1, 0, padfFirstLineVal[nX - 1],
+            oCtx.dfDistance2, oCtx.dfCurvCoeff, oCtx.dfSphereDiameter));
+        pabyResult[nX - 1] = oCtx.byVisibleVal;
+        if (heightMode != GVOT_NORMAL)
+            dfHeightResult[nX - 1] = dfGroundLevel;
+    }
+    if (nX < nXSize - 1)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                            ? padfFirstLineVal[nX + 1]
+                            : 0.0;
+        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
+            oCtx.padfGeoTransform, 1, 0, padfFirstLineVal[nX + 1],
+            oCtx.dfDistance2, oCtx.dfCurvCoeff, oCtx.dfSphereDiameter));
+        pabyResult[nX + 1] = oCtx.byVisibleVal;
+        if (heightMode != GVOT_NORMAL)
+            dfHeightResult[nX + 1] = dfGroundLevel;
+    }
+
+    /* process left, then right direction */
+    for (const int nStep : {-1, 1})
+    {
+        for (int iPixel = nX + 2 * nStep; iPixel >= 0 && iPixel < nXSize;
+             iPixel += nStep)
+        {
+            const int nDist = nStep < 0 ? nX - iPixel : iPixel - nX;
+            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                                ? padfFirstLineVal[iPixel]
+                                : 0.0;
+            bool adjusted = AdjustHeightInRange(
+                oCtx.padfGeoTransform, nDist, 0, padfFirstLineVal[iPixel],
+                oCtx.dfDistance2, oCtx.dfCurvCoeff, oCtx.dfSphereDiameter);
+            if (adjusted)
+            {
+                const double dfZ =
+                    CalcHeightLine(nDist, padfFirstLineVal[iPixel - nStep],
+                                   oCtx.dfZObserver);
+
+                if (heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = std::max(
+                        0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
+
+                SetVisibility(iPixel, dfZ, oCtx.dfTargetHeight,
+                              padfFirstLineVal, pabyResult, oCtx.byVisibleVal,
+                              oCtx.byInvisibleVal);
+            }
+            else
+            {
+                for (; iPixel >= 0 && iPixel < nXSize; iPixel += nStep)
+                {
+                    pabyResult[iPixel] = oCtx.byOutOfRangeVal;
+                    if (heightMode != GVOT_NORMAL)
+                        dfHeightResult[iPixel] = oCtx.dfOutOfRangeVal;
+                }
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GDALViewshedProcessLine()                      */
+/************************************************************************/
+
+/* Process the left (columns 0 to nX) or right (columns nX to nXSize - 1) */
+/* half of a line at nLineDist lines from the observer, given the */
+/* previous line of the scan in padfLastLineVal. */
+/* The two halves only share the observer column, that is computed by */
+/* both (in their own padfThisLineVal buffer), but only written to the */
+/* result by the left one. Hence the four quadrants around the observer */
+/* can be processed independently. */
+static void GDALViewshedProcessLine(const GDALViewshedContext &oCtx,
+                                    int nLineDist, bool bLeft,
+                                    double *padfThisLineVal,
+                                    const double *padfLastLineVal,
+                                    GByte *pabyResult, double *dfHeightResult)
+{
+    const int nX = oCtx.nX;
+    const int nXSize = oCtx.nXSize;
+    const GDALViewshedOutputType heightMode = oCtx.heightMode;
+    const GDALViewshedMode eMode = oCtx.eMode;
+    const double dfZObserver = oCtx.dfZObserver;
+    double dfZ = 0.0;
+
+    /* set up initial point on the scanline */
+    double dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                               ? padfThisLineVal[nX]
+                               : 0.0;
+    bool adjusted = AdjustHeightInRange(
+        oCtx.padfGeoTransform, 0, nLineDist, padfThisLineVal[nX],
+        oCtx.dfDistance2, oCtx.dfCurvCoeff, oCtx.dfSphereDiameter);
+    if (adjusted)
+    {
+        dfZ = CalcHeightLine(nLineDist, padfLastLineVal[nX], dfZObserver);
+
+        if (bLeft && heightMode != GVOT_NORMAL)
+            dfHeightResult[nX] =
+                std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+
+        GByte byUnused = 0;
+        SetVisibility(0, dfZ, oCtx.dfTargetHeight, padfThisLineVal + nX,
+                      bLeft ? pabyResult + nX : &byUnused, oCtx.byVisibleVal,
+                      oCtx.byInvisibleVal);
+    }
+    else if (bLeft)
+    {
+        pabyResult[nX] = oCtx.byOutOfRangeVal;
+        if (heightMode != GVOT_NORMAL)
+            dfHeightResult[nX] = oCtx.dfOutOfRangeVal;
+    }
+
+    /* process left or right direction */
+    const int nStep = bLeft ? -1 : 1;
+    for (int iPixel = nX + nStep; iPixel >= 0 && iPixel < nXSize;
+         iPixel += nStep)
+    {
+        const int nDist = bLeft ? nX - iPixel : iPixel - nX;
+        const int iPrev = iPixel - nStep;
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                            ? padfThisLineVal[iPixel]
+                            : 0.0;
+        bool pixel_adjusted = AdjustHeightInRange(
+            oCtx.padfGeoTransform, nDist, nLineDist, padfThisLineVal[iPixel],
+            oCtx.dfDistance2, oCtx.dfCurvCoeff, oCtx.dfSphereDiameter);
+        if (pixel_adjusted)
+        {
+            if (eMode != GVM_Edge)
+                dfZ = CalcHeightDiagonal(nDist, nLineDist,
+                                         padfThisLineVal[iPrev],
+                                         padfLastLineVal[iPixel], dfZObserver);
+
+            if (eMode != GVM_Diagonal)
+            {
+                double dfZ2 =
+                    nDist >= nLineDist
+                        ? CalcHeightEdge(nLineDist, nDist,
+                                         padfLastLineVal[iPrev],
+                                         padfThisLineVal[iPrev], dfZObserver)
+                        : CalcHeightEdge(nDist, nLineDist,
+                                         padfLastLineVal[iPrev],
+                                         padfLastLineVal[iPixel], dfZObserver);
+                dfZ = CalcHeight(dfZ, dfZ2, eMode);
+            }
+
+            if (heightMode != GVOT_NORMAL)
+                dfHeightResult[iPixel] = std::max(
+                    0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+
+            SetVisibility(iPixel, dfZ, oCtx.dfTargetHeight, padfThisLineVal,
+                          pabyResult, oCtx.byVisibleVal, oCtx.byInvisibleVal);
+        }
+        else
+        {
+            for (; iPixel >= 0 && iPixel < nXSize; iPixel += nStep)
+            {
+                pabyResult[iPixel] = oCtx.byOutOfRangeVal;
+                if (heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = oCtx.dfOutOfRangeVal;
+            }
+        }
+    }
+}
+
 /************************************************************************/
 /*                        GDALViewshedGenerate()                         */
 /************************************************************************/
@@ -203,7 +508,12 @@ inline static double CalcHeight(double dfZ, double dfZ2, GDALViewshedMode eMode)
  * and dfInvisibleVal will be ignored.
  *
  *
- * @param papszExtraOptions Future extra options. Must be set to NULL currently.
+ * @param papszExtraOptions Extra options. Supported options are:
+ * <ul>
+ * <li>NUM_THREADS=n/ALL_CPUS: (GDAL >= 3.8) Number of threads used to
+ * process concurrently the four quadrants around the observer. Defaults to
+ * the value of the GDAL_NUM_THREADS configuration option, or 1.</li>
+ * </ul>
  *
  * @return not NULL output dataset on success (to be closed with GDALClose()) or
  * NULL if an error occurs.
@@ -266,76 +576,70 @@ GDALDatasetH GDALViewshedGenerate(
         return nullptr;
     }
 
-    /* calculate observer position */
-    double dfX, dfY;
-    GDALApplyGeoTransform(adfInvGeoTransform, dfObserverX, dfObserverY, &dfX,
-                          &dfY);
-    int nX = static_cast<int>(dfX);
-    int nY = static_cast<int>(dfY);
-
-    int nXSize = GDALGetRasterBandXSize(hBand);
-    int nYSize = GDALGetRasterBandYSize(hBand);
-
-    if (nX < 0 || nX > nXSize || nY < 0 || nY > nYSize)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "The observer location falls outside of the DEM area");
+    /* calculate observer position and the area of interest */
+    int nX, nY, nXStart, nXStop, nYStart, nYStop;
+    if (!GDALViewshedGetWindow(adfInvGeoTransform, dfObserverX, dfObserverY,
+                               dfMaxDistance, GDALGetRasterBandXSize(hBand),
+                               GDALGetRasterBandYSize(hBand), nX, nY, nXStart,
+                               nXStop, nYStart, nYStop))
         return nullptr;
-    }
-
-    /* calculate the area of interest */
-    int nXStart =
-        dfMaxDistance > 0
-            ? (std::max)(0, static_cast<int>(std::floor(
-                                nX - adfInvGeoTransform[1] * dfMaxDistance)))
-            : 0;
-    int nXStop =
-        dfMaxDistance > 0
-            ? (std::min)(nXSize,
-                         static_cast<int>(std::ceil(nX + adfInvGeoTransform[1] *
-                                                             dfMaxDistance) +
-                                          1))
-            : nXSize;
-    int nYStart =
-        dfMaxDistance > 0
-            ? (std::max)(0, static_cast<int>(std::floor(
-                                nY + adfInvGeoTransform[5] * dfMaxDistance)))
-            : 0;
-    int nYStop =
-        dfMaxDistance > 0
-            ? (std::min)(nYSize,
-                         static_cast<int>(std::ceil(nY - adfInvGeoTransform[5] *
-                                                             dfMaxDistance) +
-                                          1))
-            : nYSize;
 
     /* normalize horizontal index (0 - nXSize) */
-    nXSize = nXStop - nXStart;
+    const int nXSize = nXStop - nXStart;
     nX -= nXStart;
 
-    nYSize = nYStop - nYStart;
-
-    if (nXSize == 0 || nYSize == 0)
+    const int nYSize = nYStop - nYStart;
+
+    /* -------------------------------------------------------------------- */
+    /*      Lines are processed by batches, read in advance, in which the   */
+    /*      four quadrants around the observer are computed concurrently.   */
+    /* -------------------------------------------------------------------- */
+    const int nLinesUp = nY - nYStart;
+    const int nLinesDown = nYStop - nY - 1;
+    const size_t nResultSize =
+        sizeof(GByte) + (heightMode != GVOT_NORMAL ? sizeof(double) : 0);
+    constexpr int MAX_BYTES_PER_BATCH = 16 * 1024 * 1024;
+    const int nBatchLines = static_cast<int>(std::max<GIntBig>(
+        1, std::min<GIntBig>(std::max(nLinesUp, nLinesDown),
+                             MAX_BYTES_PER_BATCH /
+                                 (2 * static_cast<GIntBig>(nXSize) *
+                                  (sizeof(double) + nResultSize)))));
+    const int nThreads = GDALGetNumThreads(papszExtraOptions, true);
+
+    struct Quadrant
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "Invalid target raster size");
-        return nullptr;
-    }
+        const GDALViewshedContext *poCtx = nullptr;
+        bool bUp = false;
+        bool bLeft = false;
+        std::vector<double> adfLastLineVal{};
+        std::vector<double> adfThisLineVal{};
+        // Current batch
+        int nFirstLineDist = 0;
+        int nLines = 0;
+        const double *padfDEM = nullptr;
+        GByte *pabyResult = nullptr;
+        double *padfHeightResult = nullptr;
+    };
 
     std::vector<double> vFirstLineVal;
-    std::vector<double> vLastLineVal;
-    std::vector<double> vThisLineVal;
     std::vector<GByte> vResult;
     std::vector<double> vHeightResult;
+    std::vector<double> vBatchDEM;
+    std::array<Quadrant, 4> aoQuadrants;
 
     try
     {
         vFirstLineVal.resize(nXSize);
-        vLastLineVal.resize(nXSize);
-        vThisLineVal.resize(nXSize);
-        vResult.resize(nXSize);
-
+        vBatchDEM.resize(2 * static_cast<size_t>(nBatchLines) * nXSize);
+        vResult.resize(2 * static_cast<size_t>(nBatchLines) * nXSize);
         if (heightMode != GVOT_NORMAL)
-            vHeightResult.resize(nXSize);
+            vHeightResult.resize(2 * static_cast<size_t>(nBatchLines) *
+                                 nXSize);
+        for (auto &oQuadrant : aoQuadrants)
+        {
+            oQuadrant.adfLastLineVal.resize(nXSize);
+            oQuadrant.adfThisLineVal.resize(nXSize);
+        }
     }
     catch (...)
     {
@@ -345,8 +649,6 @@ GDALDatasetH GDALViewshedGenerate(
     }
 
     double *padfFirstLineVal = vFirstLineVal.data();
-    double *padfLastLineVal = vLastLineVal.data();
-    double *padfThisLineVal = vThisLineVal.data();
     GByte *pabyResult = vResult.data();
     double *dfHeightResult = vHeightResult.data();
 
@@ -409,123 +711,26 @@ GDALDatasetH GDALViewshedGenerate(
         return nullptr;
     }
 
-    const double dfZObserver = dfObserverHeight + padfFirstLineVal[nX];
-    double dfZ = 0.0;
-    const double dfDistance2 = dfMaxDistance * dfMaxDistance;
-
-    /* If we can't get a SemiMajor axis from the SRS, it will be
-     * SRS_WGS84_SEMIMAJOR
-     */
-    double dfSphereDiameter(std::numeric_limits<double>::infinity());
-    const OGRSpatialReference *poDstSRS = poDstDS->GetSpatialRef();
-    if (poDstSRS)
-    {
-        OGRErr eSRSerr;
-        double dfSemiMajor = poDstSRS->GetSemiMajor(&eSRSerr);
-
-        /* If we fetched the axis from the SRS, use it */
-        if (eSRSerr != OGRERR_FAILURE)
-            dfSphereDiameter = dfSemiMajor * 2.0;
-        else
-            CPLDebug("GDALViewshedGenerate",
-                     "Unable to fetch SemiMajor axis from spatial reference");
-    }
-
-    /* mark the observer point as visible */
-    double dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                               ? padfFirstLineVal[nX]
-                               : 0.0;
-    pabyResult[nX] = byVisibleVal;
-    if (heightMode != GVOT_NORMAL)
-        dfHeightResult[nX] = dfGroundLevel;
-
-    if (nX > 0)
-    {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfFirstLineVal[nX - 1]
-                            : 0.0;
-        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
-            adfGeoTransform.data(), 1, 0, padfFirstLineVal[nX - 1], dfDistance2,
-            dfCurvCoeff, dfSphereDiameter));
-        pabyResult[nX - 1] = byVisibleVal;
-        if (heightMode != GVOT_NORMAL)
-            dfHeightResult[nX - 1] = dfGroundLevel;
-    }
-    if (nX < nXSize - 1)
-    {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfFirstLineVal[nX + 1]
-                            : 0.0;
-        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
-            adfGeoTransform.data(), 1, 0, padfFirstLineVal[nX + 1], dfDistance2,
-            dfCurvCoeff, dfSphereDiameter));
-        pabyResult[nX + 1] = byVisibleVal;
-        if (heightMode != GVOT_NORMAL)
-            dfHeightResult[nX + 1] = dfGroundLevel;
-    }
-
-    /* process left direction */
-    for (int iPixel = nX - 2; iPixel >= 0; iPixel--)
-    {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfFirstLineVal[iPixel]
-                            : 0.0;
-        bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), nX - iPixel, 0, padfFirstLineVal[iPixel],
-            dfDistance2, dfCurvCoeff, dfSphereDiameter);
-        if (adjusted)
-        {
-            dfZ = CalcHeightLine(nX - iPixel, padfFirstLineVal[iPixel + 1],
-                                 dfZObserver);
-
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[iPixel] = std::max(
-                    0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
-
-            SetVisibility(iPixel, dfZ, dfTargetHeight, padfFirstLineVal,
-                          vResult, byVisibleVal, byInvisibleVal);
-        }
-        else
-        {
-            for (; iPixel >= 0; iPixel--)
-            {
-                pabyResult[iPixel] = byOutOfRangeVal;
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = dfOutOfRangeVal;
-            }
-        }
-    }
-    /* process right direction */
-    for (int iPixel = nX + 2; iPixel < nXSize; iPixel++)
-    {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfFirstLineVal[iPixel]
-                            : 0.0;
-        bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), iPixel - nX, 0, padfFirstLineVal[iPixel],
-            dfDistance2, dfCurvCoeff, dfSphereDiameter);
-        if (adjusted)
-        {
-            dfZ = CalcHeightLine(iPixel - nX, padfFirstLineVal[iPixel - 1],
-                                 dfZObserver);
+    GDALViewshedContext oCtx;
+    oCtx.padfGeoTransform = adfGeoTransform.data();
+    oCtx.nX = nX;
+    oCtx.nXSize = nXSize;
+    oCtx.dfZObserver = dfObserverHeight + padfFirstLineVal[nX];
+    oCtx.dfTargetHeight = dfTargetHeight;
+    oCtx.dfDistance2 = dfMaxDistance * dfMaxDistance;
+    oCtx.dfCurvCoeff = dfCurvCoeff;
+    oCtx.dfSphereDiameter =
+        GDALViewshedGetSphereDiameter(poDstDS->GetSpatialRef());
+    oCtx.dfOutOfRangeVal = dfOutOfRangeVal;
+    oCtx.eMode = eMode;
+    oCtx.heightMode = heightMode;
+    oCtx.byVisibleVal = byVisibleVal;
+    oCtx.byInvisibleVal = byInvisibleVal;
+    oCtx.byOutOfRangeVal = byOutOfRangeVal;
+
+    GDALViewshedProcessFirstLine(oCtx, padfFirstLineVal, pabyResult,
+                                 dfHeightResult);
 
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[iPixel] = std::max(
-                    0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
-
-            SetVisibility(iPixel, dfZ, dfTargetHeight, padfFirstLineVal,
-                          vResult, byVisibleVal, byInvisibleVal);
-        }
-        else
-        {
-            for (; iPixel < nXSize; iPixel++)
-            {
-                pabyResult[iPixel] = byOutOfRangeVal;
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = dfOutOfRangeVal;
-            }
-        }
-    }
     /* write result line */
 
     if (GDALRasterIO(hTargetBand, GF_Write, 0, nY - nYStart, nXSize, 1,
@@ -542,325 +747,587 @@ GDALDatasetH GDALViewshedGenerate(
         return nullptr;
     }
 
-    /* scan upwards */
-    std::copy(vFirstLineVal.begin(), vFirstLineVal.end(), vLastLineVal.begin());
-    for (int iLine = nY - 1; iLine >= nYStart; iLine--)
+    /* -------------------------------------------------------------------- */
+    /*      Scan upwards and downwards.                                     */
+    /* -------------------------------------------------------------------- */
+    for (int i = 0; i < 4; i++)
     {
-        if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXSize, 1,
-                         padfThisLineVal, nXSize, 1, GDT_Float64, 0, 0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when reading DEM at position (%d,%d), "
-                     "size (%d,%d)",
-                     nXStart, iLine, nXSize, 1);
-            return nullptr;
-        }
-
-        /* set up initial point on the scanline */
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfThisLineVal[nX]
-                            : 0.0;
-        bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), 0, nY - iLine, padfThisLineVal[nX],
-            dfDistance2, dfCurvCoeff, dfSphereDiameter);
-        if (adjusted)
-        {
-            dfZ = CalcHeightLine(nY - iLine, padfLastLineVal[nX], dfZObserver);
-
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] =
-                    std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+        Quadrant &oQuadrant = aoQuadrants[i];
+        oQuadrant.poCtx = &oCtx;
+        oQuadrant.bUp = i < 2;
+        oQuadrant.bLeft = (i % 2) == 0;
+        std::copy(vFirstLineVal.begin(), vFirstLineVal.end(),
+                  oQuadrant.adfLastLineVal.begin());
+    }
 
-            SetVisibility(nX, dfZ, dfTargetHeight, padfThisLineVal, vResult,
-                          byVisibleVal, byInvisibleVal);
-        }
-        else
+    const auto ProcessQuadrant = [](void *pData)
+    {
+        Quadrant *poQuadrant = static_cast<Quadrant *>(pData);
+        const GDALViewshedContext &oQCtx = *(poQuadrant->poCtx);
+        const int nQXSize = oQCtx.nXSize;
+        // Columns of the quadrant, including the one of the observer
+        const int nColStart = poQuadrant->bLeft ? 0 : oQCtx.nX;
+        const int nColEnd =
+            poQuadrant->bLeft ? std::min(oQCtx.nX + 1, nQXSize) : nQXSize;
+        for (int i = 0; i < poQuadrant->nLines; i++)
         {
-            pabyResult[nX] = byOutOfRangeVal;
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] = dfOutOfRangeVal;
+            const size_t nOffset = static_cast<size_t>(i) * nQXSize;
+            std::copy(poQuadrant->padfDEM + nOffset + nColStart,
+                      poQuadrant->padfDEM + nOffset + nColEnd,
+                      poQuadrant->adfThisLineVal.begin() + nColStart);
+            GDALViewshedProcessLine(
+                oQCtx, poQuadrant->nFirstLineDist + i, poQuadrant->bLeft,
+                poQuadrant->adfThisLineVal.data(),
+                poQuadrant->adfLastLineVal.data(),
+                poQuadrant->pabyResult + nOffset,
+                poQuadrant->padfHeightResult
+                    ? poQuadrant->padfHeightResult + nOffset
+                    : nullptr);
+            std::swap(poQuadrant->adfLastLineVal, poQuadrant->adfThisLineVal);
         }
+    };
 
-        /* process left direction */
-        for (int iPixel = nX - 1; iPixel >= 0; iPixel--)
-        {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                                ? padfThisLineVal[iPixel]
-                                : 0.0;
-            bool left_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), nX - iPixel,
-                                    nY - iLine, padfThisLineVal[iPixel],
-                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
-            if (left_adjusted)
-            {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(
-                        nX - iPixel, nY - iLine, padfThisLineVal[iPixel + 1],
-                        padfLastLineVal[iPixel], dfZObserver);
-
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 =
-                        nX - iPixel >= nY - iLine
-                            ? CalcHeightEdge(nY - iLine, nX - iPixel,
-                                             padfLastLineVal[iPixel + 1],
-                                             padfThisLineVal[iPixel + 1],
-                                             dfZObserver)
-                            : CalcHeightEdge(nX - iPixel, nY - iLine,
-                                             padfLastLineVal[iPixel + 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
 
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+    const size_t nBatchSize = static_cast<size_t>(nBatchLines) * nXSize;
+    for (int nLineDist = 1; nLineDist <= std::max(nLinesUp, nLinesDown);
+         nLineDist += nBatchLines)
+    {
+        const int anLines[2] = {
+            std::max(0, std::min(nBatchLines, nLinesUp - nLineDist + 1)),
+            std::max(0, std::min(nBatchLines, nLinesDown - nLineDist + 1))};
 
-                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
-                              vResult, byVisibleVal, byInvisibleVal);
-            }
-            else
+        for (int iDir = 0; iDir < 2; iDir++)
+        {
+            for (int i = 0; i < anLines[iDir]; i++)
             {
-                for (; iPixel >= 0; iPixel--)
+                const int iLine =
+                    iDir == 0 ? nY - (nLineDist + i) : nY + (nLineDist + i);
+                if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXSize, 1,
+                                 vBatchDEM.data() + iDir * nBatchSize +
+                                     static_cast<size_t>(i) * nXSize,
+                                 nXSize, 1, GDT_Float64, 0, 0))
                 {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if (heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "RasterIO error when reading DEM at position "
+                             "(%d,%d), size (%d,%d)",
+                             nXStart, iLine, nXSize, 1);
+                    return nullptr;
                 }
             }
         }
-        /* process right direction */
-        for (int iPixel = nX + 1; iPixel < nXSize; iPixel++)
-        {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                                ? padfThisLineVal[iPixel]
-                                : 0.0;
-            bool right_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), iPixel - nX,
-                                    nY - iLine, padfThisLineVal[iPixel],
-                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
-            if (right_adjusted)
-            {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(
-                        iPixel - nX, nY - iLine, padfThisLineVal[iPixel - 1],
-                        padfLastLineVal[iPixel], dfZObserver);
-
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 =
-                        iPixel - nX >= nY - iLine
-                            ? CalcHeightEdge(nY - iLine, iPixel - nX,
-                                             padfLastLineVal[iPixel - 1],
-                                             padfThisLineVal[iPixel - 1],
-                                             dfZObserver)
-                            : CalcHeightEdge(iPixel - nX, nY - iLine,
-                                             padfLastLineVal[iPixel - 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
 
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+        for (auto &oQuadrant : aoQuadrants)
+        {
+            const int iDir = oQuadrant.bUp ? 0 : 1;
+            oQuadrant.nFirstLineDist = nLineDist;
+            oQuadrant.nLines = anLines[iDir];
+            oQuadrant.padfDEM = vBatchDEM.data() + iDir * nBatchSize;
+            oQuadrant.pabyResult = pabyResult + iDir * nBatchSize;
+            oQuadrant.padfHeightResult =
+                dfHeightResult ? dfHeightResult + iDir * nBatchSize : nullptr;
+            if (oQuadrant.nLines == 0)
+                continue;
+            if (!poQueue || !poQueue->SubmitJob(ProcessQuadrant, &oQuadrant))
+                ProcessQuadrant(&oQuadrant);
+        }
+        if (poQueue)
+            poQueue->WaitCompletion();
 
-                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
-                              vResult, byVisibleVal, byInvisibleVal);
-            }
-            else
+        /* write result lines */
+        for (int iDir = 0; iDir < 2; iDir++)
+        {
+            for (int i = 0; i < anLines[iDir]; i++)
             {
-                for (; iPixel < nXSize; iPixel++)
+                const int iLine =
+                    iDir == 0 ? nY - (nLineDist + i) : nY + (nLineDist + i);
+                const size_t nOffset =
+                    iDir * nBatchSize + static_cast<size_t>(i) * nXSize;
+                if (GDALRasterIO(
+                        hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
+                        heightMode != GVOT_NORMAL
+                            ? static_cast<void *>(dfHeightResult + nOffset)
+                            : static_cast<void *>(pabyResult + nOffset),
+                        nXSize, 1,
+                        heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte, 0,
+                        0))
                 {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if (heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "RasterIO error when writing target raster at "
+                             "position (%d,%d), size (%d,%d)",
+                             0, iLine - nYStart, nXSize, 1);
+                    return nullptr;
                 }
             }
         }
 
-        /* write result line */
-        if (GDALRasterIO(
-                hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
-                heightMode != GVOT_NORMAL ? static_cast<void *>(dfHeightResult)
-                                          : static_cast<void *>(pabyResult),
-                nXSize, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte,
-                0, 0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when writing target raster at position "
-                     "(%d,%d), size (%d,%d)",
-                     0, iLine - nYStart, nXSize, 1);
-            return nullptr;
-        }
-
-        std::swap(padfLastLineVal, padfThisLineVal);
-
-        if (!pfnProgress((nY - iLine) / static_cast<double>(nYSize), "",
+        const int nLinesDone =
+            1 + std::min(nLinesUp, nLineDist - 1 + anLines[0]) +
+            std::min(nLinesDown, nLineDist - 1 + anLines[1]);
+        if (!pfnProgress(nLinesDone / static_cast<double>(nYSize), "",
                          pProgressArg))
         {
             CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
             return nullptr;
         }
     }
-    /* scan downwards */
-    memcpy(padfLastLineVal, padfFirstLineVal, nXSize * sizeof(double));
-    for (int iLine = nY + 1; iLine < nYStop; iLine++)
+
+    if (!pfnProgress(1.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
+
+    return GDALDataset::FromHandle(poDstDS.release());
+}
+
+/************************************************************************/
+/*                   GDALViewshedGenerateCumulative()                   */
+/************************************************************************/
+
+/**
+ * Create a cumulative viewshed from raster DEM and several observers.
+ *
+ * For each pixel of the DEM, the output raster counts the number of observers
+ * from which a target at dfTargetHeight above the DEM surface is visible. The
+ * visibility from each observer is computed as with GDALViewshedGenerate()
+ * in GVOT_NORMAL mode.
+ *
+ * The part of the DEM within dfMaxDistance of any observer is read only once,
+ * and kept in memory (8 bytes per pixel, plus 4 bytes per pixel for the
+ * counts), so that observers can be processed in parallel without reading
+ * the DEM again.
+ *
+ * @param hBand The band to read the DEM data from.
+ *
+ * @param pszDriverName Driver name (GTiff if set to NULL)
+ *
+ * @param pszTargetRasterName The name of the target raster to be generated.
+ * Must not be NULL. The target raster is of type UInt32, and has the same
+ * dimensions and georeferencing as the DEM.
+ *
+ * @param papszCreationOptions creation options.
+ *
+ * @param nObservers Number of observers.
+ *
+ * @param padfObserverX Array of nObservers observer X values (in SRS units)
+ *
+ * @param padfObserverY Array of nObservers observer Y values (in SRS units)
+ *
+ * @param dfObserverHeight The height of the observers above the DEM surface.
+ *
+ * @param dfTargetHeight The height of the target above the DEM surface.
+ *
+ * @param dfCurvCoeff Coefficient to consider the effect of the curvature and
+ * refraction. See GDALViewshedGenerate().
+ *
+ * @param eMode The mode of the viewshed calculation.
+ * Possible values GVM_Diagonal = 1, GVM_Edge = 2 (default), GVM_Max = 3,
+ * GVM_Min = 4.
+ *
+ * @param dfMaxDistance maximum distance range to compute the viewshed of each
+ * observer. If set to 0, then unlimited range is assumed.
+ *
+ * @param pfnProgress A GDALProgressFunc that may be used to report progress
+ * to the user, or to interrupt the algorithm.  May be NULL if not required.
+ *
+ * @param pProgressArg The callback data for the pfnProgress function.
+ *
+ * @param papszExtraOptions Extra options. Supported options are:
+ * <ul>
+ * <li>NUM_THREADS=n/ALL_CPUS: Number of threads used to process observers.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ * </li>
+ * </ul>
+ *
+ * @return not NULL output dataset on success (to be closed with GDALClose()) or
+ * NULL if an error occurs.
+ *
+ * @since GDAL 3.8
+ */
+
+GDALDatasetH GDALViewshedGenerateCumulative(
+    GDALRasterBandH hBand, const char *pszDriverName,
+    const char *pszTargetRasterName, CSLConstList papszCreationOptions,
+    int nObservers, const double *padfObserverX, const double *padfObserverY,
+    double dfObserverHeight, double dfTargetHeight, double dfCurvCoeff,
+    GDALViewshedMode eMode, double dfMaxDistance, GDALProgressFunc pfnProgress,
+    void *pProgressArg, CSLConstList papszExtraOptions)
+{
+    VALIDATE_POINTER1(hBand, "GDALViewshedGenerateCumulative", nullptr);
+    VALIDATE_POINTER1(pszTargetRasterName, "GDALViewshedGenerateCumulative",
+                      nullptr);
+    if (nObservers > 0)
+    {
+        VALIDATE_POINTER1(padfObserverX, "GDALViewshedGenerateCumulative",
+                          nullptr);
+        VALIDATE_POINTER1(padfObserverY, "GDALViewshedGenerateCumulative",
+                          nullptr);
+    }
+
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    if (!pfnProgress(0.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
+
+    /* set up geotransformation */
+    std::array<double, 6> adfGeoTransform{{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
+    GDALDatasetH hSrcDS = GDALGetBandDataset(hBand);
+    if (hSrcDS != nullptr)
+        GDALGetGeoTransform(hSrcDS, adfGeoTransform.data());
+
+    double adfInvGeoTransform[6];
+    if (!GDALInvGeoTransform(adfGeoTransform.data(), adfInvGeoTransform))
     {
-        if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXStop - nXStart, 1,
-                         padfThisLineVal, nXStop - nXStart, 1, GDT_Float64, 0,
-                         0))
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot invert geotransform");
+        return nullptr;
+    }
+
+    const int nRasterXSize = GDALGetRasterBandXSize(hBand);
+    const int nRasterYSize = GDALGetRasterBandYSize(hBand);
+
+    /* -------------------------------------------------------------------- */
+    /*      Compute the area of interest of each observer, and their        */
+    /*      union.                                                          */
+    /* -------------------------------------------------------------------- */
+    struct Observer
+    {
+        int nX;
+        int nY;
+        int nXStart;
+        int nXStop;
+        int nYStart;
+        int nYStop;
+    };
+
+    std::vector<Observer> aoObservers;
+    int nXOff = nRasterXSize;
+    int nYOff = nRasterYSize;
+    int nXEnd = 0;
+    int nYEnd = 0;
+    for (int i = 0; i < nObservers; i++)
+    {
+        Observer oObs;
+        if (!GDALViewshedGetWindow(adfInvGeoTransform, padfObserverX[i],
+                                   padfObserverY[i], dfMaxDistance,
+                                   nRasterXSize, nRasterYSize, oObs.nX,
+                                   oObs.nY, oObs.nXStart, oObs.nXStop,
+                                   oObs.nYStart, oObs.nYStop))
+            return nullptr;
+        if (oObs.nX >= nRasterXSize || oObs.nY >= nRasterYSize)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when reading DEM at position (%d,%d), "
-                     "size (%d,%d)",
-                     nXStart, iLine, nXStop - nXStart, 1);
+                     "The observer location falls outside of the DEM area");
             return nullptr;
         }
+        nXOff = std::min(nXOff, oObs.nXStart);
+        nYOff = std::min(nYOff, oObs.nYStart);
+        nXEnd = std::max(nXEnd, oObs.nXStop);
+        nYEnd = std::max(nYEnd, oObs.nYStop);
+        aoObservers.push_back(oObs);
+    }
+    const int nWinXSize = std::max(0, nXEnd - nXOff);
+    const int nWinYSize = std::max(0, nYEnd - nYOff);
+
+    /* -------------------------------------------------------------------- */
+    /*      Read the DEM.                                                   */
+    /* -------------------------------------------------------------------- */
+    const size_t nWinPixels = static_cast<size_t>(nWinXSize) * nWinYSize;
+    std::vector<double> adfDEM;
+    try
+    {
+        adfDEM.resize(nWinPixels);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate %d x %d pixels for cumulative viewshed",
+                 nWinXSize, nWinYSize);
+        return nullptr;
+    }
 
-        /* set up initial point on the scanline */
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfThisLineVal[nX]
-                            : 0.0;
-        bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), 0, iLine - nY, padfThisLineVal[nX],
-            dfDistance2, dfCurvCoeff, dfSphereDiameter);
-        if (adjusted)
-        {
-            dfZ = CalcHeightLine(iLine - nY, padfLastLineVal[nX], dfZObserver);
+    if (!adfDEM.empty() &&
+        GDALRasterIO(hBand, GF_Read, nXOff, nYOff, nWinXSize, nWinYSize,
+                     adfDEM.data(), nWinXSize, nWinYSize, GDT_Float64, 0, 0))
+    {
+        CPLError(
+            CE_Failure, CPLE_AppDefined,
+            "RasterIO error when reading DEM at position(%d, %d), size(%d, %d)",
+            nXOff, nYOff, nWinXSize, nWinYSize);
+        return nullptr;
+    }
 
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] =
-                    std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+    /* -------------------------------------------------------------------- */
+    /*      Create the output raster.                                       */
+    /* -------------------------------------------------------------------- */
+    GDALDriver *hDriver = GetGDALDriverManager()->GetDriverByName(
+        pszDriverName ? pszDriverName : "GTiff");
+    if (!hDriver)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get driver");
+        return nullptr;
+    }
 
-            SetVisibility(nX, dfZ, dfTargetHeight, padfThisLineVal, vResult,
-                          byVisibleVal, byInvisibleVal);
-        }
-        else
+    auto poDstDS = std::unique_ptr<GDALDataset>(hDriver->Create(
+        pszTargetRasterName, nRasterXSize, nRasterYSize, 1, GDT_UInt32,
+        const_cast<char **>(papszCreationOptions)));
+    if (!poDstDS)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create dataset for %s",
+                 pszTargetRasterName);
+        return nullptr;
+    }
+    const OGRSpatialReference *poSRS =
+        hSrcDS ? GDALDataset::FromHandle(hSrcDS)->GetSpatialRef() : nullptr;
+    if (poSRS)
+        poDstDS->SetSpatialRef(poSRS);
+    poDstDS->SetGeoTransform(adfGeoTransform.data());
+
+    /* -------------------------------------------------------------------- */
+    /*      Process observers, possibly in parallel, and accumulate their   */
+    /*      visible pixels.                                                 */
+    /* -------------------------------------------------------------------- */
+    // Each running job accumulates its counts, without locking, in a buffer
+    // of its own. The buffers are reused by the next jobs, and summed once
+    // all observers have been processed.
+    struct CountBuffers
+    {
+        std::mutex oMutex{};
+        size_t nSize = 0;
+        std::vector<std::unique_ptr<std::vector<GUInt32>>> apoBuffers{};
+        std::vector<std::vector<GUInt32> *> apoAvailable{};
+    };
+
+    struct Job
+    {
+        const Observer *poObs = nullptr;
+        GDALViewshedContext oCtx{};
+        const double *padfDEM = nullptr;
+        CountBuffers *psCounts = nullptr;
+        int nWinXSize = 0;
+        int nXOff = 0;
+        int nYOff = 0;
+        std::atomic<bool> *pbStop = nullptr;
+        bool bOutOfMemory = false;
+    };
+
+    const auto ProcessObserver = [](void *pData)
+    {
+        Job *psJob = static_cast<Job *>(pData);
+        const Observer &oObs = *(psJob->poObs);
+        GDALViewshedContext &oCtx = psJob->oCtx;
+        const int nXSize = oObs.nXStop - oObs.nXStart;
+        oCtx.nX = oObs.nX - oObs.nXStart;
+        oCtx.nXSize = nXSize;
+
+        CountBuffers *psCounts = psJob->psCounts;
+        std::vector<GUInt32> *panCounts = nullptr;
         {
-            pabyResult[nX] = byOutOfRangeVal;
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] = dfOutOfRangeVal;
+            std::lock_guard<std::mutex> oLock(psCounts->oMutex);
+            if (!psCounts->apoAvailable.empty())
+            {
+                panCounts = psCounts->apoAvailable.back();
+                psCounts->apoAvailable.pop_back();
+            }
         }
 
-        /* process left direction */
-        for (int iPixel = nX - 1; iPixel >= 0; iPixel--)
+        try
         {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                                ? padfThisLineVal[iPixel]
-                                : 0.0;
-            bool left_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), nX - iPixel,
-                                    iLine - nY, padfThisLineVal[iPixel],
-                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
-            if (left_adjusted)
+            if (panCounts == nullptr)
             {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(
-                        nX - iPixel, iLine - nY, padfThisLineVal[iPixel + 1],
-                        padfLastLineVal[iPixel], dfZObserver);
-
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 =
-                        nX - iPixel >= iLine - nY
-                            ? CalcHeightEdge(iLine - nY, nX - iPixel,
-                                             padfLastLineVal[iPixel + 1],
-                                             padfThisLineVal[iPixel + 1],
-                                             dfZObserver)
-                            : CalcHeightEdge(nX - iPixel, iLine - nY,
-                                             padfLastLineVal[iPixel + 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
+                std::unique_ptr<std::vector<GUInt32>> poNewCounts(
+                    new std::vector<GUInt32>(psCounts->nSize));
+                std::lock_guard<std::mutex> oLock(psCounts->oMutex);
+                psCounts->apoBuffers.push_back(std::move(poNewCounts));
+                panCounts = psCounts->apoBuffers.back().get();
+            }
 
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+            std::vector<double> adfFirstLineVal(nXSize);
+            std::vector<double> adfLastLineVal(nXSize);
+            std::vector<double> adfThisLineVal(nXSize);
+            std::vector<GByte> abyResult(nXSize);
 
-                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
-                              vResult, byVisibleVal, byInvisibleVal);
-            }
-            else
+            const auto GetDEMLine = [psJob, &oObs](int iLine)
+            {
+                return psJob->padfDEM +
+                       static_cast<size_t>(iLine - psJob->nYOff) *
+                           psJob->nWinXSize +
+                       (oObs.nXStart - psJob->nXOff);
+            };
+            const auto Accumulate =
+                [psJob, &oObs, &abyResult, panCounts](int iLine)
             {
-                for (; iPixel >= 0; iPixel--)
+                GUInt32 *panCount = panCounts->data() +
+                                    static_cast<size_t>(iLine - psJob->nYOff) *
+                                        psJob->nWinXSize +
+                                    (oObs.nXStart - psJob->nXOff);
+                for (size_t i = 0; i < abyResult.size(); i++)
+                    panCount[i] += abyResult[i];
+            };
+
+            const double *padfDEMLine = GetDEMLine(oObs.nY);
+            std::copy(padfDEMLine, padfDEMLine + nXSize,
+                      adfFirstLineVal.begin());
+            oCtx.dfZObserver += adfFirstLineVal[oCtx.nX];
+            GDALViewshedProcessFirstLine(oCtx, adfFirstLineVal.data(),
+                                         abyResult.data(), nullptr);
+            Accumulate(oObs.nY);
+
+            for (const int nStep : {-1, 1})
+            {
+                std::vector<double> adfLeftLastLineVal(adfFirstLineVal);
+                std::vector<double> &adfRightLastLineVal = adfLastLineVal;
+                adfRightLastLineVal = adfFirstLineVal;
+                std::vector<double> adfLeftThisLineVal(nXSize);
+                for (int iLine = oObs.nY + nStep;
+                     iLine >= oObs.nYStart && iLine < oObs.nYStop &&
+                     !*(psJob->pbStop);
+                     iLine += nStep)
                 {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if (heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
+                    const int nLineDist = std::abs(iLine - oObs.nY);
+                    padfDEMLine = GetDEMLine(iLine);
+                    std::copy(padfDEMLine, padfDEMLine + nXSize,
+                              adfLeftThisLineVal.begin());
+                    std::copy(padfDEMLine, padfDEMLine + nXSize,
+                              adfThisLineVal.begin());
+                    GDALViewshedProcessLine(
+                        oCtx, nLineDist, true, adfLeftThisLineVal.data(),
+                        adfLeftLastLineVal.data(), abyResult.data(), nullptr);
+                    GDALViewshedProcessLine(
+                        oCtx, nLineDist, false, adfThisLineVal.data(),
+                        adfRightLastLineVal.data(), abyResult.data(), nullptr);
+                    Accumulate(iLine);
+                    std::swap(adfLeftLastLineVal, adfLeftThisLineVal);
+                    std::swap(adfRightLastLineVal, adfThisLineVal);
                 }
             }
         }
-        /* process right direction */
-        for (int iPixel = nX + 1; iPixel < nXSize; iPixel++)
+        catch (const std::exception &)
         {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                                ? padfThisLineVal[iPixel]
-                                : 0.0;
-            bool right_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), iPixel - nX,
-                                    iLine - nY, padfThisLineVal[iPixel],
-                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
-            if (right_adjusted)
-            {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(
-                        iPixel - nX, iLine - nY, padfThisLineVal[iPixel - 1],
-                        padfLastLineVal[iPixel], dfZObserver);
+            psJob->bOutOfMemory = true;
+        }
 
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 =
-                        iPixel - nX >= iLine - nY
-                            ? CalcHeightEdge(iLine - nY, iPixel - nX,
-                                             padfLastLineVal[iPixel - 1],
-                                             padfThisLineVal[iPixel - 1],
-                                             dfZObserver)
-                            : CalcHeightEdge(iPixel - nX, iLine - nY,
-                                             padfLastLineVal[iPixel - 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
+        if (panCounts)
+        {
+            std::lock_guard<std::mutex> oLock(psCounts->oMutex);
+            psCounts->apoAvailable.push_back(panCounts);
+        }
+    };
 
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+    CountBuffers sCounts;
+    sCounts.nSize = nWinPixels;
+    std::atomic<bool> bStop(false);
+    std::vector<Job> asJobs(nObservers);
+    for (int i = 0; i < nObservers; i++)
+    {
+        Job &sJob = asJobs[i];
+        sJob.poObs = &aoObservers[i];
+        sJob.oCtx.padfGeoTransform = adfGeoTransform.data();
+        sJob.oCtx.dfZObserver = dfObserverHeight;
+        sJob.oCtx.dfTargetHeight = dfTargetHeight;
+        sJob.oCtx.dfDistance2 = dfMaxDistance * dfMaxDistance;
+        sJob.oCtx.dfCurvCoeff = dfCurvCoeff;
+        sJob.oCtx.dfSphereDiameter = GDALViewshedGetSphereDiameter(poSRS);
+        sJob.oCtx.eMode = eMode;
+        sJob.oCtx.heightMode = GVOT_NORMAL;
+        sJob.oCtx.byVisibleVal = 1;
+        sJob.oCtx.byInvisibleVal = 0;
+        sJob.oCtx.byOutOfRangeVal = 0;
+        sJob.padfDEM = adfDEM.data();
+        sJob.psCounts = &sCounts;
+        sJob.nWinXSize = nWinXSize;
+        sJob.nXOff = nXOff;
+        sJob.nYOff = nYOff;
+        sJob.pbStop = &bStop;
+    }
 
-                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
-                              vResult, byVisibleVal, byInvisibleVal);
-            }
-            else
-            {
-                for (; iPixel < nXSize; iPixel++)
-                {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if (heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
-                }
-            }
+    const int nThreads = GDALGetNumThreads(papszExtraOptions, true);
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+
+    const auto Progress = [&](int nDone)
+    {
+        if (!bStop && !pfnProgress(0.9 * nDone / std::max(1, nObservers), "",
+                                   pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            bStop = true;
         }
+    };
+    for (int i = 0; i < nObservers && !bStop; i++)
+    {
+        if (!poQueue || !poQueue->SubmitJob(ProcessObserver, &asJobs[i]))
+        {
+            ProcessObserver(&asJobs[i]);
+            Progress(i + 1);
+        }
+    }
+    if (poQueue)
+    {
+        for (int nRemaining = nObservers - 1; nRemaining >= 0; nRemaining--)
+        {
+            poQueue->WaitCompletion(nRemaining);
+            Progress(nObservers - nRemaining);
+        }
+    }
+    if (bStop)
+        return nullptr;
+    for (const auto &sJob : asJobs)
+    {
+        if (sJob.bOutOfMemory)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate vectors for viewshed");
+            return nullptr;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Sum the counts of all jobs into the first buffer, and write it. */
+    /* -------------------------------------------------------------------- */
+    const GUInt32 *panCountSum = nullptr;
+    if (!sCounts.apoBuffers.empty())
+    {
+        std::vector<GUInt32> &anCountSum = *(sCounts.apoBuffers[0]);
+        for (size_t iBuffer = 1; iBuffer < sCounts.apoBuffers.size();
+             ++iBuffer)
+        {
+            const std::vector<GUInt32> &anCount =
+                *(sCounts.apoBuffers[iBuffer]);
+            for (size_t i = 0; i < nWinPixels; ++i)
+                anCountSum[i] += anCount[i];
+        }
+        panCountSum = anCountSum.data();
+    }
 
-        /* write result line */
-        if (GDALRasterIO(
-                hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
-                heightMode != GVOT_NORMAL ? static_cast<void *>(dfHeightResult)
-                                          : static_cast<void *>(pabyResult),
-                nXSize, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte,
-                0, 0))
+    std::vector<GUInt32> anLine(nRasterXSize);
+    for (int iLine = 0; iLine < nRasterYSize; iLine++)
+    {
+        std::fill(anLine.begin(), anLine.end(), 0);
+        if (panCountSum && iLine >= nYOff && iLine < nYOff + nWinYSize)
+        {
+            const GUInt32 *panCount =
+                panCountSum + static_cast<size_t>(iLine - nYOff) * nWinXSize;
+            std::copy(panCount, panCount + nWinXSize, anLine.begin() + nXOff);
+        }
+        if (poDstDS->GetRasterBand(1)->RasterIO(
+                GF_Write, 0, iLine, nRasterXSize, 1, anLine.data(),
+                nRasterXSize, 1, GDT_UInt32, 0, 0, nullptr) != CE_None)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "RasterIO error when writing target raster at position "
                      "(%d,%d), size (%d,%d)",
-                     0, iLine - nYStart, nXSize, 1);
+                     0, iLine, nRasterXSize, 1);
             return nullptr;
         }
-
-        std::swap(padfLastLineVal, padfThisLineVal);
-
-        if (!pfnProgress((iLine - nYStart) / static_cast<double>(nYSize), "",
+        if (!pfnProgress(0.9 + 0.1 * (iLine + 1) / nRasterYSize, "",
                          pProgressArg))
         {
             CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
@@ -868,11 +1335,5 @@ GDALDatasetH GDALViewshedGenerate(
         }
     }
 
-    if (!pfnProgress(1.0, "", pProgressArg))
-    {
-        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-        return nullptr;
-    }
-
     return GDALDataset::FromHandle(poDstDS.release());
 }
@@ -63,6 +63,7 @@ static void Usage(const char *pszErrorMsg = nullptr)
         "                    [-off <offset>] [-fl <level> <level>...] [-e "
         "<exp_base>]\n"
         "                    [-nln <outlayername>] [-q] [-p]\n"
+        "                    [-num_threads <number|ALL_CPUS>]\n"
         "                    <src_filename> <dst_filename>\n");
 
     if (pszErrorMsg != nullptr)
@@ -119,6 +120,7 @@ MAIN_START(argc, argv)
     bool bQuiet = false;
     GDALProgressFunc pfnProgress = nullptr;
     bool bPolygonize = false;
+    const char *pszNumThreads = nullptr;
 
     // Check that we are running against at least GDAL 1.4.
     // Note to developers: if we use newer API, please change the requirement.
@@ -244,6 +246,12 @@ MAIN_START(argc, argv)
             // coverity[tainted_data]
             pszNewLayerName = argv[++i];
         }
+        else if (EQUAL(argv[i], "-num_threads"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            // coverity[tainted_data]
+            pszNumThreads = argv[++i];
+        }
         else if (EQUAL(argv[i], "-inodata"))
         {
             bIgnoreNoData = true;
@@ -483,6 +491,10 @@ MAIN_START(argc, argv)
     {
         options = CSLAppendPrintf(options, "POLYGONIZE=YES");
     }
+    if (pszNumThreads)
+    {
+        options = CSLSetNameValue(options, "NUM_THREADS", pszNumThreads);
+    }
 
     CPLErr eErr =
         GDALContourGenerateEx(hBand, hLayer, options, pfnProgress, nullptr);
@@ -54,8 +54,9 @@ static void Usage(const char *pszErrorMsg = nullptr)
         "(default=45)]\n"
         "                 [-alg ZevenbergenThorne] [-combined | "
         "-multidirectional | -igor]\n"
-        "                 [-compute_edges] [-b Band (default=1)] [-of format] "
-        "[-co \"NAME=VALUE\"]* [-q]\n"
+        "                 [-compute_edges] [-b Band (default=1)] "
+        "[-multithread]\n"
+        "                 [-of format] [-co \"NAME=VALUE\"]* [-q]\n"
         "\n"
         " - To generates a slope map from any GDAL-supported elevation raster "
         ":\n\n"
@@ -63,8 +64,9 @@ static void Usage(const char *pszErrorMsg = nullptr)
         "                 [-p use percent slope (default=degrees)] [-s scale* "
         "(default=1)]\n"
         "                 [-alg ZevenbergenThorne]\n"
-        "                 [-compute_edges] [-b Band (default=1)] [-of format] "
-        "[-co \"NAME=VALUE\"]* [-q]\n"
+        "                 [-compute_edges] [-b Band (default=1)] "
+        "[-multithread]\n"
+        "                 [-of format] [-co \"NAME=VALUE\"]* [-q]\n"
         "\n"
         " - To generate an aspect map from any GDAL-supported elevation "
         "raster\n"
@@ -73,8 +75,9 @@ static void Usage(const char *pszErrorMsg = nullptr)
         "     gdaldem aspect input_dem output_aspect_map \n"
         "                 [-trigonometric] [-zero_for_flat]\n"
         "                 [-alg ZevenbergenThorne]\n"
-        "                 [-compute_edges] [-b Band (default=1)] [-of format] "
-        "[-co \"NAME=VALUE\"]* [-q]\n"
+        "                 [-compute_edges] [-b Band (default=1)] "
+        "[-multithread]\n"
+        "                 [-of format] [-co \"NAME=VALUE\"]* [-q]\n"
         "\n"
         " - To generate a color relief map from any GDAL-supported elevation "
         "raster\n"
@@ -82,8 +85,8 @@ static void Usage(const char *pszErrorMsg = nullptr)
         "output_color_relief_map\n"
         "                 [-alpha] [-exact_color_entry | "
         "-nearest_color_entry]\n"
-        "                 [-b Band (default=1)] [-of format] [-co "
-        "\"NAME=VALUE\"]* [-q]\n"
+        "                 [-b Band (default=1)] [-multithread] [-of format] "
+        "[-co \"NAME=VALUE\"]* [-q]\n"
         "     where color_text_file contains lines of the format "
         "\"elevation_value red green blue\"\n"
         "\n"
@@ -91,20 +94,23 @@ static void Usage(const char *pszErrorMsg = nullptr)
         "GDAL-supported elevation raster\n"
         "     gdaldem TRI input_dem output_TRI_map\n"
         "                 [-alg Wilson|Riley]\n"
-        "                 [-compute_edges] [-b Band (default=1)] [-of format] "
-        "[-co \"NAME=VALUE\"]* [-q]\n"
+        "                 [-compute_edges] [-b Band (default=1)] "
+        "[-multithread]\n"
+        "                 [-of format] [-co \"NAME=VALUE\"]* [-q]\n"
         "\n"
         " - To generate a Topographic Position Index (TPI) map from any "
         "GDAL-supported elevation raster\n"
         "     gdaldem TPI input_dem output_TPI_map\n"
-        "                 [-compute_edges] [-b Band (default=1)] [-of format] "
-        "[-co \"NAME=VALUE\"]* [-q]\n"
+        "                 [-compute_edges] [-b Band (default=1)] "
+        "[-multithread]\n"
+        "                 [-of format] [-co \"NAME=VALUE\"]* [-q]\n"
         "\n"
         " - To generate a roughness map from any GDAL-supported elevation "
         "raster\n"
         "     gdaldem roughness input_dem output_roughness_map\n"
-        "                 [-compute_edges] [-b Band (default=1)] [-of format] "
-        "[-co \"NAME=VALUE\"]* [-q]\n"
+        "                 [-compute_edges] [-b Band (default=1)] "
+        "[-multithread]\n"
+        "                 [-of format] [-co \"NAME=VALUE\"]* [-q]\n"
         "\n"
         " Notes : \n"
         "   Scale is the ratio of vertical units to horizontal\n"
@@ -109,7 +109,13 @@
 #endif
 
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
 #include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "cpl_error.h"
 #include "cpl_progress.h"
@@ -117,6 +123,7 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #if defined(__SSE2__) || defined(_M_X64)
 #define HAVE_16_SSE_REG
@@ -179,6 +186,7 @@ struct GDALDEMProcessingOptions
     bool bMultiDirectional = false;
     char **papszCreateOptions = nullptr;
     int nBand = 1;
+    bool bMultiThread = false;
 };
 
 /************************************************************************/
@@ -290,6 +298,509 @@ GInt32 INTERPOL(GInt32 a, GInt32 b, int bSrcHasNoData, GInt32 fSrcNoDataValue)
     return nVal;
 }
 
+/************************************************************************/
+/*                         IsSrcNoDataValue()                           */
+/************************************************************************/
+
+static inline bool IsSrcNoDataValue(float fVal, float fSrcNoDataValue,
+                                    bool bIsSrcNoDataNan)
+{
+    return bIsSrcNoDataNan ? CPLIsNan(fVal)
+                           : ARE_REAL_EQUAL(fVal, fSrcNoDataValue);
+}
+
+static inline bool IsSrcNoDataValue(GInt32 nVal, GInt32 nSrcNoDataValue,
+                                    bool /* bIsSrcNoDataNan */)
+{
+    return nVal == nSrcNoDataValue;
+}
+
+/************************************************************************/
+/*                    GDALGeneric3x3LineProcessor                       */
+/************************************************************************/
+
+// Computes an output line from the source lines around it. Shared by the
+// single-threaded and multi-threaded code paths of GDALGeneric3x3Processing()
+template <class T> struct GDALGeneric3x3LineProcessor
+{
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg = nullptr;
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+        pfnAlg_multisample = nullptr;
+    void *pData = nullptr;
+    bool bComputeAtEdges = false;
+    int nXSize = 0;
+    int nYSize = 0;
+    bool bSrcHasNoData = false;
+    bool bIsSrcNoDataNan = false;
+    T fSrcNoDataValue = 0;
+    float fDstNoDataValue = 0;
+
+    bool LineHasNoData(const T *pafLine) const;
+
+    void ProcessFirstLine(const T *pafLine0, const T *pafLine1,
+                          float *pafOutputBuf) const;
+
+    void ProcessLine(const T *pafThreeLineWin, int nLine1Off, int nLine2Off,
+                     int nLine3Off, bool bOneOfThreeLinesHasNoData,
+                     float *pafOutputBuf) const;
+
+    void ProcessLastLine(const T *pafLineBefore, const T *pafLastLine,
+                         float *pafOutputBuf) const;
+};
+
+/************************************************************************/
+/*                          LineHasNoData()                             */
+/************************************************************************/
+
+// In case none of the 3 lines of a window have nodata values, then no need
+// to check it in ComputeVal()
+template <class T>
+bool GDALGeneric3x3LineProcessor<T>::LineHasNoData(const T *pafLine) const
+{
+    if (!bSrcHasNoData)
+        return false;
+
+    int iX = 0;
+    for (; iX + 3 < nXSize; iX += 4)
+    {
+        if (IsSrcNoDataValue(pafLine[iX], fSrcNoDataValue, bIsSrcNoDataNan) ||
+            IsSrcNoDataValue(pafLine[iX + 1], fSrcNoDataValue,
+                             bIsSrcNoDataNan) ||
+            IsSrcNoDataValue(pafLine[iX + 2], fSrcNoDataValue,
+                             bIsSrcNoDataNan) ||
+            IsSrcNoDataValue(pafLine[iX + 3], fSrcNoDataValue,
+                             bIsSrcNoDataNan))
+        {
+            return true;
+        }
+    }
+    for (; iX < nXSize; iX++)
+    {
+        if (IsSrcNoDataValue(pafLine[iX], fSrcNoDataValue, bIsSrcNoDataNan))
+            return true;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                        ProcessFirstLine()                            */
+/************************************************************************/
+
+template <class T>
+void GDALGeneric3x3LineProcessor<T>::ProcessFirstLine(
+    const T *pafLine0, const T *pafLine1, float *pafOutputBuf) const
+{
+    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
+    {
+        for (int j = 0; j < nXSize; j++)
+        {
+            int jmin = (j == 0) ? j : j - 1;
+            int jmax = (j == nXSize - 1) ? j : j + 1;
+
+            T afWin[9] = {INTERPOL(pafLine0[jmin], pafLine1[jmin],
+                                   bSrcHasNoData, fSrcNoDataValue),
+                          INTERPOL(pafLine0[j], pafLine1[j], bSrcHasNoData,
+                                   fSrcNoDataValue),
+                          INTERPOL(pafLine0[jmax], pafLine1[jmax],
+                                   bSrcHasNoData, fSrcNoDataValue),
+                          pafLine0[jmin],
+                          pafLine0[j],
+                          pafLine0[jmax],
+                          pafLine1[jmin],
+                          pafLine1[j],
+                          pafLine1[jmax]};
+            pafOutputBuf[j] = ComputeVal(bSrcHasNoData, fSrcNoDataValue,
+                                         bIsSrcNoDataNan, afWin,
+                                         fDstNoDataValue, pfnAlg, pData,
+                                         bComputeAtEdges);
+        }
+    }
+    else
+    {
+        // Exclude the edges
+        for (int j = 0; j < nXSize; j++)
+        {
+            pafOutputBuf[j] = fDstNoDataValue;
+        }
+    }
+}
+
+/************************************************************************/
+/*                           ProcessLine()                              */
+/************************************************************************/
+
+template <class T>
+void GDALGeneric3x3LineProcessor<T>::ProcessLine(
+    const T *pafThreeLineWin, int nLine1Off, int nLine2Off, int nLine3Off,
+    bool bOneOfThreeLinesHasNoData, float *pafOutputBuf) const
+{
+    if (bComputeAtEdges && nXSize >= 2)
+    {
+        int j = 0;
+        T afWin[9] = {INTERPOL(pafThreeLineWin[nLine1Off + j],
+                               pafThreeLineWin[nLine1Off + j + 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine1Off + j],
+                      pafThreeLineWin[nLine1Off + j + 1],
+                      INTERPOL(pafThreeLineWin[nLine2Off + j],
+                               pafThreeLineWin[nLine2Off + j + 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine2Off + j],
+                      pafThreeLineWin[nLine2Off + j + 1],
+                      INTERPOL(pafThreeLineWin[nLine3Off + j],
+                               pafThreeLineWin[nLine3Off + j + 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine3Off + j],
+                      pafThreeLineWin[nLine3Off + j + 1]};
+
+        pafOutputBuf[j] = ComputeVal(bOneOfThreeLinesHasNoData,
+                                     fSrcNoDataValue, bIsSrcNoDataNan, afWin,
+                                     fDstNoDataValue, pfnAlg, pData,
+                                     bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        pafOutputBuf[0] = fDstNoDataValue;
+    }
+
+    int j = 1;
+    if (pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
+    {
+        j = pfnAlg_multisample(pafThreeLineWin, nLine1Off, nLine2Off,
+                               nLine3Off, nXSize, pData, pafOutputBuf);
+    }
+
+    for (; j < nXSize - 1; j++)
+    {
+        T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
+                      pafThreeLineWin[nLine1Off + j],
+                      pafThreeLineWin[nLine1Off + j + 1],
+                      pafThreeLineWin[nLine2Off + j - 1],
+                      pafThreeLineWin[nLine2Off + j],
+                      pafThreeLineWin[nLine2Off + j + 1],
+                      pafThreeLineWin[nLine3Off + j - 1],
+                      pafThreeLineWin[nLine3Off + j],
+                      pafThreeLineWin[nLine3Off + j + 1]};
+
+        pafOutputBuf[j] = ComputeVal(bOneOfThreeLinesHasNoData,
+                                     fSrcNoDataValue, bIsSrcNoDataNan, afWin,
+                                     fDstNoDataValue, pfnAlg, pData,
+                                     bComputeAtEdges);
+    }
+
+    if (bComputeAtEdges && nXSize >= 2)
+    {
+        j = nXSize - 1;
+
+        T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
+                      pafThreeLineWin[nLine1Off + j],
+                      INTERPOL(pafThreeLineWin[nLine1Off + j],
+                               pafThreeLineWin[nLine1Off + j - 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine2Off + j - 1],
+                      pafThreeLineWin[nLine2Off + j],
+                      INTERPOL(pafThreeLineWin[nLine2Off + j],
+                               pafThreeLineWin[nLine2Off + j - 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine3Off + j - 1],
+                      pafThreeLineWin[nLine3Off + j],
+                      INTERPOL(pafThreeLineWin[nLine3Off + j],
+                               pafThreeLineWin[nLine3Off + j - 1],
+                               bSrcHasNoData, fSrcNoDataValue)};
+
+        pafOutputBuf[j] = ComputeVal(bOneOfThreeLinesHasNoData,
+                                     fSrcNoDataValue, bIsSrcNoDataNan, afWin,
+                                     fDstNoDataValue, pfnAlg, pData,
+                                     bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        if (nXSize > 1)
+            pafOutputBuf[nXSize - 1] = fDstNoDataValue;
+    }
+}
+
+/************************************************************************/
+/*                         ProcessLastLine()                            */
+/************************************************************************/
+
+template <class T>
+void GDALGeneric3x3LineProcessor<T>::ProcessLastLine(
+    const T *pafLineBefore, const T *pafLastLine, float *pafOutputBuf) const
+{
+    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
+    {
+        for (int j = 0; j < nXSize; j++)
+        {
+            int jmin = (j == 0) ? j : j - 1;
+            int jmax = (j == nXSize - 1) ? j : j + 1;
+
+            T afWin[9] = {
+                pafLineBefore[jmin],
+                pafLineBefore[j],
+                pafLineBefore[jmax],
+                pafLastLine[jmin],
+                pafLastLine[j],
+                pafLastLine[jmax],
+                INTERPOL(pafLastLine[jmin], pafLineBefore[jmin], bSrcHasNoData,
+                         fSrcNoDataValue),
+                INTERPOL(pafLastLine[j], pafLineBefore[j], bSrcHasNoData,
+                         fSrcNoDataValue),
+                INTERPOL(pafLastLine[jmax], pafLineBefore[jmax], bSrcHasNoData,
+                         fSrcNoDataValue),
+            };
+
+            pafOutputBuf[j] = ComputeVal(bSrcHasNoData, fSrcNoDataValue,
+                                         bIsSrcNoDataNan, afWin,
+                                         fDstNoDataValue, pfnAlg, pData,
+                                         bComputeAtEdges);
+        }
+    }
+    else
+    {
+        // Exclude the edges
+        for (int j = 0; j < nXSize; j++)
+        {
+            pafOutputBuf[j] = fDstNoDataValue;
+        }
+    }
+}
+
+/************************************************************************/
+/*                        GDALDEMProcessStrips()                        */
+/************************************************************************/
+
+namespace
+{
+// Strip of consecutive output lines processed by a job of
+// GDALDEMProcessStrips()
+struct GDALDEMStripJob
+{
+    int nYOff = 0;
+    int nYSize = 0;
+    std::vector<GByte> abySrcBuffer{};
+    std::vector<GByte> abyDstBuffer{};
+    const std::function<void(GDALDEMStripJob &)> *pfnCompute = nullptr;
+
+    // Synchronization
+    bool bFinished = false;
+    std::mutex mutex{};
+    std::condition_variable cv{};
+};
+}  // namespace
+
+// Processes the raster by strips of nLinesPerStrip output lines. Strips are
+// read and written in order from the calling thread, whereas their
+// computation is done on the global thread pool, with at most 2 * nThreads
+// strips in flight.
+static CPLErr
+GDALDEMProcessStrips(int nYSize, int nLinesPerStrip, int nThreads,
+                     const std::function<CPLErr(GDALDEMStripJob &)> &fnRead,
+                     const std::function<void(GDALDEMStripJob &)> &fnCompute,
+                     const std::function<CPLErr(GDALDEMStripJob &)> &fnWrite,
+                     GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    if (poThreadPool == nullptr)
+        return CE_Failure;
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+
+    const auto JobComputeFunc = [](void *pData)
+    {
+        GDALDEMStripJob *poJob = static_cast<GDALDEMStripJob *>(pData);
+        (*poJob->pfnCompute)(*poJob);
+
+        std::lock_guard<std::mutex> guard(poJob->mutex);
+        poJob->bFinished = true;
+        poJob->cv.notify_one();
+    };
+
+    std::list<std::unique_ptr<GDALDEMStripJob>> jobList;
+    CPLErr eErr = CE_None;
+
+    // Wait for completion of oldest job and write it
+    const auto WaitAndFinalizeOldestJob = [&]()
+    {
+        GDALDEMStripJob *poOldestJob = jobList.front().get();
+        {
+            std::unique_lock<std::mutex> oGuard(poOldestJob->mutex);
+            while (!poOldestJob->bFinished)
+            {
+                poOldestJob->cv.wait(oGuard);
+            }
+        }
+        if (eErr == CE_None)
+        {
+            eErr = fnWrite(*poOldestJob);
+            if (eErr == CE_None &&
+                !pfnProgress(
+                    static_cast<double>(poOldestJob->nYOff +
+                                        poOldestJob->nYSize) /
+                        nYSize,
+                    nullptr, pProgressData))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                eErr = CE_Failure;
+            }
+        }
+        jobList.pop_front();
+    };
+
+    for (int nYOff = 0; eErr == CE_None && nYOff < nYSize;
+         nYOff += nLinesPerStrip)
+    {
+        auto poJob = cpl::make_unique<GDALDEMStripJob>();
+        poJob->nYOff = nYOff;
+        poJob->nYSize = std::min(nLinesPerStrip, nYSize - nYOff);
+        poJob->pfnCompute = &fnCompute;
+        try
+        {
+            eErr = fnRead(*poJob);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate buffers for lines %d to %d", nYOff,
+                     nYOff + poJob->nYSize - 1);
+            eErr = CE_Failure;
+        }
+        if (eErr != CE_None)
+            break;
+
+        if (!poJobQueue->SubmitJob(JobComputeFunc, poJob.get()))
+        {
+            eErr = CE_Failure;
+            break;
+        }
+        jobList.emplace_back(std::move(poJob));
+
+        if (static_cast<int>(jobList.size()) >= 2 * nThreads)
+            WaitAndFinalizeOldestJob();
+    }
+
+    while (!jobList.empty())
+        WaitAndFinalizeOldestJob();
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                      GDALDEMGetLinesPerStrip()                       */
+/************************************************************************/
+
+// Maximum size of the source and destination buffers of a strip
+constexpr size_t DEM_MT_MAX_BYTES_PER_STRIP = 16 * 1024 * 1024;
+// Maximum number of lines of a strip
+constexpr int DEM_MT_MAX_LINES_PER_STRIP = 256;
+
+// Returns a strip height small enough so that each thread gets several strips
+static int GDALDEMGetLinesPerStrip(int nXSize, int nYSize,
+                                   size_t nBytesPerPixel, int nThreads)
+{
+    const size_t nBytesPerLine = static_cast<size_t>(nXSize) * nBytesPerPixel;
+    const int nLinesPerStrip = static_cast<int>(std::min<size_t>(
+        DEM_MT_MAX_LINES_PER_STRIP,
+        std::max<size_t>(1, DEM_MT_MAX_BYTES_PER_STRIP / nBytesPerLine)));
+    return std::min(nLinesPerStrip, DIV_ROUND_UP(nYSize, 4 * nThreads));
+}
+
+/************************************************************************/
+/*               GDALGeneric3x3ProcessingMultiThreaded()                */
+/************************************************************************/
+
+template <class T>
+static CPLErr GDALGeneric3x3ProcessingMultiThreaded(
+    const GDALGeneric3x3LineProcessor<T> &oProcessor, GDALRasterBandH hSrcBand,
+    GDALRasterBandH hDstBand, GDALDataType eReadDT, int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    const int nXSize = oProcessor.nXSize;
+    const int nYSize = oProcessor.nYSize;
+    const int nLinesPerStrip = GDALDEMGetLinesPerStrip(
+        nXSize, nYSize, sizeof(T) + sizeof(float), nThreads);
+
+    // Source lines of a strip, including the one-line halo above and below
+    const auto GetSrcYOff = [](const GDALDEMStripJob &oJob)
+    { return std::max(0, oJob.nYOff - 1); };
+    const auto GetSrcYEnd = [nYSize](const GDALDEMStripJob &oJob)
+    { return std::min(nYSize, oJob.nYOff + oJob.nYSize + 1); };
+
+    const auto ReadStrip = [&](GDALDEMStripJob &oJob)
+    {
+        const int nSrcYOff = GetSrcYOff(oJob);
+        const int nSrcYSize = GetSrcYEnd(oJob) - nSrcYOff;
+        oJob.abySrcBuffer.resize(
+            (static_cast<size_t>(nSrcYSize) * nXSize + 1) * sizeof(T));
+        oJob.abyDstBuffer.resize(static_cast<size_t>(oJob.nYSize) * nXSize *
+                                 sizeof(float));
+        return GDALRasterIO(hSrcBand, GF_Read, 0, nSrcYOff, nXSize, nSrcYSize,
+                            oJob.abySrcBuffer.data(), nXSize, nSrcYSize,
+                            eReadDT, 0, 0);
+    };
+
+    const auto ComputeStrip = [&](GDALDEMStripJob &oJob)
+    {
+        const int nSrcYOff = GetSrcYOff(oJob);
+        const int nSrcYEnd = GetSrcYEnd(oJob);
+        const T *pafSrc = reinterpret_cast<const T *>(oJob.abySrcBuffer.data());
+        float *pafDst = reinterpret_cast<float *>(oJob.abyDstBuffer.data());
+        const auto GetSrcLine = [pafSrc, nSrcYOff, nXSize](int iLine)
+        { return pafSrc + static_cast<size_t>(iLine - nSrcYOff) * nXSize; };
+
+        bool abLineHasNoDataValue[DEM_MT_MAX_LINES_PER_STRIP + 2];
+        for (int iLine = nSrcYOff; iLine < nSrcYEnd; iLine++)
+        {
+            abLineHasNoDataValue[iLine - nSrcYOff] =
+                oProcessor.LineHasNoData(GetSrcLine(iLine));
+        }
+
+        for (int iLine = oJob.nYOff; iLine < oJob.nYOff + oJob.nYSize; iLine++)
+        {
+            float *pafOutputBuf =
+                pafDst + static_cast<size_t>(iLine - oJob.nYOff) * nXSize;
+            if (iLine == 0)
+            {
+                oProcessor.ProcessFirstLine(
+                    GetSrcLine(0), nYSize > 1 ? GetSrcLine(1) : nullptr,
+                    pafOutputBuf);
+            }
+            else if (iLine == nYSize - 1)
+            {
+                oProcessor.ProcessLastLine(GetSrcLine(iLine - 1),
+                                           GetSrcLine(iLine), pafOutputBuf);
+            }
+            else
+            {
+                const int k = iLine - 1 - nSrcYOff;
+                oProcessor.ProcessLine(GetSrcLine(iLine - 1), 0, nXSize,
+                                       2 * nXSize,
+                                       abLineHasNoDataValue[k] ||
+                                           abLineHasNoDataValue[k + 1] ||
+                                           abLineHasNoDataValue[k + 2],
+                                       pafOutputBuf);
+            }
+        }
+    };
+
+    const auto WriteStrip = [&](GDALDEMStripJob &oJob)
+    {
+        return GDALRasterIO(hDstBand, GF_Write, 0, oJob.nYOff, nXSize,
+                            oJob.nYSize, oJob.abyDstBuffer.data(), nXSize,
+                            oJob.nYSize, GDT_Float32, 0, 0);
+    };
+
+    const CPLErr eErr =
+        GDALDEMProcessStrips(nYSize, nLinesPerStrip, nThreads, ReadStrip,
+                             ComputeStrip, WriteStrip, pfnProgress,
+                             pProgressData);
+    if (eErr == CE_None)
+        pfnProgress(1.0, nullptr, pProgressData);
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                  GDALGeneric3x3Processing()                          */
 /************************************************************************/
@@ -300,8 +811,8 @@ static CPLErr GDALGeneric3x3Processing(
     typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg,
     typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
         pfnAlg_multisample,
-    void *pData, bool bComputeAtEdges, GDALProgressFunc pfnProgress,
-    void *pProgressData)
+    void *pData, bool bComputeAtEdges, int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressData)
 {
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
@@ -318,19 +829,6 @@ static CPLErr GDALGeneric3x3Processing(
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
 
-    // 1 line destination buffer.
-    float *pafOutputBuf =
-        static_cast<float *>(VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
-    // 3 line rotating source buffer.
-    T *pafThreeLineWin =
-        static_cast<T *>(VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize + 1));
-    if (pafOutputBuf == nullptr || pafThreeLineWin == nullptr)
-    {
-        VSIFree(pafOutputBuf);
-        VSIFree(pafThreeLineWin);
-        return CE_Failure;
-    }
-
     GDALDataType eReadDT;
     int bSrcHasNoData = FALSE;
     const double dfNoDataValue =
@@ -377,6 +875,38 @@ static CPLErr GDALGeneric3x3Processing(
     if (!bDstHasNoData)
         fDstNoDataValue = 0.0;
 
+    GDALGeneric3x3LineProcessor<T> oProcessor;
+    oProcessor.pfnAlg = pfnAlg;
+    oProcessor.pfnAlg_multisample = pfnAlg_multisample;
+    oProcessor.pData = pData;
+    oProcessor.bComputeAtEdges = bComputeAtEdges;
+    oProcessor.nXSize = nXSize;
+    oProcessor.nYSize = nYSize;
+    oProcessor.bSrcHasNoData = CPL_TO_BOOL(bSrcHasNoData);
+    oProcessor.bIsSrcNoDataNan = CPL_TO_BOOL(bIsSrcNoDataNan);
+    oProcessor.fSrcNoDataValue = fSrcNoDataValue;
+    oProcessor.fDstNoDataValue = fDstNoDataValue;
+
+    if (nThreads > 1)
+    {
+        return GDALGeneric3x3ProcessingMultiThreaded(
+            oProcessor, hSrcBand, hDstBand, eReadDT, nThreads, pfnProgress,
+            pProgressData);
+    }
+
+    // 1 line destination buffer.
+    float *pafOutputBuf =
+        static_cast<float *>(VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
+    // 3 line rotating source buffer.
+    T *pafThreeLineWin =
+        static_cast<T *>(VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize + 1));
+    if (pafOutputBuf == nullptr || pafThreeLineWin == nullptr)
+    {
+        VSIFree(pafOutputBuf);
+        VSIFree(pafThreeLineWin);
+        return CE_Failure;
+    }
+
     int nLine1Off = 0;
     int nLine2Off = nXSize;
     int nLine3Off = 2 * nXSize;
@@ -390,9 +920,7 @@ static CPLErr GDALGeneric3x3Processing(
 
     /* Preload the first 2 lines */
 
-    bool abLineHasNoDataValue[3] = {CPL_TO_BOOL(bSrcHasNoData),
-                                    CPL_TO_BOOL(bSrcHasNoData),
-                                    CPL_TO_BOOL(bSrcHasNoData)};
+    bool abLineHasNoDataValue[3] = {false, false, false};
 
     // Create an extra scope for VC12 to ignore i.
     {
@@ -407,66 +935,15 @@ static CPLErr GDALGeneric3x3Processing(
 
                 return CE_Failure;
             }
-            if (std::numeric_limits<T>::is_integer && bSrcHasNoData)
-            {
-                abLineHasNoDataValue[i] = false;
-                for (int iX = 0; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[i * nXSize + iX] == fSrcNoDataValue)
-                    {
-                        abLineHasNoDataValue[i] = true;
-                        break;
-                    }
-                }
-            }
+            abLineHasNoDataValue[i] =
+                oProcessor.LineHasNoData(pafThreeLineWin + i * nXSize);
         }
     }  // End extra scope for VC12
 
-    CPLErr eErr = CE_None;
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
-    {
-        for (int j = 0; j < nXSize; j++)
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                INTERPOL(pafThreeLineWin[jmin], pafThreeLineWin[nXSize + jmin],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[j], pafThreeLineWin[nXSize + j],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[jmax], pafThreeLineWin[nXSize + jmax],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[jmin],
-                pafThreeLineWin[j],
-                pafThreeLineWin[jmax],
-                pafThreeLineWin[nXSize + jmin],
-                pafThreeLineWin[nXSize + j],
-                pafThreeLineWin[nXSize + jmax]};
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
-                           CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
-                           pfnAlg, pData, bComputeAtEdges);
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-    }
-    else
-    {
-        // Exclude the edges
-        for (int j = 0; j < nXSize; j++)
-        {
-            pafOutputBuf[j] = fDstNoDataValue;
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-
-        if (eErr == CE_None && nYSize > 1)
-        {
-            eErr = GDALRasterIO(hDstBand, GF_Write, 0, nYSize - 1, nXSize, 1,
-                                pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
-        }
-    }
+    oProcessor.ProcessFirstLine(pafThreeLineWin, pafThreeLineWin + nXSize,
+                                pafOutputBuf);
+    CPLErr eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1,
+                               pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
     if (eErr != CE_None)
     {
         CPLFree(pafOutputBuf);
@@ -490,127 +967,15 @@ static CPLErr GDALGeneric3x3Processing(
             return eErr;
         }
 
-        // In case none of the 3 lines have nodata values, then no need to
-        // check it in ComputeVal()
-        bool bOneOfThreeLinesHasNoData = CPL_TO_BOOL(bSrcHasNoData);
-        if (std::numeric_limits<T>::is_integer && bSrcHasNoData)
-        {
-            bool bLastLineHasNoDataValue = false;
-            int iX = 0;
-            for (; iX + 3 < nXSize; iX += 4)
-            {
-                if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 1] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 2] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 3] == fSrcNoDataValue)
-                {
-                    bLastLineHasNoDataValue = true;
-                    break;
-                }
-            }
-            if (!bLastLineHasNoDataValue)
-            {
-                for (; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue)
-                    {
-                        bLastLineHasNoDataValue = true;
-                    }
-                }
-            }
-            abLineHasNoDataValue[nLine3Off / nXSize] = bLastLineHasNoDataValue;
-
-            bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
-                                        abLineHasNoDataValue[1] ||
-                                        abLineHasNoDataValue[2];
-        }
+        abLineHasNoDataValue[nLine3Off / nXSize] =
+            oProcessor.LineHasNoData(pafThreeLineWin + nLine3Off);
+        const bool bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
+                                               abLineHasNoDataValue[1] ||
+                                               abLineHasNoDataValue[2];
 
-        if (bComputeAtEdges && nXSize >= 2)
-        {
-            int j = 0;
-            T afWin[9] = {INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            pafOutputBuf[0] = fDstNoDataValue;
-        }
-
-        int j = 1;
-        if (pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
-        {
-            j = pfnAlg_multisample(pafThreeLineWin, nLine1Off, nLine2Off,
-                                   nLine3Off, nXSize, pData, pafOutputBuf);
-        }
-
-        for (; j < nXSize - 1; j++)
-        {
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
-        }
-
-        if (bComputeAtEdges && nXSize >= 2)
-        {
-            j = nXSize - 1;
-
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue)};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            if (nXSize > 1)
-                pafOutputBuf[nXSize - 1] = fDstNoDataValue;
-        }
+        oProcessor.ProcessLine(pafThreeLineWin, nLine1Off, nLine2Off,
+                               nLine3Off, bOneOfThreeLinesHasNoData,
+                               pafOutputBuf);
 
         /* -----------------------------------------
          * Write Line to Raster
@@ -642,36 +1007,10 @@ static CPLErr GDALGeneric3x3Processing(
         nLine3Off = nTemp;
     }
 
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
+    if (nYSize > 1)
     {
-        for (int j = 0; j < nXSize; j++)
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + jmin],
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + jmax],
-                pafThreeLineWin[nLine2Off + jmin],
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + jmax],
-                INTERPOL(pafThreeLineWin[nLine2Off + jmin],
-                         pafThreeLineWin[nLine1Off + jmin], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine1Off + j], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + jmax],
-                         pafThreeLineWin[nLine1Off + jmax], bSrcHasNoData,
-                         fSrcNoDataValue),
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
-                           CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
-                           pfnAlg, pData, bComputeAtEdges);
-        }
+        oProcessor.ProcessLastLine(pafThreeLineWin + nLine1Off,
+                                   pafThreeLineWin + nLine2Off, pafOutputBuf);
         eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1, pafOutputBuf,
                             nXSize, 1, GDT_Float32, 0, 0);
         if (eErr != CE_None)
@@ -727,6 +1066,133 @@ template <class T> struct Gradient<T, GradientAlg::ZEVENBERGEN_THORNE>
     }
 };
 
+#ifdef HAVE_16_SSE_REG
+
+/************************************************************************/
+/*                            GDALDEMSSE                                */
+/************************************************************************/
+
+// Operations on 4 consecutive values of type T, done in the same type (and
+// thus with the same rounding) as in the scalar code paths.
+template <class T> struct GDALDEMSSE;
+
+template <> struct GDALDEMSSE<GInt32>
+{
+    typedef __m128i Vec;
+
+    static inline Vec Load(const GInt32 *p)
+    {
+        return _mm_loadu_si128(reinterpret_cast<__m128i const *>(p));
+    }
+
+    static inline Vec Add(Vec a, Vec b)
+    {
+        return _mm_add_epi32(a, b);
+    }
+
+    static inline Vec Sub(Vec a, Vec b)
+    {
+        return _mm_sub_epi32(a, b);
+    }
+
+    // Converts the 2 first values to double
+    static inline __m128d Low(Vec a)
+    {
+        return _mm_cvtepi32_pd(a);
+    }
+
+    // Converts the 2 last values to double
+    static inline __m128d High(Vec a)
+    {
+        return _mm_cvtepi32_pd(_mm_srli_si128(a, 8));
+    }
+};
+
+template <> struct GDALDEMSSE<float>
+{
+    typedef __m128 Vec;
+
+    static inline Vec Load(const float *p)
+    {
+        return _mm_loadu_ps(p);
+    }
+
+    static inline Vec Add(Vec a, Vec b)
+    {
+        return _mm_add_ps(a, b);
+    }
+
+    static inline Vec Sub(Vec a, Vec b)
+    {
+        return _mm_sub_ps(a, b);
+    }
+
+    // Converts the 2 first values to double
+    static inline __m128d Low(Vec a)
+    {
+        return _mm_cvtps_pd(a);
+    }
+
+    // Converts the 2 last values to double
+    static inline __m128d High(Vec a)
+    {
+        return _mm_cvtps_pd(_mm_movehl_ps(a, a));
+    }
+};
+
+/************************************************************************/
+/*                            GradientSSE                               */
+/************************************************************************/
+
+// Vectorized Gradient: computes the x and y gradients, before scaling by
+// the resolution, of the 4 pixels centered on pafLine2[1] to pafLine2[4]
+template <class T, GradientAlg alg> struct GradientSSE
+{
+    typedef typename GDALDEMSSE<T>::Vec Vec;
+    static inline void calc(const T *pafLine1, const T *pafLine2,
+                            const T *pafLine3, Vec &x, Vec &y);
+};
+
+template <class T> struct GradientSSE<T, GradientAlg::HORN>
+{
+    typedef GDALDEMSSE<T> S;
+    typedef typename S::Vec Vec;
+
+    static inline void calc(const T *pafLine1, const T *pafLine2,
+                            const T *pafLine3, Vec &x, Vec &y)
+    {
+        const Vec w0 = S::Load(pafLine1);
+        const Vec w1 = S::Load(pafLine1 + 1);
+        const Vec w2 = S::Load(pafLine1 + 2);
+        const Vec w3 = S::Load(pafLine2);
+        const Vec w5 = S::Load(pafLine2 + 2);
+        const Vec w6 = S::Load(pafLine3);
+        const Vec w7 = S::Load(pafLine3 + 1);
+        const Vec w8 = S::Load(pafLine3 + 2);
+
+        x = S::Sub(S::Add(S::Add(S::Add(w0, w3), w3), w6),
+                   S::Add(S::Add(S::Add(w2, w5), w5), w8));
+
+        y = S::Sub(S::Add(S::Add(S::Add(w6, w7), w7), w8),
+                   S::Add(S::Add(S::Add(w0, w1), w1), w2));
+    }
+};
+
+template <class T> struct GradientSSE<T, GradientAlg::ZEVENBERGEN_THORNE>
+{
+    typedef GDALDEMSSE<T> S;
+    typedef typename S::Vec Vec;
+
+    static inline void calc(const T *pafLine1, const T *pafLine2,
+                            const T *pafLine3, Vec &x, Vec &y)
+    {
+        x = S::Sub(S::Load(pafLine2), S::Load(pafLine2 + 2));
+        y = S::Sub(S::Load(pafLine3 + 1), S::Load(pafLine1 + 1));
+    }
+};
+
+#endif  // HAVE_16_SSE_REG
+
 /************************************************************************/
 /*                         GDALHillshade()                              */
 /************************************************************************/
@@ -978,7 +1444,8 @@ GDALHillshadeAlg_same_res_multisample(const T *pafThreeLineWin, int nLine1Off,
                                       int nLine2Off, int nLine3Off, int nXSize,
                                       void *pData, float *pafOutputBuf)
 {
-    // Only valid for T == int
+    typedef GDALDEMSSE<T> S;
+    typedef typename S::Vec Vec;
 
     GDALHillshadeAlgData *psData = static_cast<GDALHillshadeAlgData *>(pData);
     const __m128d reg_fact_x =
@@ -1000,36 +1467,29 @@ GDALHillshadeAlg_same_res_multisample(const T *pafThreeLineWin, int nLine1Off,
         const T *secondLine = pafThreeLineWin + nLine2Off + j - 1;
         const T *thirdLine = pafThreeLineWin + nLine3Off + j - 1;
 
-        __m128i firstLine0 =
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(firstLine));
-        __m128i firstLine1 =
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(firstLine + 1));
-        __m128i firstLine2 =
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(firstLine + 2));
-        __m128i thirdLine0 =
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(thirdLine));
-        __m128i thirdLine1 =
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(thirdLine + 1));
-        __m128i thirdLine2 =
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(thirdLine + 2));
-        __m128i accX = _mm_sub_epi32(firstLine0, thirdLine2);
-        const __m128i six_minus_two = _mm_sub_epi32(thirdLine0, firstLine2);
-        __m128i accY = accX;
-        const __m128i three_minus_five = _mm_sub_epi32(
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(secondLine)),
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(secondLine + 2)));
-        const __m128i one_minus_seven = _mm_sub_epi32(firstLine1, thirdLine1);
-        accX = _mm_add_epi32(accX, three_minus_five);
-        accY = _mm_add_epi32(accY, one_minus_seven);
-        accX = _mm_add_epi32(accX, three_minus_five);
-        accY = _mm_add_epi32(accY, one_minus_seven);
-        accX = _mm_add_epi32(accX, six_minus_two);
-        accY = _mm_sub_epi32(accY, six_minus_two);
-
-        __m128d reg_x0 = _mm_cvtepi32_pd(accX);
-        __m128d reg_x1 = _mm_cvtepi32_pd(_mm_srli_si128(accX, 8));
-        __m128d reg_y0 = _mm_cvtepi32_pd(accY);
-        __m128d reg_y1 = _mm_cvtepi32_pd(_mm_srli_si128(accY, 8));
+        Vec firstLine0 = S::Load(firstLine);
+        Vec firstLine1 = S::Load(firstLine + 1);
+        Vec firstLine2 = S::Load(firstLine + 2);
+        Vec thirdLine0 = S::Load(thirdLine);
+        Vec thirdLine1 = S::Load(thirdLine + 1);
+        Vec thirdLine2 = S::Load(thirdLine + 2);
+        Vec accX = S::Sub(firstLine0, thirdLine2);
+        const Vec six_minus_two = S::Sub(thirdLine0, firstLine2);
+        Vec accY = accX;
+        const Vec three_minus_five =
+            S::Sub(S::Load(secondLine), S::Load(secondLine + 2));
+        const Vec one_minus_seven = S::Sub(firstLine1, thirdLine1);
+        accX = S::Add(accX, three_minus_five);
+        accY = S::Add(accY, one_minus_seven);
+        accX = S::Add(accX, three_minus_five);
+        accY = S::Add(accY, one_minus_seven);
+        accX = S::Add(accX, six_minus_two);
+        accY = S::Sub(accY, six_minus_two);
+
+        __m128d reg_x0 = S::Low(accX);
+        __m128d reg_x1 = S::High(accX);
+        __m128d reg_y0 = S::Low(accY);
+        __m128d reg_y1 = S::High(accY);
         __m128d reg_xx_plus_yy0 =
             _mm_add_pd(_mm_mul_pd(reg_x0, reg_x0), _mm_mul_pd(reg_y0, reg_y0));
         __m128d reg_xx_plus_yy1 =
@@ -1078,6 +1538,74 @@ GDALHillshadeAlg_same_res_multisample(const T *pafThreeLineWin, int nLine1Off,
     }
     return j;
 }
+
+// Vectorized GDALHillshadeAlg(), returning the shade values of 2 pixels
+// from their x and y gradients
+static inline __m128 GDALHillshadeAlg_SSE(__m128d x, __m128d y,
+                                          const GDALHillshadeAlgData *psData)
+{
+    const __m128d reg_half = _mm_set1_pd(0.5);
+    const __m128d reg_one = _mm_set1_pd(1.0);
+
+    const __m128d xx_plus_yy = _mm_add_pd(_mm_mul_pd(x, x), _mm_mul_pd(y, y));
+
+    // ... then the shade value
+    const __m128d numerator = _mm_sub_pd(
+        _mm_set1_pd(psData->sin_altRadians_mul_254),
+        _mm_sub_pd(
+            _mm_mul_pd(y,
+                       _mm_set1_pd(psData->cos_az_mul_cos_alt_mul_z_mul_254)),
+            _mm_mul_pd(x,
+                       _mm_set1_pd(psData->sin_az_mul_cos_alt_mul_z_mul_254))));
+    __m128d regB = _mm_add_pd(
+        reg_one, _mm_mul_pd(_mm_set1_pd(psData->square_z), xx_plus_yy));
+
+    // Same as ApproxADivByInvSqrtB()
+    const __m128d regB_half = _mm_mul_pd(regB, reg_half);
+    regB = _mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(regB)));
+    regB = _mm_mul_pd(
+        regB, _mm_sub_pd(_mm_set1_pd(1.5),
+                         _mm_mul_pd(regB_half, _mm_mul_pd(regB, regB))));
+    const __m128d cang_mul_254 = _mm_mul_pd(numerator, regB);
+
+    // cang_mul_254 <= 0.0 ? 1.0 : 1.0 + cang_mul_254
+    return _mm_cvtpd_ps(_mm_max_pd(reg_one, _mm_add_pd(reg_one, cang_mul_254)));
+}
+
+template <class T, GradientAlg alg>
+static int GDALHillshadeAlg_multisample(const T *pafThreeLineWin,
+                                        int nLine1Off, int nLine2Off,
+                                        int nLine3Off, int nXSize, void *pData,
+                                        float *pafOutputBuf)
+{
+    typedef GDALDEMSSE<T> S;
+    typedef typename S::Vec Vec;
+
+    const GDALHillshadeAlgData *psData =
+        static_cast<const GDALHillshadeAlgData *>(pData);
+    const __m128d reg_inv_ewres = _mm_set1_pd(psData->inv_ewres);
+    const __m128d reg_inv_nsres = _mm_set1_pd(psData->inv_nsres);
+
+    int j = 1;  // Used after for.
+    for (; j < nXSize - 4; j += 4)
+    {
+        // First Slope ...
+        Vec x, y;
+        GradientSSE<T, alg>::calc(pafThreeLineWin + nLine1Off + j - 1,
+                                  pafThreeLineWin + nLine2Off + j - 1,
+                                  pafThreeLineWin + nLine3Off + j - 1, x, y);
+
+        const __m128 res0 = GDALHillshadeAlg_SSE(
+            _mm_mul_pd(S::Low(x), reg_inv_ewres),
+            _mm_mul_pd(S::Low(y), reg_inv_nsres), psData);
+        const __m128 res1 = GDALHillshadeAlg_SSE(
+            _mm_mul_pd(S::High(x), reg_inv_ewres),
+            _mm_mul_pd(S::High(y), reg_inv_nsres), psData);
+
+        _mm_storeu_ps(pafOutputBuf + j, _mm_movelh_ps(res0, res1));
+    }
+    return j;
+}
 #endif
 
 static const double INV_SQUARE_OF_HALF_PI = 1.0 / ((M_PI * M_PI) / 4);
@@ -1307,6 +1835,67 @@ static float GDALSlopeZevenbergenThorneAlg(const T *afWin,
     return static_cast<float>(100 * (sqrt(key) / (2 * psData->scale)));
 }
 
+#ifdef HAVE_16_SSE_REG
+template <class T, GradientAlg alg>
+static int GDALSlopeAlg_multisample(const T *pafThreeLineWin, int nLine1Off,
+                                    int nLine2Off, int nLine3Off, int nXSize,
+                                    void *pData, float *pafOutputBuf)
+{
+    typedef GDALDEMSSE<T> S;
+    typedef typename S::Vec Vec;
+
+    const GDALSlopeAlgData *psData =
+        static_cast<const GDALSlopeAlgData *>(pData);
+    const __m128d reg_ewres = _mm_set1_pd(psData->ewres);
+    const __m128d reg_nsres = _mm_set1_pd(psData->nsres);
+    const __m128d reg_scale = _mm_set1_pd(
+        (alg == GradientAlg::ZEVENBERGEN_THORNE ? 2 : 8) * psData->scale);
+
+    int j = 1;  // Used after for.
+    for (; j < nXSize - 4; j += 4)
+    {
+        Vec x, y;
+        GradientSSE<T, alg>::calc(pafThreeLineWin + nLine1Off + j - 1,
+                                  pafThreeLineWin + nLine2Off + j - 1,
+                                  pafThreeLineWin + nLine3Off + j - 1, x, y);
+
+        __m128d adfSlope[2];
+        for (int k = 0; k < 2; k++)
+        {
+            const __m128d dx =
+                _mm_div_pd(k == 0 ? S::Low(x) : S::High(x), reg_ewres);
+            const __m128d dy =
+                _mm_div_pd(k == 0 ? S::Low(y) : S::High(y), reg_nsres);
+            const __m128d key =
+                _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+            adfSlope[k] = _mm_div_pd(_mm_sqrt_pd(key), reg_scale);
+        }
+
+        if (psData->slopeFormat == 1)
+        {
+            // No vectorized atan(): finish the computation pixel per pixel
+            double adfVal[4];
+            _mm_storeu_pd(adfVal, adfSlope[0]);
+            _mm_storeu_pd(adfVal + 2, adfSlope[1]);
+            for (int k = 0; k < 4; k++)
+            {
+                pafOutputBuf[j + k] =
+                    static_cast<float>(atan(adfVal[k]) * kdfRadiansToDegrees);
+            }
+        }
+        else
+        {
+            const __m128d reg_100 = _mm_set1_pd(100);
+            _mm_storeu_ps(
+                pafOutputBuf + j,
+                _mm_movelh_ps(_mm_cvtpd_ps(_mm_mul_pd(reg_100, adfSlope[0])),
+                              _mm_cvtpd_ps(_mm_mul_pd(reg_100, adfSlope[1]))));
+        }
+    }
+    return j;
+}
+#endif
+
 static void *GDALCreateSlopeData(double *adfGeoTransform, double scale,
                                  int slopeFormat)
 {
@@ -2207,11 +2796,127 @@ GDALColorInterp GDALColorReliefRasterBand::GetColorInterpretation()
     return static_cast<GDALColorInterp>(GCI_RedBand + nBand - 1);
 }
 
+/************************************************************************/
+/*                    GDALColorReliefProcessPixels()                    */
+/************************************************************************/
+
+static void GDALColorReliefProcessPixels(
+    ColorAssociation *pasColorAssociation, int nColorAssociation,
+    ColorSelectionMode eColorSelectionMode, const GByte *pabyPrecomputed,
+    int nIndexOffset, const int *panSourceBuf, const float *pafSourceBuf,
+    size_t nCount, GByte *pabyDestBuf1, GByte *pabyDestBuf2,
+    GByte *pabyDestBuf3, GByte *pabyDestBuf4)
+{
+    if (pabyPrecomputed)
+    {
+        for (size_t j = 0; j < nCount; j++)
+        {
+            int nIndex = panSourceBuf[j] + nIndexOffset;
+            pabyDestBuf1[j] = pabyPrecomputed[4 * nIndex];
+            pabyDestBuf2[j] = pabyPrecomputed[4 * nIndex + 1];
+            pabyDestBuf3[j] = pabyPrecomputed[4 * nIndex + 2];
+            pabyDestBuf4[j] = pabyPrecomputed[4 * nIndex + 3];
+        }
+    }
+    else
+    {
+        int nR = 0;
+        int nG = 0;
+        int nB = 0;
+        int nA = 0;
+
+        for (size_t j = 0; j < nCount; j++)
+        {
+            GDALColorReliefGetRGBA(pasColorAssociation, nColorAssociation,
+                                   pafSourceBuf[j], eColorSelectionMode, &nR,
+                                   &nG, &nB, &nA);
+            pabyDestBuf1[j] = static_cast<GByte>(nR);
+            pabyDestBuf2[j] = static_cast<GByte>(nG);
+            pabyDestBuf3[j] = static_cast<GByte>(nB);
+            pabyDestBuf4[j] = static_cast<GByte>(nA);
+        }
+    }
+}
+
+/************************************************************************/
+/*                   GDALColorReliefMultiThreaded()                     */
+/************************************************************************/
+
+static CPLErr GDALColorReliefMultiThreaded(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand1,
+    GDALRasterBandH hDstBand2, GDALRasterBandH hDstBand3,
+    GDALRasterBandH hDstBand4, ColorAssociation *pasColorAssociation,
+    int nColorAssociation, ColorSelectionMode eColorSelectionMode,
+    const GByte *pabyPrecomputed, int nIndexOffset, int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+    const GDALDataType eReadDT = pabyPrecomputed ? GDT_Int32 : GDT_Float32;
+    const int nLinesPerStrip =
+        GDALDEMGetLinesPerStrip(nXSize, nYSize, sizeof(float) + 4, nThreads);
+
+    const auto ReadStrip = [&](GDALDEMStripJob &oJob)
+    {
+        const size_t nPixels = static_cast<size_t>(oJob.nYSize) * nXSize;
+        oJob.abySrcBuffer.resize(nPixels * GDALGetDataTypeSizeBytes(eReadDT));
+        oJob.abyDstBuffer.resize(nPixels * 4);
+        return GDALRasterIO(hSrcBand, GF_Read, 0, oJob.nYOff, nXSize,
+                            oJob.nYSize, oJob.abySrcBuffer.data(), nXSize,
+                            oJob.nYSize, eReadDT, 0, 0);
+    };
+
+    const auto ComputeStrip = [&](GDALDEMStripJob &oJob)
+    {
+        const size_t nPixels = static_cast<size_t>(oJob.nYSize) * nXSize;
+        GByte *pabyDst = oJob.abyDstBuffer.data();
+        GDALColorReliefProcessPixels(
+            pasColorAssociation, nColorAssociation, eColorSelectionMode,
+            pabyPrecomputed, nIndexOffset,
+            reinterpret_cast<const int *>(oJob.abySrcBuffer.data()),
+            reinterpret_cast<const float *>(oJob.abySrcBuffer.data()), nPixels,
+            pabyDst, pabyDst + nPixels, pabyDst + 2 * nPixels,
+            pabyDst + 3 * nPixels);
+    };
+
+    const auto WriteStrip = [&](GDALDEMStripJob &oJob)
+    {
+        const size_t nPixels = static_cast<size_t>(oJob.nYSize) * nXSize;
+        const GDALRasterBandH ahDstBands[] = {hDstBand1, hDstBand2, hDstBand3,
+                                              hDstBand4};
+        CPLErr eErr = CE_None;
+        for (int iBand = 0; eErr == CE_None && iBand < 4; iBand++)
+        {
+            if (ahDstBands[iBand])
+            {
+                eErr = GDALRasterIO(ahDstBands[iBand], GF_Write, 0, oJob.nYOff,
+                                    nXSize, oJob.nYSize,
+                                    oJob.abyDstBuffer.data() + iBand * nPixels,
+                                    nXSize, oJob.nYSize, GDT_Byte, 0, 0);
+            }
+        }
+        return eErr;
+    };
+
+    const CPLErr eErr =
+        GDALDEMProcessStrips(nYSize, nLinesPerStrip, nThreads, ReadStrip,
+                             ComputeStrip, WriteStrip, pfnProgress,
+                             pProgressData);
+    if (eErr == CE_None)
+        pfnProgress(1.0, nullptr, pProgressData);
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                          GDALColorRelief()                           */
+/************************************************************************/
+
 static CPLErr
 GDALColorRelief(GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand1,
                 GDALRasterBandH hDstBand2, GDALRasterBandH hDstBand3,
                 GDALRasterBandH hDstBand4, const char *pszColorFilename,
-                ColorSelectionMode eColorSelectionMode,
+                ColorSelectionMode eColorSelectionMode, int nThreads,
                 GDALProgressFunc pfnProgress, void *pProgressData)
 {
     if (hSrcBand == nullptr || hDstBand1 == nullptr || hDstBand2 == nullptr ||
@@ -2236,6 +2941,27 @@ GDALColorRelief(GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand1,
         hSrcBand, pasColorAssociation, nColorAssociation, eColorSelectionMode,
         &nIndexOffset);
 
+    if (nThreads > 1)
+    {
+        CPLErr eErr = CE_Failure;
+        if (!pfnProgress(0.0, nullptr, pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        }
+        else
+        {
+            eErr = GDALColorReliefMultiThreaded(
+                hSrcBand, hDstBand1, hDstBand2, hDstBand3, hDstBand4,
+                pasColorAssociation, nColorAssociation, eColorSelectionMode,
+                pabyPrecomputed, nIndexOffset, nThreads, pfnProgress,
+                pProgressData);
+        }
+        VSIFree(pabyPrecomputed);
+        CPLFree(pasColorAssociation);
+
+        return eErr;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Initialize progress counter.                                    */
     /* -------------------------------------------------------------------- */
@@ -2281,11 +3007,6 @@ GDALColorRelief(GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand1,
         return CE_Failure;
     }
 
-    int nR = 0;
-    int nG = 0;
-    int nB = 0;
-    int nA = 0;
-
     for (int i = 0; i < nYSize; i++)
     {
         /* Read source buffer */
@@ -2304,30 +3025,10 @@ GDALColorRelief(GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand1,
             return eErr;
         }
 
-        if (pabyPrecomputed)
-        {
-            for (int j = 0; j < nXSize; j++)
-            {
-                int nIndex = panSourceBuf[j] + nIndexOffset;
-                pabyDestBuf1[j] = pabyPrecomputed[4 * nIndex];
-                pabyDestBuf2[j] = pabyPrecomputed[4 * nIndex + 1];
-                pabyDestBuf3[j] = pabyPrecomputed[4 * nIndex + 2];
-                pabyDestBuf4[j] = pabyPrecomputed[4 * nIndex + 3];
-            }
-        }
-        else
-        {
-            for (int j = 0; j < nXSize; j++)
-            {
-                GDALColorReliefGetRGBA(pasColorAssociation, nColorAssociation,
-                                       pafSourceBuf[j], eColorSelectionMode,
-                                       &nR, &nG, &nB, &nA);
-                pabyDestBuf1[j] = static_cast<GByte>(nR);
-                pabyDestBuf2[j] = static_cast<GByte>(nG);
-                pabyDestBuf3[j] = static_cast<GByte>(nB);
-                pabyDestBuf4[j] = static_cast<GByte>(nA);
-            }
-        }
+        GDALColorReliefProcessPixels(
+            pasColorAssociation, nColorAssociation, eColorSelectionMode,
+            pabyPrecomputed, nIndexOffset, panSourceBuf, pafSourceBuf, nXSize,
+            pabyDestBuf1, pabyDestBuf2, pabyDestBuf3, pabyDestBuf4);
 
         /* -----------------------------------------
          * Write Line to Raster
@@ -3393,6 +4094,8 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
     GDALGeneric3x3ProcessingAlg<GInt32>::type pfnAlgInt32 = nullptr;
     GDALGeneric3x3ProcessingAlg_multisample<GInt32>::type
         pfnAlgInt32_multisample = nullptr;
+    GDALGeneric3x3ProcessingAlg_multisample<float>::type
+        pfnAlgFloat_multisample = nullptr;
 
     if (eUtilityMode == HILL_SHADE && psOptions->bMultiDirectional)
     {
@@ -3449,6 +4152,12 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
                     GDALHillshadeAlg<float, GradientAlg::ZEVENBERGEN_THORNE>;
                 pfnAlgInt32 =
                     GDALHillshadeAlg<GInt32, GradientAlg::ZEVENBERGEN_THORNE>;
+#ifdef HAVE_16_SSE_REG
+                pfnAlgFloat_multisample = GDALHillshadeAlg_multisample<
+                    float, GradientAlg::ZEVENBERGEN_THORNE>;
+                pfnAlgInt32_multisample = GDALHillshadeAlg_multisample<
+                    GInt32, GradientAlg::ZEVENBERGEN_THORNE>;
+#endif
             }
         }
         else
@@ -3472,6 +4181,8 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
                     pfnAlgFloat = GDALHillshadeAlg_same_res<float>;
                     pfnAlgInt32 = GDALHillshadeAlg_same_res<GInt32>;
 #ifdef HAVE_16_SSE_REG
+                    pfnAlgFloat_multisample =
+                        GDALHillshadeAlg_same_res_multisample<float>;
                     pfnAlgInt32_multisample =
                         GDALHillshadeAlg_same_res_multisample<GInt32>;
 #endif
@@ -3480,6 +4191,12 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
                 {
                     pfnAlgFloat = GDALHillshadeAlg<float, GradientAlg::HORN>;
                     pfnAlgInt32 = GDALHillshadeAlg<GInt32, GradientAlg::HORN>;
+#ifdef HAVE_16_SSE_REG
+                    pfnAlgFloat_multisample =
+                        GDALHillshadeAlg_multisample<float, GradientAlg::HORN>;
+                    pfnAlgInt32_multisample =
+                        GDALHillshadeAlg_multisample<GInt32, GradientAlg::HORN>;
+#endif
                 }
             }
         }
@@ -3495,11 +4212,25 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
         {
             pfnAlgFloat = GDALSlopeZevenbergenThorneAlg<float>;
             pfnAlgInt32 = GDALSlopeZevenbergenThorneAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgFloat_multisample =
+                GDALSlopeAlg_multisample<float,
+                                         GradientAlg::ZEVENBERGEN_THORNE>;
+            pfnAlgInt32_multisample =
+                GDALSlopeAlg_multisample<GInt32,
+                                         GradientAlg::ZEVENBERGEN_THORNE>;
+#endif
         }
         else
         {
             pfnAlgFloat = GDALSlopeHornAlg<float>;
             pfnAlgInt32 = GDALSlopeHornAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgFloat_multisample =
+                GDALSlopeAlg_multisample<float, GradientAlg::HORN>;
+            pfnAlgInt32_multisample =
+                GDALSlopeAlg_multisample<GInt32, GradientAlg::HORN>;
+#endif
         }
     }
 
@@ -3692,6 +4423,10 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
         return hOutDS;
     }
 
+    const int nThreads = psOptions->bMultiThread
+                             ? GDALGetNumThreads(nullptr, true, 128, "ALL_CPUS")
+                             : 1;
+
     const int nDstBands =
         eUtilityMode == COLOR_RELIEF ? ((psOptions->bAddAlpha) ? 4 : 3) : 1;
 
@@ -3721,7 +4456,7 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
                         psOptions->bAddAlpha ? GDALGetRasterBand(hDstDataset, 4)
                                              : nullptr,
                         pszColorFilename, psOptions->eColorSelectionMode,
-                        pfnProgress, pProgressData);
+                        nThreads, pfnProgress, pProgressData);
     }
     else
     {
@@ -3732,13 +4467,15 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
         {
             GDALGeneric3x3Processing<GInt32>(
                 hSrcBand, hDstBand, pfnAlgInt32, pfnAlgInt32_multisample, pData,
-                psOptions->bComputeAtEdges, pfnProgress, pProgressData);
+                psOptions->bComputeAtEdges, nThreads, pfnProgress,
+                pProgressData);
         }
         else
         {
             GDALGeneric3x3Processing<float>(
-                hSrcBand, hDstBand, pfnAlgFloat, nullptr, pData,
-                psOptions->bComputeAtEdges, pfnProgress, pProgressData);
+                hSrcBand, hDstBand, pfnAlgFloat, pfnAlgFloat_multisample, pData,
+                psOptions->bComputeAtEdges, nThreads, pfnProgress,
+                pProgressData);
         }
     }
 
@@ -3944,6 +4681,10 @@ GDALDEMProcessingOptions *GDALDEMProcessingOptionsNew(
         {
             psOptions->bComputeAtEdges = true;
         }
+        else if (EQUAL(papszArgv[i], "-multithread"))
+        {
+            psOptions->bMultiThread = true;
+        }
         else if (i + 1 < argc &&
                  (EQUAL(papszArgv[i], "--b") || EQUAL(papszArgv[i], "-b")))
         {
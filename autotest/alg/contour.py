@@ -445,6 +445,49 @@ def test_contour_raster_acquisition_error():
         )
 
 
+###############################################################################
+# Test that the multi-threaded mode gives the same contours as the default one
+
+
+@pytest.mark.parametrize("polygonize", [False, True])
+def test_contour_multithreaded(polygonize):
+    def generate(options):
+        ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+        ogr_lyr = ogr_ds.CreateLayer(
+            "contour",
+            geom_type=ogr.wkbMultiPolygon if polygonize else ogr.wkbLineString,
+        )
+        ogr_lyr.CreateField(ogr.FieldDefn("elev", ogr.OFTReal))
+        ds = gdal.Open("data/contour_in.tif")
+        band = ds.GetRasterBand(1)
+        options = options + ["LEVEL_INTERVAL=10", "NODATA=320"]
+        if polygonize:
+            options += ["POLYGONIZE=YES", "ELEV_FIELD_MAX=0"]
+        else:
+            options += ["ELEV_FIELD=0"]
+        assert gdal.ContourGenerateEx(band, ogr_lyr, options=options) == 0
+        res = {}
+        for f in ogr_lyr:
+            geom = f.GetGeometryRef()
+            count, size = res.get(f["elev"], (0, 0))
+            res[f["elev"]] = (
+                count + 1,
+                size + (geom.GetArea() if polygonize else geom.Length()),
+            )
+        return res
+
+    ref = generate([])
+    assert ref
+
+    with gdaltest.config_option("GDAL_CONTOUR_LINES_PER_STRIP", "3"):
+        got = generate(["NUM_THREADS=4"])
+
+    assert got.keys() == ref.keys()
+    for elev in ref:
+        assert got[elev][0] == ref[elev][0], elev
+        assert got[elev][1] == pytest.approx(ref[elev][1], rel=1e-10), elev
+
+
 ###############################################################################
 # Cleanup
 
@@ -30,6 +30,7 @@
 
 import struct
 
+import gdaltest
 import pytest
 
 from osgeo import gdal
@@ -256,3 +257,137 @@ def test_fillnodata_user_provided_mask_with_smoothing():
     )
     got = [x for x in struct.unpack("f" * (5 * 5), targetBand.ReadRaster())]
     assert got == pytest.approx(expected, 1e-5)
+
+
+###############################################################################
+# Check that multi-threaded processing gives the same result as the
+# single-threaded one
+
+
+@pytest.mark.parametrize("smoothingIterations", [0, 3])
+@pytest.mark.parametrize("user_mask", [False, True])
+def test_fillnodata_multithreaded(smoothingIterations, user_mask):
+
+    width = 67
+    height = 53
+    ar = []
+    mask_ar = []
+    for y in range(height):
+        for x in range(width):
+            valid = (x * 7 + y * 13) % 5 == 0 or (x - 30) ** 2 + (y - 20) ** 2 > 200
+            ar.append(1 + ((x * 31 + y * 17) % 97) if valid else 0)
+            mask_ar.append(255 if valid else 0)
+
+    def fill(options):
+        ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, gdal.GDT_Float32)
+        band = ds.GetRasterBand(1)
+        band.SetNoDataValue(0)
+        band.WriteRaster(0, 0, width, height, struct.pack("f" * len(ar), *ar))
+        mask_band = None
+        if user_mask:
+            mask_ds = gdal.GetDriverByName("MEM").Create("", width, height)
+            mask_ds.WriteRaster(
+                0, 0, width, height, struct.pack("B" * len(mask_ar), *mask_ar)
+            )
+            mask_band = mask_ds.GetRasterBand(1)
+        gdal.FillNodata(
+            targetBand=band,
+            maskBand=mask_band,
+            maxSearchDist=20,
+            smoothingIterations=smoothingIterations,
+            options=options,
+        )
+        return band.ReadRaster()
+
+    expected = fill([])
+    with gdaltest.config_option("GDAL_FILLNODATA_LINES_PER_STRIP", "5"):
+        assert fill(["NUM_THREADS=4"]) == expected
+
+
+###############################################################################
+# Test INTERPOLATION=HARMONIC
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_fillnodata_harmonic(num_threads):
+
+    width = 50
+    height = 40
+
+    def in_hole(x, y):
+        return 10 <= x < 30 and 10 <= y < 25
+
+    ar = [
+        0 if in_hole(x, y) else x + 2 * y + 1
+        for y in range(height)
+        for x in range(width)
+    ]
+    ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, gdal.GDT_Float32)
+    band = ds.GetRasterBand(1)
+    band.SetNoDataValue(0)
+    band.WriteRaster(0, 0, width, height, struct.pack("f" * len(ar), *ar))
+
+    # A linear function is harmonic, so it must be exactly reconstructed,
+    # whatever the size of the hole.
+    gdal.FillNodata(
+        targetBand=band,
+        maskBand=None,
+        maxSearchDist=0,
+        smoothingIterations=0,
+        options=["INTERPOLATION=HARMONIC", "NUM_THREADS=" + num_threads],
+    )
+    got = struct.unpack("f" * len(ar), band.ReadRaster())
+    for y in range(height):
+        for x in range(width):
+            assert got[y * width + x] == pytest.approx(x + 2 * y + 1, abs=1e-3)
+
+    # Pixels further than maxSearchDist from valid ones are left untouched
+    band.WriteRaster(0, 0, width, height, struct.pack("f" * len(ar), *ar))
+    gdal.FillNodata(
+        targetBand=band,
+        maskBand=None,
+        maxSearchDist=3,
+        smoothingIterations=0,
+        options=["INTERPOLATION=HARMONIC", "NUM_THREADS=" + num_threads],
+    )
+    got = struct.unpack("f" * len(ar), band.ReadRaster())
+    assert got[17 * width + 20] == 0
+    assert got[10 * width + 10] != 0
+    assert got.count(0) == (20 - 6) * (15 - 6)
+
+
+###############################################################################
+# Test that maxSearchDist=0 does not limit the path length with HARMONIC
+
+
+def test_fillnodata_harmonic_unlimited_search_distance():
+
+    # The only valid pixel is in a corner, so the opposite corner is
+    # width + height - 2 pixels away through nodata pixels.
+    ds = gdal.GetDriverByName("MEM").Create("", 10, 10, 1, gdal.GDT_Float32)
+    band = ds.GetRasterBand(1)
+    band.SetNoDataValue(0)
+    band.WriteRaster(0, 0, 1, 1, struct.pack("f", 5))
+    gdal.FillNodata(
+        targetBand=band,
+        maskBand=None,
+        maxSearchDist=0,
+        smoothingIterations=0,
+        options=["INTERPOLATION=HARMONIC"],
+    )
+    got = struct.unpack("f" * 100, band.ReadRaster())
+    assert got == pytest.approx([5] * 100)
+
+
+def test_fillnodata_invalid_interpolation():
+
+    ds = gdal.GetDriverByName("MEM").Create("", 1, 1)
+    with gdaltest.error_handler():
+        ret = gdal.FillNodata(
+            targetBand=ds.GetRasterBand(1),
+            maskBand=None,
+            maxSearchDist=1,
+            smoothingIterations=0,
+            options=["INTERPOLATION=INVALID"],
+        )
+    assert ret != 0
@@ -33,6 +33,7 @@
 import struct
 from collections import defaultdict
 
+import gdaltest
 import ogrtest
 import pytest
 
@@ -402,3 +403,36 @@ def test_polygonize_7():
         assert (
             abs(value - dn_area_vector[key]) < pixel_area
         ), "polygonized vector area not match raster area"
+
+
+###############################################################################
+# Test that STREAMING=YES gives the same polygons as the default algorithm
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize(
+    "lines_per_strip,num_threads", [(None, "1"), ("1", "1"), ("3", "4")]
+)
+def test_polygonize_streaming(connectedness, lines_per_strip, num_threads):
+
+    src_ds = gdal.Open("data/polygonize_check_area.tif")
+    src_band = src_ds.GetRasterBand(1)
+
+    def polygonize(options):
+        mem_ds = ogr.GetDriverByName("Memory").CreateDataSource("out")
+        mem_layer = mem_ds.CreateLayer("poly", None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn("DN", ogr.OFTInteger))
+        if connectedness == 8:
+            options = options + ["8CONNECTED=8"]
+        assert (
+            gdal.Polygonize(src_band, src_band.GetMaskBand(), mem_layer, 0, options)
+            == 0
+        )
+        return sorted(
+            (f.GetField("DN"), f.GetGeometryRef().ExportToWkt()) for f in mem_layer
+        )
+
+    expected = polygonize([])
+    with gdaltest.config_option("GDAL_POLYGONIZE_LINES_PER_STRIP", lines_per_strip):
+        got = polygonize(["STREAMING=YES", "NUM_THREADS=" + num_threads])
+    assert got == expected
@@ -29,6 +29,10 @@
 ###############################################################################
 
 
+import math
+import struct
+
+import gdaltest
 import pytest
 
 from osgeo import gdal
@@ -126,3 +130,129 @@ def test_proximity_3():
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test ALGORITHM=EXACT against a brute force Euclidean distance computation
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        [],
+        ["VALUES=65,64", "MAXDIST=12", "NODATA=-1", "FIXED_BUF_VAL=255"],
+        ["VALUES=65,64", "MAXDIST=12", "USE_INPUT_NODATA=YES", "NODATA=0"],
+    ],
+)
+@pytest.mark.parametrize("num_threads", [None, "4"])
+def test_proximity_exact(options, num_threads):
+
+    src_ds = gdal.Open("data/pat.tif")
+    src_band = src_ds.GetRasterBand(1)
+    xsize = src_ds.RasterXSize
+    ysize = src_ds.RasterYSize
+    src_data = struct.unpack(
+        "i" * xsize * ysize, src_band.ReadRaster(buf_type=gdal.GDT_Int32)
+    )
+
+    values = None
+    maxdist = None
+    nodata = 65535
+    fixed_buf_val = None
+    use_input_nodata = False
+    for opt in options:
+        key, val = opt.split("=")
+        if key == "VALUES":
+            values = [int(x) for x in val.split(",")]
+        elif key == "MAXDIST":
+            maxdist = float(val)
+        elif key == "NODATA":
+            nodata = float(val)
+        elif key == "FIXED_BUF_VAL":
+            fixed_buf_val = float(val)
+        elif key == "USE_INPUT_NODATA":
+            use_input_nodata = True
+
+    def is_target(v):
+        return v != 0 if values is None else v in values
+
+    targets = [
+        (x, y)
+        for y in range(ysize)
+        for x in range(xsize)
+        if is_target(src_data[y * xsize + x])
+    ]
+    src_nodata = src_band.GetNoDataValue()
+    expected = []
+    for y in range(ysize):
+        for x in range(xsize):
+            dist_sq = min((x - tx) ** 2 + (y - ty) ** 2 for (tx, ty) in targets)
+            if dist_sq == 0:
+                expected.append(0.0)
+            elif (
+                use_input_nodata
+                and src_nodata is not None
+                and src_data[y * xsize + x] == src_nodata
+            ) or (maxdist is not None and dist_sq > maxdist * maxdist):
+                expected.append(nodata)
+            elif fixed_buf_val is not None:
+                expected.append(fixed_buf_val)
+            else:
+                expected.append(
+                    struct.unpack("f", struct.pack("f", math.sqrt(dist_sq)))[0]
+                )
+
+    dst_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1, gdal.GDT_Float32)
+    dst_band = dst_ds.GetRasterBand(1)
+    options = options + ["ALGORITHM=EXACT"]
+    if num_threads:
+        options.append("NUM_THREADS=" + num_threads)
+    with gdaltest.config_option("GDAL_PROXIMITY_LINES_PER_STRIP", "4"):
+        assert gdal.ComputeProximity(src_band, dst_band, options=options) == 0
+
+    got = struct.unpack("f" * xsize * ysize, dst_band.ReadRaster())
+    assert list(got) == expected
+
+
+###############################################################################
+# Test ALGORITHM=EXACT on an unsigned output band, which requires a temporary
+# working file
+
+
+def test_proximity_exact_byte_output():
+
+    src_ds = gdal.Open("data/pat.tif")
+    src_band = src_ds.GetRasterBand(1)
+
+    ref_ds = gdal.GetDriverByName("MEM").Create("", 25, 25, 1, gdal.GDT_Float32)
+    gdal.ComputeProximity(
+        src_band, ref_ds.GetRasterBand(1), options=["ALGORITHM=EXACT"]
+    )
+
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 25, 25, 1, gdal.GDT_Byte)
+    gdal.ComputeProximity(
+        src_band, dst_ds.GetRasterBand(1), options=["ALGORITHM=EXACT"]
+    )
+
+    assert dst_ds.GetRasterBand(1).ReadRaster() == ref_ds.GetRasterBand(1).ReadRaster(
+        buf_type=gdal.GDT_Byte
+    )
+
+
+###############################################################################
+# Test invalid ALGORITHM value
+
+
+def test_proximity_invalid_algorithm():
+
+    src_ds = gdal.Open("data/pat.tif")
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 25, 25, 1, gdal.GDT_Float32)
+    with gdaltest.error_handler():
+        assert (
+            gdal.ComputeProximity(
+                src_ds.GetRasterBand(1),
+                dst_ds.GetRasterBand(1),
+                options=["ALGORITHM=INVALID"],
+            )
+            != 0
+        )
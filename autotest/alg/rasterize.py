@@ -30,6 +30,7 @@
 
 import struct
 
+import gdaltest
 import ogrtest
 import pytest
 
@@ -850,3 +851,63 @@ def test_rasterize_bugfix_gh6981():
         )
         == gdal.CE_None
     )
+
+
+###############################################################################
+# Test that the multi-threaded mode gives the same result as the
+# single-threaded one
+
+
+@pytest.mark.parametrize("add", [False, True], ids=["replace", "add"])
+@pytest.mark.parametrize("all_touched", [False, True])
+def test_rasterize_multithreaded(add, all_touched):
+
+    import random
+
+    r = random.Random(0)
+
+    sr_wkt = 'LOCAL_CS["arbitrary"]'
+    sr = osr.SpatialReference(sr_wkt)
+
+    data_source = ogr.GetDriverByName("MEMORY").CreateDataSource("")
+    layer = data_source.CreateLayer("", sr)
+    layer.CreateField(ogr.FieldDefn("val", ogr.OFTReal))
+    for i in range(100):
+        x = r.uniform(-10, 100)
+        y = r.uniform(-10, 100)
+        size = r.uniform(0.5, 40)
+        points = ",".join(
+            "%.10f %.10f" % (x + r.uniform(0, size), y + r.uniform(0, size))
+            for _ in range(5)
+        )
+        if i % 3 == 0:
+            wkt = "LINESTRING (%s)" % points
+        elif i % 3 == 1:
+            wkt = "POLYGON ((%s,%s))" % (points, points.split(",")[0])
+        else:
+            wkt = "MULTIPOINT (%s)" % points
+        feature = ogr.Feature(layer.GetLayerDefn())
+        feature["val"] = i + 1
+        feature.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        layer.CreateFeature(feature)
+
+    def rasterize():
+        ds = gdal.GetDriverByName("MEM").Create("", 97, 89, 2, gdal.GDT_Float32)
+        ds.SetGeoTransform([0, 1, 0, 89, 0, -1])
+        ds.SetProjection(sr_wkt)
+        gdal.Rasterize(
+            ds,
+            data_source,
+            bands=[1, 2],
+            attribute="val",
+            allTouched=all_touched,
+            add=add,
+        )
+        return ds.ReadRaster()
+
+    ref = rasterize()
+    with gdaltest.config_options(
+        {"GDAL_NUM_THREADS": "4", "GDAL_RASTERIZE_TILE_SIZE": "16"}
+    ):
+        got = rasterize()
+    assert got == ref
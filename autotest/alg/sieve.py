@@ -30,6 +30,7 @@
 ###############################################################################
 
 
+import gdaltest
 import pytest
 
 from osgeo import gdal
@@ -345,3 +346,48 @@ cellsize     60.000000000000
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test that STREAMING=YES gives the same result as the default algorithm
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("threshold", [2, 10, 100])
+@pytest.mark.parametrize(
+    "lines_per_strip,num_threads", [(None, "1"), ("1", "1"), ("3", "4")]
+)
+@pytest.mark.parametrize("in_place", [False, True])
+def test_sieve_streaming(
+    connectedness, threshold, lines_per_strip, num_threads, in_place
+):
+
+    src_ds = gdal.Open("data/polygonize_check_area.tif")
+
+    def sieve(options):
+        ds = gdal.GetDriverByName("MEM").CreateCopy("", src_ds)
+        src_band = ds.GetRasterBand(1)
+        if in_place:
+            dst_band = src_band
+        else:
+            dst_ds = gdal.GetDriverByName("MEM").Create(
+                "", ds.RasterXSize, ds.RasterYSize, 1, src_band.DataType
+            )
+            dst_band = dst_ds.GetRasterBand(1)
+        assert (
+            gdal.SieveFilter(
+                src_band,
+                src_band.GetMaskBand(),
+                dst_band,
+                threshold,
+                connectedness,
+                options=options,
+            )
+            == 0
+        )
+        return dst_band.ReadRaster()
+
+    expected = sieve([])
+    with gdaltest.config_option("GDAL_SIEVE_LINES_PER_STRIP", lines_per_strip):
+        got = sieve(["STREAMING=YES", "NUM_THREADS=" + num_threads])
+    assert got == expected
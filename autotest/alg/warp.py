@@ -1667,7 +1667,9 @@ def test_warp_52():
 # Test Grey+Alpha
 
 
-@pytest.mark.parametrize("typestr", ("Byte", "UInt16", "Int16"))
+@pytest.mark.parametrize(
+    "typestr", ("Byte", "UInt16", "Int16", "Int32", "UInt32", "Int64", "UInt64")
+)
 @pytest.mark.parametrize(
     "option", ("-wo USE_GENERAL_CASE=TRUE", ""), ids=["generalCase", "default"]
 )
@@ -1904,6 +1906,62 @@ def test_warp_mode_ties():
     assert out_ds.GetRasterBand(1).ReadAsArray()[0, 0] == 5
 
 
+###############################################################################
+# Test average/rms/min/max/mode with integer downsampling factors, where
+# source windows are made of whole pixels
+
+
+@pytest.mark.parametrize("resampling", ["average", "rms", "min", "max", "mode", "med"])
+@pytest.mark.parametrize("datatype", [gdal.GDT_Byte, gdal.GDT_UInt16, gdal.GDT_Float32])
+def test_warp_average_or_mode_integer_factor(resampling, datatype):
+    numpy = pytest.importorskip("numpy")
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 60, 40, 1, datatype)
+    src_ds.SetGeoTransform([1000, 0.1, 0, 2000, 0, -0.1])
+    numpy.random.seed(0)
+    values = numpy.random.randint(0, 5, size=(40, 60)) * 37
+    src_ds.GetRasterBand(1).WriteArray(values)
+
+    out_ds = gdal.Warp(
+        "",
+        src_ds,
+        format="MEM",
+        resampleAlg=resampling,
+        xRes=0.3,
+        yRes=0.4,
+    )
+    got = out_ds.GetRasterBand(1).ReadAsArray()
+
+    blocks = values.reshape(10, 4, 20, 3).swapaxes(1, 2).reshape(10, 20, 12)
+    if resampling == "average":
+        expected = blocks.mean(axis=2)
+    elif resampling == "rms":
+        expected = numpy.sqrt((blocks.astype(numpy.float64) ** 2).mean(axis=2))
+    elif resampling == "min":
+        expected = blocks.min(axis=2)
+    elif resampling == "max":
+        expected = blocks.max(axis=2)
+    elif resampling == "med":
+        expected = numpy.sort(blocks, axis=2)[:, :, 5]
+    else:
+        # Ties are resolved by the value first reaching the maximum count.
+        expected = numpy.empty((10, 20))
+        for j in range(10):
+            for i in range(20):
+                counts = {}
+                best, best_count = None, 0
+                for v in blocks[j, i]:
+                    counts[v] = counts.get(v, 0) + 1
+                    if counts[v] > best_count:
+                        best, best_count = v, counts[v]
+                expected[j, i] = best
+
+    if datatype == gdal.GDT_Float32:
+        assert numpy.allclose(got, expected, rtol=1e-6, atol=0)
+    else:
+        assert numpy.array_equal(got, numpy.floor(expected + 0.5))
+
+
 ###############################################################################
 # Test bugfix for #6526
 
@@ -1912,3 +1970,27 @@ def test_warp_max_downsampling_missed_edges():
 
     ds = gdal.Open("data/bug_6526_warped.vrt")
     assert ds.GetRasterBand(1).ComputeRasterMinMax() == (1, 1)
+
+
+###############################################################################
+# Test that nearest neighbour resampling of 64-bit integer values is exact
+
+
+@pytest.mark.parametrize(
+    "datatype,fmt", [(gdal.GDT_Int64, "q"), (gdal.GDT_UInt64, "Q")]
+)
+def test_warp_nearest_int64_exact(datatype, fmt):
+
+    values = (
+        (1 << 62) + 1,
+        (1 << 62) + 3,
+        ((1 << 63) - 1) if fmt == "q" else ((1 << 64) - 1),
+        0,
+    )
+    src_ds = gdal.GetDriverByName("MEM").Create("", 2, 2, 1, datatype)
+    src_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    src_ds.GetRasterBand(1).WriteRaster(0, 0, 2, 2, struct.pack(fmt * 4, *values))
+    with gdaltest.config_option("GDAL_WARP_USE_TRANSLATION_OPTIM", "NO"):
+        out_ds = gdal.Warp("", src_ds, format="MEM")
+    got = struct.unpack(fmt * 4, out_ds.GetRasterBand(1).ReadRaster())
+    assert got == values
@@ -30,6 +30,7 @@
 #include "gdal_unit_test.h"
 
 #include "cpl_conv.h"
+#include "cpl_string.h"
 
 #include "gdal_alg.h"
 #include "gdalwarper.h"
@@ -37,6 +38,10 @@
 
 #include "gtest_include.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace
 {
 // Common fixture with test data
@@ -273,4 +278,149 @@ TEST_F(test_alg, GDALAutoCreateWarpedVRT_alpha_band)
     GDALClose(hWarpedVRT);
 }
 
+// Create a synthetic MEM DEM for viewshed tests
+static GDALDatasetUniquePtr CreateViewshedTestDEM()
+{
+    const int nSize = 97;
+    GDALDatasetUniquePtr poDS(
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+            ->Create("", nSize, nSize, 1, GDT_Float32, nullptr));
+    double adfGeoTransform[6] = {0, 10, 0, nSize * 10, 0, -10};
+    poDS->SetGeoTransform(adfGeoTransform);
+    std::vector<float> afDEM(nSize * nSize);
+    for (int iY = 0; iY < nSize; iY++)
+    {
+        for (int iX = 0; iX < nSize; iX++)
+        {
+            afDEM[iY * nSize + iX] = static_cast<float>(
+                100 + 30 * std::sin(iX * 0.21) * std::cos(iY * 0.17) +
+                ((iX * 7 + iY * 13) % 11));
+        }
+    }
+    CPL_IGNORE_RET_VAL(poDS->GetRasterBand(1)->RasterIO(
+        GF_Write, 0, 0, nSize, nSize, afDEM.data(), nSize, nSize,
+        GDT_Float32, 0, 0, nullptr));
+    return poDS;
+}
+
+// Read a whole band as doubles
+static std::vector<double> ReadViewshedBand(GDALDatasetH hDS)
+{
+    GDALRasterBandH hBand = GDALGetRasterBand(hDS, 1);
+    const int nXSize = GDALGetRasterBandXSize(hBand);
+    const int nYSize = GDALGetRasterBandYSize(hBand);
+    std::vector<double> adfValues(static_cast<size_t>(nXSize) * nYSize);
+    CPL_IGNORE_RET_VAL(GDALRasterIO(hBand, GF_Read, 0, 0, nXSize, nYSize,
+                                    adfValues.data(), nXSize, nYSize,
+                                    GDT_Float64, 0, 0));
+    return adfValues;
+}
+
+// Test that GDALViewshedGenerate() gives the same result whatever the
+// number of threads
+TEST_F(test_alg, GDALViewshedGenerate_multithreaded)
+{
+    auto poDEM = CreateViewshedTestDEM();
+    GDALRasterBandH hBand = GDALRasterBand::ToHandle(poDEM->GetRasterBand(1));
+    for (const auto heightMode :
+         {GVOT_NORMAL, GVOT_MIN_TARGET_HEIGHT_FROM_DEM,
+          GVOT_MIN_TARGET_HEIGHT_FROM_GROUND})
+    {
+        std::vector<double> adfRef;
+        for (const char *pszThreads : {"1", "4"})
+        {
+            CPLStringList aosOptions;
+            aosOptions.SetNameValue("NUM_THREADS", pszThreads);
+            GDALDatasetH hOut = GDALViewshedGenerate(
+                hBand, "MEM", "", nullptr, 455, 385, 10, 2, 255, 0, 1, -1,
+                0.85714, GVM_Edge, 300, nullptr, nullptr, heightMode,
+                aosOptions.List());
+            ASSERT_TRUE(hOut != nullptr);
+            const auto adfValues = ReadViewshedBand(hOut);
+            GDALClose(hOut);
+            if (adfRef.empty())
+                adfRef = adfValues;
+            else
+                EXPECT_EQ(adfValues, adfRef);
+        }
+    }
+}
+
+// Test that GDALViewshedGenerateCumulative() counts the number of observers
+// from which each cell is visible
+TEST_F(test_alg, GDALViewshedGenerateCumulative)
+{
+    auto poDEM = CreateViewshedTestDEM();
+    GDALRasterBandH hBand = GDALRasterBand::ToHandle(poDEM->GetRasterBand(1));
+    const double adfX[] = {155, 505, 805};
+    const double adfY[] = {205, 555, 305};
+    std::vector<double> adfExpected(97 * 97);
+    for (int i = 0; i < 3; i++)
+    {
+        GDALDatasetH hOut = GDALViewshedGenerate(
+            hBand, "MEM", "", nullptr, adfX[i], adfY[i], 10, 2, 1, 0, 0, -1,
+            0.85714, GVM_Edge, 0, nullptr, nullptr, GVOT_NORMAL, nullptr);
+        ASSERT_TRUE(hOut != nullptr);
+        // Individual viewsheds are cropped to the observer extent: paste them
+        // back into the full DEM grid.
+        double adfGT[6];
+        GDALGetGeoTransform(hOut, adfGT);
+        const int nXOff = static_cast<int>(adfGT[0] / 10 + 0.5);
+        const int nYOff = static_cast<int>((970 - adfGT[3]) / 10 + 0.5);
+        const int nXSize = GDALGetRasterXSize(hOut);
+        const auto adfValues = ReadViewshedBand(hOut);
+        for (size_t j = 0; j < adfValues.size(); j++)
+        {
+            const int iX = nXOff + static_cast<int>(j % nXSize);
+            const int iY = nYOff + static_cast<int>(j / nXSize);
+            adfExpected[iY * 97 + iX] += adfValues[j];
+        }
+        GDALClose(hOut);
+    }
+
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("NUM_THREADS", "2");
+    GDALDatasetH hOut = GDALViewshedGenerateCumulative(
+        hBand, "MEM", "", nullptr, 3, adfX, adfY, 10, 2, 0.85714, GVM_Edge, 0,
+        nullptr, nullptr, aosOptions.List());
+    ASSERT_TRUE(hOut != nullptr);
+    EXPECT_EQ(GDALGetRasterDataType(GDALGetRasterBand(hOut, 1)), GDT_UInt32);
+    EXPECT_EQ(ReadViewshedBand(hOut), adfExpected);
+    GDALClose(hOut);
+}
+
+// Test that GDALViewshedGenerateCumulative() gives the same counts whatever
+// the number of threads
+TEST_F(test_alg, GDALViewshedGenerateCumulative_multithreaded)
+{
+    auto poDEM = CreateViewshedTestDEM();
+    GDALRasterBandH hBand = GDALRasterBand::ToHandle(poDEM->GetRasterBand(1));
+    std::vector<double> adfX;
+    std::vector<double> adfY;
+    for (int i = 0; i < 25; i++)
+    {
+        adfX.push_back(55 + 180 * (i % 5));
+        adfY.push_back(65 + 190 * (i / 5));
+    }
+    std::vector<double> adfRef;
+    for (const char *pszThreads : {"1", "4"})
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("NUM_THREADS", pszThreads);
+        GDALDatasetH hOut = GDALViewshedGenerateCumulative(
+            hBand, "MEM", "", nullptr, static_cast<int>(adfX.size()),
+            adfX.data(), adfY.data(), 10, 2, 0.85714, GVM_Edge, 0, nullptr,
+            nullptr, aosOptions.List());
+        ASSERT_TRUE(hOut != nullptr);
+        const auto adfValues = ReadViewshedBand(hOut);
+        GDALClose(hOut);
+        if (adfRef.empty())
+            adfRef = adfValues;
+        else
+            EXPECT_EQ(adfValues, adfRef);
+    }
+    // Several observers see each cell close to them
+    EXPECT_GT(*std::max_element(adfRef.begin(), adfRef.end()), 1);
+}
+
 }  // namespace
@@ -1611,3 +1611,98 @@ def test_cog_overview_count_existing():
     assert ds.GetRasterBand(1).GetOverview(0).Checksum() == 0
     ds = None
     gdal.Unlink(tmpfilename)
+
+
+###############################################################################
+# Test that the raw tiles of the temporary overview file are copied, and that
+# this gives the same result as decoding and re-encoding them
+
+
+@pytest.mark.parametrize("with_mask", [False, True])
+@pytest.mark.parametrize(
+    "options",
+    [
+        ["COMPRESS=LZW"],
+        ["COMPRESS=DEFLATE", "PREDICTOR=YES", "LEVEL=1"],
+        ["COMPRESS=DEFLATE", "BLOCKSIZE=64", "SPARSE_OK=YES"],
+        ["COMPRESS=NONE", "BLOCKSIZE=96"],
+    ],
+)
+def test_cog_overview_raw_tile_copy(options, with_mask):
+
+    tmpfilename = "/vsimem/test_cog_overview_raw_tile_copy.tif"
+    tmpfilename_ref = "/vsimem/test_cog_overview_raw_tile_copy_ref.tif"
+
+    src_ds = gdal.Open("data/byte.tif")
+    src_ds = gdal.Translate("", src_ds, format="MEM", width=400, height=300)
+    src_ds.GetRasterBand(1).WriteRaster(0, 0, 200, 150, b"\x00" * (200 * 150))
+    if with_mask:
+        src_ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+        src_ds.GetRasterBand(1).GetMaskBand().Fill(255)
+        src_ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+            100, 50, 250, 200, b"\x00" * (250 * 200)
+        )
+
+    class my_error_handler(object):
+        def __init__(self):
+            self.debug_msg_list = []
+
+        def handler(self, eErrClass, err_no, msg):
+            if eErrClass == gdal.CE_Debug:
+                self.debug_msg_list.append(msg)
+
+    handler = my_error_handler()
+    try:
+        gdal.PushErrorHandler(handler.handler)
+        gdal.SetCurrentErrorHandlerCatchDebug(True)
+        with gdaltest.config_option("CPL_DEBUG", "GTiff"):
+            ds = gdal.GetDriverByName("COG").CreateCopy(
+                tmpfilename, src_ds, options=options + ["OVERVIEW_RESAMPLING=AVERAGE"]
+            )
+            ds = None
+    finally:
+        gdal.PopErrorHandler()
+    _check_cog(tmpfilename)
+
+    with gdaltest.config_option("GTIFF_COPY_RAW_TILES", "NO"):
+        ds = gdal.GetDriverByName("COG").CreateCopy(
+            tmpfilename_ref,
+            src_ds,
+            options=options + ["OVERVIEW_RESAMPLING=AVERAGE"],
+        )
+        ds = None
+    _check_cog(tmpfilename_ref)
+
+    ds = gdal.Open(tmpfilename)
+    ds_ref = gdal.Open(tmpfilename_ref)
+    ovr_count = ds.GetRasterBand(1).GetOverviewCount()
+    assert ovr_count > 0
+    assert ovr_count == ds_ref.GetRasterBand(1).GetOverviewCount()
+
+    # Check that all overview levels went through the raw tile copy
+    raw_copy_msg_list = [
+        msg for msg in handler.debug_msg_list if "Copying raw tiles" in msg
+    ]
+    assert raw_copy_msg_list == [
+        "GTiff: Copying raw tiles of overview level %d" % i
+        for i in reversed(range(ovr_count))
+    ]
+
+    for i in range(ovr_count):
+        ovr = ds.GetRasterBand(1).GetOverview(i)
+        ovr_ref = ds_ref.GetRasterBand(1).GetOverview(i)
+        assert ovr.GetBlockSize() == ovr_ref.GetBlockSize()
+        assert ovr.Checksum() == ovr_ref.Checksum()
+        if with_mask:
+            assert ovr.GetMaskFlags() == gdal.GMF_PER_DATASET
+            assert ovr.GetMaskBand().Checksum() == ovr_ref.GetMaskBand().Checksum()
+    if with_mask:
+        assert (
+            ds.GetRasterBand(1).GetMaskBand().Checksum()
+            == ds_ref.GetRasterBand(1).GetMaskBand().Checksum()
+        )
+    ds = None
+    ds_ref = None
+
+    gdal.Unlink(tmpfilename)
+    gdal.Unlink(tmpfilename_ref)
@@ -905,3 +905,70 @@ def test_stats_computeminmax(datatype, minval, maxval, nodata):
         buf_ysize=1,
     )
     assert ds.GetRasterBand(1).ComputeRasterMinMax(0) == (expected_minval, maxval)
+
+
+###############################################################################
+# Test that multi-threaded statistics, min/max and histogram computations
+# give the same results as single-threaded ones
+
+
+@pytest.mark.parametrize(
+    "datatype,struct_frmt",
+    [
+        (gdal.GDT_Byte, "B"),
+        (gdal.GDT_Int16, "h"),
+        (gdal.GDT_UInt16, "H"),
+        (gdal.GDT_Int32, "i"),
+        (gdal.GDT_Float32, "f"),
+        (gdal.GDT_Float64, "d"),
+    ],
+)
+@pytest.mark.parametrize("nodata", [None, 7])
+def test_stats_multithreaded(datatype, struct_frmt, nodata):
+
+    width = 67
+    height = 53
+    ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, datatype)
+    band = ds.GetRasterBand(1)
+    if nodata is not None:
+        band.SetNoDataValue(nodata)
+
+    values = []
+    valid_values = []
+    for i in range(width * height):
+        v = (i * 7919) % 251
+        if datatype in (gdal.GDT_Int16, gdal.GDT_Int32):
+            v -= 100
+        elif datatype in (gdal.GDT_Float32, gdal.GDT_Float64):
+            v = v * 0.5 - 50
+            if i % 97 == 0:
+                v = float("nan")
+        values.append(v)
+        if v == v and v != nodata:
+            valid_values.append(v)
+    band.WriteRaster(
+        0, 0, width, height, struct.pack(struct_frmt * (width * height), *values)
+    )
+
+    def compute():
+        return (
+            band.ComputeStatistics(False),
+            band.ComputeRasterMinMax(False),
+            band.GetHistogram(-0.5, 200.5, 40, include_out_of_range=1, approx_ok=0),
+            band.GetHistogram(-0.5, 200.5, 40, include_out_of_range=0, approx_ok=0),
+        )
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "1"):
+        ref = compute()
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        got = compute()
+
+    assert got == ref
+
+    mean = sum(valid_values) / len(valid_values)
+    stddev = (sum((v - mean) ** 2 for v in valid_values) / len(valid_values)) ** 0.5
+    assert ref[0] == pytest.approx(
+        [min(valid_values), max(valid_values), mean, stddev], rel=1e-12
+    )
+    assert ref[1] == (min(valid_values), max(valid_values))
+    assert sum(ref[2]) == len(valid_values)
@@ -2753,6 +2753,72 @@ def test_tiff_ovr_internal_overview_different_planar_config_to_band():
     gdal.GetDriverByName("GTiff").Delete(temp_path)
 
 
+###############################################################################
+# Test that computing lossless overviews in cascade from the previous level
+# kept in memory gives the same result as reading back the previous level
+
+
+@pytest.mark.parametrize(
+    "resampling,nodata,num_threads",
+    [
+        ("NEAREST", None, "1"),
+        ("AVERAGE", None, "1"),
+        ("AVERAGE", 0, "2"),
+        ("CUBIC", None, "2"),
+        ("CUBIC", 0, "1"),
+        ("GAUSS", None, "1"),
+        ("LANCZOS", None, "1"),
+        ("MODE", None, "1"),
+    ],
+)
+@pytest.mark.parametrize("external", [False, True])
+def test_tiff_ovr_cascading(resampling, nodata, num_threads, external):
+
+    src_ds = gdal.Translate("", "data/byte.tif", format="MEM", width=1001, height=777)
+    src_ds.GetRasterBand(1).WriteRaster(0, 0, 300, 200, b"\x00" * (300 * 200))
+    src_ds.AddBand(gdal.GDT_Byte)
+    src_ds.GetRasterBand(2).WriteRaster(
+        0, 0, 1001, 777, src_ds.GetRasterBand(1).ReadRaster()[::-1]
+    )
+    if nodata is not None:
+        src_ds.GetRasterBand(1).SetNoDataValue(nodata)
+        src_ds.GetRasterBand(2).SetNoDataValue(nodata)
+
+    def build(filename, cascading):
+        if external:
+            gdal.GetDriverByName("GTiff").CreateCopy(filename, src_ds)
+            ds = gdal.Open(filename)
+        else:
+            ds = gdal.GetDriverByName("GTiff").CreateCopy(
+                filename, src_ds, options=["COMPRESS=DEFLATE", "TILED=YES"]
+            )
+        with gdaltest.config_options(
+            {
+                "COMPRESS_OVERVIEW": "DEFLATE",
+                "GDAL_NUM_THREADS": num_threads,
+                "GDAL_OVR_CASCADING": "YES" if cascading else "NO",
+            }
+        ):
+            ds.BuildOverviews(resampling, [2, 4, 8, 16])
+        ds = None
+        ds = gdal.Open(filename)
+        ret = [
+            [
+                ds.GetRasterBand(i + 1).GetOverview(j).Checksum()
+                for j in range(ds.GetRasterBand(i + 1).GetOverviewCount())
+            ]
+            for i in range(ds.RasterCount)
+        ]
+        ds = None
+        gdal.GetDriverByName("GTiff").Delete(filename)
+        return ret
+
+    got = build("/vsimem/test_tiff_ovr_cascading.tif", True)
+    expected = build("/vsimem/test_tiff_ovr_cascading_ref.tif", False)
+    assert len(got[0]) == 4
+    assert got == expected
+
+
 ###############################################################################
 # Cleanup
 
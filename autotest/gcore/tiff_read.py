@@ -4844,6 +4844,156 @@ def test_tiff_read_multi_threaded(
     gdal.Unlink(tmpfile)
 
 
+###############################################################################
+# Test multi-threaded decoding into the block cache, for resampled requests,
+# AdviseRead() and sequential block reads
+
+
+@pytest.mark.parametrize(
+    "creation_options",
+    [
+        ["COMPRESS=DEFLATE", "TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32"],
+        [
+            "COMPRESS=DEFLATE",
+            "TILED=YES",
+            "BLOCKXSIZE=32",
+            "BLOCKYSIZE=32",
+            "INTERLEAVE=BAND",
+        ],
+        ["COMPRESS=LZW", "BLOCKYSIZE=8"],
+        ["COMPRESS=LZW", "BLOCKYSIZE=8", "INTERLEAVE=BAND"],
+    ],
+)
+def test_tiff_read_multi_threaded_predecode(creation_options):
+
+    ref_ds = gdal.GetDriverByName("MEM").Create("", 150, 130, 3)
+    for band in range(ref_ds.RasterCount):
+        buf = b""
+        for j in range(ref_ds.RasterYSize):
+            buf += array.array(
+                "B",
+                [(band * 10 + j * i) % 256 for i in range(ref_ds.RasterXSize)],
+            )
+        ref_ds.GetRasterBand(band + 1).WriteRaster(
+            0, 0, ref_ds.RasterXSize, ref_ds.RasterYSize, buf
+        )
+
+    tmpfile = "/vsimem/test_tiff_read_multi_threaded_predecode.tif"
+    gdal.GetDriverByName("GTiff").CreateCopy(tmpfile, ref_ds, options=creation_options)
+
+    try:
+        ds = gdal.OpenEx(tmpfile, open_options=["NUM_THREADS=4"])
+
+        # Resampled requests
+        for resampling in (gdal.GRIORA_NearestNeighbour, gdal.GRIORA_Bilinear):
+            assert ds.ReadRaster(
+                1, 2, 140, 120, 35, 30, resample_alg=resampling
+            ) == ref_ds.ReadRaster(1, 2, 140, 120, 35, 30, resample_alg=resampling)
+            ds.FlushCache()
+            assert ds.GetRasterBand(2).ReadRaster(
+                buf_xsize=75, buf_ysize=65, resample_alg=resampling
+            ) == ref_ds.GetRasterBand(2).ReadRaster(
+                buf_xsize=75, buf_ysize=65, resample_alg=resampling
+            )
+            ds.FlushCache()
+
+        # AdviseRead() followed by block reads
+        assert ds.AdviseRead(10, 20, 100, 90) == gdal.CE_None
+        assert ds.GetRasterBand(3).AdviseRead(0, 0, 150, 130) == gdal.CE_None
+        for band in range(ds.RasterCount):
+            assert ds.GetRasterBand(band + 1).ReadRaster(
+                10, 20, 100, 90
+            ) == ref_ds.GetRasterBand(band + 1).ReadRaster(10, 20, 100, 90)
+        ds.FlushCache()
+
+        # AdviseRead() followed by block reads not going through RasterIO()
+        assert ds.AdviseRead(0, 0, 150, 130) == gdal.CE_None
+        for band in range(ds.RasterCount):
+            assert (
+                ds.GetRasterBand(band + 1).Checksum()
+                == ref_ds.GetRasterBand(band + 1).Checksum()
+            )
+        ds.FlushCache()
+
+        # AdviseRead() pending when the cache is flushed, or the dataset closed
+        assert ds.AdviseRead(0, 0, 150, 130) == gdal.CE_None
+        ds.FlushCache()
+        assert ds.AdviseRead(0, 0, 150, 130) == gdal.CE_None
+        ds = None
+        ds = gdal.OpenEx(tmpfile, open_options=["NUM_THREADS=4"])
+
+        # Sequential block reads
+        for band in range(ds.RasterCount):
+            assert (
+                ds.GetRasterBand(band + 1).Checksum()
+                == ref_ds.GetRasterBand(band + 1).Checksum()
+            )
+            assert ds.GetRasterBand(band + 1).ComputeRasterMinMax(
+                False
+            ) == ref_ds.GetRasterBand(band + 1).ComputeRasterMinMax(False)
+        ds = None
+    finally:
+        gdal.Unlink(tmpfile)
+
+
+###############################################################################
+# Test that the tiles of a local file read through io_uring are fetched with
+# a single VSIFReadMultiRangeL() call
+
+
+@pytest.mark.skipif(sys.platform != "linux", reason="io_uring is Linux only")
+@pytest.mark.parametrize("use_io_uring", ["YES", "NO"])
+def test_tiff_read_local_pread_multi_range(tmp_path, use_io_uring):
+
+    filename = str(tmp_path / "test.tif")
+    src_ds = gdal.Open("data/byte.tif")
+    gdal.Translate(
+        filename,
+        src_ds,
+        creationOptions=[
+            "TILED=YES",
+            "BLOCKXSIZE=16",
+            "BLOCKYSIZE=16",
+            "COMPRESS=DEFLATE",
+        ],
+    )
+
+    debug_msg_list = []
+
+    def handler(eErrClass, err_no, msg):
+        if eErrClass == gdal.CE_Debug:
+            debug_msg_list.append(msg)
+
+    with gdaltest.config_options(
+        {
+            "CPL_VSIL_LOCAL_USE_PREAD": "YES",
+            "CPL_VSIL_LOCAL_USE_IO_URING": use_io_uring,
+            "CPL_DEBUG": "ON",
+        }
+    ):
+        ds = gdal.Open(filename)
+        gdal.PushErrorHandler(handler)
+        gdal.SetCurrentErrorHandlerCatchDebug(True)
+        try:
+            data = ds.ReadRaster()
+        finally:
+            gdal.PopErrorHandler()
+        ds = None
+
+    assert data == src_ds.ReadRaster()
+
+    batch_msg_list = [
+        msg for msg in debug_msg_list if "with VSIFReadMultiRangeL()" in msg
+    ]
+    if use_io_uring == "NO":
+        assert batch_msg_list == []
+    elif not batch_msg_list:
+        pytest.skip("io_uring not available")
+    else:
+        assert len(batch_msg_list) == 1
+        assert batch_msg_list[0].startswith("GTiff: Fetching 4 blocks in ")
+
+
 ###############################################################################
 # Test multi-threaded decoding with /vsicurl
 
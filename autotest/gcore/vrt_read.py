@@ -2105,3 +2105,118 @@ def test_vrt_read_compute_statistics_mosaic_optimization_not_triggered():
 
     vrt_stats = vrt_ds.GetRasterBand(1).ComputeStatistics(False)
     assert vrt_stats == src_ds.GetRasterBand(1).ComputeStatistics(False)
+
+
+###############################################################################
+# Test multi-threaded IRasterIO() with overlapping sources from a same file
+
+
+@pytest.mark.parametrize("num_threads", ["2", "ALL_CPUS"])
+def test_vrt_read_multi_threaded_overlapping_sources(num_threads):
+
+    src_filename = "/vsimem/test_vrt_read_multi_threaded_overlapping_sources.tif"
+    src_ds = gdal.GetDriverByName("GTiff").Create(
+        src_filename, 300, 600, 2, options=["TILED=YES"]
+    )
+    for i in range(2):
+        src_ds.GetRasterBand(i + 1).WriteRaster(
+            0,
+            0,
+            300,
+            600,
+            bytes([(x * 7 + i) % 253 for x in range(300 * 600)]),
+        )
+    src_ds = None
+
+    vrt_xml = "<VRTDataset rasterXSize='400' rasterYSize='700'>"
+    for band in (1, 2):
+        vrt_xml += f"""<VRTRasterBand dataType='Byte' band='{band}'>
+            <NoDataValue>255</NoDataValue>
+            <SimpleSource>
+              <SourceFilename>{src_filename}</SourceFilename>
+              <SourceBand>{band}</SourceBand>
+              <SrcRect xOff='0' yOff='0' xSize='300' ySize='600'/>
+              <DstRect xOff='0' yOff='0' xSize='300' ySize='600'/>
+            </SimpleSource>
+            <ComplexSource>
+              <SourceFilename>{src_filename}</SourceFilename>
+              <SourceBand>{3 - band}</SourceBand>
+              <SrcRect xOff='10' yOff='20' xSize='280' ySize='500'/>
+              <DstRect xOff='100' yOff='150' xSize='280' ySize='500'/>
+              <NODATA>0</NODATA>
+            </ComplexSource>
+            <SimpleSource>
+              <SourceFilename>{src_filename}</SourceFilename>
+              <SourceBand>{band}</SourceBand>
+              <SrcRect xOff='0' yOff='0' xSize='300' ySize='600'/>
+              <DstRect xOff='50' yOff='250' xSize='150' ySize='300'/>
+            </SimpleSource>
+          </VRTRasterBand>"""
+    vrt_xml += "</VRTDataset>"
+
+    try:
+        vrt_ds = gdal.Open(vrt_xml)
+        expected_band = vrt_ds.GetRasterBand(2).ReadRaster()
+        expected_ds = vrt_ds.ReadRaster()
+        vrt_ds = None
+
+        with gdaltest.config_option("VRT_NUM_THREADS", num_threads):
+            vrt_ds = gdal.Open(vrt_xml)
+            assert vrt_ds.GetRasterBand(2).ReadRaster() == expected_band
+            assert vrt_ds.ReadRaster() == expected_ds
+            # Second read re-uses the per-thread clones
+            assert (
+                vrt_ds.ReadRaster(band_list=[2, 1])
+                == vrt_ds.GetRasterBand(2).ReadRaster()
+                + vrt_ds.GetRasterBand(1).ReadRaster()
+            )
+            vrt_ds = None
+    finally:
+        gdal.Unlink(src_filename)
+
+
+###############################################################################
+# Test multi-threaded IRasterIO() with GDAL_NUM_THREADS also applying to
+# the sources, and that modifications of the VRT are taken into account
+
+
+def test_vrt_read_multi_threaded_compressed_source_and_modified():
+
+    src_filename = (
+        "/vsimem/test_vrt_read_multi_threaded_compressed_source_and_modified.tif"
+    )
+    src_ds = gdal.GetDriverByName("GTiff").Create(
+        src_filename,
+        300,
+        600,
+        1,
+        options=["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32", "COMPRESS=DEFLATE"],
+    )
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, 300, 600, bytes([(x * 7) % 253 for x in range(300 * 600)])
+    )
+    src_ds = None
+
+    try:
+        ref_ds = gdal.Translate("", src_filename, format="VRT")
+        expected = ref_ds.ReadRaster()
+
+        with gdaltest.config_option("GDAL_NUM_THREADS", "2"):
+            vrt_ds = gdal.Translate("", src_filename, format="VRT")
+            assert vrt_ds.ReadRaster() == expected
+
+            # Add a source after a multi-threaded read
+            source_xml = f"""<SimpleSource>
+              <SourceFilename>{src_filename}</SourceFilename>
+              <SourceBand>1</SourceBand>
+              <SrcRect xOff='0' yOff='0' xSize='100' ySize='600'/>
+              <DstRect xOff='200' yOff='0' xSize='100' ySize='600'/>
+            </SimpleSource>"""
+            for ds in (vrt_ds, ref_ds):
+                ds.GetRasterBand(1).SetMetadataItem(
+                    "source_1", source_xml, "new_vrt_sources"
+                )
+            assert vrt_ds.ReadRaster() == ref_ds.ReadRaster()
+            assert vrt_ds.ReadRaster() != expected
+    finally:
+        gdal.Unlink(src_filename)
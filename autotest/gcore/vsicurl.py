@@ -1093,6 +1093,235 @@ def test_vsicurl_GDAL_HTTP_HEADERS():
     assert statres.size == 3
 
 
+###############################################################################
+# Test the persistent disk cache (CPL_VSIL_CURL_DISK_CACHE_DIR)
+
+
+def test_vsicurl_disk_cache(tmp_path):
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    cache_dir = str(tmp_path / "cache")
+    filename = (
+        "/vsicurl/http://localhost:%d/test_disk_cache/test.bin"
+        % gdaltest.webserver_port
+    )
+
+    def read_file():
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert f is not None
+        data = gdal.VSIFReadL(1, 3, f).decode("ascii")
+        gdal.VSIFCloseL(f)
+        return data
+
+    with gdaltest.config_option("CPL_VSIL_CURL_DISK_CACHE_DIR", cache_dir):
+
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add("GET", "/test_disk_cache/", 404)
+        handler.add(
+            "HEAD",
+            "/test_disk_cache/test.bin",
+            200,
+            {"Content-Length": "3", "ETag": '"first"'},
+        )
+        handler.add("GET", "/test_disk_cache/test.bin", 200, {"ETag": '"first"'}, "foo")
+        with webserver.install_http_handler(handler):
+            assert read_file() == "foo"
+
+        assert len(gdal.ReadDirRecursive(cache_dir)) > 1
+
+        # Chunks are read from the disk cache, as if by a new process
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add("GET", "/test_disk_cache/", 404)
+        handler.add(
+            "HEAD",
+            "/test_disk_cache/test.bin",
+            200,
+            {"Content-Length": "3", "ETag": '"first"'},
+        )
+        with webserver.install_http_handler(handler):
+            assert read_file() == "foo"
+
+        # Cached chunks are not used once the ETag has changed
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add("GET", "/test_disk_cache/", 404)
+        handler.add(
+            "HEAD",
+            "/test_disk_cache/test.bin",
+            200,
+            {"Content-Length": "3", "ETag": '"second"'},
+        )
+        handler.add(
+            "GET", "/test_disk_cache/test.bin", 200, {"ETag": '"second"'}, "bar"
+        )
+        with webserver.install_http_handler(handler):
+            assert read_file() == "bar"
+
+        # Data whose ETag differs from the one of the file properties is not
+        # stored in the disk cache, as the file was modified in between
+        for expected in ("baz", "qux"):
+            gdal.VSICurlClearCache()
+            handler = webserver.SequentialHandler()
+            handler.add("GET", "/test_disk_cache/", 404)
+            handler.add(
+                "HEAD",
+                "/test_disk_cache/test.bin",
+                200,
+                {"Content-Length": "3", "ETag": '"third"'},
+            )
+            handler.add(
+                "GET",
+                "/test_disk_cache/test.bin",
+                200,
+                {"ETag": '"fourth"'},
+                expected,
+            )
+            with webserver.install_http_handler(handler):
+                assert read_file() == expected
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Serves range requests of a single file and records them
+
+
+class RangeHandler(object):
+    def __init__(self, path, filedata):
+        self.path = path
+        self.filedata = filedata
+        self.ranges = []
+
+    def final_check(self):
+        pass
+
+    def send_not_found(self, request):
+        request.send_response(404)
+        request.send_header("Content-Length", 0)
+        request.end_headers()
+
+    def do_HEAD(self, request):
+        if request.path != self.path:
+            return self.send_not_found(request)
+        request.send_response(200)
+        request.send_header("Content-Length", len(self.filedata))
+        request.end_headers()
+
+    def do_GET(self, request):
+        if request.path != self.path:
+            return self.send_not_found(request)
+        start, end = request.headers["Range"][len("bytes=") :].split("-")
+        start = int(start)
+        end = min(int(end) + 1, len(self.filedata))
+        self.ranges.append((start, end))
+        request.send_response(206)
+        request.send_header(
+            "Content-Range", "bytes %d-%d/%d" % (start, end - 1, len(self.filedata))
+        )
+        request.send_header("Content-Length", end - start)
+        request.end_headers()
+        request.wfile.write(self.filedata[start:end])
+
+
+###############################################################################
+# Test that GTiff AdviseRead() prefetches the tiles in the background
+
+
+def test_vsicurl_advise_read():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    tmpfilename = "/vsimem/test_vsicurl_advise_read.tif"
+    src_ds = gdal.GetDriverByName("GTiff").Create(
+        tmpfilename, 512, 512, options=["TILED=YES", "BLOCKYSIZE=256"]
+    )
+    src_ds.WriteRaster(0, 0, 512, 512, bytes(i % 251 for i in range(512 * 512)))
+    src_ds = None
+    f = gdal.VSIFOpenL(tmpfilename, "rb")
+    filedata = gdal.VSIFReadL(1, 1000000, f)
+    gdal.VSIFCloseL(f)
+    gdal.Unlink(tmpfilename)
+
+    gdal.VSICurlClearCache()
+    handler = RangeHandler("/test_advise_read.tif", filedata)
+    with webserver.install_http_handler(handler):
+        ds = gdal.Open(
+            "/vsicurl/http://localhost:%d/test_advise_read.tif"
+            % gdaltest.webserver_port
+        )
+        assert ds is not None
+        band = ds.GetRasterBand(1)
+        offset = int(band.GetMetadataItem("BLOCK_OFFSET_1_1", "TIFF"))
+        size = int(band.GetMetadataItem("BLOCK_SIZE_1_1", "TIFF"))
+        nb_requests = len(handler.ranges)
+
+        assert ds.AdviseRead(256, 256, 256, 256) == gdal.CE_None
+        data = ds.ReadRaster(256, 256, 256, 256)
+        assert data == bytes(
+            (y * 512 + x) % 251 for y in range(256, 512) for x in range(256, 512)
+        )
+
+        # Only the prefetch request has been issued by the read
+        assert len(handler.ranges) == nb_requests + 1
+        start, end = handler.ranges[-1]
+        assert start <= offset and end >= offset + size
+
+        ds = None
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test that large reads are split into concurrent range requests
+
+
+def test_vsicurl_parallel_read():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    filedata = bytes(i % 251 for i in range(100000))
+    handler = RangeHandler("/test_parallel_read.bin", filedata)
+    gdal.VSICurlClearCache()
+    with webserver.install_http_handler(handler), gdaltest.config_options(
+        {
+            "CPL_VSIL_CURL_PARALLEL_READ_REQUESTS": "3",
+            "CPL_VSIL_CURL_PARALLEL_READ_CHUNK_SIZE": "16384",
+        }
+    ):
+        f = gdal.VSIFOpenL(
+            "/vsicurl/http://localhost:%d/test_parallel_read.bin"
+            % gdaltest.webserver_port,
+            "rb",
+        )
+        assert f is not None
+        gdal.VSIFSeekL(f, 0, 2)
+        assert gdal.VSIFTellL(f) == len(filedata)
+
+        # Small read: single request
+        gdal.VSIFSeekL(f, 0, 0)
+        assert gdal.VSIFReadL(1, 100, f) == filedata[0:100]
+        assert handler.ranges == [(0, 16384)]
+
+        # Large read: split into 3 requests of whole chunks
+        handler.ranges = []
+        gdal.VSIFSeekL(f, 20000, 0)
+        assert gdal.VSIFReadL(1, 80000, f) == filedata[20000:]
+        assert sorted(handler.ranges) == [
+            (20000, 20000 + 32768),
+            (20000 + 32768, 20000 + 65536),
+            (20000 + 65536, 100000),
+        ]
+        gdal.VSIFCloseL(f)
+
+    gdal.VSICurlClearCache()
+
+
 ###############################################################################
 
 
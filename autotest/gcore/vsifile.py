@@ -1143,3 +1143,106 @@ def test_vsifile_vsimem_truncate_zeroize():
     gdal.VSIFSeekL(f, 0, 0)
     assert gdal.VSIFReadL(1, 1, f) == b"\x00"
     gdal.VSIFCloseL(f)
+
+
+###############################################################################
+# Test the pread() based handle for local files
+
+
+@pytest.mark.skipif(sys.platform == "win32", reason="not relevant on Windows")
+def test_vsifile_local_use_pread(tmp_path):
+
+    filename = str(tmp_path / "test.bin")
+    data = bytes(i % 251 for i in range(100000))
+    f = gdal.VSIFOpenL(filename, "wb")
+    gdal.VSIFWriteL(data, 1, len(data), f)
+    gdal.VSIFCloseL(f)
+
+    with gdaltest.config_option("CPL_VSIL_LOCAL_USE_PREAD", "YES"):
+        f = gdal.VSIFOpenL(filename, "rb")
+    assert f
+    try:
+        # Small reads served from the read-ahead buffer
+        assert gdal.VSIFReadL(1, 3, f) == data[0:3]
+        assert gdal.VSIFReadL(1, 5, f) == data[3:8]
+        assert gdal.VSIFTellL(f) == 8
+        # Large read
+        assert gdal.VSIFReadL(1, 50000, f) == data[8:50008]
+        assert gdal.VSIFSeekL(f, 99990, 0) == 0
+        assert not gdal.VSIFEofL(f)
+        assert gdal.VSIFReadL(1, 20, f) == data[99990:]
+        assert gdal.VSIFEofL(f)
+        assert gdal.VSIFSeekL(f, -10, 2) == 0
+        assert gdal.VSIFTellL(f) == 99990
+        assert not gdal.VSIFEofL(f)
+        assert gdal.VSIFSeekL(f, 5, 1) == 0
+        assert gdal.VSIFReadL(1, 5, f) == data[99995:]
+        # Read-only handle
+        assert gdal.VSIFWriteL(b"x", 1, 1, f) == 0
+    finally:
+        gdal.VSIFCloseL(f)
+
+    with gdaltest.config_option("CPL_VSIL_LOCAL_USE_PREAD", "YES"):
+        assert gdal.VSIFOpenL(str(tmp_path / "i_do_not_exist.bin"), "rb") is None
+
+
+###############################################################################
+# Test GTiff multi-threaded reads through the pread() based handle
+
+
+@pytest.mark.skipif(sys.platform == "win32", reason="not relevant on Windows")
+def test_vsifile_local_use_pread_gtiff_multithreaded(tmp_path):
+
+    filename = str(tmp_path / "test.tif")
+    src_ds = gdal.Open("data/byte.tif")
+    gdal.Translate(
+        filename,
+        src_ds,
+        creationOptions=[
+            "TILED=YES",
+            "BLOCKXSIZE=16",
+            "BLOCKYSIZE=16",
+            "COMPRESS=DEFLATE",
+        ],
+    )
+    expected_cs = src_ds.GetRasterBand(1).Checksum()
+    expected_data = src_ds.ReadRaster()
+
+    with gdaltest.config_options(
+        {"CPL_VSIL_LOCAL_USE_PREAD": "YES", "GDAL_NUM_THREADS": "4"}
+    ):
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster() == expected_data
+        assert ds.GetRasterBand(1).Checksum() == expected_cs
+        ds = None
+
+
+###############################################################################
+# Test GTiff multi-range reads through the pread() based handle (served by
+# io_uring when available)
+
+
+@pytest.mark.skipif(sys.platform == "win32", reason="not relevant on Windows")
+@pytest.mark.parametrize("use_io_uring", ["YES", "NO"])
+def test_vsifile_local_use_pread_read_multi_range(tmp_path, use_io_uring):
+
+    filename = str(tmp_path / "test.tif")
+    src_ds = gdal.Open("data/byte.tif")
+    gdal.Translate(
+        filename,
+        src_ds,
+        creationOptions=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+    )
+    expected_data = src_ds.ReadRaster()
+
+    with gdaltest.config_options(
+        {
+            "CPL_VSIL_LOCAL_USE_PREAD": "YES",
+            "CPL_VSIL_LOCAL_USE_IO_URING": use_io_uring,
+            "GTIFF_HAS_OPTIMIZED_READ_MULTI_RANGE": "YES",
+        }
+    ):
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster() == expected_data
+        assert ds.ReadRaster(1, 2, 17, 18) == src_ds.ReadRaster(1, 2, 17, 18)
+        ds = None
@@ -736,6 +736,68 @@ def test_mem_alpha_ismaskband():
     assert ds.GetRasterBand(2).IsMaskBand()
 
 
+###############################################################################
+# Test that overviews computed with several threads, which split a chunk into
+# several jobs, are identical to the single-threaded ones, and that the
+# histogram based mode of integer types matches the generic one.
+
+
+def _mem_create_ovr_test_ds(datatype, nodata):
+
+    width = 300
+    height = 260
+    ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, datatype)
+    values = [
+        ((x // 3) * 7 + (y // 5) * 13 + (x * y) % 3) % 100
+        for y in range(height)
+        for x in range(width)
+    ]
+    ds.GetRasterBand(1).WriteRaster(
+        0,
+        0,
+        width,
+        height,
+        struct.pack("<%df" % len(values), *values),
+        buf_type=gdal.GDT_Float32,
+    )
+    if nodata is not None:
+        ds.GetRasterBand(1).SetNoDataValue(nodata)
+    return ds
+
+
+def _mem_get_ovr_data(ds):
+
+    band = ds.GetRasterBand(1)
+    return [
+        band.GetOverview(i).ReadRaster(buf_type=gdal.GDT_Float32)
+        for i in range(band.GetOverviewCount())
+    ]
+
+
+@pytest.mark.parametrize(
+    "datatype",
+    [gdal.GDT_Byte, gdal.GDT_Int8, gdal.GDT_UInt16, gdal.GDT_Int16, gdal.GDT_Float32],
+)
+@pytest.mark.parametrize("resampling", ["MODE", "GAUSS", "CUBIC"])
+@pytest.mark.parametrize("nodata", [None, 0])
+def test_mem_overview_multithreaded(datatype, resampling, nodata):
+
+    ds = _mem_create_ovr_test_ds(datatype, nodata)
+    with gdaltest.config_option("GDAL_NUM_THREADS", "1"):
+        ds.BuildOverviews(resampling, [2, 4])
+    expected = _mem_get_ovr_data(ds)
+
+    ds = _mem_create_ovr_test_ds(datatype, nodata)
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        ds.BuildOverviews(resampling, [2, 4])
+    assert _mem_get_ovr_data(ds) == expected
+
+    if resampling == "MODE" and datatype != gdal.GDT_Float32:
+        ds = _mem_create_ovr_test_ds(gdal.GDT_Float32, nodata)
+        ds.BuildOverviews(resampling, [2, 4])
+        assert _mem_get_ovr_data(ds) == expected
+
+
 ###############################################################################
 # cleanup
 
@@ -2985,6 +2985,69 @@ def test_zarr_advise_read(compression):
         gdal.RmdirRecursive(filename)
 
 
+@pytest.mark.parametrize("format", ["ZARR_V2", "ZARR_V3"])
+@pytest.mark.parametrize(
+    "options",
+    [
+        ["COMPRESS=NONE"],
+        ["COMPRESS=ZLIB", "CHUNK_MEMORY_LAYOUT=F"],
+        ["COMPRESS=ZLIB", "DIM_SEPARATOR=/"],
+    ],
+)
+def test_zarr_write_multi_threaded(format, options):
+
+    filename = "tmp/test_zarr_write_multi_threaded.zarr"
+    try:
+        dim0_size = 230
+        dim1_size = 570
+        dim0_blocksize = 20
+        dim1_blocksize = 30
+        data_ar = [(i % 251) for i in range(dim0_size * dim1_size)]
+
+        # Create empty block
+        for y in range(dim0_blocksize):
+            for x in range(dim1_blocksize):
+                data_ar[dim1_size * (y + dim0_blocksize) + x + dim1_blocksize] = 0
+
+        def write():
+            ds = gdal.GetDriverByName("ZARR").CreateMultiDimensional(
+                filename, options=["FORMAT=" + format]
+            )
+            assert ds is not None
+            rg = ds.GetRootGroup()
+            dim0 = rg.CreateDimension("dim0", None, None, dim0_size)
+            dim1 = rg.CreateDimension("dim1", None, None, dim1_size)
+            ar = rg.CreateMDArray(
+                "test",
+                [dim0, dim1],
+                gdal.ExtendedDataType.Create(gdal.GDT_Byte),
+                options + ["BLOCKSIZE=%d,%d" % (dim0_blocksize, dim1_blocksize)],
+            )
+            assert ar
+            assert ar.Write(array.array("B", data_ar)) == gdal.CE_None
+
+            # Partial update of a tile that may still be queued for writing
+            assert (
+                ar.Write(b"\xFF" * (5 * 7), array_start_idx=[1, 2], count=[5, 7])
+                == gdal.CE_None
+            )
+            for y in range(5):
+                for x in range(7):
+                    data_ar[dim1_size * (1 + y) + 2 + x] = 255
+            assert ar.Read() == array.array("B", data_ar)
+
+        with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+            write()
+
+        ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+        assert ds is not None
+        ar = ds.GetRootGroup().OpenMDArray("test")
+        assert ar.Read() == array.array("B", data_ar)
+
+    finally:
+        gdal.RmdirRecursive(filename)
+
+
 def test_zarr_read_invalid_nczarr_dim():
 
     try:
@@ -701,3 +701,53 @@ def test_gdaldem_lib_nodata():
     if cs != 10:
         print(ds.ReadAsArray())  # Should be 0 0 0 0 181 0 0 0 0
         pytest.fail("Bad checksum")
+
+
+###############################################################################
+# Test that -multithread gives the same result as the single-threaded code path
+
+
+@pytest.mark.parametrize(
+    "processing,options",
+    [
+        ("hillshade", {"scale": 111120, "zFactor": 30}),
+        ("hillshade", {"zFactor": 30}),
+        (
+            "hillshade",
+            {"scale": 111120, "zFactor": 30, "alg": "ZevenbergenThorne"},
+        ),
+        ("hillshade", {"scale": 111120, "zFactor": 30, "computeEdges": True}),
+        ("hillshade", {"scale": 111120, "multiDirectional": True}),
+        ("slope", {"scale": 111120}),
+        ("slope", {"scale": 111120, "slopeFormat": "percent"}),
+        ("slope", {"scale": 111120, "alg": "ZevenbergenThorne"}),
+        ("aspect", {"computeEdges": True}),
+        ("TRI", {}),
+        ("TPI", {"computeEdges": True}),
+        ("roughness", {}),
+        ("color-relief", {"colorFilename": "data/color_file.txt"}),
+    ],
+)
+@pytest.mark.parametrize("datatype", [gdal.GDT_Int16, gdal.GDT_Float32])
+def test_gdaldem_lib_multithread(processing, options, datatype):
+
+    src_ds = gdal.Translate(
+        "", "../gdrivers/data/n43.tif", format="MEM", outputType=datatype
+    )
+    # Add a few nodata pixels
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(
+        20, 30, 5, 5, b"\x00" * (5 * 5 * gdal.GetDataTypeSize(datatype) // 8)
+    )
+
+    ref_ds = gdal.DEMProcessing("", src_ds, processing, format="MEM", **options)
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        ds = gdal.DEMProcessing(
+            "", src_ds, processing, format="MEM", multithread=True, **options
+        )
+    assert ds.RasterCount == ref_ds.RasterCount
+    for i in range(ds.RasterCount):
+        assert (
+            ds.GetRasterBand(i + 1).ReadRaster()
+            == ref_ds.GetRasterBand(i + 1).ReadRaster()
+        )
@@ -3307,6 +3307,43 @@ def test_gdalwarp_lib_srcBands():
     assert ds.GetRasterBand(2).GetColorInterpretation() == gdal.GCI_AlphaBand
 
 
+###############################################################################
+# Test that the ChunkAndWarpMulti() pipeline gives the same result as the
+# single-threaded code path, whatever its depth
+
+
+@pytest.mark.parametrize("pipeline_depth", [None, "1", "2", "8"])
+@pytest.mark.parametrize("with_masks", [False, True])
+def test_gdalwarp_lib_multi_pipeline(pipeline_depth, with_masks):
+
+    src_ds = gdal.Translate(
+        "", "../gcore/data/byte.tif", format="MEM", width=200, height=200
+    )
+    options = {
+        "format": "MEM",
+        "dstSRS": "EPSG:4326",
+        "warpMemoryLimit": 50000,
+        "resampleAlg": "cubic",
+    }
+    if with_masks:
+        options["srcNodata"] = 0
+        options["dstAlpha"] = True
+        options["cutlineDSName"] = "data/cutline.vrt"
+        options["cutlineLayer"] = "cutline"
+    ref_ds = gdal.Warp("", src_ds, **options)
+
+    if pipeline_depth:
+        options["warpOptions"] = ["PIPELINE_DEPTH=" + pipeline_depth]
+    with gdaltest.config_option("CPL_DEBUG", "ON"):
+        ds = gdal.Warp("", src_ds, multithread=True, **options)
+    assert ds.RasterCount == ref_ds.RasterCount
+    for i in range(ds.RasterCount):
+        assert (
+            ds.GetRasterBand(i + 1).ReadRaster()
+            == ref_ds.GetRasterBand(i + 1).ReadRaster()
+        )
+
+
 ###############################################################################
 # Cleanup
 
@@ -340,6 +340,9 @@ gdal_check_package(Deflate "Enable libdeflate compression library (complement to
 gdal_check_package(OpenSSL "Use OpenSSL library" COMPONENTS SSL Crypto CAN_DISABLE)
 
 gdal_check_package(CryptoPP "Use crypto++ library for CPL." CAN_DISABLE)
+if (CMAKE_SYSTEM_NAME STREQUAL "Linux")
+  gdal_check_package(URING "Use liburing for batched reads of local files (io_uring)" CAN_DISABLE)
+endif ()
 if (GDAL_USE_CRYPTOPP)
   option(CRYPTOPP_USE_ONLY_CRYPTODLL_ALG "Use Only cryptoDLL alg. only work on dynamic DLL" OFF)
 endif ()
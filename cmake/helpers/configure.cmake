@@ -235,6 +235,8 @@ else ()
   check_type_size("off_t" SIZEOF_OFF_T)
 
   check_function_exists(pread64 HAVE_PREAD64)
+  check_function_exists(preadv64 HAVE_PREADV64)
+  check_function_exists(posix_fadvise HAVE_POSIX_FADVISE)
 
   check_function_exists(ftruncate64 HAVE_FTRUNCATE64)
   if (HAVE_FTRUNCATE64)
@@ -266,6 +268,8 @@ else ()
     unset(HAVE_STATVFS64 CACHE)
     unset(HAVE_PREAD64)
     unset(HAVE_PREAD64 CACHE)
+    unset(HAVE_PREADV64)
+    unset(HAVE_PREADV64 CACHE)
   endif()
 
   if( NOT HAVE_PREAD64 )
@@ -279,6 +283,17 @@ else ()
       HAVE_PREAD_BSD)
   endif()
 
+  if( NOT HAVE_PREADV64 )
+    check_c_source_compiles(
+      "
+         #include <sys/types.h>
+         #include <sys/uio.h>
+         #include <unistd.h>
+         int main() { preadv(0, NULL, 0, 0); return 0; }
+        "
+      HAVE_PREADV_BSD)
+  endif()
+
   set(UNIX_STDIO_64 TRUE)
 
   set(INCLUDE_XLOCALE_H)
@@ -0,0 +1,56 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+#[=======================================================================[.rst:
+FindURING
+---------
+
+Find the liburing include directory and library (io_uring helper library
+of the Linux kernel).
+
+IMPORTED Targets
+^^^^^^^^^^^^^^^^
+
+This module defines :prop_tgt:`IMPORTED` target ``URING::URING``, if
+liburing has been found.
+
+Result Variables
+^^^^^^^^^^^^^^^^
+
+This module defines the following variables:
+
+::
+
+  URING_INCLUDE_DIRS   - where to find liburing.h
+  URING_LIBRARIES      - List of libraries when using liburing.
+  URING_FOUND          - True if liburing found.
+
+Cache variables
+^^^^^^^^^^^^^^^
+
+::
+
+  URING_INCLUDE_DIR    - Path to the include directory with liburing.h
+  URING_LIBRARY        - Path to the liburing library
+
+#]=======================================================================]
+
+find_path(URING_INCLUDE_DIR NAMES liburing.h)
+find_library(URING_LIBRARY NAMES uring)
+mark_as_advanced(URING_INCLUDE_DIR URING_LIBRARY)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(URING
+                                  REQUIRED_VARS URING_LIBRARY URING_INCLUDE_DIR)
+
+if(URING_FOUND)
+  set(URING_INCLUDE_DIRS ${URING_INCLUDE_DIR})
+  set(URING_LIBRARIES ${URING_LIBRARY})
+  if(NOT TARGET URING::URING)
+    add_library(URING::URING UNKNOWN IMPORTED)
+    set_target_properties(URING::URING PROPERTIES
+      IMPORTED_LINK_INTERFACE_LANGUAGES "C"
+      IMPORTED_LOCATION "${URING_LIBRARY}"
+      INTERFACE_INCLUDE_DIRECTORIES "${URING_INCLUDE_DIR}")
+  endif()
+endif()
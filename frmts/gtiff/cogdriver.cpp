@@ -1044,6 +1044,51 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
             aosOverviewOptions.SetNameValue("MASK_OVERVIEW_DATASET",
                                             m_osTmpMskOverviewFilename);
         }
+
+        // If the overviews are to be compressed with a lossless codec,
+        // encode the temporary overviews exactly as the final ones, so that
+        // the GTiff driver can copy their tiles without decoding and
+        // re-encoding them. The temporary file is still fully written
+        // before being copied. The mask overviews are not concerned, as
+        // they are 1-bit in the final file: their tiles are re-encoded.
+        std::unique_ptr<CPLConfigOptionSetter> poOvrBlockSizeSetter;
+        const char *pszOverviewCompress = CSLFetchNameValueDef(
+            papszOptions, "OVERVIEW_COMPRESS", osCompress.c_str());
+        if (CPLGetConfigOption("COG_TMP_COMPRESSION", nullptr) == nullptr &&
+            (EQUAL(pszOverviewCompress, "NONE") ||
+             EQUAL(pszOverviewCompress, "LZW") ||
+             EQUAL(pszOverviewCompress, "DEFLATE") ||
+             EQUAL(pszOverviewCompress, "ZSTD")))
+        {
+            aosOverviewOptions.SetNameValue("COMPRESS", pszOverviewCompress);
+            aosOverviewOptions.SetNameValue(
+                "PREDICTOR",
+                GetPredictor(poSrcDS, CSLFetchNameValueDef(
+                                          papszOptions, "OVERVIEW_PREDICTOR",
+                                          "FALSE")));
+            const char *pszLevel = CSLFetchNameValue(papszOptions, "LEVEL");
+            if (EQUAL(pszOverviewCompress, "DEFLATE"))
+                aosOverviewOptions.SetNameValue("ZLEVEL", pszLevel);
+            else if (EQUAL(pszOverviewCompress, "ZSTD"))
+                aosOverviewOptions.SetNameValue("ZSTD_LEVEL", pszLevel);
+            aosOverviewOptions.SetNameValue(
+                "SPARSE_OK", CPLFetchBool(papszOptions, "SPARSE_OK", false)
+                                 ? "YES"
+                                 : "NO");
+
+            // Same logic as GTIFFGetOverviewBlockSize() applied on the
+            // final dataset.
+            int nOvrBlockSize = atoi(osBlockSize);
+            if (nOvrBlockSize < 64 || nOvrBlockSize > 4096 ||
+                !CPLIsPowerOfTwo(nOvrBlockSize))
+            {
+                nOvrBlockSize = 128;
+            }
+            poOvrBlockSizeSetter.reset(new CPLConfigOptionSetter(
+                "GDAL_TIFF_OVR_BLOCKSIZE", CPLSPrintf("%d", nOvrBlockSize),
+                true));
+        }
+
         CPLErr eErr = GTIFFBuildOverviewsEx(
             m_osTmpOverviewFilename, nBands, &apoSrcBands[0],
             static_cast<int>(asOverviewDims.size()), nullptr,
@@ -48,6 +48,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <map>
 #include <memory>
@@ -241,6 +242,21 @@ bool GTIFFSupportsPredictor(int nCompression)
            nCompression == COMPRESSION_ZSTD;
 }
 
+/************************************************************************/
+/*                     GTIFFIsLosslessCompression()                     */
+/************************************************************************/
+
+bool GTIFFIsLosslessCompression(int nCompression)
+{
+    return nCompression == COMPRESSION_NONE ||
+           nCompression == COMPRESSION_LZW ||
+           nCompression == COMPRESSION_ADOBE_DEFLATE ||
+           nCompression == COMPRESSION_DEFLATE ||
+           nCompression == COMPRESSION_ZSTD ||
+           nCompression == COMPRESSION_LZMA ||
+           nCompression == COMPRESSION_PACKBITS;
+}
+
 /************************************************************************/
 /*                     GTIFFSetThreadLocalInExternalOvr()               */
 /************************************************************************/
@@ -343,6 +359,7 @@ enum class GTiffProfile : GByte
 
 #ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
 static void ThreadDecompressionFunc(void *);
+struct GTiffDecompressBatch;
 #endif
 
 class GTiffDataset final : public GDALPamDataset
@@ -410,6 +427,10 @@ class GTiffDataset final : public GDALPamDataset
 #ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
     lru11::Cache<int, std::pair<vsi_l_offset, vsi_l_offset>>
         m_oCacheStrileToOffsetByteCount{1024};
+
+    // Strips/tiles being pre-decoded in the background, not yet in the
+    // block cache.
+    std::unique_ptr<GTiffDecompressBatch> m_poPredecodeBatch{};
 #endif
 
     MaskOffset *m_panMaskOffsetLsb = nullptr;
@@ -662,6 +683,13 @@ class GTiffDataset final : public GDALPamDataset
                                      GDALProgressFunc pfnProgress,
                                      void *pProgressData);
 
+    static bool CanCopyRawTiles(GTiffDataset *poDstDS, GTiffDataset *poSrcDS);
+
+    static CPLErr CopyRawTiles(GTiffDataset *poDstDS, GTiffDataset *poSrcDS,
+                               GDALRasterBand *poSrcMaskBand,
+                               GDALProgressFunc pfnProgress,
+                               void *pProgressData);
+
     bool GetOverviewParameters(int &nCompression, uint16_t &nPlanarConfig,
                                uint16_t &nPredictor, uint16_t &nPhotometric,
                                int &nOvrJpegQuality, std::string &osNoData,
@@ -693,7 +721,14 @@ class GTiffDataset final : public GDALPamDataset
                              void *pData, GDALDataType eBufType, int nBandCount,
                              const int *panBandMap, GSpacing nPixelSpace,
                              GSpacing nLineSpace, GSpacing nBandSpace);
+    bool PredecodeBlocks(int nXOff, int nYOff, int nXSize, int nYSize,
+                         int nBandCount, const int *panBandMap, bool bWait);
 #endif
+    bool WaitPredecodeBatch(int nCurBand = 0, int nCurXBlock = -1,
+                            int nCurYBlock = -1, void *pCurImage = nullptr);
+    void CancelPredecodeBatch();
+    void AdviseReadStriles(int nXOff, int nYOff, int nXSize, int nYSize,
+                           int nBandCount, const int *panBandMap);
     virtual CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                              int nXSize, int nYSize, void *pData, int nBufXSize,
                              int nBufYSize, GDALDataType eBufType,
@@ -701,6 +736,10 @@ class GTiffDataset final : public GDALPamDataset
                              GSpacing nPixelSpace, GSpacing nLineSpace,
                              GSpacing nBandSpace,
                              GDALRasterIOExtraArg *psExtraArg) override;
+    CPLErr AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
+                      int nBufXSize, int nBufYSize, GDALDataType eDT,
+                      int nBandCount, int *panBandMap,
+                      char **papszOptions) override;
     virtual char **GetFileList() override;
 
     virtual CPLErr IBuildOverviews(const char *, int, const int *, int,
@@ -1353,6 +1392,9 @@ class GTiffRasterBand CPL_NON_FINAL : public GDALPamRasterBand
     GDALColorInterp m_eBandInterp = GCI_Undefined;
     std::set<GTiffRasterBand **> m_aSetPSelf{};
     bool m_bHaveOffsetScale = false;
+    // Band 0 block id of the last IReadBlock() call, to detect sequential
+    // block reads. Atomic as blocks may be read concurrently.
+    std::atomic<int> m_nLastReadBlockId{-1};
 
     int DirectIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
                  int nYSize, void *pData, int nBufXSize, int nBufYSize,
@@ -1417,6 +1459,9 @@ class GTiffRasterBand CPL_NON_FINAL : public GDALPamRasterBand
                              int nBufYSize, GDALDataType eBufType,
                              GSpacing nPixelSpace, GSpacing nLineSpace,
                              GDALRasterIOExtraArg *psExtraArg) override final;
+    CPLErr AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
+                      int nBufXSize, int nBufYSize, GDALDataType eDT,
+                      char **papszOptions) override;
 
     virtual const char *GetDescription() const override final;
     virtual void SetDescription(const char *) override final;
@@ -2328,8 +2373,13 @@ bool GTiffDataset::HasOptimizedReadMultiRange()
 {
     if (m_nHasOptimizedReadMultiRange >= 0)
         return m_nHasOptimizedReadMultiRange != 0;
+    // The file system capability is about network file systems. The handle
+    // one also covers local files read through io_uring.
+    VSIVirtualHandle *poHandle = reinterpret_cast<VSIVirtualHandle *>(
+        VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF)));
     m_nHasOptimizedReadMultiRange = static_cast<signed char>(
-        VSIHasOptimizedReadMultiRange(m_pszFilename)
+        VSIHasOptimizedReadMultiRange(m_pszFilename) ||
+        poHandle->HasOptimizedReadMultiRange()
         // Config option for debug and testing purposes only
         || CPLTestBool(CPLGetConfigOption(
                "GTIFF_HAS_OPTIMIZED_READ_MULTI_RANGE", "NO")));
@@ -2349,6 +2399,9 @@ CPLErr GTiffDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                                GDALRasterIOExtraArg *psExtraArg)
 
 {
+    // Make the blocks pre-decoded by AdviseRead() visible.
+    WaitPredecodeBatch();
+
     // Try to pass the request to the most appropriate overview dataset.
     if (nBufXSize < nXSize && nBufYSize < nYSize)
     {
@@ -2426,6 +2479,15 @@ CPLErr GTiffDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                                  nBandCount, panBandMap, nPixelSpace,
                                  nLineSpace, nBandSpace);
     }
+    else if (eRWFlag == GF_Read && (nBufXSize != nXSize || nBufYSize != nYSize))
+    {
+        // Resampled requests are served from the block cache by the generic
+        // implementation: fill it with multi-threaded decoding first.
+        // Blocks that could not be decoded are read again, and their errors
+        // reported, by the generic implementation.
+        PredecodeBlocks(nXOff, nYOff, nXSize, nYSize, nBandCount, panBandMap,
+                        /* bWait = */ true);
+    }
 #endif
 
     ++m_nJPEGOverviewVisibilityCounter;
@@ -2445,6 +2507,134 @@ CPLErr GTiffDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
     return eErr;
 }
 
+/************************************************************************/
+/*                            AdviseRead()                              */
+/************************************************************************/
+
+CPLErr GTiffDataset::AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
+                                int nBufXSize, int nBufYSize, GDALDataType eDT,
+                                int nBandCount, int *panBandMap,
+                                char ** /* papszOptions */)
+{
+    if (eAccess != GA_ReadOnly || m_bStreamingIn || nBandCount <= 0 ||
+        nXOff < 0 || nYOff < 0 || nXSize <= 0 || nYSize <= 0 ||
+        nXOff > nRasterXSize - nXSize || nYOff > nRasterYSize - nYSize)
+    {
+        return CE_None;
+    }
+
+    // Same logic as in IRasterIO() to select the overview that will be read.
+    if (nBufXSize < nXSize && nBufYSize < nYSize)
+    {
+        ++m_nJPEGOverviewVisibilityCounter;
+        const int iOvr = GDALBandGetBestOverviewLevel2(
+            papoBands[0], nXOff, nYOff, nXSize, nYSize, nBufXSize, nBufYSize,
+            nullptr);
+        GDALRasterBand *poOvrBand =
+            iOvr >= 0 ? papoBands[0]->GetOverview(iOvr) : nullptr;
+        GDALDataset *poOvrDS = poOvrBand ? poOvrBand->GetDataset() : nullptr;
+        --m_nJPEGOverviewVisibilityCounter;
+        if (poOvrDS)
+        {
+            return poOvrDS->AdviseRead(nXOff, nYOff, nXSize, nYSize, nBufXSize,
+                                       nBufYSize, eDT, nBandCount, panBandMap,
+                                       nullptr);
+        }
+    }
+
+    // Fetch the strips/tiles, and decode them in the background. The caller
+    // thread does not wait for that: the decoded blocks are put in the block
+    // cache at the next RasterIO() or block read.
+    CancelPredecodeBatch();
+    AdviseReadStriles(nXOff, nYOff, nXSize, nYSize, nBandCount, panBandMap);
+#ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
+    PredecodeBlocks(nXOff, nYOff, nXSize, nYSize, nBandCount, panBandMap,
+                    /* bWait = */ false);
+#endif
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                         AdviseReadStriles()                          */
+/************************************************************************/
+
+// Lets the file handle prefetch, in the background, the strips/tiles
+// intersecting the window. This is a no-op on file systems that don't
+// implement VSIVirtualHandle::AdviseRead().
+void GTiffDataset::AdviseReadStriles(int nXOff, int nYOff, int nXSize,
+                                     int nYSize, int nBandCount,
+                                     const int *panBandMap)
+{
+    VSIVirtualHandle *poHandle = reinterpret_cast<VSIVirtualHandle *>(
+        VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF)));
+    const size_t nLimit = poHandle->GetAdviseReadTotalBytesLimit();
+    if (nLimit == 0)
+        return;
+
+    const int nBlockX1 = nXOff / m_nBlockXSize;
+    const int nBlockY1 = nYOff / m_nBlockYSize;
+    const int nBlockX2 = (nXOff + nXSize - 1) / m_nBlockXSize;
+    const int nBlockY2 = (nYOff + nYSize - 1) / m_nBlockYSize;
+    const int nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, m_nBlockXSize);
+    const int nPlaneCount =
+        m_nPlanarConfig == PLANARCONFIG_SEPARATE ? nBandCount : 1;
+    const bool bWithMask = m_bMaskInterleavedWithImagery && m_poMaskDS;
+    // Strile leader and trailer of COG files, so that the optimized
+    // retrieval of CacheMultiRange() finds them too.
+    const int nLeaderSize = m_bLeaderSizeAsUInt4 ? 4 : 0;
+    const int nTrailerSize = m_bTrailerRepeatedLast4BytesRepeated ? 4 : 0;
+
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    size_t nTotalSize = 0;
+    const auto AddStrile = [&](GTiffDataset *poDS, int nBlockId)
+    {
+        vsi_l_offset nOffset = 0;
+        vsi_l_offset nSize = 0;
+        if (!poDS->IsBlockAvailable(nBlockId, &nOffset, &nSize) ||
+            nOffset < static_cast<vsi_l_offset>(nLeaderSize))
+        {
+            return true;
+        }
+        nOffset -= nLeaderSize;
+        nSize += nLeaderSize + nTrailerSize;
+        if (nSize > nLimit - nTotalSize)
+            return false;
+        anOffsets.push_back(nOffset);
+        anSizes.push_back(static_cast<size_t>(nSize));
+        nTotalSize += static_cast<size_t>(nSize);
+        return true;
+    };
+
+    bool bGoOn = true;
+    for (int iY = nBlockY1; bGoOn && iY <= nBlockY2; ++iY)
+    {
+        for (int iX = nBlockX1; bGoOn && iX <= nBlockX2; ++iX)
+        {
+            for (int iPlane = 0; bGoOn && iPlane < nPlaneCount; ++iPlane)
+            {
+                int nBlockId = iX + iY * nBlocksPerRow;
+                if (m_nPlanarConfig == PLANARCONFIG_SEPARATE)
+                {
+                    const int nBand =
+                        panBandMap ? panBandMap[iPlane] : iPlane + 1;
+                    nBlockId += (nBand - 1) * m_nBlocksPerBand;
+                }
+                bGoOn = AddStrile(this, nBlockId);
+            }
+            if (bGoOn && bWithMask)
+                bGoOn = AddStrile(m_poMaskDS, iX + iY * nBlocksPerRow);
+        }
+    }
+
+    if (!anOffsets.empty())
+    {
+        poHandle->AdviseRead(static_cast<int>(anOffsets.size()),
+                             anOffsets.data(), anSizes.data());
+    }
+}
+
 #ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
 
 struct GTiffDecompressContext
@@ -2500,6 +2690,25 @@ struct GTiffDecompressJob
     int nYBlock = 0;
     vsi_l_offset nOffset = 0;
     vsi_l_offset nSize = 0;
+    // When pre-decoding, the decoded strip/tile (all bands pixel-interleaved
+    // in contig mode), or empty if it could not be decoded.
+    std::vector<GByte> abyDecoded{};
+};
+
+// Jobs of a MultiThreadedRead() call, and the data they use. When
+// pre-decoding, they may still be running after MultiThreadedRead() has
+// returned, until GTiffDataset::WaitPredecodeBatch() is called.
+struct GTiffDecompressBatch
+{
+    std::unique_ptr<CPLJobQueue> poQueue{};
+    GTiffDecompressContext sContext{};
+    std::vector<GTiffDecompressJob> asJobs{};
+
+    // Copies of what sContext would otherwise point to, that may change or
+    // disappear before the jobs are completed.
+    std::vector<int> anBandMap{};
+    std::vector<GByte> abyJPEGTable{};
+    std::vector<uint16_t> anExtraSamples{};
 };
 
 /************************************************************************/
@@ -2508,10 +2717,16 @@ struct GTiffDecompressJob
 
 static void ThreadDecompressionFunc(void *pData)
 {
-    const auto psJob = static_cast<const GTiffDecompressJob *>(pData);
+    const auto psJob = static_cast<GTiffDecompressJob *>(pData);
     auto psContext = psJob->psContext;
     auto poDS = psContext->poDS;
 
+    // Errors while pre-decoding are not fatal. They are reported if the
+    // strip/tile is decoded again when it is read.
+    std::unique_ptr<CPLErrorHandlerPusher> poQuietErrors;
+    if (psContext->pabyData == nullptr)
+        poQuietErrors.reset(new CPLErrorHandlerPusher(CPLQuietErrorHandler));
+
     const int nBandsPerStrile =
         poDS->m_nPlanarConfig == PLANARCONFIG_CONTIG ? poDS->nBands : 1;
     const int nBandsToWrite = poDS->m_nPlanarConfig == PLANARCONFIG_CONTIG
@@ -2573,6 +2788,9 @@ static void ThreadDecompressionFunc(void *pData)
 
     if (psJob->nSize == 0)
     {
+        // Nothing to pre-decode for a sparse block
+        if (psContext->pabyData == nullptr)
+            return;
         {
             std::lock_guard<std::mutex> oLock(psContext->oMutex);
             if (!psContext->bSuccess)
@@ -2919,6 +3137,17 @@ static void ThreadDecompressionFunc(void *pData)
             }
         }
 
+        // Only pre-decoding: the decoded data is put in the block cache by
+        // GTiffDataset::WaitPredecodeBatch(), in the calling thread.
+        if (psContext->pabyData == nullptr)
+        {
+            if (pabyOutput == abyInput.data())
+                psJob->abyDecoded = std::move(abyInput);
+            else
+                psJob->abyDecoded = std::move(abyOutput);
+            return;
+        }
+
         const GByte *pSrcPtr =
             pabyOutput +
             (static_cast<size_t>(nYOffsetInBlock) * poDS->m_nBlockXSize +
@@ -2999,6 +3228,9 @@ static void ThreadDecompressionFunc(void *pData)
 
     CPLAssert(!psContext->bSkipBlockCache);
 
+    if (psContext->pabyData == nullptr)
+        return;
+
     // Compose cached blocks into final buffer
     for (int i = 0; i < nBandsToWrite; ++i)
     {
@@ -3058,7 +3290,9 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
                                        GSpacing nPixelSpace,
                                        GSpacing nLineSpace, GSpacing nBandSpace)
 {
-    auto poQueue = m_poThreadPool->CreateJobQueue();
+    std::unique_ptr<GTiffDecompressBatch> poBatch(new GTiffDecompressBatch());
+    poBatch->poQueue = m_poThreadPool->CreateJobQueue();
+    auto poQueue = poBatch->poQueue.get();
     if (poQueue == nullptr)
     {
         return CE_Failure;
@@ -3074,7 +3308,7 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
         m_nPlanarConfig == PLANARCONFIG_CONTIG ? 1 : nBandCount;
     const int nBlocks = nXBlocks * nYBlocks * nStrilePerBlock;
 
-    GTiffDecompressContext sContext;
+    GTiffDecompressContext &sContext = poBatch->sContext;
     sContext.poHandle = reinterpret_cast<VSIVirtualHandle *>(
         VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF)));
     sContext.bHasPRead =
@@ -3106,7 +3340,16 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
     sContext.nPredictor = PREDICTOR_NONE;
     sContext.nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, m_nBlockXSize);
 
-    if (m_bDirectIO)
+    if (pData == nullptr)
+    {
+        // Pre-decoding: jobs keep the decoded data, that is put in the
+        // block cache by WaitPredecodeBatch(). Jobs do not access the block
+        // cache themselves, as the caller may use it while they run.
+        CPLAssert(!m_bDirectIO);
+        CPLAssert(m_poPredecodeBatch == nullptr);
+        sContext.bSkipBlockCache = true;
+    }
+    else if (m_bDirectIO)
     {
         sContext.bSkipBlockCache = true;
     }
@@ -3131,7 +3374,8 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
         }
     }
 
-    if (m_nPlanarConfig == PLANARCONFIG_CONTIG && nBandCount == nBands &&
+    if (pData != nullptr && m_nPlanarConfig == PLANARCONFIG_CONTIG &&
+        nBandCount == nBands &&
         nPixelSpace == nBands * static_cast<GSpacing>(sContext.nBufDTSize))
     {
         sContext.bUseBIPOptim = true;
@@ -3145,7 +3389,7 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
         }
     }
 
-    if (m_nPlanarConfig == PLANARCONFIG_CONTIG &&
+    if (pData != nullptr && m_nPlanarConfig == PLANARCONFIG_CONTIG &&
         (nBands == 3 || nBands == 4) && nBands == nBandCount &&
         (sContext.eDT == GDT_Byte || sContext.eDT == GDT_Int16 ||
          sContext.eDT == GDT_UInt16))
@@ -3174,8 +3418,9 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
 
     // In contig mode, if only one band is requested, check if we have
     // enough cache to cache all bands.
-    if (!sContext.bSkipBlockCache && nBands != 1 &&
-        m_nPlanarConfig == PLANARCONFIG_CONTIG && nBandCount == 1)
+    if (!sContext.bSkipBlockCache && !sContext.bCacheAllBands &&
+        nBands != 1 && m_nPlanarConfig == PLANARCONFIG_CONTIG &&
+        nBandCount == 1)
     {
         const GIntBig nRequiredMem = static_cast<GIntBig>(nBands) * nXBlocks *
                                      nYBlocks * m_nBlockXSize * m_nBlockYSize *
@@ -3299,12 +3544,46 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
     TIFFGetField(m_hTIFF, TIFFTAG_EXTRASAMPLES, &sContext.nExtraSampleCount,
                  &sContext.pExtraSamples);
 
+    if (pData == nullptr)
+    {
+        // The jobs may outlive this call: do not point to data owned by the
+        // caller, or by libtiff, which changes with the current directory.
+        poBatch->anBandMap.assign(panBandMap, panBandMap + nBandCount);
+        sContext.panBandMap = poBatch->anBandMap.data();
+        if (sContext.pJPEGTable)
+        {
+            const GByte *pabyJPEGTable =
+                static_cast<const GByte *>(sContext.pJPEGTable);
+            poBatch->abyJPEGTable.assign(
+                pabyJPEGTable, pabyJPEGTable + sContext.nJPEGTableSize);
+            sContext.pJPEGTable = poBatch->abyJPEGTable.data();
+        }
+        if (sContext.pExtraSamples)
+        {
+            poBatch->anExtraSamples.assign(sContext.pExtraSamples,
+                                           sContext.pExtraSamples +
+                                               sContext.nExtraSampleCount);
+            sContext.pExtraSamples = poBatch->anExtraSamples.data();
+        }
+    }
+
+    // Let the file handle know about the strips/tiles that are going to be
+    // read, so that it can start fetching them ahead of the decompression
+    // threads (e.g. posix_fadvise() with the local pread() based handle).
+    if (sContext.bHasPRead)
+    {
+        AdviseReadStriles(nXOff, nYOff, nXSize, nYSize, nBandCount,
+                          panBandMap);
+    }
+
     // We need to do that as threads will access the block cache
-    TemporarilyDropReadWriteLock();
+    if (pData != nullptr)
+        TemporarilyDropReadWriteLock();
 
     // Create one job per tile/strip
     vsi_l_offset nFileSize = 0;
-    std::vector<GTiffDecompressJob> asJobs(nBlocks);
+    std::vector<GTiffDecompressJob> &asJobs = poBatch->asJobs;
+    asJobs.resize(nBlocks);
     int iJob = 0;
     for (int y = 0; y < nYBlocks; ++y)
     {
@@ -3371,6 +3650,16 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
         }
     }
 
+    if (pData == nullptr)
+    {
+        m_poPredecodeBatch = std::move(poBatch);
+        // Only leave the jobs running when they do not share the file
+        // position with the caller.
+        if (!sContext.bHasPRead)
+            WaitPredecodeBatch();
+        return CE_None;
+    }
+
     // Wait for all jobs to have been completed
     poQueue->WaitCompletion();
 
@@ -3380,7 +3669,172 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
     return sContext.bSuccess ? CE_None : CE_Failure;
 }
 
+/************************************************************************/
+/*                          PredecodeBlocks()                           */
+/************************************************************************/
+
+// Decodes with the thread pool the strips/tiles intersecting the window into
+// the block cache, so that requests that end up in the generic block based
+// implementation (resampled RasterIO(), GetLockedBlockRef() users) don't
+// decode them one at a time. If bWait is false, the decoding goes on in the
+// background when the file handle supports PRead(), and the blocks are put
+// in the block cache by the next WaitPredecodeBatch() call.
+// Returns false, silently, when that is not possible or not worth it, or
+// when called from a job of the global thread pool (e.g. a multi-threaded
+// VRT read), as waiting there for other jobs of the pool could deadlock.
+// Errors are not reported either: blocks that could not be decoded are
+// decoded again when read.
+bool GTiffDataset::PredecodeBlocks(int nXOff, int nYOff, int nXSize,
+                                   int nYSize, int nBandCount,
+                                   const int *panBandMap, bool bWait)
+{
+    if (m_poThreadPool == nullptr || eAccess != GA_ReadOnly || m_bDirectIO ||
+        nXSize <= 0 || nYSize <= 0 || !IsMultiThreadedReadCompatible() ||
+        GDALIsInGlobalThreadPool())
+    {
+        return false;
+    }
+
+    const int nXBlocks = (nXOff + nXSize - 1) / m_nBlockXSize -
+                         nXOff / m_nBlockXSize + 1;
+    const int nYBlocks = (nYOff + nYSize - 1) / m_nBlockYSize -
+                         nYOff / m_nBlockYSize + 1;
+    if (nXBlocks * nYBlocks <= 1)
+        return false;
+
+    // Do not decode more than what the block cache can reasonably hold,
+    // otherwise the first blocks would be evicted before being used.
+    const int nCachedBands =
+        m_nPlanarConfig == PLANARCONFIG_CONTIG ? nBands : nBandCount;
+    const GIntBig nRequiredMem =
+        static_cast<GIntBig>(nCachedBands) * nXBlocks * nYBlocks *
+        m_nBlockXSize * m_nBlockYSize *
+        GDALGetDataTypeSizeBytes(papoBands[0]->GetRasterDataType());
+    if (nRequiredMem > GDALGetCacheMax64() / 4)
+        return false;
+
+    // Only one batch at a time
+    WaitPredecodeBatch();
+
+    CPLErrorStateBackuper oErrorStateBackuper;
+    CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+    if (MultiThreadedRead(nXOff, nYOff, nXSize, nYSize, nullptr,
+                          papoBands[0]->GetRasterDataType(), nBandCount,
+                          panBandMap, 0, 0, 0) != CE_None)
+    {
+        return false;
+    }
+    if (bWait)
+        WaitPredecodeBatch();
+    return true;
+}
+#endif
+
+/************************************************************************/
+/*                        CancelPredecodeBatch()                        */
+/************************************************************************/
+
+// Stops the pre-decoding started by PredecodeBlocks(): jobs not started yet
+// do nothing, and the result of the others is discarded.
+void GTiffDataset::CancelPredecodeBatch()
+{
+#ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
+    if (!m_poPredecodeBatch)
+        return;
+    {
+        std::lock_guard<std::mutex> oLock(m_poPredecodeBatch->sContext.oMutex);
+        m_poPredecodeBatch->sContext.bSuccess = false;
+    }
+    m_poPredecodeBatch->poQueue->WaitCompletion();
+    m_poPredecodeBatch.reset();
 #endif
+}
+
+/************************************************************************/
+/*                         WaitPredecodeBatch()                         */
+/************************************************************************/
+
+// Waits for the strips/tiles being pre-decoded by PredecodeBlocks(), and
+// puts them in the block cache. Must be called before the block cache of
+// the dataset is used, as pre-decoded blocks are only visible from then.
+// If pCurImage is set and the block (nCurXBlock, nCurYBlock) of band nCurBand
+// is one of the pre-decoded ones, it is copied into pCurImage instead
+// (IReadBlock() case, where that block is already in the block cache), and
+// true is returned.
+bool GTiffDataset::WaitPredecodeBatch(int nCurBand, int nCurXBlock,
+                                      int nCurYBlock, void *pCurImage)
+{
+#ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
+    if (!m_poPredecodeBatch)
+        return false;
+    // Reset before using the block cache, which could call us again
+    std::unique_ptr<GTiffDecompressBatch> poBatch(
+        std::move(m_poPredecodeBatch));
+    poBatch->poQueue->WaitCompletion();
+
+    const GDALDataType eDT = poBatch->sContext.eDT;
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    const int nBlocksPerColumn = DIV_ROUND_UP(nRasterYSize, m_nBlockYSize);
+    const int nBandsPerStrile =
+        m_nPlanarConfig == PLANARCONFIG_CONTIG ? nBands : 1;
+    bool bCurImageFilled = false;
+    for (const auto &sJob : poBatch->asJobs)
+    {
+        if (sJob.abyDecoded.empty())
+            continue;
+        // Same as in ThreadDecompressionFunc()
+        const int nBlockReqYSize =
+            (sJob.nYBlock < nBlocksPerColumn - 1) ? m_nBlockYSize
+            : (nRasterYSize % m_nBlockYSize) == 0
+                ? m_nBlockYSize
+                : nRasterYSize % m_nBlockYSize;
+        const size_t nValues =
+            static_cast<size_t>(nBlockReqYSize) * m_nBlockXSize;
+        for (int i = 0; i < nBandsPerStrile; ++i)
+        {
+            const int iBand = sJob.iBand >= 0 ? sJob.iBand : i;
+            void *pDst = nullptr;
+            GDALRasterBlock *poBlock = nullptr;
+            if (pCurImage && iBand + 1 == nCurBand &&
+                sJob.nXBlock == nCurXBlock && sJob.nYBlock == nCurYBlock)
+            {
+                pDst = pCurImage;
+                bCurImageFilled = true;
+            }
+            else
+            {
+                GDALRasterBand *poBand = papoBands[iBand];
+                poBlock =
+                    poBand->TryGetLockedBlockRef(sJob.nXBlock, sJob.nYBlock);
+                if (poBlock)
+                {
+                    // Already loaded
+                    poBlock->DropLock();
+                    continue;
+                }
+                poBlock = poBand->GetLockedBlockRef(sJob.nXBlock, sJob.nYBlock,
+                                                    TRUE);
+                if (poBlock == nullptr)
+                    continue;
+                pDst = poBlock->GetDataRef();
+            }
+            GDALCopyWords64(sJob.abyDecoded.data() +
+                                static_cast<size_t>(i) * nDTSize,
+                            eDT, nDTSize * nBandsPerStrile, pDst, eDT, nDTSize,
+                            nValues);
+            if (poBlock)
+                poBlock->DropLock();
+        }
+    }
+    return bCurImageFilled;
+#else
+    CPL_IGNORE_RET_VAL(nCurBand);
+    CPL_IGNORE_RET_VAL(nCurXBlock);
+    CPL_IGNORE_RET_VAL(nCurYBlock);
+    CPL_IGNORE_RET_VAL(pCurImage);
+    return false;
+#endif
+}
 
 /************************************************************************/
 /*                        FetchBufferVirtualMemIO                       */
@@ -5545,6 +5999,11 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
                     "Requesting range [" CPL_FRMT_GUIB "-" CPL_FRMT_GUIB "]",
                     anOffsets.back(), anOffsets.back() + anSizes.back() - 1);
 #endif
+                CPLDebug("GTiff",
+                         "Fetching %d blocks in %d range(s) with "
+                         "VSIFReadMultiRangeL()",
+                         static_cast<int>(aOffsetSize.size()),
+                         static_cast<int>(anSizes.size()));
 
                 VSILFILE *fp = VSI_TIFFGetVSILFile(th);
 
@@ -5578,6 +6037,18 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
     return pBufferedData;
 }
 
+/************************************************************************/
+/*                            AdviseRead()                              */
+/************************************************************************/
+
+CPLErr GTiffRasterBand::AdviseRead(int nXOff, int nYOff, int nXSize,
+                                   int nYSize, int nBufXSize, int nBufYSize,
+                                   GDALDataType eDT, char **papszOptions)
+{
+    return m_poGDS->AdviseRead(nXOff, nYOff, nXSize, nYSize, nBufXSize,
+                               nBufYSize, eDT, 1, &nBand, papszOptions);
+}
+
 /************************************************************************/
 /*                            IRasterIO()                               */
 /************************************************************************/
@@ -5594,6 +6065,9 @@ CPLErr GTiffRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
              nYSize, nBufXSize, nBufYSize);
 #endif
 
+    // Make the blocks pre-decoded by AdviseRead() visible.
+    m_poGDS->WaitPredecodeBatch();
+
     // Try to pass the request to the most appropriate overview dataset.
     if (nBufXSize < nXSize && nBufYSize < nYSize)
     {
@@ -5718,6 +6192,15 @@ CPLErr GTiffRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             }
         }
     }
+#ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
+    else if (eRWFlag == GF_Read && pBufferedData == nullptr)
+    {
+        // Resampled requests are served from the block cache by the generic
+        // implementation: fill it with multi-threaded decoding first.
+        m_poGDS->PredecodeBlocks(nXOff, nYOff, nXSize, nYSize, 1, &nBand,
+                                 /* bWait = */ true);
+    }
+#endif
 
     ++m_poGDS->m_nJPEGOverviewVisibilityCounter;
     const CPLErr eErr = GDALPamRasterBand::IRasterIO(
@@ -5931,6 +6414,10 @@ CPLErr GTiffRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
 {
     m_poGDS->Crystalize();
 
+    // The block may have been pre-decoded by AdviseRead()
+    if (m_poGDS->WaitPredecodeBatch(nBand, nBlockXOff, nBlockYOff, pImage))
+        return CE_None;
+
     GPtrDiff_t nBlockBufSize = 0;
     if (TIFFIsTiled(m_poGDS->m_hTIFF))
     {
@@ -5981,6 +6468,68 @@ CPLErr GTiffRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
         return CE_None;
     }
 
+#ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
+    /* -------------------------------------------------------------------- */
+    /*      When blocks are read in sequence, as most users of              */
+    /*      GetLockedBlockRef() do, decode the next ones into the block     */
+    /*      cache with the thread pool.                                     */
+    /* -------------------------------------------------------------------- */
+    const bool bSequentialRead =
+        nBlockIdBand0 == m_nLastReadBlockId.exchange(nBlockIdBand0) + 1;
+    if (bSequentialRead && m_poGDS->m_poThreadPool &&
+        m_poGDS->eAccess == GA_ReadOnly && !m_poGDS->m_bLoadingOtherBands)
+    {
+        const int nReadAhead = m_poGDS->m_poThreadPool->GetThreadCount();
+        const bool bAlongRow = nBlocksPerRow > 1;
+        const int nNextXBlock = bAlongRow ? nBlockXOff + 1 : 0;
+        const int nNextYBlock = bAlongRow ? nBlockYOff : nBlockYOff + 1;
+        if (nNextXBlock < nBlocksPerRow && nNextYBlock < nBlocksPerColumn)
+        {
+            GDALRasterBlock *poNextBlock =
+                TryGetLockedBlockRef(nNextXBlock, nNextYBlock);
+            if (poNextBlock)
+            {
+                poNextBlock->DropLock();
+            }
+            else
+            {
+                const int nXOff = nNextXBlock * nBlockXSize;
+                const int nYOff = nNextYBlock * nBlockYSize;
+                const int nXSize =
+                    bAlongRow ? static_cast<int>(std::min<GIntBig>(
+                                    static_cast<GIntBig>(nReadAhead) *
+                                        nBlockXSize,
+                                    nRasterXSize - nXOff))
+                              : nRasterXSize;
+                const int nYSize =
+                    bAlongRow ? std::min(nBlockYSize, nRasterYSize - nYOff)
+                              : static_cast<int>(std::min<GIntBig>(
+                                    static_cast<GIntBig>(nReadAhead) *
+                                        nBlockYSize,
+                                    nRasterYSize - nYOff));
+                // The next blocks are found in the block cache, so
+                // IReadBlock() is not called for them: continue the sequence
+                // from the last one. Failures are not fatal, as the current
+                // block is valid and the next ones will be read again.
+                if (m_poGDS->PredecodeBlocks(nXOff, nYOff, nXSize, nYSize, 1,
+                                             &nBand, /* bWait = */ true))
+                {
+                    const int nLastXBlock =
+                        bAlongRow ? DIV_ROUND_UP(nXOff + nXSize, nBlockXSize) -
+                                        1
+                                  : 0;
+                    const int nLastYBlock =
+                        bAlongRow
+                            ? nNextYBlock
+                            : DIV_ROUND_UP(nYOff + nYSize, nBlockYSize) - 1;
+                    m_nLastReadBlockId =
+                        nLastXBlock + nLastYBlock * nBlocksPerRow;
+                }
+            }
+        }
+    }
+#endif
+
     if (m_poGDS->m_bStreamingIn &&
         !(m_poGDS->nBands > 1 &&
           m_poGDS->m_nPlanarConfig == PLANARCONFIG_CONTIG &&
@@ -9372,6 +9921,9 @@ int GTiffDataset::Finalize()
     if (m_bIsFinalized)
         return FALSE;
 
+    // Background pre-decoding jobs use the file handle
+    CancelPredecodeBatch();
+
     bool bHasDroppedRef = false;
 
     Crystalize();
@@ -11905,6 +12457,10 @@ void GTiffDataset::FlushCacheInternal(bool bAtClosing, bool bFlushDirectory)
     if (m_bIsFinalized)
         return;
 
+    // Blocks pre-decoded by AdviseRead() would otherwise be published after
+    // the block cache has been flushed.
+    CancelPredecodeBatch();
+
     GDALPamDataset::FlushCache(bAtClosing);
 
     if (m_bLoadedBlockDirty && m_nLoadedBlock != -1)
@@ -13200,9 +13756,27 @@ CPLErr GTiffDataset::IBuildOverviews(const char *pszResampling, int nOverviews,
             }
         }
 
+        // If the overviews are stored without loss, they can be computed in
+        // cascade from the previous level kept in memory.
+        bool bCascading = true;
+        for (int i = 0; i < m_nOverviewCount; ++i)
+        {
+            GTiffDataset *poODS = m_papoOverviewDS[i];
+            if (!GTIFFIsLosslessCompression(poODS->m_nCompression) ||
+                poODS->m_nBitsPerSample !=
+                    GDALGetDataTypeSizeBits(
+                        poODS->GetRasterBand(1)->GetRasterDataType()))
+            {
+                bCascading = false;
+            }
+        }
+        CPLStringList aosOptions(papszOptions);
+        if (bCascading)
+            aosOptions.SetNameValue("CASCADING", "YES");
+
         GDALRegenerateOverviewsMultiBand(
             nBandsIn, papoBandList, nNewOverviews, papapoOverviewBands,
-            pszResampling, pfnProgress, pProgressData, papszOptions);
+            pszResampling, pfnProgress, pProgressData, aosOptions.List());
 
         for (int iBand = 0; iBand < nBandsIn; ++iBand)
         {
@@ -19743,6 +20317,220 @@ CPLErr GTiffDataset::CopyImageryAndMask(GTiffDataset *poDstDS,
     return eErr;
 }
 
+/************************************************************************/
+/*                          CanCopyRawTiles()                           */
+/*                                                                      */
+/*      Return whether the compressed tiles of poSrcDS can be written   */
+/*      as they are into poDstDS, that is if both datasets use the      */
+/*      same lossless encoding and tiling.                              */
+/************************************************************************/
+
+bool GTiffDataset::CanCopyRawTiles(GTiffDataset *poDstDS,
+                                   GTiffDataset *poSrcDS)
+{
+    // only for debug/testing purposes
+    if (!CPLTestBool(CPLGetConfigOption("GTIFF_COPY_RAW_TILES", "YES")))
+        return false;
+
+    switch (poDstDS->m_nCompression)
+    {
+        case COMPRESSION_NONE:
+        case COMPRESSION_LZW:
+        case COMPRESSION_ADOBE_DEFLATE:
+        case COMPRESSION_ZSTD:
+            break;
+        default:
+            return false;
+    }
+
+    if (poSrcDS->m_nCompression != poDstDS->m_nCompression ||
+        !TIFFIsTiled(poSrcDS->m_hTIFF) || !TIFFIsTiled(poDstDS->m_hTIFF) ||
+        poSrcDS->nRasterXSize != poDstDS->nRasterXSize ||
+        poSrcDS->nRasterYSize != poDstDS->nRasterYSize ||
+        poSrcDS->m_nBlockXSize != poDstDS->m_nBlockXSize ||
+        poSrcDS->m_nBlockYSize != poDstDS->m_nBlockYSize ||
+        poSrcDS->m_nPlanarConfig != poDstDS->m_nPlanarConfig ||
+        poSrcDS->m_nSamplesPerPixel != poDstDS->m_nSamplesPerPixel ||
+        poSrcDS->m_nBitsPerSample != poDstDS->m_nBitsPerSample ||
+        poSrcDS->m_nSampleFormat != poDstDS->m_nSampleFormat ||
+        TIFFIsByteSwapped(poSrcDS->m_hTIFF) !=
+            TIFFIsByteSwapped(poDstDS->m_hTIFF))
+    {
+        return false;
+    }
+
+    if (poDstDS->m_nCompression != COMPRESSION_NONE)
+    {
+        uint16_t nSrcPredictor = PREDICTOR_NONE;
+        uint16_t nDstPredictor = PREDICTOR_NONE;
+        TIFFGetFieldDefaulted(poSrcDS->m_hTIFF, TIFFTAG_PREDICTOR,
+                              &nSrcPredictor);
+        TIFFGetFieldDefaulted(poDstDS->m_hTIFF, TIFFTAG_PREDICTOR,
+                              &nDstPredictor);
+        if (nSrcPredictor != nDstPredictor)
+            return false;
+    }
+
+    // If empty tiles must be written, the source must not be sparse.
+    if (poDstDS->m_bWriteEmptyTiles)
+    {
+        const int nBlocks = poDstDS->m_nBlocksPerBand *
+                            (poDstDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE
+                                 ? poDstDS->nBands
+                                 : 1);
+        for (int iBlock = 0; iBlock < nBlocks; ++iBlock)
+        {
+            if (!poSrcDS->IsBlockAvailable(iBlock))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                            CopyRawTiles()                            */
+/*                                                                      */
+/*      Copy the compressed tiles of poSrcDS into poDstDS, in order,    */
+/*      without decoding and re-encoding them.                          */
+/*                                                                      */
+/*      If poDstDS has a mask, each mask tile is written after the      */
+/*      imagery one, as CopyImageryAndMask() does. The mask tiles are   */
+/*      encoded from poSrcMaskBand: they are 1-bit in poDstDS, so they  */
+/*      cannot be copied from a temporary 8-bit mask overview.          */
+/************************************************************************/
+
+CPLErr GTiffDataset::CopyRawTiles(GTiffDataset *poDstDS, GTiffDataset *poSrcDS,
+                                  GDALRasterBand *poSrcMaskBand,
+                                  GDALProgressFunc pfnProgress,
+                                  void *pProgressData)
+{
+    VSILFILE *fpSrc = VSI_TIFFGetVSILFile(TIFFClientdata(poSrcDS->m_hTIFF));
+    const int nBlocks = poDstDS->m_nBlocksPerBand *
+                        (poDstDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE
+                             ? poDstDS->nBands
+                             : 1);
+    const int nBlocksPerRow =
+        DIV_ROUND_UP(poDstDS->nRasterXSize, poDstDS->m_nBlockXSize);
+    GTiffDataset *poDstMaskDS = poDstDS->m_poMaskDS;
+    CPLAssert(poDstMaskDS == nullptr || poSrcMaskBand != nullptr);
+    CPLAssert(poDstMaskDS == nullptr ||
+              poDstDS->m_nPlanarConfig == PLANARCONFIG_CONTIG ||
+              poDstDS->nBands == 1);
+    std::vector<GByte> abyRaw;
+    std::vector<GByte> abyMask;
+    if (poDstMaskDS)
+    {
+        CPLAssert(poDstMaskDS->m_nBlockXSize == poDstDS->m_nBlockXSize);
+        CPLAssert(poDstMaskDS->m_nBlockYSize == poDstDS->m_nBlockYSize);
+        try
+        {
+            abyMask.resize(static_cast<size_t>(poDstDS->m_nBlockXSize) *
+                           poDstDS->m_nBlockYSize);
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate mask block");
+            return CE_Failure;
+        }
+    }
+    for (int iBlock = 0; iBlock < nBlocks; ++iBlock)
+    {
+        vsi_l_offset nOffset = 0;
+        vsi_l_offset nSize = 0;
+        bool bErrOccurred = false;
+        if (poSrcDS->IsBlockAvailable(iBlock, &nOffset, &nSize,
+                                      &bErrOccurred))
+        {
+            if (nSize > static_cast<vsi_l_offset>(
+                            std::numeric_limits<GPtrDiff_t>::max()))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Too large tile %d in %s", iBlock,
+                         poSrcDS->GetDescription());
+                return CE_Failure;
+            }
+            try
+            {
+                abyRaw.resize(static_cast<size_t>(nSize));
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate " CPL_FRMT_GUIB " bytes",
+                         static_cast<GUIntBig>(nSize));
+                return CE_Failure;
+            }
+            if (VSIFSeekL(fpSrc, nOffset, SEEK_SET) != 0 ||
+                VSIFReadL(abyRaw.data(), 1, abyRaw.size(), fpSrc) !=
+                    abyRaw.size())
+            {
+                CPLError(CE_Failure, CPLE_FileIO, "Cannot read tile %d of %s",
+                         iBlock, poSrcDS->GetDescription());
+                return CE_Failure;
+            }
+            poDstDS->WriteRawStripOrTile(iBlock, abyRaw.data(),
+                                         static_cast<GPtrDiff_t>(nSize));
+            if (poDstDS->m_bWriteError)
+                return CE_Failure;
+        }
+        else if (bErrOccurred)
+        {
+            return CE_Failure;
+        }
+
+        if (poDstMaskDS)
+        {
+            const int nXBlock = iBlock % nBlocksPerRow;
+            const int nYBlock = iBlock / nBlocksPerRow;
+            const int iX = nXBlock * poDstDS->m_nBlockXSize;
+            const int iY = nYBlock * poDstDS->m_nBlockYSize;
+            const int nReqXSize =
+                std::min(poDstDS->nRasterXSize - iX, poDstDS->m_nBlockXSize);
+            const int nReqYSize =
+                std::min(poDstDS->nRasterYSize - iY, poDstDS->m_nBlockYSize);
+            if (nReqXSize < poDstDS->m_nBlockXSize ||
+                nReqYSize < poDstDS->m_nBlockYSize)
+            {
+                std::fill(abyMask.begin(), abyMask.end(), 0);
+            }
+            if (poSrcMaskBand->RasterIO(GF_Read, iX, iY, nReqXSize, nReqYSize,
+                                        abyMask.data(), nReqXSize, nReqYSize,
+                                        GDT_Byte, 1, poDstDS->m_nBlockXSize,
+                                        nullptr) != CE_None)
+            {
+                return CE_Failure;
+            }
+            // Avoid any attempt to load from disk
+            poDstMaskDS->m_nLoadedBlock = iBlock;
+            if (poDstMaskDS->GetRasterBand(1)->WriteBlock(
+                    nXBlock, nYBlock, abyMask.data()) != CE_None ||
+                poDstMaskDS->FlushBlockBuf() != CE_None ||
+                poDstDS->m_bWriteError)
+            {
+                return CE_Failure;
+            }
+        }
+
+        if (pfnProgress &&
+            !pfnProgress(static_cast<double>(iBlock + 1) / nBlocks, nullptr,
+                         pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    if (poDstMaskDS)
+    {
+        // Wait for the completion of the mask compression jobs
+        poDstDS->FlushCache(false);
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                             CreateCopy()                             */
 /************************************************************************/
@@ -21119,9 +21907,29 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
                         dfNextCurPixels / dfTotalPixels, pfnProgress,
                         pProgressData);
 
-                    eErr =
-                        CopyImageryAndMask(poDstDS, poSrcOvrDS, poSrcMaskBand,
-                                           GDALScaledProgress, pScaledData);
+                    // When the source overview level is a GeoTIFF encoded
+                    // as the target one (typically the temporary overview
+                    // file of the COG driver), copy its tiles as they are.
+                    GTiffDataset *poSrcOvrGTiffDS =
+                        dynamic_cast<GTiffDataset *>(
+                            poSrcOvrBand->GetDataset());
+                    if (poSrcOvrGTiffDS &&
+                        CanCopyRawTiles(poDstDS, poSrcOvrGTiffDS))
+                    {
+                        CPLDebug("GTiff",
+                                 "Copying raw tiles of overview level %d",
+                                 iOvrLevel);
+                        eErr = CopyRawTiles(poDstDS, poSrcOvrGTiffDS,
+                                            poSrcMaskBand, GDALScaledProgress,
+                                            pScaledData);
+                    }
+                    else
+                    {
+                        eErr = CopyImageryAndMask(poDstDS, poSrcOvrDS,
+                                                  poSrcMaskBand,
+                                                  GDALScaledProgress,
+                                                  pScaledData);
+                    }
 
                     dfCurPixels = dfNextCurPixels;
                     GDALDestroyScaledProgress(pScaledData);
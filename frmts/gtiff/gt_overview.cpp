@@ -1147,10 +1147,21 @@ CPLErr GTIFFBuildOverviewsEx(const char *pszFilename, int nBands,
                 "GDAL_NUM_THREADS",
                 CSLFetchNameValue(papszOptions, "NUM_THREADS"), true);
 
+            // If the overviews are stored without loss, they can be computed
+            // in cascade from the previous level kept in memory.
+            CPLStringList aosOptions(papszOptions);
+            if (GTIFFIsLosslessCompression(nCompression) &&
+                nBitsPerPixel == GDALGetDataTypeSizeBits(
+                                     papoBandList[0]->GetRasterDataType()))
+            {
+                aosOptions.SetNameValue("CASCADING", "YES");
+            }
+
             if (eErr == CE_None)
                 eErr = GDALRegenerateOverviewsMultiBand(
                     nBands, papoBandList, nOverviews, papapoOverviewBands,
-                    pszResampling, pfnProgress, pProgressData, papszOptions);
+                    pszResampling, pfnProgress, pProgressData,
+                    aosOptions.List());
         }
 
         for (int iBand = 0; iBand < nBands; iBand++)
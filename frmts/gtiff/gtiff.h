@@ -56,6 +56,7 @@ void GTIFFSetMaxZError(GDALDatasetH hGTIFFDS, double dfMaxZError);
 int GTIFFGetCompressionMethod(const char *pszValue,
                               const char *pszVariableName);
 bool GTIFFSupportsPredictor(int nCompression);
+bool GTIFFIsLosslessCompression(int nCompression);
 bool GTIFFUpdatePhotometric(const char *pszPhotometric,
                             const char *pszOptionKey, int nCompression,
                             const char *pszInterleave, int nBands,
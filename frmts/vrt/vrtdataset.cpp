@@ -35,6 +35,7 @@
 #include "ogr_spatialref.h"
 #include "gdal_utils.h"
 
+#include "gdal_thread_pool.h"
 #include <algorithm>
 #include <typeinfo>
 #include "gdal_proxy.h"
@@ -1525,6 +1526,15 @@ int VRTDataset::CloseDependentDatasets()
 
     int bHasDroppedRef = GDALDataset::CloseDependentDatasets();
 
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutexClones);
+        if (!m_oMapThreadToClone.empty())
+        {
+            bHasDroppedRef = TRUE;
+            m_oMapThreadToClone.clear();
+        }
+    }
+
     for (int iBand = 0; iBand < nBands; iBand++)
     {
         bHasDroppedRef |= static_cast<VRTRasterBand *>(papoBands[iBand])
@@ -1739,6 +1749,262 @@ CPLErr VRTDataset::AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
                                panBandList, papszOptions);
 }
 
+/************************************************************************/
+/*                      GetNumThreadsForRasterIO()                      */
+/************************************************************************/
+
+int VRTDataset::GetNumThreadsForRasterIO() const
+{
+    // VRT_NUM_THREADS takes precedence over GDAL_NUM_THREADS
+    const char *pszVRTNumThreads =
+        CPLGetConfigOption("VRT_NUM_THREADS", nullptr);
+    return GDALGetNumThreads(papszOpenOptions, pszVRTNumThreads == nullptr,
+                             128, pszVRTNumThreads ? pszVRTNumThreads : "1");
+}
+
+/************************************************************************/
+/*                    CanUseMultiThreadedRasterIO()                     */
+/************************************************************************/
+
+// Minimum number of lines of a sub-window processed by a worker thread.
+// Each worker thread reads the sources through its own clone of the VRT, so
+// source blocks crossing sub-window boundaries are decoded once per thread.
+constexpr int MT_RASTERIO_MIN_LINES_PER_JOB = 128;
+
+/* Returns true if the request can be split in horizontal sub-windows that */
+/* are processed concurrently by MultiThreadedRasterIO(). This requires a  */
+/* non-resampled read on bands only made of simple/complex sources whose   */
+/* datasets can be re-opened by name in each worker thread.                */
+
+bool VRTDataset::CanUseMultiThreadedRasterIO(
+    GDALRWFlag eRWFlag, int nXSize, int nYSize, int nBufXSize, int nBufYSize,
+    int nBandCount, const int *panBandMap,
+    const GDALRasterIOExtraArg *psExtraArg)
+{
+    if (eRWFlag != GF_Read || m_bIsMultiThreadedRasterIOClone ||
+        GDALIsInGlobalThreadPool() || nXSize != nBufXSize ||
+        nYSize != nBufYSize ||
+        nBufYSize < 2 * MT_RASTERIO_MIN_LINES_PER_JOB ||
+        (psExtraArg && psExtraArg->bFloatingPointWindowValidity) ||
+        m_poRootGroup != nullptr)
+    {
+        return false;
+    }
+
+    if (GetNumThreadsForRasterIO() <= 1)
+        return false;
+
+    for (int iBandIndex = 0; iBandIndex < nBandCount; iBandIndex++)
+    {
+        auto poBand = dynamic_cast<VRTSourcedRasterBand *>(
+            GetRasterBand(panBandMap[iBandIndex]));
+        if (poBand == nullptr ||
+            dynamic_cast<VRTDerivedRasterBand *>(poBand) != nullptr)
+        {
+            return false;
+        }
+
+        for (int iSource = 0; iSource < poBand->nSources; iSource++)
+        {
+            if (!poBand->papoSources[iSource]->IsSimpleSource())
+                return false;
+            auto poSource =
+                cpl::down_cast<VRTSimpleSource *>(poBand->papoSources[iSource]);
+            if (poSource->m_osSrcDSName.empty())
+                return false;
+
+            // Sources set from an already opened dataset can only be
+            // re-opened if they do not belong to an in-memory dataset.
+            auto poSrcBand = poSource->GetRasterBandNoOpen();
+            if (poSrcBand)
+            {
+                auto poSrcDS = poSrcBand->GetDataset();
+                if (poSrcDS == nullptr)
+                    return false;
+                if (dynamic_cast<GDALProxyPoolDataset *>(poSrcDS) == nullptr)
+                {
+                    auto poSrcDriver = poSrcDS->GetDriver();
+                    if (poSrcDriver == nullptr ||
+                        EQUAL(poSrcDriver->GetDescription(), "MEM"))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                    GetMultiThreadedRasterIOClone()                   */
+/************************************************************************/
+
+/* Returns the clone of this dataset owned by the calling worker thread,   */
+/* instantiating it from m_osClonesXML if needed. The clone must be opened */
+/* by the worker thread itself, so that the source datasets it opens       */
+/* through the proxy pool are not shared with other threads.               */
+
+GDALDataset *VRTDataset::GetMultiThreadedRasterIOClone()
+{
+    const GIntBig nThreadId = CPLGetPID();
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutexClones);
+        auto oIter = m_oMapThreadToClone.find(nThreadId);
+        if (oIter != m_oMapThreadToClone.end())
+            return oIter->second.get();
+    }
+
+    std::unique_ptr<GDALDataset> poClone(
+        OpenXML(m_osClonesXML.c_str(), m_pszVRTPath, GA_ReadOnly));
+    auto poVRTClone = dynamic_cast<VRTDataset *>(poClone.get());
+    if (poVRTClone == nullptr)
+        return nullptr;
+    poVRTClone->m_bIsMultiThreadedRasterIOClone = true;
+
+    std::lock_guard<std::mutex> oLock(m_oMutexClones);
+    m_oMapThreadToClone[nThreadId] = std::move(poClone);
+    return poVRTClone;
+}
+
+/************************************************************************/
+/*                        MultiThreadedRasterIO()                       */
+/************************************************************************/
+
+/* Split the request in horizontal sub-windows that are read concurrently */
+/* on the global thread pool, each worker thread using its own clone of   */
+/* the VRT dataset. Within each sub-window, sources are composited in     */
+/* their order of declaration, so the result is the same as the one of    */
+/* the single-threaded code path, including for overlapping sources.      */
+
+CPLErr VRTDataset::MultiThreadedRasterIO(
+    int nXOff, int nYOff, int nXSize, int nYSize, void *pData,
+    GDALDataType eBufType, int nBandCount, const int *panBandMap,
+    GSpacing nPixelSpace, GSpacing nLineSpace, GSpacing nBandSpace,
+    GDALRasterIOExtraArg *psExtraArg)
+{
+    const int nThreads = GetNumThreadsForRasterIO();
+    const int nJobs =
+        std::min(nThreads, nYSize / MT_RASTERIO_MIN_LINES_PER_JOB);
+    CPLAssert(nJobs >= 2);
+
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    if (poThreadPool == nullptr)
+        return CE_Failure;
+
+    /* -------------------------------------------------------------------- */
+    /*      Serialize the current state of the dataset if it has been       */
+    /*      modified (see SetNeedsFlush()) since the clones were opened,    */
+    /*      and discard the existing clones.                                */
+    /* -------------------------------------------------------------------- */
+    if (!m_bClonesXMLValid)
+    {
+        CPLXMLNode *psTree = SerializeToXML(m_pszVRTPath);
+        if (psTree == nullptr)
+            return CE_Failure;
+        char *pszXML = CPLSerializeXMLTree(psTree);
+        CPLDestroyXMLNode(psTree);
+        if (pszXML == nullptr)
+            return CE_Failure;
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutexClones);
+            m_oMapThreadToClone.clear();
+            m_osClonesXML = pszXML;
+        }
+        CPLFree(pszXML);
+        m_bClonesXMLValid = true;
+    }
+
+    struct Job
+    {
+        VRTDataset *poDS = nullptr;
+        int nXOff = 0;
+        int nYOff = 0;
+        int nXSize = 0;
+        int nYSize = 0;
+        GByte *pabyData = nullptr;
+        GDALDataType eBufType = GDT_Unknown;
+        int nBandCount = 0;
+        int *panBandMap = nullptr;
+        GSpacing nPixelSpace = 0;
+        GSpacing nLineSpace = 0;
+        GSpacing nBandSpace = 0;
+        GDALRIOResampleAlg eResampleAlg = GRIORA_NearestNeighbour;
+        bool bSuccess = false;
+    };
+
+    const auto JobRunner = [](void *pJobData)
+    {
+        Job *psJob = static_cast<Job *>(pJobData);
+
+        // The sources opened by the clone must not use the global thread
+        // pool themselves, as waiting for their jobs from this worker
+        // thread could deadlock once all workers run such VRT jobs.
+        CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", "1", false);
+
+        GDALDataset *poClone = psJob->poDS->GetMultiThreadedRasterIOClone();
+        if (poClone == nullptr)
+            return;
+
+        GDALRasterIOExtraArg sExtraArg;
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+        sExtraArg.eResampleAlg = psJob->eResampleAlg;
+        psJob->bSuccess =
+            poClone->RasterIO(GF_Read, psJob->nXOff, psJob->nYOff,
+                              psJob->nXSize, psJob->nYSize, psJob->pabyData,
+                              psJob->nXSize, psJob->nYSize, psJob->eBufType,
+                              psJob->nBandCount, psJob->panBandMap,
+                              psJob->nPixelSpace, psJob->nLineSpace,
+                              psJob->nBandSpace, &sExtraArg) == CE_None;
+    };
+
+    CPLDebugOnly("VRT", "MultiThreadedRasterIO(): using %d jobs", nJobs);
+
+    std::vector<int> anBandMap(panBandMap, panBandMap + nBandCount);
+    std::vector<Job> asJobs(nJobs);
+    const int nLinesPerJob = DIV_ROUND_UP(nYSize, nJobs);
+    auto poQueue = poThreadPool->CreateJobQueue();
+    bool bSubmitError = false;
+    for (int i = 0; i < nJobs; ++i)
+    {
+        const int nLineStart = i * nLinesPerJob;
+        Job &sJob = asJobs[i];
+        sJob.poDS = this;
+        sJob.nXOff = nXOff;
+        sJob.nYOff = nYOff + nLineStart;
+        sJob.nXSize = nXSize;
+        sJob.nYSize = std::min(nLinesPerJob, nYSize - nLineStart);
+        sJob.pabyData = static_cast<GByte *>(pData) + nLineStart * nLineSpace;
+        sJob.eBufType = eBufType;
+        sJob.nBandCount = nBandCount;
+        sJob.panBandMap = anBandMap.data();
+        sJob.nPixelSpace = nPixelSpace;
+        sJob.nLineSpace = nLineSpace;
+        sJob.nBandSpace = nBandSpace;
+        sJob.eResampleAlg = psExtraArg->eResampleAlg;
+        if (!poQueue->SubmitJob(JobRunner, &sJob))
+        {
+            bSubmitError = true;
+            break;
+        }
+    }
+    poQueue->WaitCompletion();
+
+    if (bSubmitError)
+        return CE_Failure;
+    for (const auto &sJob : asJobs)
+    {
+        if (!sJob.bSuccess)
+            return CE_Failure;
+    }
+
+    if (psExtraArg->pfnProgress)
+        psExtraArg->pfnProgress(1.0, "", psExtraArg->pProgressData);
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                              IRasterIO()                             */
 /************************************************************************/
@@ -1751,6 +2017,16 @@ CPLErr VRTDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                              GSpacing nBandSpace,
                              GDALRasterIOExtraArg *psExtraArg)
 {
+    if (CanUseMultiThreadedRasterIO(eRWFlag, nXSize, nYSize, nBufXSize,
+                                    nBufYSize, nBandCount, panBandMap,
+                                    psExtraArg))
+    {
+        return MultiThreadedRasterIO(nXOff, nYOff, nXSize, nYSize, pData,
+                                     eBufType, nBandCount, panBandMap,
+                                     nPixelSpace, nLineSpace, nBandSpace,
+                                     psExtraArg);
+    }
+
     bool bLocalCompatibleForDatasetIO =
         CPL_TO_BOOL(CheckCompatibleForDatasetIO());
     if (bLocalCompatibleForDatasetIO && eRWFlag == GF_Read &&
@@ -44,6 +44,8 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 int VRTApplyMetadata(CPLXMLNode *, GDALMajorObject *);
@@ -209,6 +211,17 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
     std::map<CPLString, GDALDataset *> m_oMapSharedSources{};
     std::shared_ptr<VRTGroup> m_poRootGroup{};
 
+    // Per-thread clones of this dataset used by MultiThreadedRasterIO(),
+    // keyed by the id of the worker thread that opened them.
+    bool m_bIsMultiThreadedRasterIOClone = false;
+    std::mutex m_oMutexClones{};
+    std::string m_osClonesXML{};
+    bool m_bClonesXMLValid = false;
+    std::map<GIntBig, std::unique_ptr<GDALDataset>> m_oMapThreadToClone{};
+
+    int GetNumThreadsForRasterIO() const;
+    GDALDataset *GetMultiThreadedRasterIOClone();
+
     VRTRasterBand *InitBand(const char *pszSubclass, int nBand,
                             bool bAllowPansharpened);
     static GDALDataset *OpenVRTProtocol(const char *pszSpec);
@@ -231,6 +244,8 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
     void SetNeedsFlush()
     {
         m_bNeedsFlush = true;
+        // The clones used by MultiThreadedRasterIO() must be re-created
+        m_bClonesXMLValid = false;
     }
     virtual void FlushCache(bool bAtClosing) override;
 
@@ -286,6 +301,17 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
                               int nBandCount, int *panBandList,
                               char **papszOptions) override;
 
+    bool CanUseMultiThreadedRasterIO(GDALRWFlag eRWFlag, int nXSize,
+                                     int nYSize, int nBufXSize, int nBufYSize,
+                                     int nBandCount, const int *panBandMap,
+                                     const GDALRasterIOExtraArg *psExtraArg);
+    CPLErr MultiThreadedRasterIO(int nXOff, int nYOff, int nXSize, int nYSize,
+                                 void *pData, GDALDataType eBufType,
+                                 int nBandCount, const int *panBandMap,
+                                 GSpacing nPixelSpace, GSpacing nLineSpace,
+                                 GSpacing nBandSpace,
+                                 GDALRasterIOExtraArg *psExtraArg);
+
     virtual CPLXMLNode *SerializeToXML(const char *pszVRTPath);
     virtual CPLErr XMLInit(CPLXMLNode *, const char *);
 
@@ -493,6 +493,8 @@ void GDALRegister_VRT()
         "relative paths inside the VRT. Mainly useful for inlined VRT, or "
         "in-memory "
         "VRT, where their own directory does not make sense'/>"
+        "  <Option name='NUM_THREADS' type='string' description='Number of "
+        "worker threads for reading sources, or ALL_CPUS'/>"
         "</OpenOptionList>");
 
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
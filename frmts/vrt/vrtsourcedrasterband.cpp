@@ -179,6 +179,18 @@ CPLErr VRTSourcedRasterBand::IRasterIO(
             return CE_None;
     }
 
+    /* ==================================================================== */
+    /*      Read sub-windows of the request concurrently if allowed.        */
+    /* ==================================================================== */
+    if (l_poDS && l_poDS->GetRasterBand(nBand) == this &&
+        l_poDS->CanUseMultiThreadedRasterIO(eRWFlag, nXSize, nYSize, nBufXSize,
+                                            nBufYSize, 1, &nBand, psExtraArg))
+    {
+        return l_poDS->MultiThreadedRasterIO(
+            nXOff, nYOff, nXSize, nYSize, pData, eBufType, 1, &nBand,
+            nPixelSpace, nLineSpace, 0, psExtraArg);
+    }
+
     // If resampling with non-nearest neighbour, we need to be careful
     // if the VRT band exposes a nodata value, but the sources do not have it
     if (eRWFlag == GF_Read && (nXSize != nBufXSize || nYSize != nBufYSize) &&
@@ -31,6 +31,7 @@
 
 #include "cpl_compressor.h"
 #include "cpl_json.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_priv.h"
 #include "gdal_pam.h"
 #include "memmultidim.h"
@@ -541,6 +542,15 @@ class ZarrArray final : public GDALPamMDArray
     };
     mutable std::map<uint64_t, CachedTile> m_oMapTileIndexToCachedTile{};
 
+    // Asynchronous tile writing, enabled with GDAL_NUM_THREADS.
+    mutable bool m_bTileWriteQueueInitDone = false;
+    mutable std::unique_ptr<CPLJobQueue> m_poTileWriteJobQueue{};
+    mutable int m_nMaxPendingTileWrites = 0;
+    // Below members are protected by m_oMutex
+    mutable std::set<std::string> m_oSetPendingTileWrites{};
+    mutable bool m_bTileWriteError = false;
+    mutable std::string m_osTileWriteErrorMsg{};
+
     ZarrArray(const std::shared_ptr<ZarrSharedResource> &poSharedResource,
               const std::string &osParentName, const std::string &osName,
               const std::vector<std::shared_ptr<GDALDimension>> &aoDims,
@@ -576,8 +586,30 @@ class ZarrArray final : public GDALPamMDArray
 
     void DeallocateDecodedTileData();
 
+    std::string BuildTileFilename(const uint64_t *tileIndices) const;
+
+    bool IsEmptyTile(const std::vector<GByte> &abyTile) const;
+
+    void EncodeTile(const std::vector<GByte> &abyDecodedTileData,
+                    std::vector<GByte> &abyRawTileData) const;
+
+    bool WriteTile(const std::string &osFilename,
+                   std::vector<GByte> &abyRawTileData,
+                   std::vector<GByte> &abyTmpRawTileData) const;
+
+    bool DeleteTile(const std::string &osFilename) const;
+
     bool FlushDirtyTile() const;
 
+    CPLJobQueue *GetTileWriteJobQueue() const;
+
+    bool SubmitTileWrite(const std::string &osFilename, bool bEmptyTile) const;
+
+    bool IsTileWritePending(const std::string &osFilename) const;
+
+    bool WaitTileWrites() const;
+    bool ReportTileWriteError() const;
+
     std::shared_ptr<GDALMDArray> OpenTilePresenceCache(bool bCanCreate) const;
 
     // Disable copy constructor and assignment operator
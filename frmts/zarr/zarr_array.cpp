@@ -202,6 +202,12 @@ ZarrArray::~ZarrArray()
 void ZarrArray::Flush()
 {
     FlushDirtyTile();
+    if (!WaitTileWrites())
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "Flush of %s failed: not all tiles could be written",
+                 GetFullName().c_str());
+    }
     bool bSerializeV3 = false;
 
     if (m_bDefinitionModified)
@@ -1169,6 +1175,13 @@ static void DecodeSourceElt(const std::vector<DtypeElt> &elts,
 bool ZarrArray::LoadTileData(const uint64_t *tileIndices,
                              bool &bMissingTileOut) const
 {
+    // Make sure that a queued version of the tile has reached the storage
+    if (IsTileWritePending(BuildTileFilename(tileIndices)) &&
+        !WaitTileWrites())
+    {
+        return false;
+    }
+
     return LoadTileData(tileIndices,
                         false,  // use mutex
                         m_psDecompressor, m_abyRawTileData, m_abyTmpRawTileData,
@@ -1193,33 +1206,7 @@ bool ZarrArray::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
 
     bMissingTileOut = false;
 
-    std::string osFilename;
-    if (m_aoDims.empty())
-    {
-        osFilename = "0";
-    }
-    else
-    {
-        for (size_t i = 0; i < m_aoDims.size(); ++i)
-        {
-            if (!osFilename.empty())
-                osFilename += m_osDimSeparator;
-            osFilename += std::to_string(tileIndices[i]);
-        }
-    }
-
-    if (m_nVersion == 2)
-    {
-        osFilename = CPLFormFilename(CPLGetDirname(m_osFilename.c_str()),
-                                     osFilename.c_str(), nullptr);
-    }
-    else
-    {
-        std::string osTmp = m_osRootDirectoryName + "/data/root";
-        if (GetFullName() != "/")
-            osTmp += GetFullName();
-        osFilename = osTmp + "/c" + osFilename;
-    }
+    std::string osFilename = BuildTileFilename(tileIndices);
 
     // For network file systems, get the streaming version of the filename,
     // as we don't need arbitrary seeking in the file
@@ -1483,20 +1470,8 @@ bool ZarrArray::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
         return false;
     }
 
-    const int nThreadsMax = [papszOptions]()
-    {
-        int nThreadsTmp;
-        const char *pszNumThreads = CSLFetchNameValueDef(
-            papszOptions, "NUM_THREADS",
-            CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS"));
-        if (EQUAL(pszNumThreads, "ALL_CPUS"))
-            nThreadsTmp = CPLGetNumCPUs();
-        else
-            nThreadsTmp = std::max(1, atoi(pszNumThreads));
-        if (nThreadsTmp > 1024)
-            nThreadsTmp = 1024;
-        return nThreadsTmp;
-    }();
+    const int nThreadsMax =
+        GDALGetNumThreads(papszOptions, true, 1024, "ALL_CPUS");
     if (nThreadsMax <= 1)
         return true;
     CPLDebug(ZARR_DEBUG_KEY, "IAdviseRead(): Using up to %d threads",
@@ -1562,6 +1537,10 @@ lbl_next_depth:
         goto lbl_return_to_caller;
     assert(nTileIter == nReqTiles);
 
+    // Tiles being written must have reached the storage before reading them
+    if (!WaitTileWrites())
+        return false;
+
     CPLWorkerThreadPool *wtp = GDALGetGlobalThreadPool(nThreadsMax);
     if (wtp == nullptr)
         return false;
@@ -2192,27 +2171,23 @@ lbl_next_depth:
 }
 
 /************************************************************************/
-/*                    ZarrArray::FlushDirtyTile()                       */
+/*                   ZarrArray::BuildTileFilename()                     */
 /************************************************************************/
 
-bool ZarrArray::FlushDirtyTile() const
+std::string ZarrArray::BuildTileFilename(const uint64_t *tileIndices) const
 {
-    if (!m_bDirtyTile)
-        return true;
-    m_bDirtyTile = false;
-
     std::string osFilename;
-    if (m_anCachedTiledIndices.empty())
+    if (m_aoDims.empty())
     {
         osFilename = "0";
     }
     else
     {
-        for (const auto index : m_anCachedTiledIndices)
+        for (size_t i = 0; i < m_aoDims.size(); ++i)
         {
             if (!osFilename.empty())
                 osFilename += m_osDimSeparator;
-            osFilename += std::to_string(index);
+            osFilename += std::to_string(tileIndices[i]);
         }
     }
 
@@ -2228,38 +2203,35 @@ bool ZarrArray::FlushDirtyTile() const
             osTmp += GetFullName();
         osFilename = osTmp + "/c" + osFilename;
     }
+    return osFilename;
+}
 
-    const size_t nSourceSize =
-        m_aoDtypeElts.back().nativeOffset + m_aoDtypeElts.back().nativeSize;
-    auto &abyTile =
-        m_abyDecodedTileData.empty() ? m_abyRawTileData : m_abyDecodedTileData;
+/************************************************************************/
+/*                      ZarrArray::IsEmptyTile()                        */
+/************************************************************************/
 
-    bool bEmptyTile = false;
+bool ZarrArray::IsEmptyTile(const std::vector<GByte> &abyTile) const
+{
     if (m_pabyNoData == nullptr || (m_oType.GetClass() == GEDTC_NUMERIC &&
                                     GetNoDataValueAsDouble() == 0.0))
     {
         const size_t nBytes = abyTile.size();
         size_t i = 0;
-        bEmptyTile = true;
         for (; i + (sizeof(size_t) - 1) < nBytes; i += sizeof(size_t))
         {
             if (*reinterpret_cast<const size_t *>(abyTile.data() + i) != 0)
             {
-                bEmptyTile = false;
-                break;
+                return false;
             }
         }
-        if (bEmptyTile)
+        for (; i < nBytes; ++i)
         {
-            for (; i < nBytes; ++i)
+            if (abyTile[i] != 0)
             {
-                if (abyTile[i] != 0)
-                {
-                    bEmptyTile = false;
-                    break;
-                }
+                return false;
             }
         }
+        return true;
     }
     else if (m_oType.GetClass() == GEDTC_NUMERIC &&
              !GDALDataTypeIsComplex(m_oType.GetNumericDataType()))
@@ -2267,7 +2239,7 @@ bool ZarrArray::FlushDirtyTile() const
         const int nDTSize = static_cast<int>(m_oType.GetSize());
         const size_t nElts = abyTile.size() / nDTSize;
         const auto eDT = m_oType.GetNumericDataType();
-        bEmptyTile = GDALBufferHasOnlyNoData(
+        return GDALBufferHasOnlyNoData(
             abyTile.data(), GetNoDataValueAsDouble(),
             nElts,        // nWidth
             1,            // nHeight
@@ -2279,42 +2251,65 @@ bool ZarrArray::FlushDirtyTile() const
                                              : GSF_UNSIGNED_INT)
                 : GSF_FLOATING_POINT);
     }
+    return false;
+}
 
-    if (bEmptyTile)
-    {
-        m_bCachedTiledEmpty = true;
+/************************************************************************/
+/*                       ZarrArray::EncodeTile()                        */
+/************************************************************************/
 
-        VSIStatBufL sStat;
-        if (VSIStatL(osFilename.c_str(), &sStat) == 0)
-        {
-            CPLDebugOnly(ZARR_DEBUG_KEY,
-                         "Deleting tile %s that has now empty content",
-                         osFilename.c_str());
-            return VSIUnlink(osFilename.c_str()) == 0;
-        }
-        return true;
+void ZarrArray::EncodeTile(const std::vector<GByte> &abyDecodedTileData,
+                           std::vector<GByte> &abyRawTileData) const
+{
+    const size_t nSourceSize =
+        m_aoDtypeElts.back().nativeOffset + m_aoDtypeElts.back().nativeSize;
+    const size_t nDTSize = m_oType.GetSize();
+    const size_t nValues = abyDecodedTileData.size() / nDTSize;
+    GByte *pDst = &abyRawTileData[0];
+    const GByte *pSrc = abyDecodedTileData.data();
+    for (size_t i = 0; i < nValues; i++, pDst += nSourceSize, pSrc += nDTSize)
+    {
+        EncodeElt(m_aoDtypeElts, pSrc, pDst);
     }
+}
 
-    if (!m_abyDecodedTileData.empty())
+/************************************************************************/
+/*                       ZarrArray::WriteTile()                         */
+/************************************************************************/
+
+bool ZarrArray::WriteTile(const std::string &osFilename,
+                          std::vector<GByte> &abyRawTileData,
+                          std::vector<GByte> &abyTmpRawTileData) const
+{
+    // This method should NOT modify any ZarrArray member, as it is going to
+    // be called concurrently from several threads.
+
+    // Set those #define to avoid accidental use of some global variables
+#define m_abyTmpRawTileData cannot_use_here
+#define m_abyRawTileData cannot_use_here
+#define m_abyDecodedTileData cannot_use_here
+
+    if ((m_bFortranOrder || m_oFiltersArray.Size() != 0) &&
+        abyTmpRawTileData.size() < m_nTileSize)
     {
-        const size_t nDTSize = m_oType.GetSize();
-        const size_t nValues = m_abyDecodedTileData.size() / nDTSize;
-        GByte *pDst = &m_abyRawTileData[0];
-        const GByte *pSrc = m_abyDecodedTileData.data();
-        for (size_t i = 0; i < nValues;
-             i++, pDst += nSourceSize, pSrc += nDTSize)
+        try
+        {
+            abyTmpRawTileData.resize(m_nTileSize);
+        }
+        catch (const std::bad_alloc &e)
         {
-            EncodeElt(m_aoDtypeElts, pSrc, pDst);
+            CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+            return false;
         }
     }
 
     if (m_bFortranOrder && !m_aoDims.empty())
     {
-        BlockTranspose(m_abyRawTileData, m_abyTmpRawTileData, false);
-        std::swap(m_abyRawTileData, m_abyTmpRawTileData);
+        BlockTranspose(abyRawTileData, abyTmpRawTileData, false);
+        std::swap(abyRawTileData, abyTmpRawTileData);
     }
 
-    size_t nRawDataSize = m_abyRawTileData.size();
+    size_t nRawDataSize = abyRawTileData.size();
     for (const auto &oFilter : m_oFiltersArray)
     {
         const auto osFilterId = oFilter["id"].ToString();
@@ -2327,10 +2322,10 @@ bool ZarrArray::FlushDirtyTile() const
             aosOptions.SetNameValue(obj.GetName().c_str(),
                                     obj.ToString().c_str());
         }
-        void *out_buffer = &m_abyTmpRawTileData[0];
-        size_t nOutSize = m_abyTmpRawTileData.size();
+        void *out_buffer = &abyTmpRawTileData[0];
+        size_t nOutSize = abyTmpRawTileData.size();
         if (!psFilterCompressor->pfnFunc(
-                m_abyRawTileData.data(), nRawDataSize, &out_buffer, &nOutSize,
+                abyRawTileData.data(), nRawDataSize, &out_buffer, &nOutSize,
                 aosOptions.List(), psFilterCompressor->user_data))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -2340,7 +2335,7 @@ bool ZarrArray::FlushDirtyTile() const
         }
 
         nRawDataSize = nOutSize;
-        std::swap(m_abyRawTileData, m_abyTmpRawTileData);
+        std::swap(abyRawTileData, abyTmpRawTileData);
     }
 
     if (m_osDimSeparator == "/")
@@ -2349,7 +2344,9 @@ bool ZarrArray::FlushDirtyTile() const
         VSIStatBufL sStat;
         if (VSIStatL(osDir.c_str(), &sStat) != 0)
         {
-            if (VSIMkdirRecursive(osDir.c_str(), 0755) != 0)
+            // Another thread may have created it in the meantime
+            if (VSIMkdirRecursive(osDir.c_str(), 0755) != 0 &&
+                VSIStatL(osDir.c_str(), &sStat) != 0)
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
                          "Cannot create directory %s", osDir.c_str());
@@ -2369,7 +2366,7 @@ bool ZarrArray::FlushDirtyTile() const
     bool bRet = true;
     if (m_psCompressor == nullptr)
     {
-        if (VSIFWriteL(m_abyRawTileData.data(), 1, nRawDataSize, fp) !=
+        if (VSIFWriteL(abyRawTileData.data(), 1, nRawDataSize, fp) !=
             nRawDataSize)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -2417,7 +2414,7 @@ bool ZarrArray::FlushDirtyTile() const
             }
 
             if (!m_psCompressor->pfnFunc(
-                    m_abyRawTileData.data(), nRawDataSize, &out_buffer,
+                    abyRawTileData.data(), nRawDataSize, &out_buffer,
                     &out_size, aosOptions.List(), m_psCompressor->user_data))
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
@@ -2436,9 +2433,259 @@ bool ZarrArray::FlushDirtyTile() const
             bRet = false;
         }
     }
-    VSIFCloseL(fp);
+    if (VSIFCloseL(fp) != 0 && bRet)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not write tile %s correctly", osFilename.c_str());
+        bRet = false;
+    }
 
     return bRet;
+#undef m_abyTmpRawTileData
+#undef m_abyRawTileData
+#undef m_abyDecodedTileData
+}
+
+/************************************************************************/
+/*                       ZarrArray::DeleteTile()                        */
+/************************************************************************/
+
+bool ZarrArray::DeleteTile(const std::string &osFilename) const
+{
+    VSIStatBufL sStat;
+    if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+    {
+        CPLDebugOnly(ZARR_DEBUG_KEY,
+                     "Deleting tile %s that has now empty content",
+                     osFilename.c_str());
+        return VSIUnlink(osFilename.c_str()) == 0;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                    ZarrArray::FlushDirtyTile()                       */
+/************************************************************************/
+
+bool ZarrArray::FlushDirtyTile() const
+{
+    if (!m_bDirtyTile)
+        return true;
+    m_bDirtyTile = false;
+
+    const std::string osFilename =
+        BuildTileFilename(m_anCachedTiledIndices.data());
+
+    auto &abyTile =
+        m_abyDecodedTileData.empty() ? m_abyRawTileData : m_abyDecodedTileData;
+    const bool bEmptyTile = IsEmptyTile(abyTile);
+    if (bEmptyTile)
+        m_bCachedTiledEmpty = true;
+
+    if (GetTileWriteJobQueue())
+        return SubmitTileWrite(osFilename, bEmptyTile);
+
+    if (bEmptyTile)
+        return DeleteTile(osFilename);
+
+    if (!m_abyDecodedTileData.empty())
+        EncodeTile(m_abyDecodedTileData, m_abyRawTileData);
+
+    return WriteTile(osFilename, m_abyRawTileData, m_abyTmpRawTileData);
+}
+
+/************************************************************************/
+/*                  ZarrArray::GetTileWriteJobQueue()                   */
+/************************************************************************/
+
+// Returns the job queue used to encode and write tiles in worker threads,
+// or nullptr if tiles must be written synchronously.
+CPLJobQueue *ZarrArray::GetTileWriteJobQueue() const
+{
+    if (!m_bTileWriteQueueInitDone)
+    {
+        m_bTileWriteQueueInitDone = true;
+
+        const int nThreads = GDALGetNumThreads(nullptr, true, 1024);
+        if (nThreads > 1)
+        {
+            CPLWorkerThreadPool *wtp = GDALGetGlobalThreadPool(nThreads);
+            if (wtp)
+            {
+                CPLDebug(ZARR_DEBUG_KEY,
+                         "Writing tiles of %s with up to %d threads",
+                         GetFullName().c_str(), nThreads);
+                m_poTileWriteJobQueue = wtp->CreateJobQueue();
+                // Bound the memory used by tiles waiting to be encoded
+                m_nMaxPendingTileWrites = 2 * nThreads;
+            }
+        }
+    }
+    return m_poTileWriteJobQueue.get();
+}
+
+/************************************************************************/
+/*                    ZarrArray::SubmitTileWrite()                      */
+/************************************************************************/
+
+// Queues the encoding and writing of the current dirty tile.
+bool ZarrArray::SubmitTileWrite(const std::string &osFilename,
+                                bool bEmptyTile) const
+{
+    struct JobStruct
+    {
+        const ZarrArray *poArray = nullptr;
+        std::string osFilename{};
+        bool bEmptyTile = false;
+        std::vector<GByte> abyRawTileData{};
+    };
+
+    // Errors of previously submitted tiles are reported, but the current
+    // tile is still queued.
+    bool bPreviousOK = ReportTileWriteError();
+
+    // Two jobs must not write the same tile concurrently
+    if (IsTileWritePending(osFilename))
+    {
+        if (!WaitTileWrites())
+            bPreviousOK = false;
+    }
+
+    std::unique_ptr<JobStruct> poJob(new JobStruct());
+    poJob->poArray = this;
+    poJob->osFilename = osFilename;
+    poJob->bEmptyTile = bEmptyTile;
+    if (!bEmptyTile)
+    {
+        // Take a copy of the tile, in its encoded form, so that the caller
+        // can go on with the next one.
+        try
+        {
+            if (m_abyDecodedTileData.empty())
+            {
+                poJob->abyRawTileData = m_abyRawTileData;
+            }
+            else
+            {
+                poJob->abyRawTileData.resize(m_nTileSize);
+                EncodeTile(m_abyDecodedTileData, poJob->abyRawTileData);
+            }
+        }
+        catch (const std::bad_alloc &e)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+            return false;
+        }
+    }
+
+    const auto JobFunc = [](void *pThreadData)
+    {
+        std::unique_ptr<JobStruct> poJobIn(
+            static_cast<JobStruct *>(pThreadData));
+        const auto poArray = poJobIn->poArray;
+
+        // Errors are emitted again by the thread that reports them
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        CPLErrorReset();
+
+        bool bRet;
+        if (poJobIn->bEmptyTile)
+        {
+            bRet = poArray->DeleteTile(poJobIn->osFilename);
+        }
+        else
+        {
+            std::vector<GByte> abyTmpRawTileData;
+            bRet = poArray->WriteTile(poJobIn->osFilename,
+                                      poJobIn->abyRawTileData,
+                                      abyTmpRawTileData);
+        }
+
+        std::lock_guard<std::mutex> oLock(poArray->m_oMutex);
+        if (!bRet)
+        {
+            // Only keep the first error message
+            if (!poArray->m_bTileWriteError)
+            {
+                poArray->m_osTileWriteErrorMsg =
+                    CPLGetLastErrorType() == CE_None
+                        ? "Cannot write " + poJobIn->osFilename
+                        : std::string(CPLGetLastErrorMsg());
+            }
+            poArray->m_bTileWriteError = true;
+        }
+        poArray->m_oSetPendingTileWrites.erase(poJobIn->osFilename);
+    };
+
+    m_poTileWriteJobQueue->WaitCompletion(m_nMaxPendingTileWrites - 1);
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_oSetPendingTileWrites.insert(osFilename);
+    }
+    if (!m_poTileWriteJobQueue->SubmitJob(JobFunc, poJob.get()))
+    {
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            m_oSetPendingTileWrites.erase(osFilename);
+        }
+        if (bEmptyTile)
+            return DeleteTile(osFilename) && bPreviousOK;
+        std::vector<GByte> abyTmpRawTileData;
+        return WriteTile(osFilename, poJob->abyRawTileData,
+                         abyTmpRawTileData) &&
+               bPreviousOK;
+    }
+    poJob.release();
+    return bPreviousOK;
+}
+
+/************************************************************************/
+/*                   ZarrArray::IsTileWritePending()                    */
+/************************************************************************/
+
+bool ZarrArray::IsTileWritePending(const std::string &osFilename) const
+{
+    if (!m_poTileWriteJobQueue)
+        return false;
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    return m_oSetPendingTileWrites.find(osFilename) !=
+           m_oSetPendingTileWrites.end();
+}
+
+/************************************************************************/
+/*                      ZarrArray::WaitTileWrites()                     */
+/************************************************************************/
+
+// Waits for all queued tiles to be written, and returns whether they all
+// succeeded.
+bool ZarrArray::WaitTileWrites() const
+{
+    if (!m_poTileWriteJobQueue)
+        return true;
+    m_poTileWriteJobQueue->WaitCompletion();
+    return ReportTileWriteError();
+}
+
+/************************************************************************/
+/*                   ZarrArray::ReportTileWriteError()                  */
+/************************************************************************/
+
+// Emits, in the calling thread, the first error that occurred while writing
+// tiles in worker threads since the last call, and returns false in that
+// case.
+bool ZarrArray::ReportTileWriteError() const
+{
+    std::string osErrorMsg;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        if (!m_bTileWriteError)
+            return true;
+        m_bTileWriteError = false;
+        std::swap(osErrorMsg, m_osTileWriteErrorMsg);
+    }
+    CPLError(CE_Failure, CPLE_FileIO, "%s", osErrorMsg.c_str());
+    return false;
 }
 
 /************************************************************************/
@@ -4152,6 +4399,9 @@ bool ZarrArray::CacheTilePresence()
     if (m_nTotalTileCount == 1)
         return true;
 
+    if (!WaitTileWrites())
+        return false;
+
     const std::string osDirectoryName = [this]()
     {
         if (m_nVersion == 2)
@@ -28,6 +28,9 @@
 
 #include "gdal_thread_pool.h"
 
+#include "cpl_string.h"
+
+#include <algorithm>
 #include <mutex>
 
 static std::mutex gMutexThreadPool;
@@ -53,6 +56,35 @@ CPLWorkerThreadPool *GDALGetGlobalThreadPool(int nThreads)
     return gpoCompressThreadPool;
 }
 
+// Returns whether the calling thread is a worker thread of the global thread
+// pool. Code that may run in a job of that pool must not submit jobs to it and
+// wait for them, as this can deadlock once all worker threads are busy.
+bool GDALIsInGlobalThreadPool()
+{
+    std::lock_guard<std::mutex> oGuard(gMutexThreadPool);
+    return gpoCompressThreadPool != nullptr &&
+           gpoCompressThreadPool->IsCurrentThreadWorkerThread();
+}
+
+// Returns the number of threads from the NUM_THREADS item of papszOptions,
+// or if it is not set and bDefaultToGDAL_NUM_THREADS is true, from the
+// GDAL_NUM_THREADS configuration option, or otherwise from pszDefault.
+// The value is an integer or ALL_CPUS, and the result is clamped to
+// [1, nMaxThreads].
+int GDALGetNumThreads(CSLConstList papszOptions,
+                      bool bDefaultToGDAL_NUM_THREADS, int nMaxThreads,
+                      const char *pszDefault)
+{
+    const char *pszThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszThreads == nullptr && bDefaultToGDAL_NUM_THREADS)
+        pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", pszDefault);
+    if (pszThreads == nullptr)
+        pszThreads = pszDefault;
+    const int nThreads =
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads);
+    return std::max(1, std::min(nMaxThreads, nThreads));
+}
+
 void GDALDestroyGlobalThreadPool()
 {
     delete gpoCompressThreadPool;
@@ -35,4 +35,11 @@ CPLWorkerThreadPool CPL_DLL *GDALGetGlobalThreadPool(int nThreads);
 
 void GDALDestroyGlobalThreadPool();
 
+bool CPL_DLL GDALIsInGlobalThreadPool();
+
+int CPL_DLL GDALGetNumThreads(CSLConstList papszOptions,
+                              bool bDefaultToGDAL_NUM_THREADS,
+                              int nMaxThreads = 128,
+                              const char *pszDefault = "1");
+
 #endif  // GDAL_THREAD_POOL_H
@@ -39,8 +39,10 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <type_traits>
 
@@ -53,6 +55,7 @@
 #include "gdal.h"
 #include "gdal_rat.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALRasterBand()                           */
@@ -3262,6 +3265,419 @@ static inline void ComputeFloatNoDataValue(GDALDataType eDataType,
     }
 }
 
+/************************************************************************/
+/*                    GDALStatsGetIntegerNoDataRange()                  */
+/************************************************************************/
+
+// Return the range [nLo, nHi] of the integer values that GetPixelValue()
+// considers equal to dfNoDataValue with ARE_REAL_EQUAL(), which is a fuzzy
+// comparison. Returns false if there is no such value.
+static bool GDALStatsGetIntegerNoDataRange(bool bGotNoDataValue,
+                                           double dfNoDataValue,
+                                           std::int64_t nTypeMin,
+                                           std::int64_t nTypeMax,
+                                           std::int64_t &nLo,
+                                           std::int64_t &nHi)
+{
+    if (!bGotNoDataValue || !std::isfinite(dfNoDataValue) ||
+        dfNoDataValue < static_cast<double>(nTypeMin) - 1 ||
+        dfNoDataValue > static_cast<double>(nTypeMax) + 1)
+        return false;
+    const auto IsNoData = [dfNoDataValue](std::int64_t nVal)
+    { return ARE_REAL_EQUAL(static_cast<double>(nVal), dfNoDataValue); };
+    const std::int64_t nNearest = std::max(
+        nTypeMin,
+        std::min(nTypeMax, static_cast<std::int64_t>(
+                               std::floor(dfNoDataValue + 0.5))));
+    if (!IsNoData(nNearest))
+        return false;
+    // The tolerance of ARE_REAL_EQUAL() is below 1024 for 32-bit values.
+    nLo = nNearest;
+    while (nLo > nTypeMin && IsNoData(nLo - 1))
+        --nLo;
+    nHi = nNearest;
+    while (nHi < nTypeMax && IsNoData(nHi + 1))
+        ++nHi;
+    return true;
+}
+
+/************************************************************************/
+/*                    GDALStatsForEachSampledBlock()                    */
+/************************************************************************/
+
+namespace
+{
+struct GDALStatsBlockJob
+{
+    void *pBlockFunc = nullptr;
+    GDALRasterBlock *poBlock = nullptr;
+    int iSlot = 0;
+    int nXCheck = 0;
+    int nYCheck = 0;
+};
+}  // namespace
+
+template <class BlockFunc> static void GDALStatsBlockJobFunc(void *pData)
+{
+    GDALStatsBlockJob *psJob = static_cast<GDALStatsBlockJob *>(pData);
+    (*static_cast<BlockFunc *>(psJob->pBlockFunc))(
+        psJob->iSlot, psJob->poBlock->GetDataRef(), psJob->nXCheck,
+        psJob->nYCheck);
+    psJob->poBlock->DropLock();
+}
+
+// Visit one block every nSampleRate blocks of poBand.
+// Blocks are fetched by the calling thread, since drivers are not required to
+// be thread-safe, but when GDAL_NUM_THREADS is greater than 1, blockFunc(iSlot,
+// pData, nXCheck, nYCheck) runs on the global thread pool. Blocks are processed
+// by batches: iSlot is the index of the block within its batch, and
+// batchFunc(nSlots) is called by the calling thread once all blocks of a batch
+// are done, so that per-slot results can be reduced in the order of the blocks,
+// which makes the result independent of the number of threads. batchFunc()
+// may return false to stop iterating early.
+template <class BlockFunc, class BatchFunc>
+static CPLErr GDALStatsForEachSampledBlock(GDALRasterBand *poBand,
+                                           int nSampleRate,
+                                           const char *pszProgressMsg,
+                                           GDALProgressFunc pfnProgress,
+                                           void *pProgressData,
+                                           BlockFunc &blockFunc,
+                                           BatchFunc &batchFunc)
+{
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBlocksPerRow = DIV_ROUND_UP(poBand->GetXSize(), nBlockXSize);
+    const int nBlocksPerColumn = DIV_ROUND_UP(poBand->GetYSize(), nBlockYSize);
+    const int nTotalBlocks = nBlocksPerRow * nBlocksPerColumn;
+
+    const int nThreads = GDALGetNumThreads(nullptr, true);
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 && nTotalBlocks / nSampleRate > 1
+            ? GDALGetGlobalThreadPool(nThreads)
+            : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    const int nBatchSize = poJobQueue ? 4 * nThreads : 1;
+    std::vector<GDALStatsBlockJob> asJobs(nBatchSize);
+
+    CPLErr eErr = CE_None;
+    for (int iSampleBlock = 0; iSampleBlock < nTotalBlocks && eErr == CE_None;)
+    {
+        int nSlots = 0;
+        for (; nSlots < nBatchSize && iSampleBlock < nTotalBlocks;
+             ++nSlots, iSampleBlock += nSampleRate)
+        {
+            const int iYBlock = iSampleBlock / nBlocksPerRow;
+            const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
+
+            GDALRasterBlock *const poBlock =
+                poBand->GetLockedBlockRef(iXBlock, iYBlock);
+            if (poBlock == nullptr)
+            {
+                eErr = CE_Failure;
+                break;
+            }
+
+            GDALStatsBlockJob &sJob = asJobs[nSlots];
+            sJob.pBlockFunc = &blockFunc;
+            sJob.poBlock = poBlock;
+            sJob.iSlot = nSlots;
+            poBand->GetActualBlockSize(iXBlock, iYBlock, &sJob.nXCheck,
+                                       &sJob.nYCheck);
+            if (poJobQueue)
+                poJobQueue->SubmitJob(GDALStatsBlockJobFunc<BlockFunc>, &sJob);
+            else
+                GDALStatsBlockJobFunc<BlockFunc>(&sJob);
+
+            if (!pfnProgress(iSampleBlock / static_cast<double>(nTotalBlocks),
+                             pszProgressMsg, pProgressData))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                eErr = CE_Failure;
+                break;
+            }
+        }
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+        if (eErr == CE_None && !batchFunc(nSlots))
+            break;
+    }
+    return eErr;
+}
+
+/************************************************************************/
+/*                          GDALStatsNoData                             */
+/************************************************************************/
+
+namespace
+{
+// Nodata test of GetPixelValue(), specialized by data type.
+struct GDALStatsNoData
+{
+    bool bHasNoData = false;
+    float fNoDataValue = 0;    // GDT_Float32
+    double dfNoDataValue = 0;  // GDT_Float64
+    // Integer types: range of values considered as nodata.
+    std::int64_t nLo = 0;
+    std::int64_t nHi = 0;
+};
+}  // namespace
+
+static GDALStatsNoData GDALStatsGetNoData(GDALDataType eDataType,
+                                          bool bGotNoDataValue,
+                                          double dfNoDataValue,
+                                          bool bGotFloatNoDataValue,
+                                          float fNoDataValue)
+{
+    GDALStatsNoData sNoData;
+    switch (eDataType)
+    {
+        case GDT_Float32:
+            sNoData.bHasNoData = bGotFloatNoDataValue;
+            sNoData.fNoDataValue = fNoDataValue;
+            break;
+        case GDT_Float64:
+            sNoData.bHasNoData = bGotNoDataValue;
+            sNoData.dfNoDataValue = dfNoDataValue;
+            break;
+        case GDT_Byte:
+            sNoData.bHasNoData = GDALStatsGetIntegerNoDataRange(
+                bGotNoDataValue, dfNoDataValue, 0, 255, sNoData.nLo,
+                sNoData.nHi);
+            break;
+        case GDT_UInt16:
+            sNoData.bHasNoData = GDALStatsGetIntegerNoDataRange(
+                bGotNoDataValue, dfNoDataValue, 0, 65535, sNoData.nLo,
+                sNoData.nHi);
+            break;
+        case GDT_Int16:
+            sNoData.bHasNoData = GDALStatsGetIntegerNoDataRange(
+                bGotNoDataValue, dfNoDataValue, -32768, 32767, sNoData.nLo,
+                sNoData.nHi);
+            break;
+        case GDT_Int32:
+            sNoData.bHasNoData = GDALStatsGetIntegerNoDataRange(
+                bGotNoDataValue, dfNoDataValue,
+                std::numeric_limits<GInt32>::min(),
+                std::numeric_limits<GInt32>::max(), sNoData.nLo, sNoData.nHi);
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+    return sNoData;
+}
+
+static inline bool GDALStatsIsValid(float fValue,
+                                    const GDALStatsNoData &sNoData)
+{
+    return !CPLIsNan(fValue) &&
+           !(sNoData.bHasNoData &&
+             ARE_REAL_EQUAL(fValue, sNoData.fNoDataValue));
+}
+
+static inline bool GDALStatsIsValid(double dfValue,
+                                    const GDALStatsNoData &sNoData)
+{
+    return !CPLIsNan(dfValue) &&
+           !(sNoData.bHasNoData &&
+             ARE_REAL_EQUAL(dfValue, sNoData.dfNoDataValue));
+}
+
+static inline bool GDALStatsIsValid(GInt32 nValue,
+                                    const GDALStatsNoData &sNoData)
+{
+    return !(sNoData.bHasNoData && nValue >= sNoData.nLo &&
+             nValue <= sNoData.nHi);
+}
+
+/************************************************************************/
+/*                      GDALHistogramComputeBlocks()                    */
+/************************************************************************/
+
+// Histogram buckets have an extra bucket, at index nBuckets, that collects
+// discarded values, so that the inner loops are branch-free.
+
+// For 8 and 16 bit types, use a lookup table from value to bucket.
+template <class T>
+static std::vector<int>
+GDALHistogramBuildLUT(const GDALStatsNoData &sNoData, double dfMin,
+                      double dfScale, int nBuckets, bool bIncludeOutOfRange)
+{
+    constexpr int nTypeMin = std::numeric_limits<T>::min();
+    constexpr int nTypeMax = std::numeric_limits<T>::max();
+    std::vector<int> anLUT(nTypeMax - nTypeMin + 1);
+    for (int i = nTypeMin; i <= nTypeMax; ++i)
+    {
+        int &nBucket = anLUT[i - nTypeMin];
+        if (sNoData.bHasNoData && i >= sNoData.nLo && i <= sNoData.nHi)
+        {
+            nBucket = nBuckets;
+            continue;
+        }
+        // Same computation as in GetHistogram()
+        const double dfIndex = floor((i - dfMin) * dfScale);
+        if (dfIndex < 0)
+            nBucket = bIncludeOutOfRange ? 0 : nBuckets;
+        else if (dfIndex >= nBuckets)
+            nBucket = bIncludeOutOfRange ? nBuckets - 1 : nBuckets;
+        else
+            nBucket = static_cast<int>(dfIndex);
+    }
+    return anLUT;
+}
+
+template <class T>
+static void GDALHistogramAddBlockLUT(const T *pData, int nXCheck,
+                                     int nBlockXSize, int nYCheck,
+                                     const int *panLUT,
+                                     GUIntBig *panHistogram)
+{
+    constexpr int nTypeMin = std::numeric_limits<T>::min();
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const T *pLine = pData + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+        for (int iX = 0; iX < nXCheck; iX++)
+            ++panHistogram[panLUT[static_cast<int>(pLine[iX]) - nTypeMin]];
+    }
+}
+
+template <class T>
+static void GDALHistogramAddBlock(const T *pData, int nXCheck, int nBlockXSize,
+                                  int nYCheck, const GDALStatsNoData &sNoData,
+                                  double dfMin, double dfScale, int nBuckets,
+                                  bool bIncludeOutOfRange,
+                                  GUIntBig *panHistogram)
+{
+    const int nBucketBelow = bIncludeOutOfRange ? 0 : nBuckets;
+    const int nBucketAbove = bIncludeOutOfRange ? nBuckets - 1 : nBuckets;
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const T *pLine = pData + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+        for (int iX = 0; iX < nXCheck; iX++)
+        {
+            const T value = pLine[iX];
+            if (!GDALStatsIsValid(value, sNoData))
+                continue;
+            // Same computation as in GetHistogram()
+            const double dfIndex =
+                floor((static_cast<double>(value) - dfMin) * dfScale);
+            if (dfIndex < 0)
+                ++panHistogram[nBucketBelow];
+            else if (dfIndex >= nBuckets)
+                ++panHistogram[nBucketAbove];
+            else
+                ++panHistogram[static_cast<int>(dfIndex)];
+        }
+    }
+}
+
+// Compute the histogram of the sampled blocks, for Byte (unsigned), UInt16,
+// Int16, Int32, Float32 and Float64. Each thread accumulates in its own
+// histogram, and they are summed at the end.
+static CPLErr GDALHistogramComputeBlocks(
+    GDALRasterBand *poBand, int nSampleRate, const GDALStatsNoData &sNoData,
+    double dfMin, double dfScale, int nBuckets, GUIntBig *panHistogram,
+    bool bIncludeOutOfRange, GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    const GDALDataType eDataType = poBand->GetRasterDataType();
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+
+    std::vector<int> anLUT;
+    if (eDataType == GDT_Byte)
+        anLUT = GDALHistogramBuildLUT<GByte>(sNoData, dfMin, dfScale, nBuckets,
+                                             bIncludeOutOfRange);
+    else if (eDataType == GDT_UInt16)
+        anLUT = GDALHistogramBuildLUT<GUInt16>(sNoData, dfMin, dfScale,
+                                               nBuckets, bIncludeOutOfRange);
+    else if (eDataType == GDT_Int16)
+        anLUT = GDALHistogramBuildLUT<GInt16>(sNoData, dfMin, dfScale,
+                                              nBuckets, bIncludeOutOfRange);
+
+    std::mutex oMutex;
+    std::vector<std::vector<GUIntBig>> aanHistograms;
+    std::vector<size_t> anFreeHistograms;
+
+    auto blockFunc = [&](int /* iSlot */, const void *pData, int nXCheck,
+                         int nYCheck)
+    {
+        size_t iHistogram;
+        GUIntBig *panHist;
+        {
+            std::lock_guard<std::mutex> oLock(oMutex);
+            if (anFreeHistograms.empty())
+            {
+                aanHistograms.emplace_back(static_cast<size_t>(nBuckets) + 1);
+                iHistogram = aanHistograms.size() - 1;
+            }
+            else
+            {
+                iHistogram = anFreeHistograms.back();
+                anFreeHistograms.pop_back();
+            }
+            panHist = aanHistograms[iHistogram].data();
+        }
+
+        switch (eDataType)
+        {
+            case GDT_Byte:
+                GDALHistogramAddBlockLUT(static_cast<const GByte *>(pData),
+                                         nXCheck, nBlockXSize, nYCheck,
+                                         anLUT.data(), panHist);
+                break;
+            case GDT_UInt16:
+                GDALHistogramAddBlockLUT(static_cast<const GUInt16 *>(pData),
+                                         nXCheck, nBlockXSize, nYCheck,
+                                         anLUT.data(), panHist);
+                break;
+            case GDT_Int16:
+                GDALHistogramAddBlockLUT(static_cast<const GInt16 *>(pData),
+                                         nXCheck, nBlockXSize, nYCheck,
+                                         anLUT.data(), panHist);
+                break;
+            case GDT_Int32:
+                GDALHistogramAddBlock(static_cast<const GInt32 *>(pData),
+                                      nXCheck, nBlockXSize, nYCheck, sNoData,
+                                      dfMin, dfScale, nBuckets,
+                                      bIncludeOutOfRange, panHist);
+                break;
+            case GDT_Float32:
+                GDALHistogramAddBlock(static_cast<const float *>(pData),
+                                      nXCheck, nBlockXSize, nYCheck, sNoData,
+                                      dfMin, dfScale, nBuckets,
+                                      bIncludeOutOfRange, panHist);
+                break;
+            case GDT_Float64:
+                GDALHistogramAddBlock(static_cast<const double *>(pData),
+                                      nXCheck, nBlockXSize, nYCheck, sNoData,
+                                      dfMin, dfScale, nBuckets,
+                                      bIncludeOutOfRange, panHist);
+                break;
+            default:
+                CPLAssert(false);
+                break;
+        }
+
+        std::lock_guard<std::mutex> oLock(oMutex);
+        anFreeHistograms.push_back(iHistogram);
+    };
+    auto batchFunc = [](int /* nSlots */) { return true; };
+
+    const CPLErr eErr = GDALStatsForEachSampledBlock(
+        poBand, nSampleRate, "Compute Histogram", pfnProgress, pProgressData,
+        blockFunc, batchFunc);
+
+    for (const auto &anHistogram : aanHistograms)
+    {
+        for (int i = 0; i < nBuckets; ++i)
+            panHistogram[i] += anHistogram[i];
+    }
+    return eErr;
+}
+
 /************************************************************************/
 /*                            GetHistogram()                            */
 /************************************************************************/
@@ -3288,6 +3704,10 @@ static inline void ComputeFloatNoDataValue(GDALDataType eDataType,
  * in generating histogram based luts for instance.  Generally bApproxOK is
  * much faster than an exactly computed histogram.
  *
+ * Starting with GDAL 3.8, blocks are processed by several threads when the
+ * GDAL_NUM_THREADS configuration option is set to a value greater than 1 or
+ * ALL_CPUS.
+ *
  * This method is the same as the C functions GDALGetRasterHistogram() and
  * GDALGetRasterHistogramEx().
  *
@@ -3586,6 +4006,24 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                 nSampleRate += 1;
         }
 
+        if ((eDataType == GDT_Byte && !bSignedByte) ||
+            eDataType == GDT_UInt16 || eDataType == GDT_Int16 ||
+            eDataType == GDT_Int32 || eDataType == GDT_Float32 ||
+            eDataType == GDT_Float64)
+        {
+            const GDALStatsNoData sNoData = GDALStatsGetNoData(
+                eDataType, CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
+                bGotFloatNoDataValue, fNoDataValue);
+            if (GDALHistogramComputeBlocks(
+                    this, nSampleRate, sNoData, dfMin, dfScale, nBuckets,
+                    panHistogram, CPL_TO_BOOL(bIncludeOutOfRange), pfnProgress,
+                    pProgressData) != CE_None)
+                return CE_Failure;
+
+            pfnProgress(1.0, "Compute Histogram", pProgressData);
+            return CE_None;
+        }
+
         /* --------------------------------------------------------------------
          */
         /*      Read the blocks, and add to histogram. */
@@ -5307,6 +5745,543 @@ struct ComputeStatisticsInternal<GUInt16, COMPUTE_OTHER_STATS>
 
 #endif  // CPL_HAS_GINT64
 
+/************************************************************************/
+/*                        GDALStatsAccumulator                          */
+/************************************************************************/
+
+namespace
+{
+// Statistics of the values of a block, or of several blocks, for the data
+// types whose statistics are accumulated in floating-point. Results of blocks
+// are combined with the pairwise update of the mean and of the sum of squared
+// differences to the mean (M2) of Chan et al.
+struct GDALStatsAccumulator
+{
+    double dfMin = std::numeric_limits<double>::max();
+    double dfMax = -std::numeric_limits<double>::max();
+    double dfMean = 0;
+    double dfM2 = 0;
+    GUIntBig nValidCount = 0;
+    GUIntBig nSampleCount = 0;
+
+    void Merge(const GDALStatsAccumulator &other)
+    {
+        nSampleCount += other.nSampleCount;
+        if (other.nValidCount == 0)
+            return;
+        dfMin = std::min(dfMin, other.dfMin);
+        dfMax = std::max(dfMax, other.dfMax);
+        if (nValidCount == 0)
+        {
+            dfMean = other.dfMean;
+            dfM2 = other.dfM2;
+            nValidCount = other.nValidCount;
+            return;
+        }
+        const GUIntBig nNewValidCount = nValidCount + other.nValidCount;
+        const double dfDelta = other.dfMean - dfMean;
+        const double dfOtherRatio =
+            static_cast<double>(other.nValidCount) / nNewValidCount;
+        dfMean += dfDelta * dfOtherRatio;
+        dfM2 += other.dfM2 +
+                dfDelta * dfDelta * static_cast<double>(nValidCount) *
+                    dfOtherRatio;
+        nValidCount = nNewValidCount;
+    }
+};
+
+template <class T> struct GDALStatsSumType
+{
+    typedef double type;
+};
+
+// Exact sum for 32-bit integers.
+template <> struct GDALStatsSumType<GInt32>
+{
+    typedef std::int64_t type;
+};
+}  // namespace
+
+/************************************************************************/
+/*                         GDALStatsKernel<T>                           */
+/************************************************************************/
+
+// Pass1() accumulates the minimum, maximum, sum and number of valid values of
+// a line, and Pass2() the sum of squared differences to the mean. They process
+// the beginning of the line with SIMD instructions when available, and return
+// the number of values processed, the rest being done by the caller.
+template <class T> struct GDALStatsKernel
+{
+    template <bool COMPUTE_OTHER_STATS>
+    static int Pass1(const T *, int, const GDALStatsNoData &, T &, T &,
+                     typename GDALStatsSumType<T>::type &, GUIntBig &)
+    {
+        return 0;
+    }
+
+    static int Pass2(const T *, int, const GDALStatsNoData &, double, double &)
+    {
+        return 0;
+    }
+};
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <emmintrin.h>
+
+static inline __m128 GDALStatsBlendPS(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128d GDALStatsBlendPD(__m128d mask, __m128d a, __m128d b)
+{
+    return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+
+static inline __m128i GDALStatsBlendEPI32(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// Same test as GDALStatsIsValid(), i.e. !CPLIsNan(v) && !ARE_REAL_EQUAL(v, nd)
+static inline __m128 GDALStatsValidMaskPS(__m128 v, bool bHasNoData,
+                                          __m128 vNoData)
+{
+    __m128 vValid = _mm_cmpord_ps(v, v);
+    if (bHasNoData)
+    {
+        const __m128 vAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        const __m128 vDiff = _mm_and_ps(_mm_sub_ps(v, vNoData), vAbsMask);
+        const __m128 vTolerance = _mm_mul_ps(
+            _mm_mul_ps(_mm_set1_ps(std::numeric_limits<float>::epsilon()),
+                       _mm_and_ps(_mm_add_ps(v, vNoData), vAbsMask)),
+            _mm_set1_ps(2.0f));
+        vValid = _mm_andnot_ps(_mm_or_ps(_mm_cmpeq_ps(v, vNoData),
+                                         _mm_cmplt_ps(vDiff, vTolerance)),
+                               vValid);
+    }
+    return vValid;
+}
+
+static inline __m128d GDALStatsValidMaskPD(__m128d v, bool bHasNoData,
+                                           __m128d vNoData)
+{
+    __m128d vValid = _mm_cmpord_pd(v, v);
+    if (bHasNoData)
+    {
+        const __m128d vAbsMask =
+            _mm_castsi128_pd(_mm_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+        const __m128d vDiff = _mm_and_pd(_mm_sub_pd(v, vNoData), vAbsMask);
+        const __m128d vTolerance = _mm_mul_pd(
+            _mm_mul_pd(_mm_set1_pd(static_cast<double>(
+                           std::numeric_limits<float>::epsilon())),
+                       _mm_and_pd(_mm_add_pd(v, vNoData), vAbsMask)),
+            _mm_set1_pd(2.0));
+        vValid = _mm_andnot_pd(_mm_or_pd(_mm_cmpeq_pd(v, vNoData),
+                                         _mm_cmplt_pd(vDiff, vTolerance)),
+                               vValid);
+    }
+    return vValid;
+}
+
+static inline __m128i GDALStatsValidMaskEPI32(__m128i v, bool bHasNoData,
+                                              __m128i vNoDataLo,
+                                              __m128i vNoDataHi)
+{
+    if (!bHasNoData)
+        return _mm_set1_epi32(-1);
+    return _mm_or_si128(_mm_cmplt_epi32(v, vNoDataLo),
+                        _mm_cmpgt_epi32(v, vNoDataHi));
+}
+
+static inline GUIntBig GDALStatsHorizontalSumEPI32(__m128i v)
+{
+    GInt32 anCount[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(anCount), v);
+    return static_cast<GUIntBig>(anCount[0]) + anCount[1] + anCount[2] +
+           anCount[3];
+}
+
+static inline double GDALStatsHorizontalSumPD(__m128d v)
+{
+    double adf[2];
+    _mm_storeu_pd(adf, v);
+    return adf[0] + adf[1];
+}
+
+template <> struct GDALStatsKernel<float>
+{
+    template <bool COMPUTE_OTHER_STATS>
+    static int Pass1(const float *pafLine, int nCount,
+                     const GDALStatsNoData &sNoData, float &fMin, float &fMax,
+                     double &dfSum, GUIntBig &nValidCount)
+    {
+        const int nVecCount = nCount & ~3;
+        if (nVecCount == 0)
+            return 0;
+        const __m128 vNoData = _mm_set1_ps(sNoData.fNoDataValue);
+        const __m128 vPosInf =
+            _mm_set1_ps(std::numeric_limits<float>::infinity());
+        const __m128 vNegInf =
+            _mm_set1_ps(-std::numeric_limits<float>::infinity());
+        __m128 vMin = vPosInf;
+        __m128 vMax = vNegInf;
+        __m128d vSumLow = _mm_setzero_pd();
+        __m128d vSumHigh = _mm_setzero_pd();
+        __m128i vCount = _mm_setzero_si128();
+        for (int i = 0; i < nVecCount; i += 4)
+        {
+            const __m128 v = _mm_loadu_ps(pafLine + i);
+            const __m128 vValid =
+                GDALStatsValidMaskPS(v, sNoData.bHasNoData, vNoData);
+            vMin = _mm_min_ps(vMin, GDALStatsBlendPS(vValid, v, vPosInf));
+            vMax = _mm_max_ps(vMax, GDALStatsBlendPS(vValid, v, vNegInf));
+            vCount = _mm_sub_epi32(vCount, _mm_castps_si128(vValid));
+            if (COMPUTE_OTHER_STATS)
+            {
+                const __m128 vMasked = _mm_and_ps(vValid, v);
+                vSumLow = _mm_add_pd(vSumLow, _mm_cvtps_pd(vMasked));
+                vSumHigh = _mm_add_pd(
+                    vSumHigh, _mm_cvtps_pd(_mm_movehl_ps(vMasked, vMasked)));
+            }
+        }
+        float afMin[4];
+        float afMax[4];
+        _mm_storeu_ps(afMin, vMin);
+        _mm_storeu_ps(afMax, vMax);
+        for (int i = 0; i < 4; ++i)
+        {
+            fMin = std::min(fMin, afMin[i]);
+            fMax = std::max(fMax, afMax[i]);
+        }
+        nValidCount += GDALStatsHorizontalSumEPI32(vCount);
+        if (COMPUTE_OTHER_STATS)
+            dfSum += GDALStatsHorizontalSumPD(_mm_add_pd(vSumLow, vSumHigh));
+        return nVecCount;
+    }
+
+    static int Pass2(const float *pafLine, int nCount,
+                     const GDALStatsNoData &sNoData, double dfMean,
+                     double &dfM2)
+    {
+        const int nVecCount = nCount & ~3;
+        if (nVecCount == 0)
+            return 0;
+        const __m128 vNoData = _mm_set1_ps(sNoData.fNoDataValue);
+        const __m128d vMean = _mm_set1_pd(dfMean);
+        __m128d vM2 = _mm_setzero_pd();
+        for (int i = 0; i < nVecCount; i += 4)
+        {
+            const __m128 v = _mm_loadu_ps(pafLine + i);
+            const __m128i vValid = _mm_castps_si128(
+                GDALStatsValidMaskPS(v, sNoData.bHasNoData, vNoData));
+            const __m128d vDeltaLow = _mm_sub_pd(_mm_cvtps_pd(v), vMean);
+            const __m128d vDeltaHigh =
+                _mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), vMean);
+            vM2 = _mm_add_pd(
+                vM2, _mm_and_pd(
+                         _mm_castsi128_pd(_mm_unpacklo_epi32(vValid, vValid)),
+                         _mm_mul_pd(vDeltaLow, vDeltaLow)));
+            vM2 = _mm_add_pd(
+                vM2, _mm_and_pd(
+                         _mm_castsi128_pd(_mm_unpackhi_epi32(vValid, vValid)),
+                         _mm_mul_pd(vDeltaHigh, vDeltaHigh)));
+        }
+        dfM2 += GDALStatsHorizontalSumPD(vM2);
+        return nVecCount;
+    }
+};
+
+template <> struct GDALStatsKernel<double>
+{
+    template <bool COMPUTE_OTHER_STATS>
+    static int Pass1(const double *padfLine, int nCount,
+                     const GDALStatsNoData &sNoData, double &dfMin,
+                     double &dfMax, double &dfSum, GUIntBig &nValidCount)
+    {
+        const int nVecCount = nCount & ~1;
+        if (nVecCount == 0)
+            return 0;
+        const __m128d vNoData = _mm_set1_pd(sNoData.dfNoDataValue);
+        const __m128d vPosInf =
+            _mm_set1_pd(std::numeric_limits<double>::infinity());
+        const __m128d vNegInf =
+            _mm_set1_pd(-std::numeric_limits<double>::infinity());
+        __m128d vMin = vPosInf;
+        __m128d vMax = vNegInf;
+        __m128d vSum = _mm_setzero_pd();
+        __m128i vCount = _mm_setzero_si128();
+        for (int i = 0; i < nVecCount; i += 2)
+        {
+            const __m128d v = _mm_loadu_pd(padfLine + i);
+            const __m128d vValid =
+                GDALStatsValidMaskPD(v, sNoData.bHasNoData, vNoData);
+            vMin = _mm_min_pd(vMin, GDALStatsBlendPD(vValid, v, vPosInf));
+            vMax = _mm_max_pd(vMax, GDALStatsBlendPD(vValid, v, vNegInf));
+            vCount = _mm_sub_epi64(vCount, _mm_castpd_si128(vValid));
+            if (COMPUTE_OTHER_STATS)
+                vSum = _mm_add_pd(vSum, _mm_and_pd(vValid, v));
+        }
+        double adfMin[2];
+        double adfMax[2];
+        _mm_storeu_pd(adfMin, vMin);
+        _mm_storeu_pd(adfMax, vMax);
+        dfMin = std::min(dfMin, std::min(adfMin[0], adfMin[1]));
+        dfMax = std::max(dfMax, std::max(adfMax[0], adfMax[1]));
+        GUIntBig anCount[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(anCount), vCount);
+        nValidCount += anCount[0] + anCount[1];
+        if (COMPUTE_OTHER_STATS)
+            dfSum += GDALStatsHorizontalSumPD(vSum);
+        return nVecCount;
+    }
+
+    static int Pass2(const double *padfLine, int nCount,
+                     const GDALStatsNoData &sNoData, double dfMean,
+                     double &dfM2)
+    {
+        const int nVecCount = nCount & ~1;
+        if (nVecCount == 0)
+            return 0;
+        const __m128d vNoData = _mm_set1_pd(sNoData.dfNoDataValue);
+        const __m128d vMean = _mm_set1_pd(dfMean);
+        __m128d vM2 = _mm_setzero_pd();
+        for (int i = 0; i < nVecCount; i += 2)
+        {
+            const __m128d v = _mm_loadu_pd(padfLine + i);
+            const __m128d vValid =
+                GDALStatsValidMaskPD(v, sNoData.bHasNoData, vNoData);
+            const __m128d vDelta = _mm_sub_pd(v, vMean);
+            vM2 = _mm_add_pd(vM2,
+                             _mm_and_pd(vValid, _mm_mul_pd(vDelta, vDelta)));
+        }
+        dfM2 += GDALStatsHorizontalSumPD(vM2);
+        return nVecCount;
+    }
+};
+
+template <> struct GDALStatsKernel<GInt32>
+{
+    template <bool COMPUTE_OTHER_STATS>
+    static int Pass1(const GInt32 *panLine, int nCount,
+                     const GDALStatsNoData &sNoData, GInt32 &nMin,
+                     GInt32 &nMax, std::int64_t &nSum, GUIntBig &nValidCount)
+    {
+        const int nVecCount = nCount & ~3;
+        if (nVecCount == 0)
+            return 0;
+        const __m128i vNoDataLo =
+            _mm_set1_epi32(static_cast<GInt32>(sNoData.nLo));
+        const __m128i vNoDataHi =
+            _mm_set1_epi32(static_cast<GInt32>(sNoData.nHi));
+        const __m128i vInt32Max =
+            _mm_set1_epi32(std::numeric_limits<GInt32>::max());
+        const __m128i vInt32Min =
+            _mm_set1_epi32(std::numeric_limits<GInt32>::min());
+        const __m128i vZero = _mm_setzero_si128();
+        __m128i vMin = vInt32Max;
+        __m128i vMax = vInt32Min;
+        __m128i vSum = _mm_setzero_si128();
+        __m128i vCount = _mm_setzero_si128();
+        for (int i = 0; i < nVecCount; i += 4)
+        {
+            const __m128i v =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(panLine + i));
+            const __m128i vValid = GDALStatsValidMaskEPI32(
+                v, sNoData.bHasNoData, vNoDataLo, vNoDataHi);
+            // No _mm_min_epi32() / _mm_max_epi32() in SSE2
+            const __m128i vForMin = GDALStatsBlendEPI32(vValid, v, vInt32Max);
+            vMin = GDALStatsBlendEPI32(_mm_cmplt_epi32(vForMin, vMin), vForMin,
+                                       vMin);
+            const __m128i vForMax = GDALStatsBlendEPI32(vValid, v, vInt32Min);
+            vMax = GDALStatsBlendEPI32(_mm_cmpgt_epi32(vForMax, vMax), vForMax,
+                                       vMax);
+            vCount = _mm_sub_epi32(vCount, vValid);
+            if (COMPUTE_OTHER_STATS)
+            {
+                // Sign-extend to 64 bit
+                const __m128i vMasked = _mm_and_si128(vValid, v);
+                const __m128i vSign = _mm_cmplt_epi32(vMasked, vZero);
+                vSum = _mm_add_epi64(vSum, _mm_unpacklo_epi32(vMasked, vSign));
+                vSum = _mm_add_epi64(vSum, _mm_unpackhi_epi32(vMasked, vSign));
+            }
+        }
+        GInt32 anMin[4];
+        GInt32 anMax[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(anMin), vMin);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(anMax), vMax);
+        for (int i = 0; i < 4; ++i)
+        {
+            nMin = std::min(nMin, anMin[i]);
+            nMax = std::max(nMax, anMax[i]);
+        }
+        nValidCount += GDALStatsHorizontalSumEPI32(vCount);
+        if (COMPUTE_OTHER_STATS)
+        {
+            std::int64_t anSum[2];
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(anSum), vSum);
+            nSum += anSum[0] + anSum[1];
+        }
+        return nVecCount;
+    }
+
+    static int Pass2(const GInt32 *panLine, int nCount,
+                     const GDALStatsNoData &sNoData, double dfMean,
+                     double &dfM2)
+    {
+        const int nVecCount = nCount & ~3;
+        if (nVecCount == 0)
+            return 0;
+        const __m128i vNoDataLo =
+            _mm_set1_epi32(static_cast<GInt32>(sNoData.nLo));
+        const __m128i vNoDataHi =
+            _mm_set1_epi32(static_cast<GInt32>(sNoData.nHi));
+        const __m128d vMean = _mm_set1_pd(dfMean);
+        __m128d vM2 = _mm_setzero_pd();
+        for (int i = 0; i < nVecCount; i += 4)
+        {
+            const __m128i v =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(panLine + i));
+            const __m128i vValid = GDALStatsValidMaskEPI32(
+                v, sNoData.bHasNoData, vNoDataLo, vNoDataHi);
+            const __m128d vDeltaLow = _mm_sub_pd(_mm_cvtepi32_pd(v), vMean);
+            const __m128d vDeltaHigh = _mm_sub_pd(
+                _mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(3, 2, 3, 2))),
+                vMean);
+            vM2 = _mm_add_pd(
+                vM2, _mm_and_pd(
+                         _mm_castsi128_pd(_mm_unpacklo_epi32(vValid, vValid)),
+                         _mm_mul_pd(vDeltaLow, vDeltaLow)));
+            vM2 = _mm_add_pd(
+                vM2, _mm_and_pd(
+                         _mm_castsi128_pd(_mm_unpackhi_epi32(vValid, vValid)),
+                         _mm_mul_pd(vDeltaHigh, vDeltaHigh)));
+        }
+        dfM2 += GDALStatsHorizontalSumPD(vM2);
+        return nVecCount;
+    }
+};
+
+#endif  // defined(__x86_64__) || defined(_M_X64)
+
+/************************************************************************/
+/*                       GDALStatsComputeBlock()                        */
+/************************************************************************/
+
+// Statistics of a block of Int32, Float32 or Float64 values. The mean is
+// computed first, and then M2 with a second pass over the block, which is
+// still in the CPU cache.
+template <class T, bool COMPUTE_OTHER_STATS>
+static void GDALStatsComputeBlock(const T *pData, int nXCheck, int nBlockXSize,
+                                  int nYCheck, const GDALStatsNoData &sNoData,
+                                  GDALStatsAccumulator &sAcc)
+{
+    typedef typename GDALStatsSumType<T>::type SumType;
+    T tMin = std::numeric_limits<T>::has_infinity
+                 ? std::numeric_limits<T>::infinity()
+                 : std::numeric_limits<T>::max();
+    T tMax = std::numeric_limits<T>::has_infinity
+                 ? -std::numeric_limits<T>::infinity()
+                 : std::numeric_limits<T>::lowest();
+    SumType sum = 0;
+    GUIntBig nValidCount = 0;
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const T *pLine = pData + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+        int iX = GDALStatsKernel<T>::template Pass1<COMPUTE_OTHER_STATS>(
+            pLine, nXCheck, sNoData, tMin, tMax, sum, nValidCount);
+        for (; iX < nXCheck; iX++)
+        {
+            const T value = pLine[iX];
+            if (!GDALStatsIsValid(value, sNoData))
+                continue;
+            tMin = std::min(tMin, value);
+            tMax = std::max(tMax, value);
+            if (COMPUTE_OTHER_STATS)
+                sum += value;
+            nValidCount++;
+        }
+    }
+
+    sAcc = GDALStatsAccumulator();
+    sAcc.nSampleCount = static_cast<GUIntBig>(nXCheck) * nYCheck;
+    sAcc.nValidCount = nValidCount;
+    if (nValidCount == 0)
+        return;
+    sAcc.dfMin = static_cast<double>(tMin);
+    sAcc.dfMax = static_cast<double>(tMax);
+    if (!COMPUTE_OTHER_STATS)
+        return;
+
+    const double dfMean = static_cast<double>(sum) / nValidCount;
+    double dfM2 = 0;
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const T *pLine = pData + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+        int iX =
+            GDALStatsKernel<T>::Pass2(pLine, nXCheck, sNoData, dfMean, dfM2);
+        for (; iX < nXCheck; iX++)
+        {
+            const T value = pLine[iX];
+            if (!GDALStatsIsValid(value, sNoData))
+                continue;
+            const double dfDelta = static_cast<double>(value) - dfMean;
+            dfM2 += dfDelta * dfDelta;
+        }
+    }
+    sAcc.dfMean = dfMean;
+    sAcc.dfM2 = dfM2;
+}
+
+/************************************************************************/
+/*                       GDALStatsComputeBlocks()                       */
+/************************************************************************/
+
+// Statistics of the sampled blocks of a Int32, Float32 or Float64 band.
+template <bool COMPUTE_OTHER_STATS>
+static CPLErr GDALStatsComputeBlocks(GDALRasterBand *poBand, int nSampleRate,
+                                     const GDALStatsNoData &sNoData,
+                                     GDALStatsAccumulator &sAcc,
+                                     const char *pszProgressMsg,
+                                     GDALProgressFunc pfnProgress,
+                                     void *pProgressData)
+{
+    const GDALDataType eDataType = poBand->GetRasterDataType();
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+
+    std::vector<GDALStatsAccumulator> asSlots(
+        static_cast<size_t>(4) * GDALGetNumThreads(nullptr, true));
+    auto blockFunc = [eDataType, nBlockXSize, &sNoData,
+                      &asSlots](int iSlot, const void *pData, int nXCheck,
+                                int nYCheck)
+    {
+        if (eDataType == GDT_Int32)
+            GDALStatsComputeBlock<GInt32, COMPUTE_OTHER_STATS>(
+                static_cast<const GInt32 *>(pData), nXCheck, nBlockXSize,
+                nYCheck, sNoData, asSlots[iSlot]);
+        else if (eDataType == GDT_Float32)
+            GDALStatsComputeBlock<float, COMPUTE_OTHER_STATS>(
+                static_cast<const float *>(pData), nXCheck, nBlockXSize,
+                nYCheck, sNoData, asSlots[iSlot]);
+        else
+            GDALStatsComputeBlock<double, COMPUTE_OTHER_STATS>(
+                static_cast<const double *>(pData), nXCheck, nBlockXSize,
+                nYCheck, sNoData, asSlots[iSlot]);
+    };
+    auto batchFunc = [&sAcc, &asSlots](int nSlots)
+    {
+        for (int i = 0; i < nSlots; ++i)
+            sAcc.Merge(asSlots[i]);
+        return true;
+    };
+    return GDALStatsForEachSampledBlock(poBand, nSampleRate, pszProgressMsg,
+                                        pfnProgress, pProgressData, blockFunc,
+                                        batchFunc);
+}
+
 /************************************************************************/
 /*                          GetPixelValue()                             */
 /************************************************************************/
@@ -5474,6 +6449,10 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
  *
  * Cached statistics can be cleared with GDALDataset::ClearStatistics().
  *
+ * Starting with GDAL 3.8, blocks are processed by several threads when the
+ * GDAL_NUM_THREADS configuration option is set to a value greater than 1 or
+ * ALL_CPUS. The result does not depend on the number of threads.
+ *
  * This method is the same as the C function GDALComputeRasterStatistics().
  *
  * @param bApproxOK If TRUE statistics may be computed based on overviews
@@ -5684,13 +6663,14 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
         // explored is lower than GUINTBIG_MAX / (255*255), so that nSumSquare
         // can fit on a uint64. Should be 99.99999% of cases.
         // For GUInt16, this limits to raster of 4 giga pixels
+        // GInt16 values are biased by 32768 to use the GUInt16 code path.
         if ((eDataType == GDT_Byte && !bSignedByte &&
              static_cast<GUIntBig>(nBlocksPerRow) * nBlocksPerColumn /
                      nSampleRate <
                  GUINTBIG_MAX / (255U * 255U) /
                      (static_cast<GUInt64>(nBlockXSize) *
                       static_cast<GUInt64>(nBlockYSize))) ||
-            (eDataType == GDT_UInt16 &&
+            ((eDataType == GDT_UInt16 || eDataType == GDT_Int16) &&
              static_cast<GUIntBig>(nBlocksPerRow) * nBlocksPerColumn /
                      nSampleRate <
                  GUINTBIG_MAX / (65535U * 65535U) /
@@ -5698,66 +6678,118 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                       static_cast<GUInt64>(nBlockYSize))))
         {
             const GUInt32 nMaxValueType = (eDataType == GDT_Byte) ? 255 : 65535;
+            const GUInt32 nBias = (eDataType == GDT_Int16) ? 32768 : 0;
             GUInt32 nMin = nMaxValueType;
             GUInt32 nMax = 0;
             GUIntBig nSum = 0;
             GUIntBig nSumSquare = 0;
             // If no valid nodata, map to invalid value (256 for Byte)
-            const GUInt32 nNoDataValue =
-                (bGotNoDataValue && dfNoDataValue >= 0 &&
-                 dfNoDataValue <= nMaxValueType &&
-                 fabs(dfNoDataValue -
-                      static_cast<GUInt32>(dfNoDataValue + 1e-10)) < 1e-10)
-                    ? static_cast<GUInt32>(dfNoDataValue + 1e-10)
-                    : nMaxValueType + 1;
-
-            for (int iSampleBlock = 0;
-                 iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
+            GUInt32 nNoDataValue = nMaxValueType + 1;
+            if (eDataType == GDT_Int16)
             {
-                const int iYBlock = iSampleBlock / nBlocksPerRow;
-                const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-                GDALRasterBlock *const poBlock =
-                    GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
-                    return CE_Failure;
-
-                void *const pData = poBlock->GetDataRef();
-
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+                const GDALStatsNoData sNoData =
+                    GDALStatsGetNoData(eDataType, CPL_TO_BOOL(bGotNoDataValue),
+                                       dfNoDataValue, bGotFloatNoDataValue,
+                                       fNoDataValue);
+                if (sNoData.bHasNoData)
+                    nNoDataValue = static_cast<GUInt32>(sNoData.nLo + nBias);
+            }
+            else if (bGotNoDataValue && dfNoDataValue >= 0 &&
+                     dfNoDataValue <= nMaxValueType &&
+                     fabs(dfNoDataValue -
+                          static_cast<GUInt32>(dfNoDataValue + 1e-10)) < 1e-10)
+            {
+                nNoDataValue = static_cast<GUInt32>(dfNoDataValue + 1e-10);
+            }
 
-                if (eDataType == GDT_Byte)
+            // Per-block results, summed in the order of the blocks.
+            struct SlotStats
+            {
+                GUInt32 nMin = 0;
+                GUInt32 nMax = 0;
+                GUIntBig nSum = 0;
+                GUIntBig nSumSquare = 0;
+                GUIntBig nSampleCount = 0;
+                GUIntBig nValidCount = 0;
+                std::vector<GUInt16> anBiased{};
+            };
+            std::vector<SlotStats> asSlots(static_cast<size_t>(4) *
+                                           GDALGetNumThreads(nullptr, true));
+            const GDALDataType eDT = eDataType;
+            const int nBlockXSizeLocal = nBlockXSize;
+            auto blockFunc = [eDT, nBlockXSizeLocal, nMaxValueType,
+                              nNoDataValue, &asSlots](int iSlot,
+                                                      const void *pData,
+                                                      int nXCheck, int nYCheck)
+            {
+                SlotStats &sSlot = asSlots[iSlot];
+                sSlot.nMin = nMaxValueType;
+                sSlot.nMax = 0;
+                sSlot.nSum = 0;
+                sSlot.nSumSquare = 0;
+                sSlot.nSampleCount = 0;
+                sSlot.nValidCount = 0;
+                if (eDT == GDT_Byte)
                 {
                     ComputeStatisticsInternal<
                         GByte, /* COMPUTE_OTHER_STATS = */ true>::
-                        f(nXCheck, nBlockXSize, nYCheck,
+                        f(nXCheck, nBlockXSizeLocal, nYCheck,
                           static_cast<const GByte *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                          nNoDataValue <= nMaxValueType, nNoDataValue,
+                          sSlot.nMin, sSlot.nMax, sSlot.nSum, sSlot.nSumSquare,
+                          sSlot.nSampleCount, sSlot.nValidCount);
+                    return;
                 }
-                else
+                const GUInt16 *panData = static_cast<const GUInt16 *>(pData);
+                int nStride = nBlockXSizeLocal;
+                if (eDT == GDT_Int16)
                 {
-                    ComputeStatisticsInternal<
-                        GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
-                        f(nXCheck, nBlockXSize, nYCheck,
-                          static_cast<const GUInt16 *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                    // Flipping the sign bit maps [-32768, 32767] to
+                    // [0, 65535] while preserving the order.
+                    sSlot.anBiased.resize(static_cast<size_t>(nXCheck) *
+                                          nYCheck);
+                    for (int iY = 0; iY < nYCheck; iY++)
+                    {
+                        const GUInt16 *panSrc =
+                            panData +
+                            static_cast<GPtrDiff_t>(iY) * nBlockXSizeLocal;
+                        GUInt16 *panDst = sSlot.anBiased.data() +
+                                          static_cast<size_t>(iY) * nXCheck;
+                        for (int iX = 0; iX < nXCheck; iX++)
+                            panDst[iX] = static_cast<GUInt16>(panSrc[iX] ^
+                                                              0x8000U);
+                    }
+                    panData = sSlot.anBiased.data();
+                    nStride = nXCheck;
                 }
-
-                poBlock->DropLock();
-
-                if (!pfnProgress(iSampleBlock /
-                                     static_cast<double>(nBlocksPerRow *
-                                                         nBlocksPerColumn),
-                                 "Compute Statistics", pProgressData))
+                ComputeStatisticsInternal<GUInt16,
+                                          /* COMPUTE_OTHER_STATS = */ true>::
+                    f(nXCheck, nStride, nYCheck, panData,
+                      nNoDataValue <= nMaxValueType, nNoDataValue, sSlot.nMin,
+                      sSlot.nMax, sSlot.nSum, sSlot.nSumSquare,
+                      sSlot.nSampleCount, sSlot.nValidCount);
+            };
+            auto batchFunc = [&](int nSlots)
+            {
+                for (int i = 0; i < nSlots; ++i)
                 {
-                    ReportError(CE_Failure, CPLE_UserInterrupt,
-                                "User terminated");
-                    return CE_Failure;
+                    const SlotStats &sSlot = asSlots[i];
+                    nSampleCount += sSlot.nSampleCount;
+                    if (sSlot.nValidCount == 0)
+                        continue;
+                    nMin = std::min(nMin, sSlot.nMin);
+                    nMax = std::max(nMax, sSlot.nMax);
+                    nSum += sSlot.nSum;
+                    nSumSquare += sSlot.nSumSquare;
+                    nValidCount += sSlot.nValidCount;
                 }
+                return true;
+            };
+            if (GDALStatsForEachSampledBlock(
+                    this, nSampleRate, "Compute Statistics", pfnProgress,
+                    pProgressData, blockFunc, batchFunc) != CE_None)
+            {
+                return CE_Failure;
             }
 
             if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -5772,7 +6804,11 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
             /* --------------------------------------------------------------------
              */
             if (nValidCount)
-                dfMean = static_cast<double>(nSum) / nValidCount;
+                dfMean = static_cast<double>(
+                             static_cast<GIntBig>(nSum) -
+                             static_cast<GIntBig>(nBias) *
+                                 static_cast<GIntBig>(nValidCount)) /
+                         nValidCount;
 
             // To avoid potential precision issues when doing the difference,
             // we need to do that computation on 128 bit rather than casting
@@ -5795,7 +6831,9 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                 {
                     SetMetadataItem("STATISTICS_APPROXIMATE", nullptr);
                 }
-                SetStatistics(nMin, nMax, dfMean, dfStdDev);
+                SetStatistics(static_cast<double>(nMin) - nBias,
+                              static_cast<double>(nMax) - nBias, dfMean,
+                              dfStdDev);
             }
 
             SetValidPercent(nSampleCount, nValidCount);
@@ -5806,9 +6844,11 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
             /* --------------------------------------------------------------------
              */
             if (pdfMin != nullptr)
-                *pdfMin = nValidCount ? nMin : 0;
+                *pdfMin =
+                    nValidCount ? static_cast<double>(nMin) - nBias : 0;
             if (pdfMax != nullptr)
-                *pdfMax = nValidCount ? nMax : 0;
+                *pdfMax =
+                    nValidCount ? static_cast<double>(nMax) - nBias : 0;
 
             if (pdfMean != nullptr)
                 *pdfMean = dfMean;
@@ -5824,62 +6864,90 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                         "in sampling.");
             return CE_Failure;
         }
+
 #endif
 
-        for (int iSampleBlock = 0;
-             iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
+        // Mean and M2 of each block are computed in two passes, and combined
+        // in the order of the blocks.
+        if (eDataType == GDT_Int32 || eDataType == GDT_Float32 ||
+            eDataType == GDT_Float64)
         {
-            const int iYBlock = iSampleBlock / nBlocksPerRow;
-            const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-            GDALRasterBlock *const poBlock =
-                GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
+            const GDALStatsNoData sNoData = GDALStatsGetNoData(
+                eDataType, CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
+                bGotFloatNoDataValue, fNoDataValue);
+            GDALStatsAccumulator sAcc;
+            if (GDALStatsComputeBlocks</* COMPUTE_OTHER_STATS = */ true>(
+                    this, nSampleRate, sNoData, sAcc, "Compute Statistics",
+                    pfnProgress, pProgressData) != CE_None)
+            {
                 return CE_Failure;
+            }
+            dfMin = sAcc.dfMin;
+            dfMax = sAcc.dfMax;
+            dfMean = sAcc.dfMean;
+            dfM2 = sAcc.dfM2;
+            nValidCount = sAcc.nValidCount;
+            nSampleCount = sAcc.nSampleCount;
+        }
+        else
+        {
+            for (int iSampleBlock = 0;
+                 iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
+                 iSampleBlock += nSampleRate)
+            {
+                const int iYBlock = iSampleBlock / nBlocksPerRow;
+                const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
 
-            void *const pData = poBlock->GetDataRef();
+                GDALRasterBlock *const poBlock =
+                    GetLockedBlockRef(iXBlock, iYBlock);
+                if (poBlock == nullptr)
+                    return CE_Failure;
 
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+                void *const pData = poBlock->GetDataRef();
 
-            // This isn't the fastest way to do this, but is easier for now.
-            for (int iY = 0; iY < nYCheck; iY++)
-            {
-                for (int iX = 0; iX < nXCheck; iX++)
+                int nXCheck = 0, nYCheck = 0;
+                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+                // This isn't the fastest way to do this, but is easier for
+                // now.
+                for (int iY = 0; iY < nYCheck; iY++)
                 {
-                    const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-                    bool bValid = true;
-                    double dfValue = GetPixelValue(
-                        eDataType, bSignedByte, pData, iOffset,
-                        CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
-                        bGotFloatNoDataValue, fNoDataValue, bValid);
+                    for (int iX = 0; iX < nXCheck; iX++)
+                    {
+                        const GPtrDiff_t iOffset =
+                            iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+                        bool bValid = true;
+                        double dfValue = GetPixelValue(
+                            eDataType, bSignedByte, pData, iOffset,
+                            CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
+                            bGotFloatNoDataValue, fNoDataValue, bValid);
 
-                    if (!bValid)
-                        continue;
+                        if (!bValid)
+                            continue;
 
-                    dfMin = std::min(dfMin, dfValue);
-                    dfMax = std::max(dfMax, dfValue);
+                        dfMin = std::min(dfMin, dfValue);
+                        dfMax = std::max(dfMax, dfValue);
 
-                    nValidCount++;
-                    const double dfDelta = dfValue - dfMean;
-                    dfMean += dfDelta / nValidCount;
-                    dfM2 += dfDelta * (dfValue - dfMean);
+                        nValidCount++;
+                        const double dfDelta = dfValue - dfMean;
+                        dfMean += dfDelta / nValidCount;
+                        dfM2 += dfDelta * (dfValue - dfMean);
+                    }
                 }
-            }
 
-            nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+                nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
 
-            poBlock->DropLock();
+                poBlock->DropLock();
 
-            if (!pfnProgress(
-                    iSampleBlock /
-                        static_cast<double>(nBlocksPerRow * nBlocksPerColumn),
-                    "Compute Statistics", pProgressData))
-            {
-                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                return CE_Failure;
+                if (!pfnProgress(iSampleBlock /
+                                     static_cast<double>(nBlocksPerRow *
+                                                         nBlocksPerColumn),
+                                 "Compute Statistics", pProgressData))
+                {
+                    ReportError(CE_Failure, CPLE_UserInterrupt,
+                                "User terminated");
+                    return CE_Failure;
+                }
             }
         }
     }
@@ -6235,6 +7303,10 @@ static bool ComputeMinMaxGenericIterBlocks(
  * If bApprox is FALSE, then all pixels will be read and used to compute
  * an exact range.
  *
+ * Starting with GDAL 3.8, blocks are processed by several threads when the
+ * GDAL_NUM_THREADS configuration option is set to a value greater than 1 or
+ * ALL_CPUS.
+ *
  * This method is the same as the C function GDALComputeRasterMinMax().
  *
  * @param bApproxOK TRUE if an approximate (faster) answer is OK, otherwise
@@ -6321,9 +7393,10 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                    eDataType == GDT_UInt16;
 
     const auto ComputeMinMaxForBlock =
-        [this, bSignedByte, bGotNoDataValue, dfNoDataValue, &nMin, &nMax,
-         &nMinInt16, &nMaxInt16](const void *pData, int nXCheck,
-                                 int nBufferWidth, int nYCheck)
+        [this, bSignedByte, bGotNoDataValue,
+         dfNoDataValue](const void *pData, int nXCheck, int nBufferWidth,
+                        int nYCheck, GUInt32 &nMinOut, GUInt32 &nMaxOut,
+                        GInt16 &nMinInt16Out, GInt16 &nMaxInt16Out)
     {
         if (eDataType == GDT_Byte && !bSignedByte)
         {
@@ -6337,7 +7410,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GByte *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  nMinOut, nMaxOut, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_UInt16)
         {
@@ -6351,7 +7425,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GUInt16 *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  nMinOut, nMaxOut, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_Int16)
         {
@@ -6367,7 +7442,7 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, true>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, nNoDataValue, &nMinInt16, &nMaxInt16);
+                        nXCheck, nNoDataValue, &nMinInt16Out, &nMaxInt16Out);
                 }
             }
             else
@@ -6377,7 +7452,7 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, false>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, 0, &nMinInt16, &nMaxInt16);
+                        nXCheck, 0, &nMinInt16Out, &nMaxInt16Out);
                 }
             }
         }
@@ -6422,7 +7497,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced);
+            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced,
+                                  nMin, nMax, nMinInt16, nMaxInt16);
         }
         else
         {
@@ -6462,30 +7538,64 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            for (int iSampleBlock = 0;
-                 iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
+            struct SlotMinMax
             {
-                const int iYBlock = iSampleBlock / nBlocksPerRow;
-                const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-                GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
-                    return CE_Failure;
-
-                void *const pData = poBlock->GetDataRef();
-
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck);
-
-                poBlock->DropLock();
-
-                if (eDataType == GDT_Byte && !bSignedByte && nMin == 0 &&
-                    nMax == 255)
-                    break;
+                GUInt32 nMin = 0;
+                GUInt32 nMax = 0;
+                GInt16 nMinInt16 = 0;
+                GInt16 nMaxInt16 = 0;
+            };
+            std::vector<SlotMinMax> asSlots(static_cast<size_t>(4) *
+                                            GDALGetNumThreads(nullptr, true));
+            const GUInt32 nInitMin = nMin;
+            const int nBlockXSizeLocal = nBlockXSize;
+            auto blockFunc = [&ComputeMinMaxForBlock, &asSlots, nInitMin,
+                              nBlockXSizeLocal](int iSlot, const void *pData,
+                                                int nXCheck, int nYCheck)
+            {
+                SlotMinMax &sSlot = asSlots[iSlot];
+                sSlot.nMin = nInitMin;
+                sSlot.nMax = 0;
+                sSlot.nMinInt16 = std::numeric_limits<GInt16>::max();
+                sSlot.nMaxInt16 = std::numeric_limits<GInt16>::lowest();
+                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSizeLocal,
+                                      nYCheck, sSlot.nMin, sSlot.nMax,
+                                      sSlot.nMinInt16, sSlot.nMaxInt16);
+            };
+            const bool bIsUnsignedByte = eDataType == GDT_Byte && !bSignedByte;
+            auto batchFunc = [&](int nSlots)
+            {
+                for (int i = 0; i < nSlots; ++i)
+                {
+                    nMin = std::min(nMin, asSlots[i].nMin);
+                    nMax = std::max(nMax, asSlots[i].nMax);
+                    nMinInt16 = std::min(nMinInt16, asSlots[i].nMinInt16);
+                    nMaxInt16 = std::max(nMaxInt16, asSlots[i].nMaxInt16);
+                }
+                return !(bIsUnsignedByte && nMin == 0 && nMax == 255);
+            };
+            if (GDALStatsForEachSampledBlock(this, nSampleRate, "",
+                                             GDALDummyProgress, nullptr,
+                                             blockFunc, batchFunc) != CE_None)
+            {
+                return CE_Failure;
+            }
+        }
+        else if (eDataType == GDT_Int32 || eDataType == GDT_Float32 ||
+                 eDataType == GDT_Float64)
+        {
+            const GDALStatsNoData sNoData = GDALStatsGetNoData(
+                eDataType, CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
+                bGotFloatNoDataValue, fNoDataValue);
+            GDALStatsAccumulator sAcc;
+            if (GDALStatsComputeBlocks</* COMPUTE_OTHER_STATS = */ false>(
+                    this, nSampleRate, sNoData, sAcc, "", GDALDummyProgress,
+                    nullptr) != CE_None)
+            {
+                return CE_Failure;
             }
+            dfMin = sAcc.dfMin;
+            dfMax = sAcc.dfMax;
         }
         else
         {
@@ -34,6 +34,8 @@
 
 #include <algorithm>
 #include <climits>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 
 #include "cpl_atomic_ops.h"
@@ -46,21 +48,106 @@
 static bool bCacheMaxInitialized = false;
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static GIntBig nCacheUsed = 0;
-
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
+/************************************************************************/
+/*                      GDALRasterBlockCacheShard                       */
+/************************************************************************/
+
+// The global block cache is made of one or several shards. Each shard has
+// its own LRU list, its own lock and its own share of the cache budget.
+// A block is assigned to a shard from a hash of its band and coordinates, so
+// that the blocks of a given band are spread uniformly over the shards,
+// and evicting the oldest block of a shard approximates a global LRU
+// eviction. The number of shards is controlled by the GDAL_RB_CACHE_SHARDS
+// configuration option, and defaults to 1, which corresponds to the
+// historical behavior of a single global list and lock.
+
+constexpr int MAX_RB_CACHE_SHARDS = 128;
+
+struct alignas(64) GDALRasterBlockCacheShard
+{
+    CPLLock *hLock = nullptr;
+    GDALRasterBlock *poOldest = nullptr;  // Tail.
+    GDALRasterBlock *poNewest = nullptr;  // Head.
+    GIntBig nCacheUsed = 0;
+};
+
+static GDALRasterBlockCacheShard asShards[MAX_RB_CACHE_SHARDS];
+
+/************************************************************************/
+/*                          GetShardCount()                             */
+/************************************************************************/
+
+static int ReadShardCount()
+{
+    const char *pszShards = CPLGetConfigOption("GDAL_RB_CACHE_SHARDS", "1");
+    const int nShards =
+        EQUAL(pszShards, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszShards);
+    if (nShards < 1 || nShards > MAX_RB_CACHE_SHARDS)
+    {
+        const int nClamped =
+            std::max(1, std::min(MAX_RB_CACHE_SHARDS, nShards));
+        CPLError(CE_Warning, CPLE_NotSupported,
+                 "GDAL_RB_CACHE_SHARDS=%s not supported. Using %d", pszShards,
+                 nClamped);
+        return nClamped;
+    }
+    if (nShards > 1)
+        CPLDebug("GDAL", "Using %d block cache shards", nShards);
+    return nShards;
+}
+
+// The value is read only once, as it must not change while blocks are cached.
+static int GetShardCount()
+{
+    static const int nShards = ReadShardCount();
+    return nShards;
+}
+
+/************************************************************************/
+/*                              GetShard()                              */
+/************************************************************************/
+
+static GDALRasterBlockCacheShard &GetShard(GDALRasterBlock *poBlock)
+{
+    const int nShards = GetShardCount();
+    if (nShards == 1)
+        return asShards[0];
+
+    GUIntBig nHash =
+        static_cast<GUIntBig>(reinterpret_cast<std::uintptr_t>(
+                                  poBlock->GetBand()) >>
+                              6) *
+        UINT64_C(0x9E3779B97F4A7C15);
+    nHash ^= static_cast<GUIntBig>(static_cast<GUInt32>(poBlock->GetXOff())) *
+             UINT64_C(0xC2B2AE3D27D4EB4F);
+    nHash ^= static_cast<GUIntBig>(static_cast<GUInt32>(poBlock->GetYOff())) *
+             UINT64_C(0x165667B19E3779F9);
+    nHash ^= nHash >> 29;
+    return asShards[nHash % static_cast<unsigned>(nShards)];
+}
+
+/************************************************************************/
+/*                         GetTotalCacheUsed()                          */
+/************************************************************************/
+
+static GIntBig GetTotalCacheUsed()
+{
+    const int nShards = GetShardCount();
+    GIntBig nTotal = 0;
+    for (int i = 0; i < nShards; ++i)
+        nTotal += asShards[i].nCacheUsed;
+    return nTotal;
+}
+
 #if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD(&hRBLock)
-#define TAKE_LOCK CPLMutexHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyMutex(hRBLock)
+#define INITIALIZE_LOCK(shard) CPLMutexHolderD(&((shard).hLock))
+#define TAKE_LOCK(shard) CPLMutexHolderOptionalLockD((shard).hLock)
+#define DESTROY_LOCK(shard) CPLDestroyMutex((shard).hLock)
 #else
 
-static CPLLock *hRBLock = nullptr;
 static bool bDebugContention = false;
 static bool bSleepsForBockCacheDebug = false;
 static CPLLockType GetLockType()
@@ -90,14 +177,27 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK                                                        \
-    CPLLockHolderD(&hRBLock, GetLockType());                                   \
-    CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK CPLLockHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyLock(hRBLock)
+#define INITIALIZE_LOCK(shard)                                                 \
+    CPLLockHolderD(&((shard).hLock), GetLockType());                           \
+    CPLLockSetDebugPerf((shard).hLock, bDebugContention)
+#define TAKE_LOCK(shard) CPLLockHolderOptionalLockD((shard).hLock)
+#define DESTROY_LOCK(shard) CPLDestroyLock((shard).hLock)
 
 #endif
 
+/************************************************************************/
+/*                         InitializeLocks()                            */
+/************************************************************************/
+
+static void InitializeLocks()
+{
+    const int nShards = GetShardCount();
+    for (int i = 0; i < nShards; ++i)
+    {
+        INITIALIZE_LOCK(asShards[i]);
+    }
+}
+
 // #define ENABLE_DEBUG
 
 /************************************************************************/
@@ -153,9 +253,7 @@ void CPL_STDCALL GDALSetCacheMax64(GIntBig nNewSizeInBytes)
     }
 #endif
 
-    {
-        INITIALIZE_LOCK;
-    }
+    InitializeLocks();
     bCacheMaxInitialized = true;
     nCacheMax = nNewSizeInBytes;
 
@@ -163,13 +261,13 @@ void CPL_STDCALL GDALSetCacheMax64(GIntBig nNewSizeInBytes)
     /*      Flush blocks till we are under the new limit or till we         */
     /*      can't seem to flush anymore.                                    */
     /* -------------------------------------------------------------------- */
-    while (nCacheUsed > nCacheMax)
+    while (GetTotalCacheUsed() > nCacheMax)
     {
-        const GIntBig nOldCacheUsed = nCacheUsed;
+        const GIntBig nOldCacheUsed = GetTotalCacheUsed();
 
         GDALFlushCacheBlock();
 
-        if (nCacheUsed == nOldCacheUsed)
+        if (GetTotalCacheUsed() == nOldCacheUsed)
             break;
     }
 }
@@ -239,9 +337,7 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
 {
     if (!bCacheMaxInitialized)
     {
-        {
-            INITIALIZE_LOCK;
-        }
+        InitializeLocks();
         bSleepsForBockCacheDebug =
             CPLTestBool(CPLGetConfigOption("GDAL_DEBUG_BLOCK_CACHE", "NO"));
 
@@ -321,6 +417,7 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
 
 int CPL_STDCALL GDALGetCacheUsed()
 {
+    const GIntBig nCacheUsed = GetTotalCacheUsed();
     if (nCacheUsed > INT_MAX)
     {
         static bool bHasWarned = false;
@@ -351,7 +448,7 @@ int CPL_STDCALL GDALGetCacheUsed()
 
 GIntBig CPL_STDCALL GDALGetCacheUsed64()
 {
-    return nCacheUsed;
+    return GetTotalCacheUsed();
 }
 
 /************************************************************************/
@@ -431,11 +528,25 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
 {
-    GDALRasterBlock *poTarget;
-
+    GDALRasterBlock *poTarget = nullptr;
+
+    // When there are several shards, start from a different one at each
+    // call, so that eviction is spread over all of them.
+    const int nShards = GetShardCount();
+    static int nNextShard = 0;
+    const int iFirstShard =
+        nShards == 1 ? 0
+                     : static_cast<int>(
+                           static_cast<unsigned>(CPLAtomicInc(&nNextShard)) %
+                           static_cast<unsigned>(nShards));
+
+    for (int iIter = 0; iIter < nShards && poTarget == nullptr; ++iIter)
     {
-        INITIALIZE_LOCK;
-        poTarget = poOldest;
+        GDALRasterBlockCacheShard &oShard =
+            asShards[(iFirstShard + iIter) % nShards];
+
+        INITIALIZE_LOCK(oShard);
+        poTarget = oShard.poOldest;
 
         while (poTarget != nullptr)
         {
@@ -449,7 +560,7 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
 
         if (poTarget == nullptr)
-            return FALSE;
+            continue;
         if (bSleepsForBockCacheDebug)
         {
             // coverity[tainted_data]
@@ -463,6 +574,9 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         poTarget->GetBand()->UnreferenceBlock(poTarget);
     }
 
+    if (poTarget == nullptr)
+        return FALSE;
+
     if (bSleepsForBockCacheDebug)
     {
         // coverity[tainted_data]
@@ -698,19 +812,21 @@ void GDALRasterBlock::Detach()
 {
     if (bMustDetach)
     {
-        TAKE_LOCK;
+        TAKE_LOCK(GetShard(this));
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if (poOldest == this)
-        poOldest = poPrevious;
+    GDALRasterBlockCacheShard &oShard = GetShard(this);
 
-    if (poNewest == this)
+    if (oShard.poOldest == this)
+        oShard.poOldest = poPrevious;
+
+    if (oShard.poNewest == this)
     {
-        poNewest = poNext;
+        oShard.poNewest = poNext;
     }
 
     if (poPrevious != nullptr)
@@ -724,7 +840,7 @@ void GDALRasterBlock::Detach_unlocked()
     bMustDetach = false;
 
     if (pData)
-        nCacheUsed -= GetEffectiveBlockSize(GetBlockSize());
+        oShard.nCacheUsed -= GetEffectiveBlockSize(GetBlockSize());
 
 #ifdef ENABLE_DEBUG
     Verify();
@@ -744,26 +860,32 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
-
-    CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
-              (poNewest != nullptr && poOldest != nullptr));
-
-    if (poNewest != nullptr)
+    const int nShards = GetShardCount();
+    for (int i = 0; i < nShards; ++i)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        CPLAssert(poOldest->poNext == nullptr);
+        GDALRasterBlockCacheShard &oShard = asShards[i];
+        TAKE_LOCK(oShard);
+
+        CPLAssert((oShard.poNewest == nullptr && oShard.poOldest == nullptr) ||
+                  (oShard.poNewest != nullptr && oShard.poOldest != nullptr));
 
-        GDALRasterBlock *poLast = nullptr;
-        for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-             poBlock = poBlock->poNext)
+        if (oShard.poNewest != nullptr)
         {
-            CPLAssert(poBlock->poPrevious == poLast);
+            CPLAssert(oShard.poNewest->poPrevious == nullptr);
+            CPLAssert(oShard.poOldest->poNext == nullptr);
 
-            poLast = poBlock;
-        }
+            GDALRasterBlock *poLast = nullptr;
+            for (GDALRasterBlock *poBlock = oShard.poNewest; poBlock != nullptr;
+                 poBlock = poBlock->poNext)
+            {
+                CPLAssert(poBlock->poPrevious == poLast);
+                CPLAssert(&GetShard(poBlock) == &oShard);
+
+                poLast = poBlock;
+            }
 
-        CPLAssert(poOldest == poLast);
+            CPLAssert(oShard.poOldest == poLast);
+        }
     }
 }
 
@@ -776,24 +898,27 @@ void GDALRasterBlock::Verify()
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks(GDALRasterBand *poBand)
 {
-    TAKE_LOCK;
-    for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-         poBlock = poBlock->poNext)
+    for (int i = 0; i < GetShardCount(); ++i)
     {
-        if (poBlock->GetBand() == poBand)
+        TAKE_LOCK(asShards[i]);
+        for (GDALRasterBlock *poBlock = asShards[i].poNewest;
+             poBlock != nullptr; poBlock = poBlock->poNext)
         {
-            printf("Cache has still blocks of band %p\n", poBand); /*ok*/
-            printf("Band : %d\n", poBand->GetBand());              /*ok*/
-            printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
-            printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
-            int nBlockXSize, nBlockYSize;
-            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
-            printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
-            printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
-            printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
-            if (poBand->GetDataset())
-                printf("Dataset : %s\n", /*ok*/
-                       poBand->GetDataset()->GetDescription());
+            if (poBlock->GetBand() == poBand)
+            {
+                printf("Cache has still blocks of band %p\n", poBand); /*ok*/
+                printf("Band : %d\n", poBand->GetBand());              /*ok*/
+                printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
+                printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
+                int nBlockXSize, nBlockYSize;
+                poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+                printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
+                printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
+                printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
+                if (poBand->GetDataset())
+                    printf("Dataset : %s\n", /*ok*/
+                           poBand->GetDataset()->GetDescription());
+            }
         }
     }
 }
@@ -850,32 +975,36 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
+    GDALRasterBlockCacheShard &oShard = GetShard(this);
+
     // Can be safely tested outside the lock
-    if (poNewest == this)
+    if (oShard.poNewest == this)
         return;
 
-    TAKE_LOCK;
+    TAKE_LOCK(oShard);
     Touch_unlocked();
 }
 
 void GDALRasterBlock::Touch_unlocked()
 
 {
+    GDALRasterBlockCacheShard &oShard = GetShard(this);
+
     // Could happen even if tested in Touch() before taking the lock
     // Scenario would be :
     // 0. this is the second block (the one pointed by poNewest->poNext)
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
-    if (poNewest == this)
+    if (oShard.poNewest == this)
         return;
 
     // We should not try to touch a block that has been detached.
     // If that happen, corruption has already occurred.
     CPLAssert(bMustDetach);
 
-    if (poOldest == this)
-        poOldest = this->poPrevious;
+    if (oShard.poOldest == this)
+        oShard.poOldest = this->poPrevious;
 
     if (poPrevious != nullptr)
         poPrevious->poNext = poNext;
@@ -884,19 +1013,19 @@ void GDALRasterBlock::Touch_unlocked()
         poNext->poPrevious = poPrevious;
 
     poPrevious = nullptr;
-    poNext = poNewest;
+    poNext = oShard.poNewest;
 
-    if (poNewest != nullptr)
+    if (oShard.poNewest != nullptr)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        poNewest->poPrevious = this;
+        CPLAssert(oShard.poNewest->poPrevious == nullptr);
+        oShard.poNewest->poPrevious = this;
     }
-    poNewest = this;
+    oShard.poNewest = this;
 
-    if (poOldest == nullptr)
+    if (oShard.poOldest == nullptr)
     {
         CPLAssert(poPrevious == nullptr && poNext == nullptr);
-        poOldest = this;
+        oShard.poOldest = this;
     }
 #ifdef ENABLE_DEBUG
     Verify();
@@ -925,10 +1054,14 @@ CPLErr GDALRasterBlock::Internalize()
 
     void *pNewData = nullptr;
 
-    // This call will initialize the hRBLock mutex. Other call places can
+    // This call will initialize the block cache locks. Other call places can
     // only be called if we have go through there.
     const GIntBig nCurCacheMax = GDALGetCacheMax64();
 
+    // Each shard gets an equal share of the cache budget.
+    GDALRasterBlockCacheShard &oShard = GetShard(this);
+    const GIntBig nCurShardCacheMax = nCurCacheMax / GetShardCount();
+
     // No risk of overflow as it is checked in GDALRasterBand::InitBlockInfo().
     const auto nSizeInBytes = GetBlockSize();
 
@@ -944,12 +1077,12 @@ CPLErr GDALRasterBlock::Internalize()
         GDALRasterBlock *apoBlocksToFree[64] = {nullptr};
         int nBlocksToFree = 0;
         {
-            TAKE_LOCK;
+            TAKE_LOCK(oShard);
 
             if (bFirstIter)
-                nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
-            while (nCacheUsed > nCurCacheMax)
+                oShard.nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
+            GDALRasterBlock *poTarget = oShard.poOldest;
+            while (oShard.nCacheUsed > nCurShardCacheMax)
             {
                 GDALRasterBlock *poDirtyBlockOtherDataset = nullptr;
                 // In this first pass, only discard dirty blocks of this
@@ -995,7 +1128,7 @@ CPLErr GDALRasterBlock::Internalize()
                     }
                     else
                     {
-                        poTarget = poOldest;
+                        poTarget = oShard.poOldest;
                         while (poTarget != nullptr)
                         {
                             if (CPLAtomicCompareAndExchange(
@@ -1033,12 +1166,12 @@ CPLErr GDALRasterBlock::Internalize()
                         // Only free one dirty block at a time so that
                         // other dirty blocks of other bands with the same
                         // coordinates can be found with TryGetLockedBlock()
-                        bLoopAgain = nCacheUsed > nCurCacheMax;
+                        bLoopAgain = oShard.nCacheUsed > nCurShardCacheMax;
                         break;
                     }
                     if (nBlocksToFree == 64)
                     {
-                        bLoopAgain = (nCacheUsed > nCurCacheMax);
+                        bLoopAgain = (oShard.nCacheUsed > nCurShardCacheMax);
                         break;
                     }
 
@@ -1164,9 +1297,12 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
-    if (hRBLock != nullptr)
-        DESTROY_LOCK;
-    hRBLock = nullptr;
+    for (auto &oShard : asShards)
+    {
+        if (oShard.hLock != nullptr)
+            DESTROY_LOCK(oShard);
+        oShard.hLock = nullptr;
+    }
 }
 /*! @endcond */
 
@@ -1244,7 +1380,7 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced.
-    TAKE_LOCK;
+    TAKE_LOCK(GetShard(this));
 
     return FALSE;
 }
@@ -1253,7 +1389,7 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
+    for( GDALRasterBlock *poBlock = asShards[0].poNewest;
          poBlock != nullptr;
          poBlock = poBlock->poNext )
     {
@@ -50,6 +50,7 @@
 #include "gdal.h"
 #include "gdal_thread_pool.h"
 #include "gdalwarper.h"
+#include "memdataset.h"
 
 // Restrict to 64bit processors because they are guaranteed to have SSE2.
 // Could possibly be used too on 32bit, but we would need to check at runtime.
@@ -1993,7 +1994,36 @@ static CPLErr GDALResampleChunk32R_Gauss(
                 nSrcXOff = nChunkXOff;
             }
 
-            if (poColorTable == nullptr)
+            if (poColorTable == nullptr && pabySrcScanlineNodataMask == nullptr)
+            {
+                // Fast path without any mask: no per-pixel test in the inner
+                // loop. The accumulation order is kept identical to the
+                // generic path below so that results are unchanged.
+                double dfTotal = 0.0;
+                GInt64 nCount = 0;
+                const int *panLineWeight =
+                    panGaussMatrix + nYShiftGaussMatrix * nGaussMatrixDim +
+                    nXShiftGaussMatrix;
+                const int nXCount = nSrcXOff2 - nSrcXOff;
+                const float *pafSrc = pafSrcScanline + nSrcXOff - nChunkXOff;
+
+                for (int iY = nSrcYOff; iY < nSrcYOff2; ++iY,
+                         panLineWeight += nGaussMatrixDim,
+                         pafSrc += nChunkXSize)
+                {
+                    for (int i = 0; i < nXCount; ++i)
+                    {
+                        dfTotal += static_cast<double>(pafSrc[i]) *
+                                   panLineWeight[i];
+                        nCount += panLineWeight[i];
+                    }
+                }
+
+                pafDstScanline[iDstPixel - nDstXOff] =
+                    nCount == 0 ? fNoDataValue
+                                : static_cast<float>(dfTotal / nCount);
+            }
+            else if (poColorTable == nullptr)
             {
                 double dfTotal = 0.0;
                 GInt64 nCount = 0;
@@ -2140,7 +2170,43 @@ static CPLErr GDALResampleChunk32R_Mode(
 
     const int nChunkRightXOff = nChunkXOff + nChunkXSize;
     const int nChunkBottomYOff = nChunkYOff + nChunkYSize;
-    std::vector<int> anVals(256, 0);
+
+    // Integer data types with at most 65536 distinct values are processed
+    // with a histogram table indexed by value, instead of the generic
+    // list of distinct values which is quadratic in the number of source
+    // pixels. The Byte case keeps its historical behavior of comparing with
+    // the nodata value, whereas the other types use the mask, as the generic
+    // case does.
+    const bool bByteHistogram =
+        eSrcDataType == GDT_Byte &&
+        !(poColorTable && poColorTable->GetColorEntryCount() > 256);
+    int nHistogramOffset = 0;
+    size_t nHistogramSize = 0;
+    if (bByteHistogram)
+        nHistogramSize = 256;
+    else if (eSrcDataType == GDT_Int8)
+    {
+        nHistogramOffset = 128;
+        nHistogramSize = 256;
+    }
+    else if (eSrcDataType == GDT_UInt16)
+        nHistogramSize = 65536;
+    else if (eSrcDataType == GDT_Int16)
+    {
+        nHistogramOffset = 32768;
+        nHistogramSize = 65536;
+    }
+    std::vector<int> anVals;
+    try
+    {
+        anVals.resize(nHistogramSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate histogram for mode resampling");
+        return CE_Failure;
+    }
 
     /* ==================================================================== */
     /*      Loop over destination scanlines.                                */
@@ -2219,8 +2285,7 @@ static CPLErr GDALResampleChunk32R_Mode(
             if (nSrcXOff2 > nChunkRightXOff)
                 nSrcXOff2 = nChunkRightXOff;
 
-            if (eSrcDataType != GDT_Byte ||
-                (poColorTable && poColorTable->GetColorEntryCount() > 256))
+            if (nHistogramSize == 0)
             {
                 // Not sure how much sense it makes to run a majority
                 // filter on floating point data, but here it is for the sake
@@ -2311,18 +2376,13 @@ static CPLErr GDALResampleChunk32R_Mode(
                 else
                     pafDstScanline[iDstPixel - nDstXOff] = pafVals[iMaxVal];
             }
-            else  // if( eSrcDataType == GDT_Byte && nEntryCount < 256 )
+            else
             {
-                // So we go here for a paletted or non-paletted byte band.
-                // The input values are then between 0 and 255.
+                // The input values are then between -nHistogramOffset and
+                // nHistogramSize - nHistogramOffset - 1.
                 int nMaxVal = 0;
                 int iMaxInd = -1;
 
-                // The cost of this zeroing might be high. Perhaps we should
-                // just use the above generic case, and go to this one if the
-                // number of source pixels is large enough
-                std::fill(anVals.begin(), anVals.end(), 0);
-
                 for (int iY = nSrcYOff; iY < nSrcYOff2; ++iY)
                 {
                     const GPtrDiff_t iTotYOff =
@@ -2331,9 +2391,13 @@ static CPLErr GDALResampleChunk32R_Mode(
                     for (int iX = nSrcXOff; iX < nSrcXOff2; ++iX)
                     {
                         const float val = pafSrcScanline[iX + iTotYOff];
-                        if (bHasNoData == FALSE || val != fNoDataValue)
+                        if (bByteHistogram
+                                ? (bHasNoData == FALSE || val != fNoDataValue)
+                                : (pabySrcScanlineNodataMask == nullptr ||
+                                   pabySrcScanlineNodataMask[iX + iTotYOff]))
                         {
-                            int nVal = static_cast<int>(val);
+                            const int nVal =
+                                static_cast<int>(val) + nHistogramOffset;
                             if (++anVals[nVal] > nMaxVal)
                             {
                                 // Sum the density.
@@ -2349,7 +2413,37 @@ static CPLErr GDALResampleChunk32R_Mode(
                     pafDstScanline[iDstPixel - nDstXOff] = fNoDataValue;
                 else
                     pafDstScanline[iDstPixel - nDstXOff] =
-                        static_cast<float>(iMaxInd);
+                        static_cast<float>(iMaxInd - nHistogramOffset);
+
+                // Reset the histogram. When the window is small compared to
+                // the table, it is cheaper to only clear the entries that
+                // were incremented.
+                if (nMaxVal == 0)
+                {
+                    // nothing to do
+                }
+                else if (static_cast<size_t>(nSrcYOff2 - nSrcYOff) *
+                             (nSrcXOff2 - nSrcXOff) >=
+                         nHistogramSize / 4)
+                {
+                    std::fill(anVals.begin(), anVals.end(), 0);
+                }
+                else
+                {
+                    for (int iY = nSrcYOff; iY < nSrcYOff2; ++iY)
+                    {
+                        const GPtrDiff_t iTotYOff =
+                            static_cast<GPtrDiff_t>(iY - nSrcYOff) *
+                                nChunkXSize -
+                            nChunkXOff;
+                        for (int iX = nSrcXOff; iX < nSrcXOff2; ++iX)
+                        {
+                            const int nVal = static_cast<int>(
+                                pafSrcScanline[iX + iTotYOff]);
+                            anVals[nVal + nHistogramOffset] = 0;
+                        }
+                    }
+                }
             }
         }
     }
@@ -2694,6 +2788,14 @@ inline double GDALResampleConvolutionHorizontal<GUInt16>(
                                                  nSrcPixelCount);
 }
 
+template <>
+inline double GDALResampleConvolutionHorizontal<float>(
+    const float *pChunk, const double *padfWeightsAligned, int nSrcPixelCount)
+{
+    return GDALResampleConvolutionHorizontalSSE2(pChunk, padfWeightsAligned,
+                                                 nSrcPixelCount);
+}
+
 /************************************************************************/
 /*              GDALResampleConvolutionHorizontalWithMaskSSE2<T>        */
 /************************************************************************/
@@ -2753,6 +2855,17 @@ inline void GDALResampleConvolutionHorizontalWithMask<GUInt16>(
         dfWeightSum);
 }
 
+template <>
+inline void GDALResampleConvolutionHorizontalWithMask<float>(
+    const float *pChunk, const GByte *pabyMask,
+    const double *padfWeightsAligned, int nSrcPixelCount, double &dfVal,
+    double &dfWeightSum)
+{
+    GDALResampleConvolutionHorizontalWithMaskSSE2(
+        pChunk, pabyMask, padfWeightsAligned, nSrcPixelCount, dfVal,
+        dfWeightSum);
+}
+
 /************************************************************************/
 /*              GDALResampleConvolutionHorizontal_3rows_SSE2<T>         */
 /************************************************************************/
@@ -2828,6 +2941,17 @@ inline void GDALResampleConvolutionHorizontal_3rows<GUInt16>(
         dfRes1, dfRes2, dfRes3);
 }
 
+template <>
+inline void GDALResampleConvolutionHorizontal_3rows<float>(
+    const float *pChunkRow1, const float *pChunkRow2, const float *pChunkRow3,
+    const double *padfWeightsAligned, int nSrcPixelCount, double &dfRes1,
+    double &dfRes2, double &dfRes3)
+{
+    GDALResampleConvolutionHorizontal_3rows_SSE2(
+        pChunkRow1, pChunkRow2, pChunkRow3, padfWeightsAligned, nSrcPixelCount,
+        dfRes1, dfRes2, dfRes3);
+}
+
 /************************************************************************/
 /*     GDALResampleConvolutionHorizontalPixelCountLess8_3rows_SSE2<T>   */
 /************************************************************************/
@@ -2894,6 +3018,17 @@ inline void GDALResampleConvolutionHorizontalPixelCountLess8_3rows<GUInt16>(
         dfRes1, dfRes2, dfRes3);
 }
 
+template <>
+inline void GDALResampleConvolutionHorizontalPixelCountLess8_3rows<float>(
+    const float *pChunkRow1, const float *pChunkRow2, const float *pChunkRow3,
+    const double *padfWeightsAligned, int nSrcPixelCount, double &dfRes1,
+    double &dfRes2, double &dfRes3)
+{
+    GDALResampleConvolutionHorizontalPixelCountLess8_3rows_SSE2(
+        pChunkRow1, pChunkRow2, pChunkRow3, padfWeightsAligned, nSrcPixelCount,
+        dfRes1, dfRes2, dfRes3);
+}
+
 /************************************************************************/
 /*     GDALResampleConvolutionHorizontalPixelCount4_3rows_SSE2<T>       */
 /************************************************************************/
@@ -2947,6 +3082,17 @@ inline void GDALResampleConvolutionHorizontalPixelCount4_3rows<GUInt16>(
         dfRes3);
 }
 
+template <>
+inline void GDALResampleConvolutionHorizontalPixelCount4_3rows<float>(
+    const float *pChunkRow1, const float *pChunkRow2, const float *pChunkRow3,
+    const double *padfWeightsAligned, double &dfRes1, double &dfRes2,
+    double &dfRes3)
+{
+    GDALResampleConvolutionHorizontalPixelCount4_3rows_SSE2(
+        pChunkRow1, pChunkRow2, pChunkRow3, padfWeightsAligned, dfRes1, dfRes2,
+        dfRes3);
+}
+
 #endif  // USE_SSE2
 
 /************************************************************************/
@@ -3061,6 +3207,34 @@ static CPLErr GDALResampleChunk32R_ConvolutionT(
     const double dfYScaleWeight = (dfYScale >= 1.0) ? 1.0 : dfYScale;
     const double dfYScaledRadius = nKernelRadius / dfYScaleWeight;
 
+    // Only run the horizontal filter on the source lines needed by the
+    // requested destination lines. This matters when the caller splits a
+    // chunk into several jobs over subsets of the destination lines.
+    if (nBands == 1 && nDstYOff2 > nDstYOff)
+    {
+        const int nSrcLineMin = std::max(
+            nChunkYOff, static_cast<int>(floor((nDstYOff + 0.5) *
+                                                   dfYRatioDstToSrc +
+                                               dfSrcYDelta - dfYScaledRadius +
+                                               0.5)));
+        const int nSrcLineMax = std::min(
+            nChunkYOff + nChunkYSize,
+            static_cast<int>((nDstYOff2 - 0.5) * dfYRatioDstToSrc +
+                             dfSrcYDelta + dfYScaledRadius + 0.5));
+        if (nSrcLineMin > nChunkYOff && nSrcLineMin < nSrcLineMax)
+        {
+            const GPtrDiff_t nShift =
+                static_cast<GPtrDiff_t>(nSrcLineMin - nChunkYOff) * nChunkXSize;
+            pChunk += nShift;
+            if (pabyChunkNodataMask)
+                pabyChunkNodataMask += nShift;
+            nChunkYSize -= nSrcLineMin - nChunkYOff;
+            nChunkYOff = nSrcLineMin;
+        }
+        if (nSrcLineMax > nChunkYOff && nSrcLineMax < nChunkYOff + nChunkYSize)
+            nChunkYSize = nSrcLineMax - nChunkYOff;
+    }
+
     // Temporary array to store result of horizontal filter.
     double *padfHorizontalFiltered = static_cast<double *>(
         VSI_MALLOC3_VERBOSE(nChunkYSize, nDstXSize, sizeof(double) * nBands));
@@ -4715,42 +4889,62 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
                      nDstWidth, nDstYOff2 - nDstYOff);
 #endif
 
-            auto poJob = std::unique_ptr<OvrJob>(new OvrJob());
-            poJob->pfnResampleFn = pfnResampleFn;
-            poJob->dfXRatioDstToSrc = dfXRatioDstToSrc;
-            poJob->dfYRatioDstToSrc = dfYRatioDstToSrc;
-            poJob->eWrkDataType = eWrkDataType;
-            poJob->pChunk = pChunk;
-            poJob->pabyChunkNodataMask = pabyChunkNodataMask;
-            poJob->nWidth = nWidth;
-            poJob->nHeight = nHeight;
-            poJob->nChunkYOff = nChunkYOffQueried;
-            poJob->nChunkYSize = nChunkYSizeQueried;
-            poJob->nDstWidth = nDstWidth;
-            poJob->nDstYOff = nDstYOff;
-            poJob->nDstYOff2 = nDstYOff2;
-            poJob->poDstBand = poDstBand;
-            poJob->pszResampling = pszResampling;
-            poJob->bHasNoData = bHasNoData;
-            poJob->fNoDataValue = fNoDataValue;
-            poJob->poColorTable = poColorTable;
-            poJob->eSrcDataType = eSrcDataType;
-            poJob->bPropagateNoData = bPropagateNoData;
-
-            if (poJobQueue)
-            {
-                poJob->oSrcMaskBufferHolder = oSrcMaskBufferHolder;
-                poJob->oSrcBufferHolder = oSrcBufferHolder;
-                poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
-                jobList.emplace_back(std::move(poJob));
-            }
-            else
+            // When multithreading, split the destination lines of this
+            // chunk into several jobs sharing the same source buffer, so
+            // that a single chunk is resampled in parallel, and not only
+            // successive chunks or overview levels. Each destination line
+            // only depends on the source chunk, so the result is identical.
+            constexpr int MIN_DST_LINES_PER_JOB = 32;
+            const int nJobCount =
+                poJobQueue ? std::max(1, std::min(nThreads,
+                                                  (nDstYOff2 - nDstYOff) /
+                                                      MIN_DST_LINES_PER_JOB))
+                           : 1;
+            for (int iJob = 0; iJob < nJobCount && eErr == CE_None; ++iJob)
             {
-                JobResampleFunc(poJob.get());
-                eErr = poJob->eErr;
-                if (eErr == CE_None)
+                auto poJob = std::unique_ptr<OvrJob>(new OvrJob());
+                poJob->pfnResampleFn = pfnResampleFn;
+                poJob->dfXRatioDstToSrc = dfXRatioDstToSrc;
+                poJob->dfYRatioDstToSrc = dfYRatioDstToSrc;
+                poJob->eWrkDataType = eWrkDataType;
+                poJob->pChunk = pChunk;
+                poJob->pabyChunkNodataMask = pabyChunkNodataMask;
+                poJob->nWidth = nWidth;
+                poJob->nHeight = nHeight;
+                poJob->nChunkYOff = nChunkYOffQueried;
+                poJob->nChunkYSize = nChunkYSizeQueried;
+                poJob->nDstWidth = nDstWidth;
+                poJob->nDstYOff = static_cast<int>(
+                    nDstYOff +
+                    static_cast<GIntBig>(nDstYOff2 - nDstYOff) * iJob /
+                        nJobCount);
+                poJob->nDstYOff2 = static_cast<int>(
+                    nDstYOff +
+                    static_cast<GIntBig>(nDstYOff2 - nDstYOff) * (iJob + 1) /
+                        nJobCount);
+                poJob->poDstBand = poDstBand;
+                poJob->pszResampling = pszResampling;
+                poJob->bHasNoData = bHasNoData;
+                poJob->fNoDataValue = fNoDataValue;
+                poJob->poColorTable = poColorTable;
+                poJob->eSrcDataType = eSrcDataType;
+                poJob->bPropagateNoData = bPropagateNoData;
+
+                if (poJobQueue)
+                {
+                    poJob->oSrcMaskBufferHolder = oSrcMaskBufferHolder;
+                    poJob->oSrcBufferHolder = oSrcBufferHolder;
+                    poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
+                    jobList.emplace_back(std::move(poJob));
+                }
+                else
                 {
-                    eErr = WriteJobData(poJob.get());
+                    JobResampleFunc(poJob.get());
+                    eErr = poJob->eErr;
+                    if (eErr == CE_None)
+                    {
+                        eErr = WriteJobData(poJob.get());
+                    }
                 }
             }
         }
@@ -4799,6 +4993,508 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
     return eErr;
 }
 
+/************************************************************************/
+/*                   GDALCascadingOverviewsBuilder                      */
+/************************************************************************/
+
+namespace
+{
+
+// Computes all the overview levels with a single read of the source bands.
+// Each level is computed, strip after strip, from a window of rows of the
+// previous level kept in memory (and also written to the overview bands),
+// instead of reading back the previous overview level once it has been
+// completely written. This is only valid if the overview bands store
+// exactly the values that are written to them.
+class GDALCascadingOverviewsBuilder
+{
+    struct Level
+    {
+        GDALRasterBand *const *papoSrcBands = nullptr;  // only for level 0
+        int nSrcWidth = 0;
+        int nSrcHeight = 0;
+        int nDstWidth = 0;
+        int nDstHeight = 0;
+        int nDstChunkYSize = 0;
+        double dfXRatioDstToSrc = 0;
+        double dfYRatioDstToSrc = 0;
+        int nOvrFactor = 1;
+        int nKernelRadiusRows = 0;
+        int nFullResYChunkQueried = 0;
+
+        // Next destination row to compute.
+        int nNextDstYOff = 0;
+
+        // Source buffers of the resampling function (one per band).
+        std::vector<std::vector<GByte>> aabyChunk{};
+        std::vector<std::vector<GByte>> aabyChunkNoDataMask{};
+
+        // Window of the computed rows of this level, used as the source of
+        // the next level. Rows are in the data type of the overview bands.
+        int nWinYOff = 0;
+        int nWinYSize = 0;
+        int nWinCapacity = 0;
+        std::vector<std::vector<GByte>> aabyWin{};
+        std::unique_ptr<GDALDataset> poWinDS{};
+    };
+
+    const int m_nBands;
+    GDALRasterBand *const *const *const m_papapoOverviewBands;
+    const char *const m_pszResampling;
+    const GDALResampleFunction m_pfnResampleFn;
+    const GDALDataType m_eDataType;
+    const GDALDataType m_eWrkDataType;
+    const bool m_bUseNoDataMask;
+    const int *const m_pabHasNoData;
+    const float *const m_pafNoDataValue;
+    const bool m_bPropagateNoData;
+    CPLJobQueue *const m_poJobQueue;
+
+    std::vector<Level> m_aoLevels{};
+
+    GDALProgressFunc m_pfnProgress = nullptr;
+    void *m_pProgressData = nullptr;
+    double m_dfTotalPixelCount = 0;
+    double m_dfCurPixelCount = 0;
+
+    CPLErr ComputeChunk(int iLevel);
+    CPLErr EnsureRowsAvailable(int iLevel, int nYEnd);
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALCascadingOverviewsBuilder)
+
+  public:
+    GDALCascadingOverviewsBuilder(
+        int nBands, GDALRasterBand *const *const *papapoOverviewBands,
+        const char *pszResampling, GDALResampleFunction pfnResampleFn,
+        GDALDataType eDataType, GDALDataType eWrkDataType,
+        bool bUseNoDataMask, const int *pabHasNoData,
+        const float *pafNoDataValue, bool bPropagateNoData,
+        CPLJobQueue *poJobQueue)
+        : m_nBands(nBands), m_papapoOverviewBands(papapoOverviewBands),
+          m_pszResampling(pszResampling), m_pfnResampleFn(pfnResampleFn),
+          m_eDataType(eDataType), m_eWrkDataType(eWrkDataType),
+          m_bUseNoDataMask(bUseNoDataMask), m_pabHasNoData(pabHasNoData),
+          m_pafNoDataValue(pafNoDataValue),
+          m_bPropagateNoData(bPropagateNoData), m_poJobQueue(poJobQueue)
+    {
+    }
+
+    bool Init(GDALRasterBand *const *papoSrcBands, int nOverviews,
+              int nKernelRadius);
+
+    CPLErr Run(double dfTotalPixelCount, GDALProgressFunc pfnProgress,
+               void *pProgressData);
+};
+
+/************************************************************************/
+/*                               Init()                                 */
+/************************************************************************/
+
+// Returns false if the overviews cannot be computed in cascade, or if that
+// would require too much memory.
+bool GDALCascadingOverviewsBuilder::Init(GDALRasterBand *const *papoSrcBands,
+                                         int nOverviews, int nKernelRadius)
+{
+    if (nOverviews < 2 || m_eDataType == GDT_Int64 ||
+        m_eDataType == GDT_UInt64 || papoSrcBands[0]->IsMaskBand())
+    {
+        return false;
+    }
+
+    const int nWrkDataTypeSize = GDALGetDataTypeSizeBytes(m_eWrkDataType);
+    const int nDataTypeSize = GDALGetDataTypeSizeBytes(m_eDataType);
+    double dfMemNeeded = 0;
+    m_aoLevels.resize(nOverviews);
+    for (int iLevel = 0; iLevel < nOverviews; ++iLevel)
+    {
+        Level &oLevel = m_aoLevels[iLevel];
+        GDALRasterBand *poOvrBand = m_papapoOverviewBands[0][iLevel];
+        oLevel.nDstWidth = poOvrBand->GetXSize();
+        oLevel.nDstHeight = poOvrBand->GetYSize();
+        if (iLevel == 0)
+        {
+            oLevel.papoSrcBands = papoSrcBands;
+            oLevel.nSrcWidth = papoSrcBands[0]->GetXSize();
+            oLevel.nSrcHeight = papoSrcBands[0]->GetYSize();
+        }
+        else
+        {
+            // Same condition as in GDALRegenerateOverviewsMultiBand() to
+            // use the previous level as the source.
+            const Level &oPrevLevel = m_aoLevels[iLevel - 1];
+            if (oPrevLevel.nDstWidth <= oLevel.nDstWidth)
+                return false;
+            oLevel.nSrcWidth = oPrevLevel.nDstWidth;
+            oLevel.nSrcHeight = oPrevLevel.nDstHeight;
+        }
+
+        int nDstChunkXSize = 0;
+        poOvrBand->GetBlockSize(&nDstChunkXSize, &oLevel.nDstChunkYSize);
+        oLevel.dfXRatioDstToSrc =
+            static_cast<double>(oLevel.nSrcWidth) / oLevel.nDstWidth;
+        oLevel.dfYRatioDstToSrc =
+            static_cast<double>(oLevel.nSrcHeight) / oLevel.nDstHeight;
+        oLevel.nOvrFactor =
+            std::max(static_cast<int>(0.5 + oLevel.dfXRatioDstToSrc),
+                     static_cast<int>(0.5 + oLevel.dfYRatioDstToSrc));
+        if (oLevel.nOvrFactor == 0)
+            oLevel.nOvrFactor = 1;
+        oLevel.nKernelRadiusRows = nKernelRadius * oLevel.nOvrFactor;
+        const int nFullResYChunk =
+            2 + static_cast<int>(oLevel.nDstChunkYSize *
+                                 oLevel.dfYRatioDstToSrc);
+        oLevel.nFullResYChunkQueried =
+            nFullResYChunk + 2 * oLevel.nKernelRadiusRows;
+
+        dfMemNeeded += static_cast<double>(oLevel.nSrcWidth) *
+                       oLevel.nFullResYChunkQueried * m_nBands *
+                       (nWrkDataTypeSize + (m_bUseNoDataMask ? 1 : 0));
+        dfMemNeeded += static_cast<double>(oLevel.nDstWidth) *
+                       oLevel.nDstChunkYSize * m_nBands * sizeof(double);
+
+        if (iLevel > 0)
+        {
+            Level &oPrevLevel = m_aoLevels[iLevel - 1];
+            oPrevLevel.nWinCapacity =
+                oLevel.nFullResYChunkQueried + oPrevLevel.nDstChunkYSize;
+            dfMemNeeded += static_cast<double>(oPrevLevel.nDstWidth) *
+                           oPrevLevel.nWinCapacity * m_nBands * nDataTypeSize;
+        }
+
+        // The mask of the previous level is derived from its values, so it
+        // must be a nodata mask or no mask at all.
+        if (m_bUseNoDataMask && iLevel + 1 < nOverviews)
+        {
+            for (int iBand = 0; iBand < m_nBands; ++iBand)
+            {
+                const int nMaskFlags =
+                    m_papapoOverviewBands[iBand][iLevel]->GetMaskFlags();
+                if (nMaskFlags != GMF_NODATA && nMaskFlags != GMF_ALL_VALID)
+                    return false;
+            }
+        }
+    }
+
+    if (dfMemNeeded > static_cast<double>(GDALGetCacheMax64()) / 2)
+    {
+        CPLDebug("GDAL",
+                 "Not computing overviews in cascade, as that would require "
+                 "%.0f MB of RAM",
+                 dfMemNeeded / (1024 * 1024));
+        return false;
+    }
+
+    for (int iLevel = 0; iLevel < nOverviews; ++iLevel)
+    {
+        Level &oLevel = m_aoLevels[iLevel];
+        try
+        {
+            const size_t nChunkPixels =
+                static_cast<size_t>(oLevel.nSrcWidth) *
+                oLevel.nFullResYChunkQueried;
+            oLevel.aabyChunk.resize(m_nBands);
+            if (m_bUseNoDataMask)
+                oLevel.aabyChunkNoDataMask.resize(m_nBands);
+            for (int iBand = 0; iBand < m_nBands; ++iBand)
+            {
+                oLevel.aabyChunk[iBand].resize(nChunkPixels *
+                                               nWrkDataTypeSize);
+                if (m_bUseNoDataMask)
+                    oLevel.aabyChunkNoDataMask[iBand].resize(nChunkPixels);
+            }
+            if (oLevel.nWinCapacity > 0)
+            {
+                oLevel.aabyWin.resize(m_nBands);
+                for (int iBand = 0; iBand < m_nBands; ++iBand)
+                {
+                    oLevel.aabyWin[iBand].resize(
+                        static_cast<size_t>(oLevel.nDstWidth) *
+                        oLevel.nWinCapacity * nDataTypeSize);
+                }
+            }
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate buffers for cascading overviews");
+            return false;
+        }
+
+        if (oLevel.nWinCapacity > 0)
+        {
+            // Wrap the window into a MEM dataset, to read it (and its nodata
+            // mask) as the overview band would be read.
+            MEMDataset *poMEMDS =
+                MEMDataset::Create("", oLevel.nDstWidth, oLevel.nWinCapacity,
+                                   0, m_eDataType, nullptr);
+            oLevel.poWinDS.reset(poMEMDS);
+            for (int iBand = 0; iBand < m_nBands; ++iBand)
+            {
+                GDALRasterBandH hMEMBand = MEMCreateRasterBandEx(
+                    poMEMDS, iBand + 1, oLevel.aabyWin[iBand].data(),
+                    m_eDataType, 0, 0, false);
+                poMEMDS->AddMEMBand(hMEMBand);
+                int bHasNoData = FALSE;
+                const double dfNoData =
+                    m_papapoOverviewBands[iBand][iLevel]->GetNoDataValue(
+                        &bHasNoData);
+                if (bHasNoData)
+                {
+                    oLevel.poWinDS->GetRasterBand(iBand + 1)->SetNoDataValue(
+                        dfNoData);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                        EnsureRowsAvailable()                         */
+/************************************************************************/
+
+// Compute rows of level iLevel until its window reaches row nYEnd.
+CPLErr GDALCascadingOverviewsBuilder::EnsureRowsAvailable(int iLevel,
+                                                          int nYEnd)
+{
+    Level &oLevel = m_aoLevels[iLevel];
+    CPLErr eErr = CE_None;
+    while (eErr == CE_None && oLevel.nWinYOff + oLevel.nWinYSize < nYEnd &&
+           oLevel.nNextDstYOff < oLevel.nDstHeight)
+    {
+        eErr = ComputeChunk(iLevel);
+    }
+    return eErr;
+}
+
+/************************************************************************/
+/*                            ComputeChunk()                            */
+/************************************************************************/
+
+// Compute the next strip of rows of level iLevel.
+CPLErr GDALCascadingOverviewsBuilder::ComputeChunk(int iLevel)
+{
+    Level &oLevel = m_aoLevels[iLevel];
+
+    const int nDstYOff = oLevel.nNextDstYOff;
+    const int nDstYCount =
+        std::min(oLevel.nDstChunkYSize, oLevel.nDstHeight - nDstYOff);
+    oLevel.nNextDstYOff += nDstYCount;
+
+    // Same source window computation as in
+    // GDALRegenerateOverviewsMultiBand().
+    const int nChunkYOff =
+        static_cast<int>(nDstYOff * oLevel.dfYRatioDstToSrc);
+    int nChunkYOff2 = static_cast<int>(
+        ceil((nDstYOff + nDstYCount) * oLevel.dfYRatioDstToSrc));
+    if (nChunkYOff2 > oLevel.nSrcHeight ||
+        nDstYOff + nDstYCount == oLevel.nDstHeight)
+        nChunkYOff2 = oLevel.nSrcHeight;
+    const int nYCount = nChunkYOff2 - nChunkYOff;
+
+    int nChunkYOffQueried = nChunkYOff - oLevel.nKernelRadiusRows;
+    int nChunkYSizeQueried = nYCount + 2 * oLevel.nKernelRadiusRows;
+    if (nChunkYOffQueried < 0)
+    {
+        nChunkYSizeQueried += nChunkYOffQueried;
+        nChunkYOffQueried = 0;
+    }
+    if (nChunkYSizeQueried + nChunkYOffQueried > oLevel.nSrcHeight)
+        nChunkYSizeQueried = oLevel.nSrcHeight - nChunkYOffQueried;
+    CPLAssert(nChunkYSizeQueried <= oLevel.nFullResYChunkQueried);
+
+    // Fetch the source rows, either from the source bands, or from the
+    // window of the previous level.
+    CPLErr eErr = CE_None;
+    GDALDataset *poPrevWinDS = nullptr;
+    int nSrcYOff = nChunkYOffQueried;
+    if (iLevel > 0)
+    {
+        Level &oPrevLevel = m_aoLevels[iLevel - 1];
+
+        // Discard the rows that are no longer needed.
+        const int nDiscardedRows = nChunkYOffQueried - oPrevLevel.nWinYOff;
+        CPLAssert(nDiscardedRows >= 0 &&
+                  nDiscardedRows <= oPrevLevel.nWinYSize);
+        if (nDiscardedRows > 0)
+        {
+            const size_t nRowSize =
+                static_cast<size_t>(oPrevLevel.nDstWidth) *
+                GDALGetDataTypeSizeBytes(m_eDataType);
+            for (auto &abyWin : oPrevLevel.aabyWin)
+            {
+                memmove(abyWin.data(),
+                        abyWin.data() + nDiscardedRows * nRowSize,
+                        (oPrevLevel.nWinYSize - nDiscardedRows) * nRowSize);
+            }
+            oPrevLevel.nWinYOff += nDiscardedRows;
+            oPrevLevel.nWinYSize -= nDiscardedRows;
+        }
+
+        eErr = EnsureRowsAvailable(iLevel - 1,
+                                   nChunkYOffQueried + nChunkYSizeQueried);
+        poPrevWinDS = oPrevLevel.poWinDS.get();
+        nSrcYOff -= oPrevLevel.nWinYOff;
+    }
+
+    for (int iBand = 0; iBand < m_nBands && eErr == CE_None; ++iBand)
+    {
+        GDALRasterBand *poSrcBand = poPrevWinDS
+                                        ? poPrevWinDS->GetRasterBand(iBand + 1)
+                                        : oLevel.papoSrcBands[iBand];
+        eErr = poSrcBand->RasterIO(
+            GF_Read, 0, nSrcYOff, oLevel.nSrcWidth, nChunkYSizeQueried,
+            oLevel.aabyChunk[iBand].data(), oLevel.nSrcWidth,
+            nChunkYSizeQueried, m_eWrkDataType, 0, 0, nullptr);
+        if (m_bUseNoDataMask && eErr == CE_None)
+        {
+            eErr = poSrcBand->GetMaskBand()->RasterIO(
+                GF_Read, 0, nSrcYOff, oLevel.nSrcWidth, nChunkYSizeQueried,
+                oLevel.aabyChunkNoDataMask[iBand].data(), oLevel.nSrcWidth,
+                nChunkYSizeQueried, GDT_Byte, 0, 0, nullptr);
+        }
+    }
+    if (eErr != CE_None)
+        return eErr;
+
+    // Resample all the bands, possibly in parallel.
+    struct Job
+    {
+        const GDALCascadingOverviewsBuilder *poBuilder = nullptr;
+        const Level *poLevel = nullptr;
+        int iBand = 0;
+        int nChunkYOff = 0;
+        int nChunkYSize = 0;
+        int nDstYOff = 0;
+        int nDstYOff2 = 0;
+        GDALRasterBand *poOverview = nullptr;
+        void *pDstBuffer = nullptr;
+        GDALDataType eDstBufferDataType = GDT_Unknown;
+        CPLErr eErr = CE_Failure;
+    };
+
+    const auto JobResampleFunc = [](void *pData)
+    {
+        Job *psJob = static_cast<Job *>(pData);
+        const auto poBuilder = psJob->poBuilder;
+        const auto poLevel = psJob->poLevel;
+        const int iBand = psJob->iBand;
+        psJob->eErr = poBuilder->m_pfnResampleFn(
+            poLevel->dfXRatioDstToSrc, poLevel->dfYRatioDstToSrc, 0.0, 0.0,
+            poBuilder->m_eWrkDataType, poLevel->aabyChunk[iBand].data(),
+            poBuilder->m_bUseNoDataMask
+                ? poLevel->aabyChunkNoDataMask[iBand].data()
+                : nullptr,
+            0, poLevel->nSrcWidth, psJob->nChunkYOff, psJob->nChunkYSize, 0,
+            poLevel->nDstWidth, psJob->nDstYOff, psJob->nDstYOff2,
+            psJob->poOverview, &(psJob->pDstBuffer),
+            &(psJob->eDstBufferDataType), poBuilder->m_pszResampling,
+            poBuilder->m_pabHasNoData[iBand],
+            poBuilder->m_pafNoDataValue[iBand], nullptr,
+            poBuilder->m_eDataType, poBuilder->m_bPropagateNoData);
+    };
+
+    std::vector<Job> asJobs(m_nBands);
+    for (int iBand = 0; iBand < m_nBands; ++iBand)
+    {
+        Job &sJob = asJobs[iBand];
+        sJob.poBuilder = this;
+        sJob.poLevel = &oLevel;
+        sJob.iBand = iBand;
+        sJob.nChunkYOff = nChunkYOffQueried;
+        sJob.nChunkYSize = nChunkYSizeQueried;
+        sJob.nDstYOff = nDstYOff;
+        sJob.nDstYOff2 = nDstYOff + nDstYCount;
+        sJob.poOverview = m_papapoOverviewBands[iBand][iLevel];
+        if (m_poJobQueue && m_nBands > 1)
+            m_poJobQueue->SubmitJob(JobResampleFunc, &sJob);
+        else
+            JobResampleFunc(&sJob);
+    }
+    if (m_poJobQueue && m_nBands > 1)
+        m_poJobQueue->WaitCompletion();
+
+    // Write the result to the overview bands, and append it to the window
+    // of this level if it is the source of another one.
+    const size_t nDstPixels =
+        static_cast<size_t>(oLevel.nDstWidth) * nDstYCount;
+    const int nDataTypeSize = GDALGetDataTypeSizeBytes(m_eDataType);
+    CPLAssert(oLevel.aabyWin.empty() ||
+              oLevel.nWinYSize + nDstYCount <= oLevel.nWinCapacity);
+    for (int iBand = 0; iBand < m_nBands; ++iBand)
+    {
+        Job &sJob = asJobs[iBand];
+        if (eErr == CE_None)
+            eErr = sJob.eErr;
+        if (eErr == CE_None)
+        {
+            eErr = sJob.poOverview->RasterIO(
+                GF_Write, 0, nDstYOff, oLevel.nDstWidth, nDstYCount,
+                sJob.pDstBuffer, oLevel.nDstWidth, nDstYCount,
+                sJob.eDstBufferDataType, 0, 0, nullptr);
+        }
+        if (eErr == CE_None && !oLevel.aabyWin.empty())
+        {
+            GDALCopyWords64(sJob.pDstBuffer, sJob.eDstBufferDataType,
+                            GDALGetDataTypeSizeBytes(sJob.eDstBufferDataType),
+                            oLevel.aabyWin[iBand].data() +
+                                static_cast<size_t>(oLevel.nWinYSize) *
+                                    oLevel.nDstWidth * nDataTypeSize,
+                            m_eDataType, nDataTypeSize, nDstPixels);
+        }
+        CPLFree(sJob.pDstBuffer);
+    }
+    if (eErr != CE_None)
+        return eErr;
+    oLevel.nWinYSize += nDstYCount;
+
+    m_dfCurPixelCount += static_cast<double>(nYCount) * oLevel.nSrcWidth;
+    if (!m_pfnProgress(m_dfCurPixelCount / m_dfTotalPixelCount, nullptr,
+                       m_pProgressData))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                                Run()                                 */
+/************************************************************************/
+
+CPLErr GDALCascadingOverviewsBuilder::Run(double dfTotalPixelCount,
+                                          GDALProgressFunc pfnProgress,
+                                          void *pProgressData)
+{
+    m_dfTotalPixelCount = dfTotalPixelCount;
+    m_pfnProgress = pfnProgress;
+    m_pProgressData = pProgressData;
+
+    // Pulling the rows of the last level computes all the other ones.
+    const int iLastLevel = static_cast<int>(m_aoLevels.size()) - 1;
+    CPLErr eErr =
+        EnsureRowsAvailable(iLastLevel, m_aoLevels[iLastLevel].nDstHeight);
+
+    for (int iLevel = 0; iLevel <= iLastLevel; ++iLevel)
+    {
+        for (int iBand = 0; iBand < m_nBands; ++iBand)
+        {
+            if (m_papapoOverviewBands[iBand][iLevel]->FlushCache(false) !=
+                    CE_None &&
+                eErr == CE_None)
+            {
+                eErr = CE_Failure;
+            }
+        }
+    }
+
+    return eErr;
+}
+
+}  // namespace
+
 /************************************************************************/
 /*            GDALRegenerateOverviewsMultiBand()                        */
 /************************************************************************/
@@ -4837,6 +5533,15 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
  * to "ALL_CPUS" or a integer value to specify the number of threads to use for
  * overview computation.
  *
+ * Starting with GDAL 3.8, if the CASCADING=YES option is set, and each
+ * overview level is computed from the previous one, all the overview levels
+ * are computed with a single read of the source bands: each level is
+ * computed strip after strip from the rows of the previous level kept in
+ * memory, instead of being read back from the previous overview bands. This
+ * is only valid if the overview bands store exactly the values written to
+ * them (that is not the case for lossy compression methods). Setting the
+ * GDAL_OVR_CASCADING configuration option to NO disables that mode.
+ *
  * @param nBands the number of bands, size of papoSrcBands and size of
  *               first dimension of papapoOverviewBands
  * @param papoSrcBands the list of source bands to downsample
@@ -4849,7 +5554,8 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
  * @param pfnProgress progress report function.
  * @param pProgressData progress function callback data.
  * @param papszOptions (GDAL >= 3.6) NULL terminated list of options as
- *                     key=value pairs, or NULL
+ *                     key=value pairs, or NULL. Starting with GDAL 3.8,
+ *                     CASCADING=YES/NO can be specified.
  * @return CE_None on success or CE_Failure on failure.
  */
 
@@ -4859,8 +5565,6 @@ CPLErr GDALRegenerateOverviewsMultiBand(
     const char *pszResampling, GDALProgressFunc pfnProgress,
     void *pProgressData, CSLConstList papszOptions)
 {
-    CPL_IGNORE_RET_VAL(papszOptions);
-
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
 
@@ -4999,6 +5703,30 @@ CPLErr GDALRegenerateOverviewsMultiBand(
     auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
                                    : std::unique_ptr<CPLJobQueue>(nullptr);
 
+    if (CPLFetchBool(papszOptions, "CASCADING", false) &&
+        CPLTestBool(CPLGetConfigOption("GDAL_OVR_CASCADING", "YES")))
+    {
+        GDALCascadingOverviewsBuilder oBuilder(
+            nBands, papapoOverviewBands, pszResampling, pfnResampleFn,
+            eDataType, eWrkDataType, bUseNoDataMask, pabHasNoData,
+            pafNoDataValue, bPropagateNoData, poJobQueue.get());
+        if (oBuilder.Init(papoSrcBands, nOverviews, nKernelRadius))
+        {
+            CPLDebug("GDAL", "Computing %d overview levels in cascade",
+                     nOverviews);
+            const CPLErr eErr =
+                oBuilder.Run(dfTotalPixelCount, pfnProgress, pProgressData);
+
+            CPLFree(pabHasNoData);
+            CPLFree(pafNoDataValue);
+
+            if (eErr == CE_None)
+                pfnProgress(1.0, nullptr, pProgressData);
+
+            return eErr;
+        }
+    }
+
     // Only configurable for debug / testing
     const int nChunkMaxSize =
         atoi(CPLGetConfigOption("GDAL_OVR_CHUNK_MAX_SIZE", "10485760"));
@@ -4665,6 +4665,33 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
     poSrcDS->AdviseRead(0, 0, nXSize, nYSize, nXSize, nYSize, eDT, nBandCount,
                         nullptr, nullptr);
 
+    // Advise the source of the swath that follows (iBand, iX, iY), once the
+    // current one has been read, so that drivers that prefetch
+    // asynchronously (e.g. GTiff on /vsicurl/) fetch it while the current
+    // swath is being written. iBand < 0 means all bands at once.
+    const auto AdviseReadNextSwath = [&](int iBand, int iX, int iY)
+    {
+        iX += nSwathCols;
+        if (iX >= nXSize)
+        {
+            iX = 0;
+            iY += nSwathLines;
+        }
+        if (iY >= nYSize)
+        {
+            if (iBand < 0 || iBand + 1 == nBandCount)
+                return;
+            iBand++;
+            iY = 0;
+        }
+        int nBand = iBand + 1;
+        const int nThisCols = std::min(nSwathCols, nXSize - iX);
+        const int nThisLines = std::min(nSwathLines, nYSize - iY);
+        poSrcDS->AdviseRead(iX, iY, nThisCols, nThisLines, nThisCols,
+                            nThisLines, eDT, iBand < 0 ? nBandCount : 1,
+                            iBand < 0 ? nullptr : &nBand, nullptr);
+    };
+
     /* ==================================================================== */
     /*      Band oriented (uninterleaved) case.                             */
     /* ==================================================================== */
@@ -4728,6 +4755,9 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
 
                         GDALDestroyScaledProgress(sExtraArg.pProgressData);
 
+                        if (eErr == CE_None)
+                            AdviseReadNextSwath(iBand, iX, iY);
+
                         if (eErr == CE_None)
                             eErr = poDstDS->RasterIO(
                                 GF_Write, iX, iY, nThisCols, nThisLines,
@@ -4808,6 +4838,9 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
 
                     GDALDestroyScaledProgress(sExtraArg.pProgressData);
 
+                    if (eErr == CE_None)
+                        AdviseReadNextSwath(-1, iX, iY);
+
                     if (eErr == CE_None)
                         eErr = poDstDS->RasterIO(
                             GF_Write, iX, iY, nThisCols, nThisLines, pSwathBuf,
@@ -43,6 +43,7 @@
 #endif
 #endif
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 
@@ -70,6 +71,10 @@ static void osr_proj_logger(void * /* user_data */, int level,
 static unsigned g_searchPathGenerationCounter = 0;
 static unsigned g_auxDbPathsGenerationCounter = 0;
 static std::mutex g_oSearchPathMutex;
+// Incremented, under g_oSearchPathMutex, each time one of the above counters
+// is. Allows OSRGetProjTLSContext() to skip taking the mutex when nothing
+// changed, since it is called for each batch of transformed points.
+static std::atomic<unsigned> g_globalGenerationCounter{0};
 static CPLStringList g_aosSearchpaths;
 static CPLStringList g_aosAuxDbPaths;
 #if PROJ_VERSION_MAJOR >= 7
@@ -92,6 +97,8 @@ struct OSRPJContextHolder
 #if PROJ_VERSION_MAJOR >= 7
     unsigned projNetworkEnabledGenerationCounter = 0;
 #endif
+    unsigned globalGenerationCounter = 0;
+    bool bGlobalGenerationCounterValid = false;
     PJ_CONTEXT *context = nullptr;
     OSRProjTLSCache oCache;
 #if !defined(_WIN32)
@@ -151,6 +158,7 @@ OSRPJContextHolder::~OSRPJContextHolder()
 void OSRPJContextHolder::deinit()
 {
     searchPathGenerationCounter = 0;
+    bGlobalGenerationCounterValid = false;
     oCache.clear();
 
     // Destroy context in last
@@ -247,10 +255,16 @@ PJ_CONTEXT *OSRGetProjTLSContext()
     // calls it. The reason is that OSRCleanupTLSContext() calls deinit(),
     // so if reusing the object, we must re-init again.
     l_projContext.init();
+    if (!l_projContext.bGlobalGenerationCounterValid ||
+        l_projContext.globalGenerationCounter !=
+            g_globalGenerationCounter.load(std::memory_order_acquire))
     {
         // If OSRSetPROJSearchPaths() has been called since we created the
         // context, set the new search paths on the context.
         std::lock_guard<std::mutex> oLock(g_oSearchPathMutex);
+        l_projContext.globalGenerationCounter =
+            g_globalGenerationCounter.load(std::memory_order_relaxed);
+        l_projContext.bGlobalGenerationCounterValid = true;
         if (l_projContext.searchPathGenerationCounter !=
             g_searchPathGenerationCounter)
         {
@@ -367,6 +381,7 @@ void OSRSetPROJSearchPaths(const char *const *papszPaths)
 {
     std::lock_guard<std::mutex> oLock(g_oSearchPathMutex);
     g_searchPathGenerationCounter++;
+    g_globalGenerationCounter++;
     g_aosSearchpaths.Assign(CSLDuplicate(papszPaths), true);
 }
 
@@ -413,6 +428,7 @@ void OSRSetPROJAuxDbPaths(const char *const *papszAux)
 {
     std::lock_guard<std::mutex> oLock(g_oSearchPathMutex);
     g_auxDbPathsGenerationCounter++;
+    g_globalGenerationCounter++;
     g_aosAuxDbPaths.Assign(CSLDuplicate(papszAux), true);
 }
 
@@ -455,6 +471,7 @@ void OSRSetPROJEnableNetwork(int enabled)
     {
         g_projNetworkEnabled = enabled;
         g_projNetworkEnabledGenerationCounter++;
+        g_globalGenerationCounter++;
     }
 #else
     if (enabled)
@@ -0,0 +1,168 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Benchmark contention on the global raster block cache.
+ *
+ ******************************************************************************
+ * Copyright (c) 2023, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+// Each thread reads random blocks of its own dataset through
+// GetLockedBlockRef(), with a cache size smaller than the total amount of
+// blocks so that Touch(), Internalize() and FlushCacheBlock() are exercised.
+//
+// Compare for example:
+//   bench_block_cache -threads 32
+//   bench_block_cache -threads 32 --config GDAL_RB_CACHE_SHARDS ALL_CPUS
+
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "gdal_priv.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf("Usage: bench_block_cache [-threads N] [-iters N] [-size N]\n");
+    printf("                         [-blocksize N] [-cache_ratio R]\n");
+    exit(1);
+}
+
+/************************************************************************/
+/*                               main()                                 */
+/************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    int nThreads = CPLGetNumCPUs();
+    int nIters = 1000 * 1000;
+    int nSize = 4096;
+    int nBlockSize = 64;
+    double dfCacheRatio = 0.5;
+    for (int i = 1; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "-threads") && i + 1 < argc)
+            nThreads = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-iters") && i + 1 < argc)
+            nIters = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-size") && i + 1 < argc)
+            nSize = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-blocksize") && i + 1 < argc)
+            nBlockSize = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-cache_ratio") && i + 1 < argc)
+            dfCacheRatio = CPLAtof(argv[++i]);
+        else
+            Usage();
+    }
+    if (nThreads <= 0 || nIters <= 0 || nSize <= 0 || nBlockSize <= 0 ||
+        nBlockSize > nSize)
+        Usage();
+
+    GDALAllRegister();
+
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (!poDrv)
+    {
+        fprintf(stderr, "GTiff driver not available\n");
+        exit(1);
+    }
+
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("TILED", "YES");
+    aosOptions.SetNameValue("BLOCKXSIZE", CPLSPrintf("%d", nBlockSize));
+    aosOptions.SetNameValue("BLOCKYSIZE", CPLSPrintf("%d", nBlockSize));
+    aosOptions.SetNameValue("SPARSE_OK", "YES");
+
+    std::vector<GDALDataset *> apoDS;
+    for (int i = 0; i < nThreads; i++)
+    {
+        apoDS.push_back(poDrv->Create(CPLSPrintf("/vsimem/bench_%d.tif", i),
+                                      nSize, nSize, 1, GDT_Byte,
+                                      aosOptions.List()));
+        if (!apoDS.back())
+            exit(1);
+    }
+
+    const int nBlocksPerRow = DIV_ROUND_UP(nSize, nBlockSize);
+    const GIntBig nTotalBytes = static_cast<GIntBig>(nThreads) *
+                                nBlocksPerRow * nBlocksPerRow * nBlockSize *
+                                nBlockSize;
+    GDALSetCacheMax64(static_cast<GIntBig>(nTotalBytes * dfCacheRatio));
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> aoThreads;
+    for (int i = 0; i < nThreads; i++)
+    {
+        aoThreads.emplace_back(
+            [i, nIters, nBlocksPerRow, &apoDS]()
+            {
+                GDALRasterBand *poBand = apoDS[i]->GetRasterBand(1);
+                unsigned nSeed = static_cast<unsigned>(i) * 2654435761U + 1;
+                for (int iIter = 0; iIter < nIters; iIter++)
+                {
+                    nSeed = nSeed * 1103515245U + 12345U;
+                    const int nBlockX = static_cast<int>(
+                        (nSeed >> 8) % static_cast<unsigned>(nBlocksPerRow));
+                    nSeed = nSeed * 1103515245U + 12345U;
+                    const int nBlockY = static_cast<int>(
+                        (nSeed >> 8) % static_cast<unsigned>(nBlocksPerRow));
+                    GDALRasterBlock *poBlock =
+                        poBand->GetLockedBlockRef(nBlockX, nBlockY);
+                    if (poBlock)
+                        poBlock->DropLock();
+                }
+            });
+    }
+    for (auto &oThread : aoThreads)
+        oThread.join();
+    const double dfElapsed = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+
+    printf("Shards: %s\n", CPLGetConfigOption("GDAL_RB_CACHE_SHARDS", "1"));
+    printf("Threads: %d\n", nThreads);
+    printf("Elapsed: %.3f s\n", dfElapsed);
+    printf("Block accesses per second: %.0f\n",
+           static_cast<double>(nIters) * nThreads / dfElapsed);
+
+    for (int i = 0; i < nThreads; i++)
+    {
+        GDALClose(apoDS[i]);
+        VSIUnlink(CPLSPrintf("/vsimem/bench_%d.tif", i));
+    }
+
+    CSLDestroy(argv);
+    GDALDestroyDriverManager();
+
+    return 0;
+}
@@ -0,0 +1,217 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Benchmark the read paths of local files.
+ *
+ ******************************************************************************
+ * Copyright (c) 2023, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+// Reads a set of random ranges of an existing local file, sorted by offset
+// as when fetching the tiles of a GeoTIFF window, through the different read
+// paths of the local file system handler:
+//   - fread:         stdio based handle, Seek() + Read() for each range
+//   - pread:         pread() based handle (CPL_VSIL_LOCAL_USE_PREAD=YES),
+//                    Seek() + Read() for each range
+//   - pread_multi:   pread() based handle, single ReadMultiRange() call
+//                    served by preadv()/pread()
+//   - io_uring:      pread() based handle, single ReadMultiRange() call
+//                    served by io_uring (only if GDAL is built with liburing
+//                    and the kernel allows it)
+//
+// Results are mostly relevant with a cold page cache, for example by running
+// "sync; echo 3 > /proc/sys/vm/drop_caches" as root before each method:
+//   bench_local_read -method fread my.bin
+//   bench_local_read -method io_uring my.bin
+
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+#include "gdal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf("Usage: bench_local_read [-method "
+           "all|fread|pread|pread_multi|io_uring]\n");
+    printf("                        [-ranges N] [-range_size N] [-iters N]\n");
+    printf("                        [-seed N] filename\n");
+    exit(1);
+}
+
+/************************************************************************/
+/*                               Bench()                                */
+/************************************************************************/
+
+static void Bench(const char *pszMethod, const char *pszFilename,
+                  const std::vector<vsi_l_offset> &anOffsets, int nRangeSize,
+                  int nIters)
+{
+    const bool bFRead = EQUAL(pszMethod, "fread");
+    const bool bMulti =
+        EQUAL(pszMethod, "pread_multi") || EQUAL(pszMethod, "io_uring");
+    CPLSetThreadLocalConfigOption("CPL_VSIL_LOCAL_USE_PREAD",
+                                  bFRead ? "NO" : "YES");
+    CPLSetThreadLocalConfigOption(
+        "CPL_VSIL_LOCAL_USE_IO_URING",
+        EQUAL(pszMethod, "io_uring") ? "YES" : "NO");
+    if (EQUAL(pszMethod, "io_uring") &&
+        !VSIHasOptimizedReadMultiRange(pszFilename))
+    {
+        printf("%-12s: not available\n", pszMethod);
+        return;
+    }
+
+    const int nRanges = static_cast<int>(anOffsets.size());
+    std::vector<GByte> abyData(static_cast<size_t>(nRanges) * nRangeSize);
+    std::vector<void *> apData(nRanges);
+    std::vector<size_t> anSizes(nRanges, nRangeSize);
+    for (int i = 0; i < nRanges; i++)
+        apData[i] = abyData.data() + static_cast<size_t>(i) * nRangeSize;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int iIter = 0; iIter < nIters; iIter++)
+    {
+        VSILFILE *fp = VSIFOpenL(pszFilename, "rb");
+        if (!fp)
+        {
+            fprintf(stderr, "Cannot open %s\n", pszFilename);
+            exit(1);
+        }
+        if (bMulti)
+        {
+            if (VSIFReadMultiRangeL(nRanges, apData.data(), anOffsets.data(),
+                                    anSizes.data(), fp) != 0)
+            {
+                fprintf(stderr, "ReadMultiRange() failed\n");
+                exit(1);
+            }
+        }
+        else
+        {
+            for (int i = 0; i < nRanges; i++)
+            {
+                if (VSIFSeekL(fp, anOffsets[i], SEEK_SET) != 0 ||
+                    VSIFReadL(apData[i], 1, nRangeSize, fp) !=
+                        static_cast<size_t>(nRangeSize))
+                {
+                    fprintf(stderr, "Read() failed\n");
+                    exit(1);
+                }
+            }
+        }
+        VSIFCloseL(fp);
+    }
+    const double dfElapsed = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+
+    CPLSetThreadLocalConfigOption("CPL_VSIL_LOCAL_USE_PREAD", nullptr);
+    CPLSetThreadLocalConfigOption("CPL_VSIL_LOCAL_USE_IO_URING", nullptr);
+
+    printf("%-12s: %.3f s, %.1f MB/s\n", pszMethod, dfElapsed,
+           static_cast<double>(nIters) * nRanges * nRangeSize / dfElapsed /
+               (1024 * 1024));
+}
+
+/************************************************************************/
+/*                               main()                                 */
+/************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    const char *pszMethod = "all";
+    const char *pszFilename = nullptr;
+    int nRanges = 1000;
+    int nRangeSize = 65536;
+    int nIters = 1;
+    int nSeed = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "-method") && i + 1 < argc)
+            pszMethod = argv[++i];
+        else if (EQUAL(argv[i], "-ranges") && i + 1 < argc)
+            nRanges = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-range_size") && i + 1 < argc)
+            nRangeSize = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-iters") && i + 1 < argc)
+            nIters = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-seed") && i + 1 < argc)
+            nSeed = atoi(argv[++i]);
+        else if (argv[i][0] == '-' || pszFilename != nullptr)
+            Usage();
+        else
+            pszFilename = argv[i];
+    }
+    if (pszFilename == nullptr || nRanges <= 0 || nRangeSize <= 0 ||
+        nIters <= 0)
+        Usage();
+
+    VSIStatBufL sStat;
+    if (VSIStatL(pszFilename, &sStat) != 0 ||
+        static_cast<vsi_l_offset>(sStat.st_size) <
+            static_cast<vsi_l_offset>(nRangeSize))
+    {
+        fprintf(stderr, "%s does not exist or is too small\n", pszFilename);
+        exit(1);
+    }
+
+    std::mt19937 oGenerator(nSeed);
+    std::uniform_int_distribution<vsi_l_offset> oDist(
+        0, static_cast<vsi_l_offset>(sStat.st_size) - nRangeSize);
+    std::vector<vsi_l_offset> anOffsets;
+    for (int i = 0; i < nRanges; i++)
+        anOffsets.push_back(oDist(oGenerator));
+    std::sort(anOffsets.begin(), anOffsets.end());
+
+    printf("Ranges: %d x %d bytes\n", nRanges, nRangeSize);
+    const char *const apszMethods[] = {"fread", "pread", "pread_multi",
+                                       "io_uring"};
+    bool bFound = false;
+    for (const char *pszIter : apszMethods)
+    {
+        if (EQUAL(pszMethod, "all") || EQUAL(pszMethod, pszIter))
+        {
+            bFound = true;
+            Bench(pszIter, pszFilename, anOffsets, nRangeSize, nIters);
+        }
+    }
+    if (!bFound)
+        Usage();
+
+    CSLDestroy(argv);
+
+    return 0;
+}
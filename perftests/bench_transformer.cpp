@@ -0,0 +1,227 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Algorithms
+ * Purpose:  Benchmark the throughput of the warping transformers.
+ *
+ ******************************************************************************
+ * Copyright (c) 2023, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+// Transforms target pixel centers, one scanline at a time, back to source
+// pixel/line coordinates as the warper does, and reports the number of points
+// transformed per second. Each thread works on its own clone of the
+// transformer.
+//
+// Compare for example:
+//   bench_transformer -error_threshold 0
+//   bench_transformer -error_threshold 0.125
+//   bench_transformer -threads 8 -t_srs EPSG:3857
+
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "gdal_alg.h"
+#include "gdal_alg_priv.h"
+#include "gdal_priv.h"
+#include "ogr_spatialref.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf("Usage: bench_transformer [-threads N] [-iters N] [-size N]\n");
+    printf("                         [-s_srs srs_def] [-t_srs srs_def]\n");
+    printf("                         [-error_threshold val]\n");
+    exit(1);
+}
+
+/************************************************************************/
+/*                               main()                                 */
+/************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    int nThreads = 1;
+    int nIters = 10;
+    int nSize = 4096;
+    const char *pszSrcSRS = "EPSG:4326";
+    const char *pszDstSRS = "EPSG:32631";
+    double dfErrorThreshold = 0.125;
+    for (int i = 1; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "-threads") && i + 1 < argc)
+            nThreads = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-iters") && i + 1 < argc)
+            nIters = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-size") && i + 1 < argc)
+            nSize = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-s_srs") && i + 1 < argc)
+            pszSrcSRS = argv[++i];
+        else if (EQUAL(argv[i], "-t_srs") && i + 1 < argc)
+            pszDstSRS = argv[++i];
+        else if (EQUAL(argv[i], "-error_threshold") && i + 1 < argc)
+            dfErrorThreshold = CPLAtof(argv[++i]);
+        else
+            Usage();
+    }
+    if (nThreads <= 0 || nIters <= 0 || nSize <= 1 || dfErrorThreshold < 0)
+        Usage();
+
+    GDALAllRegister();
+
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poDrv)
+    {
+        fprintf(stderr, "MEM driver not available\n");
+        exit(1);
+    }
+
+    OGRSpatialReference oSrcSRS;
+    if (oSrcSRS.SetFromUserInput(pszSrcSRS) != OGRERR_NONE)
+        exit(1);
+    oSrcSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+
+    // 6 x 6 degrees area around (3E, 43N) in the source CRS.
+    double adfSrcGeoTransform[6] = {0.0, 6.0 / nSize, 0.0,
+                                    46.0, 0.0, -6.0 / nSize};
+    if (!oSrcSRS.IsGeographic())
+    {
+        OGRSpatialReference oWGS84;
+        oWGS84.SetFromUserInput(SRS_WKT_WGS84_LAT_LONG);
+        oWGS84.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+        auto poCT = OGRCreateCoordinateTransformation(&oWGS84, &oSrcSRS);
+        if (!poCT)
+            exit(1);
+        double adfX[2] = {0.0, 6.0};
+        double adfY[2] = {46.0, 40.0};
+        if (!poCT->Transform(2, adfX, adfY))
+            exit(1);
+        delete poCT;
+        adfSrcGeoTransform[0] = adfX[0];
+        adfSrcGeoTransform[1] = (adfX[1] - adfX[0]) / nSize;
+        adfSrcGeoTransform[3] = adfY[0];
+        adfSrcGeoTransform[5] = (adfY[1] - adfY[0]) / nSize;
+    }
+
+    auto poSrcDS = poDrv->Create("", nSize, nSize, 0, GDT_Byte, nullptr);
+    poSrcDS->SetGeoTransform(adfSrcGeoTransform);
+    poSrcDS->SetSpatialRef(&oSrcSRS);
+
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("DST_SRS", pszDstSRS);
+    void *hTransformArg = GDALCreateGenImgProjTransformer2(
+        GDALDataset::ToHandle(poSrcDS), nullptr, aosOptions.List());
+    if (!hTransformArg)
+        exit(1);
+
+    double adfDstGeoTransform[6] = {};
+    int nDstXSize = 0;
+    int nDstYSize = 0;
+    if (GDALSuggestedWarpOutput(GDALDataset::ToHandle(poSrcDS),
+                                GDALGenImgProjTransform, hTransformArg,
+                                adfDstGeoTransform, &nDstXSize,
+                                &nDstYSize) != CE_None)
+        exit(1);
+    GDALSetGenImgProjTransformerDstGeoTransform(hTransformArg,
+                                                adfDstGeoTransform);
+
+    GDALTransformerFunc pfnTransformer = GDALGenImgProjTransform;
+    if (dfErrorThreshold > 0)
+    {
+        hTransformArg = GDALCreateApproxTransformer(
+            GDALGenImgProjTransform, hTransformArg, dfErrorThreshold);
+        GDALApproxTransformerOwnsSubtransformer(hTransformArg, TRUE);
+        pfnTransformer = GDALApproxTransform;
+    }
+
+    std::vector<void *> ahTransformArgs;
+    for (int i = 0; i < nThreads; i++)
+    {
+        ahTransformArgs.push_back(i == 0 ? hTransformArg
+                                         : GDALCloneTransformer(hTransformArg));
+        if (!ahTransformArgs.back())
+            exit(1);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> aoThreads;
+    for (int i = 0; i < nThreads; i++)
+    {
+        aoThreads.emplace_back(
+            [i, nIters, nDstXSize, nDstYSize, pfnTransformer,
+             &ahTransformArgs]()
+            {
+                std::vector<double> adfX(nDstXSize);
+                std::vector<double> adfY(nDstXSize);
+                std::vector<double> adfZ(nDstXSize);
+                std::vector<int> anSuccess(nDstXSize);
+                for (int iIter = 0; iIter < nIters; iIter++)
+                {
+                    for (int iLine = 0; iLine < nDstYSize; iLine++)
+                    {
+                        for (int iPixel = 0; iPixel < nDstXSize; iPixel++)
+                        {
+                            adfX[iPixel] = iPixel + 0.5;
+                            adfY[iPixel] = iLine + 0.5;
+                            adfZ[iPixel] = 0.0;
+                        }
+                        pfnTransformer(ahTransformArgs[i], TRUE, nDstXSize,
+                                       adfX.data(), adfY.data(), adfZ.data(),
+                                       anSuccess.data());
+                    }
+                }
+            });
+    }
+    for (auto &oThread : aoThreads)
+        oThread.join();
+    const double dfElapsed = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+
+    printf("Transformer: %s\n", dfErrorThreshold > 0
+                                    ? "GDALApproxTransform"
+                                    : "GDALGenImgProjTransform");
+    printf("Threads: %d\n", nThreads);
+    printf("Elapsed: %.3f s\n", dfElapsed);
+    printf("Points per second: %.0f\n", static_cast<double>(nIters) *
+                                            nDstXSize * nDstYSize * nThreads /
+                                            dfElapsed);
+
+    for (void *hArg : ahTransformArgs)
+        GDALDestroyTransformer(hArg);
+    GDALClose(GDALDataset::ToHandle(poSrcDS));
+
+    CSLDestroy(argv);
+    GDALDestroyDriverManager();
+
+    return 0;
+}
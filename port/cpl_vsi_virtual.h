@@ -84,6 +84,46 @@ class CPL_DLL VSIVirtualHandle
     virtual size_t PRead(void *pBuffer, size_t nSize,
                          vsi_l_offset nOffset) const;
 
+    /** Hint that the specified ranges will be read soon.
+     *
+     * Implementations may start fetching them in the background, so that a
+     * later Read(), PRead() or ReadMultiRange() is served without waiting.
+     * This method must not block on I/O. The default implementation does
+     * nothing.
+     *
+     * @since GDAL 3.8
+     */
+    virtual void AdviseRead(CPL_UNUSED int nRanges,
+                            CPL_UNUSED const vsi_l_offset *panOffsets,
+                            CPL_UNUSED const size_t *panSizes)
+    {
+    }
+
+    /** Return the maximum number of bytes that AdviseRead() can handle
+     * in a single call, or 0 if AdviseRead() is a no-op.
+     *
+     * @since GDAL 3.8
+     */
+    virtual size_t GetAdviseReadTotalBytesLimit() const
+    {
+        return 0;
+    }
+
+    /** Return whether ReadMultiRange() fetches the ranges more efficiently
+     * than reading them one after the other.
+     *
+     * Contrary to VSIHasOptimizedReadMultiRange(), that some drivers use to
+     * detect network file systems, this is a property of the handle: for
+     * example, local files opened with CPL_VSIL_LOCAL_USE_PREAD=YES return
+     * true when their ranges are read through io_uring.
+     *
+     * @since GDAL 3.8
+     */
+    virtual bool HasOptimizedReadMultiRange() const
+    {
+        return false;
+    }
+
     // NOTE: when adding new methods, besides the "actual" implementations,
     // also consider the VSICachedFile one.
 
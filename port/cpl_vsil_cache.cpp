@@ -108,6 +108,22 @@ class VSICachedFile final : public VSIVirtualHandle
     {
         return m_poBase->PRead(pBuffer, nSize, nOffset);
     }
+
+    void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                    const size_t *panSizes) override
+    {
+        m_poBase->AdviseRead(nRanges, panOffsets, panSizes);
+    }
+
+    size_t GetAdviseReadTotalBytesLimit() const override
+    {
+        return m_poBase->GetAdviseReadTotalBytesLimit();
+    }
+
+    bool HasOptimizedReadMultiRange() const override
+    {
+        return m_poBase->HasOptimizedReadMultiRange();
+    }
 };
 
 /************************************************************************/
@@ -32,9 +32,14 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <ctime>
+#include <cstdlib>
+#include <limits>
 #include <set>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "cpl_aws.h"
 #include "cpl_json.h"
@@ -47,6 +52,13 @@
 #include "cpl_vsi_virtual.h"
 #include "cpl_http.h"
 #include "cpl_mem_cache.h"
+#include "cpl_sha256.h"
+
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
 
 #ifndef S_IRUSR
 #define S_IRUSR 00400
@@ -444,6 +456,7 @@ VSICurlHandle::VSICurlHandle(VSICurlFilesystemHandlerBase *poFSIn,
 
 VSICurlHandle::~VSICurlHandle()
 {
+    ReapAdviseReadJobs(true);
     if (!m_bCached)
     {
         poFS->InvalidateCachedData(m_pszURL);
@@ -882,6 +895,25 @@ void VSICURLResetHeaderAndWriterFunctions(CURL *hCurlHandle)
                                VSICurlDummyWriteFunc);
 }
 
+/************************************************************************/
+/*                          VSICurlGetETag()                            */
+/************************************************************************/
+
+// Returns the ETag of a response, or an empty string if it has none.
+static std::string VSICurlGetETag(const char *pszHeaders)
+{
+    const char *pszETag =
+        pszHeaders ? strstr(pszHeaders, "ETag: \"") : nullptr;
+    if (pszETag)
+    {
+        pszETag += strlen("ETag: \"");
+        const char *pszEndOfETag = strchr(pszETag, '"');
+        if (pszEndOfETag)
+            return std::string(pszETag, pszEndOfETag - pszETag);
+    }
+    return std::string();
+}
+
 /************************************************************************/
 /*                        Iso8601ToUnixTime()                           */
 /************************************************************************/
@@ -1059,6 +1091,9 @@ vsi_l_offset VSICurlHandle::GetFileSizeOrHeaders(bool bSetError,
     bool bS3LikeRedirect = false;
     int nRetryCount = 0;
     double dfRetryDelay = m_dfRetryDelay;
+    bool bCacheFirstBytes = false;
+    std::string osFirstBytes;
+    std::string osFirstBytesETag;
 
 retry:
     CURL *hCurlHandle = curl_easy_init();
@@ -1309,17 +1344,10 @@ retry:
         if (sWriteFuncHeaderData.pBuffer != nullptr &&
             (response_code == 200 || response_code == 206))
         {
-            const char *pzETag =
-                strstr(sWriteFuncHeaderData.pBuffer, "ETag: \"");
-            if (pzETag)
-            {
-                pzETag += strlen("ETag: \"");
-                const char *pszEndOfETag = strchr(pzETag, '"');
-                if (pszEndOfETag)
-                {
-                    oFileProp.ETag.assign(pzETag, pszEndOfETag - pzETag);
-                }
-            }
+            const std::string osETag =
+                VSICurlGetETag(sWriteFuncHeaderData.pBuffer);
+            if (!osETag.empty())
+                oFileProp.ETag = osETag;
 
             // Azure Data Lake Storage
             const char *pszPermissions =
@@ -1391,19 +1419,16 @@ retry:
                         CPLAtoGIntBig(pszContentRange + 1));
                 }
 
-                // Add first bytes to cache
-                if (sWriteFuncData.pBuffer != nullptr)
+                // First bytes are added to the cache once the file
+                // properties are, so that the disk cache can key them.
+                if (sWriteFuncData.pBuffer != nullptr &&
+                    oFileProp.eExists == EXIST_YES)
                 {
-                    size_t nOffset = 0;
-                    while (nOffset < sWriteFuncData.nSize)
-                    {
-                        const size_t nToCache =
-                            std::min<size_t>(sWriteFuncData.nSize - nOffset,
-                                             knDOWNLOAD_CHUNK_SIZE);
-                        poFS->AddRegion(m_pszURL, nOffset, nToCache,
-                                        sWriteFuncData.pBuffer + nOffset);
-                        nOffset += nToCache;
-                    }
+                    osFirstBytes.assign(sWriteFuncData.pBuffer,
+                                        sWriteFuncData.nSize);
+                    osFirstBytesETag =
+                        VSICurlGetETag(sWriteFuncHeaderData.pBuffer);
+                    bCacheFirstBytes = true;
                 }
             }
         }
@@ -1539,6 +1564,20 @@ retry:
         oFileProp.mTime = mtime;
     poFS->SetCachedFileProp(m_pszURL, oFileProp);
 
+    if (bCacheFirstBytes)
+    {
+        size_t nOffset = 0;
+        while (nOffset < osFirstBytes.size())
+        {
+            const size_t nToCache = std::min<size_t>(
+                osFirstBytes.size() - nOffset, knDOWNLOAD_CHUNK_SIZE);
+            poFS->AddRegion(m_pszURL, nOffset, nToCache,
+                            osFirstBytes.data() + nOffset,
+                            osFirstBytesETag.c_str());
+            nOffset += nToCache;
+        }
+    }
+
     return oFileProp.fileSize;
 }
 
@@ -1890,8 +1929,9 @@ retry:
         }
     }
 
-    DownloadRegionPostProcess(startOffset, nBlocks, sWriteFuncData.pBuffer,
-                              sWriteFuncData.nSize);
+    DownloadRegionPostProcess(
+        startOffset, nBlocks, sWriteFuncData.pBuffer, sWriteFuncData.nSize,
+        VSICurlGetETag(sWriteFuncHeaderData.pBuffer).c_str());
 
     std::string osRet;
     osRet.assign(sWriteFuncData.pBuffer, sWriteFuncData.nSize);
@@ -1960,7 +2000,8 @@ void VSICurlHandle::UpdateRedirectInfo(
 
 void VSICurlHandle::DownloadRegionPostProcess(const vsi_l_offset startOffset,
                                               const int nBlocks,
-                                              const char *pBuffer, size_t nSize)
+                                              const char *pBuffer, size_t nSize,
+                                              const char *pszETag)
 {
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
     lastDownloadedOffset = startOffset + nBlocks * knDOWNLOAD_CHUNK_SIZE;
@@ -1987,7 +2028,7 @@ void VSICurlHandle::DownloadRegionPostProcess(const vsi_l_offset startOffset,
 #endif
         const size_t nChunkSize =
             std::min(static_cast<size_t>(knDOWNLOAD_CHUNK_SIZE), nSize);
-        poFS->AddRegion(m_pszURL, l_startOffset, nChunkSize, pBuffer);
+        poFS->AddRegion(m_pszURL, l_startOffset, nChunkSize, pBuffer, pszETag);
         l_startOffset += nChunkSize;
         pBuffer += nChunkSize;
         nSize -= nChunkSize;
@@ -2016,6 +2057,18 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
              static_cast<int>(curOffset), static_cast<int>(nBufferRequestSize));
 #endif
 
+    // Split large reads in several concurrent requests.
+    const size_t nParallelRead =
+        ReadParallel(pBuffer, nBufferRequestSize, curOffset);
+    if (nParallelRead > 0)
+    {
+        const size_t ret = nParallelRead / nSize;
+        if (ret != nMemb)
+            bEOF = true;
+        curOffset += nParallelRead;
+        return ret;
+    }
+
     vsi_l_offset iterOffset = curOffset;
     const int knMAX_REGIONS = GetMaxRegions();
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
@@ -2040,10 +2093,23 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
         std::string osRegion;
         std::shared_ptr<std::string> psRegion =
             poFS->GetRegion(m_pszURL, nOffsetToDownload);
+        std::shared_ptr<AdviseReadRange> poAdvisedRange;
         if (psRegion != nullptr)
         {
             osRegion = *psRegion;
         }
+        else if ((poAdvisedRange = GetAdvisedRange(nOffsetToDownload,
+                                                   true)) != nullptr)
+        {
+            const size_t nPos = static_cast<size_t>(
+                nOffsetToDownload - poAdvisedRange->nStartOffset);
+            osRegion.assign(
+                reinterpret_cast<const char *>(poAdvisedRange->abyData.data()) +
+                    nPos,
+                std::min(static_cast<size_t>(knDOWNLOAD_CHUNK_SIZE),
+                         poAdvisedRange->nSize - nPos));
+            ConsumeAdvisedRange(poAdvisedRange, osRegion.size());
+        }
         else
         {
             if (nOffsetToDownload == lastDownloadedOffset)
@@ -2073,14 +2139,16 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
             if (nBlocksToDownload < nMinBlocksToDownload)
                 nBlocksToDownload = nMinBlocksToDownload;
 
-            // Avoid reading already cached data.
+            // Avoid reading already cached data, or data being fetched by
+            // AdviseRead().
             // Note: this might get evicted if concurrent reads are done, but
             // this should not cause bugs. Just missed optimization.
             for (int i = 1; i < nBlocksToDownload; i++)
             {
-                if (poFS->GetRegion(m_pszURL, nOffsetToDownload +
-                                                  i * knDOWNLOAD_CHUNK_SIZE) !=
-                    nullptr)
+                const vsi_l_offset nBlockOffset =
+                    nOffsetToDownload + i * knDOWNLOAD_CHUNK_SIZE;
+                if (poFS->GetRegion(m_pszURL, nBlockOffset) != nullptr ||
+                    GetAdvisedRange(nBlockOffset, false) != nullptr)
                 {
                     nBlocksToDownload = i;
                     break;
@@ -2135,6 +2203,96 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
     return ret;
 }
 
+/************************************************************************/
+/*                            ReadParallel()                            */
+/************************************************************************/
+
+// Reads a large contiguous range with several concurrent range requests, as
+// the throughput of a single connection is often much lower than what an
+// object store can deliver in aggregate. Returns the number of bytes read,
+// or 0 if the read is not eligible or failed, in which case the caller must
+// use the regular code path.
+size_t VSICurlHandle::ReadParallel(void *pBuffer, size_t nSize,
+                                   vsi_l_offset nOffset)
+{
+    const int nMaxRequests = atoi(
+        CPLGetConfigOption("CPL_VSIL_CURL_PARALLEL_READ_REQUESTS", "4"));
+    const GIntBig nMinPartSize = CPLAtoGIntBig(CPLGetConfigOption(
+        "CPL_VSIL_CURL_PARALLEL_READ_CHUNK_SIZE", "4194304"));
+    if (nMaxRequests <= 1 || nMinPartSize <= 0 ||
+        nSize < 2 * static_cast<GUIntBig>(nMinPartSize))
+    {
+        return 0;
+    }
+
+    poFS->GetCachedFileProp(m_pszURL, oFileProp);
+    if (!oFileProp.bHasComputedFileSize || nOffset >= oFileProp.fileSize)
+        return 0;
+    nSize = static_cast<size_t>(
+        std::min<vsi_l_offset>(nSize, oFileProp.fileSize - nOffset));
+    const int nParts = static_cast<int>(std::min<GUIntBig>(
+        nMaxRequests, nSize / static_cast<GUIntBig>(nMinPartSize)));
+    if (nParts < 2)
+        return 0;
+
+    // Leave reads that start in cached or prefetched data to the regular
+    // code path.
+    const int nChunkSize = VSICURLGetDownloadChunkSize();
+    if (GetAdvisedRange(nOffset, false) != nullptr ||
+        poFS->GetRegion(m_pszURL, (nOffset / nChunkSize) * nChunkSize) !=
+            nullptr)
+    {
+        return 0;
+    }
+
+    CPLString osURL;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        ManagePlanetaryComputerSigning();
+        bool bHasExpired = false;
+        osURL = GetRedirectURLIfValid(bHasExpired);
+        if (bHasExpired)
+            return 0;
+    }
+
+    // Split in parts of (nearly) equal size, multiple of the chunk size.
+    size_t nPartSize = (nSize + nParts - 1) / nParts;
+    nPartSize = ((nPartSize + nChunkSize - 1) / nChunkSize) * nChunkSize;
+    std::vector<void *> apData;
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    for (size_t nPos = 0; nPos < nSize; nPos += nPartSize)
+    {
+        apData.push_back(static_cast<GByte *>(pBuffer) + nPos);
+        anOffsets.push_back(nOffset + nPos);
+        anSizes.push_back(std::min(nPartSize, nSize - nPos));
+    }
+
+    if (ENABLE_DEBUG)
+        CPLDebug(poFS->GetDebugKey(),
+                 "Reading " CPL_FRMT_GUIB " bytes at offset " CPL_FRMT_GUIB
+                 " with %d parallel requests",
+                 static_cast<GUIntBig>(nSize), nOffset,
+                 static_cast<int>(apData.size()));
+
+    int nRet;
+    {
+        // Errors are not fatal, as we retry with the regular code path.
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        nRet = ReadMultiRangeParallel(static_cast<int>(apData.size()),
+                                      apData.data(), anOffsets.data(),
+                                      anSizes.data(), osURL, false);
+    }
+    if (nRet != 0)
+    {
+        CPLDebug(poFS->GetDebugKey(),
+                 "Parallel read failed. Retrying with a single request");
+        return 0;
+    }
+    return nSize;
+}
+
 /************************************************************************/
 /*                           ReadMultiRange()                           */
 /************************************************************************/
@@ -2150,6 +2308,32 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
     if (oFileProp.eExists == EXIST_NO)
         return -1;
 
+    if (HasAdvisedRanges())
+    {
+        // Serve what AdviseRead() has fetched, and only request the rest.
+        std::vector<void *> apRemainingData;
+        std::vector<vsi_l_offset> anRemainingOffsets;
+        std::vector<size_t> anRemainingSizes;
+        for (int i = 0; i < nRanges; ++i)
+        {
+            if (!ReadFromAdvisedRanges(ppData[i], panSizes[i], panOffsets[i]))
+            {
+                apRemainingData.push_back(ppData[i]);
+                anRemainingOffsets.push_back(panOffsets[i]);
+                anRemainingSizes.push_back(panSizes[i]);
+            }
+        }
+        if (apRemainingData.empty())
+            return 0;
+        if (static_cast<int>(apRemainingData.size()) < nRanges)
+        {
+            return ReadMultiRange(static_cast<int>(apRemainingData.size()),
+                                  apRemainingData.data(),
+                                  anRemainingOffsets.data(),
+                                  anRemainingSizes.data());
+        }
+    }
+
     NetworkStatisticsFileSystem oContextFS(poFS->GetFSPrefix());
     NetworkStatisticsFile oContextFile(m_osFilename);
     NetworkStatisticsAction oContextAction("ReadMultiRange");
@@ -2178,6 +2362,26 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
                                                 panSizes);
     }
 
+    const bool bMergeConsecutiveRanges = CPLTestBool(
+        CPLGetConfigOption("GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
+
+    return ReadMultiRangeParallel(nRanges, ppData, panOffsets, panSizes, osURL,
+                                  bMergeConsecutiveRanges);
+}
+
+/************************************************************************/
+/*                       ReadMultiRangeParallel()                       */
+/************************************************************************/
+
+// Issues one range request per range (or per group of consecutive ranges if
+// bMergeConsecutiveRanges) through the curl multi interface.
+int VSICurlHandle::ReadMultiRangeParallel(int const nRanges,
+                                          void **const ppData,
+                                          const vsi_l_offset *const panOffsets,
+                                          const size_t *const panSizes,
+                                          const CPLString &osURL,
+                                          bool bMergeConsecutiveRanges)
+{
     CURLM *hMultiHandle = poFS->GetCurlMultiHandleFor(osURL);
 #ifdef CURLPIPE_MULTIPLEX
     // Enable HTTP/2 multiplexing (ignored if an older version of HTTP is
@@ -2205,9 +2409,6 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
     };
     std::vector<CurlErrBuffer> asCurlErrors(nRanges);
 
-    const bool bMergeConsecutiveRanges = CPLTestBool(
-        CPLGetConfigOption("GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
-
     for (int i = 0, iRequest = 0; i < nRanges;)
     {
         size_t nSize = 0;
@@ -2789,6 +2990,9 @@ size_t VSICurlHandle::PRead(void *pBuffer, size_t nSize,
     if (oFileProp.eExists == EXIST_NO)
         return static_cast<size_t>(-1);
 
+    if (ReadFromAdvisedRanges(pBuffer, nSize, nOffset))
+        return nSize;
+
     NetworkStatisticsFileSystem oContextFS(poFS->GetFSPrefix());
     NetworkStatisticsFile oContextFile(m_osFilename);
     NetworkStatisticsAction oContextAction("PRead");
@@ -2915,6 +3119,541 @@ size_t VSICurlHandle::PRead(void *pBuffer, size_t nSize,
     return nRet;
 }
 
+/************************************************************************/
+/*                           AdviseReadJob                              */
+/************************************************************************/
+
+struct VSICurlHandle::AdviseReadJob
+{
+    struct Request
+    {
+        CURL *hCurlHandle = nullptr;
+        struct curl_slist *headers = nullptr;
+        WriteFuncStruct sWriteFuncData{};
+        WriteFuncStruct sWriteFuncHeaderData{};
+        std::array<char, CURL_ERROR_SIZE + 1> szCurlErrBuf{};
+        std::shared_ptr<AdviseReadRange> poRange{};
+        bool bFinished = false;
+    };
+
+    VSICurlFilesystemHandlerBase *poFS = nullptr;
+    std::string osFSPrefix{};
+    std::string osFilename{};
+    std::string osCacheURL{};  // key of the region cache, ie m_pszURL
+    int nChunkSize = 0;
+    bool bMultiplex = true;
+    std::atomic<bool> bStop{false};
+    std::vector<std::unique_ptr<Request>> apoRequests{};
+    CPLJoinableThread *hThread = nullptr;
+    std::atomic<bool> bThreadFinished{false};
+
+    void FinishRequest(Request &oReq);
+
+    ~AdviseReadJob()
+    {
+        for (auto &poReq : apoRequests)
+        {
+            VSICURLResetHeaderAndWriterFunctions(poReq->hCurlHandle);
+            curl_easy_cleanup(poReq->hCurlHandle);
+            CPLFree(poReq->sWriteFuncData.pBuffer);
+            CPLFree(poReq->sWriteFuncHeaderData.pBuffer);
+            curl_slist_free_all(poReq->headers);
+        }
+    }
+};
+
+/************************************************************************/
+/*                          FinishRequest()                             */
+/************************************************************************/
+
+// Publishes the result of a transfer to the region cache and to the threads
+// waiting for it. A failed transfer is published without data, and readers
+// then fall back to downloading the range themselves.
+void VSICurlHandle::AdviseReadJob::FinishRequest(Request &oReq)
+{
+    oReq.bFinished = true;
+    AdviseReadRange *poRange = oReq.poRange.get();
+
+    long response_code = 0;
+    curl_easy_getinfo(oReq.hCurlHandle, CURLINFO_HTTP_CODE, &response_code);
+    const bool bOK = (response_code == 206 || response_code == 225) &&
+                     oReq.sWriteFuncData.nSize == poRange->nSize;
+    if (bOK)
+    {
+        NetworkStatisticsLogger::LogGET(oReq.sWriteFuncData.nSize);
+        const std::string osETag(
+            VSICurlGetETag(oReq.sWriteFuncHeaderData.pBuffer));
+        for (size_t nPos = 0; nPos < poRange->nSize; nPos += nChunkSize)
+        {
+            poFS->AddRegion(osCacheURL.c_str(), poRange->nStartOffset + nPos,
+                            std::min(static_cast<size_t>(nChunkSize),
+                                     poRange->nSize - nPos),
+                            oReq.sWriteFuncData.pBuffer + nPos, osETag.c_str());
+        }
+    }
+    else if (ENABLE_DEBUG)
+    {
+        CPLDebug(poFS->GetDebugKey(),
+                 "AdviseRead(%s): request at offset " CPL_FRMT_GUIB
+                 " failed with response_code=%d, msg=%s",
+                 osFilename.c_str(), poRange->nStartOffset,
+                 static_cast<int>(response_code), &oReq.szCurlErrBuf[0]);
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(poRange->oMutex);
+        if (bOK)
+        {
+            poRange->abyData.assign(
+                reinterpret_cast<const GByte *>(oReq.sWriteFuncData.pBuffer),
+                reinterpret_cast<const GByte *>(oReq.sWriteFuncData.pBuffer) +
+                    poRange->nSize);
+        }
+        poRange->bDone = true;
+    }
+    poRange->oCV.notify_all();
+
+    CPLFree(oReq.sWriteFuncData.pBuffer);
+    oReq.sWriteFuncData.pBuffer = nullptr;
+    // So that the data is released as soon as it has been consumed.
+    oReq.poRange.reset();
+}
+
+/************************************************************************/
+/*                        AdviseReadThreadFunc()                        */
+/************************************************************************/
+
+void VSICurlHandle::AdviseReadThreadFunc(void *pData)
+{
+    AdviseReadJob *psJob = static_cast<AdviseReadJob *>(pData);
+
+    NetworkStatisticsFileSystem oContextFS(psJob->osFSPrefix.c_str());
+    NetworkStatisticsFile oContextFile(psJob->osFilename.c_str());
+    NetworkStatisticsAction oContextAction("AdviseRead");
+
+    // Use a dedicated multi handle, as the ones of poFS are per-thread.
+    CURLM *hMultiHandle = curl_multi_init();
+#ifdef CURLPIPE_MULTIPLEX
+    if (psJob->bMultiplex)
+        curl_multi_setopt(hMultiHandle, CURLMOPT_PIPELINING,
+                          CURLPIPE_MULTIPLEX);
+#endif
+    for (auto &poReq : psJob->apoRequests)
+        curl_multi_add_handle(hMultiHandle, poReq->hCurlHandle);
+
+    void *old_handler = CPLHTTPIgnoreSigPipe();
+    while (!psJob->bStop)
+    {
+        int still_running = 0;
+        while (curl_multi_perform(hMultiHandle, &still_running) ==
+               CURLM_CALL_MULTI_PERFORM)
+        {
+            // loop
+        }
+
+        // Publish each range as soon as it is received, so that readers
+        // don't have to wait for the whole set.
+        int msgq = 0;
+        while (CURLMsg *msg = curl_multi_info_read(hMultiHandle, &msgq))
+        {
+            if (msg->msg != CURLMSG_DONE)
+                continue;
+            char *pPrivate = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &pPrivate);
+            psJob->FinishRequest(
+                *reinterpret_cast<AdviseReadJob::Request *>(pPrivate));
+        }
+
+        if (!still_running)
+            break;
+
+        // Short timeout so that a stop request is honoured quickly.
+        int numfds = 0;
+        curl_multi_wait(hMultiHandle, nullptr, 0, 100, &numfds);
+    }
+    CPLHTTPRestoreSigPipeHandler(old_handler);
+
+    for (auto &poReq : psJob->apoRequests)
+    {
+        curl_multi_remove_handle(hMultiHandle, poReq->hCurlHandle);
+        if (!poReq->bFinished)
+        {
+            // Interrupted or not reported: release the waiters.
+            {
+                std::lock_guard<std::mutex> oLock(poReq->poRange->oMutex);
+                poReq->poRange->bDone = true;
+            }
+            poReq->poRange->oCV.notify_all();
+        }
+    }
+    curl_multi_cleanup(hMultiHandle);
+    psJob->bThreadFinished = true;
+}
+
+/************************************************************************/
+/*                         ReapAdviseReadJobs()                         */
+/************************************************************************/
+
+// Joins the threads of the AdviseRead() jobs that are finished, which does not
+// block. If bStopAll, interrupts and joins all of them.
+void VSICurlHandle::ReapAdviseReadJobs(bool bStopAll)
+{
+    if (bStopAll)
+    {
+        for (auto &poJob : m_apoAdviseReadJobs)
+            poJob->bStop = true;
+    }
+    for (auto oIter = m_apoAdviseReadJobs.begin();
+         oIter != m_apoAdviseReadJobs.end();)
+    {
+        if (bStopAll || (*oIter)->bThreadFinished)
+        {
+            CPLJoinThread((*oIter)->hThread);
+            oIter = m_apoAdviseReadJobs.erase(oIter);
+        }
+        else
+        {
+            ++oIter;
+        }
+    }
+}
+
+/************************************************************************/
+/*                    GetAdviseReadTotalBytesLimit()                    */
+/************************************************************************/
+
+size_t VSICurlHandle::GetAdviseReadTotalBytesLimit() const
+{
+    return static_cast<size_t>(std::min<unsigned long long>(
+        std::numeric_limits<size_t>::max(),
+        std::strtoull(CPLGetConfigOption(
+                          "CPL_VSIL_CURL_ADVISE_READ_TOTAL_BYTES_LIMIT",
+                          "104857600"),
+                      nullptr, 10)));
+}
+
+/************************************************************************/
+/*                             AdviseRead()                             */
+/************************************************************************/
+
+void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                               const size_t *panSizes)
+{
+    if (bInterrupted && bStopOnInterruptUntilUninstall)
+        return;
+
+    const size_t nLimit = GetAdviseReadTotalBytesLimit();
+    if (nRanges <= 0 || nLimit == 0)
+        return;
+
+    poFS->GetCachedFileProp(m_pszURL, oFileProp);
+    if (oFileProp.eExists == EXIST_NO)
+        return;
+
+    // Align the ranges on the chunks of the region cache and merge them.
+    const int nChunkSize = VSICURLGetDownloadChunkSize();
+    std::vector<std::pair<vsi_l_offset, vsi_l_offset>> aoRanges;
+    for (int i = 0; i < nRanges; ++i)
+    {
+        if (panSizes[i] == 0)
+            continue;
+        const vsi_l_offset nStart =
+            (panOffsets[i] / nChunkSize) * nChunkSize;
+        vsi_l_offset nEnd =
+            ((panOffsets[i] + panSizes[i] + nChunkSize - 1) / nChunkSize) *
+            nChunkSize;
+        if (oFileProp.bHasComputedFileSize)
+            nEnd = std::min(nEnd, oFileProp.fileSize);
+        if (nStart < nEnd)
+            aoRanges.emplace_back(nStart, nEnd);
+    }
+    std::sort(aoRanges.begin(), aoRanges.end());
+
+    // Only fetch the chunks that are neither cached nor already advised, up
+    // to nLimit bytes.
+    std::vector<std::pair<vsi_l_offset, size_t>> aoToFetch;
+    size_t nTotal = 0;
+    vsi_l_offset nLastEnd = 0;
+    for (const auto &oRange : aoRanges)
+    {
+        for (vsi_l_offset nOffset = std::max(oRange.first, nLastEnd);
+             nOffset < oRange.second && nTotal < nLimit; nOffset += nChunkSize)
+        {
+            if (GetAdvisedRange(nOffset, false) != nullptr ||
+                poFS->GetRegion(m_pszURL, nOffset) != nullptr)
+            {
+                continue;
+            }
+            const size_t nSize = static_cast<size_t>(
+                std::min<vsi_l_offset>(nChunkSize, oRange.second - nOffset));
+            if (!aoToFetch.empty() &&
+                aoToFetch.back().first + aoToFetch.back().second == nOffset)
+            {
+                aoToFetch.back().second += nSize;
+            }
+            else
+            {
+                aoToFetch.emplace_back(nOffset, nSize);
+            }
+            nTotal += nSize;
+        }
+        nLastEnd = std::max(nLastEnd, oRange.second);
+    }
+    if (aoToFetch.empty())
+        return;
+
+    // The transfers of the previous call go on in the background, as their
+    // data is likely to be needed now, and its ranges are kept until the next
+    // call, unless the data they hold and the new ranges would exceed nLimit.
+    // Then, they only end up in the region cache. Transfers of older calls
+    // are interrupted.
+    ReapAdviseReadJobs(false);
+    for (size_t i = 0; i + 1 < m_apoAdviseReadJobs.size(); ++i)
+        m_apoAdviseReadJobs[i]->bStop = true;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_aoAdviseReadRangesPrev = std::move(m_aoAdviseReadRanges);
+        m_aoAdviseReadRanges.clear();
+        size_t nHeld = 0;
+        for (const auto &poRange : m_aoAdviseReadRangesPrev)
+            nHeld += poRange->nSize;
+        if (nHeld + nTotal > nLimit)
+            m_aoAdviseReadRangesPrev.clear();
+    }
+
+    std::string osURL;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        ManagePlanetaryComputerSigning();
+        bool bHasExpired = false;
+        osURL = GetRedirectURLIfValid(bHasExpired);
+        if (bHasExpired)
+            return;
+    }
+
+    // The requests, including their authentication headers, are prepared
+    // in this thread, as GetCurlHeaders() is not thread-safe.
+    std::unique_ptr<AdviseReadJob> poJob(new AdviseReadJob());
+    auto psJob = poJob.get();
+    psJob->poFS = poFS;
+    psJob->osFSPrefix = poFS->GetFSPrefix();
+    psJob->osFilename = m_osFilename;
+    psJob->osCacheURL = m_pszURL;
+    psJob->nChunkSize = nChunkSize;
+    psJob->bMultiplex =
+        CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES"));
+
+    std::vector<std::shared_ptr<AdviseReadRange>> apoRanges;
+    for (const auto &oRange : aoToFetch)
+    {
+        auto poRange = std::make_shared<AdviseReadRange>();
+        poRange->nStartOffset = oRange.first;
+        poRange->nSize = oRange.second;
+
+        std::unique_ptr<AdviseReadJob::Request> poReq(
+            new AdviseReadJob::Request());
+        poReq->poRange = poRange;
+        CURL *hCurlHandle = curl_easy_init();
+        poReq->hCurlHandle = hCurlHandle;
+        poReq->headers =
+            VSICurlSetOptions(hCurlHandle, osURL.c_str(), m_papszHTTPOptions);
+
+        VSICURLInitWriteFuncStruct(&poReq->sWriteFuncData, nullptr, nullptr,
+                                   nullptr);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_WRITEDATA,
+                                   &poReq->sWriteFuncData);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_WRITEFUNCTION,
+                                   VSICurlHandleWriteFunc);
+
+        VSICURLInitWriteFuncStruct(&poReq->sWriteFuncHeaderData, nullptr,
+                                   nullptr, nullptr);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERDATA,
+                                   &poReq->sWriteFuncHeaderData);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERFUNCTION,
+                                   VSICurlHandleWriteFunc);
+        poReq->sWriteFuncHeaderData.bIsHTTP = STARTS_WITH(m_pszURL, "http");
+        poReq->sWriteFuncHeaderData.nStartOffset = oRange.first;
+        poReq->sWriteFuncHeaderData.nEndOffset =
+            oRange.first + oRange.second - 1;
+
+        char rangeStr[512] = {};
+        snprintf(rangeStr, sizeof(rangeStr), CPL_FRMT_GUIB "-" CPL_FRMT_GUIB,
+                 poReq->sWriteFuncHeaderData.nStartOffset,
+                 poReq->sWriteFuncHeaderData.nEndOffset);
+        if (poReq->sWriteFuncHeaderData.bIsHTTP)
+        {
+            CPLString osHeaderRange;
+            osHeaderRange.Printf("Range: bytes=%s", rangeStr);
+            // So it gets included in Azure signature
+            poReq->headers = curl_slist_append(poReq->headers, osHeaderRange);
+            unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, nullptr);
+        }
+        else
+        {
+            unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, rangeStr);
+        }
+
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_ERRORBUFFER,
+                                   &poReq->szCurlErrBuf[0]);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_PRIVATE,
+                                   poReq.get());
+
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            poReq->headers = VSICurlMergeHeaders(
+                poReq->headers, GetCurlHeaders("GET", poReq->headers));
+        }
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER,
+                                   poReq->headers);
+
+        psJob->apoRequests.push_back(std::move(poReq));
+        apoRanges.push_back(std::move(poRange));
+    }
+
+    if (ENABLE_DEBUG)
+        CPLDebug(poFS->GetDebugKey(),
+                 "AdviseRead(%s): fetching %d range(s), %u bytes",
+                 m_osFilename.c_str(), static_cast<int>(aoToFetch.size()),
+                 static_cast<unsigned>(nTotal));
+
+    psJob->hThread = CPLCreateJoinableThread(AdviseReadThreadFunc, psJob);
+    if (!psJob->hThread)
+        return;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_aoAdviseReadRanges = std::move(apoRanges);
+    }
+    m_apoAdviseReadJobs.push_back(std::move(poJob));
+}
+
+/************************************************************************/
+/*                          HasAdvisedRanges()                          */
+/************************************************************************/
+
+bool VSICurlHandle::HasAdvisedRanges() const
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    return !m_aoAdviseReadRanges.empty() || !m_aoAdviseReadRangesPrev.empty();
+}
+
+/************************************************************************/
+/*                          GetAdvisedRange()                           */
+/************************************************************************/
+
+// Returns the range of the last AdviseRead() calls that contains nOffset.
+// If bWait, waits for its transfer to complete, and returns nullptr if it
+// failed.
+std::shared_ptr<VSICurlHandle::AdviseReadRange>
+VSICurlHandle::GetAdvisedRange(vsi_l_offset nOffset, bool bWait) const
+{
+    std::shared_ptr<AdviseReadRange> poRange;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        for (const auto *paoRanges :
+             {&m_aoAdviseReadRanges, &m_aoAdviseReadRangesPrev})
+        {
+            // Ranges are sorted by increasing offset and don't overlap.
+            auto oIter = std::upper_bound(
+                paoRanges->begin(), paoRanges->end(), nOffset,
+                [](vsi_l_offset nVal,
+                   const std::shared_ptr<AdviseReadRange> &poR)
+                { return nVal < poR->nStartOffset; });
+            if (oIter == paoRanges->begin())
+                continue;
+            --oIter;
+            if (nOffset - (*oIter)->nStartOffset < (*oIter)->nSize)
+            {
+                poRange = *oIter;
+                break;
+            }
+        }
+    }
+    if (!poRange || !bWait)
+        return poRange;
+
+    // Wait outside of m_oMutex, so that other readers are not blocked.
+    std::unique_lock<std::mutex> oLock(poRange->oMutex);
+    poRange->oCV.wait(oLock, [&poRange] { return poRange->bDone; });
+    if (poRange->abyData.empty())
+        return nullptr;
+    return poRange;
+}
+
+/************************************************************************/
+/*                        ConsumeAdvisedRange()                         */
+/************************************************************************/
+
+// Records that nSize bytes of a range have been read. Once all of them have,
+// the range is dropped: its data is also in the region cache, and keeping it
+// until the next AdviseRead() call would double the memory used.
+void VSICurlHandle::ConsumeAdvisedRange(
+    const std::shared_ptr<AdviseReadRange> &poRange, size_t nSize) const
+{
+    {
+        std::lock_guard<std::mutex> oLock(poRange->oMutex);
+        poRange->nConsumed += nSize;
+        if (poRange->nConsumed < poRange->nSize)
+            return;
+    }
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    for (auto *paoRanges : {&m_aoAdviseReadRanges, &m_aoAdviseReadRangesPrev})
+    {
+        auto oIter = std::find(paoRanges->begin(), paoRanges->end(), poRange);
+        if (oIter != paoRanges->end())
+        {
+            paoRanges->erase(oIter);
+            break;
+        }
+    }
+}
+
+/************************************************************************/
+/*                       ReadFromAdvisedRanges()                        */
+/************************************************************************/
+
+// Serves [nOffset, nOffset + nSize[ from the data fetched by AdviseRead(),
+// completed with the region cache. Returns false if any part is missing.
+bool VSICurlHandle::ReadFromAdvisedRanges(void *pBuffer, size_t nSize,
+                                          vsi_l_offset nOffset) const
+{
+    if (!HasAdvisedRanges())
+        return false;
+
+    const int nChunkSize = VSICURLGetDownloadChunkSize();
+    GByte *pabyBuffer = static_cast<GByte *>(pBuffer);
+    const vsi_l_offset nEndOffset = nOffset + nSize;
+    while (nOffset < nEndOffset)
+    {
+        const size_t nToCopy = static_cast<size_t>(std::min<vsi_l_offset>(
+            nEndOffset - nOffset, nChunkSize - nOffset % nChunkSize));
+        const auto poRange = GetAdvisedRange(nOffset, true);
+        if (poRange)
+        {
+            if (nOffset + nToCopy > poRange->nStartOffset + poRange->nSize)
+                return false;
+            memcpy(pabyBuffer,
+                   poRange->abyData.data() +
+                       static_cast<size_t>(nOffset - poRange->nStartOffset),
+                   nToCopy);
+            ConsumeAdvisedRange(poRange, nToCopy);
+        }
+        else
+        {
+            const vsi_l_offset nChunkOffset =
+                (nOffset / nChunkSize) * nChunkSize;
+            auto psRegion = poFS->GetRegion(m_pszURL, nChunkOffset);
+            const size_t nOffsetInChunk =
+                static_cast<size_t>(nOffset - nChunkOffset);
+            if (!psRegion || psRegion->size() < nOffsetInChunk + nToCopy)
+                return false;
+            memcpy(pabyBuffer, psRegion->data() + nOffsetInChunk, nToCopy);
+        }
+        pabyBuffer += nToCopy;
+        nOffset += nToCopy;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                               Write()                                */
 /************************************************************************/
@@ -3089,6 +3828,375 @@ VSICurlFilesystemHandlerBase::GetCurlMultiHandleFor(const CPLString & /*osURL*/)
     return conn.hCurlMultiHandle;
 }
 
+/************************************************************************/
+/*                          VSICurlDiskCache                            */
+/************************************************************************/
+
+// Persistent cache of downloaded chunks, shared by all processes that use the
+// same CPL_VSIL_CURL_DISK_CACHE_DIR directory.
+//
+// Chunks are stored as <dir>/<xx>/<key>_<offset>, where <key> is the SHA256
+// of the URL, of the ETag (or last modification time and size) of the file
+// and of the chunk size, so that a modified remote file never hits stale
+// chunks. Chunks are written in a temporary file renamed once complete, and
+// have a small header that is checked when reading them, so that concurrent
+// processes never see partial chunks. The modification time of chunk files
+// is updated when they are read, and the least recently used ones are
+// removed when the total size exceeds CPL_VSIL_CURL_DISK_CACHE_SIZE.
+static const char VSICURL_DISK_CACHE_MAGIC[] = "GDALVCC1";
+static const char VSICURL_DISK_CACHE_PRUNE_MARKER[] = "last_prune";
+
+class VSICurlDiskCache
+{
+    static constexpr int HEADER_SIZE = 16;
+    // Minimum delay in seconds between two scans of the cache directory by
+    // different processes.
+    static constexpr int PRUNE_DELAY = 60;
+
+    std::mutex m_oMutex{};
+    std::string m_osDir{};
+    GIntBig m_nMaxSize = 0;
+    GIntBig m_nWrittenSinceLastPrune = 0;
+    time_t m_nLastPruneMarkerCheck = 0;
+    bool m_bPruning = false;
+
+    std::string GetChunkFilename(const std::string &osKey,
+                                 vsi_l_offset nOffset) const
+    {
+        return m_osDir + "/" + osKey.substr(0, 2) + "/" + osKey + "_" +
+               std::to_string(static_cast<GUIntBig>(nOffset));
+    }
+
+    void PruneIfNeeded(size_t nJustWritten);
+    static void Prune(const std::string &osDir, GIntBig nMaxSize);
+
+    static void Touch(const std::string &osFilename);
+
+  public:
+    static VSICurlDiskCache *Get();
+
+    static std::string GetKey(const char *pszURL,
+                              const std::string *posResponseETag = nullptr);
+
+    bool Read(const std::string &osKey, vsi_l_offset nOffset,
+              std::string &osData);
+    void Write(const std::string &osKey, vsi_l_offset nOffset,
+               const char *pData, size_t nSize);
+};
+
+/************************************************************************/
+/*                       VSICurlDiskCache::Get()                        */
+/************************************************************************/
+
+// Returns nullptr if the disk cache is not enabled.
+VSICurlDiskCache *VSICurlDiskCache::Get()
+{
+    const char *pszDir =
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_DIR", nullptr);
+    if (pszDir == nullptr || pszDir[0] == '\0')
+        return nullptr;
+
+    static VSICurlDiskCache oCache;
+    std::lock_guard<std::mutex> oLock(oCache.m_oMutex);
+    if (oCache.m_osDir != pszDir)
+    {
+        VSIStatBufL sStat;
+        if (VSIStatL(pszDir, &sStat) != 0 && VSIMkdir(pszDir, 0755) != 0 &&
+            VSIStatL(pszDir, &sStat) != 0)
+        {
+            CPLError(CE_Warning, CPLE_FileIO,
+                     "Cannot create CPL_VSIL_CURL_DISK_CACHE_DIR=%s", pszDir);
+            return nullptr;
+        }
+        oCache.m_osDir = pszDir;
+        oCache.m_nWrittenSinceLastPrune = 0;
+        oCache.m_nLastPruneMarkerCheck = 0;
+    }
+    oCache.m_nMaxSize = std::max(
+        static_cast<GIntBig>(VSICURLGetDownloadChunkSize()),
+        CPLAtoGIntBig(CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_SIZE",
+                                         "1073741824")));
+    return &oCache;
+}
+
+/************************************************************************/
+/*                      VSICurlDiskCache::GetKey()                      */
+/************************************************************************/
+
+// Returns an empty string if the file properties are not known well enough
+// to validate the cached chunks. When storing data, posResponseETag is the
+// ETag of the response it comes from (empty if there was none): if it does
+// not match the cached one, the file has been modified since its properties
+// were fetched, and the data must not be stored under the key of the previous
+// version.
+std::string VSICurlDiskCache::GetKey(const char *pszURL,
+                                     const std::string *posResponseETag)
+{
+    FileProp oFileProp;
+    if (!VSICURLGetCachedFileProp(pszURL, oFileProp) ||
+        oFileProp.eExists != EXIST_YES || oFileProp.bIsDirectory)
+        return std::string();
+    if (posResponseETag && *posResponseETag != oFileProp.ETag)
+    {
+        CPLDebug("VSICURL",
+                 "ETag of %s changed from '%s' to '%s'. "
+                 "Not storing data in disk cache",
+                 pszURL, oFileProp.ETag.c_str(), posResponseETag->c_str());
+        return std::string();
+    }
+
+    std::string osToHash(pszURL);
+    if (!oFileProp.ETag.empty())
+    {
+        osToHash += "\nETag=";
+        osToHash += oFileProp.ETag;
+    }
+    else if (oFileProp.mTime != 0 && oFileProp.bHasComputedFileSize)
+    {
+        osToHash += "\nmtime=";
+        osToHash += std::to_string(static_cast<GIntBig>(oFileProp.mTime));
+        osToHash += "\nsize=";
+        osToHash += std::to_string(static_cast<GUIntBig>(oFileProp.fileSize));
+    }
+    else
+    {
+        return std::string();
+    }
+    osToHash += "\nchunk=";
+    osToHash += std::to_string(VSICURLGetDownloadChunkSize());
+
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256(osToHash.data(), osToHash.size(), abyHash);
+    char *pszHex = CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyHash);
+    std::string osKey(pszHex);
+    CPLFree(pszHex);
+    return osKey;
+}
+
+/************************************************************************/
+/*                       VSICurlDiskCache::Touch()                      */
+/************************************************************************/
+
+void VSICurlDiskCache::Touch(const std::string &osFilename)
+{
+#ifdef _WIN32
+    wchar_t *pwszFilename =
+        CPLRecodeToWChar(osFilename.c_str(), CPL_ENC_UTF8, CPL_ENC_UCS2);
+    _wutime(pwszFilename, nullptr);
+    CPLFree(pwszFilename);
+#else
+    utime(osFilename.c_str(), nullptr);
+#endif
+}
+
+/************************************************************************/
+/*                       VSICurlDiskCache::Read()                       */
+/************************************************************************/
+
+bool VSICurlDiskCache::Read(const std::string &osKey, vsi_l_offset nOffset,
+                            std::string &osData)
+{
+    const std::string osFilename(GetChunkFilename(osKey, nOffset));
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "rb");
+    if (fp == nullptr)
+        return false;
+
+    bool bOK = false;
+    GByte abyHeader[HEADER_SIZE];
+    if (VSIFReadL(abyHeader, 1, HEADER_SIZE, fp) == HEADER_SIZE &&
+        memcmp(abyHeader, VSICURL_DISK_CACHE_MAGIC, 8) == 0)
+    {
+        GUInt64 nSize = 0;
+        memcpy(&nSize, abyHeader + 8, sizeof(nSize));
+        CPL_LSBPTR64(&nSize);
+        if (nSize <= static_cast<GUInt64>(VSICURLGetDownloadChunkSize()))
+        {
+            osData.resize(static_cast<size_t>(nSize));
+            bOK = VSIFReadL(&osData[0], 1, osData.size(), fp) ==
+                      osData.size() &&
+                  VSIFReadL(abyHeader, 1, 1, fp) == 0;
+        }
+    }
+    VSIFCloseL(fp);
+
+    if (bOK)
+        Touch(osFilename);
+    else
+        CPLDebug("VSICURL", "Ignoring invalid cached chunk %s",
+                 osFilename.c_str());
+    return bOK;
+}
+
+/************************************************************************/
+/*                       VSICurlDiskCache::Write()                      */
+/************************************************************************/
+
+void VSICurlDiskCache::Write(const std::string &osKey, vsi_l_offset nOffset,
+                             const char *pData, size_t nSize)
+{
+    const std::string osFilename(GetChunkFilename(osKey, nOffset));
+    VSIStatBufL sStat;
+    if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+        return;
+
+    const std::string osSubDir(CPLGetPath(osFilename.c_str()));
+    if (VSIStatL(osSubDir.c_str(), &sStat) != 0)
+        VSIMkdir(osSubDir.c_str(), 0755);
+
+    static std::atomic<unsigned> nCounter{0};
+    const std::string osTmpFilename(
+        osFilename + ".tmp." + std::to_string(CPLGetCurrentProcessID()) + "." +
+        std::to_string(++nCounter));
+    VSILFILE *fp = VSIFOpenL(osTmpFilename.c_str(), "wb");
+    if (fp == nullptr)
+        return;
+
+    GByte abyHeader[HEADER_SIZE];
+    memcpy(abyHeader, VSICURL_DISK_CACHE_MAGIC, 8);
+    GUInt64 nSize64 = nSize;
+    CPL_LSBPTR64(&nSize64);
+    memcpy(abyHeader + 8, &nSize64, sizeof(nSize64));
+    bool bOK = VSIFWriteL(abyHeader, 1, HEADER_SIZE, fp) == HEADER_SIZE &&
+               VSIFWriteL(pData, 1, nSize, fp) == nSize;
+    bOK = VSIFCloseL(fp) == 0 && bOK;
+    // Renaming over an existing file fails on Windows, in which case another
+    // process has already written the same chunk.
+    if (!bOK || VSIRename(osTmpFilename.c_str(), osFilename.c_str()) != 0)
+    {
+        VSIUnlink(osTmpFilename.c_str());
+        return;
+    }
+
+    PruneIfNeeded(HEADER_SIZE + nSize);
+}
+
+/************************************************************************/
+/*                  VSICurlDiskCache::PruneIfNeeded()                   */
+/************************************************************************/
+
+// The cache directory is scanned when this process has written more than a
+// tenth of the maximum cache size since its last scan, or when no process
+// has scanned it for PRUNE_DELAY seconds, which bounds its growth even when
+// it is used by many short-lived processes. The file system is only accessed
+// outside of m_oMutex, so that other threads are not blocked by a scan, and
+// a single thread of the process scans the directory at a time.
+void VSICurlDiskCache::PruneIfNeeded(size_t nJustWritten)
+{
+    std::string osDir;
+    GIntBig nMaxSize = 0;
+    bool bPrune = false;
+    bool bCheckMarker = false;
+    const time_t nNow = time(nullptr);
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_nWrittenSinceLastPrune += static_cast<GIntBig>(nJustWritten);
+        if (m_bPruning)
+            return;
+        bPrune = m_nWrittenSinceLastPrune > m_nMaxSize / 10;
+        if (!bPrune && nNow - m_nLastPruneMarkerCheck >= PRUNE_DELAY / 10)
+        {
+            m_nLastPruneMarkerCheck = nNow;
+            bCheckMarker = true;
+        }
+        if (!bPrune && !bCheckMarker)
+            return;
+        osDir = m_osDir;
+        nMaxSize = m_nMaxSize;
+        m_bPruning = true;
+    }
+
+    if (bCheckMarker)
+    {
+        const std::string osMarker(osDir + "/" +
+                                   VSICURL_DISK_CACHE_PRUNE_MARKER);
+        VSIStatBufL sStat;
+        bPrune = VSIStatL(osMarker.c_str(), &sStat) != 0 ||
+                 nNow - sStat.st_mtime >= PRUNE_DELAY;
+    }
+    if (bPrune)
+    {
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            m_nWrittenSinceLastPrune = 0;
+        }
+        Prune(osDir, nMaxSize);
+    }
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    m_bPruning = false;
+}
+
+/************************************************************************/
+/*                       VSICurlDiskCache::Prune()                      */
+/************************************************************************/
+
+void VSICurlDiskCache::Prune(const std::string &osDir, GIntBig nMaxSize)
+{
+    // Tell other processes that the directory has just been scanned.
+    const std::string osMarker(osDir + "/" + VSICURL_DISK_CACHE_PRUNE_MARKER);
+    VSILFILE *fpMarker = VSIFOpenL(osMarker.c_str(), "wb");
+    if (fpMarker)
+        VSIFCloseL(fpMarker);
+
+    struct Entry
+    {
+        std::string osFilename;
+        GIntBig nSize;
+        time_t nMTime;
+    };
+    std::vector<Entry> aoEntries;
+    GIntBig nTotalSize = 0;
+    const time_t nNow = time(nullptr);
+    const CPLStringList aosSubDirs(VSIReadDir(osDir.c_str()));
+    for (int iSubDir = 0; iSubDir < aosSubDirs.size(); ++iSubDir)
+    {
+        const char *pszSubDir = aosSubDirs[iSubDir];
+        if (strlen(pszSubDir) != 2)
+            continue;
+        const std::string osSubDir(osDir + "/" + pszSubDir);
+        const CPLStringList aosFiles(VSIReadDir(osSubDir.c_str()));
+        for (int iFile = 0; iFile < aosFiles.size(); ++iFile)
+        {
+            const char *pszFile = aosFiles[iFile];
+            const std::string osFilename(osSubDir + "/" + pszFile);
+            VSIStatBufL sStat;
+            if (VSIStatL(osFilename.c_str(), &sStat) != 0 ||
+                !VSI_ISREG(sStat.st_mode))
+                continue;
+            if (strstr(pszFile, ".tmp.") != nullptr)
+            {
+                // Left over by a process that was interrupted.
+                if (nNow - sStat.st_mtime > 3600)
+                    VSIUnlink(osFilename.c_str());
+                continue;
+            }
+            nTotalSize += static_cast<GIntBig>(sStat.st_size);
+            aoEntries.push_back(Entry{osFilename,
+                                      static_cast<GIntBig>(sStat.st_size),
+                                      sStat.st_mtime});
+        }
+    }
+    if (nTotalSize <= nMaxSize)
+        return;
+
+    // Evict the least recently used chunks, and leave some room so that the
+    // directory does not need to be scanned again right away.
+    std::sort(aoEntries.begin(), aoEntries.end(),
+              [](const Entry &a, const Entry &b)
+              { return a.nMTime < b.nMTime; });
+    const GIntBig nTargetSize = nMaxSize - nMaxSize / 5;
+    for (const auto &oEntry : aoEntries)
+    {
+        if (nTotalSize <= nTargetSize)
+            break;
+        // May fail if another process has already removed it.
+        VSIUnlink(oEntry.osFilename.c_str());
+        nTotalSize -= oEntry.nSize;
+    }
+    CPLDebug("VSICURL", "Disk cache %s pruned to " CPL_FRMT_GIB " bytes",
+             osDir.c_str(), nTotalSize);
+}
+
 /************************************************************************/
 /*                          GetRegionCache()                            */
 /************************************************************************/
@@ -3113,17 +4221,35 @@ std::shared_ptr<std::string>
 VSICurlFilesystemHandlerBase::GetRegion(const char *pszURL,
                                         vsi_l_offset nFileOffsetStart)
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
     nFileOffsetStart =
         (nFileOffsetStart / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
 
     std::shared_ptr<std::string> out;
-    if (GetRegionCache()->tryGet(
-            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out))
     {
-        return out;
+        CPLMutexHolder oHolder(&hMutex);
+        if (GetRegionCache()->tryGet(
+                FilenameOffsetPair(std::string(pszURL), nFileOffsetStart),
+                out))
+        {
+            return out;
+        }
+    }
+
+    VSICurlDiskCache *poDiskCache = VSICurlDiskCache::Get();
+    if (poDiskCache)
+    {
+        const std::string osKey(VSICurlDiskCache::GetKey(pszURL));
+        out = std::make_shared<std::string>();
+        if (!osKey.empty() &&
+            poDiskCache->Read(osKey, nFileOffsetStart, *out))
+        {
+            CPLMutexHolder oHolder(&hMutex);
+            GetRegionCache()->insert(
+                FilenameOffsetPair(std::string(pszURL), nFileOffsetStart),
+                out);
+            return out;
+        }
     }
 
     return nullptr;
@@ -3133,16 +4259,31 @@ VSICurlFilesystemHandlerBase::GetRegion(const char *pszURL,
 /*                          AddRegion()                                 */
 /************************************************************************/
 
+// pszETag is the ETag of the response the data comes from, or nullptr if it
+// had none.
 void VSICurlFilesystemHandlerBase::AddRegion(const char *pszURL,
                                              vsi_l_offset nFileOffsetStart,
-                                             size_t nSize, const char *pData)
+                                             size_t nSize, const char *pData,
+                                             const char *pszETag)
 {
-    CPLMutexHolder oHolder(&hMutex);
+    {
+        CPLMutexHolder oHolder(&hMutex);
 
-    std::shared_ptr<std::string> value(new std::string());
-    value->assign(pData, nSize);
-    GetRegionCache()->insert(
-        FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
+        std::shared_ptr<std::string> value(new std::string());
+        value->assign(pData, nSize);
+        GetRegionCache()->insert(
+            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
+    }
+
+    VSICurlDiskCache *poDiskCache = VSICurlDiskCache::Get();
+    if (poDiskCache)
+    {
+        const std::string osResponseETag(pszETag ? pszETag : "");
+        const std::string osKey(
+            VSICurlDiskCache::GetKey(pszURL, &osResponseETag));
+        if (!osKey.empty())
+            poDiskCache->Write(osKey, nFileOffsetStart, pData, nSize);
+    }
 }
 
 /************************************************************************/
@@ -3430,6 +4571,22 @@ const char *VSICurlFilesystemHandlerBase::GetActualURL(const char *pszFilename)
     "  <Option name='CPL_VSIL_CURL_CACHE_SIZE' type='integer' "                \
     "description='Size in bytes of the global /vsicurl/ cache' "               \
     "default='16384000'/>"                                                     \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_DIR' type='string' "             \
+    "description='Directory where downloaded chunks are cached persistently "  \
+    "and shared between processes'/>"                                          \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_SIZE' type='integer' "           \
+    "description='Maximum size in bytes of the persistent cache' "             \
+    "default='1073741824'/>"                                                   \
+    "  <Option name='CPL_VSIL_CURL_PARALLEL_READ_REQUESTS' type='integer' "    \
+    "description='Maximum number of concurrent requests a large read is "      \
+    "split into. 1 to disable' default='4'/>"                                  \
+    "  <Option name='CPL_VSIL_CURL_PARALLEL_READ_CHUNK_SIZE' type='integer' "  \
+    "description='Minimum size in bytes of each of the concurrent requests "   \
+    "of a large read' default='4194304'/>"                                     \
+    "  <Option name='CPL_VSIL_CURL_ADVISE_READ_TOTAL_BYTES_LIMIT' "            \
+    "type='integer' description='Maximum number of bytes prefetched in the "   \
+    "background by a single AdviseRead() call. 0 to disable' "                 \
+    "default='104857600'/>"                                                    \
     "  <Option name='CPL_VSIL_CURL_IGNORE_GLACIER_STORAGE' type='boolean' "    \
     "description='Whether to skip files with Glacier storage class in "        \
     "directory listing.' default='YES'/>"
@@ -38,14 +38,17 @@
 #include "cpl_string.h"
 #include "cpl_vsil_curl_priv.h"
 #include "cpl_mem_cache.h"
+#include "cpl_multiproc.h"
 
 #include "cpl_curl_priv.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <set>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 //! @cond Doxygen_Suppress
 
@@ -295,7 +298,7 @@ class VSICurlFilesystemHandlerBase : public VSIFilesystemHandler
                                            vsi_l_offset nFileOffsetStart);
 
     void AddRegion(const char *pszURL, vsi_l_offset nFileOffsetStart,
-                   size_t nSize, const char *pData);
+                   size_t nSize, const char *pData, const char *pszETag);
 
     bool GetCachedFileProp(const char *pszURL, FileProp &oFileProp);
     void SetCachedFileProp(const char *pszURL, FileProp &oFileProp);
@@ -376,7 +379,7 @@ class VSICurlHandle : public VSIVirtualHandle
 
     void DownloadRegionPostProcess(const vsi_l_offset startOffset,
                                    const int nBlocks, const char *pBuffer,
-                                   size_t nSize);
+                                   size_t nSize, const char *pszETag = nullptr);
 
   private:
     vsi_l_offset curOffset = 0;
@@ -397,11 +400,51 @@ class VSICurlHandle : public VSIVirtualHandle
     int ReadMultiRangeSingleGet(int nRanges, void **ppData,
                                 const vsi_l_offset *panOffsets,
                                 const size_t *panSizes);
+    int ReadMultiRangeParallel(int nRanges, void **ppData,
+                               const vsi_l_offset *panOffsets,
+                               const size_t *panSizes, const CPLString &osURL,
+                               bool bMergeConsecutiveRanges);
+    size_t ReadParallel(void *pBuffer, size_t nSize, vsi_l_offset nOffset);
     CPLString GetRedirectURLIfValid(bool &bHasExpired) const;
 
     void UpdateRedirectInfo(CURL *hCurlHandle,
                             const WriteFuncStruct &sWriteFuncHeaderData);
 
+    // Data fetched in the background by AdviseRead()
+    struct AdviseReadRange
+    {
+        bool bDone = false;
+        std::mutex oMutex{};
+        std::condition_variable oCV{};
+        vsi_l_offset nStartOffset = 0;
+        size_t nSize = 0;
+        size_t nConsumed = 0;  // protected by oMutex
+        std::vector<GByte> abyData{};
+    };
+    struct AdviseReadJob;
+
+    // Ranges of the last AdviseRead() call, and of the one before it, so
+    // that advising the next window doesn't discard the current one. A range
+    // is removed once all its bytes have been read, as they are then in the
+    // region cache too. Protected by m_oMutex.
+    mutable std::vector<std::shared_ptr<AdviseReadRange>>
+        m_aoAdviseReadRanges{};
+    mutable std::vector<std::shared_ptr<AdviseReadRange>>
+        m_aoAdviseReadRangesPrev{};
+    // Jobs whose thread has not been joined yet. Only accessed by the thread
+    // that owns the handle.
+    std::vector<std::unique_ptr<AdviseReadJob>> m_apoAdviseReadJobs{};
+
+    static void AdviseReadThreadFunc(void *pData);
+    void ReapAdviseReadJobs(bool bStopAll);
+    bool HasAdvisedRanges() const;
+    std::shared_ptr<AdviseReadRange> GetAdvisedRange(vsi_l_offset nOffset,
+                                                     bool bWait) const;
+    void ConsumeAdvisedRange(const std::shared_ptr<AdviseReadRange> &poRange,
+                             size_t nSize) const;
+    bool ReadFromAdvisedRanges(void *pBuffer, size_t nSize,
+                               vsi_l_offset nOffset) const;
+
   protected:
     virtual struct curl_slist *
     GetCurlHeaders(const CPLString & /*osVerb*/,
@@ -458,6 +501,10 @@ class VSICurlHandle : public VSIVirtualHandle
     size_t PRead(void *pBuffer, size_t nSize,
                  vsi_l_offset nOffset) const override;
 
+    void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                    const size_t *panSizes) override;
+    size_t GetAdviseReadTotalBytesLimit() const override;
+
     bool IsKnownFileSize() const
     {
         return oFileProp.bHasComputedFileSize;
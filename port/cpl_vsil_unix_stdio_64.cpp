@@ -78,12 +78,19 @@
 #if HAVE_UNISTD_H
 #include <unistd.h>
 #endif
-#ifdef HAVE_PREAD_BSD
+#if defined(HAVE_PREAD_BSD) || defined(HAVE_PREADV64) ||                    \
+    defined(HAVE_PREADV_BSD)
 #include <sys/uio.h>
 #endif
 
+#ifdef HAVE_LIBURING
+#include <liburing.h>
+#endif
+
+#include <algorithm>
 #include <limits>
 #include <new>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -546,7 +553,7 @@ int VSIUnixStdioHandle::Truncate(vsi_l_offset nNewSize)
 }
 
 /************************************************************************/
-/*                          GetRangeStatus()                            */
+/*                       VSIUnixGetRangeStatus()                        */
 /************************************************************************/
 
 #ifdef __linux
@@ -561,14 +568,19 @@ int VSIUnixStdioHandle::Truncate(vsi_l_offset nNewSize)
 #include <errno.h>
 #endif
 
-VSIRangeStatus VSIUnixStdioHandle::GetRangeStatus(vsi_l_offset
+static VSIRangeStatus VSIUnixGetRangeStatus(int
+#ifdef FS_IOC_FIEMAP
+                                                 fd
+#endif
+                                             ,
+                                             vsi_l_offset
 #ifdef FS_IOC_FIEMAP
-                                                      nOffset
+                                                 nOffset
 #endif
-                                                  ,
-                                                  vsi_l_offset
+                                             ,
+                                             vsi_l_offset
 #ifdef FS_IOC_FIEMAP
-                                                      nLength
+                                                 nLength
 #endif
 )
 {
@@ -580,7 +592,6 @@ VSIRangeStatus VSIUnixStdioHandle::GetRangeStatus(vsi_l_offset
     // As we are interested in only one extent, we allocate the base size of
     // fiemap + one fiemap_extent.
     GByte abyBuffer[sizeof(struct fiemap) + sizeof(struct fiemap_extent)];
-    int fd = fileno(fp);
     struct fiemap *psExtentMap = reinterpret_cast<struct fiemap *>(&abyBuffer);
     memset(psExtentMap, 0,
            sizeof(struct fiemap) + sizeof(struct fiemap_extent));
@@ -621,6 +632,16 @@ VSIRangeStatus VSIUnixStdioHandle::GetRangeStatus(vsi_l_offset
 #endif
 }
 
+/************************************************************************/
+/*                          GetRangeStatus()                            */
+/************************************************************************/
+
+VSIRangeStatus VSIUnixStdioHandle::GetRangeStatus(vsi_l_offset nOffset,
+                                                  vsi_l_offset nLength)
+{
+    return VSIUnixGetRangeStatus(fileno(fp), nOffset, nLength);
+}
+
 /************************************************************************/
 /*                             HasPRead()                               */
 /************************************************************************/
@@ -646,6 +667,611 @@ size_t VSIUnixStdioHandle::PRead(void *pBuffer, size_t nSize,
 }
 #endif
 
+#if defined(HAVE_PREAD64) || (defined(HAVE_PREAD_BSD) && SIZEOF_OFF_T == 8)
+
+/************************************************************************/
+/*                          VSIUnixPReadFully()                         */
+/************************************************************************/
+
+// Reads nSize bytes at nOffset, retrying on EINTR and short reads. Returns
+// the number of bytes actually read.
+static size_t VSIUnixPReadFully(int fd, void *pBuffer, size_t nSize,
+                                vsi_l_offset nOffset)
+{
+    GByte *pabyBuffer = static_cast<GByte *>(pBuffer);
+    size_t nDone = 0;
+    while (nDone < nSize)
+    {
+#ifdef HAVE_PREAD64
+        const auto nRet =
+            pread64(fd, pabyBuffer + nDone, nSize - nDone, nOffset + nDone);
+#else
+        const auto nRet = pread(fd, pabyBuffer + nDone, nSize - nDone,
+                                static_cast<off_t>(nOffset + nDone));
+#endif
+        if (nRet < 0 && errno == EINTR)
+            continue;
+        if (nRet <= 0)
+            break;
+        nDone += static_cast<size_t>(nRet);
+    }
+    return nDone;
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                        VSIUnixPReadHandle                            */
+/* ==================================================================== */
+/************************************************************************/
+
+// Read-only handle working directly on a file descriptor with positional
+// reads, without the stdio FILE* buffering layer. All reads go through
+// pread(), so PRead() can be used concurrently from several threads, and
+// ReadMultiRange() is served with vectored reads where available.
+class VSIUnixPReadHandle final : public VSIVirtualHandle
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIUnixPReadHandle)
+
+    // Small reads (typically when parsing headers) are served from a
+    // read-ahead buffer, to avoid issuing one system call for each of them.
+    static constexpr size_t SMALL_READ_THRESHOLD = 4096;
+    static constexpr size_t READ_AHEAD_SIZE = 16384;
+
+    int m_fd = -1;
+    vsi_l_offset m_nOffset = 0;
+    bool m_bEOF = false;
+    std::vector<GByte> m_abyBuffer{};
+    vsi_l_offset m_nBufferOffset = 0;
+    size_t m_nBufferSize = 0;
+
+#ifdef HAVE_LIBURING
+    // Maximum number of reads in flight in ReadMultiRange()
+    static constexpr unsigned IO_URING_QUEUE_DEPTH = 64;
+
+    io_uring m_sRing{};
+    bool m_bRingInitialized = false;
+    bool m_bRingUnavailable = false;
+
+    bool InitRing();
+    void ReadMultiRangeIOUring(int nRanges, void **ppData,
+                               const vsi_l_offset *panOffsets,
+                               const size_t *panSizes,
+                               std::vector<bool> &abDone);
+#endif
+
+  public:
+    explicit VSIUnixPReadHandle(int fd) : m_fd(fd)
+    {
+    }
+    ~VSIUnixPReadHandle() override;
+
+    int Seek(vsi_l_offset nOffsetIn, int nWhence) override;
+    vsi_l_offset Tell() override
+    {
+        return m_nOffset;
+    }
+    size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
+    int ReadMultiRange(int nRanges, void **ppData,
+                       const vsi_l_offset *panOffsets,
+                       const size_t *panSizes) override;
+    size_t Write(const void *pBuffer, size_t nSize, size_t nMemb) override;
+    int Eof() override
+    {
+        return m_bEOF ? TRUE : FALSE;
+    }
+    int Flush() override
+    {
+        return 0;
+    }
+    int Close() override;
+    int Truncate(vsi_l_offset nNewSize) override;
+    void *GetNativeFileDescriptor() override
+    {
+        return reinterpret_cast<void *>(static_cast<uintptr_t>(m_fd));
+    }
+    VSIRangeStatus GetRangeStatus(vsi_l_offset nOffset,
+                                  vsi_l_offset nLength) override
+    {
+        return VSIUnixGetRangeStatus(m_fd, nOffset, nLength);
+    }
+    bool HasPRead() const override
+    {
+        return true;
+    }
+    size_t PRead(void *pBuffer, size_t nSize,
+                 vsi_l_offset nOffset) const override
+    {
+        return VSIUnixPReadFully(m_fd, pBuffer, nSize, nOffset);
+    }
+    void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                    const size_t *panSizes) override;
+    size_t GetAdviseReadTotalBytesLimit() const override;
+    bool HasOptimizedReadMultiRange() const override;
+};
+
+/************************************************************************/
+/*                        ~VSIUnixPReadHandle()                         */
+/************************************************************************/
+
+VSIUnixPReadHandle::~VSIUnixPReadHandle()
+{
+    VSIUnixPReadHandle::Close();
+}
+
+/************************************************************************/
+/*                               Close()                                */
+/************************************************************************/
+
+int VSIUnixPReadHandle::Close()
+{
+    if (m_fd < 0)
+        return 0;
+    VSIDebug1("VSIUnixPReadHandle::Close(%d)", m_fd);
+#ifdef HAVE_LIBURING
+    if (m_bRingInitialized)
+    {
+        io_uring_queue_exit(&m_sRing);
+        m_bRingInitialized = false;
+    }
+#endif
+    const int nRet = close(m_fd);
+    m_fd = -1;
+    return nRet;
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSIUnixPReadHandle::Seek(vsi_l_offset nOffsetIn, int nWhence)
+{
+    m_bEOF = false;
+    if (nWhence == SEEK_SET)
+    {
+        m_nOffset = nOffsetIn;
+    }
+    else if (nWhence == SEEK_CUR)
+    {
+        m_nOffset += nOffsetIn;
+    }
+    else if (nWhence == SEEK_END)
+    {
+        // The position of the file descriptor itself is never used by
+        // pread(), so it is fine to move it.
+#ifdef HAVE_PREAD64
+        const auto nFileSize = lseek64(m_fd, 0, SEEK_END);
+#else
+        const auto nFileSize = lseek(m_fd, 0, SEEK_END);
+#endif
+        if (nFileSize < 0)
+            return -1;
+        m_nOffset = static_cast<vsi_l_offset>(nFileSize) + nOffsetIn;
+    }
+    else
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSIUnixPReadHandle::Read(void *pBuffer, size_t nSize, size_t nCount)
+{
+    const size_t nBytes = nSize * nCount;
+    if (nBytes == 0)
+        return 0;
+
+    GByte *pabyBuffer = static_cast<GByte *>(pBuffer);
+    size_t nDone = 0;
+
+    // Serve what we can from the read-ahead buffer
+    if (m_nOffset >= m_nBufferOffset &&
+        m_nOffset < m_nBufferOffset + m_nBufferSize)
+    {
+        const size_t nPos = static_cast<size_t>(m_nOffset - m_nBufferOffset);
+        nDone = std::min(nBytes, m_nBufferSize - nPos);
+        memcpy(pabyBuffer, m_abyBuffer.data() + nPos, nDone);
+    }
+
+    if (nDone < nBytes)
+    {
+        const size_t nRemaining = nBytes - nDone;
+        const vsi_l_offset nOffset = m_nOffset + nDone;
+        if (nRemaining >= SMALL_READ_THRESHOLD)
+        {
+            nDone += VSIUnixPReadFully(m_fd, pabyBuffer + nDone, nRemaining,
+                                       nOffset);
+        }
+        else
+        {
+            m_abyBuffer.resize(READ_AHEAD_SIZE);
+            m_nBufferOffset = nOffset;
+            m_nBufferSize = VSIUnixPReadFully(m_fd, m_abyBuffer.data(),
+                                              READ_AHEAD_SIZE, nOffset);
+            const size_t nToCopy = std::min(nRemaining, m_nBufferSize);
+            memcpy(pabyBuffer + nDone, m_abyBuffer.data(), nToCopy);
+            nDone += nToCopy;
+        }
+    }
+
+#ifdef VSI_DEBUG
+    VSIDebug3("VSIUnixPReadHandle::Read(%d," CPL_FRMT_GUIB
+              ") = " CPL_FRMT_GUIB,
+              m_fd, static_cast<GUIntBig>(nBytes),
+              static_cast<GUIntBig>(nDone));
+#endif
+
+    m_nOffset += nDone;
+    if (nDone < nBytes)
+        m_bEOF = true;
+
+    return nDone / nSize;
+}
+
+/************************************************************************/
+/*                          ReadMultiRange()                            */
+/************************************************************************/
+
+int VSIUnixPReadHandle::ReadMultiRange(int nRanges, void **ppData,
+                                       const vsi_l_offset *panOffsets,
+                                       const size_t *panSizes)
+{
+#ifdef HAVE_LIBURING
+    if (nRanges > 1 && InitRing())
+    {
+        // Ranges that could not be read through io_uring are read with
+        // pread() afterwards.
+        std::vector<bool> abDone(nRanges);
+        ReadMultiRangeIOUring(nRanges, ppData, panOffsets, panSizes, abDone);
+        for (int i = 0; i < nRanges; ++i)
+        {
+            if (!abDone[i] && VSIUnixPReadFully(m_fd, ppData[i], panSizes[i],
+                                                panOffsets[i]) != panSizes[i])
+                return -1;
+        }
+        return 0;
+    }
+#endif
+
+#if defined(HAVE_PREADV64) ||                                                  \
+    (defined(HAVE_PREADV_BSD) && SIZEOF_OFF_T == 8)
+    // Consecutive ranges are read with a single preadv() call
+#ifdef IOV_MAX
+    const int nMaxIOV = IOV_MAX;
+#else
+    const int nMaxIOV = 16;
+#endif
+    std::vector<struct iovec> asIOV;
+    int iRange = 0;
+    while (iRange < nRanges)
+    {
+        asIOV.clear();
+        const vsi_l_offset nStartOffset = panOffsets[iRange];
+        vsi_l_offset nEndOffset = nStartOffset;
+        int iLast = iRange;
+        while (iLast < nRanges && static_cast<int>(asIOV.size()) < nMaxIOV &&
+               panOffsets[iLast] == nEndOffset)
+        {
+            struct iovec sIOV;
+            sIOV.iov_base = ppData[iLast];
+            sIOV.iov_len = panSizes[iLast];
+            asIOV.push_back(sIOV);
+            nEndOffset += panSizes[iLast];
+            ++iLast;
+        }
+
+        if (asIOV.size() == 1)
+        {
+            if (VSIUnixPReadFully(m_fd, ppData[iRange], panSizes[iRange],
+                                  nStartOffset) != panSizes[iRange])
+                return -1;
+        }
+        else
+        {
+#ifdef HAVE_PREADV64
+            ssize_t nRet;
+            do
+            {
+                nRet = preadv64(m_fd, asIOV.data(),
+                                static_cast<int>(asIOV.size()), nStartOffset);
+            } while (nRet < 0 && errno == EINTR);
+#else
+            ssize_t nRet;
+            do
+            {
+                nRet = preadv(m_fd, asIOV.data(),
+                              static_cast<int>(asIOV.size()),
+                              static_cast<off_t>(nStartOffset));
+            } while (nRet < 0 && errno == EINTR);
+#endif
+            if (nRet < 0)
+                return -1;
+            if (static_cast<vsi_l_offset>(nRet) != nEndOffset - nStartOffset)
+            {
+                // Short read: complete the ranges that were not fully read
+                vsi_l_offset nOffset = nStartOffset;
+                for (int i = iRange; i < iLast; ++i)
+                {
+                    const vsi_l_offset nRead =
+                        nStartOffset + static_cast<vsi_l_offset>(nRet);
+                    if (nOffset + panSizes[i] > nRead)
+                    {
+                        const size_t nAlreadyRead =
+                            nRead > nOffset
+                                ? static_cast<size_t>(nRead - nOffset)
+                                : 0;
+                        const size_t nToRead = panSizes[i] - nAlreadyRead;
+                        if (VSIUnixPReadFully(
+                                m_fd,
+                                static_cast<GByte *>(ppData[i]) + nAlreadyRead,
+                                nToRead, nOffset + nAlreadyRead) != nToRead)
+                            return -1;
+                    }
+                    nOffset += panSizes[i];
+                }
+            }
+        }
+        iRange = iLast;
+    }
+    return 0;
+#else
+    for (int i = 0; i < nRanges; ++i)
+    {
+        if (VSIUnixPReadFully(m_fd, ppData[i], panSizes[i], panOffsets[i]) !=
+            panSizes[i])
+            return -1;
+    }
+    return 0;
+#endif
+}
+
+#ifdef HAVE_LIBURING
+
+/************************************************************************/
+/*                              InitRing()                              */
+/************************************************************************/
+
+bool VSIUnixPReadHandle::InitRing()
+{
+    if (m_bRingInitialized)
+        return true;
+    if (m_bRingUnavailable)
+        return false;
+
+    m_bRingUnavailable = true;
+    if (!CPLTestBool(CPLGetConfigOption("CPL_VSIL_LOCAL_USE_IO_URING", "YES")))
+        return false;
+
+    // Fails with -ENOSYS on kernels without io_uring, or -EPERM when it is
+    // disabled by a seccomp policy or the kernel.io_uring_disabled sysctl.
+    const int nRet = io_uring_queue_init(IO_URING_QUEUE_DEPTH, &m_sRing, 0);
+    if (nRet < 0)
+    {
+        CPLDebug("VSI", "io_uring_queue_init() failed: %s. Using pread()",
+                 strerror(-nRet));
+        return false;
+    }
+    m_bRingInitialized = true;
+    m_bRingUnavailable = false;
+    return true;
+}
+
+/************************************************************************/
+/*                        ReadMultiRangeIOUring()                       */
+/************************************************************************/
+
+// Submits all the ranges to the ring, keeping up to IO_URING_QUEUE_DEPTH
+// reads in flight, and sets abDone[i] for the ranges that have been fully
+// read. This always waits for all submitted reads to be completed before
+// returning, since they write into the caller buffers.
+void VSIUnixPReadHandle::ReadMultiRangeIOUring(int nRanges, void **ppData,
+                                               const vsi_l_offset *panOffsets,
+                                               const size_t *panSizes,
+                                               std::vector<bool> &abDone)
+{
+    int iNext = 0;
+    int nQueued = 0;
+    int nInFlight = 0;
+    bool bRingError = false;
+    while (nInFlight > 0 ||
+           (!bRingError && (iNext < nRanges || nQueued > 0)))
+    {
+        // Queue as many reads as the submission queue can take
+        while (!bRingError && iNext < nRanges &&
+               nQueued + nInFlight < static_cast<int>(IO_URING_QUEUE_DEPTH))
+        {
+            if (panSizes[iNext] > std::numeric_limits<unsigned>::max())
+            {
+                ++iNext;
+                continue;
+            }
+            struct io_uring_sqe *psSQE = io_uring_get_sqe(&m_sRing);
+            if (psSQE == nullptr)
+                break;
+            io_uring_prep_read(psSQE, m_fd, ppData[iNext],
+                               static_cast<unsigned>(panSizes[iNext]),
+                               panOffsets[iNext]);
+            io_uring_sqe_set_data(
+                psSQE, reinterpret_cast<void *>(static_cast<uintptr_t>(iNext)));
+            ++iNext;
+            ++nQueued;
+        }
+
+        if (!bRingError && nQueued > 0)
+        {
+            const int nRet = io_uring_submit(&m_sRing);
+            if (nRet > 0)
+            {
+                nQueued -= nRet;
+                nInFlight += nRet;
+            }
+            else if (nInFlight == 0 || (nRet != -EINTR && nRet != -EAGAIN &&
+                                        nRet != -EBUSY))
+            {
+                CPLDebug("VSI", "io_uring_submit() failed: %s",
+                         strerror(-nRet));
+                bRingError = true;
+            }
+        }
+        if (nInFlight == 0)
+            continue;
+
+        // Wait for at least one completion, and reap all available ones
+        struct io_uring_cqe *psCQE = nullptr;
+        const int nRet = io_uring_wait_cqe(&m_sRing, &psCQE);
+        if (nRet < 0)
+            continue;
+        do
+        {
+            const int i = static_cast<int>(
+                reinterpret_cast<uintptr_t>(io_uring_cqe_get_data(psCQE)));
+            const int nRes = psCQE->res;
+            io_uring_cqe_seen(&m_sRing, psCQE);
+            --nInFlight;
+
+            if (nRes >= 0)
+            {
+                // Complete short reads synchronously
+                const size_t nRead = static_cast<size_t>(nRes);
+                abDone[i] =
+                    nRead == panSizes[i] ||
+                    VSIUnixPReadFully(m_fd,
+                                      static_cast<GByte *>(ppData[i]) + nRead,
+                                      panSizes[i] - nRead,
+                                      panOffsets[i] + nRead) ==
+                        panSizes[i] - nRead;
+            }
+            else if ((nRes == -EINVAL || nRes == -EOPNOTSUPP) && !bRingError)
+            {
+                // IORING_OP_READ is only available since Linux 5.6
+                CPLDebug("VSI", "io_uring read not supported: %s",
+                         strerror(-nRes));
+                bRingError = true;
+            }
+        } while (io_uring_peek_cqe(&m_sRing, &psCQE) == 0);
+    }
+
+    if (bRingError)
+    {
+        // Discards the reads that have been queued but not submitted
+        io_uring_queue_exit(&m_sRing);
+        m_bRingInitialized = false;
+        m_bRingUnavailable = true;
+    }
+}
+
+/************************************************************************/
+/*                       VSIUnixIOUringAvailable()                      */
+/************************************************************************/
+
+static bool VSIUnixIOUringAvailable()
+{
+    static const bool bAvailable = []()
+    {
+        struct io_uring sRing;
+        if (io_uring_queue_init(1, &sRing, 0) < 0)
+            return false;
+        io_uring_queue_exit(&sRing);
+        return true;
+    }();
+    return bAvailable;
+}
+
+#endif  // HAVE_LIBURING
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+size_t VSIUnixPReadHandle::Write(const void *, size_t, size_t)
+{
+    errno = EBADF;
+    return 0;
+}
+
+/************************************************************************/
+/*                              Truncate()                              */
+/************************************************************************/
+
+int VSIUnixPReadHandle::Truncate(vsi_l_offset)
+{
+    errno = EBADF;
+    return -1;
+}
+
+/************************************************************************/
+/*                             AdviseRead()                             */
+/************************************************************************/
+
+void VSIUnixPReadHandle::AdviseRead(int
+#ifdef HAVE_POSIX_FADVISE
+                                        nRanges
+#endif
+                                    ,
+                                    const vsi_l_offset *
+#ifdef HAVE_POSIX_FADVISE
+                                        panOffsets
+#endif
+                                    ,
+                                    const size_t *
+#ifdef HAVE_POSIX_FADVISE
+                                        panSizes
+#endif
+)
+{
+#ifdef HAVE_POSIX_FADVISE
+    // Let the kernel start reading the ranges in the page cache, so that
+    // the following reads do not block on I/O.
+    for (int i = 0; i < nRanges; ++i)
+    {
+        posix_fadvise(m_fd, static_cast<off_t>(panOffsets[i]),
+                      static_cast<off_t>(panSizes[i]), POSIX_FADV_WILLNEED);
+    }
+#endif
+}
+
+/************************************************************************/
+/*                    GetAdviseReadTotalBytesLimit()                    */
+/************************************************************************/
+
+size_t VSIUnixPReadHandle::GetAdviseReadTotalBytesLimit() const
+{
+#ifdef HAVE_POSIX_FADVISE
+    // Hints only populate the page cache, but avoid putting pressure on it
+    // when a caller advises a whole large file.
+    return 64 * 1024 * 1024;
+#else
+    return 0;
+#endif
+}
+
+/************************************************************************/
+/*                     HasOptimizedReadMultiRange()                     */
+/************************************************************************/
+
+bool VSIUnixPReadHandle::HasOptimizedReadMultiRange() const
+{
+#ifdef HAVE_LIBURING
+    // Only batched reads through io_uring are worth it. Plain preadv() only
+    // merges consecutive ranges.
+    if (m_bRingInitialized)
+        return true;
+    if (m_bRingUnavailable)
+        return false;
+    return CPLTestBool(
+               CPLGetConfigOption("CPL_VSIL_LOCAL_USE_IO_URING", "YES")) &&
+           VSIUnixIOUringAvailable();
+#else
+    return false;
+#endif
+}
+
+#endif  // pread
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       VSIUnixStdioFilesystemHandler                  */
@@ -680,6 +1306,59 @@ VSIUnixStdioFilesystemHandler::Open(const char *pszFilename,
                                     CSLConstList /* papszOptions */)
 
 {
+    const bool bReadOnly =
+        strcmp(pszAccess, "rb") == 0 || strcmp(pszAccess, "r") == 0;
+
+#if defined(HAVE_PREAD64) || (defined(HAVE_PREAD_BSD) && SIZEOF_OFF_T == 8)
+    /* -------------------------------------------------------------------- */
+    /*      Files opened in read-only mode can use positional reads on a    */
+    /*      file descriptor, bypassing stdio buffering.                     */
+    /* -------------------------------------------------------------------- */
+    if (bReadOnly &&
+        CPLTestBool(CPLGetConfigOption("CPL_VSIL_LOCAL_USE_PREAD", "NO")))
+    {
+        // Do not leak the descriptor into child processes.
+#ifdef O_CLOEXEC
+        const int fd = open(pszFilename, O_RDONLY | O_CLOEXEC);
+#else
+        const int fd = open(pszFilename, O_RDONLY);
+        if (fd >= 0)
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+#endif
+        const int nError = errno;
+
+        VSIDebug2("VSIUnixStdioFilesystemHandler::Open(\"%s\",\"rb\") = fd %d",
+                  pszFilename, fd);
+
+        if (fd < 0)
+        {
+            if (bSetError)
+            {
+                VSIError(VSIE_FileError, "%s: %s", pszFilename,
+                         strerror(nError));
+            }
+            errno = nError;
+            return nullptr;
+        }
+
+        VSIVirtualHandle *poHandle = new (std::nothrow) VSIUnixPReadHandle(fd);
+        if (poHandle == nullptr)
+        {
+            close(fd);
+            return nullptr;
+        }
+
+        errno = nError;
+
+        if (CPLTestBool(CPLGetConfigOption("VSI_CACHE", "FALSE")))
+        {
+            return VSICreateCachedFile(poHandle);
+        }
+
+        return poHandle;
+    }
+#endif
+
     FILE *fp = VSI_FOPEN64(pszFilename, pszAccess);
     const int nError = errno;
 
@@ -696,8 +1375,6 @@ VSIUnixStdioFilesystemHandler::Open(const char *pszFilename,
         return nullptr;
     }
 
-    const bool bReadOnly =
-        strcmp(pszAccess, "rb") == 0 || strcmp(pszAccess, "r") == 0;
     const bool bModeAppendReadWrite =
         strcmp(pszAccess, "a+b") == 0 || strcmp(pszAccess, "a+") == 0;
     VSIUnixStdioHandle *poHandle = new (std::nothrow)
@@ -118,6 +118,23 @@ void CPLWorkerThreadPool::WorkerThreadFunction(void *user_data)
     }
 }
 
+/************************************************************************/
+/*                    IsCurrentThreadWorkerThread()                     */
+/************************************************************************/
+
+/** Returns whether the calling thread is one of the worker threads of this
+ * pool.
+ *
+ * Code running in a job can use it to avoid waiting for other jobs of the
+ * same pool, which could deadlock if all worker threads are busy.
+ *
+ * @since GDAL 3.8
+ */
+bool CPLWorkerThreadPool::IsCurrentThreadWorkerThread() const
+{
+    return threadLocalCurrentThreadPool == this;
+}
+
 /************************************************************************/
 /*                             SubmitJob()                              */
 /************************************************************************/
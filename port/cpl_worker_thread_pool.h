@@ -116,6 +116,8 @@ class CPL_DLL CPLWorkerThreadPool
     {
         return m_nMaxThreads;
     }
+
+    bool IsCurrentThreadWorkerThread() const;
 };
 
 /** Job queue */